@@ -0,0 +1,261 @@
+/* Standard includes. */
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <linux/filter.h>
+
+/* Example includes. */
+#include "binding_server.h"
+
+/*-----------------------------------------------------------*/
+
+/* Static Functions. */
+static void * WorkerMain( void * pArg );
+
+static int GetWorkerCpu( size_t index );
+
+/*-----------------------------------------------------------*/
+
+/* Runs on the CPU of the worker when pinned, so the socket, the cache and the
+ * buffers the backend allocates are local to it. */
+static void * WorkerMain( void * pArg )
+{
+    BindingServerWorker_t * pWorker = ( BindingServerWorker_t * ) pArg;
+    struct timespec now;
+
+    pWorker->socketFd = BindingServer_OpenSocket( pWorker->pConfig );
+
+    /* Wait for the other workers to open their sockets. *pStop is set if
+     * one of them failed. */
+    sem_post( &( pWorker->opened ) );
+    sem_wait( &( pWorker->released ) );
+
+    if( ( pWorker->socketFd >= 0 ) &&
+        ( __atomic_load_n( pWorker->pStop, __ATOMIC_ACQUIRE ) == 0 ) )
+    {
+        clock_gettime( CLOCK_MONOTONIC, &( now ) );
+        pWorker->pCache = BindingServer_CreateResponseCache( ( ( uint64_t ) now.tv_nsec << 32 ) ^
+                                                             ( ( uint64_t ) now.tv_sec * 0x9E3779B97F4A7C15ULL ) ^
+                                                             ( uint64_t ) pWorker->index );
+    }
+
+    if( pWorker->pCache != NULL )
+    {
+        ( void ) pWorker->pBackend( pWorker );
+        BindingServer_DeleteResponseCache( pWorker->pCache );
+        pWorker->pCache = NULL;
+    }
+
+    clock_gettime( CLOCK_THREAD_CPUTIME_ID, &( now ) );
+    pWorker->cpuNs = ( ( uint64_t ) now.tv_sec * 1000000000ULL ) + ( uint64_t ) now.tv_nsec;
+
+    return NULL;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Returns the index-th CPU the process may run on, wrapping around when there
+ * are more workers than CPUs. */
+static int GetWorkerCpu( size_t index )
+{
+    cpu_set_t allowed;
+    int cpu, count, target, ret = -1;
+
+    if( sched_getaffinity( 0, sizeof( allowed ), &( allowed ) ) == 0 )
+    {
+        count = CPU_COUNT( &( allowed ) );
+        target = ( int ) ( index % ( size_t ) count );
+
+        for( cpu = 0; ( ret < 0 ) && ( cpu < CPU_SETSIZE ); cpu++ )
+        {
+            if( CPU_ISSET( cpu, &( allowed ) ) )
+            {
+                if( target == 0 )
+                {
+                    ret = cpu;
+                }
+
+                target--;
+            }
+        }
+    }
+
+    return ret;
+}
+
+/*-----------------------------------------------------------*/
+
+int BindingServer_OpenSocket( const BindingServerConfig_t * pConfig )
+{
+    int socketFd, enable = 1;
+    struct timeval timeout;
+
+    timeout.tv_sec = 0;
+    timeout.tv_usec = BINDING_SERVER_RECEIVE_TIMEOUT_MS * 1000;
+
+    socketFd = socket( AF_INET, SOCK_DGRAM, 0 );
+
+    if( socketFd >= 0 )
+    {
+        if( ( setsockopt( socketFd, SOL_SOCKET, SO_REUSEPORT, &( enable ), sizeof( enable ) ) != 0 ) ||
+            ( setsockopt( socketFd, SOL_SOCKET, SO_RCVTIMEO, &( timeout ), sizeof( timeout ) ) != 0 ) ||
+            ( bind( socketFd, ( const struct sockaddr * ) &( pConfig->address ), sizeof( pConfig->address ) ) != 0 ) )
+        {
+            perror( "Binding server socket" );
+            close( socketFd );
+            socketFd = -1;
+        }
+    }
+
+    return socketFd;
+}
+
+/*-----------------------------------------------------------*/
+
+int BindingServer_AttachSteering( int socketFd,
+                                  size_t workerCount )
+{
+    int ret = 0;
+    /* The socket of index ( hash % workerCount ) in the reuseport group gets
+     * the datagram, where the hash mixes the IPv4 source address and port
+     * with a multiplication. The offsets are from the IP header, which has no
+     * options. */
+    struct sock_filter steering[] =
+    {
+        BPF_STMT( BPF_LD | BPF_W | BPF_ABS, SKF_NET_OFF + 12 ),
+        BPF_STMT( BPF_MISC | BPF_TAX, 0 ),
+        BPF_STMT( BPF_LD | BPF_H | BPF_ABS, SKF_NET_OFF + 20 ),
+        BPF_STMT( BPF_ALU | BPF_XOR | BPF_X, 0 ),
+        BPF_STMT( BPF_ALU | BPF_MUL | BPF_K, 0x9E3779B1U ),
+        BPF_STMT( BPF_ALU | BPF_RSH | BPF_K, 16 ),
+        BPF_STMT( BPF_ALU | BPF_MOD | BPF_K, ( uint32_t ) workerCount ),
+        BPF_STMT( BPF_RET | BPF_A, 0 )
+    };
+    struct sock_fprog program;
+
+    program.len = ( unsigned short ) ( sizeof( steering ) / sizeof( steering[ 0 ] ) );
+    program.filter = &( steering[ 0 ] );
+
+    if( setsockopt( socketFd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &( program ), sizeof( program ) ) != 0 )
+    {
+        perror( "Reuseport steering" );
+        ret = -1;
+    }
+
+    return ret;
+}
+
+/*-----------------------------------------------------------*/
+
+int BindingServer_Start( const BindingServerConfig_t * pConfig,
+                         BindingServerWorker_t * pWorkers,
+                         int * pStop )
+{
+    int ret = 0;
+    size_t i, startedCount = 0;
+    pthread_attr_t attributes;
+    cpu_set_t cpus;
+
+    __atomic_store_n( pStop, 0, __ATOMIC_RELAXED );
+
+    for( i = 0; i < pConfig->workerCount; i++ )
+    {
+        memset( &( pWorkers[ i ] ), 0, sizeof( BindingServerWorker_t ) );
+        pWorkers[ i ].pConfig = pConfig;
+        pWorkers[ i ].index = i;
+        pWorkers[ i ].pStop = pStop;
+        pWorkers[ i ].socketFd = -1;
+        pWorkers[ i ].cpu = ( pConfig->sharded != 0 ) ? GetWorkerCpu( i ) : -1;
+        pWorkers[ i ].pBackend = ( pConfig->backend == BINDING_SERVER_BACKEND_URING ) ? BindingServer_UringWorker : BindingServer_MmsgWorker;
+    }
+
+    /* The index of a socket in the reuseport group is the order it was bound
+     * in. Each worker opens its socket on its own thread, and the next worker
+     * only starts once it is open, so that the index is the one of the
+     * worker. */
+    for( i = 0; ( ret == 0 ) && ( i < pConfig->workerCount ); i++ )
+    {
+        sem_init( &( pWorkers[ i ].opened ), 0, 0 );
+        sem_init( &( pWorkers[ i ].released ), 0, 0 );
+        pthread_attr_init( &( attributes ) );
+
+        /* The thread starts on its CPU. */
+        if( pWorkers[ i ].cpu >= 0 )
+        {
+            CPU_ZERO( &( cpus ) );
+            CPU_SET( pWorkers[ i ].cpu, &( cpus ) );
+            pthread_attr_setaffinity_np( &( attributes ), sizeof( cpus ), &( cpus ) );
+        }
+
+        if( pthread_create( &( pWorkers[ i ].thread ), &( attributes ), WorkerMain, &( pWorkers[ i ] ) ) != 0 )
+        {
+            sem_destroy( &( pWorkers[ i ].opened ) );
+            sem_destroy( &( pWorkers[ i ].released ) );
+            ret = -1;
+        }
+        else
+        {
+            startedCount++;
+            sem_wait( &( pWorkers[ i ].opened ) );
+
+            if( pWorkers[ i ].socketFd < 0 )
+            {
+                ret = -1;
+            }
+        }
+
+        pthread_attr_destroy( &( attributes ) );
+    }
+
+    /* Attached before the workers are released, so that the reuseport group
+     * is complete and steered when the first request is answered. */
+    if( ( ret == 0 ) && ( pConfig->sharded != 0 ) )
+    {
+        ret = BindingServer_AttachSteering( pWorkers[ 0 ].socketFd, pConfig->workerCount );
+    }
+
+    if( ret != 0 )
+    {
+        __atomic_store_n( pStop, 1, __ATOMIC_RELEASE );
+    }
+
+    for( i = 0; i < startedCount; i++ )
+    {
+        sem_post( &( pWorkers[ i ].released ) );
+    }
+
+    if( ret != 0 )
+    {
+        BindingServer_Stop( pWorkers, startedCount, pStop );
+    }
+
+    return ret;
+}
+
+/*-----------------------------------------------------------*/
+
+void BindingServer_Stop( BindingServerWorker_t * pWorkers,
+                         size_t workerCount,
+                         int * pStop )
+{
+    size_t i;
+
+    __atomic_store_n( pStop, 1, __ATOMIC_RELEASE );
+
+    for( i = 0; i < workerCount; i++ )
+    {
+        pthread_join( pWorkers[ i ].thread, NULL );
+        sem_destroy( &( pWorkers[ i ].opened ) );
+        sem_destroy( &( pWorkers[ i ].released ) );
+
+        if( pWorkers[ i ].socketFd >= 0 )
+        {
+            close( pWorkers[ i ].socketFd );
+        }
+    }
+}
+
+/*-----------------------------------------------------------*/
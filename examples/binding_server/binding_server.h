@@ -0,0 +1,141 @@
+#ifndef BINDING_SERVER_H
+#define BINDING_SERVER_H
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <netinet/in.h>
+
+/* API includes. */
+#include "stun_serializer.h"
+
+/*
+ * Example STUN server that answers RFC 8489 Binding Requests with a Binding
+ * success response carrying XOR-MAPPED-ADDRESS. Each worker thread owns a UDP
+ * socket bound with SO_REUSEPORT to the same address, so the kernel spreads
+ * the clients over the workers. A worker either receives and sends in batches
+ * with recvmmsg and sendmmsg, or drives the socket through io_uring.
+ *
+ * Workers share nothing on the hot path: each has its own socket, buffers and
+ * response cache. With pConfig->sharded set, worker i is also pinned to the
+ * i-th CPU the process may run on, and a reuseport BPF program steers each
+ * client to a worker by a hash of its source address and port.
+ */
+
+#define BINDING_SERVER_MAX_WORKERS          64
+#define BINDING_SERVER_MAX_BATCH            64
+
+/* Datagrams longer than this are truncated and dropped. */
+#define BINDING_SERVER_REQUEST_LENGTH       1500
+
+/* XOR-MAPPED-ADDRESS of an IPv6 address and FINGERPRINT. */
+#define BINDING_SERVER_RESPONSE_LENGTH                                             \
+    ( STUN_HEADER_LENGTH +                                                         \
+      STUN_SERIALIZER_ATTRIBUTE_LENGTH( STUN_ATTRIBUTE_ADDRESS_IPV6_VALUE_LENGTH ) + \
+      STUN_SERIALIZER_ATTRIBUTE_LENGTH( STUN_ATTRIBUTE_FINGERPRINT_VALUE_LENGTH ) )
+
+/* Responses kept per worker for retransmitted requests. */
+#define BINDING_SERVER_CACHE_ENTRIES        1024
+
+/* How often a blocked worker checks whether it has to stop. */
+#define BINDING_SERVER_RECEIVE_TIMEOUT_MS   100
+
+typedef enum BindingServerBackend
+{
+    BINDING_SERVER_BACKEND_MMSG,
+    BINDING_SERVER_BACKEND_URING
+} BindingServerBackend_t;
+
+typedef struct BindingServerConfig
+{
+    BindingServerBackend_t backend;
+    struct sockaddr_in address;
+    size_t workerCount;
+    size_t batchSize;
+    int sharded;
+} BindingServerConfig_t;
+
+typedef struct BindingServerResponseCache BindingServerResponseCache_t;
+
+/* Aligned to a cache line, so that the counters of a worker do not share a
+ * line with its neighbour in the array. */
+typedef struct BindingServerWorker
+{
+    const BindingServerConfig_t * pConfig;
+    size_t index;
+    int socketFd;
+    int cpu; /* -1 if not pinned. */
+    int * pStop;
+    pthread_t thread;
+    void * ( * pBackend )( void * pArg );
+    BindingServerResponseCache_t * pCache;
+    /* Posted by the worker once its socket is open, and by
+     * BindingServer_Start once all the sockets are open. */
+    sem_t opened;
+    sem_t released;
+    /* Written by the worker, read once it has stopped. */
+    uint64_t requestCount;
+    uint64_t responseCount;
+    uint64_t droppedCount;
+    uint64_t receiveCallCount;
+    uint64_t cacheHitCount;
+    uint64_t cpuNs;
+} __attribute__( ( aligned( 64 ) ) ) BindingServerWorker_t;
+
+/* Validates a Binding Request received from pPeer and writes the response to
+ * pResponse. Returns the length of the response, or 0 if the request is
+ * dropped. */
+size_t BindingServer_HandleRequest( uint8_t * pRequest,
+                                    size_t requestLength,
+                                    const struct sockaddr * pPeer,
+                                    uint8_t * pResponse,
+                                    size_t responseBufferLength );
+
+/* Answers a request from the response cache of the worker if it is a
+ * retransmission, otherwise with BindingServer_HandleRequest, and caches the
+ * response. */
+size_t BindingServer_HandleWorkerRequest( BindingServerWorker_t * pWorker,
+                                          uint8_t * pRequest,
+                                          size_t requestLength,
+                                          const struct sockaddr * pPeer,
+                                          uint8_t * pResponse,
+                                          size_t responseBufferLength );
+
+/* Returns NULL if out of memory. */
+BindingServerResponseCache_t * BindingServer_CreateResponseCache( uint64_t seed );
+
+void BindingServer_DeleteResponseCache( BindingServerResponseCache_t * pCache );
+
+/* Opens a UDP socket bound to the address of pConfig with SO_REUSEPORT.
+ * Returns -1 on error. */
+int BindingServer_OpenSocket( const BindingServerConfig_t * pConfig );
+
+/* Worker thread that answers requests with recvmmsg and sendmmsg until
+ * *pStop is set. */
+void * BindingServer_MmsgWorker( void * pArg );
+
+/* Worker thread that answers requests with a multishot recvmsg on a provided
+ * buffer ring and sends from registered buffers until *pStop is set. Falls
+ * back to BindingServer_MmsgWorker if io_uring is not available. */
+void * BindingServer_UringWorker( void * pArg );
+
+/* Attaches the reuseport BPF program that steers each client to one of
+ * workerCount sockets. Returns 0 on success. */
+int BindingServer_AttachSteering( int socketFd,
+                                  size_t workerCount );
+
+/* Starts pConfig->workerCount workers, each of which opens its socket on its
+ * own thread, and returns once all the sockets are open. Returns 0 on
+ * success. */
+int BindingServer_Start( const BindingServerConfig_t * pConfig,
+                         BindingServerWorker_t * pWorkers,
+                         int * pStop );
+
+/* Sets *pStop and waits for the workers. */
+void BindingServer_Stop( BindingServerWorker_t * pWorkers,
+                         size_t workerCount,
+                         int * pStop );
+
+#endif /* BINDING_SERVER_H */
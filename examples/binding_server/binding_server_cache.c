@@ -0,0 +1,184 @@
+/* Standard includes. */
+#include <stdlib.h>
+#include <string.h>
+#include <arpa/inet.h>
+
+/* API includes. */
+#include "stun_transaction_table.h"
+
+/* Example includes. */
+#include "binding_server.h"
+
+/*
+ * Cache of the last BINDING_SERVER_CACHE_ENTRIES responses of a worker, so
+ * that a retransmitted request gets the same response without going through
+ * the codec again. The entries are reused in FIFO order and are indexed by
+ * transaction ID with a transaction table. Each worker has its own cache, so
+ * the table is only ever used from one thread.
+ *
+ * A new request costs a lookup, a remove and an insert. The table frees the
+ * removed slots, so this cost does not grow as the entries are reused and the
+ * table never needs to be rebuilt.
+ */
+
+/* The table is kept at most half full. */
+#define CACHE_TABLE_CAPACITY    ( 2 * BINDING_SERVER_CACHE_ENTRIES )
+
+/*-----------------------------------------------------------*/
+
+typedef struct CacheEntry
+{
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ];
+    uint8_t inUse;
+    socklen_t peerLength;
+    struct sockaddr_in6 peer;
+    size_t responseLength;
+    uint8_t response[ BINDING_SERVER_RESPONSE_LENGTH ];
+} CacheEntry_t;
+
+struct BindingServerResponseCache
+{
+    StunTransactionTable_t table;
+    uint8_t tags[ CACHE_TABLE_CAPACITY ];
+    StunTransactionSlot_t slots[ CACHE_TABLE_CAPACITY ];
+    uint32_t overflowCounts[ CACHE_TABLE_CAPACITY / STUN_TRANSACTION_TABLE_GROUP_LENGTH ];
+    CacheEntry_t entries[ BINDING_SERVER_CACHE_ENTRIES ];
+    size_t nextEntry;
+};
+
+/*-----------------------------------------------------------*/
+
+/* Static Functions. */
+static socklen_t GetPeerLength( const struct sockaddr * pPeer );
+
+static int IsBindingRequest( const uint8_t * pRequest,
+                             size_t requestLength );
+
+/*-----------------------------------------------------------*/
+
+static socklen_t GetPeerLength( const struct sockaddr * pPeer )
+{
+    return ( pPeer->sa_family == AF_INET6 ) ? sizeof( struct sockaddr_in6 ) : sizeof( struct sockaddr_in );
+}
+
+/*-----------------------------------------------------------*/
+
+/* Only the header is checked before the lookup. The codec validates the rest
+ * of the request before its response is cached. */
+static int IsBindingRequest( const uint8_t * pRequest,
+                             size_t requestLength )
+{
+    int ret = 0;
+    uint16_t messageType;
+    uint32_t magicCookie;
+
+    if( requestLength >= STUN_HEADER_LENGTH )
+    {
+        memcpy( &( messageType ), pRequest, sizeof( messageType ) );
+        memcpy( &( magicCookie ), &( pRequest[ STUN_HEADER_MAGIC_COOKIE_OFFSET ] ), sizeof( magicCookie ) );
+
+        ret = ( ntohs( messageType ) == STUN_MESSAGE_TYPE_BINDING_REQUEST ) &&
+              ( ntohl( magicCookie ) == STUN_HEADER_MAGIC_COOKIE );
+    }
+
+    return ret;
+}
+
+/*-----------------------------------------------------------*/
+
+BindingServerResponseCache_t * BindingServer_CreateResponseCache( uint64_t seed )
+{
+    BindingServerResponseCache_t * pCache;
+
+    pCache = calloc( 1, sizeof( BindingServerResponseCache_t ) );
+
+    if( ( pCache != NULL ) &&
+        ( StunTransactionTable_Init( &( pCache->table ),
+                                     &( pCache->tags[ 0 ] ),
+                                     &( pCache->slots[ 0 ] ),
+                                     &( pCache->overflowCounts[ 0 ] ),
+                                     CACHE_TABLE_CAPACITY,
+                                     seed ) != STUN_RESULT_OK ) )
+    {
+        free( pCache );
+        pCache = NULL;
+    }
+
+    return pCache;
+}
+
+/*-----------------------------------------------------------*/
+
+void BindingServer_DeleteResponseCache( BindingServerResponseCache_t * pCache )
+{
+    free( pCache );
+}
+
+/*-----------------------------------------------------------*/
+
+size_t BindingServer_HandleWorkerRequest( BindingServerWorker_t * pWorker,
+                                          uint8_t * pRequest,
+                                          size_t requestLength,
+                                          const struct sockaddr * pPeer,
+                                          uint8_t * pResponse,
+                                          size_t responseBufferLength )
+{
+    BindingServerResponseCache_t * pCache = pWorker->pCache;
+    CacheEntry_t * pEntry = NULL;
+    const uint8_t * pTransactionId = &( pRequest[ STUN_HEADER_TRANSACTION_ID_OFFSET ] );
+    socklen_t peerLength = GetPeerLength( pPeer );
+    void * pUserData;
+    size_t responseLength = 0;
+    int found = 0;
+
+    if( IsBindingRequest( pRequest, requestLength ) != 0 )
+    {
+        found = ( StunTransactionTable_Lookup( &( pCache->table ), pTransactionId, &( pUserData ) ) == STUN_RESULT_OK );
+
+        if( found != 0 )
+        {
+            pEntry = ( CacheEntry_t * ) pUserData;
+        }
+
+        if( ( pEntry != NULL ) &&
+            ( pEntry->peerLength == peerLength ) &&
+            ( memcmp( &( pEntry->peer ), pPeer, peerLength ) == 0 ) &&
+            ( pEntry->responseLength <= responseBufferLength ) )
+        {
+            memcpy( pResponse, &( pEntry->response[ 0 ] ), pEntry->responseLength );
+            responseLength = pEntry->responseLength;
+            pWorker->cacheHitCount++;
+        }
+        else
+        {
+            responseLength = BindingServer_HandleRequest( pRequest, requestLength, pPeer, pResponse, responseBufferLength );
+        }
+    }
+
+    /* The same transaction ID from another peer is answered, but not
+     * cached, as the transaction IDs in the table must be unique. */
+    if( ( found == 0 ) &&
+        ( responseLength > 0 ) &&
+        ( responseLength <= BINDING_SERVER_RESPONSE_LENGTH ) )
+    {
+        /* Reuse the oldest entry. */
+        pEntry = &( pCache->entries[ pCache->nextEntry ] );
+        pCache->nextEntry = ( pCache->nextEntry + 1U ) % BINDING_SERVER_CACHE_ENTRIES;
+
+        if( pEntry->inUse != 0U )
+        {
+            ( void ) StunTransactionTable_Remove( &( pCache->table ), &( pEntry->transactionId[ 0 ] ), NULL );
+        }
+
+        memcpy( &( pEntry->transactionId[ 0 ] ), pTransactionId, STUN_HEADER_TRANSACTION_ID_LENGTH );
+        memcpy( &( pEntry->peer ), pPeer, peerLength );
+        pEntry->peerLength = peerLength;
+        pEntry->responseLength = responseLength;
+        memcpy( &( pEntry->response[ 0 ] ), pResponse, responseLength );
+        pEntry->inUse = ( StunTransactionTable_Insert( &( pCache->table ), pTransactionId, pEntry ) == STUN_RESULT_OK ) ? 1U : 0U;
+    }
+
+    return responseLength;
+}
+
+/*-----------------------------------------------------------*/
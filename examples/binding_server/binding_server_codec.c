@@ -0,0 +1,121 @@
+/* Standard includes. */
+#include <string.h>
+#include <arpa/inet.h>
+
+/* API includes. */
+#include "stun_deserializer.h"
+#include "stun_serializer.h"
+
+/* Example includes. */
+#include "binding_server.h"
+
+/*-----------------------------------------------------------*/
+
+/* Static Functions. */
+static int GetPeerAddress( const struct sockaddr * pPeer,
+                           StunAttributeAddress_t * pAddress );
+
+/*-----------------------------------------------------------*/
+
+static int GetPeerAddress( const struct sockaddr * pPeer,
+                           StunAttributeAddress_t * pAddress )
+{
+    int ret = 0;
+    const struct sockaddr_in * pPeer4;
+    const struct sockaddr_in6 * pPeer6;
+
+    memset( pAddress, 0, sizeof( StunAttributeAddress_t ) );
+
+    if( pPeer->sa_family == AF_INET )
+    {
+        pPeer4 = ( const struct sockaddr_in * ) pPeer;
+        pAddress->family = STUN_ADDRESS_IPv4;
+        pAddress->port = ntohs( pPeer4->sin_port );
+        memcpy( &( pAddress->address[ 0 ] ), &( pPeer4->sin_addr ), STUN_IPV4_ADDRESS_SIZE );
+    }
+    else if( pPeer->sa_family == AF_INET6 )
+    {
+        pPeer6 = ( const struct sockaddr_in6 * ) pPeer;
+        pAddress->family = STUN_ADDRESS_IPv6;
+        pAddress->port = ntohs( pPeer6->sin6_port );
+        memcpy( &( pAddress->address[ 0 ] ), &( pPeer6->sin6_addr ), STUN_IPV6_ADDRESS_SIZE );
+    }
+    else
+    {
+        ret = -1;
+    }
+
+    return ret;
+}
+
+/*-----------------------------------------------------------*/
+
+size_t BindingServer_HandleRequest( uint8_t * pRequest,
+                                    size_t requestLength,
+                                    const struct sockaddr * pPeer,
+                                    uint8_t * pResponse,
+                                    size_t responseBufferLength )
+{
+    StunContext_t ctx;
+    StunHeader_t header;
+    StunAttribute_t attribute;
+    StunAttributeAddress_t mappedAddress;
+    StunResult_t result;
+    uint8_t hasFingerprint = 0;
+    size_t responseLength = 0;
+
+    result = StunDeserializer_Init( &( ctx ), pRequest, requestLength, &( header ) );
+
+    if( ( result == STUN_RESULT_OK ) &&
+        ( header.messageType != STUN_MESSAGE_TYPE_BINDING_REQUEST ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    /* Walk the attributes to reject malformed requests. A FINGERPRINT, if
+     * present, is the last attribute and must match. */
+    while( result == STUN_RESULT_OK )
+    {
+        result = StunDeserializer_GetNextAttribute( &( ctx ), &( attribute ) );
+
+        if( ( result == STUN_RESULT_OK ) &&
+            ( attribute.attributeType == STUN_ATTRIBUTE_TYPE_FINGERPRINT ) )
+        {
+            result = StunDeserializer_VerifyFingerprint( &( ctx ), &( attribute ) );
+            hasFingerprint = 1;
+        }
+    }
+
+    if( result == STUN_RESULT_NO_MORE_ATTRIBUTE_FOUND )
+    {
+        result = ( GetPeerAddress( pPeer, &( mappedAddress ) ) == 0 ) ? STUN_RESULT_OK : STUN_RESULT_BAD_PARAM;
+    }
+
+    /* The response has the transaction ID of the request, and a FINGERPRINT
+     * if the request has one. */
+    if( result == STUN_RESULT_OK )
+    {
+        header.messageType = STUN_MESSAGE_TYPE_BINDING_SUCCESS_RESPONSE;
+        result = StunSerializer_Init( &( ctx ), pResponse, responseBufferLength, &( header ) );
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        result = StunSerializer_AddAttributeXorMappedAddress( &( ctx ), &( mappedAddress ) );
+    }
+
+    if( ( result == STUN_RESULT_OK ) &&
+        ( hasFingerprint != 0U ) )
+    {
+        result = StunSerializer_AddComputedFingerprint( &( ctx ) );
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        result = StunSerializer_Finalize( &( ctx ), &( responseLength ) );
+    }
+
+    return ( result == STUN_RESULT_OK ) ? responseLength : 0;
+}
+
+/*-----------------------------------------------------------*/
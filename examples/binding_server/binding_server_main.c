@@ -0,0 +1,313 @@
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <arpa/inet.h>
+
+/* Example includes. */
+#include "binding_server.h"
+#include "load_generator.h"
+
+/*
+ * Runs the binding server, the load generator or both over loopback for a
+ * fixed time and prints the throughput and latency:
+ *
+ *   binding_server [-m both|server|client|scale] [-e mmsg|uring] [-s]
+ *                  [-a address] [-p port] [-w workers] [-c clients]
+ *                  [-b batch] [-d seconds]
+ *
+ * -s pins the workers and steers the clients with a reuseport BPF program.
+ * -m scale runs both sides with 1 to -w workers and -c clients per worker,
+ * and prints how the throughput scales.
+ */
+
+/*-----------------------------------------------------------*/
+
+typedef struct Options
+{
+    const char * pMode;
+    const char * pBackend;
+    int sharded;
+    const char * pAddress;
+    uint16_t port;
+    size_t workerCount;
+    size_t clientCount;
+    size_t batchSize;
+    unsigned int durationSeconds;
+} Options_t;
+
+/*-----------------------------------------------------------*/
+
+/* Static Functions. */
+static uint64_t NowNs( void );
+
+static int ParseOptions( int argc,
+                         char ** argv,
+                         Options_t * pOptions );
+
+static double ReportServer( const BindingServerWorker_t * pWorkers,
+                            size_t workerCount,
+                            uint64_t elapsedNs );
+
+static int Run( const Options_t * pOptions,
+                size_t workerCount,
+                size_t clientCount,
+                double * pMpps );
+
+/*-----------------------------------------------------------*/
+
+static uint64_t NowNs( void )
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &( ts ) );
+
+    return ( ( uint64_t ) ts.tv_sec * 1000000000ULL ) + ( uint64_t ) ts.tv_nsec;
+}
+
+/*-----------------------------------------------------------*/
+
+static int ParseOptions( int argc,
+                         char ** argv,
+                         Options_t * pOptions )
+{
+    int ret = 0, option;
+
+    pOptions->pMode = "both";
+    pOptions->pBackend = "mmsg";
+    pOptions->sharded = 0;
+    pOptions->pAddress = "127.0.0.1";
+    pOptions->port = 3478;
+    pOptions->workerCount = 1;
+    pOptions->clientCount = 2;
+    pOptions->batchSize = 32;
+    pOptions->durationSeconds = 5;
+
+    while( ( ret == 0 ) && ( ( option = getopt( argc, argv, "m:e:sa:p:w:c:b:d:" ) ) != -1 ) )
+    {
+        switch( option )
+        {
+            case 'm':
+                pOptions->pMode = optarg;
+                break;
+
+            case 'e':
+                pOptions->pBackend = optarg;
+                break;
+
+            case 's':
+                pOptions->sharded = 1;
+                break;
+
+            case 'a':
+                pOptions->pAddress = optarg;
+                break;
+
+            case 'p':
+                pOptions->port = ( uint16_t ) strtoul( optarg, NULL, 10 );
+                break;
+
+            case 'w':
+                pOptions->workerCount = strtoul( optarg, NULL, 10 );
+                break;
+
+            case 'c':
+                pOptions->clientCount = strtoul( optarg, NULL, 10 );
+                break;
+
+            case 'b':
+                pOptions->batchSize = strtoul( optarg, NULL, 10 );
+                break;
+
+            case 'd':
+                pOptions->durationSeconds = ( unsigned int ) strtoul( optarg, NULL, 10 );
+                break;
+
+            default:
+                ret = -1;
+                break;
+        }
+    }
+
+    if( ( ret != 0 ) ||
+        ( ( strcmp( pOptions->pMode, "both" ) != 0 ) &&
+          ( strcmp( pOptions->pMode, "server" ) != 0 ) &&
+          ( strcmp( pOptions->pMode, "client" ) != 0 ) &&
+          ( strcmp( pOptions->pMode, "scale" ) != 0 ) ) ||
+        ( ( strcmp( pOptions->pBackend, "mmsg" ) != 0 ) &&
+          ( strcmp( pOptions->pBackend, "uring" ) != 0 ) ) ||
+        ( pOptions->workerCount == 0 ) || ( pOptions->workerCount > BINDING_SERVER_MAX_WORKERS ) ||
+        ( pOptions->clientCount == 0 ) || ( pOptions->clientCount > LOAD_GENERATOR_MAX_CLIENTS ) ||
+        ( ( strcmp( pOptions->pMode, "scale" ) == 0 ) &&
+          ( pOptions->clientCount * pOptions->workerCount > LOAD_GENERATOR_MAX_CLIENTS ) ) ||
+        ( pOptions->batchSize == 0 ) || ( pOptions->batchSize > BINDING_SERVER_MAX_BATCH ) )
+    {
+        fprintf( stderr, "Usage: %s [-m both|server|client|scale] [-e mmsg|uring] [-s] [-a address] [-p port] [-w workers 1-%d] [-c clients 1-%d] [-b batch 1-%d] [-d seconds]\n",
+                 argv[ 0 ], BINDING_SERVER_MAX_WORKERS, LOAD_GENERATOR_MAX_CLIENTS, BINDING_SERVER_MAX_BATCH );
+        ret = -1;
+    }
+
+    return ret;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Returns the throughput in Mpps. */
+static double ReportServer( const BindingServerWorker_t * pWorkers,
+                            size_t workerCount,
+                            uint64_t elapsedNs )
+{
+    uint64_t requestCount = 0, responseCount = 0, droppedCount = 0, receiveCallCount = 0, cacheHitCount = 0, cpuNs = 0;
+    size_t i;
+
+    for( i = 0; i < workerCount; i++ )
+    {
+        printf( "Worker %zu (CPU %d): %zu responses, %.3f Mpps per CPU second\n",
+                i, pWorkers[ i ].cpu, ( size_t ) pWorkers[ i ].responseCount,
+                ( pWorkers[ i ].cpuNs > 0U ) ? ( double ) pWorkers[ i ].responseCount * 1e3 / ( double ) pWorkers[ i ].cpuNs : 0.0 );
+
+        requestCount += pWorkers[ i ].requestCount;
+        responseCount += pWorkers[ i ].responseCount;
+        droppedCount += pWorkers[ i ].droppedCount;
+        receiveCallCount += pWorkers[ i ].receiveCallCount;
+        cacheHitCount += pWorkers[ i ].cacheHitCount;
+        cpuNs += pWorkers[ i ].cpuNs;
+    }
+
+    printf( "Server: %zu requests, %zu responses, %zu from cache, %zu dropped, %.1f requests per receive call\n",
+            ( size_t ) requestCount, ( size_t ) responseCount, ( size_t ) cacheHitCount, ( size_t ) droppedCount,
+            ( receiveCallCount > 0U ) ? ( double ) requestCount / ( double ) receiveCallCount : 0.0 );
+    printf( "Server: %.3f Mpps, %.3f Mpps per CPU second\n",
+            ( double ) responseCount * 1e3 / ( double ) elapsedNs,
+            ( cpuNs > 0U ) ? ( double ) responseCount * 1e3 / ( double ) cpuNs : 0.0 );
+
+    return ( double ) responseCount * 1e3 / ( double ) elapsedNs;
+}
+
+/*-----------------------------------------------------------*/
+
+static int Run( const Options_t * pOptions,
+                size_t workerCount,
+                size_t clientCount,
+                double * pMpps )
+{
+    static BindingServerWorker_t workers[ BINDING_SERVER_MAX_WORKERS ];
+    static LoadGeneratorClient_t clients[ LOAD_GENERATOR_MAX_CLIENTS ];
+    BindingServerConfig_t serverConfig;
+    LoadGeneratorConfig_t clientConfig;
+    int serverStop = 0, clientStop = 0, runServer, runClients, ret = 0;
+    uint64_t start, elapsedNs;
+
+    runServer = ( strcmp( pOptions->pMode, "client" ) != 0 );
+    runClients = ( strcmp( pOptions->pMode, "server" ) != 0 );
+    *pMpps = 0.0;
+
+    memset( &( serverConfig ), 0, sizeof( serverConfig ) );
+    serverConfig.backend = ( strcmp( pOptions->pBackend, "uring" ) == 0 ) ? BINDING_SERVER_BACKEND_URING : BINDING_SERVER_BACKEND_MMSG;
+    serverConfig.address.sin_family = AF_INET;
+    serverConfig.address.sin_port = htons( pOptions->port );
+    serverConfig.workerCount = workerCount;
+    serverConfig.batchSize = pOptions->batchSize;
+    serverConfig.sharded = pOptions->sharded;
+
+    if( inet_pton( AF_INET, pOptions->pAddress, &( serverConfig.address.sin_addr ) ) != 1 )
+    {
+        fprintf( stderr, "Invalid IPv4 address %s\n", pOptions->pAddress );
+        return -1;
+    }
+
+    memset( &( clientConfig ), 0, sizeof( clientConfig ) );
+    clientConfig.serverAddress = serverConfig.address;
+    clientConfig.clientCount = clientCount;
+    clientConfig.batchSize = pOptions->batchSize;
+
+    printf( "Mode: %s, backend: %s%s, workers: %zu, clients: %zu, batch: %zu, %u s\n",
+            pOptions->pMode, pOptions->pBackend, ( pOptions->sharded != 0 ) ? ", sharded" : "",
+            workerCount, clientCount, pOptions->batchSize, pOptions->durationSeconds );
+
+    if( runServer && ( BindingServer_Start( &( serverConfig ), &( workers[ 0 ] ), &( serverStop ) ) != 0 ) )
+    {
+        return -1;
+    }
+
+    if( runClients && ( LoadGenerator_Start( &( clientConfig ), &( clients[ 0 ] ), &( clientStop ) ) != 0 ) )
+    {
+        ret = -1;
+    }
+
+    start = NowNs();
+
+    if( ret == 0 )
+    {
+        sleep( pOptions->durationSeconds );
+    }
+
+    /* Stop the clients first, so that the server answers the requests in
+     * flight. */
+    if( runClients && ( ret == 0 ) )
+    {
+        LoadGenerator_Stop( &( clients[ 0 ] ), clientCount, &( clientStop ) );
+    }
+
+    elapsedNs = NowNs() - start;
+
+    if( runServer )
+    {
+        BindingServer_Stop( &( workers[ 0 ] ), workerCount, &( serverStop ) );
+        *pMpps = ReportServer( &( workers[ 0 ] ), workerCount, elapsedNs );
+    }
+
+    if( runClients && ( ret == 0 ) )
+    {
+        LoadGenerator_Report( &( clients[ 0 ] ), clientCount, elapsedNs );
+    }
+
+    return ret;
+}
+
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    Options_t options;
+    double mpps[ BINDING_SERVER_MAX_WORKERS ];
+    size_t workerCount;
+    int ret = 0;
+
+    if( ParseOptions( argc, argv, &( options ) ) != 0 )
+    {
+        return EXIT_FAILURE;
+    }
+
+    if( strcmp( options.pMode, "scale" ) != 0 )
+    {
+        ret = Run( &( options ), options.workerCount, options.clientCount, &( mpps[ 0 ] ) );
+    }
+    else
+    {
+        /* Runs the server and the load generator with 1 to -w workers, and
+         * -c clients per worker. */
+        options.pMode = "both";
+
+        for( workerCount = 1; ( ret == 0 ) && ( workerCount <= options.workerCount ); workerCount++ )
+        {
+            ret = Run( &( options ), workerCount, options.clientCount * workerCount, &( mpps[ workerCount - 1U ] ) );
+            printf( "\n" );
+        }
+
+        for( workerCount = 1; ( ret == 0 ) && ( workerCount <= options.workerCount ); workerCount++ )
+        {
+            printf( "Workers: %2zu, %.3f Mpps, %.2fx of 1 worker\n",
+                    workerCount, mpps[ workerCount - 1U ],
+                    ( mpps[ 0 ] > 0.0 ) ? mpps[ workerCount - 1U ] / mpps[ 0 ] : 0.0 );
+        }
+    }
+
+    return ( ret == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*-----------------------------------------------------------*/
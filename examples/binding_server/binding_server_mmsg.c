@@ -0,0 +1,161 @@
+/* Standard includes. */
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+/* Example includes. */
+#include "binding_server.h"
+
+/*-----------------------------------------------------------*/
+
+/* Buffers of a worker for one batch. The requests are answered in place: the
+ * response to request i goes out with the address request i came from. */
+typedef struct MmsgBatch
+{
+    struct mmsghdr requests[ BINDING_SERVER_MAX_BATCH ];
+    struct mmsghdr responses[ BINDING_SERVER_MAX_BATCH ];
+    struct iovec requestIoVecs[ BINDING_SERVER_MAX_BATCH ];
+    struct iovec responseIoVecs[ BINDING_SERVER_MAX_BATCH ];
+    struct sockaddr_in6 peers[ BINDING_SERVER_MAX_BATCH ];
+    uint8_t requestBuffers[ BINDING_SERVER_MAX_BATCH ][ BINDING_SERVER_REQUEST_LENGTH ];
+    uint8_t responseBuffers[ BINDING_SERVER_MAX_BATCH ][ BINDING_SERVER_RESPONSE_LENGTH ];
+} MmsgBatch_t;
+
+/*-----------------------------------------------------------*/
+
+/* Static Functions. */
+static void ResetRequests( MmsgBatch_t * pBatch,
+                           size_t requestCount );
+
+static void SendResponses( BindingServerWorker_t * pWorker,
+                           MmsgBatch_t * pBatch,
+                           unsigned int responseCount );
+
+/*-----------------------------------------------------------*/
+
+/* recvmmsg updates the address length and the flags of the requests it
+ * fills, so they are reset before the next call. */
+static void ResetRequests( MmsgBatch_t * pBatch,
+                           size_t requestCount )
+{
+    size_t i;
+
+    for( i = 0; i < requestCount; i++ )
+    {
+        pBatch->requestIoVecs[ i ].iov_base = &( pBatch->requestBuffers[ i ][ 0 ] );
+        pBatch->requestIoVecs[ i ].iov_len = BINDING_SERVER_REQUEST_LENGTH;
+        memset( &( pBatch->requests[ i ] ), 0, sizeof( struct mmsghdr ) );
+        pBatch->requests[ i ].msg_hdr.msg_name = &( pBatch->peers[ i ] );
+        pBatch->requests[ i ].msg_hdr.msg_namelen = sizeof( pBatch->peers[ i ] );
+        pBatch->requests[ i ].msg_hdr.msg_iov = &( pBatch->requestIoVecs[ i ] );
+        pBatch->requests[ i ].msg_hdr.msg_iovlen = 1;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+static void SendResponses( BindingServerWorker_t * pWorker,
+                           MmsgBatch_t * pBatch,
+                           unsigned int responseCount )
+{
+    unsigned int sentCount = 0;
+    int ret;
+
+    while( sentCount < responseCount )
+    {
+        ret = sendmmsg( pWorker->socketFd, &( pBatch->responses[ sentCount ] ), responseCount - sentCount, 0 );
+
+        if( ret > 0 )
+        {
+            sentCount += ( unsigned int ) ret;
+        }
+        else if( ( ret < 0 ) && ( errno == EINTR ) )
+        {
+            /* Retry. */
+        }
+        else
+        {
+            /* The socket buffer is full or the peer is gone, drop the rest
+             * as the network would. */
+            pWorker->droppedCount += responseCount - sentCount;
+            break;
+        }
+    }
+
+    pWorker->responseCount += sentCount;
+}
+
+/*-----------------------------------------------------------*/
+
+void * BindingServer_MmsgWorker( void * pArg )
+{
+    BindingServerWorker_t * pWorker = ( BindingServerWorker_t * ) pArg;
+    MmsgBatch_t * pBatch;
+    size_t batchSize = pWorker->pConfig->batchSize, responseLength;
+    unsigned int responseCount, i;
+    int receivedCount;
+
+    pBatch = malloc( sizeof( MmsgBatch_t ) );
+
+    if( pBatch != NULL )
+    {
+        ResetRequests( pBatch, batchSize );
+
+        while( __atomic_load_n( pWorker->pStop, __ATOMIC_ACQUIRE ) == 0 )
+        {
+            /* Blocks for the first datagram only, up to the receive timeout. */
+            receivedCount = recvmmsg( pWorker->socketFd, &( pBatch->requests[ 0 ] ), ( unsigned int ) batchSize, MSG_WAITFORONE, NULL );
+
+            if( receivedCount <= 0 )
+            {
+                continue;
+            }
+
+            pWorker->receiveCallCount++;
+            pWorker->requestCount += ( uint64_t ) receivedCount;
+            responseCount = 0;
+
+            for( i = 0; i < ( unsigned int ) receivedCount; i++ )
+            {
+                responseLength = 0;
+
+                if( ( pBatch->requests[ i ].msg_hdr.msg_flags & MSG_TRUNC ) == 0 )
+                {
+                    responseLength = BindingServer_HandleWorkerRequest( pWorker,
+                                                                        &( pBatch->requestBuffers[ i ][ 0 ] ),
+                                                                        pBatch->requests[ i ].msg_len,
+                                                                        ( const struct sockaddr * ) &( pBatch->peers[ i ] ),
+                                                                        &( pBatch->responseBuffers[ responseCount ][ 0 ] ),
+                                                                        BINDING_SERVER_RESPONSE_LENGTH );
+                }
+
+                if( responseLength == 0 )
+                {
+                    pWorker->droppedCount++;
+                }
+                else
+                {
+                    pBatch->responseIoVecs[ responseCount ].iov_base = &( pBatch->responseBuffers[ responseCount ][ 0 ] );
+                    pBatch->responseIoVecs[ responseCount ].iov_len = responseLength;
+                    memset( &( pBatch->responses[ responseCount ] ), 0, sizeof( struct mmsghdr ) );
+                    pBatch->responses[ responseCount ].msg_hdr.msg_name = &( pBatch->peers[ i ] );
+                    pBatch->responses[ responseCount ].msg_hdr.msg_namelen = pBatch->requests[ i ].msg_hdr.msg_namelen;
+                    pBatch->responses[ responseCount ].msg_hdr.msg_iov = &( pBatch->responseIoVecs[ responseCount ] );
+                    pBatch->responses[ responseCount ].msg_hdr.msg_iovlen = 1;
+                    responseCount++;
+                }
+            }
+
+            SendResponses( pWorker, pBatch, responseCount );
+            ResetRequests( pBatch, ( size_t ) receivedCount );
+        }
+
+        free( pBatch );
+    }
+
+    return NULL;
+}
+
+/*-----------------------------------------------------------*/
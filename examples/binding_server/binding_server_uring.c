@@ -0,0 +1,521 @@
+/* Standard includes. */
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+
+/* Example includes. */
+#include "binding_server.h"
+
+/*
+ * io_uring backend, driven with the raw system calls. One multishot recvmsg
+ * stays armed on the socket and takes its buffers from a provided buffer
+ * ring, so the kernel writes each datagram, with the peer address in front of
+ * it, straight into a buffer the codec then parses in place. Responses are
+ * written into registered buffers and sent to the peer address with
+ * IORING_OP_SEND_ZC, the send that takes a registered buffer.
+ */
+
+/* The SQ is larger than the number of sends in flight, so it never fills up
+ * between two calls to io_uring_enter. */
+#define URING_SQ_ENTRIES            512
+#define URING_CQ_ENTRIES            2048
+
+/* Provided receive buffers. Must be a power of 2. */
+#define URING_RECEIVE_BUFFER_COUNT  256
+#define URING_RECEIVE_BUFFER_GROUP  0
+
+/* Each receive buffer holds the recvmsg header, the peer address and the
+ * datagram. */
+#define URING_RECEIVE_BUFFER_LENGTH                                            \
+    ( sizeof( struct io_uring_recvmsg_out ) + sizeof( struct sockaddr_in6 ) + \
+      BINDING_SERVER_REQUEST_LENGTH )
+
+/* Registered send buffers, one response each. */
+#define URING_SEND_SLOT_COUNT       256
+
+#define URING_RECEIVE_USER_DATA     UINT64_MAX
+
+/*-----------------------------------------------------------*/
+
+typedef struct UringSendSlot
+{
+    struct sockaddr_in6 peer;
+    uint8_t response[ BINDING_SERVER_RESPONSE_LENGTH ];
+} UringSendSlot_t;
+
+typedef struct Uring
+{
+    int ringFd;
+
+    /* Submission and completion rings, mapped together. */
+    void * pRings;
+    size_t ringsLength;
+    uint32_t * pSqHead;
+    uint32_t * pSqTail;
+    uint32_t * pSqArray;
+    uint32_t sqMask;
+    uint32_t sqEntries;
+    uint32_t sqTail;
+    struct io_uring_sqe * pSqes;
+    size_t sqesLength;
+    uint32_t * pCqHead;
+    uint32_t * pCqTail;
+    uint32_t cqMask;
+    struct io_uring_cqe * pCqes;
+
+    /* Provided buffer ring and the receive buffers it hands out. */
+    struct io_uring_buf_ring * pBufferRing;
+    size_t bufferRingLength;
+    uint8_t * pReceiveBuffers;
+    uint16_t bufferTail;
+    struct msghdr receiveHeader;
+
+    /* Registered send buffers and the stack of free ones. */
+    UringSendSlot_t * pSendSlots;
+    uint16_t freeSlots[ URING_SEND_SLOT_COUNT ];
+    size_t freeSlotCount;
+} Uring_t;
+
+/*-----------------------------------------------------------*/
+
+/* Static Functions. */
+static int UringInit( Uring_t * pUring,
+                      int socketFd );
+
+static int UringSupportsSendZc( int ringFd );
+
+static void UringDeinit( Uring_t * pUring );
+
+static struct io_uring_sqe * GetSqe( Uring_t * pUring );
+
+static void ArmReceive( Uring_t * pUring,
+                        int socketFd );
+
+static void RecycleBuffer( Uring_t * pUring,
+                           uint16_t bufferId );
+
+static void HandleReceive( BindingServerWorker_t * pWorker,
+                           Uring_t * pUring,
+                           const struct io_uring_cqe * pCqe );
+
+static void HandleSend( BindingServerWorker_t * pWorker,
+                        Uring_t * pUring,
+                        const struct io_uring_cqe * pCqe );
+
+/*-----------------------------------------------------------*/
+
+static int UringInit( Uring_t * pUring,
+                      int socketFd )
+{
+    int ret = 0;
+    struct io_uring_params params;
+    struct io_uring_buf_reg bufferRegistration;
+    struct iovec sendBuffers;
+    size_t sqRingLength, cqRingLength;
+    uint16_t i;
+
+    memset( pUring, 0, sizeof( Uring_t ) );
+    pUring->ringFd = -1;
+    pUring->pRings = MAP_FAILED;
+    pUring->pSqes = MAP_FAILED;
+    pUring->pBufferRing = MAP_FAILED;
+
+    /* A ring with a single submitter that runs completion work only when the
+     * worker waits, as the worker does nothing else. Older kernels get a
+     * plain ring. */
+    memset( &( params ), 0, sizeof( params ) );
+    params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN;
+    params.cq_entries = URING_CQ_ENTRIES;
+    pUring->ringFd = ( int ) syscall( __NR_io_uring_setup, URING_SQ_ENTRIES, &( params ) );
+
+    if( pUring->ringFd < 0 )
+    {
+        memset( &( params ), 0, sizeof( params ) );
+        params.flags = IORING_SETUP_CQSIZE;
+        params.cq_entries = URING_CQ_ENTRIES;
+        pUring->ringFd = ( int ) syscall( __NR_io_uring_setup, URING_SQ_ENTRIES, &( params ) );
+    }
+
+    /* The wait with a timeout needs IORING_FEAT_EXT_ARG, which also implies
+     * that both rings are in one mapping. Kernels with IORING_OP_SEND_ZC also
+     * have the multishot recvmsg. */
+    if( ( pUring->ringFd < 0 ) ||
+        ( ( params.features & IORING_FEAT_EXT_ARG ) == 0 ) ||
+        ( UringSupportsSendZc( pUring->ringFd ) == 0 ) )
+    {
+        ret = -1;
+    }
+
+    if( ret == 0 )
+    {
+        sqRingLength = params.sq_off.array + ( params.sq_entries * sizeof( uint32_t ) );
+        cqRingLength = params.cq_off.cqes + ( params.cq_entries * sizeof( struct io_uring_cqe ) );
+        pUring->ringsLength = ( sqRingLength > cqRingLength ) ? sqRingLength : cqRingLength;
+        pUring->sqesLength = params.sq_entries * sizeof( struct io_uring_sqe );
+
+        pUring->pRings = mmap( NULL, pUring->ringsLength, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                               pUring->ringFd, IORING_OFF_SQ_RING );
+        pUring->pSqes = mmap( NULL, pUring->sqesLength, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                              pUring->ringFd, IORING_OFF_SQES );
+
+        if( ( pUring->pRings == MAP_FAILED ) || ( pUring->pSqes == MAP_FAILED ) )
+        {
+            ret = -1;
+        }
+    }
+
+    if( ret == 0 )
+    {
+        pUring->pSqHead = ( uint32_t * ) ( ( uint8_t * ) pUring->pRings + params.sq_off.head );
+        pUring->pSqTail = ( uint32_t * ) ( ( uint8_t * ) pUring->pRings + params.sq_off.tail );
+        pUring->pSqArray = ( uint32_t * ) ( ( uint8_t * ) pUring->pRings + params.sq_off.array );
+        pUring->sqMask = *( ( uint32_t * ) ( ( uint8_t * ) pUring->pRings + params.sq_off.ring_mask ) );
+        pUring->sqEntries = params.sq_entries;
+        pUring->sqTail = *( pUring->pSqTail );
+        pUring->pCqHead = ( uint32_t * ) ( ( uint8_t * ) pUring->pRings + params.cq_off.head );
+        pUring->pCqTail = ( uint32_t * ) ( ( uint8_t * ) pUring->pRings + params.cq_off.tail );
+        pUring->cqMask = *( ( uint32_t * ) ( ( uint8_t * ) pUring->pRings + params.cq_off.ring_mask ) );
+        pUring->pCqes = ( struct io_uring_cqe * ) ( ( uint8_t * ) pUring->pRings + params.cq_off.cqes );
+
+        /* The buffer ring must be page aligned, so it is mapped, and the
+         * receive buffers follow it in the same mapping. */
+        pUring->bufferRingLength = ( URING_RECEIVE_BUFFER_COUNT * sizeof( struct io_uring_buf ) ) +
+                                   ( URING_RECEIVE_BUFFER_COUNT * URING_RECEIVE_BUFFER_LENGTH );
+        pUring->pBufferRing = mmap( NULL, pUring->bufferRingLength, PROT_READ | PROT_WRITE,
+                                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0 );
+        pUring->pSendSlots = malloc( URING_SEND_SLOT_COUNT * sizeof( UringSendSlot_t ) );
+
+        if( ( pUring->pBufferRing == MAP_FAILED ) || ( pUring->pSendSlots == NULL ) )
+        {
+            ret = -1;
+        }
+    }
+
+    if( ret == 0 )
+    {
+        pUring->pReceiveBuffers = ( uint8_t * ) pUring->pBufferRing + ( URING_RECEIVE_BUFFER_COUNT * sizeof( struct io_uring_buf ) );
+
+        memset( &( bufferRegistration ), 0, sizeof( bufferRegistration ) );
+        bufferRegistration.ring_addr = ( uint64_t ) ( uintptr_t ) pUring->pBufferRing;
+        bufferRegistration.ring_entries = URING_RECEIVE_BUFFER_COUNT;
+        bufferRegistration.bgid = URING_RECEIVE_BUFFER_GROUP;
+
+        sendBuffers.iov_base = pUring->pSendSlots;
+        sendBuffers.iov_len = URING_SEND_SLOT_COUNT * sizeof( UringSendSlot_t );
+
+        if( ( syscall( __NR_io_uring_register, pUring->ringFd, IORING_REGISTER_PBUF_RING, &( bufferRegistration ), 1 ) != 0 ) ||
+            ( syscall( __NR_io_uring_register, pUring->ringFd, IORING_REGISTER_BUFFERS, &( sendBuffers ), 1 ) != 0 ) )
+        {
+            ret = -1;
+        }
+    }
+
+    if( ret == 0 )
+    {
+        for( i = 0; i < URING_RECEIVE_BUFFER_COUNT; i++ )
+        {
+            RecycleBuffer( pUring, i );
+        }
+
+        __atomic_store_n( &( pUring->pBufferRing->tail ), pUring->bufferTail, __ATOMIC_RELEASE );
+
+        for( i = 0; i < URING_SEND_SLOT_COUNT; i++ )
+        {
+            pUring->freeSlots[ i ] = ( uint16_t ) ( URING_SEND_SLOT_COUNT - 1 - i );
+        }
+
+        pUring->freeSlotCount = URING_SEND_SLOT_COUNT;
+
+        /* Only the lengths are used by a multishot recvmsg, to lay out the
+         * receive buffers. */
+        pUring->receiveHeader.msg_namelen = sizeof( struct sockaddr_in6 );
+        pUring->receiveHeader.msg_controllen = 0;
+
+        ArmReceive( pUring, socketFd );
+    }
+    else
+    {
+        UringDeinit( pUring );
+    }
+
+    return ret;
+}
+
+/*-----------------------------------------------------------*/
+
+static int UringSupportsSendZc( int ringFd )
+{
+    int supported = 0;
+    struct io_uring_probe * pProbe;
+
+    pProbe = calloc( 1, sizeof( struct io_uring_probe ) + ( 256 * sizeof( struct io_uring_probe_op ) ) );
+
+    if( pProbe != NULL )
+    {
+        if( ( syscall( __NR_io_uring_register, ringFd, IORING_REGISTER_PROBE, pProbe, 256 ) == 0 ) &&
+            ( pProbe->last_op >= IORING_OP_SEND_ZC ) &&
+            ( ( pProbe->ops[ IORING_OP_SEND_ZC ].flags & IO_URING_OP_SUPPORTED ) != 0 ) )
+        {
+            supported = 1;
+        }
+
+        free( pProbe );
+    }
+
+    return supported;
+}
+
+/*-----------------------------------------------------------*/
+
+static void UringDeinit( Uring_t * pUring )
+{
+    if( pUring->ringFd >= 0 )
+    {
+        close( pUring->ringFd );
+    }
+
+    if( pUring->pRings != MAP_FAILED )
+    {
+        munmap( pUring->pRings, pUring->ringsLength );
+    }
+
+    if( pUring->pSqes != MAP_FAILED )
+    {
+        munmap( pUring->pSqes, pUring->sqesLength );
+    }
+
+    if( pUring->pBufferRing != MAP_FAILED )
+    {
+        munmap( pUring->pBufferRing, pUring->bufferRingLength );
+    }
+
+    free( pUring->pSendSlots );
+}
+
+/*-----------------------------------------------------------*/
+
+/* The SQ holds more entries than can be queued between two submissions, so
+ * there is always room. The tail is published before io_uring_enter. */
+static struct io_uring_sqe * GetSqe( Uring_t * pUring )
+{
+    struct io_uring_sqe * pSqe;
+    uint32_t index = pUring->sqTail & pUring->sqMask;
+
+    pSqe = &( pUring->pSqes[ index ] );
+    memset( pSqe, 0, sizeof( struct io_uring_sqe ) );
+    pUring->pSqArray[ index ] = index;
+    pUring->sqTail++;
+
+    return pSqe;
+}
+
+/*-----------------------------------------------------------*/
+
+static void ArmReceive( Uring_t * pUring,
+                        int socketFd )
+{
+    struct io_uring_sqe * pSqe = GetSqe( pUring );
+
+    pSqe->opcode = IORING_OP_RECVMSG;
+    pSqe->fd = socketFd;
+    pSqe->addr = ( uint64_t ) ( uintptr_t ) &( pUring->receiveHeader );
+    pSqe->ioprio = IORING_RECV_MULTISHOT;
+    pSqe->flags = IOSQE_BUFFER_SELECT;
+    pSqe->buf_group = URING_RECEIVE_BUFFER_GROUP;
+    pSqe->user_data = URING_RECEIVE_USER_DATA;
+}
+
+/*-----------------------------------------------------------*/
+
+/* The kernel sees the buffer once the ring tail is published. */
+static void RecycleBuffer( Uring_t * pUring,
+                           uint16_t bufferId )
+{
+    struct io_uring_buf * pBuffer;
+
+    pBuffer = &( pUring->pBufferRing->bufs[ pUring->bufferTail & ( URING_RECEIVE_BUFFER_COUNT - 1 ) ] );
+    pBuffer->addr = ( uint64_t ) ( uintptr_t ) &( pUring->pReceiveBuffers[ ( size_t ) bufferId * URING_RECEIVE_BUFFER_LENGTH ] );
+    pBuffer->len = URING_RECEIVE_BUFFER_LENGTH;
+    pBuffer->bid = bufferId;
+    pUring->bufferTail++;
+}
+
+/*-----------------------------------------------------------*/
+
+static void HandleReceive( BindingServerWorker_t * pWorker,
+                           Uring_t * pUring,
+                           const struct io_uring_cqe * pCqe )
+{
+    struct io_uring_recvmsg_out * pOut;
+    struct io_uring_sqe * pSqe;
+    UringSendSlot_t * pSlot = NULL;
+    uint8_t * pBuffer, * pPayload;
+    uint16_t bufferId, slot = 0;
+    size_t responseLength = 0;
+
+    if( ( pCqe->flags & IORING_CQE_F_BUFFER ) != 0 )
+    {
+        bufferId = ( uint16_t ) ( pCqe->flags >> IORING_CQE_BUFFER_SHIFT );
+        pBuffer = &( pUring->pReceiveBuffers[ ( size_t ) bufferId * URING_RECEIVE_BUFFER_LENGTH ] );
+        pOut = ( struct io_uring_recvmsg_out * ) pBuffer;
+        pPayload = pBuffer + sizeof( struct io_uring_recvmsg_out ) + pUring->receiveHeader.msg_namelen + pUring->receiveHeader.msg_controllen;
+
+        pWorker->requestCount++;
+
+        if( ( pCqe->res > 0 ) &&
+            ( ( pOut->flags & MSG_TRUNC ) == 0 ) &&
+            ( pOut->namelen <= pUring->receiveHeader.msg_namelen ) &&
+            ( pUring->freeSlotCount > 0 ) )
+        {
+            slot = pUring->freeSlots[ pUring->freeSlotCount - 1 ];
+            pSlot = &( pUring->pSendSlots[ slot ] );
+
+            responseLength = BindingServer_HandleWorkerRequest( pWorker,
+                                                                pPayload,
+                                                                pOut->payloadlen,
+                                                                ( const struct sockaddr * ) ( pOut + 1 ),
+                                                                &( pSlot->response[ 0 ] ),
+                                                                BINDING_SERVER_RESPONSE_LENGTH );
+        }
+
+        if( responseLength == 0 )
+        {
+            pWorker->droppedCount++;
+        }
+        else
+        {
+            pUring->freeSlotCount--;
+            memcpy( &( pSlot->peer ), pOut + 1, pOut->namelen );
+
+            pSqe = GetSqe( pUring );
+            pSqe->opcode = IORING_OP_SEND_ZC;
+            pSqe->fd = pWorker->socketFd;
+            pSqe->addr = ( uint64_t ) ( uintptr_t ) &( pSlot->response[ 0 ] );
+            pSqe->len = ( uint32_t ) responseLength;
+            pSqe->ioprio = IORING_RECVSEND_FIXED_BUF;
+            pSqe->buf_index = 0;
+            pSqe->addr2 = ( uint64_t ) ( uintptr_t ) &( pSlot->peer );
+            pSqe->addr_len = ( uint16_t ) pOut->namelen;
+            pSqe->user_data = slot;
+        }
+
+        /* The request has been parsed in place and the peer address copied,
+         * so the buffer goes back to the kernel. */
+        RecycleBuffer( pUring, bufferId );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+static void HandleSend( BindingServerWorker_t * pWorker,
+                        Uring_t * pUring,
+                        const struct io_uring_cqe * pCqe )
+{
+    if( ( pCqe->flags & IORING_CQE_F_NOTIF ) != 0 )
+    {
+        /* Notification that the kernel is done with the buffer. */
+    }
+    else if( pCqe->res >= 0 )
+    {
+        pWorker->responseCount++;
+    }
+    else
+    {
+        /* The socket buffer is full, drop the response as the network
+         * would. */
+        pWorker->droppedCount++;
+    }
+
+    /* With IORING_CQE_F_MORE set the buffer is still in use, and a
+     * notification follows. */
+    if( ( pCqe->flags & IORING_CQE_F_MORE ) == 0 )
+    {
+        pUring->freeSlots[ pUring->freeSlotCount ] = ( uint16_t ) pCqe->user_data;
+        pUring->freeSlotCount++;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+void * BindingServer_UringWorker( void * pArg )
+{
+    BindingServerWorker_t * pWorker = ( BindingServerWorker_t * ) pArg;
+    Uring_t uring;
+    struct io_uring_getevents_arg waitArg;
+    struct __kernel_timespec timeout;
+    const struct io_uring_cqe * pCqe;
+    uint32_t cqHead, cqTail, toSubmit;
+    int rearm;
+
+    if( UringInit( &( uring ), pWorker->socketFd ) != 0 )
+    {
+        fprintf( stderr, "Worker %zu: io_uring is not available, using recvmmsg.\n", pWorker->index );
+
+        return BindingServer_MmsgWorker( pArg );
+    }
+
+    timeout.tv_sec = 0;
+    timeout.tv_nsec = BINDING_SERVER_RECEIVE_TIMEOUT_MS * 1000000LL;
+    memset( &( waitArg ), 0, sizeof( waitArg ) );
+    waitArg.ts = ( uint64_t ) ( uintptr_t ) &( timeout );
+
+    while( __atomic_load_n( pWorker->pStop, __ATOMIC_ACQUIRE ) == 0 )
+    {
+        /* Submits the sends queued by the last batch and waits for at least
+         * one completion, up to the receive timeout. */
+        __atomic_store_n( uring.pSqTail, uring.sqTail, __ATOMIC_RELEASE );
+        toSubmit = uring.sqTail - __atomic_load_n( uring.pSqHead, __ATOMIC_ACQUIRE );
+
+        ( void ) syscall( __NR_io_uring_enter, uring.ringFd, toSubmit, 1,
+                          IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &( waitArg ), sizeof( waitArg ) );
+        pWorker->receiveCallCount++;
+
+        cqHead = *( uring.pCqHead );
+        cqTail = __atomic_load_n( uring.pCqTail, __ATOMIC_ACQUIRE );
+        rearm = 0;
+
+        while( cqHead != cqTail )
+        {
+            pCqe = &( uring.pCqes[ cqHead & uring.cqMask ] );
+
+            if( pCqe->user_data == URING_RECEIVE_USER_DATA )
+            {
+                HandleReceive( pWorker, &( uring ), pCqe );
+
+                /* The multishot receive ends when it runs out of buffers or
+                 * fails, and is armed again. */
+                if( ( pCqe->flags & IORING_CQE_F_MORE ) == 0 )
+                {
+                    rearm = 1;
+                }
+            }
+            else
+            {
+                HandleSend( pWorker, &( uring ), pCqe );
+            }
+
+            cqHead++;
+        }
+
+        __atomic_store_n( uring.pCqHead, cqHead, __ATOMIC_RELEASE );
+        __atomic_store_n( &( uring.pBufferRing->tail ), uring.bufferTail, __ATOMIC_RELEASE );
+
+        if( rearm != 0 )
+        {
+            ArmReceive( &( uring ), pWorker->socketFd );
+        }
+    }
+
+    UringDeinit( &( uring ) );
+
+    return NULL;
+}
+
+/*-----------------------------------------------------------*/
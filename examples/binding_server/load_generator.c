@@ -0,0 +1,381 @@
+/* Standard includes. */
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+/* API includes. */
+#include "stun_serializer.h"
+#include "stun_message_template.h"
+
+/* Example includes. */
+#include "load_generator.h"
+
+#define LOAD_GENERATOR_MAX_BATCH        64
+#define LOAD_GENERATOR_REQUEST_LENGTH   64
+#define LOAD_GENERATOR_RESPONSE_LENGTH  128
+
+/*
+ * Transaction ID of the requests:
+ *   0 - 1   index of the request in the batch
+ *   2 - 3   batch sequence number, to tell late responses apart
+ *   4 - 11  send time in nanoseconds
+ */
+#define LOAD_GENERATOR_SEQUENCE_OFFSET  2
+#define LOAD_GENERATOR_SEND_TIME_OFFSET 4
+
+/*-----------------------------------------------------------*/
+
+typedef struct ClientBatch
+{
+    struct mmsghdr requests[ LOAD_GENERATOR_MAX_BATCH ];
+    struct mmsghdr responses[ LOAD_GENERATOR_MAX_BATCH ];
+    struct iovec requestIoVecs[ LOAD_GENERATOR_MAX_BATCH ];
+    struct iovec responseIoVecs[ LOAD_GENERATOR_MAX_BATCH ];
+    uint8_t requestBuffers[ LOAD_GENERATOR_MAX_BATCH ][ LOAD_GENERATOR_REQUEST_LENGTH ];
+    uint8_t responseBuffers[ LOAD_GENERATOR_MAX_BATCH ][ LOAD_GENERATOR_RESPONSE_LENGTH ];
+} ClientBatch_t;
+
+/*-----------------------------------------------------------*/
+
+/* Static Functions. */
+static uint64_t NowNs( void );
+
+static int CompareUint64( const void * pLeft,
+                          const void * pRight );
+
+static int OpenClientSocket( const LoadGeneratorConfig_t * pConfig );
+
+static int InitRequestTemplate( StunMessageTemplate_t * pTemplate,
+                                uint8_t * pBuffer,
+                                size_t bufferLength );
+
+static void ReceiveResponses( LoadGeneratorClient_t * pClient,
+                              int socketFd,
+                              ClientBatch_t * pBatch,
+                              size_t sentCount,
+                              uint16_t sequence );
+
+static void * ClientThread( void * pArg );
+
+/*-----------------------------------------------------------*/
+
+static uint64_t NowNs( void )
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &( ts ) );
+
+    return ( ( uint64_t ) ts.tv_sec * 1000000000ULL ) + ( uint64_t ) ts.tv_nsec;
+}
+
+/*-----------------------------------------------------------*/
+
+static int CompareUint64( const void * pLeft,
+                          const void * pRight )
+{
+    uint64_t left = *( const uint64_t * ) pLeft, right = *( const uint64_t * ) pRight;
+
+    return ( left > right ) - ( left < right );
+}
+
+/*-----------------------------------------------------------*/
+
+static int OpenClientSocket( const LoadGeneratorConfig_t * pConfig )
+{
+    int socketFd;
+    struct timeval timeout;
+
+    timeout.tv_sec = 0;
+    timeout.tv_usec = LOAD_GENERATOR_RECEIVE_TIMEOUT_MS * 1000;
+
+    socketFd = socket( AF_INET, SOCK_DGRAM, 0 );
+
+    if( socketFd >= 0 )
+    {
+        if( ( setsockopt( socketFd, SOL_SOCKET, SO_RCVTIMEO, &( timeout ), sizeof( timeout ) ) != 0 ) ||
+            ( connect( socketFd, ( const struct sockaddr * ) &( pConfig->serverAddress ), sizeof( pConfig->serverAddress ) ) != 0 ) )
+        {
+            perror( "Load generator socket" );
+            close( socketFd );
+            socketFd = -1;
+        }
+    }
+
+    return socketFd;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Binding Request with FINGERPRINT. Only the transaction ID and FINGERPRINT
+ * change between requests. */
+static int InitRequestTemplate( StunMessageTemplate_t * pTemplate,
+                                uint8_t * pBuffer,
+                                size_t bufferLength )
+{
+    StunContext_t ctx;
+    StunHeader_t header;
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] = { 0 };
+    size_t messageLength = 0;
+    StunResult_t result;
+
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    result = StunSerializer_Init( &( ctx ), pBuffer, bufferLength, &( header ) );
+
+    if( result == STUN_RESULT_OK )
+    {
+        result = StunSerializer_AddComputedFingerprint( &( ctx ) );
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        result = StunSerializer_Finalize( &( ctx ), &( messageLength ) );
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        result = StunMessageTemplate_Init( pTemplate, pBuffer, messageLength );
+    }
+
+    return ( result == STUN_RESULT_OK ) ? 0 : -1;
+}
+
+/*-----------------------------------------------------------*/
+
+static void ReceiveResponses( LoadGeneratorClient_t * pClient,
+                              int socketFd,
+                              ClientBatch_t * pBatch,
+                              size_t sentCount,
+                              uint16_t sequence )
+{
+    size_t receivedCount = 0;
+    int ret, i;
+    uint64_t now, sendTime;
+    uint16_t responseSequence;
+    const uint8_t * pResponse;
+
+    while( receivedCount < sentCount )
+    {
+        ret = recvmmsg( socketFd, &( pBatch->responses[ 0 ] ), ( unsigned int ) ( sentCount - receivedCount ), MSG_WAITFORONE, NULL );
+
+        if( ( ret < 0 ) && ( errno == EINTR ) )
+        {
+            continue;
+        }
+        else if( ret <= 0 )
+        {
+            pClient->lostCount += sentCount - receivedCount;
+            break;
+        }
+
+        now = NowNs();
+
+        for( i = 0; i < ret; i++ )
+        {
+            pResponse = &( pBatch->responseBuffers[ i ][ 0 ] );
+            memcpy( &( responseSequence ), &( pResponse[ STUN_HEADER_TRANSACTION_ID_OFFSET + LOAD_GENERATOR_SEQUENCE_OFFSET ] ), sizeof( responseSequence ) );
+
+            /* Late responses of a previous batch were already counted as
+             * lost. */
+            if( ( pBatch->responses[ i ].msg_len >= STUN_HEADER_LENGTH ) &&
+                ( pResponse[ 0 ] == ( STUN_MESSAGE_TYPE_BINDING_SUCCESS_RESPONSE >> 8 ) ) &&
+                ( pResponse[ 1 ] == ( STUN_MESSAGE_TYPE_BINDING_SUCCESS_RESPONSE & 0xFF ) ) &&
+                ( responseSequence == sequence ) )
+            {
+                memcpy( &( sendTime ), &( pResponse[ STUN_HEADER_TRANSACTION_ID_OFFSET + LOAD_GENERATOR_SEND_TIME_OFFSET ] ), sizeof( sendTime ) );
+                pClient->pLatenciesNs[ pClient->latencyCount % LOAD_GENERATOR_LATENCY_CAPACITY ] = now - sendTime;
+                pClient->latencyCount++;
+                receivedCount++;
+            }
+        }
+    }
+
+    pClient->receivedCount += receivedCount;
+}
+
+/*-----------------------------------------------------------*/
+
+static void * ClientThread( void * pArg )
+{
+    LoadGeneratorClient_t * pClient = ( LoadGeneratorClient_t * ) pArg;
+    size_t batchSize = pClient->pConfig->batchSize, messageLength, i;
+    uint8_t templateBuffer[ LOAD_GENERATOR_REQUEST_LENGTH ];
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] = { 0 };
+    StunMessageTemplate_t requestTemplate;
+    StunMessageTemplateFields_t fields = { 0 };
+    ClientBatch_t * pBatch;
+    uint16_t sequence = 0, index;
+    uint64_t sendTime;
+    int socketFd, ret;
+
+    socketFd = OpenClientSocket( pClient->pConfig );
+    pBatch = calloc( 1, sizeof( ClientBatch_t ) );
+
+    if( ( socketFd >= 0 ) &&
+        ( pBatch != NULL ) &&
+        ( InitRequestTemplate( &( requestTemplate ), &( templateBuffer[ 0 ] ), sizeof( templateBuffer ) ) == 0 ) )
+    {
+        for( i = 0; i < batchSize; i++ )
+        {
+            pBatch->requestIoVecs[ i ].iov_base = &( pBatch->requestBuffers[ i ][ 0 ] );
+            pBatch->requests[ i ].msg_hdr.msg_iov = &( pBatch->requestIoVecs[ i ] );
+            pBatch->requests[ i ].msg_hdr.msg_iovlen = 1;
+            pBatch->responseIoVecs[ i ].iov_base = &( pBatch->responseBuffers[ i ][ 0 ] );
+            pBatch->responseIoVecs[ i ].iov_len = LOAD_GENERATOR_RESPONSE_LENGTH;
+            pBatch->responses[ i ].msg_hdr.msg_iov = &( pBatch->responseIoVecs[ i ] );
+            pBatch->responses[ i ].msg_hdr.msg_iovlen = 1;
+        }
+
+        fields.pTransactionId = &( transactionId[ 0 ] );
+
+        while( __atomic_load_n( pClient->pStop, __ATOMIC_ACQUIRE ) == 0 )
+        {
+            sequence++;
+            sendTime = NowNs();
+            memcpy( &( transactionId[ LOAD_GENERATOR_SEQUENCE_OFFSET ] ), &( sequence ), sizeof( sequence ) );
+            memcpy( &( transactionId[ LOAD_GENERATOR_SEND_TIME_OFFSET ] ), &( sendTime ), sizeof( sendTime ) );
+
+            for( i = 0; i < batchSize; i++ )
+            {
+                index = ( uint16_t ) i;
+                memcpy( &( transactionId[ 0 ] ), &( index ), sizeof( index ) );
+                ( void ) StunMessageTemplate_Stamp( &( requestTemplate ), &( fields ), NULL,
+                                                    &( pBatch->requestBuffers[ i ][ 0 ] ), LOAD_GENERATOR_REQUEST_LENGTH,
+                                                    &( messageLength ) );
+                pBatch->requestIoVecs[ i ].iov_len = messageLength;
+            }
+
+            ret = sendmmsg( socketFd, &( pBatch->requests[ 0 ] ), ( unsigned int ) batchSize, 0 );
+
+            if( ret > 0 )
+            {
+                pClient->sentCount += ( uint64_t ) ret;
+                ReceiveResponses( pClient, socketFd, pBatch, ( size_t ) ret, sequence );
+            }
+        }
+    }
+
+    free( pBatch );
+
+    if( socketFd >= 0 )
+    {
+        close( socketFd );
+    }
+
+    return NULL;
+}
+
+/*-----------------------------------------------------------*/
+
+int LoadGenerator_Start( const LoadGeneratorConfig_t * pConfig,
+                         LoadGeneratorClient_t * pClients,
+                         int * pStop )
+{
+    int ret = 0;
+    size_t i;
+
+    __atomic_store_n( pStop, 0, __ATOMIC_RELAXED );
+
+    for( i = 0; ( ret == 0 ) && ( i < pConfig->clientCount ); i++ )
+    {
+        memset( &( pClients[ i ] ), 0, sizeof( LoadGeneratorClient_t ) );
+        pClients[ i ].pConfig = pConfig;
+        pClients[ i ].index = i;
+        pClients[ i ].pStop = pStop;
+        pClients[ i ].pLatenciesNs = malloc( LOAD_GENERATOR_LATENCY_CAPACITY * sizeof( uint64_t ) );
+
+        if( ( pClients[ i ].pLatenciesNs == NULL ) ||
+            ( pthread_create( &( pClients[ i ].thread ), NULL, ClientThread, &( pClients[ i ] ) ) != 0 ) )
+        {
+            free( pClients[ i ].pLatenciesNs );
+            LoadGenerator_Stop( pClients, i, pStop );
+            ret = -1;
+        }
+    }
+
+    return ret;
+}
+
+/*-----------------------------------------------------------*/
+
+void LoadGenerator_Stop( LoadGeneratorClient_t * pClients,
+                         size_t clientCount,
+                         int * pStop )
+{
+    size_t i;
+
+    __atomic_store_n( pStop, 1, __ATOMIC_RELEASE );
+
+    for( i = 0; i < clientCount; i++ )
+    {
+        pthread_join( pClients[ i ].thread, NULL );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+void LoadGenerator_Report( LoadGeneratorClient_t * pClients,
+                           size_t clientCount,
+                           uint64_t elapsedNs )
+{
+    uint64_t sentCount = 0, receivedCount = 0, lostCount = 0;
+    uint64_t * pLatenciesNs;
+    size_t sampleCount = 0, clientSampleCount, i;
+    const double percentiles[] = { 0.5, 0.9, 0.99, 0.999 };
+
+    for( i = 0; i < clientCount; i++ )
+    {
+        sentCount += pClients[ i ].sentCount;
+        receivedCount += pClients[ i ].receivedCount;
+        lostCount += pClients[ i ].lostCount;
+        sampleCount += ( pClients[ i ].latencyCount < LOAD_GENERATOR_LATENCY_CAPACITY ) ? pClients[ i ].latencyCount :
+                       LOAD_GENERATOR_LATENCY_CAPACITY;
+    }
+
+    printf( "Clients: %zu sent, %zu received, %zu lost, %.3f Mpps\n",
+            ( size_t ) sentCount, ( size_t ) receivedCount, ( size_t ) lostCount,
+            ( double ) receivedCount * 1e3 / ( double ) elapsedNs );
+
+    pLatenciesNs = malloc( ( sampleCount + 1U ) * sizeof( uint64_t ) );
+
+    if( ( pLatenciesNs != NULL ) && ( sampleCount > 0U ) )
+    {
+        sampleCount = 0;
+
+        for( i = 0; i < clientCount; i++ )
+        {
+            clientSampleCount = ( pClients[ i ].latencyCount < LOAD_GENERATOR_LATENCY_CAPACITY ) ? pClients[ i ].latencyCount :
+                                LOAD_GENERATOR_LATENCY_CAPACITY;
+            memcpy( &( pLatenciesNs[ sampleCount ] ), pClients[ i ].pLatenciesNs, clientSampleCount * sizeof( uint64_t ) );
+            sampleCount += clientSampleCount;
+        }
+
+        qsort( pLatenciesNs, sampleCount, sizeof( uint64_t ), CompareUint64 );
+
+        printf( "Latency:" );
+
+        for( i = 0; i < sizeof( percentiles ) / sizeof( percentiles[ 0 ] ); i++ )
+        {
+            printf( " p%g %.1f us,", percentiles[ i ] * 100.0,
+                    ( double ) pLatenciesNs[ ( size_t ) ( percentiles[ i ] * ( double ) ( sampleCount - 1U ) ) ] / 1e3 );
+        }
+
+        printf( " max %.1f us\n", ( double ) pLatenciesNs[ sampleCount - 1U ] / 1e3 );
+    }
+
+    free( pLatenciesNs );
+
+    for( i = 0; i < clientCount; i++ )
+    {
+        free( pClients[ i ].pLatenciesNs );
+        pClients[ i ].pLatenciesNs = NULL;
+    }
+}
+
+/*-----------------------------------------------------------*/
@@ -0,0 +1,64 @@
+#ifndef LOAD_GENERATOR_H
+#define LOAD_GENERATOR_H
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+#include <netinet/in.h>
+
+/*
+ * Loopback load generator for the binding server. Each client thread owns a
+ * connected UDP socket, so the server sees one 5-tuple per client. A client
+ * sends a batch of Binding Requests with sendmmsg and waits for the responses
+ * with recvmmsg before sending the next batch. The send time is carried in the
+ * transaction ID, so the latency of each response is measured without keeping
+ * state per request.
+ */
+
+#define LOAD_GENERATOR_MAX_CLIENTS          64
+
+/* Latency samples kept per client. Later samples overwrite the oldest. */
+#define LOAD_GENERATOR_LATENCY_CAPACITY     ( 1U << 18 )
+
+/* Responses not received within this time are counted as lost. */
+#define LOAD_GENERATOR_RECEIVE_TIMEOUT_MS   100
+
+typedef struct LoadGeneratorConfig
+{
+    struct sockaddr_in serverAddress;
+    size_t clientCount;
+    size_t batchSize;
+} LoadGeneratorConfig_t;
+
+typedef struct LoadGeneratorClient
+{
+    const LoadGeneratorConfig_t * pConfig;
+    size_t index;
+    int * pStop;
+    pthread_t thread;
+    /* Written by the client, read once it has stopped. */
+    uint64_t sentCount;
+    uint64_t receivedCount;
+    uint64_t lostCount;
+    uint64_t * pLatenciesNs;
+    size_t latencyCount;
+} LoadGeneratorClient_t;
+
+/* Starts pConfig->clientCount clients. Returns 0 on success. */
+int LoadGenerator_Start( const LoadGeneratorConfig_t * pConfig,
+                         LoadGeneratorClient_t * pClients,
+                         int * pStop );
+
+/* Sets *pStop and waits for the clients. */
+void LoadGenerator_Stop( LoadGeneratorClient_t * pClients,
+                         size_t clientCount,
+                         int * pStop );
+
+/* Prints the totals and the latency percentiles of the clients, and frees
+ * their samples. */
+void LoadGenerator_Report( LoadGeneratorClient_t * pClients,
+                           size_t clientCount,
+                           uint64_t elapsedNs );
+
+#endif /* LOAD_GENERATOR_H */
@@ -0,0 +1,76 @@
+#ifndef STUN_CHANNEL_DATA_H
+#define STUN_CHANNEL_DATA_H
+
+/* API includes. */
+#include "stun_data_types.h"
+
+/*
+ * TURN ChannelData message (RFC 8656 section 12.4):
+ *
+ *  0                   1                   2                   3
+ *  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+ * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ * |         Channel Number        |            Length             |
+ * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ * |                                                               |
+ * /                       Application Data                        /
+ * /                                                               /
+ * |                                                               |
+ * |                               +-------------------------------+
+ * |                               |
+ * +-------------------------------+
+ *
+ * Over TCP and TLS, the message is padded to a multiple of 4 bytes. The
+ * padding is not included in the length.
+ */
+#define STUN_CHANNEL_DATA_HEADER_LENGTH             4
+#define STUN_CHANNEL_DATA_CHANNEL_NUMBER_OFFSET     0
+#define STUN_CHANNEL_DATA_LENGTH_OFFSET             2
+
+/* Channel numbers allowed by RFC 8656. They also fall in the ChannelData range
+ * of RFC 7983. */
+#define STUN_CHANNEL_NUMBER_MIN                     0x4000
+#define STUN_CHANNEL_NUMBER_MAX                     0x4FFF
+
+typedef struct StunChannelData
+{
+    uint16_t channelNumber;
+    uint8_t * pData;
+    uint16_t dataLength;
+} StunChannelData_t;
+
+/* Writes the ChannelData header in the STUN_CHANNEL_DATA_HEADER_LENGTH bytes
+ * before pChannelData->pData, which the caller must leave free, so that the
+ * application data is not copied. If addPadding is set, the message is padded
+ * to a multiple of 4 bytes for TCP and TLS, in which case the caller must also
+ * leave 3 bytes free after the application data. pEncoded is set to the
+ * message, ready to be sent. */
+StunResult_t StunChannelData_Encode( const StunChannelData_t * pChannelData,
+                                     uint8_t addPadding,
+                                     StunMessageBuffer_t * pEncoded );
+
+/* Parses a received ChannelData message in place. pChannelData->pData points
+ * into pPacket. Bytes after the application data, like the padding, are
+ * ignored. */
+StunResult_t StunChannelData_Decode( uint8_t * pPacket,
+                                     size_t packetLength,
+                                     StunChannelData_t * pChannelData );
+
+/* Encodes count messages, e.g. for sendmmsg. Nothing is written if any of the
+ * messages has an invalid channel number. */
+StunResult_t StunChannelData_EncodeBatch( const StunChannelData_t * pChannelData,
+                                          size_t count,
+                                          uint8_t addPadding,
+                                          StunMessageBuffer_t * pEncoded );
+
+/* Decodes packetCount packets received with recvmmsg. pResults is set to the
+ * result of StunChannelData_Decode for every packet, and the entries of
+ * pChannelData are only valid for the packets whose result is STUN_RESULT_OK.
+ * pValidPacketCount is set to the number of such packets. */
+StunResult_t StunChannelData_DecodeBatch( const StunMessageBuffer_t * pPackets,
+                                          size_t packetCount,
+                                          StunChannelData_t * pChannelData,
+                                          StunResult_t * pResults,
+                                          size_t * pValidPacketCount );
+
+#endif /* STUN_CHANNEL_DATA_H */
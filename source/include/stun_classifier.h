@@ -0,0 +1,62 @@
+#ifndef STUN_CLASSIFIER_H
+#define STUN_CLASSIFIER_H
+
+#include "stun_data_types.h"
+
+/*
+ * Demultiplexing of the packets received on a port shared by STUN, ZRTP, DTLS,
+ * TURN ChannelData and RTP/RTCP as per RFC 7983:
+ * https://datatracker.ietf.org/doc/html/rfc7983#section-7
+ *
+ *                  +----------------+
+ *                  |        [0..3] -+--> forward to STUN
+ *                  |                |
+ *                  |      [16..19] -+--> forward to ZRTP
+ *                  |                |
+ *      packet -->  |      [20..63] -+--> forward to DTLS
+ *                  |                |
+ *                  |      [64..79] -+--> forward to TURN Channel
+ *                  |                |
+ *                  |    [128..191] -+--> forward to RTP/RTCP
+ *                  +----------------+
+ *
+ * A packet in the STUN range is only classified as STUN when it is at least
+ * as long as the STUN header, carries the magic cookie and has a message
+ * length that is a multiple of 4. Everything else is classified as unknown.
+ */
+
+/* First byte ranges from RFC 7983. */
+#define STUN_CLASSIFIER_STUN_FIRST_BYTE_MIN             0
+#define STUN_CLASSIFIER_STUN_FIRST_BYTE_MAX             3
+#define STUN_CLASSIFIER_ZRTP_FIRST_BYTE_MIN             16
+#define STUN_CLASSIFIER_ZRTP_FIRST_BYTE_MAX             19
+#define STUN_CLASSIFIER_DTLS_FIRST_BYTE_MIN             20
+#define STUN_CLASSIFIER_DTLS_FIRST_BYTE_MAX             63
+#define STUN_CLASSIFIER_CHANNEL_DATA_FIRST_BYTE_MIN     64
+#define STUN_CLASSIFIER_CHANNEL_DATA_FIRST_BYTE_MAX     79
+#define STUN_CLASSIFIER_RTP_FIRST_BYTE_MIN              128
+#define STUN_CLASSIFIER_RTP_FIRST_BYTE_MAX              191
+
+/* Packet types. The values fit in a byte so that StunClassifier_ClassifyBatch
+ * can write them to a uint8_t array. */
+typedef enum StunPacketType
+{
+    STUN_PACKET_TYPE_UNKNOWN = 0,
+    STUN_PACKET_TYPE_STUN = 1,
+    STUN_PACKET_TYPE_ZRTP = 2,
+    STUN_PACKET_TYPE_DTLS = 3,
+    STUN_PACKET_TYPE_CHANNEL_DATA = 4,
+    STUN_PACKET_TYPE_RTP = 5, /* RTP or RTCP. */
+} StunPacketType_t;
+
+StunPacketType_t StunClassifier_ClassifyPacket( const uint8_t * pPacket,
+                                                size_t packetLength );
+
+/* Classify a batch of packets. pPacketTypes must have room for packetCount
+ * entries, each of which is set to a StunPacketType_t value. SSE2, AVX2 (when
+ * supported by the CPU at run time) or NEON is used where available. */
+StunResult_t StunClassifier_ClassifyBatch( const StunMessageBuffer_t * pPackets,
+                                           size_t packetCount,
+                                           uint8_t * pPacketTypes );
+
+#endif /* STUN_CLASSIFIER_H */
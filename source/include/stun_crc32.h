@@ -0,0 +1,24 @@
+#ifndef STUN_CRC32_H
+#define STUN_CRC32_H
+
+/* Standard includes. */
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * CRC-32 as used by the STUN FINGERPRINT attribute (ITU-T V.42, the same CRC
+ * as Ethernet and zlib). The value of the FINGERPRINT attribute is this CRC
+ * XOR-ed with STUN_ATTRIBUTE_FINGERPRINT_XOR_VALUE.
+ *
+ * Pass 0 as crc for the first buffer and the returned value to continue the
+ * calculation over the next buffer.
+ *
+ * Slicing-by-8 is used on all platforms. PCLMULQDQ folding on x86-64 and the
+ * CRC32 instructions on ARMv8 are used when the CPU supports them, which is
+ * detected at run time. Define STUN_DISABLE_SIMD to only use slicing-by-8.
+ */
+uint32_t Stun_Crc32( uint32_t crc,
+                     const uint8_t * pBuffer,
+                     size_t bufferLength );
+
+#endif /* STUN_CRC32_H */
@@ -0,0 +1,76 @@
+#ifndef STUN_CREDENTIAL_CACHE_H
+#define STUN_CREDENTIAL_CACHE_H
+
+/* API includes. */
+#include "stun_data_types.h"
+#include "stun_integrity.h"
+
+/*
+ * Cache of long-term credential keys (RFC 8489 section 9.2), keyed on
+ * (username, realm). Every entry holds the derived MD5 key and the HMAC state
+ * prepared from it, so that a TURN client only derives the key once instead of
+ * for every Allocate, Refresh, CreatePermission and ChannelBind request.
+ *
+ * The entries are provided by the caller. The cache is not thread safe.
+ * Call StunCredentialCache_Remove when the password of a (username, realm)
+ * pair changes.
+ */
+
+/* Longest username and realm that can be cached. */
+#ifndef STUN_CREDENTIAL_CACHE_MAX_USERNAME_LENGTH
+    #define STUN_CREDENTIAL_CACHE_MAX_USERNAME_LENGTH   128
+#endif
+
+#ifndef STUN_CREDENTIAL_CACHE_MAX_REALM_LENGTH
+    #define STUN_CREDENTIAL_CACHE_MAX_REALM_LENGTH      128
+#endif
+
+/* Number of entries, starting at the one selected by the hash, that are
+ * searched for a (username, realm) pair. */
+#define STUN_CREDENTIAL_CACHE_PROBE_LENGTH      4
+
+typedef struct StunCredentialCacheEntry
+{
+    StunIntegrityKey_t integrityKey;
+    uint32_t hash;
+    uint8_t inUse;
+    uint16_t usernameLength;
+    uint16_t realmLength;
+    uint8_t username[ STUN_CREDENTIAL_CACHE_MAX_USERNAME_LENGTH ];
+    uint8_t realm[ STUN_CREDENTIAL_CACHE_MAX_REALM_LENGTH ];
+    uint8_t longTermKey[ STUN_INTEGRITY_LONG_TERM_KEY_LENGTH ];
+} StunCredentialCacheEntry_t;
+
+typedef struct StunCredentialCache
+{
+    StunCredentialCacheEntry_t * pEntries;
+    size_t entryCount;
+} StunCredentialCache_t;
+
+StunResult_t StunCredentialCache_Init( StunCredentialCache_t * pCache,
+                                       StunCredentialCacheEntry_t * pEntries,
+                                       size_t entryCount );
+
+/* Returns the prepared key for (pUsername, pRealm) in *ppIntegrityKey. The key
+ * is derived from pPassword only when the pair is not in the cache, in which
+ * case it may evict another pair. The returned key stays valid until the
+ * next call to StunCredentialCache_GetKey or StunCredentialCache_Remove.
+ * Returns STUN_RESULT_OUT_OF_MEMORY if the username or the realm is too long
+ * to be cached. */
+StunResult_t StunCredentialCache_GetKey( StunCredentialCache_t * pCache,
+                                         const uint8_t * pUsername,
+                                         uint16_t usernameLength,
+                                         const uint8_t * pRealm,
+                                         uint16_t realmLength,
+                                         const uint8_t * pPassword,
+                                         size_t passwordLength,
+                                         const StunIntegrityKey_t ** ppIntegrityKey );
+
+/* Removes (pUsername, pRealm) from the cache, if present. */
+StunResult_t StunCredentialCache_Remove( StunCredentialCache_t * pCache,
+                                         const uint8_t * pUsername,
+                                         uint16_t usernameLength,
+                                         const uint8_t * pRealm,
+                                         uint16_t realmLength );
+
+#endif /* STUN_CREDENTIAL_CACHE_H */
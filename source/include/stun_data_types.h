@@ -118,6 +118,7 @@
 
 /* Attribute value lengths. */
 #define STUN_ATTRIBUTE_VALUE_MAX_LENGTH                 512 /* Maximum for general attributes. */
+#define STUN_ATTRIBUTE_DATA_VALUE_MAX_LENGTH            0xFFF8 /* Largest padded value in a 16-bit message length. */
 #define STUN_ATTRIBUTE_PRIORITY_VALUE_LENGTH            4 /* 32-bit priority value. */
 #define STUN_ATTRIBUTE_LIFETIME_VALUE_LENGTH            4 /* 32-bit lifetime value. */
 #define STUN_ATTRIBUTE_CHANGE_REQUEST_VALUE_LENGTH      4 /* 32-bit flag. */
@@ -134,6 +135,15 @@
 #define STUN_GET_ERROR_CLASS( errorCode )               ( ( uint8_t ) ( ( errorCode ) / 100 ) )
 #define STUN_GET_ERROR_NUMBER( errorCode )              ( ( uint8_t ) ( ( errorCode ) % 100 ) )
 
+/* Attribute index. Comprehension-required attribute types 0x0000-0x002F map
+ * to slots 0x00-0x2F and comprehension-optional attribute types 0x8020-0x802F
+ * map to slots 0x30-0x3F. Other attribute types are not indexed. */
+#define STUN_ATTRIBUTE_INDEX_SLOT_COUNT                 64
+#define STUN_ATTRIBUTE_INDEX_REQUIRED_RANGE_END         0x002F
+#define STUN_ATTRIBUTE_INDEX_OPTIONAL_RANGE_START       0x8020
+#define STUN_ATTRIBUTE_INDEX_OPTIONAL_RANGE_END         0x802F
+#define STUN_ATTRIBUTE_INDEX_NOT_PRESENT                0xFFFF
+
 /* IP address macros. */
 #define STUN_ADDRESS_IPv4           0x01
 #define STUN_ADDRESS_IPv6           0x02
@@ -144,6 +154,7 @@
 /* STUN context flags. */
 #define STUN_FLAG_FINGERPRINT_ATTRIBUTE             ( 1 << 0 )
 #define STUN_FLAG_INTEGRITY_ATTRIBUTE               ( 1 << 1 )
+#define STUN_FLAG_DATA_REFERENCE_ATTRIBUTE          ( 1 << 2 )
 
 /*-----------------------------------------------------------*/
 
@@ -161,6 +172,11 @@ typedef enum StunResult
     STUN_RESULT_INVALID_ATTRIBUTE_ORDER,
     STUN_RESULT_NO_ATTRIBUTE_FOUND,
     STUN_RESULT_INVALID_ATTRIBUTE,
+    STUN_RESULT_FINGERPRINT_MISMATCH,
+    STUN_RESULT_INTEGRITY_MISMATCH,
+    STUN_RESULT_TRANSACTION_NOT_FOUND,
+    STUN_RESULT_NEED_MORE_DATA,
+    STUN_RESULT_INVALID_FRAME,
 } StunResult_t;
 
 /* STUN message types. */
@@ -240,8 +256,24 @@ typedef struct StunContext
     size_t currentIndex;
     uint32_t attributeFlag;
     StunReadWriteFunctions_t readWriteFunctions;
+    /* DATA value referenced by StunSerializer_AddAttributeDataReference. It
+     * goes at dataReferenceIndex in the message but is not in the buffer. */
+    const uint8_t * pDataReference;
+    size_t dataReferenceIndex;
+    uint16_t dataReferenceLength;
+    /* Set by StunSerializer_EnableHashStream. */
+    struct StunSerializerHashStream * pHashStream;
 } StunContext_t;
 
+/* A part of a serialized message, as returned by
+ * StunSerializer_FinalizeIoVec. The members are the same as the ones of struct
+ * iovec, in the same order. */
+typedef struct StunIoVec
+{
+    const uint8_t * pBase;
+    size_t length;
+} StunIoVec_t;
+
 /* This cannot be struct StunHeader to avoid collision with the same name in
  * the KVS WebRTC C-SDK. */
 typedef struct StunMessageHeader
@@ -257,6 +289,49 @@ typedef struct StunAttribute
     uint16_t attributeValueLength;
 } StunAttribute_t;
 
+/* Offsets of the first occurrence of each indexed attribute type, relative to
+ * the start of the attributes (i.e. after the 20 bytes header). Filled by
+ * StunDeserializer_BuildIndex. */
+typedef struct StunAttributeIndex
+{
+    uint16_t attributeOffsets[ STUN_ATTRIBUTE_INDEX_SLOT_COUNT ];
+} StunAttributeIndex_t;
+
+/* A received datagram, as filled by recvmmsg. */
+typedef struct StunMessageBuffer
+{
+    uint8_t * pStunMessage;
+    size_t stunMessageLength;
+} StunMessageBuffer_t;
+
+/* Per-message output of StunDeserializer_InitBatch in structure-of-arrays
+ * form. Each array is provided by the caller and must have room for the
+ * number of messages in the batch. For the messages whose result is not
+ * STUN_RESULT_OK, the other outputs are not valid. */
+typedef struct StunMessageBatch
+{
+    StunResult_t * pResults;
+    StunMessageType_t * pMessageTypes;
+    uint8_t ** ppTransactionIds;
+    uint8_t ** ppAttributes;         /* Start of the attributes (after the header). */
+    uint16_t * pAttributesLengths;   /* Length of the attributes, i.e. the message length in the header. */
+    size_t messageCount;             /* Set by StunDeserializer_InitBatch. */
+} StunMessageBatch_t;
+
+/* Bytes covered by MESSAGE-INTEGRITY or FINGERPRINT in a received message. The
+ * hash input is the message with the length in the header replaced by
+ * patchedMessageLength, i.e. pStunMessage[ 0 .. 1 ], patchedMessageLength in
+ * network byte order and pStunMessage[ 4 .. stunMessageLength - 1 ]. The
+ * attribute can start past 64 KiB, so the lengths are not 16-bit. Filled
+ * by StunDeserializer_GetIntegrityRange and
+ * StunDeserializer_GetFingerprintRange, which do not modify the message. */
+typedef struct StunHashRange
+{
+    const uint8_t * pStunMessage;
+    size_t stunMessageLength;
+    size_t patchedMessageLength;
+} StunHashRange_t;
+
 /* This cannot be struct StunAttributeAddress to avoid collision with the same
  * name in the KVS WebRTC C-SDK. */
 typedef struct StunAttributesAddress
@@ -266,6 +341,49 @@ typedef struct StunAttributesAddress
     uint8_t address[ STUN_IPV6_ADDRESS_SIZE ];
 } StunAttributeAddress_t;
 
+/* Value of an attribute in a received message. */
+typedef struct StunAttributeValue
+{
+    uint8_t * pValue;
+    uint16_t valueLength;
+} StunAttributeValue_t;
+
+#define STUN_CACHE_LINE_SIZE    64
+
+#if defined( __GNUC__ ) || defined( __clang__ )
+    #define STUN_CACHE_LINE_ALIGNED    __attribute__( ( aligned( STUN_CACHE_LINE_SIZE ) ) )
+#else
+    #define STUN_CACHE_LINE_ALIGNED
+#endif
+
+/* Attributes of a received message decoded in one pass by
+ * StunDeserializer_DecodeMessageView. Bit N of attributesPresent is set if the
+ * attribute in slot N of StunAttributeIndex_t is present; use
+ * StunDeserializer_IsAttributeInView to test it. Only the first occurrence of
+ * each attribute is decoded, and the fields of the attributes that are not
+ * present are 0. The integrity and fingerprint offsets are the offsets of the
+ * MESSAGE-INTEGRITY and FINGERPRINT attributes from the start of the message,
+ * i.e. the lengths of the message covered by them. They are 32 bits wide, as
+ * an attribute can start past 64 KiB in a message of the maximum length. The
+ * view is 2 cache lines, with the ICE connectivity check fields in the first
+ * one. */
+typedef struct StunMessageView
+{
+    uint64_t attributesPresent;
+    uint64_t iceTieBreaker;         /* ICE-CONTROLLING or ICE-CONTROLLED. */
+    uint32_t priority;
+    uint32_t lifetime;
+    uint32_t integrityOffset;
+    uint32_t fingerprintOffset;
+    StunAttributeValue_t username;
+    uint16_t errorCode;
+    uint16_t channelNumber;
+    StunAttributeAddress_t xorMappedAddress;
+    StunAttributeValue_t realm;
+    StunAttributeValue_t nonce;
+    StunAttributeValue_t data;
+} STUN_CACHE_LINE_ALIGNED StunMessageView_t;
+
 /*-----------------------------------------------------------*/
 
 #endif /* STUN_DATA_TYPES_H */
@@ -2,12 +2,23 @@
 #define STUN_DESERIALIZER_H
 
 #include "stun_data_types.h"
+#include "stun_integrity.h"
 
 StunResult_t StunDeserializer_Init( StunContext_t * pCtx,
                                     uint8_t * pStunMessage,
                                     size_t stunMessageLength,
                                     StunHeader_t * pStunHeader );
 
+StunResult_t StunDeserializer_InitBatch( const StunMessageBuffer_t * pStunMessages,
+                                         size_t messageCount,
+                                         StunMessageBatch_t * pBatch,
+                                         size_t * pValidMessageCount );
+
+StunResult_t StunDeserializer_InitFromBatch( StunContext_t * pCtx,
+                                             const StunMessageBatch_t * pBatch,
+                                             size_t messageIndex,
+                                             StunHeader_t * pStunHeader );
+
 StunResult_t StunDeserializer_GetNextAttribute( StunContext_t * pCtx,
                                                 StunAttribute_t * pAttribute );
 
@@ -48,6 +59,10 @@ StunResult_t StunDeserializer_ParseAttributeAddress( const StunContext_t * pCtx,
                                                      const StunAttribute_t * pAttribute,
                                                      StunAttributeAddress_t * pAddress );
 
+/* Write the patched message length to the message and return the bytes
+ * covered by MESSAGE-INTEGRITY or FINGERPRINT. Return
+ * STUN_RESULT_INVALID_MESSAGE_LENGTH if the attribute starts past 64 KiB, as
+ * its offset does not fit in pStunMessageLength. */
 StunResult_t StunDeserializer_GetIntegrityBuffer( StunContext_t * pCtx,
                                                   uint8_t ** ppStunMessage,
                                                   uint16_t * pStunMessageLength );
@@ -56,10 +71,54 @@ StunResult_t StunDeserializer_GetFingerprintBuffer( StunContext_t * pCtx,
                                                     uint8_t ** ppStunMessage,
                                                     uint16_t * pStunMessageLength );
 
+/* Same as StunDeserializer_GetIntegrityBuffer and
+ * StunDeserializer_GetFingerprintBuffer, but the patched message length is
+ * returned in pRange instead of being written to the message. The message is
+ * only read, so it can be in read-only memory and these can be called from
+ * several threads, each with its own context, on the same message. */
+StunResult_t StunDeserializer_GetIntegrityRange( const StunContext_t * pCtx,
+                                                 StunHashRange_t * pRange );
+
+StunResult_t StunDeserializer_GetFingerprintRange( const StunContext_t * pCtx,
+                                                   StunHashRange_t * pRange );
+
+/* Checks the FINGERPRINT attribute, as returned by the last call to
+ * StunDeserializer_GetNextAttribute, against the CRC-32 of the message.
+ * Returns STUN_RESULT_FINGERPRINT_MISMATCH if they do not match. The message
+ * is not modified. */
+StunResult_t StunDeserializer_VerifyFingerprint( const StunContext_t * pCtx,
+                                                 const StunAttribute_t * pAttribute );
+
+/* Checks the MESSAGE-INTEGRITY attribute, as returned by the last call to
+ * StunDeserializer_GetNextAttribute, against the HMAC-SHA1 of the message
+ * computed with pIntegrityKey. Returns STUN_RESULT_INTEGRITY_MISMATCH if they
+ * do not match. The message is not modified. */
+StunResult_t StunDeserializer_VerifyIntegrity( const StunContext_t * pCtx,
+                                               const StunAttribute_t * pAttribute,
+                                               const StunIntegrityKey_t * pIntegrityKey );
+
 StunResult_t StunDeserializer_FindAttribute( StunContext_t * pCtx,
                                              StunAttributeType_t attributeType,
                                              StunAttribute_t * pAttribute );
 
+StunResult_t StunDeserializer_BuildIndex( const StunContext_t * pCtx,
+                                          StunAttributeIndex_t * pIndex );
+
+StunResult_t StunDeserializer_FindAttributeInIndex( const StunContext_t * pCtx,
+                                                    const StunAttributeIndex_t * pIndex,
+                                                    StunAttributeType_t attributeType,
+                                                    StunAttribute_t * pAttribute );
+
+/* Walks the message once and decodes the attributes used by ICE and TURN into
+ * pView. The context is not modified. */
+StunResult_t StunDeserializer_DecodeMessageView( const StunContext_t * pCtx,
+                                                 StunMessageView_t * pView );
+
+/* Returns 1 if the attribute was found by StunDeserializer_DecodeMessageView.
+ * Always returns 0 for the attribute types that are not indexed. */
+uint8_t StunDeserializer_IsAttributeInView( const StunMessageView_t * pView,
+                                            StunAttributeType_t attributeType );
+
 StunResult_t StunDeserializer_UpdateAttributeNonce( const uint8_t * pNonce,
                                                     uint16_t nonceLength,
                                                     StunAttribute_t * pAttribute );
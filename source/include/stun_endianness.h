@@ -3,6 +3,64 @@
 
 /* Standard includes. */
 #include <stdint.h>
+#include <string.h>
+
+/*
+ * Host byte order.
+ *
+ * Either STUN_LITTLE_ENDIAN or STUN_BIG_ENDIAN can be defined by the build. If
+ * neither is defined, the byte order reported by the compiler is used. When
+ * the byte order cannot be determined at compile time, it is probed at run
+ * time in Stun_InitReadWriteFunctions.
+ */
+#if !defined( STUN_LITTLE_ENDIAN ) && !defined( STUN_BIG_ENDIAN )
+    #if defined( __BYTE_ORDER__ ) && ( __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ )
+        #define STUN_LITTLE_ENDIAN
+    #elif defined( __BYTE_ORDER__ ) && ( __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__ )
+        #define STUN_BIG_ENDIAN
+    #endif
+#endif
+
+/*
+ * Compile-time byte order selection.
+ *
+ * When STUN_USE_COMPILE_TIME_ENDIANNESS is defined, the serializer and the
+ * deserializer call the static inline helpers below directly instead of going
+ * through the function pointers in StunReadWriteFunctions_t. This lets the
+ * compiler inline every 16/32/64-bit access in the attribute loops.
+ */
+#if defined( STUN_USE_COMPILE_TIME_ENDIANNESS ) && !defined( STUN_LITTLE_ENDIAN ) && !defined( STUN_BIG_ENDIAN )
+    #error "STUN_USE_COMPILE_TIME_ENDIANNESS requires STUN_LITTLE_ENDIAN or STUN_BIG_ENDIAN to be defined."
+#endif
+
+/* Byte swap helpers - compiler builtins where available. */
+#if defined( __GNUC__ ) || defined( __clang__ )
+    #define STUN_BSWAP_16( value )    __builtin_bswap16( value )
+    #define STUN_BSWAP_32( value )    __builtin_bswap32( value )
+    #define STUN_BSWAP_64( value )    __builtin_bswap64( value )
+#else
+    #define STUN_BSWAP_16( value )                      \
+    ( ( uint16_t ) ( ( ( ( value ) >> 8 ) & 0xFF ) |    \
+                     ( ( ( value ) & 0xFF ) << 8 ) ) )
+    #define STUN_BSWAP_32( value )                          \
+    ( ( uint32_t ) ( ( ( ( value ) >> 24 ) & 0xFF )  |      \
+                     ( ( ( value ) >> 8 ) & 0xFF00 ) |      \
+                     ( ( ( value ) & 0xFF00 ) << 8 ) |      \
+                     ( ( ( value ) & 0xFF ) << 24 ) ) )
+    #define STUN_BSWAP_64( value )                                      \
+    ( ( ( uint64_t ) STUN_BSWAP_32( ( uint32_t ) ( value ) ) << 32 ) |  \
+      ( uint64_t ) STUN_BSWAP_32( ( uint32_t ) ( ( uint64_t ) ( value ) >> 32 ) ) )
+#endif
+
+#if defined( STUN_LITTLE_ENDIAN )
+    #define STUN_HOST_TO_BE_16( value )    STUN_BSWAP_16( value )
+    #define STUN_HOST_TO_BE_32( value )    STUN_BSWAP_32( value )
+    #define STUN_HOST_TO_BE_64( value )    STUN_BSWAP_64( value )
+#else
+    #define STUN_HOST_TO_BE_16( value )    ( value )
+    #define STUN_HOST_TO_BE_32( value )    ( value )
+    #define STUN_HOST_TO_BE_64( value )    ( value )
+#endif
 
 /* Endianness Function types. */
 typedef void ( * WriteUint16_t ) ( uint8_t * pDst,
@@ -27,4 +85,133 @@ typedef struct StunReadWriteFunctions
 
 void Stun_InitReadWriteFunctions( StunReadWriteFunctions_t * pReadWriteFunctions );
 
+/*
+ * Network (big endian) order read/write helpers. They are always available,
+ * for the modules that do not keep a StunReadWriteFunctions_t.
+ */
+#if defined( STUN_LITTLE_ENDIAN ) || defined( STUN_BIG_ENDIAN )
+
+/*-----------------------------------------------------------*/
+
+/* The host byte order is known at compile time. The memcpy is used to perform
+ * unaligned access and is lowered to a single load/store by the compiler. */
+static inline void Stun_WriteUint16( uint8_t * pDst,
+                                     uint16_t val )
+{
+    uint16_t beVal = STUN_HOST_TO_BE_16( val );
+
+    memcpy( ( void * ) pDst, ( const void * ) &( beVal ), sizeof( beVal ) );
+}
+
+/*-----------------------------------------------------------*/
+
+static inline void Stun_WriteUint32( uint8_t * pDst,
+                                     uint32_t val )
+{
+    uint32_t beVal = STUN_HOST_TO_BE_32( val );
+
+    memcpy( ( void * ) pDst, ( const void * ) &( beVal ), sizeof( beVal ) );
+}
+
+/*-----------------------------------------------------------*/
+
+static inline void Stun_WriteUint64( uint8_t * pDst,
+                                     uint64_t val )
+{
+    uint64_t beVal = STUN_HOST_TO_BE_64( val );
+
+    memcpy( ( void * ) pDst, ( const void * ) &( beVal ), sizeof( beVal ) );
+}
+
+/*-----------------------------------------------------------*/
+
+static inline uint16_t Stun_ReadUint16( const uint8_t * pSrc )
+{
+    uint16_t beVal;
+
+    memcpy( ( void * ) &( beVal ), ( const void * ) pSrc, sizeof( beVal ) );
+
+    return STUN_HOST_TO_BE_16( beVal );
+}
+
+/*-----------------------------------------------------------*/
+
+static inline uint32_t Stun_ReadUint32( const uint8_t * pSrc )
+{
+    uint32_t beVal;
+
+    memcpy( ( void * ) &( beVal ), ( const void * ) pSrc, sizeof( beVal ) );
+
+    return STUN_HOST_TO_BE_32( beVal );
+}
+
+/*-----------------------------------------------------------*/
+
+static inline uint64_t Stun_ReadUint64( const uint8_t * pSrc )
+{
+    uint64_t beVal;
+
+    memcpy( ( void * ) &( beVal ), ( const void * ) pSrc, sizeof( beVal ) );
+
+    return STUN_HOST_TO_BE_64( beVal );
+}
+
+/*-----------------------------------------------------------*/
+
+#else /* if defined( STUN_LITTLE_ENDIAN ) || defined( STUN_BIG_ENDIAN ) */
+
+/*-----------------------------------------------------------*/
+
+/* The host byte order is not known at compile time, the bytes are accessed one
+ * at a time. */
+static inline void Stun_WriteUint16( uint8_t * pDst,
+                                     uint16_t val )
+{
+    pDst[ 0 ] = ( uint8_t ) ( val >> 8 );
+    pDst[ 1 ] = ( uint8_t ) val;
+}
+
+/*-----------------------------------------------------------*/
+
+static inline void Stun_WriteUint32( uint8_t * pDst,
+                                     uint32_t val )
+{
+    Stun_WriteUint16( &( pDst[ 0 ] ), ( uint16_t ) ( val >> 16 ) );
+    Stun_WriteUint16( &( pDst[ 2 ] ), ( uint16_t ) val );
+}
+
+/*-----------------------------------------------------------*/
+
+static inline void Stun_WriteUint64( uint8_t * pDst,
+                                     uint64_t val )
+{
+    Stun_WriteUint32( &( pDst[ 0 ] ), ( uint32_t ) ( val >> 32 ) );
+    Stun_WriteUint32( &( pDst[ 4 ] ), ( uint32_t ) val );
+}
+
+/*-----------------------------------------------------------*/
+
+static inline uint16_t Stun_ReadUint16( const uint8_t * pSrc )
+{
+    return ( uint16_t ) ( ( ( uint16_t ) pSrc[ 0 ] << 8 ) | pSrc[ 1 ] );
+}
+
+/*-----------------------------------------------------------*/
+
+static inline uint32_t Stun_ReadUint32( const uint8_t * pSrc )
+{
+    return ( ( uint32_t ) Stun_ReadUint16( &( pSrc[ 0 ] ) ) << 16 ) | Stun_ReadUint16( &( pSrc[ 2 ] ) );
+}
+
+/*-----------------------------------------------------------*/
+
+static inline uint64_t Stun_ReadUint64( const uint8_t * pSrc )
+{
+    return ( ( uint64_t ) Stun_ReadUint32( &( pSrc[ 0 ] ) ) << 32 ) | Stun_ReadUint32( &( pSrc[ 4 ] ) );
+}
+
+/*-----------------------------------------------------------*/
+
+#endif /* if defined( STUN_LITTLE_ENDIAN ) || defined( STUN_BIG_ENDIAN ) */
+
 #endif /* STUN_ENDIANNESS_H */
@@ -0,0 +1,79 @@
+#ifndef STUN_INTEGRITY_H
+#define STUN_INTEGRITY_H
+
+/* API includes. */
+#include "stun_data_types.h"
+#include "stun_sha1.h"
+#include "stun_md5.h"
+
+/*
+ * HMAC-SHA1 for the MESSAGE-INTEGRITY attribute.
+ *
+ * The key (the ICE password for short-term credentials) is padded and hashed
+ * into the inner and outer HMAC states once in StunIntegrity_InitKey. Every
+ * HMAC computed with the key then costs the compression of the message plus
+ * two blocks, instead of deriving ipad/opad for each message.
+ *
+ * Treat the members of StunIntegrityKey_t as private. The object does not
+ * reference the key after StunIntegrity_InitKey and can be shared between
+ * threads.
+ */
+/* Length of the long-term credential key. */
+#define STUN_INTEGRITY_LONG_TERM_KEY_LENGTH     STUN_MD5_DIGEST_LENGTH
+
+typedef struct StunIntegrityKey
+{
+    uint32_t innerState[ STUN_SHA1_STATE_WORDS ];
+    uint32_t outerState[ STUN_SHA1_STATE_WORDS ];
+    StunSha1CompressFunction_t compressFn;
+} StunIntegrityKey_t;
+
+/* Prepares pIntegrityKey for the key pKey of length keyLength. Pass NULL
+ * compressFn to use the SHA-1 backend returned by
+ * Stun_Sha1GetCompressFunction. */
+StunResult_t StunIntegrity_InitKey( StunIntegrityKey_t * pIntegrityKey,
+                                    const uint8_t * pKey,
+                                    size_t keyLength,
+                                    StunSha1CompressFunction_t compressFn );
+
+/* State of an HMAC computed in several parts. */
+typedef struct StunHmacContext
+{
+    StunSha1Context_t sha1Ctx;
+    const StunIntegrityKey_t * pIntegrityKey;
+} StunHmacContext_t;
+
+/* Writes STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH bytes to pHmac. */
+StunResult_t StunIntegrity_ComputeHmac( const StunIntegrityKey_t * pIntegrityKey,
+                                        const uint8_t * pData,
+                                        size_t dataLength,
+                                        uint8_t * pHmac );
+
+/* Computes an HMAC over data provided in several parts. pIntegrityKey must
+ * remain valid until StunIntegrity_HmacFinal. */
+StunResult_t StunIntegrity_HmacInit( StunHmacContext_t * pHmacCtx,
+                                     const StunIntegrityKey_t * pIntegrityKey );
+
+StunResult_t StunIntegrity_HmacUpdate( StunHmacContext_t * pHmacCtx,
+                                       const uint8_t * pData,
+                                       size_t dataLength );
+
+/* Writes STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH bytes to pHmac. */
+StunResult_t StunIntegrity_HmacFinal( StunHmacContext_t * pHmacCtx,
+                                      uint8_t * pHmac );
+
+/* Derives the long-term credential key MD5( username ":" realm ":" password )
+ * into pLongTermKey, which must have room for
+ * STUN_INTEGRITY_LONG_TERM_KEY_LENGTH bytes. The username, realm and password
+ * must already be processed with SASLprep/OpaqueString. Pass the result to
+ * StunIntegrity_InitKey, or use StunCredentialCache_GetKey to do both once
+ * per credential. */
+StunResult_t StunIntegrity_DeriveLongTermKey( const uint8_t * pUsername,
+                                              size_t usernameLength,
+                                              const uint8_t * pRealm,
+                                              size_t realmLength,
+                                              const uint8_t * pPassword,
+                                              size_t passwordLength,
+                                              uint8_t * pLongTermKey );
+
+#endif /* STUN_INTEGRITY_H */
@@ -0,0 +1,34 @@
+#ifndef STUN_MD5_H
+#define STUN_MD5_H
+
+/* Standard includes. */
+#include <stddef.h>
+#include <stdint.h>
+
+#define STUN_MD5_BLOCK_LENGTH       64
+#define STUN_MD5_DIGEST_LENGTH      16
+
+/*
+ * MD5 is only used to derive the long-term credential key
+ * MD5( username ":" realm ":" password ) as per RFC 8489 section 9.2.2, which
+ * is done once per credential. Do not use it for anything else.
+ */
+typedef struct StunMd5Context
+{
+    uint32_t state[ 4 ];
+    uint64_t totalLength;
+    uint8_t block[ STUN_MD5_BLOCK_LENGTH ];
+    size_t blockLength;
+} StunMd5Context_t;
+
+void Stun_Md5Init( StunMd5Context_t * pCtx );
+
+void Stun_Md5Update( StunMd5Context_t * pCtx,
+                     const uint8_t * pData,
+                     size_t dataLength );
+
+/* Writes STUN_MD5_DIGEST_LENGTH bytes to pDigest. */
+void Stun_Md5Final( StunMd5Context_t * pCtx,
+                    uint8_t * pDigest );
+
+#endif /* STUN_MD5_H */
@@ -0,0 +1,64 @@
+#ifndef STUN_MESSAGE_TEMPLATE_H
+#define STUN_MESSAGE_TEMPLATE_H
+
+/* API includes. */
+#include "stun_data_types.h"
+#include "stun_integrity.h"
+
+/*
+ * Templates for messages that are sent many times with only a few fields
+ * changed, such as the Binding Requests of ICE connectivity checks.
+ *
+ * Serialize the message once with the serializer, with placeholder values for
+ * the transaction ID, PRIORITY, MESSAGE-INTEGRITY and FINGERPRINT, and with
+ * USE-CANDIDATE if any of the messages needs it. StunMessageTemplate_Init
+ * records where those fields are. StunMessageTemplate_Stamp then copies the
+ * template into a send buffer, patches the fields, drops USE-CANDIDATE if not
+ * requested and recomputes MESSAGE-INTEGRITY and FINGERPRINT.
+ *
+ * The template references the serialized message, which must stay valid and
+ * unchanged while the template is used. A template can be used from several
+ * threads, each stamping into its own buffer.
+ */
+
+/* Offset of a field that is not in the template. */
+#define STUN_MESSAGE_TEMPLATE_NO_FIELD    0U
+
+typedef struct StunMessageTemplate
+{
+    const uint8_t * pMessage;
+    uint16_t messageLength;
+    /* Offsets of the attribute headers from the start of the message. */
+    uint16_t priorityOffset;
+    uint16_t useCandidateOffset;
+    uint16_t integrityOffset;
+    uint16_t fingerprintOffset;
+} StunMessageTemplate_t;
+
+/* Fields that change between the messages stamped from a template. */
+typedef struct StunMessageTemplateFields
+{
+    const uint8_t * pTransactionId;
+    uint32_t priority;          /* Ignored if the template has no PRIORITY. */
+    uint8_t useCandidate;       /* Requires USE-CANDIDATE in the template. */
+} StunMessageTemplateFields_t;
+
+/* Records the variable fields of the serialized message pMessage, and its
+ * length from the header. Returns the deserializer error if the message is
+ * malformed. */
+StunResult_t StunMessageTemplate_Init( StunMessageTemplate_t * pTemplate,
+                                       uint8_t * pMessage,
+                                       size_t messageLength );
+
+/* Writes a message built from pTemplate and pFields to pBuffer, and its length
+ * to pMessageLength. pIntegrityKey is required if the template has
+ * MESSAGE-INTEGRITY and ignored otherwise. Returns STUN_RESULT_OUT_OF_MEMORY
+ * if the message does not fit in bufferLength. */
+StunResult_t StunMessageTemplate_Stamp( const StunMessageTemplate_t * pTemplate,
+                                        const StunMessageTemplateFields_t * pFields,
+                                        const StunIntegrityKey_t * pIntegrityKey,
+                                        uint8_t * pBuffer,
+                                        size_t bufferLength,
+                                        size_t * pMessageLength );
+
+#endif /* STUN_MESSAGE_TEMPLATE_H */
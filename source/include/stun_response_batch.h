@@ -0,0 +1,40 @@
+#ifndef STUN_RESPONSE_BATCH_H
+#define STUN_RESPONSE_BATCH_H
+
+/* API includes. */
+#include "stun_data_types.h"
+#include "stun_integrity.h"
+
+/*
+ * Batches of Binding success responses for a STUN server, written
+ * back-to-back into one buffer to send with sendmmsg, or as one UDP GSO
+ * buffer.
+ *
+ * Each response has XOR-MAPPED-ADDRESS, MESSAGE-INTEGRITY if the request has a
+ * key, and FINGERPRINT. Responses with the same address family and the same
+ * use of MESSAGE-INTEGRITY have the same length, so a batch of such responses
+ * splits into equal-size GSO segments.
+ */
+
+/* A Binding Request to respond to. */
+typedef struct StunResponseBatchEntry
+{
+    const uint8_t * pTransactionId;
+    const StunAttributeAddress_t * pSourceAddress;
+    const StunIntegrityKey_t * pIntegrityKey; /* NULL for no MESSAGE-INTEGRITY. */
+} StunResponseBatchEntry_t;
+
+/* Writes the responses to pEntries back-to-back to pArena, their lengths to
+ * pResponseLengths and the number of responses written to pResponseCount.
+ * pResponseLengths must have room for entryCount lengths. Returns
+ * STUN_RESULT_OUT_OF_MEMORY if not all the responses fit in arenaLength, and
+ * STUN_RESULT_BAD_PARAM if an entry is invalid. The responses before the
+ * failed one are written and counted in both cases. */
+StunResult_t StunResponseBatch_SerializeBindingSuccess( const StunResponseBatchEntry_t * pEntries,
+                                                        size_t entryCount,
+                                                        uint8_t * pArena,
+                                                        size_t arenaLength,
+                                                        size_t * pResponseLengths,
+                                                        size_t * pResponseCount );
+
+#endif /* STUN_RESPONSE_BATCH_H */
@@ -2,6 +2,7 @@
 #define STUN_SERIALIZER_H
 
 #include "stun_data_types.h"
+#include "stun_integrity.h"
 
 StunResult_t StunSerializer_Init( StunContext_t * pCtx,
                                   uint8_t * pBuffer,
@@ -46,6 +47,15 @@ StunResult_t StunSerializer_AddAttributeData( StunContext_t * pCtx,
                                               const uint8_t * pData,
                                               uint16_t dataLength );
 
+/* Adds the DATA attribute without copying pData to the buffer. The value is
+ * referenced and returned as its own part by StunSerializer_FinalizeIoVec, so
+ * the message can be sent with sendmsg. pData must stay valid until the
+ * message is sent. At most one DATA value can be referenced, and
+ * MESSAGE-INTEGRITY cannot be added after it. */
+StunResult_t StunSerializer_AddAttributeDataReference( StunContext_t * pCtx,
+                                                       const uint8_t * pData,
+                                                       uint16_t dataLength );
+
 StunResult_t StunSerializer_AddAttributeRealm( StunContext_t * pCtx,
                                                const uint8_t * pRealm,
                                                uint16_t realmLength );
@@ -93,11 +103,173 @@ StunResult_t StunSerializer_GetIntegrityBuffer( StunContext_t * pCtx,
                                                 uint8_t ** ppStunMessage,
                                                 uint16_t * pStunMessageLength );
 
+/* Returns STUN_RESULT_INVALID_ATTRIBUTE_ORDER after
+ * StunSerializer_AddAttributeDataReference, as the buffer does not have the
+ * DATA value, and STUN_RESULT_INVALID_MESSAGE_LENGTH if the FINGERPRINT
+ * attribute would start past 64 KiB. Use StunSerializer_AddComputedFingerprint
+ * instead. */
 StunResult_t StunSerializer_GetFingerprintBuffer( StunContext_t * pCtx,
                                                   uint8_t ** ppStunMessage,
                                                   uint16_t * pStunMessageLength );
 
+/* Computes the CRC-32 of the message and adds the FINGERPRINT attribute. */
+StunResult_t StunSerializer_AddComputedFingerprint( StunContext_t * pCtx );
+
+/* Computes the HMAC-SHA1 of the message with pIntegrityKey and adds the
+ * MESSAGE-INTEGRITY attribute. */
+StunResult_t StunSerializer_AddComputedIntegrity( StunContext_t * pCtx,
+                                                  const StunIntegrityKey_t * pIntegrityKey );
+
 StunResult_t StunSerializer_Finalize( StunContext_t * pCtx,
                                       size_t * pStunMessageLength );
 
+/* Adds MESSAGE-INTEGRITY and FINGERPRINT and finalizes the message. The HMAC
+ * and the CRC are computed in one pass over the message, and the length in
+ * the header is written once. Same result as StunSerializer_AddComputedIntegrity,
+ * StunSerializer_AddComputedFingerprint and StunSerializer_Finalize. */
+StunResult_t StunSerializer_FinalizeWithIntegrityAndFingerprint( StunContext_t * pCtx,
+                                                                 const StunIntegrityKey_t * pIntegrityKey,
+                                                                 size_t * pStunMessageLength );
+
+/* HMAC and CRC of the part of the message that has been hashed while the
+ * attributes were added. Treat the members as private. */
+typedef struct StunSerializerHashStream
+{
+    StunHmacContext_t hmacCtx;
+    uint32_t crc32Fingerprint;
+    size_t hashedIndex;
+    size_t expectedMessageLength;
+} StunSerializerHashStream_t;
+
+/* Hashes the message for StunSerializer_FinalizeWithIntegrityAndFingerprint
+ * while the attributes are added, so that the finalize only hashes the last
+ * bytes. Call right after StunSerializer_Init, with the length that the
+ * finalize will return, e.g. calculated with a NULL buffer. The header is
+ * hashed with that length, so if the message ends up with a different length
+ * or the finalize gets another key, the finalize hashes the whole message
+ * again. pHashStream and pIntegrityKey must remain valid until the finalize. */
+StunResult_t StunSerializer_EnableHashStream( StunContext_t * pCtx,
+                                              StunSerializerHashStream_t * pHashStream,
+                                              const StunIntegrityKey_t * pIntegrityKey,
+                                              size_t expectedMessageLength );
+
+/* Encoded lengths, usable in constant expressions to size buffers and stack
+ * arrays. valueLength is the length of an attribute value before padding. */
+#define STUN_SERIALIZER_ATTRIBUTE_LENGTH( valueLength ) \
+    ( STUN_ATTRIBUTE_HEADER_LENGTH + STUN_ALIGN_SIZE_TO_WORD( valueLength ) )
+
+/* MESSAGE-INTEGRITY and FINGERPRINT. */
+#define STUN_SERIALIZER_SIGNATURE_LENGTH                                           \
+    ( STUN_SERIALIZER_ATTRIBUTE_LENGTH( STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH ) + \
+      STUN_SERIALIZER_ATTRIBUTE_LENGTH( STUN_ATTRIBUTE_FINGERPRINT_VALUE_LENGTH ) )
+
+/* Binding Request of an ICE connectivity check: USERNAME, ICE-CONTROLLING or
+ * ICE-CONTROLLED, PRIORITY, USE-CANDIDATE if useCandidate is non-zero,
+ * MESSAGE-INTEGRITY and FINGERPRINT. */
+#define STUN_SERIALIZER_ICE_CHECK_LENGTH( usernameLength, useCandidate )                   \
+    ( STUN_HEADER_LENGTH +                                                                 \
+      STUN_SERIALIZER_ATTRIBUTE_LENGTH( usernameLength ) +                                 \
+      STUN_SERIALIZER_ATTRIBUTE_LENGTH( STUN_ATTRIBUTE_ICE_CONTROLLING_VALUE_LENGTH ) +    \
+      STUN_SERIALIZER_ATTRIBUTE_LENGTH( STUN_ATTRIBUTE_PRIORITY_VALUE_LENGTH ) +           \
+      ( ( useCandidate ) ?                                                                 \
+        STUN_SERIALIZER_ATTRIBUTE_LENGTH( STUN_ATTRIBUTE_USE_CANDIDATE_VALUE_LENGTH ) : 0 ) + \
+      STUN_SERIALIZER_SIGNATURE_LENGTH )
+
+/* Binding success response to an ICE connectivity check: XOR-MAPPED-ADDRESS,
+ * MESSAGE-INTEGRITY and FINGERPRINT. addressValueLength is
+ * STUN_ATTRIBUTE_ADDRESS_IPV4_VALUE_LENGTH or
+ * STUN_ATTRIBUTE_ADDRESS_IPV6_VALUE_LENGTH. */
+#define STUN_SERIALIZER_ICE_CHECK_RESPONSE_LENGTH( addressValueLength ) \
+    ( STUN_HEADER_LENGTH +                                              \
+      STUN_SERIALIZER_ATTRIBUTE_LENGTH( addressValueLength ) +          \
+      STUN_SERIALIZER_SIGNATURE_LENGTH )
+
+/* TURN Send indication: XOR-PEER-ADDRESS and DATA. */
+#define STUN_SERIALIZER_SEND_INDICATION_LENGTH( addressValueLength, dataLength ) \
+    ( STUN_HEADER_LENGTH +                                                       \
+      STUN_SERIALIZER_ATTRIBUTE_LENGTH( addressValueLength ) +                   \
+      STUN_SERIALIZER_ATTRIBUTE_LENGTH( dataLength ) )
+
+/* An attribute of a message to size with
+ * StunSerializer_CalculateMessageLength. valueLength is the length of the
+ * value before padding, e.g. STUN_ATTRIBUTE_PRIORITY_VALUE_LENGTH for
+ * PRIORITY or STUN_ATTRIBUTE_ADDRESS_IPV4_VALUE_LENGTH for an IPv4 address. */
+typedef struct StunSerializerAttributeDescriptor
+{
+    StunAttributeType_t attributeType;
+    uint16_t valueLength;
+} StunSerializerAttributeDescriptor_t;
+
+/* Writes to pStunMessageLength the length that StunSerializer_Finalize returns
+ * for a message with the attributes in pAttributes, without serializing it.
+ * Attributes added by the finalize, such as with
+ * StunSerializer_FinalizeWithIntegrityAndFingerprint, must be listed too.
+ * Returns STUN_RESULT_BAD_PARAM if a value is longer than the serializer
+ * accepts, and STUN_RESULT_INVALID_MESSAGE_LENGTH if the message does not fit
+ * in the 16-bit message length. */
+StunResult_t StunSerializer_CalculateMessageLength( const StunSerializerAttributeDescriptor_t * pAttributes,
+                                                    size_t attributeCount,
+                                                    size_t * pStunMessageLength );
+
+/* Serializer state saved by StunSerializer_Checkpoint. Treat the members as
+ * private. */
+typedef struct StunSerializerCheckpoint
+{
+    StunContext_t ctx;
+} StunSerializerCheckpoint_t;
+
+/* Saves the state of the serializer, so that the attributes added after it
+ * can be discarded with StunSerializer_Restore. Together with
+ * StunSerializer_SetTransactionId, this serializes the attributes shared by
+ * several messages once, e.g. USERNAME and ICE-CONTROLLING of the checks of a
+ * session, and each message only adds its own attributes. */
+StunResult_t StunSerializer_Checkpoint( const StunContext_t * pCtx,
+                                        StunSerializerCheckpoint_t * pCheckpoint );
+
+/* Returns the serializer to pCheckpoint. The context must still use the buffer
+ * of the checkpoint, and the message must not have been truncated or
+ * re-initialized since. The hash stream, if any, is disabled. */
+StunResult_t StunSerializer_Restore( StunContext_t * pCtx,
+                                     const StunSerializerCheckpoint_t * pCheckpoint );
+
+/* Copies the message serialized so far in pCtx to pBuffer and initializes
+ * pForkCtx to continue it there, leaving pCtx unchanged. Returns
+ * STUN_RESULT_OUT_OF_MEMORY if the message does not fit in bufferLength. The
+ * hash stream of pCtx, if any, is not carried over. */
+StunResult_t StunSerializer_Fork( const StunContext_t * pCtx,
+                                  StunContext_t * pForkCtx,
+                                  uint8_t * pBuffer,
+                                  size_t bufferLength );
+
+/* Replaces the transaction ID in the header of the message, e.g. of a message
+ * restored from a checkpoint or forked. Disables the hash stream, if any. */
+StunResult_t StunSerializer_SetTransactionId( StunContext_t * pCtx,
+                                              const uint8_t * pTransactionId );
+
+/* Maximum number of parts returned by StunSerializer_FinalizeIoVec. */
+#define STUN_SERIALIZER_IOVEC_MAX_COUNT    3
+
+/* Same as StunSerializer_Finalize, but returns the message as the parts to
+ * send in order: the buffer up to the DATA value, the referenced DATA value and
+ * the rest of the buffer. A message without a referenced DATA value is
+ * returned as one part. Returns STUN_RESULT_OUT_OF_MEMORY if ioVecLength is
+ * less than the number of parts. */
+StunResult_t StunSerializer_FinalizeIoVec( StunContext_t * pCtx,
+                                           StunIoVec_t * pIoVecs,
+                                           size_t ioVecLength,
+                                           size_t * pIoVecCount );
+
+/* Writes the trailer of a message that is built without a StunContext_t, such
+ * as by StunMessageTemplate_Stamp and StunResponseBatch_SerializeBindingSuccess.
+ * The attributes before the trailer end at attributesLength bytes of pMessage.
+ * MESSAGE-INTEGRITY is computed with pIntegrityKey if it is not NULL, and
+ * FINGERPRINT is added if addFingerprint is set, with the length in the header
+ * that each covers. The caller checks that pMessage has room for them. The
+ * length of the message is written to pStunMessageLength. */
+StunResult_t StunSerializer_WriteTrailer( uint8_t * pMessage,
+                                          size_t attributesLength,
+                                          const StunIntegrityKey_t * pIntegrityKey,
+                                          uint8_t addFingerprint,
+                                          size_t * pStunMessageLength );
+
 #endif /* STUN_SERIALIZER_H */
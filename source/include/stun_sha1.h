@@ -0,0 +1,61 @@
+#ifndef STUN_SHA1_H
+#define STUN_SHA1_H
+
+/* Standard includes. */
+#include <stddef.h>
+#include <stdint.h>
+
+#define STUN_SHA1_BLOCK_LENGTH      64
+#define STUN_SHA1_DIGEST_LENGTH     20
+#define STUN_SHA1_STATE_WORDS       5
+
+/*
+ * SHA-1 compression function. Processes blockCount consecutive 64 byte blocks
+ * and updates the 5 word state in place.
+ *
+ * The library provides a portable implementation, one using the SHA
+ * extensions on x86-64 and one using the ARMv8 cryptography extensions. The
+ * fastest one supported by the CPU is returned by
+ * Stun_Sha1GetCompressFunction. Define STUN_DISABLE_SIMD to always use the
+ * portable one. An application with its own SHA-1 engine can set the compressFn
+ * member of StunSha1Context_t after Stun_Sha1Init.
+ */
+typedef void ( * StunSha1CompressFunction_t )( uint32_t * pState,
+                                               const uint8_t * pBlocks,
+                                               size_t blockCount );
+
+typedef struct StunSha1Context
+{
+    uint32_t state[ STUN_SHA1_STATE_WORDS ];
+    uint64_t totalLength;
+    uint8_t block[ STUN_SHA1_BLOCK_LENGTH ];
+    size_t blockLength;
+    StunSha1CompressFunction_t compressFn;
+} StunSha1Context_t;
+
+StunSha1CompressFunction_t Stun_Sha1GetCompressFunction( void );
+
+/* The portable compression function, available on all platforms. */
+void Stun_Sha1CompressPortable( uint32_t * pState,
+                                const uint8_t * pBlocks,
+                                size_t blockCount );
+
+void Stun_Sha1Init( StunSha1Context_t * pCtx );
+
+/* Starts from a state reached after processedLength bytes, which must be a
+ * multiple of STUN_SHA1_BLOCK_LENGTH. Used to resume from a precomputed state,
+ * such as the HMAC inner and outer key blocks. */
+void Stun_Sha1InitFromState( StunSha1Context_t * pCtx,
+                             const uint32_t * pState,
+                             uint64_t processedLength,
+                             StunSha1CompressFunction_t compressFn );
+
+void Stun_Sha1Update( StunSha1Context_t * pCtx,
+                      const uint8_t * pData,
+                      size_t dataLength );
+
+/* Writes STUN_SHA1_DIGEST_LENGTH bytes to pDigest. */
+void Stun_Sha1Final( StunSha1Context_t * pCtx,
+                     uint8_t * pDigest );
+
+#endif /* STUN_SHA1_H */
@@ -0,0 +1,81 @@
+#ifndef STUN_STREAM_PARSER_H
+#define STUN_STREAM_PARSER_H
+
+/* API includes. */
+#include "stun_data_types.h"
+#include "stun_classifier.h"
+
+/*
+ * Splits the data received on a TCP or TLS connection into frames, which can
+ * then be parsed in place with StunDeserializer_Init.
+ *
+ * The data is received in a buffer provided by the caller. Either receive
+ * directly into the space returned by StunStreamParser_GetWriteBuffer and call
+ * StunStreamParser_CommitWrite, or copy the received chunks with
+ * StunStreamParser_Feed. Then call StunStreamParser_GetNextFrame until it
+ * returns STUN_RESULT_NEED_MORE_DATA.
+ *
+ * The frames point into the buffer and stay valid until the next call to
+ * StunStreamParser_GetWriteBuffer or StunStreamParser_Feed, which move the
+ * data of an incomplete frame to the start of the buffer. The buffer must be
+ * large enough for the largest frame, including its length prefix and
+ * padding.
+ *
+ * Any other error from StunStreamParser_GetNextFrame means that the stream is
+ * not framed as expected and the connection should be closed.
+ */
+
+typedef enum StunStreamFraming
+{
+    /* STUN messages and padded TURN ChannelData messages back to back, as
+     * used by STUN and TURN over TCP (RFC 8489 and RFC 8656). */
+    STUN_STREAM_FRAMING_STUN,
+    /* Frames with a 16-bit length prefix as per RFC 4571, as used by ICE-TCP
+     * (RFC 6544). The frames can hold any packet type. */
+    STUN_STREAM_FRAMING_RFC4571,
+} StunStreamFraming_t;
+
+typedef struct StunStreamFrame
+{
+    StunPacketType_t packetType;
+    uint8_t * pFrame;       /* Without the RFC 4571 length prefix. */
+    size_t frameLength;     /* Without the ChannelData padding. */
+} StunStreamFrame_t;
+
+typedef struct StunStreamParser
+{
+    uint8_t * pBuffer;
+    size_t bufferLength;
+    size_t readIndex;   /* Start of the data not returned in a frame yet. */
+    size_t writeIndex;  /* End of the received data. */
+    StunStreamFraming_t framing;
+} StunStreamParser_t;
+
+StunResult_t StunStreamParser_Init( StunStreamParser_t * pParser,
+                                    uint8_t * pBuffer,
+                                    size_t bufferLength,
+                                    StunStreamFraming_t framing );
+
+/* Returns the free space at the end of the buffer, to receive into. Returns
+ * STUN_RESULT_OUT_OF_MEMORY if the buffer is full, i.e. if a frame does not
+ * fit in the buffer. */
+StunResult_t StunStreamParser_GetWriteBuffer( StunStreamParser_t * pParser,
+                                              uint8_t ** ppWriteBuffer,
+                                              size_t * pWriteBufferLength );
+
+/* Adds length bytes received into the write buffer. */
+StunResult_t StunStreamParser_CommitWrite( StunStreamParser_t * pParser,
+                                           size_t length );
+
+/* Copies as much of the data as fits in the buffer. pConsumedLength is set to
+ * the number of bytes copied. */
+StunResult_t StunStreamParser_Feed( StunStreamParser_t * pParser,
+                                    const uint8_t * pData,
+                                    size_t dataLength,
+                                    size_t * pConsumedLength );
+
+/* Returns the next complete frame, or STUN_RESULT_NEED_MORE_DATA. */
+StunResult_t StunStreamParser_GetNextFrame( StunStreamParser_t * pParser,
+                                            StunStreamFrame_t * pFrame );
+
+#endif /* STUN_STREAM_PARSER_H */
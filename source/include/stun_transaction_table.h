@@ -0,0 +1,87 @@
+#ifndef STUN_TRANSACTION_TABLE_H
+#define STUN_TRANSACTION_TABLE_H
+
+/* API includes. */
+#include "stun_data_types.h"
+
+/*
+ * Table of outstanding requests keyed by their 96-bit transaction ID, used to
+ * match the responses returned by StunDeserializer_Init to the requests.
+ *
+ * The table uses open addressing over groups of
+ * STUN_TRANSACTION_TABLE_GROUP_LENGTH slots. Every slot has a one byte tag,
+ * and the tags of a group are compared at once with SSE2 or NEON. Insert,
+ * lookup and remove are lock-free and can be called concurrently from any
+ * number of threads when built with GCC or Clang. Other compilers get a table
+ * that can only be used from one thread at a time.
+ *
+ * The tags, slots and overflow counts are provided by the caller. The capacity
+ * must be a power of 2 and a multiple of STUN_TRANSACTION_TABLE_GROUP_LENGTH.
+ * Lookups are fastest when at most half of the slots are used.
+ */
+
+#define STUN_TRANSACTION_TABLE_GROUP_LENGTH     16
+
+typedef struct StunTransactionSlot
+{
+    uint32_t sequence; /* Odd while the slot is being written. */
+    uint32_t transactionIdWords[ STUN_HEADER_TRANSACTION_ID_LENGTH / sizeof( uint32_t ) ];
+    void * pUserData;
+} StunTransactionSlot_t;
+
+typedef struct StunTransactionTable
+{
+    uint8_t * pTags;
+    StunTransactionSlot_t * pSlots;
+    uint32_t * pOverflowCounts; /* Per group, the transactions inserted past it. */
+    size_t capacity;
+    uint64_t seed;
+} StunTransactionTable_t;
+
+/* pTags and pSlots must have room for capacity entries, and pOverflowCounts
+ * for capacity / STUN_TRANSACTION_TABLE_GROUP_LENGTH entries. The seed
+ * randomizes the placement of the transaction IDs, so that a peer sending
+ * crafted transaction IDs cannot make the probe sequences long. Use a random
+ * value. */
+StunResult_t StunTransactionTable_Init( StunTransactionTable_t * pTable,
+                                        uint8_t * pTags,
+                                        StunTransactionSlot_t * pSlots,
+                                        uint32_t * pOverflowCounts,
+                                        size_t capacity,
+                                        uint64_t seed );
+
+/* Adds a request. The transaction IDs must be unique, which is not checked.
+ * Returns STUN_RESULT_OUT_OF_MEMORY if the table is full. */
+StunResult_t StunTransactionTable_Insert( StunTransactionTable_t * pTable,
+                                          const uint8_t * pTransactionId,
+                                          void * pUserData );
+
+/* Returns STUN_RESULT_TRANSACTION_NOT_FOUND if there is no request with the
+ * transaction ID. A request that another thread removes and inserts again
+ * during the lookup can also be reported as not found. */
+StunResult_t StunTransactionTable_Lookup( const StunTransactionTable_t * pTable,
+                                          const uint8_t * pTransactionId,
+                                          void ** ppUserData );
+
+/* Removes the request and returns its user data in ppUserData, which can be
+ * NULL. When several threads remove the same transaction ID, only one of them
+ * succeeds. As with StunTransactionTable_Lookup, a request that is removed and
+ * inserted again meanwhile can be reported as not found. */
+StunResult_t StunTransactionTable_Remove( StunTransactionTable_t * pTable,
+                                          const uint8_t * pTransactionId,
+                                          void ** ppUserData );
+
+/* Removes the request matching the header of a response, as filled by
+ * StunDeserializer_Init, and returns its user data. */
+StunResult_t StunTransactionTable_MatchResponse( StunTransactionTable_t * pTable,
+                                                 const StunHeader_t * pStunHeader,
+                                                 void ** ppUserData );
+
+/* Moves the requests that were inserted past the first group of their probe
+ * sequence back to the first free slot of it, which shortens the lookups of
+ * the requests and of missing transaction IDs after the table was close to
+ * full. Must not be called concurrently with any other function of the
+ * table. */
+StunResult_t StunTransactionTable_Rebuild( StunTransactionTable_t * pTable );
+
+#endif /* STUN_TRANSACTION_TABLE_H */
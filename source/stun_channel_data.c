@@ -0,0 +1,184 @@
+/* Standard includes. */
+#include <string.h>
+
+/* API includes. */
+#include "stun_channel_data.h"
+
+#define STUN_CHANNEL_NUMBER_IS_VALID( channelNumber )       \
+    ( ( ( channelNumber ) >= STUN_CHANNEL_NUMBER_MIN ) &&   \
+      ( ( channelNumber ) <= STUN_CHANNEL_NUMBER_MAX ) )
+
+/*-----------------------------------------------------------*/
+
+/* Static Functions. */
+static void EncodeChannelData( const StunChannelData_t * pChannelData,
+                               uint8_t addPadding,
+                               StunMessageBuffer_t * pEncoded );
+
+/*-----------------------------------------------------------*/
+
+static void EncodeChannelData( const StunChannelData_t * pChannelData,
+                               uint8_t addPadding,
+                               StunMessageBuffer_t * pEncoded )
+{
+    uint8_t * pHeader = pChannelData->pData - STUN_CHANNEL_DATA_HEADER_LENGTH;
+    size_t paddingLength = 0;
+
+    Stun_WriteUint16( &( pHeader[ STUN_CHANNEL_DATA_CHANNEL_NUMBER_OFFSET ] ), pChannelData->channelNumber );
+    Stun_WriteUint16( &( pHeader[ STUN_CHANNEL_DATA_LENGTH_OFFSET ] ), pChannelData->dataLength );
+
+    if( addPadding != 0U )
+    {
+        paddingLength = ( 4U - ( pChannelData->dataLength & 0x03U ) ) & 0x03U;
+
+        if( paddingLength > 0U )
+        {
+            ( void ) memset( &( pChannelData->pData[ pChannelData->dataLength ] ), 0, paddingLength );
+        }
+    }
+
+    pEncoded->pStunMessage = pHeader;
+    pEncoded->stunMessageLength = STUN_CHANNEL_DATA_HEADER_LENGTH + ( size_t ) pChannelData->dataLength + paddingLength;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunChannelData_Encode( const StunChannelData_t * pChannelData,
+                                     uint8_t addPadding,
+                                     StunMessageBuffer_t * pEncoded )
+{
+    StunResult_t result = STUN_RESULT_OK;
+
+    if( ( pChannelData == NULL ) ||
+        ( pChannelData->pData == NULL ) ||
+        ( pEncoded == NULL ) ||
+        ( !STUN_CHANNEL_NUMBER_IS_VALID( pChannelData->channelNumber ) ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        EncodeChannelData( pChannelData, addPadding, pEncoded );
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunChannelData_Decode( uint8_t * pPacket,
+                                     size_t packetLength,
+                                     StunChannelData_t * pChannelData )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    uint16_t channelNumber, dataLength;
+
+    if( ( pPacket == NULL ) ||
+        ( pChannelData == NULL ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+    else if( packetLength < STUN_CHANNEL_DATA_HEADER_LENGTH )
+    {
+        result = STUN_RESULT_INVALID_MESSAGE_LENGTH;
+    }
+    else
+    {
+        channelNumber = Stun_ReadUint16( &( pPacket[ STUN_CHANNEL_DATA_CHANNEL_NUMBER_OFFSET ] ) );
+        dataLength = Stun_ReadUint16( &( pPacket[ STUN_CHANNEL_DATA_LENGTH_OFFSET ] ) );
+
+        if( !STUN_CHANNEL_NUMBER_IS_VALID( channelNumber ) )
+        {
+            result = STUN_RESULT_INVALID_FRAME;
+        }
+        else if( ( size_t ) dataLength > ( packetLength - STUN_CHANNEL_DATA_HEADER_LENGTH ) )
+        {
+            result = STUN_RESULT_INVALID_MESSAGE_LENGTH;
+        }
+        else
+        {
+            pChannelData->channelNumber = channelNumber;
+            pChannelData->pData = &( pPacket[ STUN_CHANNEL_DATA_HEADER_LENGTH ] );
+            pChannelData->dataLength = dataLength;
+        }
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunChannelData_EncodeBatch( const StunChannelData_t * pChannelData,
+                                          size_t count,
+                                          uint8_t addPadding,
+                                          StunMessageBuffer_t * pEncoded )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    size_t i;
+
+    if( ( ( pChannelData == NULL ) || ( pEncoded == NULL ) ) &&
+        ( count > 0 ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    for( i = 0; ( i < count ) && ( result == STUN_RESULT_OK ); i++ )
+    {
+        if( ( pChannelData[ i ].pData == NULL ) ||
+            ( !STUN_CHANNEL_NUMBER_IS_VALID( pChannelData[ i ].channelNumber ) ) )
+        {
+            result = STUN_RESULT_BAD_PARAM;
+        }
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        for( i = 0; i < count; i++ )
+        {
+            EncodeChannelData( &( pChannelData[ i ] ), addPadding, &( pEncoded[ i ] ) );
+        }
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunChannelData_DecodeBatch( const StunMessageBuffer_t * pPackets,
+                                          size_t packetCount,
+                                          StunChannelData_t * pChannelData,
+                                          StunResult_t * pResults,
+                                          size_t * pValidPacketCount )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    size_t i, validCount = 0;
+
+    if( ( ( ( pPackets == NULL ) || ( pChannelData == NULL ) || ( pResults == NULL ) ) &&
+          ( packetCount > 0 ) ) ||
+        ( pValidPacketCount == NULL ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        for( i = 0; i < packetCount; i++ )
+        {
+            pResults[ i ] = StunChannelData_Decode( pPackets[ i ].pStunMessage,
+                                                    pPackets[ i ].stunMessageLength,
+                                                    &( pChannelData[ i ] ) );
+
+            if( pResults[ i ] == STUN_RESULT_OK )
+            {
+                validCount++;
+            }
+        }
+
+        *pValidPacketCount = validCount;
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
@@ -0,0 +1,489 @@
+/* Standard includes. */
+#include <string.h>
+
+/* API includes. */
+#include "stun_classifier.h"
+
+/*
+ * The batch classifier gathers the bytes it needs from every packet into a
+ * block of arrays and then classifies the block with SIMD instructions:
+ * - SSE2 on x86, which is always present on x86-64.
+ * - AVX2 on x86 with GCC/Clang, selected at run time if the CPU supports it.
+ * - NEON on ARM.
+ * Define STUN_DISABLE_SIMD to always use the portable implementation.
+ */
+#if !defined( STUN_DISABLE_SIMD )
+    #if defined( __SSE2__ ) || defined( _M_X64 )
+        #include <emmintrin.h>
+        #define STUN_CLASSIFIER_USE_SSE2
+        #if defined( __GNUC__ ) || defined( __clang__ )
+            #include <immintrin.h>
+            #define STUN_CLASSIFIER_USE_AVX2
+        #endif
+    #elif defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+        #include <arm_neon.h>
+        #define STUN_CLASSIFIER_USE_NEON
+    #endif
+#endif /* if !defined( STUN_DISABLE_SIMD ) */
+
+/* Number of packets classified together. Must be a multiple of 32. */
+#define STUN_CLASSIFIER_BLOCK_LENGTH    64
+
+/* First byte used for the packets that are too short to have one. It is not in
+ * any of the RFC 7983 ranges. */
+#define STUN_CLASSIFIER_EMPTY_PACKET_FIRST_BYTE     0xFF
+
+/* Offset of the least significant byte of the message length in the STUN
+ * header. */
+#define STUN_CLASSIFIER_LENGTH_LOW_BYTE_OFFSET      ( STUN_HEADER_MESSAGE_LENGTH_OFFSET + 1 )
+
+/* Bytes gathered from the packets of a block. */
+typedef struct ClassifierBlock
+{
+    uint8_t firstBytes[ STUN_CLASSIFIER_BLOCK_LENGTH ];
+    uint8_t lengthLowBytes[ STUN_CLASSIFIER_BLOCK_LENGTH ];
+    uint32_t magicCookies[ STUN_CLASSIFIER_BLOCK_LENGTH ]; /* In network byte order. */
+} ClassifierBlock_t;
+
+/*-----------------------------------------------------------*/
+
+/* Static Functions. */
+static uint32_t GetExpectedMagicCookie( void );
+
+static uint8_t ClassifyFirstByte( uint8_t firstByte,
+                                  uint8_t isStunHeaderValid );
+
+static void GatherBlock( const StunMessageBuffer_t * pPackets,
+                         size_t packetCount,
+                         ClassifierBlock_t * pBlock );
+
+static void ClassifyBlock( const ClassifierBlock_t * pBlock,
+                           uint32_t expectedMagicCookie,
+                           uint8_t * pPacketTypes );
+
+/*-----------------------------------------------------------*/
+
+static uint32_t GetExpectedMagicCookie( void )
+{
+    static const uint8_t magicCookieBytes[ sizeof( uint32_t ) ] = { 0x21, 0x12, 0xA4, 0x42 };
+    uint32_t magicCookie;
+
+    memcpy( ( void * ) &( magicCookie ),
+            ( const void * ) &( magicCookieBytes[ 0 ] ),
+            sizeof( magicCookie ) );
+
+    return magicCookie;
+}
+
+/*-----------------------------------------------------------*/
+
+static uint8_t ClassifyFirstByte( uint8_t firstByte,
+                                  uint8_t isStunHeaderValid )
+{
+    uint8_t packetType = STUN_PACKET_TYPE_UNKNOWN;
+
+    if( firstByte <= STUN_CLASSIFIER_STUN_FIRST_BYTE_MAX )
+    {
+        if( isStunHeaderValid != 0 )
+        {
+            packetType = STUN_PACKET_TYPE_STUN;
+        }
+    }
+    else if( ( firstByte >= STUN_CLASSIFIER_ZRTP_FIRST_BYTE_MIN ) &&
+             ( firstByte <= STUN_CLASSIFIER_ZRTP_FIRST_BYTE_MAX ) )
+    {
+        packetType = STUN_PACKET_TYPE_ZRTP;
+    }
+    else if( ( firstByte >= STUN_CLASSIFIER_DTLS_FIRST_BYTE_MIN ) &&
+             ( firstByte <= STUN_CLASSIFIER_DTLS_FIRST_BYTE_MAX ) )
+    {
+        packetType = STUN_PACKET_TYPE_DTLS;
+    }
+    else if( ( firstByte >= STUN_CLASSIFIER_CHANNEL_DATA_FIRST_BYTE_MIN ) &&
+             ( firstByte <= STUN_CLASSIFIER_CHANNEL_DATA_FIRST_BYTE_MAX ) )
+    {
+        packetType = STUN_PACKET_TYPE_CHANNEL_DATA;
+    }
+    else if( ( firstByte >= STUN_CLASSIFIER_RTP_FIRST_BYTE_MIN ) &&
+             ( firstByte <= STUN_CLASSIFIER_RTP_FIRST_BYTE_MAX ) )
+    {
+        packetType = STUN_PACKET_TYPE_RTP;
+    }
+    else
+    {
+        /* Empty action. */
+    }
+
+    return packetType;
+}
+
+/*-----------------------------------------------------------*/
+
+static void GatherBlock( const StunMessageBuffer_t * pPackets,
+                         size_t packetCount,
+                         ClassifierBlock_t * pBlock )
+{
+    size_t i, packetLength;
+    const uint8_t * pPacket;
+
+    /* The lanes after packetCount are filled like empty packets, so that they
+     * are classified as unknown and the kernels never read uninitialized
+     * bytes. */
+    memset( ( void * ) &( pBlock->firstBytes[ packetCount ] ),
+            STUN_CLASSIFIER_EMPTY_PACKET_FIRST_BYTE,
+            STUN_CLASSIFIER_BLOCK_LENGTH - packetCount );
+    memset( ( void * ) &( pBlock->lengthLowBytes[ packetCount ] ),
+            0,
+            STUN_CLASSIFIER_BLOCK_LENGTH - packetCount );
+    memset( ( void * ) &( pBlock->magicCookies[ packetCount ] ),
+            0,
+            ( STUN_CLASSIFIER_BLOCK_LENGTH - packetCount ) * sizeof( uint32_t ) );
+
+    for( i = 0; i < packetCount; i++ )
+    {
+        pPacket = pPackets[ i ].pStunMessage;
+        packetLength = ( pPacket != NULL ) ? pPackets[ i ].stunMessageLength : 0;
+
+        pBlock->firstBytes[ i ] = ( packetLength > 0 ) ? pPacket[ 0 ] : STUN_CLASSIFIER_EMPTY_PACKET_FIRST_BYTE;
+
+        if( packetLength >= STUN_HEADER_LENGTH )
+        {
+            pBlock->lengthLowBytes[ i ] = pPacket[ STUN_CLASSIFIER_LENGTH_LOW_BYTE_OFFSET ];
+            memcpy( ( void * ) &( pBlock->magicCookies[ i ] ),
+                    ( const void * ) &( pPacket[ STUN_HEADER_MAGIC_COOKIE_OFFSET ] ),
+                    sizeof( uint32_t ) );
+        }
+        else
+        {
+            /* Zero never matches the magic cookie. */
+            pBlock->lengthLowBytes[ i ] = 0;
+            pBlock->magicCookies[ i ] = 0;
+        }
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+#if defined( STUN_CLASSIFIER_USE_SSE2 )
+
+/* LCOV_EXCL_START */
+/* Per byte lane: 0xFF if min <= byte <= max, 0x00 otherwise. */
+static inline __m128i InRangeSse2( __m128i bytes,
+                                   uint8_t min,
+                                   uint8_t max )
+{
+    __m128i offset = _mm_sub_epi8( bytes, _mm_set1_epi8( ( char ) min ) );
+
+    return _mm_cmpeq_epi8( _mm_min_epu8( offset, _mm_set1_epi8( ( char ) ( max - min ) ) ), offset );
+}
+
+/*-----------------------------------------------------------*/
+
+static void ClassifyBlockSse2( const ClassifierBlock_t * pBlock,
+                               uint32_t expectedMagicCookie,
+                               uint8_t * pPacketTypes )
+{
+    size_t i;
+    const __m128i magicCookie = _mm_set1_epi32( ( int ) expectedMagicCookie );
+    __m128i firstBytes, lengthAligned, cookieMatch, isStun, packetTypes;
+    __m128i cookie0, cookie1, cookie2, cookie3;
+
+    for( i = 0; i < STUN_CLASSIFIER_BLOCK_LENGTH; i += 16 )
+    {
+        firstBytes = _mm_loadu_si128( ( const __m128i * ) &( pBlock->firstBytes[ i ] ) );
+
+        /* Compare 4 cookies at a time and narrow the 32-bit masks to bytes. */
+        cookie0 = _mm_cmpeq_epi32( _mm_loadu_si128( ( const __m128i * ) &( pBlock->magicCookies[ i ] ) ), magicCookie );
+        cookie1 = _mm_cmpeq_epi32( _mm_loadu_si128( ( const __m128i * ) &( pBlock->magicCookies[ i + 4 ] ) ), magicCookie );
+        cookie2 = _mm_cmpeq_epi32( _mm_loadu_si128( ( const __m128i * ) &( pBlock->magicCookies[ i + 8 ] ) ), magicCookie );
+        cookie3 = _mm_cmpeq_epi32( _mm_loadu_si128( ( const __m128i * ) &( pBlock->magicCookies[ i + 12 ] ) ), magicCookie );
+        cookieMatch = _mm_packs_epi16( _mm_packs_epi32( cookie0, cookie1 ),
+                                       _mm_packs_epi32( cookie2, cookie3 ) );
+
+        lengthAligned = _mm_cmpeq_epi8( _mm_and_si128( _mm_loadu_si128( ( const __m128i * ) &( pBlock->lengthLowBytes[ i ] ) ),
+                                                       _mm_set1_epi8( 0x3 ) ),
+                                        _mm_setzero_si128() );
+
+        isStun = _mm_and_si128( InRangeSse2( firstBytes, STUN_CLASSIFIER_STUN_FIRST_BYTE_MIN, STUN_CLASSIFIER_STUN_FIRST_BYTE_MAX ),
+                                _mm_and_si128( cookieMatch, lengthAligned ) );
+
+        /* The ranges do not overlap, so the types can be OR-ed together. */
+        packetTypes = _mm_and_si128( isStun, _mm_set1_epi8( STUN_PACKET_TYPE_STUN ) );
+        packetTypes = _mm_or_si128( packetTypes,
+                                    _mm_and_si128( InRangeSse2( firstBytes, STUN_CLASSIFIER_ZRTP_FIRST_BYTE_MIN, STUN_CLASSIFIER_ZRTP_FIRST_BYTE_MAX ),
+                                                   _mm_set1_epi8( STUN_PACKET_TYPE_ZRTP ) ) );
+        packetTypes = _mm_or_si128( packetTypes,
+                                    _mm_and_si128( InRangeSse2( firstBytes, STUN_CLASSIFIER_DTLS_FIRST_BYTE_MIN, STUN_CLASSIFIER_DTLS_FIRST_BYTE_MAX ),
+                                                   _mm_set1_epi8( STUN_PACKET_TYPE_DTLS ) ) );
+        packetTypes = _mm_or_si128( packetTypes,
+                                    _mm_and_si128( InRangeSse2( firstBytes, STUN_CLASSIFIER_CHANNEL_DATA_FIRST_BYTE_MIN, STUN_CLASSIFIER_CHANNEL_DATA_FIRST_BYTE_MAX ),
+                                                   _mm_set1_epi8( STUN_PACKET_TYPE_CHANNEL_DATA ) ) );
+        packetTypes = _mm_or_si128( packetTypes,
+                                    _mm_and_si128( InRangeSse2( firstBytes, STUN_CLASSIFIER_RTP_FIRST_BYTE_MIN, STUN_CLASSIFIER_RTP_FIRST_BYTE_MAX ),
+                                                   _mm_set1_epi8( STUN_PACKET_TYPE_RTP ) ) );
+
+        _mm_storeu_si128( ( __m128i * ) &( pPacketTypes[ i ] ), packetTypes );
+    }
+}
+
+/* LCOV_EXCL_STOP */
+
+#endif /* if defined( STUN_CLASSIFIER_USE_SSE2 ) */
+
+/*-----------------------------------------------------------*/
+
+#if defined( STUN_CLASSIFIER_USE_AVX2 )
+
+/* LCOV_EXCL_START */
+/* Per byte lane: 0xFF if min <= byte <= max, 0x00 otherwise. */
+__attribute__( ( target( "avx2" ) ) )
+static inline __m256i InRangeAvx2( __m256i bytes,
+                                   uint8_t min,
+                                   uint8_t max )
+{
+    __m256i offset = _mm256_sub_epi8( bytes, _mm256_set1_epi8( ( char ) min ) );
+
+    return _mm256_cmpeq_epi8( _mm256_min_epu8( offset, _mm256_set1_epi8( ( char ) ( max - min ) ) ), offset );
+}
+
+/*-----------------------------------------------------------*/
+
+__attribute__( ( target( "avx2" ) ) )
+static void ClassifyBlockAvx2( const ClassifierBlock_t * pBlock,
+                               uint32_t expectedMagicCookie,
+                               uint8_t * pPacketTypes )
+{
+    size_t i;
+    const __m256i magicCookie = _mm256_set1_epi32( ( int ) expectedMagicCookie );
+    /* The packs below work within 128-bit lanes. This restores the order of
+     * the 32-bit groups after them. */
+    const __m256i packOrder = _mm256_setr_epi32( 0, 4, 1, 5, 2, 6, 3, 7 );
+    __m256i firstBytes, lengthAligned, cookieMatch, isStun, packetTypes;
+    __m256i cookie0, cookie1, cookie2, cookie3;
+
+    for( i = 0; i < STUN_CLASSIFIER_BLOCK_LENGTH; i += 32 )
+    {
+        firstBytes = _mm256_loadu_si256( ( const __m256i * ) &( pBlock->firstBytes[ i ] ) );
+
+        /* Compare 8 cookies at a time and narrow the 32-bit masks to bytes. */
+        cookie0 = _mm256_cmpeq_epi32( _mm256_loadu_si256( ( const __m256i * ) &( pBlock->magicCookies[ i ] ) ), magicCookie );
+        cookie1 = _mm256_cmpeq_epi32( _mm256_loadu_si256( ( const __m256i * ) &( pBlock->magicCookies[ i + 8 ] ) ), magicCookie );
+        cookie2 = _mm256_cmpeq_epi32( _mm256_loadu_si256( ( const __m256i * ) &( pBlock->magicCookies[ i + 16 ] ) ), magicCookie );
+        cookie3 = _mm256_cmpeq_epi32( _mm256_loadu_si256( ( const __m256i * ) &( pBlock->magicCookies[ i + 24 ] ) ), magicCookie );
+        cookieMatch = _mm256_packs_epi16( _mm256_packs_epi32( cookie0, cookie1 ),
+                                          _mm256_packs_epi32( cookie2, cookie3 ) );
+        cookieMatch = _mm256_permutevar8x32_epi32( cookieMatch, packOrder );
+
+        lengthAligned = _mm256_cmpeq_epi8( _mm256_and_si256( _mm256_loadu_si256( ( const __m256i * ) &( pBlock->lengthLowBytes[ i ] ) ),
+                                                             _mm256_set1_epi8( 0x3 ) ),
+                                           _mm256_setzero_si256() );
+
+        isStun = _mm256_and_si256( InRangeAvx2( firstBytes, STUN_CLASSIFIER_STUN_FIRST_BYTE_MIN, STUN_CLASSIFIER_STUN_FIRST_BYTE_MAX ),
+                                   _mm256_and_si256( cookieMatch, lengthAligned ) );
+
+        /* The ranges do not overlap, so the types can be OR-ed together. */
+        packetTypes = _mm256_and_si256( isStun, _mm256_set1_epi8( STUN_PACKET_TYPE_STUN ) );
+        packetTypes = _mm256_or_si256( packetTypes,
+                                       _mm256_and_si256( InRangeAvx2( firstBytes, STUN_CLASSIFIER_ZRTP_FIRST_BYTE_MIN, STUN_CLASSIFIER_ZRTP_FIRST_BYTE_MAX ),
+                                                         _mm256_set1_epi8( STUN_PACKET_TYPE_ZRTP ) ) );
+        packetTypes = _mm256_or_si256( packetTypes,
+                                       _mm256_and_si256( InRangeAvx2( firstBytes, STUN_CLASSIFIER_DTLS_FIRST_BYTE_MIN, STUN_CLASSIFIER_DTLS_FIRST_BYTE_MAX ),
+                                                         _mm256_set1_epi8( STUN_PACKET_TYPE_DTLS ) ) );
+        packetTypes = _mm256_or_si256( packetTypes,
+                                       _mm256_and_si256( InRangeAvx2( firstBytes, STUN_CLASSIFIER_CHANNEL_DATA_FIRST_BYTE_MIN, STUN_CLASSIFIER_CHANNEL_DATA_FIRST_BYTE_MAX ),
+                                                         _mm256_set1_epi8( STUN_PACKET_TYPE_CHANNEL_DATA ) ) );
+        packetTypes = _mm256_or_si256( packetTypes,
+                                       _mm256_and_si256( InRangeAvx2( firstBytes, STUN_CLASSIFIER_RTP_FIRST_BYTE_MIN, STUN_CLASSIFIER_RTP_FIRST_BYTE_MAX ),
+                                                         _mm256_set1_epi8( STUN_PACKET_TYPE_RTP ) ) );
+
+        _mm256_storeu_si256( ( __m256i * ) &( pPacketTypes[ i ] ), packetTypes );
+    }
+}
+
+/* LCOV_EXCL_STOP */
+
+#endif /* if defined( STUN_CLASSIFIER_USE_AVX2 ) */
+
+/*-----------------------------------------------------------*/
+
+#if defined( STUN_CLASSIFIER_USE_NEON )
+
+/* LCOV_EXCL_START */
+/* Per byte lane: 0xFF if min <= byte <= max, 0x00 otherwise. */
+static inline uint8x16_t InRangeNeon( uint8x16_t bytes,
+                                      uint8_t min,
+                                      uint8_t max )
+{
+    return vcleq_u8( vsubq_u8( bytes, vdupq_n_u8( min ) ), vdupq_n_u8( ( uint8_t ) ( max - min ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+static void ClassifyBlockNeon( const ClassifierBlock_t * pBlock,
+                               uint32_t expectedMagicCookie,
+                               uint8_t * pPacketTypes )
+{
+    size_t i;
+    const uint32x4_t magicCookie = vdupq_n_u32( expectedMagicCookie );
+    uint8x16_t firstBytes, lengthAligned, cookieMatch, isStun, packetTypes;
+    uint16x8_t cookie01, cookie23;
+
+    for( i = 0; i < STUN_CLASSIFIER_BLOCK_LENGTH; i += 16 )
+    {
+        firstBytes = vld1q_u8( &( pBlock->firstBytes[ i ] ) );
+
+        /* Compare 4 cookies at a time and narrow the 32-bit masks to bytes. */
+        cookie01 = vcombine_u16( vmovn_u32( vceqq_u32( vld1q_u32( &( pBlock->magicCookies[ i ] ) ), magicCookie ) ),
+                                 vmovn_u32( vceqq_u32( vld1q_u32( &( pBlock->magicCookies[ i + 4 ] ) ), magicCookie ) ) );
+        cookie23 = vcombine_u16( vmovn_u32( vceqq_u32( vld1q_u32( &( pBlock->magicCookies[ i + 8 ] ) ), magicCookie ) ),
+                                 vmovn_u32( vceqq_u32( vld1q_u32( &( pBlock->magicCookies[ i + 12 ] ) ), magicCookie ) ) );
+        cookieMatch = vcombine_u8( vmovn_u16( cookie01 ), vmovn_u16( cookie23 ) );
+
+        lengthAligned = vceqq_u8( vandq_u8( vld1q_u8( &( pBlock->lengthLowBytes[ i ] ) ), vdupq_n_u8( 0x3 ) ),
+                                  vdupq_n_u8( 0 ) );
+
+        isStun = vandq_u8( InRangeNeon( firstBytes, STUN_CLASSIFIER_STUN_FIRST_BYTE_MIN, STUN_CLASSIFIER_STUN_FIRST_BYTE_MAX ),
+                           vandq_u8( cookieMatch, lengthAligned ) );
+
+        /* The ranges do not overlap, so the types can be OR-ed together. */
+        packetTypes = vandq_u8( isStun, vdupq_n_u8( STUN_PACKET_TYPE_STUN ) );
+        packetTypes = vorrq_u8( packetTypes,
+                                vandq_u8( InRangeNeon( firstBytes, STUN_CLASSIFIER_ZRTP_FIRST_BYTE_MIN, STUN_CLASSIFIER_ZRTP_FIRST_BYTE_MAX ),
+                                          vdupq_n_u8( STUN_PACKET_TYPE_ZRTP ) ) );
+        packetTypes = vorrq_u8( packetTypes,
+                                vandq_u8( InRangeNeon( firstBytes, STUN_CLASSIFIER_DTLS_FIRST_BYTE_MIN, STUN_CLASSIFIER_DTLS_FIRST_BYTE_MAX ),
+                                          vdupq_n_u8( STUN_PACKET_TYPE_DTLS ) ) );
+        packetTypes = vorrq_u8( packetTypes,
+                                vandq_u8( InRangeNeon( firstBytes, STUN_CLASSIFIER_CHANNEL_DATA_FIRST_BYTE_MIN, STUN_CLASSIFIER_CHANNEL_DATA_FIRST_BYTE_MAX ),
+                                          vdupq_n_u8( STUN_PACKET_TYPE_CHANNEL_DATA ) ) );
+        packetTypes = vorrq_u8( packetTypes,
+                                vandq_u8( InRangeNeon( firstBytes, STUN_CLASSIFIER_RTP_FIRST_BYTE_MIN, STUN_CLASSIFIER_RTP_FIRST_BYTE_MAX ),
+                                          vdupq_n_u8( STUN_PACKET_TYPE_RTP ) ) );
+
+        vst1q_u8( &( pPacketTypes[ i ] ), packetTypes );
+    }
+}
+
+/* LCOV_EXCL_STOP */
+
+#endif /* if defined( STUN_CLASSIFIER_USE_NEON ) */
+
+/*-----------------------------------------------------------*/
+
+static void ClassifyBlock( const ClassifierBlock_t * pBlock,
+                           uint32_t expectedMagicCookie,
+                           uint8_t * pPacketTypes )
+{
+    #if defined( STUN_CLASSIFIER_USE_AVX2 )
+        /* The kernel depends on the CPU, so it is excluded from the coverage.
+         * The unit tests check that the kernel selected on the test machine
+         * agrees with StunClassifier_ClassifyPacket. */
+        /* LCOV_EXCL_START */
+        if( __builtin_cpu_supports( "avx2" ) )
+        {
+            ClassifyBlockAvx2( pBlock, expectedMagicCookie, pPacketTypes );
+        }
+        else
+        {
+            ClassifyBlockSse2( pBlock, expectedMagicCookie, pPacketTypes );
+        }
+        /* LCOV_EXCL_STOP */
+    #elif defined( STUN_CLASSIFIER_USE_SSE2 )
+        ClassifyBlockSse2( pBlock, expectedMagicCookie, pPacketTypes );
+    #elif defined( STUN_CLASSIFIER_USE_NEON )
+        ClassifyBlockNeon( pBlock, expectedMagicCookie, pPacketTypes );
+    #else
+        size_t i;
+        uint8_t isStunHeaderValid;
+
+        for( i = 0; i < STUN_CLASSIFIER_BLOCK_LENGTH; i++ )
+        {
+            isStunHeaderValid = ( ( pBlock->magicCookies[ i ] == expectedMagicCookie ) &&
+                                  ( ( pBlock->lengthLowBytes[ i ] & 0x3 ) == 0 ) ) ? 1 : 0;
+            pPacketTypes[ i ] = ClassifyFirstByte( pBlock->firstBytes[ i ],
+                                                   isStunHeaderValid );
+        }
+    #endif /* if defined( STUN_CLASSIFIER_USE_AVX2 ) */
+}
+
+/*-----------------------------------------------------------*/
+
+StunPacketType_t StunClassifier_ClassifyPacket( const uint8_t * pPacket,
+                                                size_t packetLength )
+{
+    uint8_t packetType = STUN_PACKET_TYPE_UNKNOWN;
+    uint8_t isStunHeaderValid = 0;
+    uint32_t magicCookie;
+
+    if( ( pPacket != NULL ) &&
+        ( packetLength > 0 ) )
+    {
+        if( packetLength >= STUN_HEADER_LENGTH )
+        {
+            memcpy( ( void * ) &( magicCookie ),
+                    ( const void * ) &( pPacket[ STUN_HEADER_MAGIC_COOKIE_OFFSET ] ),
+                    sizeof( magicCookie ) );
+
+            if( ( magicCookie == GetExpectedMagicCookie() ) &&
+                ( ( pPacket[ STUN_CLASSIFIER_LENGTH_LOW_BYTE_OFFSET ] & 0x3 ) == 0 ) )
+            {
+                isStunHeaderValid = 1;
+            }
+        }
+
+        packetType = ClassifyFirstByte( pPacket[ 0 ],
+                                        isStunHeaderValid );
+    }
+
+    return ( StunPacketType_t ) packetType;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunClassifier_ClassifyBatch( const StunMessageBuffer_t * pPackets,
+                                           size_t packetCount,
+                                           uint8_t * pPacketTypes )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    ClassifierBlock_t block;
+    uint8_t packetTypes[ STUN_CLASSIFIER_BLOCK_LENGTH ];
+    uint32_t expectedMagicCookie;
+    size_t blockStart, blockLength;
+
+    if( ( ( pPackets == NULL ) || ( pPacketTypes == NULL ) ) &&
+        ( packetCount > 0 ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        expectedMagicCookie = GetExpectedMagicCookie();
+
+        for( blockStart = 0; blockStart < packetCount; blockStart += blockLength )
+        {
+            blockLength = packetCount - blockStart;
+
+            if( blockLength > STUN_CLASSIFIER_BLOCK_LENGTH )
+            {
+                blockLength = STUN_CLASSIFIER_BLOCK_LENGTH;
+            }
+
+            GatherBlock( &( pPackets[ blockStart ] ),
+                         blockLength,
+                         &( block ) );
+
+            ClassifyBlock( &( block ),
+                           expectedMagicCookie,
+                           &( packetTypes[ 0 ] ) );
+
+            memcpy( ( void * ) &( pPacketTypes[ blockStart ] ),
+                    ( const void * ) &( packetTypes[ 0 ] ),
+                    blockLength );
+        }
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
@@ -0,0 +1,263 @@
+/* Standard includes. */
+#include <string.h>
+
+/* API includes. */
+#include "stun_credential_cache.h"
+
+/* FNV-1a parameters. */
+#define STUN_CREDENTIAL_CACHE_FNV_OFFSET_BASIS      0x811C9DC5U
+#define STUN_CREDENTIAL_CACHE_FNV_PRIME             0x01000193U
+
+/*-----------------------------------------------------------*/
+
+/* Static Functions. */
+static uint32_t HashCredential( const uint8_t * pUsername,
+                                uint16_t usernameLength,
+                                const uint8_t * pRealm,
+                                uint16_t realmLength );
+
+static StunCredentialCacheEntry_t * FindEntry( const StunCredentialCache_t * pCache,
+                                               uint32_t hash,
+                                               const uint8_t * pUsername,
+                                               uint16_t usernameLength,
+                                               const uint8_t * pRealm,
+                                               uint16_t realmLength );
+
+static StunCredentialCacheEntry_t * SelectVictim( const StunCredentialCache_t * pCache,
+                                                  uint32_t hash );
+
+/*-----------------------------------------------------------*/
+
+static uint32_t HashCredential( const uint8_t * pUsername,
+                                uint16_t usernameLength,
+                                const uint8_t * pRealm,
+                                uint16_t realmLength )
+{
+    uint32_t hash = STUN_CREDENTIAL_CACHE_FNV_OFFSET_BASIS;
+    uint16_t i;
+
+    for( i = 0; i < usernameLength; i++ )
+    {
+        hash = ( hash ^ pUsername[ i ] ) * STUN_CREDENTIAL_CACHE_FNV_PRIME;
+    }
+
+    /* Separate the username from the realm, as in the key derivation. */
+    hash = ( hash ^ ( uint8_t ) ':' ) * STUN_CREDENTIAL_CACHE_FNV_PRIME;
+
+    for( i = 0; i < realmLength; i++ )
+    {
+        hash = ( hash ^ pRealm[ i ] ) * STUN_CREDENTIAL_CACHE_FNV_PRIME;
+    }
+
+    return hash;
+}
+
+/*-----------------------------------------------------------*/
+
+static StunCredentialCacheEntry_t * FindEntry( const StunCredentialCache_t * pCache,
+                                               uint32_t hash,
+                                               const uint8_t * pUsername,
+                                               uint16_t usernameLength,
+                                               const uint8_t * pRealm,
+                                               uint16_t realmLength )
+{
+    StunCredentialCacheEntry_t * pEntry = NULL, * pCandidate;
+    size_t i, index = hash % pCache->entryCount;
+
+    /* Entries can be removed from the middle of a probe sequence, so all the
+     * probed entries are checked rather than stopping at the first free one. */
+    for( i = 0; ( i < STUN_CREDENTIAL_CACHE_PROBE_LENGTH ) && ( i < pCache->entryCount ); i++ )
+    {
+        pCandidate = &( pCache->pEntries[ index ] );
+
+        if( ( pCandidate->inUse != 0 ) &&
+            ( pCandidate->hash == hash ) &&
+            ( pCandidate->usernameLength == usernameLength ) &&
+            ( pCandidate->realmLength == realmLength ) &&
+            ( memcmp( &( pCandidate->username[ 0 ] ), pUsername, usernameLength ) == 0 ) &&
+            ( memcmp( &( pCandidate->realm[ 0 ] ), pRealm, realmLength ) == 0 ) )
+        {
+            pEntry = pCandidate;
+            break;
+        }
+
+        index = ( index + 1 ) % pCache->entryCount;
+    }
+
+    return pEntry;
+}
+
+/*-----------------------------------------------------------*/
+
+static StunCredentialCacheEntry_t * SelectVictim( const StunCredentialCache_t * pCache,
+                                                  uint32_t hash )
+{
+    StunCredentialCacheEntry_t * pEntry = NULL;
+    size_t i, index = hash % pCache->entryCount;
+
+    for( i = 0; ( i < STUN_CREDENTIAL_CACHE_PROBE_LENGTH ) && ( i < pCache->entryCount ); i++ )
+    {
+        if( pCache->pEntries[ index ].inUse == 0 )
+        {
+            pEntry = &( pCache->pEntries[ index ] );
+            break;
+        }
+
+        index = ( index + 1 ) % pCache->entryCount;
+    }
+
+    /* All the probed entries are in use - evict the first one. */
+    if( pEntry == NULL )
+    {
+        pEntry = &( pCache->pEntries[ hash % pCache->entryCount ] );
+    }
+
+    return pEntry;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunCredentialCache_Init( StunCredentialCache_t * pCache,
+                                       StunCredentialCacheEntry_t * pEntries,
+                                       size_t entryCount )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    size_t i;
+
+    if( ( pCache == NULL ) ||
+        ( pEntries == NULL ) ||
+        ( entryCount == 0 ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        for( i = 0; i < entryCount; i++ )
+        {
+            pEntries[ i ].inUse = 0;
+        }
+
+        pCache->pEntries = pEntries;
+        pCache->entryCount = entryCount;
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunCredentialCache_GetKey( StunCredentialCache_t * pCache,
+                                         const uint8_t * pUsername,
+                                         uint16_t usernameLength,
+                                         const uint8_t * pRealm,
+                                         uint16_t realmLength,
+                                         const uint8_t * pPassword,
+                                         size_t passwordLength,
+                                         const StunIntegrityKey_t ** ppIntegrityKey )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    StunCredentialCacheEntry_t * pEntry = NULL;
+    uint32_t hash = 0;
+
+    if( ( pCache == NULL ) ||
+        ( pCache->pEntries == NULL ) ||
+        ( pCache->entryCount == 0 ) ||
+        ( pUsername == NULL ) ||
+        ( pRealm == NULL ) ||
+        ( ( pPassword == NULL ) && ( passwordLength != 0 ) ) ||
+        ( ppIntegrityKey == NULL ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        if( ( usernameLength > STUN_CREDENTIAL_CACHE_MAX_USERNAME_LENGTH ) ||
+            ( realmLength > STUN_CREDENTIAL_CACHE_MAX_REALM_LENGTH ) )
+        {
+            result = STUN_RESULT_OUT_OF_MEMORY;
+        }
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        hash = HashCredential( pUsername, usernameLength, pRealm, realmLength );
+        pEntry = FindEntry( pCache, hash, pUsername, usernameLength, pRealm, realmLength );
+
+        if( pEntry == NULL )
+        {
+            pEntry = SelectVictim( pCache, hash );
+            pEntry->inUse = 0;
+
+            /* These cannot fail, the parameters were checked above. */
+            ( void ) StunIntegrity_DeriveLongTermKey( pUsername,
+                                                      usernameLength,
+                                                      pRealm,
+                                                      realmLength,
+                                                      pPassword,
+                                                      passwordLength,
+                                                      &( pEntry->longTermKey[ 0 ] ) );
+            ( void ) StunIntegrity_InitKey( &( pEntry->integrityKey ),
+                                            &( pEntry->longTermKey[ 0 ] ),
+                                            STUN_INTEGRITY_LONG_TERM_KEY_LENGTH,
+                                            NULL );
+
+            memcpy( ( void * ) &( pEntry->username[ 0 ] ),
+                    ( const void * ) pUsername,
+                    usernameLength );
+            memcpy( ( void * ) &( pEntry->realm[ 0 ] ),
+                    ( const void * ) pRealm,
+                    realmLength );
+
+            pEntry->usernameLength = usernameLength;
+            pEntry->realmLength = realmLength;
+            pEntry->hash = hash;
+            pEntry->inUse = 1;
+        }
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        *ppIntegrityKey = &( pEntry->integrityKey );
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunCredentialCache_Remove( StunCredentialCache_t * pCache,
+                                         const uint8_t * pUsername,
+                                         uint16_t usernameLength,
+                                         const uint8_t * pRealm,
+                                         uint16_t realmLength )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    StunCredentialCacheEntry_t * pEntry;
+    uint32_t hash;
+
+    if( ( pCache == NULL ) ||
+        ( pCache->pEntries == NULL ) ||
+        ( pCache->entryCount == 0 ) ||
+        ( pUsername == NULL ) ||
+        ( pRealm == NULL ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        hash = HashCredential( pUsername, usernameLength, pRealm, realmLength );
+        pEntry = FindEntry( pCache, hash, pUsername, usernameLength, pRealm, realmLength );
+
+        if( pEntry != NULL )
+        {
+            pEntry->inUse = 0;
+        }
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
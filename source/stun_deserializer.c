@@ -4,14 +4,144 @@
 
 /* API includes. */
 #include "stun_deserializer.h"
+#include "stun_crc32.h"
 
 /* Read/Write macros. */
-#define STUN_WRITE_UINT16   ( pCtx->readWriteFunctions.writeUint16Fn )
-#define STUN_WRITE_UINT32   ( pCtx->readWriteFunctions.writeUint32Fn )
-#define STUN_WRITE_UINT64   ( pCtx->readWriteFunctions.writeUint64Fn )
-#define STUN_READ_UINT16    ( pCtx->readWriteFunctions.readUint16Fn )
-#define STUN_READ_UINT32    ( pCtx->readWriteFunctions.readUint32Fn )
-#define STUN_READ_UINT64    ( pCtx->readWriteFunctions.readUint64Fn )
+#if defined( STUN_USE_COMPILE_TIME_ENDIANNESS )
+    #define STUN_WRITE_UINT16   Stun_WriteUint16
+    #define STUN_WRITE_UINT32   Stun_WriteUint32
+    #define STUN_WRITE_UINT64   Stun_WriteUint64
+    #define STUN_READ_UINT16    Stun_ReadUint16
+    #define STUN_READ_UINT32    Stun_ReadUint32
+    #define STUN_READ_UINT64    Stun_ReadUint64
+#else
+    #define STUN_WRITE_UINT16   ( pCtx->readWriteFunctions.writeUint16Fn )
+    #define STUN_WRITE_UINT32   ( pCtx->readWriteFunctions.writeUint32Fn )
+    #define STUN_WRITE_UINT64   ( pCtx->readWriteFunctions.writeUint64Fn )
+    #define STUN_READ_UINT16    ( pCtx->readWriteFunctions.readUint16Fn )
+    #define STUN_READ_UINT32    ( pCtx->readWriteFunctions.readUint32Fn )
+    #define STUN_READ_UINT64    ( pCtx->readWriteFunctions.readUint64Fn )
+#endif
+
+/* Number of messages whose headers are gathered before they are validated in
+ * StunDeserializer_InitBatch. */
+#define STUN_BATCH_BLOCK_LENGTH     64
+
+/* Slots of GetAttributeIndexSlot for the attributes decoded into
+ * StunMessageView_t. */
+#define STUN_VIEW_OPTIONAL_SLOT( type )         ( ( size_t ) ( STUN_ATTRIBUTE_INDEX_REQUIRED_RANGE_END + 1 ) + ( size_t ) ( ( type ) - STUN_ATTRIBUTE_INDEX_OPTIONAL_RANGE_START ) )
+#define STUN_VIEW_SLOT_USERNAME                 ( ( size_t ) STUN_ATTRIBUTE_TYPE_USERNAME )
+#define STUN_VIEW_SLOT_MESSAGE_INTEGRITY        ( ( size_t ) STUN_ATTRIBUTE_TYPE_MESSAGE_INTEGRITY )
+#define STUN_VIEW_SLOT_ERROR_CODE               ( ( size_t ) STUN_ATTRIBUTE_TYPE_ERROR_CODE )
+#define STUN_VIEW_SLOT_CHANNEL_NUMBER           ( ( size_t ) STUN_ATTRIBUTE_TYPE_CHANNEL_NUMBER )
+#define STUN_VIEW_SLOT_LIFETIME                 ( ( size_t ) STUN_ATTRIBUTE_TYPE_LIFETIME )
+#define STUN_VIEW_SLOT_DATA                     ( ( size_t ) STUN_ATTRIBUTE_TYPE_DATA )
+#define STUN_VIEW_SLOT_REALM                    ( ( size_t ) STUN_ATTRIBUTE_TYPE_REALM )
+#define STUN_VIEW_SLOT_NONCE                    ( ( size_t ) STUN_ATTRIBUTE_TYPE_NONCE )
+#define STUN_VIEW_SLOT_XOR_MAPPED_ADDRESS       ( ( size_t ) STUN_ATTRIBUTE_TYPE_XOR_MAPPED_ADDRESS )
+#define STUN_VIEW_SLOT_PRIORITY                 ( ( size_t ) STUN_ATTRIBUTE_TYPE_PRIORITY )
+#define STUN_VIEW_SLOT_FINGERPRINT              STUN_VIEW_OPTIONAL_SLOT( STUN_ATTRIBUTE_TYPE_FINGERPRINT )
+#define STUN_VIEW_SLOT_ICE_CONTROLLED           STUN_VIEW_OPTIONAL_SLOT( STUN_ATTRIBUTE_TYPE_ICE_CONTROLLED )
+#define STUN_VIEW_SLOT_ICE_CONTROLLING          STUN_VIEW_OPTIONAL_SLOT( STUN_ATTRIBUTE_TYPE_ICE_CONTROLLING )
+
+#define STUN_VIEW_SLOT_BIT( slot )              ( ( uint64_t ) 1U << ( slot ) )
+#define STUN_VIEW_IS_PRESENT( pView, slot )     ( ( ( pView )->attributesPresent & STUN_VIEW_SLOT_BIT( slot ) ) != 0U )
+/* The view records the attribute offsets from the end of the header, like
+ * StunDeserializer_BuildIndex, so that they fit in 16 bits for any message
+ * length. */
+#define STUN_VIEW_ATTRIBUTE_START( offset )     ( ( size_t ) ( offset ) + STUN_HEADER_LENGTH )
+#define STUN_VIEW_VALUE( pCtx, offset )         ( &( ( pCtx )->pStart[ STUN_VIEW_ATTRIBUTE_START( offset ) + STUN_ATTRIBUTE_HEADER_VALUE_OFFSET ] ) )
+
+/* Length rules for the attributes in the slots of GetAttributeIndexSlot. A
+ * length is valid if it is within [ minLength, maxLength ] or is equal to
+ * alternateLength. */
+#define STUN_ATTRIBUTE_LENGTH_RULE_RANGE( min, max )    { ( min ), ( max ), ( min ) }
+#define STUN_ATTRIBUTE_LENGTH_RULE_EXACT( length )      STUN_ATTRIBUTE_LENGTH_RULE_RANGE( length, length )
+#define STUN_ATTRIBUTE_LENGTH_RULE_ADDRESS              { STUN_ATTRIBUTE_ADDRESS_IPV4_VALUE_LENGTH, STUN_ATTRIBUTE_ADDRESS_IPV4_VALUE_LENGTH, STUN_ATTRIBUTE_ADDRESS_IPV6_VALUE_LENGTH }
+#define STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT              STUN_ATTRIBUTE_LENGTH_RULE_RANGE( 0, STUN_ATTRIBUTE_VALUE_MAX_LENGTH )
+
+typedef struct StunAttributeLengthRule
+{
+    uint16_t minLength;
+    uint16_t maxLength;
+    uint16_t alternateLength;
+} StunAttributeLengthRule_t;
+
+/* Indexed by the slot returned from GetAttributeIndexSlot. */
+static const StunAttributeLengthRule_t attributeLengthRules[ STUN_ATTRIBUTE_INDEX_SLOT_COUNT ] =
+{
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x0000 */
+    STUN_ATTRIBUTE_LENGTH_RULE_ADDRESS, /* 0x0001 MAPPED_ADDRESS */
+    STUN_ATTRIBUTE_LENGTH_RULE_ADDRESS, /* 0x0002 RESPONSE_ADDRESS */
+    STUN_ATTRIBUTE_LENGTH_RULE_EXACT( STUN_ATTRIBUTE_CHANGE_REQUEST_VALUE_LENGTH ), /* 0x0003 CHANGE_REQUEST */
+    STUN_ATTRIBUTE_LENGTH_RULE_ADDRESS, /* 0x0004 SOURCE_ADDRESS */
+    STUN_ATTRIBUTE_LENGTH_RULE_ADDRESS, /* 0x0005 CHANGED_ADDRESS */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x0006 USERNAME */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x0007 PASSWORD */
+    STUN_ATTRIBUTE_LENGTH_RULE_EXACT( STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH ), /* 0x0008 MESSAGE_INTEGRITY */
+    STUN_ATTRIBUTE_LENGTH_RULE_RANGE( STUN_ATTRIBUTE_ERROR_CODE_VALUE_MIN_LENGTH, STUN_ATTRIBUTE_ERROR_CODE_VALUE_MAX_LENGTH ), /* 0x0009 ERROR_CODE */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x000A UNKNOWN_ATTRIBUTES */
+    STUN_ATTRIBUTE_LENGTH_RULE_ADDRESS, /* 0x000B REFLECTED_FROM */
+    STUN_ATTRIBUTE_LENGTH_RULE_EXACT( STUN_ATTRIBUTE_CHANNEL_NUMBER_VALUE_LENGTH ), /* 0x000C CHANNEL_NUMBER */
+    STUN_ATTRIBUTE_LENGTH_RULE_EXACT( STUN_ATTRIBUTE_LIFETIME_VALUE_LENGTH ), /* 0x000D LIFETIME */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x000E */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x000F */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x0010 */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x0011 */
+    STUN_ATTRIBUTE_LENGTH_RULE_ADDRESS, /* 0x0012 XOR_PEER_ADDRESS */
+    STUN_ATTRIBUTE_LENGTH_RULE_RANGE( 0, STUN_ATTRIBUTE_DATA_VALUE_MAX_LENGTH ), /* 0x0013 DATA */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x0014 REALM */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x0015 NONCE */
+    STUN_ATTRIBUTE_LENGTH_RULE_ADDRESS, /* 0x0016 XOR_RELAYED_ADDRESS */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x0017 */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x0018 EVEN_PORT */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x0019 REQUESTED_TRANSPORT */
+    STUN_ATTRIBUTE_LENGTH_RULE_EXACT( STUN_ATTRIBUTE_DONT_FRAGMENT_VALUE_LENGTH ), /* 0x001A DONT_FRAGMENT */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x001B */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x001C */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x001D */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x001E */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x001F */
+    STUN_ATTRIBUTE_LENGTH_RULE_ADDRESS, /* 0x0020 XOR_MAPPED_ADDRESS */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x0021 */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x0022 RESERVATION_TOKEN */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x0023 */
+    STUN_ATTRIBUTE_LENGTH_RULE_EXACT( STUN_ATTRIBUTE_PRIORITY_VALUE_LENGTH ), /* 0x0024 PRIORITY */
+    STUN_ATTRIBUTE_LENGTH_RULE_EXACT( STUN_ATTRIBUTE_USE_CANDIDATE_VALUE_LENGTH ), /* 0x0025 USE_CANDIDATE */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x0026 */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x0027 */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x0028 */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x0029 */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x002A */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x002B */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x002C */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x002D */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x002E */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x002F */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x8020 */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x8021 */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x8022 */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x8023 */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x8024 */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x8025 */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x8026 */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x8027 */
+    STUN_ATTRIBUTE_LENGTH_RULE_EXACT( STUN_ATTRIBUTE_FINGERPRINT_VALUE_LENGTH ), /* 0x8028 FINGERPRINT */
+    STUN_ATTRIBUTE_LENGTH_RULE_EXACT( STUN_ATTRIBUTE_ICE_CONTROLLED_VALUE_LENGTH ), /* 0x8029 ICE_CONTROLLED */
+    STUN_ATTRIBUTE_LENGTH_RULE_EXACT( STUN_ATTRIBUTE_ICE_CONTROLLING_VALUE_LENGTH ), /* 0x802A ICE_CONTROLLING */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x802B */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x802C */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x802D */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT, /* 0x802E */
+    STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT /* 0x802F */
+};
+
+/* Rule for the attribute types outside of the slots, i.e. comprehension
+ * required types above 0x002F and comprehension optional types outside of
+ * 0x8020-0x802F. */
+static const StunAttributeLengthRule_t defaultAttributeLengthRule = STUN_ATTRIBUTE_LENGTH_RULE_DEFAULT;
+
+static const StunAttributeValue_t emptyAttributeValue = { NULL, 0 };
 
 /*-----------------------------------------------------------*/
 
@@ -26,6 +156,24 @@ static StunResult_t ParseAttributeUint64( const StunContext_t * pCtx,
                                           uint64_t * pVal,
                                           StunAttributeType_t attributeType );
 
+static StunResult_t GetHashRange( const StunContext_t * pCtx,
+                                  uint16_t attributeValueLength,
+                                  StunHashRange_t * pRange );
+
+static uint8_t GetAttributeIndexSlot( StunAttributeType_t attributeType,
+                                      size_t * pSlot );
+
+static inline StunResult_t ReadNextAttribute( StunContext_t * pCtx,
+                                              StunAttribute_t * pAttribute );
+
+static void GetViewAttributeValue( const StunContext_t * pCtx,
+                                   uint16_t attributeOffset,
+                                   StunAttributeValue_t * pValue );
+
+static StunResult_t DecodeViewAttributes( const StunContext_t * pCtx,
+                                          const uint16_t * pAttributeOffsets,
+                                          StunMessageView_t * pView );
+
 /*-----------------------------------------------------------*/
 
 static StunResult_t ParseAttributeUint32( const StunContext_t * pCtx,
@@ -35,6 +183,11 @@ static StunResult_t ParseAttributeUint32( const StunContext_t * pCtx,
 {
     StunResult_t result = STUN_RESULT_OK;
 
+    #if defined( STUN_USE_COMPILE_TIME_ENDIANNESS )
+        /* The context is only needed for the read/write function table. */
+        ( void ) pCtx;
+    #endif
+
     if( ( pAttribute == NULL ) ||
         ( pVal == NULL ) ||
         ( pAttribute->attributeType != attributeType ) ||
@@ -68,6 +221,11 @@ static StunResult_t ParseAttributeUint64( const StunContext_t * pCtx,
 {
     StunResult_t result = STUN_RESULT_OK;
 
+    #if defined( STUN_USE_COMPILE_TIME_ENDIANNESS )
+        /* The context is only needed for the read/write function table. */
+        ( void ) pCtx;
+    #endif
+
     if( ( pAttribute == NULL ) ||
         ( pVal == NULL ) ||
         ( pAttribute->attributeType != attributeType ) ||
@@ -94,142 +252,274 @@ static StunResult_t ParseAttributeUint64( const StunContext_t * pCtx,
 
 /*-----------------------------------------------------------*/
 
+static uint8_t GetAttributeIndexSlot( StunAttributeType_t attributeType,
+                                      size_t * pSlot )
+{
+    uint8_t isIndexed = 1;
+    uint16_t type = ( uint16_t ) attributeType;
+
+    if( type <= STUN_ATTRIBUTE_INDEX_REQUIRED_RANGE_END )
+    {
+        *pSlot = type;
+    }
+    else if( ( type >= STUN_ATTRIBUTE_INDEX_OPTIONAL_RANGE_START ) &&
+             ( type <= STUN_ATTRIBUTE_INDEX_OPTIONAL_RANGE_END ) )
+    {
+        *pSlot = ( size_t ) ( STUN_ATTRIBUTE_INDEX_REQUIRED_RANGE_END + 1 ) +
+                 ( size_t ) ( type - STUN_ATTRIBUTE_INDEX_OPTIONAL_RANGE_START );
+    }
+    else
+    {
+        isIndexed = 0;
+    }
+
+    return isIndexed;
+}
+
+/*-----------------------------------------------------------*/
+
+static void GetViewAttributeValue( const StunContext_t * pCtx,
+                                   uint16_t attributeOffset,
+                                   StunAttributeValue_t * pValue )
+{
+    #if defined( STUN_USE_COMPILE_TIME_ENDIANNESS )
+        /* The context is only needed for the read/write function table. */
+        ( void ) pCtx;
+    #endif
+
+    pValue->valueLength = STUN_READ_UINT16( &( pCtx->pStart[ STUN_VIEW_ATTRIBUTE_START( attributeOffset ) + STUN_ATTRIBUTE_HEADER_LENGTH_OFFSET ] ) );
+
+    if( pValue->valueLength > 0 )
+    {
+        pValue->pValue = STUN_VIEW_VALUE( pCtx, attributeOffset );
+    }
+    else
+    {
+        pValue->pValue = NULL;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* Decodes the attributes after the walk, so that each field is a predictable
+ * branch on attributesPresent rather than a dispatch per attribute. The lengths
+ * of the fixed size attributes have been checked against attributeLengthRules
+ * by ReadNextAttribute, so the values are read without going through the
+ * StunDeserializer_ParseAttribute* checks. */
+static StunResult_t DecodeViewAttributes( const StunContext_t * pCtx,
+                                          const uint16_t * pAttributeOffsets,
+                                          StunMessageView_t * pView )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    StunAttribute_t attribute;
+    const uint8_t * pValue;
+
+    if( STUN_VIEW_IS_PRESENT( pView, STUN_VIEW_SLOT_PRIORITY ) )
+    {
+        pView->priority = STUN_READ_UINT32( STUN_VIEW_VALUE( pCtx, pAttributeOffsets[ STUN_VIEW_SLOT_PRIORITY ] ) );
+    }
+
+    /* A message carries only one of the two roles. If both are present, the
+     * ICE-CONTROLLING tie-breaker is used. */
+    if( STUN_VIEW_IS_PRESENT( pView, STUN_VIEW_SLOT_ICE_CONTROLLING ) )
+    {
+        pView->iceTieBreaker = STUN_READ_UINT64( STUN_VIEW_VALUE( pCtx, pAttributeOffsets[ STUN_VIEW_SLOT_ICE_CONTROLLING ] ) );
+    }
+    else if( STUN_VIEW_IS_PRESENT( pView, STUN_VIEW_SLOT_ICE_CONTROLLED ) )
+    {
+        pView->iceTieBreaker = STUN_READ_UINT64( STUN_VIEW_VALUE( pCtx, pAttributeOffsets[ STUN_VIEW_SLOT_ICE_CONTROLLED ] ) );
+    }
+    else
+    {
+        /* Not an ICE connectivity check. */
+    }
+
+    if( STUN_VIEW_IS_PRESENT( pView, STUN_VIEW_SLOT_USERNAME ) )
+    {
+        GetViewAttributeValue( pCtx, pAttributeOffsets[ STUN_VIEW_SLOT_USERNAME ], &( pView->username ) );
+    }
+
+    if( STUN_VIEW_IS_PRESENT( pView, STUN_VIEW_SLOT_MESSAGE_INTEGRITY ) )
+    {
+        pView->integrityOffset = ( uint32_t ) STUN_VIEW_ATTRIBUTE_START( pAttributeOffsets[ STUN_VIEW_SLOT_MESSAGE_INTEGRITY ] );
+    }
+
+    if( STUN_VIEW_IS_PRESENT( pView, STUN_VIEW_SLOT_FINGERPRINT ) )
+    {
+        pView->fingerprintOffset = ( uint32_t ) STUN_VIEW_ATTRIBUTE_START( pAttributeOffsets[ STUN_VIEW_SLOT_FINGERPRINT ] );
+    }
+
+    /* Attributes of responses and TURN messages. */
+    if( STUN_VIEW_IS_PRESENT( pView, STUN_VIEW_SLOT_XOR_MAPPED_ADDRESS ) )
+    {
+        attribute.attributeType = STUN_ATTRIBUTE_TYPE_XOR_MAPPED_ADDRESS;
+        attribute.attributeValueLength = STUN_READ_UINT16( &( pCtx->pStart[ STUN_VIEW_ATTRIBUTE_START( pAttributeOffsets[ STUN_VIEW_SLOT_XOR_MAPPED_ADDRESS ] ) +
+                                                                            STUN_ATTRIBUTE_HEADER_LENGTH_OFFSET ] ) );
+        attribute.pAttributeValue = STUN_VIEW_VALUE( pCtx, pAttributeOffsets[ STUN_VIEW_SLOT_XOR_MAPPED_ADDRESS ] );
+
+        result = StunDeserializer_ParseAttributeAddress( pCtx,
+                                                         &( attribute ),
+                                                         &( pView->xorMappedAddress ) );
+    }
+
+    if( STUN_VIEW_IS_PRESENT( pView, STUN_VIEW_SLOT_ERROR_CODE ) )
+    {
+        /* The reason phrase can be empty. */
+        pValue = STUN_VIEW_VALUE( pCtx, pAttributeOffsets[ STUN_VIEW_SLOT_ERROR_CODE ] );
+        pView->errorCode = STUN_GET_ERROR( pValue[ STUN_ATTRIBUTE_ERROR_CODE_CLASS_OFFSET ],
+                                           pValue[ STUN_ATTRIBUTE_ERROR_CODE_NUMBER_OFFSET ] );
+    }
+
+    if( STUN_VIEW_IS_PRESENT( pView, STUN_VIEW_SLOT_LIFETIME ) )
+    {
+        pView->lifetime = STUN_READ_UINT32( STUN_VIEW_VALUE( pCtx, pAttributeOffsets[ STUN_VIEW_SLOT_LIFETIME ] ) );
+    }
+
+    if( STUN_VIEW_IS_PRESENT( pView, STUN_VIEW_SLOT_CHANNEL_NUMBER ) )
+    {
+        pView->channelNumber = STUN_READ_UINT16( STUN_VIEW_VALUE( pCtx, pAttributeOffsets[ STUN_VIEW_SLOT_CHANNEL_NUMBER ] ) );
+    }
+
+    if( STUN_VIEW_IS_PRESENT( pView, STUN_VIEW_SLOT_REALM ) )
+    {
+        GetViewAttributeValue( pCtx, pAttributeOffsets[ STUN_VIEW_SLOT_REALM ], &( pView->realm ) );
+    }
+
+    if( STUN_VIEW_IS_PRESENT( pView, STUN_VIEW_SLOT_NONCE ) )
+    {
+        GetViewAttributeValue( pCtx, pAttributeOffsets[ STUN_VIEW_SLOT_NONCE ], &( pView->nonce ) );
+    }
+
+    if( STUN_VIEW_IS_PRESENT( pView, STUN_VIEW_SLOT_DATA ) )
+    {
+        GetViewAttributeValue( pCtx, pAttributeOffsets[ STUN_VIEW_SLOT_DATA ], &( pView->data ) );
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
 static uint8_t IsAttributeLengthValid( StunAttributeType_t attributeType,
                                        size_t attributeValueLength )
 {
-    uint8_t isValid = 0;
+    const StunAttributeLengthRule_t * pRule = &( defaultAttributeLengthRule );
+    size_t slot;
 
-    switch( attributeType )
+    if( GetAttributeIndexSlot( attributeType,
+                               &( slot ) ) == 1 )
     {
-        case STUN_ATTRIBUTE_TYPE_MAPPED_ADDRESS:
-        case STUN_ATTRIBUTE_TYPE_RESPONSE_ADDRESS:
-        case STUN_ATTRIBUTE_TYPE_SOURCE_ADDRESS:
-        case STUN_ATTRIBUTE_TYPE_CHANGED_ADDRESS:
-        case STUN_ATTRIBUTE_TYPE_REFLECTED_FROM:
-        case STUN_ATTRIBUTE_TYPE_XOR_MAPPED_ADDRESS:
-        case STUN_ATTRIBUTE_TYPE_XOR_RELAYED_ADDRESS:
-        case STUN_ATTRIBUTE_TYPE_XOR_PEER_ADDRESS:
-        {
-            if( ( attributeValueLength == STUN_ATTRIBUTE_ADDRESS_IPV4_VALUE_LENGTH ) ||
-                ( attributeValueLength == STUN_ATTRIBUTE_ADDRESS_IPV6_VALUE_LENGTH ) )
-            {
-                isValid = 1;
-            }
-        }
-        break;
+        pRule = &( attributeLengthRules[ slot ] );
+    }
 
-        case STUN_ATTRIBUTE_TYPE_MESSAGE_INTEGRITY:
-        {
-            if( attributeValueLength == STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH )
-            {
-                isValid = 1;
-            }
-        }
-        break;
+    /* The subtraction wraps around for lengths below the minimum, which makes
+     * the range check a single unsigned comparison. */
+    return ( uint8_t ) ( ( ( attributeValueLength - pRule->minLength ) <= ( size_t ) ( pRule->maxLength - pRule->minLength ) ) |
+                         ( attributeValueLength == pRule->alternateLength ) );
+}
 
-        case STUN_ATTRIBUTE_TYPE_FINGERPRINT:
-        {
-            if( attributeValueLength == STUN_ATTRIBUTE_FINGERPRINT_VALUE_LENGTH )
-            {
-                isValid = 1;
-            }
-        }
-        break;
+/*-----------------------------------------------------------*/
 
-        case STUN_ATTRIBUTE_TYPE_PRIORITY:
-        {
-            if( attributeValueLength == STUN_ATTRIBUTE_PRIORITY_VALUE_LENGTH )
-            {
-                isValid = 1;
-            }
-        }
-        break;
+static StunResult_t GetHashRange( const StunContext_t * pCtx,
+                                  uint16_t attributeValueLength,
+                                  StunHashRange_t * pRange )
+{
+    StunResult_t result = STUN_RESULT_OK;
 
-        case STUN_ATTRIBUTE_TYPE_LIFETIME:
-        {
-            if( attributeValueLength == STUN_ATTRIBUTE_LIFETIME_VALUE_LENGTH )
-            {
-                isValid = 1;
-            }
-        }
-        break;
+    /* The attribute covered by the hash must have been read, i.e. be the one
+     * that ends at currentIndex. */
+    if( pCtx->currentIndex < ( size_t ) ( STUN_HEADER_LENGTH + STUN_ATTRIBUTE_TOTAL_LENGTH( attributeValueLength ) ) )
+    {
+        result = STUN_RESULT_INVALID_MESSAGE_LENGTH;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        pRange->pStunMessage = pCtx->pStart;
+        pRange->stunMessageLength = pCtx->currentIndex - STUN_ATTRIBUTE_TOTAL_LENGTH( attributeValueLength );
+        pRange->patchedMessageLength = pCtx->currentIndex - STUN_HEADER_LENGTH;
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+static inline StunResult_t ReadNextAttribute( StunContext_t * pCtx,
+                                              StunAttribute_t * pAttribute )
+{
+    StunResult_t result = STUN_RESULT_OK;
+
+    if( STUN_REMAINING_LENGTH( pCtx ) < STUN_ATTRIBUTE_HEADER_LENGTH )
+    {
+        result = STUN_RESULT_NO_MORE_ATTRIBUTE_FOUND;
+    }
 
-        case STUN_ATTRIBUTE_TYPE_CHANNEL_NUMBER:
+    if( result == STUN_RESULT_OK )
+    {
+        /* Read attribute type. */
+        pAttribute->attributeType = ( StunAttributeType_t ) STUN_READ_UINT16( &( pCtx->pStart[ pCtx->currentIndex ] ) );
+
+        /* Check that it is correct attribute at this position. */
+        if( ( pCtx->attributeFlag & STUN_FLAG_FINGERPRINT_ATTRIBUTE ) != 0 )
         {
-            if( attributeValueLength == STUN_ATTRIBUTE_CHANNEL_NUMBER_VALUE_LENGTH )
-            {
-                isValid = 1;
-            }
+            /* No more attributes can be present after Fingerprint - it must  be
+             * the last attribute. */
+            result = STUN_RESULT_INVALID_ATTRIBUTE_ORDER;
         }
-        break;
-
-        case STUN_ATTRIBUTE_TYPE_CHANGE_REQUEST:
+        else if( ( ( pCtx->attributeFlag & STUN_FLAG_INTEGRITY_ATTRIBUTE ) != 0 ) &&
+                 ( pAttribute->attributeType != STUN_ATTRIBUTE_TYPE_FINGERPRINT ) )
         {
-            if( attributeValueLength == STUN_ATTRIBUTE_CHANGE_REQUEST_VALUE_LENGTH )
-            {
-                isValid = 1;
-            }
+            /* No attribute other than Fingerprint can be present after
+             * Integrity attribute. */
+            result = STUN_RESULT_INVALID_ATTRIBUTE_ORDER;
         }
-        break;
+    }
 
-        case STUN_ATTRIBUTE_TYPE_ERROR_CODE:
+    if( result == STUN_RESULT_OK )
+    {
+        if( pAttribute->attributeType == STUN_ATTRIBUTE_TYPE_FINGERPRINT )
         {
-            if( ( attributeValueLength >= STUN_ATTRIBUTE_ERROR_CODE_VALUE_MIN_LENGTH ) &&
-                ( attributeValueLength <= STUN_ATTRIBUTE_ERROR_CODE_VALUE_MAX_LENGTH ) )
-            {
-                isValid = 1;
-            }
+            pCtx->attributeFlag |= STUN_FLAG_FINGERPRINT_ATTRIBUTE;
         }
-        break;
-
-        case STUN_ATTRIBUTE_TYPE_DONT_FRAGMENT:
+        if( pAttribute->attributeType == STUN_ATTRIBUTE_TYPE_MESSAGE_INTEGRITY )
         {
-            if( attributeValueLength == STUN_ATTRIBUTE_DONT_FRAGMENT_VALUE_LENGTH )
-            {
-                isValid = 1;
-            }
+            pCtx->attributeFlag |= STUN_FLAG_INTEGRITY_ATTRIBUTE;
         }
-        break;
 
-        case STUN_ATTRIBUTE_TYPE_USE_CANDIDATE:
+        /* Read attribute length. */
+        pAttribute->attributeValueLength = STUN_READ_UINT16( &( pCtx->pStart[ pCtx->currentIndex +
+                                                                              STUN_ATTRIBUTE_HEADER_LENGTH_OFFSET ] ) );
+
+        /* Check that we have enough data to read attribute value. */
+        if( STUN_REMAINING_LENGTH( pCtx ) < ( size_t ) STUN_ATTRIBUTE_TOTAL_LENGTH( pAttribute->attributeValueLength ) )
         {
-            if( attributeValueLength == STUN_ATTRIBUTE_USE_CANDIDATE_VALUE_LENGTH )
-            {
-                isValid = 1;
-            }
+            result = STUN_RESULT_OUT_OF_MEMORY;
         }
-        break;
-
-        case STUN_ATTRIBUTE_TYPE_ICE_CONTROLLED:
+        else if( IsAttributeLengthValid( pAttribute->attributeType,
+                                         pAttribute->attributeValueLength ) == 0 )
         {
-            if( attributeValueLength == STUN_ATTRIBUTE_ICE_CONTROLLED_VALUE_LENGTH )
-            {
-                isValid = 1;
-            }
+            /* Malformed packet with wrong attribute length. */
+            result = STUN_RESULT_INVALID_ATTRIBUTE;
         }
-        break;
+    }
 
-        case STUN_ATTRIBUTE_TYPE_ICE_CONTROLLING:
+    if( result == STUN_RESULT_OK )
+    {
+        if( pAttribute->attributeValueLength > 0 )
         {
-            if( attributeValueLength == STUN_ATTRIBUTE_ICE_CONTROLLING_VALUE_LENGTH )
-            {
-                isValid = 1;
-            }
+            pAttribute->pAttributeValue = &( pCtx->pStart[ pCtx->currentIndex +
+                                                           STUN_ATTRIBUTE_HEADER_VALUE_OFFSET ] );
         }
-        break;
-
-        default:
+        else
         {
-            /* For any other attribute type, the maximum length is 512 bytes. */
-            if( attributeValueLength <= STUN_ATTRIBUTE_VALUE_MAX_LENGTH )
-            {
-                isValid = 1;
-            }
+            pAttribute->pAttributeValue = NULL;
         }
-        break;
+
+        pCtx->currentIndex += STUN_ATTRIBUTE_TOTAL_LENGTH( STUN_ALIGN_SIZE_TO_WORD( pAttribute->attributeValueLength ) );
     }
 
-    return isValid;
+    return result;
 }
 
 /*-----------------------------------------------------------*/
@@ -285,87 +575,163 @@ StunResult_t StunDeserializer_Init( StunContext_t * pCtx,
 
 /*-----------------------------------------------------------*/
 
-StunResult_t StunDeserializer_GetNextAttribute( StunContext_t * pCtx,
-                                                StunAttribute_t * pAttribute )
+StunResult_t StunDeserializer_InitBatch( const StunMessageBuffer_t * pStunMessages,
+                                         size_t messageCount,
+                                         StunMessageBatch_t * pBatch,
+                                         size_t * pValidMessageCount )
 {
     StunResult_t result = STUN_RESULT_OK;
-
-    if( ( pCtx == NULL ) ||
-        ( pAttribute == NULL ) )
+    static const uint8_t magicCookieBytes[ sizeof( uint32_t ) ] = { 0x21, 0x12, 0xA4, 0x42 };
+    uint8_t headers[ STUN_BATCH_BLOCK_LENGTH ][ STUN_HEADER_TRANSACTION_ID_OFFSET ];
+    uint8_t hasHeader[ STUN_BATCH_BLOCK_LENGTH ];
+    uint32_t magicCookie, expectedMagicCookie;
+    uint16_t messageLengthInHeader;
+    size_t blockStart, blockLength, i, validCount = 0;
+    uint8_t * pStunMessage;
+    StunResult_t messageResult;
+
+    if( ( ( pStunMessages == NULL ) && ( messageCount > 0 ) ) ||
+        ( pBatch == NULL ) ||
+        ( pBatch->pResults == NULL ) ||
+        ( pBatch->pMessageTypes == NULL ) ||
+        ( pBatch->ppTransactionIds == NULL ) ||
+        ( pBatch->ppAttributes == NULL ) ||
+        ( pBatch->pAttributesLengths == NULL ) ||
+        ( pValidMessageCount == NULL ) )
     {
         result = STUN_RESULT_BAD_PARAM;
     }
 
     if( result == STUN_RESULT_OK )
     {
-        if( STUN_REMAINING_LENGTH( pCtx ) < STUN_ATTRIBUTE_HEADER_LENGTH )
+        /* The magic cookie is compared in network byte order. */
+        memcpy( ( void * ) &( expectedMagicCookie ),
+                ( const void * ) &( magicCookieBytes[ 0 ] ),
+                sizeof( expectedMagicCookie ) );
+
+        for( blockStart = 0; blockStart < messageCount; blockStart += blockLength )
         {
-            result = STUN_RESULT_NO_MORE_ATTRIBUTE_FOUND;
+            blockLength = messageCount - blockStart;
+
+            if( blockLength > STUN_BATCH_BLOCK_LENGTH )
+            {
+                blockLength = STUN_BATCH_BLOCK_LENGTH;
+            }
+
+            /* Gather the first 8 bytes of each header, so that the validation
+             * below runs on contiguous memory. */
+            for( i = 0; i < blockLength; i++ )
+            {
+                pStunMessage = pStunMessages[ blockStart + i ].pStunMessage;
+
+                if( ( pStunMessage != NULL ) &&
+                    ( pStunMessages[ blockStart + i ].stunMessageLength >= STUN_HEADER_LENGTH ) )
+                {
+                    memcpy( ( void * ) &( headers[ i ][ 0 ] ),
+                            ( const void * ) pStunMessage,
+                            STUN_HEADER_TRANSACTION_ID_OFFSET );
+                    hasHeader[ i ] = 1;
+                }
+                else
+                {
+                    memset( ( void * ) &( headers[ i ][ 0 ] ),
+                            0,
+                            STUN_HEADER_TRANSACTION_ID_OFFSET );
+                    hasHeader[ i ] = 0;
+                }
+            }
+
+            /* Validate the gathered headers. */
+            for( i = 0; i < blockLength; i++ )
+            {
+                pStunMessage = pStunMessages[ blockStart + i ].pStunMessage;
+
+                memcpy( ( void * ) &( magicCookie ),
+                        ( const void * ) &( headers[ i ][ STUN_HEADER_MAGIC_COOKIE_OFFSET ] ),
+                        sizeof( magicCookie ) );
+                messageLengthInHeader = Stun_ReadUint16( &( headers[ i ][ STUN_HEADER_MESSAGE_LENGTH_OFFSET ] ) );
+
+                messageResult = ( hasHeader[ i ] == 0 ) ? STUN_RESULT_BAD_PARAM :
+                                ( magicCookie != expectedMagicCookie ) ? STUN_RESULT_MAGIC_COOKIE_MISMATCH :
+                                ( ( ( size_t ) messageLengthInHeader + STUN_HEADER_LENGTH ) !=
+                                  pStunMessages[ blockStart + i ].stunMessageLength ) ? STUN_RESULT_INVALID_MESSAGE_LENGTH :
+                                STUN_RESULT_OK;
+
+                validCount += ( messageResult == STUN_RESULT_OK ) ? 1U : 0U;
+
+                pBatch->pResults[ blockStart + i ] = messageResult;
+                pBatch->pMessageTypes[ blockStart + i ] = ( StunMessageType_t ) Stun_ReadUint16( &( headers[ i ][ 0 ] ) );
+                pBatch->pAttributesLengths[ blockStart + i ] = messageLengthInHeader;
+                pBatch->ppTransactionIds[ blockStart + i ] = ( hasHeader[ i ] != 0 ) ?
+                                                             &( pStunMessage[ STUN_HEADER_TRANSACTION_ID_OFFSET ] ) : NULL;
+                pBatch->ppAttributes[ blockStart + i ] = ( hasHeader[ i ] != 0 ) ?
+                                                         &( pStunMessage[ STUN_HEADER_LENGTH ] ) : NULL;
+            }
         }
+
+        pBatch->messageCount = messageCount;
+        *pValidMessageCount = validCount;
     }
 
-    if( result == STUN_RESULT_OK )
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunDeserializer_InitFromBatch( StunContext_t * pCtx,
+                                             const StunMessageBatch_t * pBatch,
+                                             size_t messageIndex,
+                                             StunHeader_t * pStunHeader )
+{
+    StunResult_t result = STUN_RESULT_OK;
+
+    if( ( pCtx == NULL ) ||
+        ( pBatch == NULL ) ||
+        ( messageIndex >= pBatch->messageCount ) ||
+        ( pStunHeader == NULL ) )
     {
-        /* Read attribute type. */
-        pAttribute->attributeType = ( StunAttributeType_t ) STUN_READ_UINT16( &( pCtx->pStart[ pCtx->currentIndex ] ) );
+        result = STUN_RESULT_BAD_PARAM;
+    }
 
-        /* Check that it is correct attribute at this position. */
-        if( ( pCtx->attributeFlag & STUN_FLAG_FINGERPRINT_ATTRIBUTE ) != 0 )
-        {
-            /* No more attributes can be present after Fingerprint - it must  be
-             * the last attribute. */
-            result = STUN_RESULT_INVALID_ATTRIBUTE_ORDER;
-        }
-        else if( ( ( pCtx->attributeFlag & STUN_FLAG_INTEGRITY_ATTRIBUTE ) != 0 ) &&
-                 ( pAttribute->attributeType != STUN_ATTRIBUTE_TYPE_FINGERPRINT ) )
-        {
-            /* No attribute other than Fingerprint can be present after
-             * Integrity attribute. */
-            result = STUN_RESULT_INVALID_ATTRIBUTE_ORDER;
-        }
+    if( result == STUN_RESULT_OK )
+    {
+        /* The header was already validated by StunDeserializer_InitBatch. */
+        result = pBatch->pResults[ messageIndex ];
     }
 
     if( result == STUN_RESULT_OK )
     {
-        if( pAttribute->attributeType == STUN_ATTRIBUTE_TYPE_FINGERPRINT )
-        {
-            pCtx->attributeFlag |= STUN_FLAG_FINGERPRINT_ATTRIBUTE;
-        }
-        if( pAttribute->attributeType == STUN_ATTRIBUTE_TYPE_MESSAGE_INTEGRITY )
-        {
-            pCtx->attributeFlag |= STUN_FLAG_INTEGRITY_ATTRIBUTE;
-        }
+        Stun_InitReadWriteFunctions( &( pCtx->readWriteFunctions ) );
 
-        /* Read attribute length. */
-        pAttribute->attributeValueLength = STUN_READ_UINT16( &( pCtx->pStart[ pCtx->currentIndex +
-                                                                              STUN_ATTRIBUTE_HEADER_LENGTH_OFFSET ] ) );
+        pCtx->pStart = pBatch->ppAttributes[ messageIndex ] - STUN_HEADER_LENGTH;
+        pCtx->totalLength = ( size_t ) pBatch->pAttributesLengths[ messageIndex ] + STUN_HEADER_LENGTH;
+        pCtx->currentIndex = STUN_HEADER_LENGTH;
+        pCtx->attributeFlag = 0;
 
-        /* Check that we have enough data to read attribute value. */
-        if( STUN_REMAINING_LENGTH( pCtx ) < ( size_t ) STUN_ATTRIBUTE_TOTAL_LENGTH( pAttribute->attributeValueLength ) )
-        {
-            result = STUN_RESULT_OUT_OF_MEMORY;
-        }
-        else if( IsAttributeLengthValid( pAttribute->attributeType,
-                                         pAttribute->attributeValueLength ) == 0 )
-        {
-            /* Malformed packet with wrong attribute length. */
-            result = STUN_RESULT_INVALID_ATTRIBUTE;
-        }
+        pStunHeader->messageType = pBatch->pMessageTypes[ messageIndex ];
+        pStunHeader->pTransactionId = pBatch->ppTransactionIds[ messageIndex ];
     }
 
-    if( result == STUN_RESULT_OK )
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunDeserializer_GetNextAttribute( StunContext_t * pCtx,
+                                                StunAttribute_t * pAttribute )
+{
+    StunResult_t result = STUN_RESULT_OK;
+
+    if( ( pCtx == NULL ) ||
+        ( pAttribute == NULL ) )
     {
-        if( pAttribute->attributeValueLength > 0 )
-        {
-            pAttribute->pAttributeValue = &( pCtx->pStart[ pCtx->currentIndex +
-                                                           STUN_ATTRIBUTE_HEADER_VALUE_OFFSET ] );
-        }
-        else
-        {
-            pAttribute->pAttributeValue = NULL;
-        }
+        result = STUN_RESULT_BAD_PARAM;
+    }
 
-        pCtx->currentIndex += STUN_ATTRIBUTE_TOTAL_LENGTH( STUN_ALIGN_SIZE_TO_WORD( pAttribute->attributeValueLength ) );
+    if( result == STUN_RESULT_OK )
+    {
+        result = ReadNextAttribute( pCtx,
+                                    pAttribute );
     }
 
     return result;
@@ -414,6 +780,11 @@ StunResult_t StunDeserializer_ParseAttributeChannelNumber( const StunContext_t *
 {
     StunResult_t result = STUN_RESULT_OK;
 
+    #if defined( STUN_USE_COMPILE_TIME_ENDIANNESS )
+        /* The context is only needed for the read/write function table. */
+        ( void ) pCtx;
+    #endif
+
     if( ( pAttribute == NULL ) ||
         ( pChannelNumber == NULL ) ||
         ( pAttribute->attributeType != STUN_ATTRIBUTE_TYPE_CHANNEL_NUMBER ) ||
@@ -581,6 +952,7 @@ StunResult_t StunDeserializer_GetIntegrityBuffer( StunContext_t * pCtx,
                                                   uint16_t * pStunMessageLength )
 {
     StunResult_t result = STUN_RESULT_OK;
+    StunHashRange_t range;
 
     if( ( pCtx == NULL ) ||
         ( ppStunMessage == NULL ) ||
@@ -589,14 +961,28 @@ StunResult_t StunDeserializer_GetIntegrityBuffer( StunContext_t * pCtx,
         result = STUN_RESULT_BAD_PARAM;
     }
 
+    if( result == STUN_RESULT_OK )
+    {
+        result = GetHashRange( pCtx,
+                               STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH,
+                               &( range ) );
+    }
+
+    /* The covered length does not fit in pStunMessageLength when the
+     * attribute starts past 64 KiB. */
+    if( ( result == STUN_RESULT_OK ) &&
+        ( range.stunMessageLength > UINT16_MAX ) )
+    {
+        result = STUN_RESULT_INVALID_MESSAGE_LENGTH;
+    }
+
     if( result == STUN_RESULT_OK )
     {
         STUN_WRITE_UINT16( &( pCtx->pStart[ STUN_HEADER_MESSAGE_LENGTH_OFFSET ] ),
-                           ( uint16_t )( pCtx->currentIndex - STUN_HEADER_LENGTH ) );
+                           ( uint16_t ) range.patchedMessageLength );
 
         *ppStunMessage = pCtx->pStart;
-        *pStunMessageLength = ( uint16_t )( pCtx->currentIndex -
-                                            STUN_ATTRIBUTE_TOTAL_LENGTH( STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH ) );
+        *pStunMessageLength = ( uint16_t ) range.stunMessageLength;
     }
 
     return result;
@@ -609,6 +995,7 @@ StunResult_t StunDeserializer_GetFingerprintBuffer( StunContext_t * pCtx,
                                                     uint16_t * pStunMessageLength )
 {
     StunResult_t result = STUN_RESULT_OK;
+    StunHashRange_t range;
 
     if( ( pCtx == NULL ) ||
         ( ppStunMessage == NULL ) ||
@@ -617,14 +1004,196 @@ StunResult_t StunDeserializer_GetFingerprintBuffer( StunContext_t * pCtx,
         result = STUN_RESULT_BAD_PARAM;
     }
 
+    if( result == STUN_RESULT_OK )
+    {
+        result = GetHashRange( pCtx,
+                               STUN_ATTRIBUTE_FINGERPRINT_VALUE_LENGTH,
+                               &( range ) );
+    }
+
+    /* The covered length does not fit in pStunMessageLength when the
+     * attribute starts past 64 KiB. */
+    if( ( result == STUN_RESULT_OK ) &&
+        ( range.stunMessageLength > UINT16_MAX ) )
+    {
+        result = STUN_RESULT_INVALID_MESSAGE_LENGTH;
+    }
+
     if( result == STUN_RESULT_OK )
     {
         STUN_WRITE_UINT16( &( pCtx->pStart[ STUN_HEADER_MESSAGE_LENGTH_OFFSET ] ),
-                           ( uint16_t )( pCtx->currentIndex - STUN_HEADER_LENGTH ) );
+                           ( uint16_t ) range.patchedMessageLength );
 
         *ppStunMessage = pCtx->pStart;
-        *pStunMessageLength = ( uint16_t )( pCtx->currentIndex -
-                                            STUN_ATTRIBUTE_TOTAL_LENGTH( STUN_ATTRIBUTE_FINGERPRINT_VALUE_LENGTH ) );
+        *pStunMessageLength = ( uint16_t ) range.stunMessageLength;
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunDeserializer_GetIntegrityRange( const StunContext_t * pCtx,
+                                                 StunHashRange_t * pRange )
+{
+    StunResult_t result = STUN_RESULT_OK;
+
+    if( ( pCtx == NULL ) ||
+        ( pRange == NULL ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        result = GetHashRange( pCtx,
+                               STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH,
+                               pRange );
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunDeserializer_GetFingerprintRange( const StunContext_t * pCtx,
+                                                   StunHashRange_t * pRange )
+{
+    StunResult_t result = STUN_RESULT_OK;
+
+    if( ( pCtx == NULL ) ||
+        ( pRange == NULL ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        result = GetHashRange( pCtx,
+                               STUN_ATTRIBUTE_FINGERPRINT_VALUE_LENGTH,
+                               pRange );
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunDeserializer_VerifyFingerprint( const StunContext_t * pCtx,
+                                                 const StunAttribute_t * pAttribute )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    StunHashRange_t range;
+    uint32_t receivedCrc32Fingerprint = 0, crc32Fingerprint;
+    uint8_t patchedLength[ 2 ];
+
+    if( pCtx == NULL )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        result = StunDeserializer_ParseAttributeFingerprint( pCtx,
+                                                             pAttribute,
+                                                             &( receivedCrc32Fingerprint ) );
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        result = StunDeserializer_GetFingerprintRange( pCtx,
+                                                       &( range ) );
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        Stun_WriteUint16( &( patchedLength[ 0 ] ), ( uint16_t ) range.patchedMessageLength );
+
+        crc32Fingerprint = Stun_Crc32( 0,
+                                       range.pStunMessage,
+                                       STUN_HEADER_MESSAGE_LENGTH_OFFSET );
+        crc32Fingerprint = Stun_Crc32( crc32Fingerprint,
+                                       &( patchedLength[ 0 ] ),
+                                       sizeof( patchedLength ) );
+        crc32Fingerprint = Stun_Crc32( crc32Fingerprint,
+                                       &( range.pStunMessage[ STUN_HEADER_MAGIC_COOKIE_OFFSET ] ),
+                                       range.stunMessageLength - STUN_HEADER_MAGIC_COOKIE_OFFSET );
+
+        if( crc32Fingerprint != receivedCrc32Fingerprint )
+        {
+            result = STUN_RESULT_FINGERPRINT_MISMATCH;
+        }
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunDeserializer_VerifyIntegrity( const StunContext_t * pCtx,
+                                               const StunAttribute_t * pAttribute,
+                                               const StunIntegrityKey_t * pIntegrityKey )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    StunHashRange_t range;
+    StunHmacContext_t hmacCtx;
+    uint8_t hmac[ STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH ];
+    uint8_t patchedLength[ 2 ];
+    uint8_t difference = 0;
+    size_t i;
+
+    if( ( pCtx == NULL ) ||
+        ( pAttribute == NULL ) ||
+        ( pIntegrityKey == NULL ) ||
+        ( pAttribute->attributeType != STUN_ATTRIBUTE_TYPE_MESSAGE_INTEGRITY ) ||
+        ( pAttribute->pAttributeValue == NULL ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        if( pAttribute->attributeValueLength != STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH )
+        {
+            result = STUN_RESULT_INVALID_ATTRIBUTE_LENGTH;
+        }
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        result = StunDeserializer_GetIntegrityRange( pCtx,
+                                                     &( range ) );
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        Stun_WriteUint16( &( patchedLength[ 0 ] ), ( uint16_t ) range.patchedMessageLength );
+
+        ( void ) StunIntegrity_HmacInit( &( hmacCtx ),
+                                         pIntegrityKey );
+        ( void ) StunIntegrity_HmacUpdate( &( hmacCtx ),
+                                           range.pStunMessage,
+                                           STUN_HEADER_MESSAGE_LENGTH_OFFSET );
+        ( void ) StunIntegrity_HmacUpdate( &( hmacCtx ),
+                                           &( patchedLength[ 0 ] ),
+                                           sizeof( patchedLength ) );
+        ( void ) StunIntegrity_HmacUpdate( &( hmacCtx ),
+                                           &( range.pStunMessage[ STUN_HEADER_MAGIC_COOKIE_OFFSET ] ),
+                                           range.stunMessageLength - STUN_HEADER_MAGIC_COOKIE_OFFSET );
+        ( void ) StunIntegrity_HmacFinal( &( hmacCtx ),
+                                          &( hmac[ 0 ] ) );
+
+        /* Compare all the bytes so that the time taken does not depend on
+         * where the first difference is. */
+        for( i = 0; i < STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH; i++ )
+        {
+            difference |= ( uint8_t )( hmac[ i ] ^ pAttribute->pAttributeValue[ i ] );
+        }
+
+        if( difference != 0 )
+        {
+            result = STUN_RESULT_INTEGRITY_MISMATCH;
+        }
     }
 
     return result;
@@ -681,6 +1250,211 @@ StunResult_t StunDeserializer_FindAttribute( StunContext_t * pCtx,
 
 /*-----------------------------------------------------------*/
 
+StunResult_t StunDeserializer_BuildIndex( const StunContext_t * pCtx,
+                                          StunAttributeIndex_t * pIndex )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    StunContext_t localCtx;
+    StunHeader_t localHeader;
+    StunAttribute_t attribute;
+    size_t attributeOffset, slot;
+
+    if( ( pCtx == NULL ) ||
+        ( pCtx->pStart == NULL ) ||
+        ( pIndex == NULL ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        memset( ( void * ) &( pIndex->attributeOffsets[ 0 ] ),
+                0xFF,
+                sizeof( pIndex->attributeOffsets ) );
+
+        result = StunDeserializer_Init( &( localCtx ),
+                                        pCtx->pStart,
+                                        pCtx->totalLength,
+                                        &( localHeader ) );
+    }
+
+    /* Walk the message once and record the first occurrence of each indexed
+     * attribute type. */
+    while( result == STUN_RESULT_OK )
+    {
+        attributeOffset = localCtx.currentIndex - STUN_HEADER_LENGTH;
+
+        result = StunDeserializer_GetNextAttribute( &( localCtx ),
+                                                    &( attribute ) );
+
+        if( ( result == STUN_RESULT_OK ) &&
+            ( GetAttributeIndexSlot( attribute.attributeType, &( slot ) ) != 0 ) &&
+            ( pIndex->attributeOffsets[ slot ] == STUN_ATTRIBUTE_INDEX_NOT_PRESENT ) )
+        {
+            pIndex->attributeOffsets[ slot ] = ( uint16_t ) attributeOffset;
+        }
+    }
+
+    if( result == STUN_RESULT_NO_MORE_ATTRIBUTE_FOUND )
+    {
+        result = STUN_RESULT_OK;
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunDeserializer_FindAttributeInIndex( const StunContext_t * pCtx,
+                                                    const StunAttributeIndex_t * pIndex,
+                                                    StunAttributeType_t attributeType,
+                                                    StunAttribute_t * pAttribute )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    StunContext_t localCtx;
+    size_t attributeIndex, slot;
+
+    if( ( pCtx == NULL ) ||
+        ( pCtx->pStart == NULL ) ||
+        ( pIndex == NULL ) ||
+        ( pAttribute == NULL ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        if( GetAttributeIndexSlot( attributeType, &( slot ) ) == 0 )
+        {
+            /* Types outside the indexed ranges need a linear search. */
+            localCtx = *pCtx;
+            result = StunDeserializer_FindAttribute( &( localCtx ),
+                                                     attributeType,
+                                                     pAttribute );
+        }
+        else if( pIndex->attributeOffsets[ slot ] == STUN_ATTRIBUTE_INDEX_NOT_PRESENT )
+        {
+            result = STUN_RESULT_NO_ATTRIBUTE_FOUND;
+        }
+        else
+        {
+            /* The attribute was validated while building the index. */
+            attributeIndex = STUN_HEADER_LENGTH + ( size_t ) pIndex->attributeOffsets[ slot ];
+
+            pAttribute->attributeType = attributeType;
+            pAttribute->attributeValueLength = STUN_READ_UINT16( &( pCtx->pStart[ attributeIndex +
+                                                                                  STUN_ATTRIBUTE_HEADER_LENGTH_OFFSET ] ) );
+
+            if( pAttribute->attributeValueLength > 0 )
+            {
+                pAttribute->pAttributeValue = &( pCtx->pStart[ attributeIndex +
+                                                               STUN_ATTRIBUTE_HEADER_VALUE_OFFSET ] );
+            }
+            else
+            {
+                pAttribute->pAttributeValue = NULL;
+            }
+        }
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunDeserializer_DecodeMessageView( const StunContext_t * pCtx,
+                                                 StunMessageView_t * pView )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    StunContext_t localCtx;
+    StunAttribute_t attribute;
+    uint16_t attributeOffsets[ STUN_ATTRIBUTE_INDEX_SLOT_COUNT ];
+    size_t attributeOffset, slot;
+    uint64_t attributesPresent = 0;
+
+    if( ( pCtx == NULL ) ||
+        ( pCtx->pStart == NULL ) ||
+        ( pCtx->totalLength < STUN_HEADER_LENGTH ) ||
+        ( pView == NULL ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        /* The header was validated by StunDeserializer_Init, so the walk only
+         * needs to restart after it. */
+        localCtx = *pCtx;
+        localCtx.currentIndex = STUN_HEADER_LENGTH;
+        localCtx.attributeFlag = 0;
+    }
+
+    /* Walk the message once and record the offset of the first occurrence of
+     * each indexed attribute type from the end of the header. attributeOffsets
+     * is only read for the slots set in attributesPresent. */
+    while( result == STUN_RESULT_OK )
+    {
+        attributeOffset = localCtx.currentIndex;
+
+        result = ReadNextAttribute( &( localCtx ),
+                                    &( attribute ) );
+
+        if( ( result == STUN_RESULT_OK ) &&
+            ( GetAttributeIndexSlot( attribute.attributeType, &( slot ) ) != 0 ) &&
+            ( ( attributesPresent & STUN_VIEW_SLOT_BIT( slot ) ) == 0U ) )
+        {
+            attributesPresent |= STUN_VIEW_SLOT_BIT( slot );
+            attributeOffsets[ slot ] = ( uint16_t ) ( attributeOffset - STUN_HEADER_LENGTH );
+        }
+    }
+
+    if( result == STUN_RESULT_NO_MORE_ATTRIBUTE_FOUND )
+    {
+        /* Cleared field by field, as a 128 byte memset is compiled to a
+         * rep stos that costs more than the walk of a small message. */
+        pView->attributesPresent = attributesPresent;
+        pView->iceTieBreaker = 0;
+        pView->priority = 0;
+        pView->lifetime = 0;
+        pView->errorCode = 0;
+        pView->channelNumber = 0;
+        pView->integrityOffset = 0;
+        pView->fingerprintOffset = 0;
+        memset( ( void * ) &( pView->xorMappedAddress ),
+                0,
+                sizeof( StunAttributeAddress_t ) );
+        pView->username = emptyAttributeValue;
+        pView->realm = emptyAttributeValue;
+        pView->nonce = emptyAttributeValue;
+        pView->data = emptyAttributeValue;
+
+        result = DecodeViewAttributes( pCtx,
+                                       &( attributeOffsets[ 0 ] ),
+                                       pView );
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+uint8_t StunDeserializer_IsAttributeInView( const StunMessageView_t * pView,
+                                            StunAttributeType_t attributeType )
+{
+    uint8_t isPresent = 0;
+    size_t slot;
+
+    if( ( pView != NULL ) &&
+        ( GetAttributeIndexSlot( attributeType, &( slot ) ) != 0 ) )
+    {
+        isPresent = ( uint8_t ) ( ( pView->attributesPresent >> slot ) & 1U );
+    }
+
+    return isPresent;
+}
+
+/*-----------------------------------------------------------*/
+
 StunResult_t StunDeserializer_UpdateAttributeNonce( const uint8_t * pNonce,
                                                     uint16_t nonceLength,
                                                     StunAttribute_t * pAttribute )
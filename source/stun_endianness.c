@@ -1,32 +1,24 @@
+/* Standard includes. */
+#include <string.h>
+
 /* API includes. */
 #include "stun_endianness.h"
 
-#define SWAP_BYTES_16( value )          \
-    ( ( ( ( value ) >> 8 ) & 0xFF ) |   \
-      ( ( ( value ) & 0xFF ) << 8 ) )
-
-#define SWAP_BYTES_32( value )           \
-    ( ( ( ( value ) >> 24 ) & 0xFF )  |  \
-      ( ( ( value ) >> 8 ) & 0xFF00 ) |  \
-      ( ( ( value ) & 0xFF00 ) << 8 ) |  \
-      ( ( ( value ) & 0xFF ) << 24 ) )
-
-#define SWAP_BYTES_64( value )                              \
-    ( ( ( ( uint64_t )( value ) >> 56 ) & 0xFF )        |   \
-      ( ( ( uint64_t )( value ) >> 40 ) & 0xFF00 )      |   \
-      ( ( ( uint64_t )( value ) >> 24 ) & 0xFF0000 )    |   \
-      ( ( ( uint64_t )( value ) >> 8 ) & 0xFF000000 )   |   \
-      ( ( ( uint64_t )( value ) & 0xFF000000 ) << 8 )   |   \
-      ( ( ( uint64_t )( value ) & 0xFF0000 ) << 24 )    |   \
-      ( ( ( uint64_t )( value ) & 0xFF00 ) << 40 )      |   \
-      ( ( ( uint64_t )( value ) & 0xFF ) << 56 ) )
+/*
+ * The helpers below access the buffer through memcpy so that they are safe for
+ * any alignment of pSrc/pDst and do not violate strict aliasing rules. The
+ * compilers lower the fixed size memcpy to a single unaligned load/store and
+ * the byte swap builtin to bswap/rev (or movbe when available).
+ */
 
 /*-----------------------------------------------------------*/
 
 static void WriteUint16Swap( uint8_t * pDst,
                              uint16_t val )
 {
-    *( ( uint16_t * )( pDst ) ) = SWAP_BYTES_16( val );
+    uint16_t swapped = STUN_BSWAP_16( val );
+
+    memcpy( ( void * ) pDst, ( const void * ) &( swapped ), sizeof( swapped ) );
 }
 
 /*-----------------------------------------------------------*/
@@ -34,7 +26,9 @@ static void WriteUint16Swap( uint8_t * pDst,
 static void WriteUint32Swap( uint8_t * pDst,
                              uint32_t val )
 {
-    *( ( uint32_t * )( pDst ) ) = SWAP_BYTES_32( val );
+    uint32_t swapped = STUN_BSWAP_32( val );
+
+    memcpy( ( void * ) pDst, ( const void * ) &( swapped ), sizeof( swapped ) );
 }
 
 /*-----------------------------------------------------------*/
@@ -42,28 +36,42 @@ static void WriteUint32Swap( uint8_t * pDst,
 static void WriteUint64Swap( uint8_t * pDst,
                              uint64_t val )
 {
-    *( ( uint64_t * )( pDst ) ) = SWAP_BYTES_64( val );
+    uint64_t swapped = STUN_BSWAP_64( val );
+
+    memcpy( ( void * ) pDst, ( const void * ) &( swapped ), sizeof( swapped ) );
 }
 
 /*-----------------------------------------------------------*/
 
 static uint16_t ReadUint16Swap( const uint8_t * pSrc )
 {
-    return SWAP_BYTES_16( *( ( uint16_t * )( pSrc ) ) );
+    uint16_t val;
+
+    memcpy( ( void * ) &( val ), ( const void * ) pSrc, sizeof( val ) );
+
+    return STUN_BSWAP_16( val );
 }
 
 /*-----------------------------------------------------------*/
 
 static uint32_t ReadUint32Swap( const uint8_t * pSrc )
 {
-    return SWAP_BYTES_32( *( ( uint32_t * )( pSrc ) ) );
+    uint32_t val;
+
+    memcpy( ( void * ) &( val ), ( const void * ) pSrc, sizeof( val ) );
+
+    return STUN_BSWAP_32( val );
 }
 
 /*-----------------------------------------------------------*/
 
 static uint64_t ReadUint64Swap( const uint8_t * pSrc )
 {
-    return SWAP_BYTES_64( *( ( uint64_t * )( pSrc ) ) );
+    uint64_t val;
+
+    memcpy( ( void * ) &( val ), ( const void * ) pSrc, sizeof( val ) );
+
+    return STUN_BSWAP_64( val );
 }
 
 /*-----------------------------------------------------------*/
@@ -71,7 +79,7 @@ static uint64_t ReadUint64Swap( const uint8_t * pSrc )
 static void WriteUint16NoSwap( uint8_t * pDst,
                                uint16_t val )
 {
-    *( ( uint16_t * )( pDst ) ) = ( val );
+    memcpy( ( void * ) pDst, ( const void * ) &( val ), sizeof( val ) );
 }
 
 /*-----------------------------------------------------------*/
@@ -79,7 +87,7 @@ static void WriteUint16NoSwap( uint8_t * pDst,
 static void WriteUint32NoSwap( uint8_t * pDst,
                                uint32_t val )
 {
-    *( ( uint32_t * )( pDst ) ) = ( val );
+    memcpy( ( void * ) pDst, ( const void * ) &( val ), sizeof( val ) );
 }
 
 /*-----------------------------------------------------------*/
@@ -87,28 +95,40 @@ static void WriteUint32NoSwap( uint8_t * pDst,
 static void WriteUint64NoSwap( uint8_t * pDst,
                                uint64_t val )
 {
-    *( ( uint64_t * )( pDst ) ) = ( val );
+    memcpy( ( void * ) pDst, ( const void * ) &( val ), sizeof( val ) );
 }
 
 /*-----------------------------------------------------------*/
 
 static uint16_t ReadUint16NoSwap( const uint8_t * pSrc )
 {
-    return *( ( uint16_t * )( pSrc ) );
+    uint16_t val;
+
+    memcpy( ( void * ) &( val ), ( const void * ) pSrc, sizeof( val ) );
+
+    return val;
 }
 
 /*-----------------------------------------------------------*/
 
 static uint32_t ReadUint32NoSwap( const uint8_t * pSrc )
 {
-    return *( ( uint32_t * )( pSrc ) );
+    uint32_t val;
+
+    memcpy( ( void * ) &( val ), ( const void * ) pSrc, sizeof( val ) );
+
+    return val;
 }
 
 /*-----------------------------------------------------------*/
 
 static uint64_t ReadUint64NoSwap( const uint8_t * pSrc )
 {
-    return *( ( uint64_t * )( pSrc ) );
+    uint64_t val;
+
+    memcpy( ( void * ) &( val ), ( const void * ) pSrc, sizeof( val ) );
+
+    return val;
 }
 
 /*-----------------------------------------------------------*/
@@ -117,7 +137,13 @@ void Stun_InitReadWriteFunctions( StunReadWriteFunctions_t * pReadWriteFunctions
 {
     uint8_t isLittleEndian;
 
-    isLittleEndian = ( *( uint8_t * )( &( uint16_t ) { 1 } ) == 1 );
+    #if defined( STUN_LITTLE_ENDIAN )
+        isLittleEndian = 1;
+    #elif defined( STUN_BIG_ENDIAN )
+        isLittleEndian = 0;
+    #else
+        isLittleEndian = ( *( uint8_t * )( &( uint16_t ) { 1 } ) == 1 );
+    #endif
 
     if( isLittleEndian != 0 )
     {
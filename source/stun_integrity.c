@@ -0,0 +1,245 @@
+/* Standard includes. */
+#include <string.h>
+
+/* API includes. */
+#include "stun_integrity.h"
+
+#define STUN_INTEGRITY_IPAD     0x36
+#define STUN_INTEGRITY_OPAD     0x5C
+
+/*-----------------------------------------------------------*/
+
+/* Static Functions. */
+static void HashPaddedKey( const StunSha1Context_t * pInitialCtx,
+                           const uint8_t * pKeyBlock,
+                           uint8_t pad,
+                           uint32_t * pState );
+
+/*-----------------------------------------------------------*/
+
+static void HashPaddedKey( const StunSha1Context_t * pInitialCtx,
+                           const uint8_t * pKeyBlock,
+                           uint8_t pad,
+                           uint32_t * pState )
+{
+    uint8_t paddedKey[ STUN_SHA1_BLOCK_LENGTH ];
+    size_t i;
+
+    for( i = 0; i < STUN_SHA1_BLOCK_LENGTH; i++ )
+    {
+        paddedKey[ i ] = pKeyBlock[ i ] ^ pad;
+    }
+
+    memcpy( ( void * ) pState,
+            ( const void * ) &( pInitialCtx->state[ 0 ] ),
+            sizeof( pInitialCtx->state ) );
+
+    pInitialCtx->compressFn( pState, &( paddedKey[ 0 ] ), 1 );
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunIntegrity_InitKey( StunIntegrityKey_t * pIntegrityKey,
+                                    const uint8_t * pKey,
+                                    size_t keyLength,
+                                    StunSha1CompressFunction_t compressFn )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    StunSha1Context_t sha1Ctx;
+    uint8_t keyBlock[ STUN_SHA1_BLOCK_LENGTH ] = { 0 };
+
+    if( ( pIntegrityKey == NULL ) ||
+        ( ( pKey == NULL ) && ( keyLength != 0 ) ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        Stun_Sha1Init( &( sha1Ctx ) );
+
+        if( compressFn != NULL )
+        {
+            sha1Ctx.compressFn = compressFn;
+        }
+
+        /* Keys longer than a block are replaced by their hash (RFC 2104). */
+        if( keyLength > STUN_SHA1_BLOCK_LENGTH )
+        {
+            Stun_Sha1Update( &( sha1Ctx ), pKey, keyLength );
+            Stun_Sha1Final( &( sha1Ctx ), &( keyBlock[ 0 ] ) );
+            Stun_Sha1Init( &( sha1Ctx ) );
+
+            if( compressFn != NULL )
+            {
+                sha1Ctx.compressFn = compressFn;
+            }
+        }
+        else if( keyLength > 0 )
+        {
+            memcpy( ( void * ) &( keyBlock[ 0 ] ),
+                    ( const void * ) pKey,
+                    keyLength );
+        }
+
+        HashPaddedKey( &( sha1Ctx ),
+                       &( keyBlock[ 0 ] ),
+                       STUN_INTEGRITY_IPAD,
+                       &( pIntegrityKey->innerState[ 0 ] ) );
+        HashPaddedKey( &( sha1Ctx ),
+                       &( keyBlock[ 0 ] ),
+                       STUN_INTEGRITY_OPAD,
+                       &( pIntegrityKey->outerState[ 0 ] ) );
+
+        pIntegrityKey->compressFn = sha1Ctx.compressFn;
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunIntegrity_ComputeHmac( const StunIntegrityKey_t * pIntegrityKey,
+                                        const uint8_t * pData,
+                                        size_t dataLength,
+                                        uint8_t * pHmac )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    StunHmacContext_t hmacCtx;
+
+    result = StunIntegrity_HmacInit( &( hmacCtx ),
+                                     pIntegrityKey );
+
+    if( result == STUN_RESULT_OK )
+    {
+        result = StunIntegrity_HmacUpdate( &( hmacCtx ),
+                                           pData,
+                                           dataLength );
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        result = StunIntegrity_HmacFinal( &( hmacCtx ),
+                                          pHmac );
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunIntegrity_HmacInit( StunHmacContext_t * pHmacCtx,
+                                     const StunIntegrityKey_t * pIntegrityKey )
+{
+    StunResult_t result = STUN_RESULT_OK;
+
+    if( ( pHmacCtx == NULL ) ||
+        ( pIntegrityKey == NULL ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        /* The inner padded key block has already been hashed. */
+        Stun_Sha1InitFromState( &( pHmacCtx->sha1Ctx ),
+                                &( pIntegrityKey->innerState[ 0 ] ),
+                                STUN_SHA1_BLOCK_LENGTH,
+                                pIntegrityKey->compressFn );
+
+        pHmacCtx->pIntegrityKey = pIntegrityKey;
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunIntegrity_HmacUpdate( StunHmacContext_t * pHmacCtx,
+                                       const uint8_t * pData,
+                                       size_t dataLength )
+{
+    StunResult_t result = STUN_RESULT_OK;
+
+    if( ( pHmacCtx == NULL ) ||
+        ( ( pData == NULL ) && ( dataLength != 0 ) ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        Stun_Sha1Update( &( pHmacCtx->sha1Ctx ),
+                         pData,
+                         dataLength );
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunIntegrity_HmacFinal( StunHmacContext_t * pHmacCtx,
+                                      uint8_t * pHmac )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    uint8_t innerDigest[ STUN_SHA1_DIGEST_LENGTH ];
+
+    if( ( pHmacCtx == NULL ) ||
+        ( pHmac == NULL ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        Stun_Sha1Final( &( pHmacCtx->sha1Ctx ), &( innerDigest[ 0 ] ) );
+
+        Stun_Sha1InitFromState( &( pHmacCtx->sha1Ctx ),
+                                &( pHmacCtx->pIntegrityKey->outerState[ 0 ] ),
+                                STUN_SHA1_BLOCK_LENGTH,
+                                pHmacCtx->pIntegrityKey->compressFn );
+        Stun_Sha1Update( &( pHmacCtx->sha1Ctx ), &( innerDigest[ 0 ] ), STUN_SHA1_DIGEST_LENGTH );
+        Stun_Sha1Final( &( pHmacCtx->sha1Ctx ), pHmac );
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunIntegrity_DeriveLongTermKey( const uint8_t * pUsername,
+                                              size_t usernameLength,
+                                              const uint8_t * pRealm,
+                                              size_t realmLength,
+                                              const uint8_t * pPassword,
+                                              size_t passwordLength,
+                                              uint8_t * pLongTermKey )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    StunMd5Context_t md5Ctx;
+    const uint8_t separator = ( uint8_t ) ':';
+
+    if( ( ( pUsername == NULL ) && ( usernameLength != 0 ) ) ||
+        ( ( pRealm == NULL ) && ( realmLength != 0 ) ) ||
+        ( ( pPassword == NULL ) && ( passwordLength != 0 ) ) ||
+        ( pLongTermKey == NULL ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        Stun_Md5Init( &( md5Ctx ) );
+        Stun_Md5Update( &( md5Ctx ), pUsername, usernameLength );
+        Stun_Md5Update( &( md5Ctx ), &( separator ), 1 );
+        Stun_Md5Update( &( md5Ctx ), pRealm, realmLength );
+        Stun_Md5Update( &( md5Ctx ), &( separator ), 1 );
+        Stun_Md5Update( &( md5Ctx ), pPassword, passwordLength );
+        Stun_Md5Final( &( md5Ctx ), pLongTermKey );
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
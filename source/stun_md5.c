@@ -0,0 +1,198 @@
+/* Standard includes. */
+#include <string.h>
+
+/* API includes. */
+#include "stun_md5.h"
+
+#define STUN_MD5_ROTL( value, bits )    ( ( ( value ) << ( bits ) ) | ( ( value ) >> ( 32 - ( bits ) ) ) )
+
+/* Offset of the 64-bit message length in bits in the last block. */
+#define STUN_MD5_LENGTH_OFFSET    ( STUN_MD5_BLOCK_LENGTH - 8 )
+
+/*-----------------------------------------------------------*/
+
+/* Static Functions. */
+static void Md5Compress( uint32_t * pState,
+                         const uint8_t * pBlock );
+
+/*-----------------------------------------------------------*/
+
+/* Round constants - floor( abs( sin( i + 1 ) ) * 2^32 ). */
+static const uint32_t md5RoundConstants[ 64 ] =
+{
+    0xD76AA478, 0xE8C7B756, 0x242070DB, 0xC1BDCEEE, 0xF57C0FAF, 0x4787C62A, 0xA8304613, 0xFD469501,
+    0x698098D8, 0x8B44F7AF, 0xFFFF5BB1, 0x895CD7BE, 0x6B901122, 0xFD987193, 0xA679438E, 0x49B40821,
+    0xF61E2562, 0xC040B340, 0x265E5A51, 0xE9B6C7AA, 0xD62F105D, 0x02441453, 0xD8A1E681, 0xE7D3FBC8,
+    0x21E1CDE6, 0xC33707D6, 0xF4D50D87, 0x455A14ED, 0xA9E3E905, 0xFCEFA3F8, 0x676F02D9, 0x8D2A4C8A,
+    0xFFFA3942, 0x8771F681, 0x6D9D6122, 0xFDE5380C, 0xA4BEEA44, 0x4BDECFA9, 0xF6BB4B60, 0xBEBFBC70,
+    0x289B7EC6, 0xEAA127FA, 0xD4EF3085, 0x04881D05, 0xD9D4D039, 0xE6DB99E5, 0x1FA27CF8, 0xC4AC5665,
+    0xF4292244, 0x432AFF97, 0xAB9423A7, 0xFC93A039, 0x655B59C3, 0x8F0CCC92, 0xFFEFF47D, 0x85845DD1,
+    0x6FA87E4F, 0xFE2CE6E0, 0xA3014314, 0x4E0811A1, 0xF7537E82, 0xBD3AF235, 0x2AD7D2BB, 0xEB86D391
+};
+
+/* Per round rotation amounts, 4 for each of the 4 rounds. */
+static const uint8_t md5Shifts[ 16 ] =
+{
+    7, 12, 17, 22, 5, 9, 14, 20, 4, 11, 16, 23, 6, 10, 15, 21
+};
+
+/*-----------------------------------------------------------*/
+
+static void Md5Compress( uint32_t * pState,
+                         const uint8_t * pBlock )
+{
+    uint32_t m[ 16 ];
+    uint32_t a, b, c, d, f, temp;
+    size_t i, g;
+
+    /* MD5 words are little endian. */
+    for( i = 0; i < 16; i++ )
+    {
+        m[ i ] = ( uint32_t ) pBlock[ 4 * i ] |
+                 ( ( uint32_t ) pBlock[ ( 4 * i ) + 1 ] << 8 ) |
+                 ( ( uint32_t ) pBlock[ ( 4 * i ) + 2 ] << 16 ) |
+                 ( ( uint32_t ) pBlock[ ( 4 * i ) + 3 ] << 24 );
+    }
+
+    a = pState[ 0 ];
+    b = pState[ 1 ];
+    c = pState[ 2 ];
+    d = pState[ 3 ];
+
+    for( i = 0; i < 64; i++ )
+    {
+        if( i < 16 )
+        {
+            f = ( b & c ) | ( ( ~b ) & d );
+            g = i;
+        }
+        else if( i < 32 )
+        {
+            f = ( d & b ) | ( ( ~d ) & c );
+            g = ( ( 5 * i ) + 1 ) & 15;
+        }
+        else if( i < 48 )
+        {
+            f = b ^ c ^ d;
+            g = ( ( 3 * i ) + 5 ) & 15;
+        }
+        else
+        {
+            f = c ^ ( b | ( ~d ) );
+            g = ( 7 * i ) & 15;
+        }
+
+        temp = a + f + md5RoundConstants[ i ] + m[ g ];
+        a = d;
+        d = c;
+        c = b;
+        b = b + STUN_MD5_ROTL( temp, md5Shifts[ ( ( i >> 4 ) << 2 ) | ( i & 3 ) ] );
+    }
+
+    pState[ 0 ] += a;
+    pState[ 1 ] += b;
+    pState[ 2 ] += c;
+    pState[ 3 ] += d;
+}
+
+/*-----------------------------------------------------------*/
+
+void Stun_Md5Init( StunMd5Context_t * pCtx )
+{
+    pCtx->state[ 0 ] = 0x67452301;
+    pCtx->state[ 1 ] = 0xEFCDAB89;
+    pCtx->state[ 2 ] = 0x98BADCFE;
+    pCtx->state[ 3 ] = 0x10325476;
+    pCtx->totalLength = 0;
+    pCtx->blockLength = 0;
+}
+
+/*-----------------------------------------------------------*/
+
+void Stun_Md5Update( StunMd5Context_t * pCtx,
+                     const uint8_t * pData,
+                     size_t dataLength )
+{
+    const uint8_t * pCurrent = pData;
+    size_t remainingLength = dataLength;
+    size_t copyLength;
+
+    pCtx->totalLength += dataLength;
+
+    while( remainingLength > 0 )
+    {
+        if( ( pCtx->blockLength == 0 ) && ( remainingLength >= STUN_MD5_BLOCK_LENGTH ) )
+        {
+            Md5Compress( &( pCtx->state[ 0 ] ), pCurrent );
+            copyLength = STUN_MD5_BLOCK_LENGTH;
+        }
+        else
+        {
+            copyLength = STUN_MD5_BLOCK_LENGTH - pCtx->blockLength;
+
+            if( copyLength > remainingLength )
+            {
+                copyLength = remainingLength;
+            }
+
+            memcpy( ( void * ) &( pCtx->block[ pCtx->blockLength ] ),
+                    ( const void * ) pCurrent,
+                    copyLength );
+            pCtx->blockLength += copyLength;
+
+            if( pCtx->blockLength == STUN_MD5_BLOCK_LENGTH )
+            {
+                Md5Compress( &( pCtx->state[ 0 ] ), &( pCtx->block[ 0 ] ) );
+                pCtx->blockLength = 0;
+            }
+        }
+
+        pCurrent += copyLength;
+        remainingLength -= copyLength;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+void Stun_Md5Final( StunMd5Context_t * pCtx,
+                    uint8_t * pDigest )
+{
+    uint64_t totalBits = pCtx->totalLength * 8U;
+    size_t i;
+
+    pCtx->block[ pCtx->blockLength ] = 0x80;
+    pCtx->blockLength++;
+
+    /* The length does not fit in this block - pad it and use another one. */
+    if( pCtx->blockLength > STUN_MD5_LENGTH_OFFSET )
+    {
+        memset( ( void * ) &( pCtx->block[ pCtx->blockLength ] ),
+                0,
+                STUN_MD5_BLOCK_LENGTH - pCtx->blockLength );
+
+        Md5Compress( &( pCtx->state[ 0 ] ), &( pCtx->block[ 0 ] ) );
+        pCtx->blockLength = 0;
+    }
+
+    memset( ( void * ) &( pCtx->block[ pCtx->blockLength ] ),
+            0,
+            STUN_MD5_LENGTH_OFFSET - pCtx->blockLength );
+
+    /* The length is little endian as well. */
+    for( i = 0; i < 8; i++ )
+    {
+        pCtx->block[ STUN_MD5_LENGTH_OFFSET + i ] = ( uint8_t ) ( totalBits >> ( 8 * i ) );
+    }
+
+    Md5Compress( &( pCtx->state[ 0 ] ), &( pCtx->block[ 0 ] ) );
+
+    for( i = 0; i < 4; i++ )
+    {
+        pDigest[ 4 * i ] = ( uint8_t ) pCtx->state[ i ];
+        pDigest[ ( 4 * i ) + 1 ] = ( uint8_t ) ( pCtx->state[ i ] >> 8 );
+        pDigest[ ( 4 * i ) + 2 ] = ( uint8_t ) ( pCtx->state[ i ] >> 16 );
+        pDigest[ ( 4 * i ) + 3 ] = ( uint8_t ) ( pCtx->state[ i ] >> 24 );
+    }
+}
+
+/*-----------------------------------------------------------*/
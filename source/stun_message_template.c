@@ -0,0 +1,220 @@
+/* Standard includes. */
+#include <string.h>
+
+/* API includes. */
+#include "stun_message_template.h"
+#include "stun_serializer.h"
+#include "stun_deserializer.h"
+
+/*-----------------------------------------------------------*/
+
+/* Static Functions. */
+static uint16_t GetStampedOffset( const StunMessageTemplate_t * pTemplate,
+                                  uint8_t dropUseCandidate,
+                                  uint16_t templateOffset );
+
+/*-----------------------------------------------------------*/
+
+/* Returns the offset in the stamped message of a field at templateOffset in
+ * the template. The fields after USE-CANDIDATE move back by its length when it
+ * is dropped. */
+static uint16_t GetStampedOffset( const StunMessageTemplate_t * pTemplate,
+                                  uint8_t dropUseCandidate,
+                                  uint16_t templateOffset )
+{
+    uint16_t stampedOffset = templateOffset;
+
+    if( ( dropUseCandidate != 0U ) &&
+        ( templateOffset > pTemplate->useCandidateOffset ) )
+    {
+        stampedOffset = ( uint16_t ) ( templateOffset - STUN_ATTRIBUTE_HEADER_LENGTH );
+    }
+
+    return stampedOffset;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunMessageTemplate_Init( StunMessageTemplate_t * pTemplate,
+                                       uint8_t * pMessage,
+                                       size_t messageLength )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    StunContext_t ctx;
+    StunHeader_t header;
+    StunAttribute_t attribute;
+    uint16_t attributeOffset;
+
+    if( ( pTemplate == NULL ) ||
+        ( pMessage == NULL ) ||
+        ( messageLength > UINT16_MAX ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        pTemplate->pMessage = pMessage;
+        pTemplate->messageLength = 0;
+        pTemplate->priorityOffset = STUN_MESSAGE_TEMPLATE_NO_FIELD;
+        pTemplate->useCandidateOffset = STUN_MESSAGE_TEMPLATE_NO_FIELD;
+        pTemplate->integrityOffset = STUN_MESSAGE_TEMPLATE_NO_FIELD;
+        pTemplate->fingerprintOffset = STUN_MESSAGE_TEMPLATE_NO_FIELD;
+
+        result = StunDeserializer_Init( &( ctx ),
+                                        pMessage,
+                                        messageLength,
+                                        &( header ) );
+    }
+
+    while( result == STUN_RESULT_OK )
+    {
+        attributeOffset = ( uint16_t ) ctx.currentIndex;
+
+        result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                    &( attribute ) );
+
+        if( result == STUN_RESULT_OK )
+        {
+            if( ( attribute.attributeType == STUN_ATTRIBUTE_TYPE_PRIORITY ) &&
+                ( pTemplate->priorityOffset == STUN_MESSAGE_TEMPLATE_NO_FIELD ) )
+            {
+                pTemplate->priorityOffset = attributeOffset;
+            }
+            else if( ( attribute.attributeType == STUN_ATTRIBUTE_TYPE_USE_CANDIDATE ) &&
+                     ( pTemplate->useCandidateOffset == STUN_MESSAGE_TEMPLATE_NO_FIELD ) )
+            {
+                pTemplate->useCandidateOffset = attributeOffset;
+            }
+            else if( attribute.attributeType == STUN_ATTRIBUTE_TYPE_MESSAGE_INTEGRITY )
+            {
+                pTemplate->integrityOffset = attributeOffset;
+            }
+            else if( attribute.attributeType == STUN_ATTRIBUTE_TYPE_FINGERPRINT )
+            {
+                pTemplate->fingerprintOffset = attributeOffset;
+            }
+            else
+            {
+                /* Not patched. */
+            }
+        }
+    }
+
+    /* The length is taken from the parsed header, which the deserializer has
+     * checked against messageLength. */
+    if( result == STUN_RESULT_NO_MORE_ATTRIBUTE_FOUND )
+    {
+        pTemplate->messageLength = ( uint16_t ) ( Stun_ReadUint16( &( pMessage[ STUN_HEADER_MESSAGE_LENGTH_OFFSET ] ) ) +
+                                                  STUN_HEADER_LENGTH );
+        result = STUN_RESULT_OK;
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunMessageTemplate_Stamp( const StunMessageTemplate_t * pTemplate,
+                                        const StunMessageTemplateFields_t * pFields,
+                                        const StunIntegrityKey_t * pIntegrityKey,
+                                        uint8_t * pBuffer,
+                                        size_t bufferLength,
+                                        size_t * pMessageLength )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    uint8_t dropUseCandidate = 0;
+    uint16_t messageLength = 0, useCandidateOffset, offset;
+    const StunIntegrityKey_t * pTrailerKey = NULL;
+
+    if( ( pTemplate == NULL ) ||
+        ( pTemplate->messageLength < STUN_HEADER_LENGTH ) ||
+        ( pFields == NULL ) ||
+        ( pFields->pTransactionId == NULL ) ||
+        ( pBuffer == NULL ) ||
+        ( pMessageLength == NULL ) ||
+        ( ( pFields->useCandidate != 0U ) &&
+          ( pTemplate->useCandidateOffset == STUN_MESSAGE_TEMPLATE_NO_FIELD ) ) ||
+        ( ( pIntegrityKey == NULL ) &&
+          ( pTemplate->integrityOffset != STUN_MESSAGE_TEMPLATE_NO_FIELD ) ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        useCandidateOffset = pTemplate->useCandidateOffset;
+        messageLength = pTemplate->messageLength;
+
+        if( ( pFields->useCandidate == 0U ) &&
+            ( useCandidateOffset != STUN_MESSAGE_TEMPLATE_NO_FIELD ) )
+        {
+            dropUseCandidate = 1;
+            messageLength = ( uint16_t ) ( messageLength - STUN_ATTRIBUTE_HEADER_LENGTH );
+        }
+
+        if( bufferLength < messageLength )
+        {
+            result = STUN_RESULT_OUT_OF_MEMORY;
+        }
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        if( dropUseCandidate != 0U )
+        {
+            ( void ) memcpy( ( void * ) pBuffer,
+                             ( const void * ) pTemplate->pMessage,
+                             useCandidateOffset );
+            ( void ) memcpy( ( void * ) &( pBuffer[ useCandidateOffset ] ),
+                             ( const void * ) &( pTemplate->pMessage[ useCandidateOffset + STUN_ATTRIBUTE_HEADER_LENGTH ] ),
+                             ( size_t ) messageLength - useCandidateOffset );
+        }
+        else
+        {
+            ( void ) memcpy( ( void * ) pBuffer,
+                             ( const void * ) pTemplate->pMessage,
+                             messageLength );
+        }
+
+        ( void ) memcpy( ( void * ) &( pBuffer[ STUN_HEADER_TRANSACTION_ID_OFFSET ] ),
+                         ( const void * ) pFields->pTransactionId,
+                         STUN_HEADER_TRANSACTION_ID_LENGTH );
+
+        if( pTemplate->priorityOffset != STUN_MESSAGE_TEMPLATE_NO_FIELD )
+        {
+            offset = GetStampedOffset( pTemplate, dropUseCandidate, pTemplate->priorityOffset );
+            Stun_WriteUint32( &( pBuffer[ offset + STUN_ATTRIBUTE_HEADER_VALUE_OFFSET ] ),
+                              pFields->priority );
+        }
+    }
+
+    /* The deserializer accepts only FINGERPRINT after MESSAGE-INTEGRITY and
+     * nothing after FINGERPRINT, so the trailer starts at the first of them. */
+    if( result == STUN_RESULT_OK )
+    {
+        if( pTemplate->integrityOffset != STUN_MESSAGE_TEMPLATE_NO_FIELD )
+        {
+            offset = GetStampedOffset( pTemplate, dropUseCandidate, pTemplate->integrityOffset );
+            pTrailerKey = pIntegrityKey;
+        }
+        else if( pTemplate->fingerprintOffset != STUN_MESSAGE_TEMPLATE_NO_FIELD )
+        {
+            offset = GetStampedOffset( pTemplate, dropUseCandidate, pTemplate->fingerprintOffset );
+        }
+        else
+        {
+            offset = messageLength;
+        }
+
+        result = StunSerializer_WriteTrailer( pBuffer,
+                                              offset,
+                                              pTrailerKey,
+                                              ( pTemplate->fingerprintOffset != STUN_MESSAGE_TEMPLATE_NO_FIELD ) ? 1U : 0U,
+                                              pMessageLength );
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
@@ -0,0 +1,146 @@
+/* Standard includes. */
+#include <string.h>
+
+/* API includes. */
+#include "stun_response_batch.h"
+#include "stun_serializer.h"
+
+/*-----------------------------------------------------------*/
+
+/* Static Functions. */
+static StunResult_t SerializeResponse( const StunResponseBatchEntry_t * pEntry,
+                                       uint8_t * pBuffer,
+                                       size_t bufferLength,
+                                       size_t * pResponseLength );
+
+/*-----------------------------------------------------------*/
+
+/* Writes one response as StunSerializer_Init,
+ * StunSerializer_AddAttributeXorMappedAddress,
+ * StunSerializer_AddComputedIntegrity, StunSerializer_AddComputedFingerprint
+ * and StunSerializer_Finalize would, without their per-attribute checks. */
+static StunResult_t SerializeResponse( const StunResponseBatchEntry_t * pEntry,
+                                       uint8_t * pBuffer,
+                                       size_t bufferLength,
+                                       size_t * pResponseLength )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    const StunAttributeAddress_t * pAddress = pEntry->pSourceAddress;
+    const uint8_t magicCookie[] = { 0x21, 0x12, 0xA4, 0x42 };
+    uint8_t * pValue;
+    size_t addressLength = 0, responseLength = 0, index, i;
+
+    if( ( pEntry->pTransactionId == NULL ) ||
+        ( pAddress == NULL ) ||
+        ( ( pAddress->family != STUN_ADDRESS_IPv4 ) &&
+          ( pAddress->family != STUN_ADDRESS_IPv6 ) ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        addressLength = ( pAddress->family == STUN_ADDRESS_IPv4 ) ? STUN_IPV4_ADDRESS_SIZE :
+                        STUN_IPV6_ADDRESS_SIZE;
+        responseLength = STUN_HEADER_LENGTH +
+                         STUN_ATTRIBUTE_TOTAL_LENGTH( STUN_ATTRIBUTE_ADDRESS_HEADER_LENGTH + addressLength ) +
+                         STUN_ATTRIBUTE_TOTAL_LENGTH( STUN_ATTRIBUTE_FINGERPRINT_VALUE_LENGTH );
+
+        if( pEntry->pIntegrityKey != NULL )
+        {
+            responseLength += STUN_ATTRIBUTE_TOTAL_LENGTH( STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH );
+        }
+
+        if( bufferLength < responseLength )
+        {
+            result = STUN_RESULT_OUT_OF_MEMORY;
+        }
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        Stun_WriteUint16( &( pBuffer[ 0 ] ),
+                          STUN_MESSAGE_TYPE_BINDING_SUCCESS_RESPONSE );
+        ( void ) memcpy( ( void * ) &( pBuffer[ STUN_HEADER_MAGIC_COOKIE_OFFSET ] ),
+                         ( const void * ) &( magicCookie[ 0 ] ),
+                         sizeof( magicCookie ) );
+        ( void ) memcpy( ( void * ) &( pBuffer[ STUN_HEADER_TRANSACTION_ID_OFFSET ] ),
+                         ( const void * ) pEntry->pTransactionId,
+                         STUN_HEADER_TRANSACTION_ID_LENGTH );
+
+        /* XOR-MAPPED-ADDRESS. The port and the address are XOR'ed with the
+         * magic cookie, and the rest of an IPv6 address with the transaction
+         * ID. */
+        index = STUN_HEADER_LENGTH;
+        pValue = &( pBuffer[ index + STUN_ATTRIBUTE_HEADER_VALUE_OFFSET ] );
+
+        Stun_WriteUint16( &( pBuffer[ index ] ),
+                          STUN_ATTRIBUTE_TYPE_XOR_MAPPED_ADDRESS );
+        Stun_WriteUint16( &( pBuffer[ index + STUN_ATTRIBUTE_HEADER_LENGTH_OFFSET ] ),
+                          ( uint16_t ) ( STUN_ATTRIBUTE_ADDRESS_HEADER_LENGTH + addressLength ) );
+        Stun_WriteUint16( &( pValue[ STUN_ATTRIBUTE_ADDRESS_FAMILY_OFFSET ] ),
+                          pAddress->family );
+        Stun_WriteUint16( &( pValue[ STUN_ATTRIBUTE_ADDRESS_PORT_OFFSET ] ),
+                          ( uint16_t ) ( pAddress->port ^ ( STUN_HEADER_MAGIC_COOKIE >> 16 ) ) );
+
+        for( i = 0; i < addressLength; i++ )
+        {
+            pValue[ STUN_ATTRIBUTE_ADDRESS_IP_ADDRESS_OFFSET + i ] = pAddress->address[ i ] ^
+                                                                     pBuffer[ STUN_HEADER_MAGIC_COOKIE_OFFSET + i ];
+        }
+
+        index += STUN_ATTRIBUTE_TOTAL_LENGTH( STUN_ATTRIBUTE_ADDRESS_HEADER_LENGTH + addressLength );
+
+        result = StunSerializer_WriteTrailer( pBuffer,
+                                              index,
+                                              pEntry->pIntegrityKey,
+                                              1U,
+                                              pResponseLength );
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunResponseBatch_SerializeBindingSuccess( const StunResponseBatchEntry_t * pEntries,
+                                                        size_t entryCount,
+                                                        uint8_t * pArena,
+                                                        size_t arenaLength,
+                                                        size_t * pResponseLengths,
+                                                        size_t * pResponseCount )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    size_t i = 0, offset = 0;
+
+    if( ( ( pEntries == NULL ) && ( entryCount > 0U ) ) ||
+        ( pArena == NULL ) ||
+        ( pResponseLengths == NULL ) ||
+        ( pResponseCount == NULL ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        for( i = 0; ( result == STUN_RESULT_OK ) && ( i < entryCount ); )
+        {
+            result = SerializeResponse( &( pEntries[ i ] ),
+                                        &( pArena[ offset ] ),
+                                        arenaLength - offset,
+                                        &( pResponseLengths[ i ] ) );
+
+            if( result == STUN_RESULT_OK )
+            {
+                offset += pResponseLengths[ i ];
+                i++;
+            }
+        }
+
+        *pResponseCount = i;
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
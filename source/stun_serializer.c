@@ -5,14 +5,33 @@
 
 /* API includes. */
 #include "stun_serializer.h"
+#include "stun_crc32.h"
 
 /* Read/Write macros. */
-#define STUN_WRITE_UINT16   ( pCtx->readWriteFunctions.writeUint16Fn )
-#define STUN_WRITE_UINT32   ( pCtx->readWriteFunctions.writeUint32Fn )
-#define STUN_WRITE_UINT64   ( pCtx->readWriteFunctions.writeUint64Fn )
-#define STUN_READ_UINT16    ( pCtx->readWriteFunctions.readUint16Fn )
-#define STUN_READ_UINT32    ( pCtx->readWriteFunctions.readUint32Fn )
-#define STUN_READ_UINT64    ( pCtx->readWriteFunctions.readUint64Fn )
+#if defined( STUN_USE_COMPILE_TIME_ENDIANNESS )
+    #define STUN_WRITE_UINT16   Stun_WriteUint16
+    #define STUN_WRITE_UINT32   Stun_WriteUint32
+    #define STUN_WRITE_UINT64   Stun_WriteUint64
+    #define STUN_READ_UINT16    Stun_ReadUint16
+    #define STUN_READ_UINT32    Stun_ReadUint32
+    #define STUN_READ_UINT64    Stun_ReadUint64
+#else
+    #define STUN_WRITE_UINT16   ( pCtx->readWriteFunctions.writeUint16Fn )
+    #define STUN_WRITE_UINT32   ( pCtx->readWriteFunctions.writeUint32Fn )
+    #define STUN_WRITE_UINT64   ( pCtx->readWriteFunctions.writeUint64Fn )
+    #define STUN_READ_UINT16    ( pCtx->readWriteFunctions.readUint16Fn )
+    #define STUN_READ_UINT32    ( pCtx->readWriteFunctions.readUint32Fn )
+    #define STUN_READ_UINT64    ( pCtx->readWriteFunctions.readUint64Fn )
+#endif
+
+/* Length of MESSAGE-INTEGRITY and FINGERPRINT. */
+#define STUN_SERIALIZER_TRAILER_LENGTH                                       \
+    ( STUN_ATTRIBUTE_TOTAL_LENGTH( STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH ) + \
+      STUN_ATTRIBUTE_TOTAL_LENGTH( STUN_ATTRIBUTE_FINGERPRINT_VALUE_LENGTH ) )
+
+/* The HMAC and the CRC are computed on chunks of this length, so that the CRC
+ * reads the chunk from L1 right after the HMAC. */
+#define STUN_SERIALIZER_HASH_CHUNK_LENGTH   8192U
 
 /*-----------------------------------------------------------*/
 
@@ -39,6 +58,22 @@ static StunResult_t AddAttributeBuffer( StunContext_t * pCtx,
                                         const uint8_t * pAttributeValueBuffer,
                                         uint16_t attributeValueBufferLength );
 
+static size_t GetMessageEnd( const StunContext_t * pCtx );
+
+static uint16_t GetAttributeValueMaxLength( StunAttributeType_t attributeType );
+
+static void StartSignatureHash( StunContext_t * pCtx,
+                                StunHmacContext_t * pHmacCtx,
+                                const StunIntegrityKey_t * pIntegrityKey,
+                                size_t messageLength,
+                                uint32_t * pCrc32Fingerprint );
+
+static void UpdateHashStream( StunContext_t * pCtx );
+
+static StunResult_t GetFingerprintBuffer( StunContext_t * pCtx,
+                                          uint8_t ** ppStunMessage,
+                                          size_t * pStunMessageLength );
+
 /*-----------------------------------------------------------*/
 
 static StunResult_t CheckAndUpdateAttributeFlag( StunContext_t * pCtx,
@@ -59,6 +94,13 @@ static StunResult_t CheckAndUpdateAttributeFlag( StunContext_t * pCtx,
          * attribute. */
         result = STUN_RESULT_INVALID_ATTRIBUTE_ORDER;
     }
+    else if( ( ( pCtx->attributeFlag & STUN_FLAG_DATA_REFERENCE_ATTRIBUTE ) != 0 ) &&
+             ( attributeType == STUN_ATTRIBUTE_TYPE_MESSAGE_INTEGRITY ) )
+    {
+        /* Integrity is computed over the buffer, which does not have the
+         * referenced DATA value. */
+        result = STUN_RESULT_INVALID_ATTRIBUTE_ORDER;
+    }
 
     if( result == STUN_RESULT_OK )
     {
@@ -89,7 +131,7 @@ static StunResult_t AddAttributeBuffer( StunContext_t * pCtx,
     if( ( pCtx == NULL ) ||
         ( pAttributeValueBuffer == NULL ) ||
         ( attributeValueBufferLength == 0 ) ||
-        ( attributeValueBufferLength > STUN_ATTRIBUTE_VALUE_MAX_LENGTH ) )
+        ( attributeValueBufferLength > GetAttributeValueMaxLength( attributeType ) ) )
     {
         result = STUN_RESULT_BAD_PARAM;
     }
@@ -135,6 +177,8 @@ static StunResult_t AddAttributeBuffer( StunContext_t * pCtx,
         }
 
         pCtx->currentIndex += STUN_ATTRIBUTE_TOTAL_LENGTH( attributeValueLengthPadded );
+
+        UpdateHashStream( pCtx );
     }
 
     return result;
@@ -142,6 +186,102 @@ static StunResult_t AddAttributeBuffer( StunContext_t * pCtx,
 
 /*-----------------------------------------------------------*/
 
+/* Returns the length of the message so far, including the referenced DATA
+ * value which is not in the buffer. */
+static size_t GetMessageEnd( const StunContext_t * pCtx )
+{
+    size_t messageEnd = pCtx->currentIndex;
+
+    if( ( pCtx->attributeFlag & STUN_FLAG_DATA_REFERENCE_ATTRIBUTE ) != 0 )
+    {
+        messageEnd += pCtx->dataReferenceLength;
+    }
+
+    return messageEnd;
+}
+
+/*-----------------------------------------------------------*/
+
+/* DATA carries application data, such as a full-MTU media packet relayed
+ * through TURN, and can take up the whole message. */
+static uint16_t GetAttributeValueMaxLength( StunAttributeType_t attributeType )
+{
+    uint16_t maxLength = STUN_ATTRIBUTE_VALUE_MAX_LENGTH;
+
+    if( attributeType == STUN_ATTRIBUTE_TYPE_DATA )
+    {
+        maxLength = STUN_ATTRIBUTE_DATA_VALUE_MAX_LENGTH;
+    }
+
+    return maxLength;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Starts the HMAC and the CRC of a message that is finalized with
+ * MESSAGE-INTEGRITY and FINGERPRINT to messageLength bytes. The header is
+ * hashed from a copy, as the HMAC covers it with the length up to the end of
+ * MESSAGE-INTEGRITY and the CRC covers it with the final length. */
+/* The HMAC calls cannot fail, the parameters were checked by the caller. */
+static void StartSignatureHash( StunContext_t * pCtx,
+                                StunHmacContext_t * pHmacCtx,
+                                const StunIntegrityKey_t * pIntegrityKey,
+                                size_t messageLength,
+                                uint32_t * pCrc32Fingerprint )
+{
+    uint8_t header[ STUN_HEADER_LENGTH ];
+
+    memcpy( ( void * ) &( header[ 0 ] ),
+            ( const void * ) pCtx->pStart,
+            STUN_HEADER_LENGTH );
+
+    STUN_WRITE_UINT16( &( header[ STUN_HEADER_MESSAGE_LENGTH_OFFSET ] ),
+                       ( uint16_t ) ( messageLength - STUN_HEADER_LENGTH -
+                                      STUN_ATTRIBUTE_TOTAL_LENGTH( STUN_ATTRIBUTE_FINGERPRINT_VALUE_LENGTH ) ) );
+
+    ( void ) StunIntegrity_HmacInit( pHmacCtx,
+                                     pIntegrityKey );
+    ( void ) StunIntegrity_HmacUpdate( pHmacCtx,
+                                       &( header[ 0 ] ),
+                                       STUN_HEADER_LENGTH );
+
+    STUN_WRITE_UINT16( &( header[ STUN_HEADER_MESSAGE_LENGTH_OFFSET ] ),
+                       ( uint16_t ) ( messageLength - STUN_HEADER_LENGTH ) );
+
+    *pCrc32Fingerprint = Stun_Crc32( 0,
+                                     &( header[ 0 ] ),
+                                     STUN_HEADER_LENGTH );
+}
+
+/*-----------------------------------------------------------*/
+
+/* Hashes the attributes added since the last call, up to the last whole
+ * SHA-1 block, so that the HMAC reads them from the buffer instead of copying
+ * them to its block. */
+static void UpdateHashStream( StunContext_t * pCtx )
+{
+    StunSerializerHashStream_t * pHashStream = pCtx->pHashStream;
+    size_t hashEnd;
+
+    if( pHashStream != NULL )
+    {
+        hashEnd = pCtx->currentIndex & ~( ( size_t ) STUN_SHA1_BLOCK_LENGTH - 1U );
+
+        if( hashEnd > pHashStream->hashedIndex )
+        {
+            ( void ) StunIntegrity_HmacUpdate( &( pHashStream->hmacCtx ),
+                                               &( pCtx->pStart[ pHashStream->hashedIndex ] ),
+                                               hashEnd - pHashStream->hashedIndex );
+            pHashStream->crc32Fingerprint = Stun_Crc32( pHashStream->crc32Fingerprint,
+                                                        &( pCtx->pStart[ pHashStream->hashedIndex ] ),
+                                                        hashEnd - pHashStream->hashedIndex );
+            pHashStream->hashedIndex = hashEnd;
+        }
+    }
+}
+
+/*-----------------------------------------------------------*/
+
 static StunResult_t AddAttributeTypeOnly( StunContext_t * pCtx,
                                           StunAttributeType_t attributeType )
 {
@@ -181,6 +321,8 @@ static StunResult_t AddAttributeTypeOnly( StunContext_t * pCtx,
         }
 
         pCtx->currentIndex += STUN_ATTRIBUTE_TOTAL_LENGTH( attributeValueLength );
+
+        UpdateHashStream( pCtx );
     }
 
     return result;
@@ -231,6 +373,8 @@ static StunResult_t AddAttributeUint32( StunContext_t * pCtx,
         }
 
         pCtx->currentIndex += STUN_ATTRIBUTE_TOTAL_LENGTH( attributeValueLength );
+
+        UpdateHashStream( pCtx );
     }
 
     return result;
@@ -281,6 +425,8 @@ static StunResult_t AddAttributeUint64( StunContext_t * pCtx,
         }
 
         pCtx->currentIndex += STUN_ATTRIBUTE_TOTAL_LENGTH( attributeValueLength );
+
+        UpdateHashStream( pCtx );
     }
 
     return result;
@@ -318,6 +464,55 @@ static StunResult_t XorAddress( StunContext_t * pCtx,
 
 /*-----------------------------------------------------------*/
 
+/* Also used by StunSerializer_AddComputedFingerprint, which adds the
+ * referenced DATA value to the CRC. A copied DATA value can put the
+ * FINGERPRINT attribute past 64 KiB, so the length is not 16-bit. */
+static StunResult_t GetFingerprintBuffer( StunContext_t * pCtx,
+                                          uint8_t ** ppStunMessage,
+                                          size_t * pStunMessageLength )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    size_t messageLength;
+
+    /* The callers pass the address of a local for pStunMessageLength. */
+    if( pCtx == NULL )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        if( ( pCtx->currentIndex < STUN_HEADER_LENGTH ) ||
+            ( ( GetMessageEnd( pCtx ) - STUN_HEADER_LENGTH ) > ( STUN_MAX_MESSAGE_LENGTH - STUN_ATTRIBUTE_TOTAL_LENGTH( STUN_ATTRIBUTE_FINGERPRINT_VALUE_LENGTH ) ) ) )
+        {
+            result = STUN_RESULT_INVALID_MESSAGE_LENGTH;
+        }
+        else
+        {
+            messageLength = GetMessageEnd( pCtx ) -
+                            STUN_HEADER_LENGTH +
+                            STUN_ATTRIBUTE_TOTAL_LENGTH( STUN_ATTRIBUTE_FINGERPRINT_VALUE_LENGTH );
+        }
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        if( pCtx->pStart != NULL )
+        {
+            STUN_WRITE_UINT16( &( pCtx->pStart[ STUN_HEADER_MESSAGE_LENGTH_OFFSET ] ),
+                               ( uint16_t ) messageLength );
+
+            *ppStunMessage = ( uint8_t * )( pCtx->pStart );
+        }
+
+        *pStunMessageLength = pCtx->currentIndex;
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
 StunResult_t StunSerializer_Init( StunContext_t * pCtx,
                                   uint8_t * pBuffer,
                                   size_t bufferLength,
@@ -341,6 +536,10 @@ StunResult_t StunSerializer_Init( StunContext_t * pCtx,
         pCtx->totalLength = bufferLength;
         pCtx->currentIndex = 0;
         pCtx->attributeFlag = 0;
+        pCtx->pDataReference = NULL;
+        pCtx->dataReferenceIndex = 0;
+        pCtx->dataReferenceLength = 0;
+        pCtx->pHashStream = NULL;
 
         if( pCtx->pStart != NULL )
         {
@@ -444,6 +643,8 @@ StunResult_t StunSerializer_AddAttributeErrorCode( StunContext_t * pCtx,
         }
 
         pCtx->currentIndex += STUN_ATTRIBUTE_TOTAL_LENGTH( attributeValueLengthPadded );
+
+        UpdateHashStream( pCtx );
     }
 
     return result;
@@ -501,6 +702,8 @@ StunResult_t StunSerializer_AddAttributeChannelNumber( StunContext_t * pCtx,
         }
 
         pCtx->currentIndex += STUN_ATTRIBUTE_TOTAL_LENGTH( attributeValueLength );
+
+        UpdateHashStream( pCtx );
     }
 
     return result;
@@ -608,6 +811,68 @@ StunResult_t StunSerializer_AddAttributeData( StunContext_t * pCtx,
 
 /*-----------------------------------------------------------*/
 
+StunResult_t StunSerializer_AddAttributeDataReference( StunContext_t * pCtx,
+                                                       const uint8_t * pData,
+                                                       uint16_t dataLength )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    uint16_t paddingLength = ( uint16_t ) ( STUN_ALIGN_SIZE_TO_WORD( dataLength ) - dataLength );
+
+    if( ( pCtx == NULL ) ||
+        ( pData == NULL ) ||
+        ( dataLength == 0 ) ||
+        ( dataLength > STUN_ATTRIBUTE_DATA_VALUE_MAX_LENGTH ) ||
+        ( ( pCtx->attributeFlag & STUN_FLAG_DATA_REFERENCE_ATTRIBUTE ) != 0 ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( ( result == STUN_RESULT_OK ) &&
+        ( pCtx->pStart != NULL ) )
+    {
+        /* Only the attribute header and the padding are written to the
+         * buffer. */
+        if( STUN_REMAINING_LENGTH( pCtx ) < ( size_t ) ( STUN_ATTRIBUTE_HEADER_LENGTH + paddingLength ) )
+        {
+            result = STUN_RESULT_OUT_OF_MEMORY;
+        }
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        result = CheckAndUpdateAttributeFlag( pCtx,
+                                              STUN_ATTRIBUTE_TYPE_DATA );
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        if( pCtx->pStart != NULL )
+        {
+            STUN_WRITE_UINT16( &( pCtx->pStart[ pCtx->currentIndex ] ),
+                               STUN_ATTRIBUTE_TYPE_DATA );
+
+            STUN_WRITE_UINT16( &( pCtx->pStart[ pCtx->currentIndex + STUN_ATTRIBUTE_HEADER_LENGTH_OFFSET ] ),
+                               dataLength );
+
+            /* The padding follows the DATA value in the message, so it starts
+             * the part of the buffer after it. */
+            memset( ( void * ) &( pCtx->pStart[ pCtx->currentIndex + STUN_ATTRIBUTE_HEADER_VALUE_OFFSET ] ),
+                    0,
+                    paddingLength );
+        }
+
+        pCtx->attributeFlag |= STUN_FLAG_DATA_REFERENCE_ATTRIBUTE;
+        pCtx->pDataReference = pData;
+        pCtx->dataReferenceIndex = pCtx->currentIndex + STUN_ATTRIBUTE_HEADER_VALUE_OFFSET;
+        pCtx->dataReferenceLength = dataLength;
+        pCtx->currentIndex += ( size_t ) STUN_ATTRIBUTE_HEADER_LENGTH + paddingLength;
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
 StunResult_t StunSerializer_AddAttributeRealm( StunContext_t * pCtx,
                                                const uint8_t * pRealm,
                                                uint16_t realmLength )
@@ -753,6 +1018,8 @@ StunResult_t StunSerializer_AddAttributeAddress( StunContext_t * pCtx,
         }
 
         pCtx->currentIndex += STUN_ATTRIBUTE_TOTAL_LENGTH( attributeValueLength );
+
+        UpdateHashStream( pCtx );
     }
 
     return result;
@@ -856,7 +1123,7 @@ StunResult_t StunSerializer_GetIntegrityBuffer( StunContext_t * pCtx,
     if( result == STUN_RESULT_OK )
     {
         if( ( pCtx->currentIndex < STUN_HEADER_LENGTH ) ||
-            ( ( pCtx->currentIndex - STUN_HEADER_LENGTH ) > ( STUN_MAX_MESSAGE_LENGTH - STUN_ATTRIBUTE_TOTAL_LENGTH( STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH ) ) ) )
+            ( ( GetMessageEnd( pCtx ) - STUN_HEADER_LENGTH ) > ( STUN_MAX_MESSAGE_LENGTH - STUN_ATTRIBUTE_TOTAL_LENGTH( STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH ) ) ) )
         {
             result = STUN_RESULT_INVALID_MESSAGE_LENGTH;
         }
@@ -864,7 +1131,7 @@ StunResult_t StunSerializer_GetIntegrityBuffer( StunContext_t * pCtx,
         {
             /* Fix-up the packet length with message integrity and without the
              * STUN header. */
-            messageLength = pCtx->currentIndex -
+            messageLength = GetMessageEnd( pCtx ) -
                             STUN_HEADER_LENGTH +
                             STUN_ATTRIBUTE_TOTAL_LENGTH( STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH );
         }
@@ -891,6 +1158,97 @@ StunResult_t StunSerializer_GetIntegrityBuffer( StunContext_t * pCtx,
 StunResult_t StunSerializer_GetFingerprintBuffer( StunContext_t * pCtx,
                                                   uint8_t ** ppStunMessage,
                                                   uint16_t * pStunMessageLength )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    size_t stunMessageLength = 0;
+
+    if( ( pCtx == NULL ) ||
+        ( pStunMessageLength == NULL ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+    else if( ( pCtx->attributeFlag & STUN_FLAG_DATA_REFERENCE_ATTRIBUTE ) != 0 )
+    {
+        /* The buffer does not have the referenced DATA value, so the CRC
+         * computed over it would be wrong. */
+        result = STUN_RESULT_INVALID_ATTRIBUTE_ORDER;
+    }
+    else if( pCtx->currentIndex > UINT16_MAX )
+    {
+        /* A copied DATA value put the attribute past 64 KiB, and the covered
+         * length does not fit in pStunMessageLength. */
+        result = STUN_RESULT_INVALID_MESSAGE_LENGTH;
+    }
+    else
+    {
+        /* The message length is checked by GetFingerprintBuffer. */
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        result = GetFingerprintBuffer( pCtx,
+                                       ppStunMessage,
+                                       &( stunMessageLength ) );
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        *pStunMessageLength = ( uint16_t ) stunMessageLength;
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunSerializer_AddComputedFingerprint( StunContext_t * pCtx )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    uint8_t * pStunMessage = NULL;
+    size_t stunMessageLength = 0;
+    uint32_t crc32Fingerprint = 0;
+
+    result = GetFingerprintBuffer( pCtx,
+                                   &( pStunMessage ),
+                                   &( stunMessageLength ) );
+
+    if( result == STUN_RESULT_OK )
+    {
+        /* There is nothing to compute when only the length of the message is
+         * being calculated. */
+        if( ( pStunMessage != NULL ) &&
+            ( ( pCtx->attributeFlag & STUN_FLAG_DATA_REFERENCE_ATTRIBUTE ) != 0 ) )
+        {
+            /* The referenced DATA value is between two parts of the
+             * buffer. */
+            crc32Fingerprint = Stun_Crc32( 0,
+                                           pStunMessage,
+                                           pCtx->dataReferenceIndex );
+            crc32Fingerprint = Stun_Crc32( crc32Fingerprint,
+                                           pCtx->pDataReference,
+                                           pCtx->dataReferenceLength );
+            crc32Fingerprint = Stun_Crc32( crc32Fingerprint,
+                                           &( pStunMessage[ pCtx->dataReferenceIndex ] ),
+                                           stunMessageLength - pCtx->dataReferenceIndex );
+        }
+        else if( pStunMessage != NULL )
+        {
+            crc32Fingerprint = Stun_Crc32( 0,
+                                           pStunMessage,
+                                           stunMessageLength );
+        }
+
+        result = StunSerializer_AddAttributeFingerprint( pCtx,
+                                                         crc32Fingerprint );
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunSerializer_Finalize( StunContext_t * pCtx,
+                                      size_t * pStunMessageLength )
 {
     StunResult_t result = STUN_RESULT_OK;
     size_t messageLength;
@@ -904,15 +1262,13 @@ StunResult_t StunSerializer_GetFingerprintBuffer( StunContext_t * pCtx,
     if( result == STUN_RESULT_OK )
     {
         if( ( pCtx->currentIndex < STUN_HEADER_LENGTH ) ||
-            ( ( pCtx->currentIndex - STUN_HEADER_LENGTH ) > ( STUN_MAX_MESSAGE_LENGTH - STUN_ATTRIBUTE_TOTAL_LENGTH( STUN_ATTRIBUTE_FINGERPRINT_VALUE_LENGTH ) ) ) )
+            ( GetMessageEnd( pCtx ) - STUN_HEADER_LENGTH > STUN_MAX_MESSAGE_LENGTH ) )
         {
             result = STUN_RESULT_INVALID_MESSAGE_LENGTH;
         }
         else
         {
-            messageLength = pCtx->currentIndex -
-                            STUN_HEADER_LENGTH +
-                            STUN_ATTRIBUTE_TOTAL_LENGTH( STUN_ATTRIBUTE_FINGERPRINT_VALUE_LENGTH );
+            messageLength = GetMessageEnd( pCtx ) - STUN_HEADER_LENGTH;
         }
     }
 
@@ -922,11 +1278,49 @@ StunResult_t StunSerializer_GetFingerprintBuffer( StunContext_t * pCtx,
         {
             STUN_WRITE_UINT16( &( pCtx->pStart[ STUN_HEADER_MESSAGE_LENGTH_OFFSET ] ),
                                ( uint16_t ) messageLength );
+        }
 
-            *ppStunMessage = ( uint8_t * )( pCtx->pStart );
+        *pStunMessageLength = GetMessageEnd( pCtx );
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunSerializer_CalculateMessageLength( const StunSerializerAttributeDescriptor_t * pAttributes,
+                                                    size_t attributeCount,
+                                                    size_t * pStunMessageLength )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    size_t i, messageLength = STUN_HEADER_LENGTH;
+
+    if( ( ( pAttributes == NULL ) && ( attributeCount > 0U ) ) ||
+        ( pStunMessageLength == NULL ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    for( i = 0; ( result == STUN_RESULT_OK ) && ( i < attributeCount ); i++ )
+    {
+        if( pAttributes[ i ].valueLength > GetAttributeValueMaxLength( pAttributes[ i ].attributeType ) )
+        {
+            result = STUN_RESULT_BAD_PARAM;
         }
+        else
+        {
+            messageLength += ( size_t ) STUN_SERIALIZER_ATTRIBUTE_LENGTH( pAttributes[ i ].valueLength );
 
-        *pStunMessageLength = ( uint16_t )( pCtx->currentIndex );
+            if( messageLength - STUN_HEADER_LENGTH > STUN_MAX_MESSAGE_LENGTH )
+            {
+                result = STUN_RESULT_INVALID_MESSAGE_LENGTH;
+            }
+        }
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        *pStunMessageLength = messageLength;
     }
 
     return result;
@@ -934,13 +1328,166 @@ StunResult_t StunSerializer_GetFingerprintBuffer( StunContext_t * pCtx,
 
 /*-----------------------------------------------------------*/
 
-StunResult_t StunSerializer_Finalize( StunContext_t * pCtx,
-                                      size_t * pStunMessageLength )
+StunResult_t StunSerializer_FinalizeIoVec( StunContext_t * pCtx,
+                                           StunIoVec_t * pIoVecs,
+                                           size_t ioVecLength,
+                                           size_t * pIoVecCount )
 {
     StunResult_t result = STUN_RESULT_OK;
-    size_t messageLength;
+    size_t messageLength, ioVecCount = 1;
 
     if( ( pCtx == NULL ) ||
+        ( pCtx->pStart == NULL ) ||
+        ( pIoVecs == NULL ) ||
+        ( pIoVecCount == NULL ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        if( ( pCtx->attributeFlag & STUN_FLAG_DATA_REFERENCE_ATTRIBUTE ) != 0 )
+        {
+            /* The last part is empty if nothing follows an unpadded DATA
+             * value. */
+            ioVecCount = ( pCtx->currentIndex > pCtx->dataReferenceIndex ) ? 3U : 2U;
+        }
+
+        if( ioVecLength < ioVecCount )
+        {
+            result = STUN_RESULT_OUT_OF_MEMORY;
+        }
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        result = StunSerializer_Finalize( pCtx,
+                                          &( messageLength ) );
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        if( ioVecCount == 1U )
+        {
+            pIoVecs[ 0 ].pBase = pCtx->pStart;
+            pIoVecs[ 0 ].length = pCtx->currentIndex;
+        }
+        else
+        {
+            pIoVecs[ 0 ].pBase = pCtx->pStart;
+            pIoVecs[ 0 ].length = pCtx->dataReferenceIndex;
+            pIoVecs[ 1 ].pBase = pCtx->pDataReference;
+            pIoVecs[ 1 ].length = pCtx->dataReferenceLength;
+
+            if( ioVecCount == 3U )
+            {
+                pIoVecs[ 2 ].pBase = &( pCtx->pStart[ pCtx->dataReferenceIndex ] );
+                pIoVecs[ 2 ].length = pCtx->currentIndex - pCtx->dataReferenceIndex;
+            }
+        }
+
+        *pIoVecCount = ioVecCount;
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunSerializer_AddComputedIntegrity( StunContext_t * pCtx,
+                                                  const StunIntegrityKey_t * pIntegrityKey )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    uint8_t * pStunMessage = NULL;
+    uint16_t stunMessageLength = 0;
+    uint8_t hmac[ STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH ] = { 0 };
+
+    if( pIntegrityKey == NULL )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        result = StunSerializer_GetIntegrityBuffer( pCtx,
+                                                    &( pStunMessage ),
+                                                    &( stunMessageLength ) );
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        /* There is nothing to compute when only the length of the message is
+         * being calculated. */
+        if( pStunMessage != NULL )
+        {
+            result = StunIntegrity_ComputeHmac( pIntegrityKey,
+                                                pStunMessage,
+                                                stunMessageLength,
+                                                &( hmac[ 0 ] ) );
+        }
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        result = StunSerializer_AddAttributeIntegrity( pCtx,
+                                                       &( hmac[ 0 ] ),
+                                                       STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH );
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunSerializer_EnableHashStream( StunContext_t * pCtx,
+                                              StunSerializerHashStream_t * pHashStream,
+                                              const StunIntegrityKey_t * pIntegrityKey,
+                                              size_t expectedMessageLength )
+{
+    StunResult_t result = STUN_RESULT_OK;
+
+    if( ( pCtx == NULL ) ||
+        ( pCtx->pStart == NULL ) ||
+        ( pCtx->currentIndex != STUN_HEADER_LENGTH ) ||
+        ( pHashStream == NULL ) ||
+        ( pIntegrityKey == NULL ) ||
+        ( expectedMessageLength < ( STUN_HEADER_LENGTH + STUN_SERIALIZER_TRAILER_LENGTH ) ) ||
+        ( expectedMessageLength > ( STUN_HEADER_LENGTH + STUN_MAX_MESSAGE_LENGTH ) ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        StartSignatureHash( pCtx,
+                            &( pHashStream->hmacCtx ),
+                            pIntegrityKey,
+                            expectedMessageLength,
+                            &( pHashStream->crc32Fingerprint ) );
+
+        pHashStream->hashedIndex = STUN_HEADER_LENGTH;
+        pHashStream->expectedMessageLength = expectedMessageLength;
+        pCtx->pHashStream = pHashStream;
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunSerializer_FinalizeWithIntegrityAndFingerprint( StunContext_t * pCtx,
+                                                                 const StunIntegrityKey_t * pIntegrityKey,
+                                                                 size_t * pStunMessageLength )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    StunHmacContext_t hmacCtx;
+    StunHmacContext_t * pHmacCtx = &( hmacCtx );
+    StunSerializerHashStream_t * pHashStream;
+    uint32_t crc32Fingerprint = 0;
+    size_t integrityIndex = 0, index = STUN_HEADER_LENGTH, chunkLength;
+
+    if( ( pCtx == NULL ) ||
+        ( pIntegrityKey == NULL ) ||
         ( pStunMessageLength == NULL ) )
     {
         result = STUN_RESULT_BAD_PARAM;
@@ -949,25 +1496,224 @@ StunResult_t StunSerializer_Finalize( StunContext_t * pCtx,
     if( result == STUN_RESULT_OK )
     {
         if( ( pCtx->currentIndex < STUN_HEADER_LENGTH ) ||
-            ( pCtx->currentIndex - STUN_HEADER_LENGTH > STUN_MAX_MESSAGE_LENGTH ) )
+            ( ( GetMessageEnd( pCtx ) - STUN_HEADER_LENGTH ) > ( STUN_MAX_MESSAGE_LENGTH - STUN_SERIALIZER_TRAILER_LENGTH ) ) )
         {
             result = STUN_RESULT_INVALID_MESSAGE_LENGTH;
         }
+        else if( ( pCtx->pStart != NULL ) &&
+                 ( STUN_REMAINING_LENGTH( pCtx ) < STUN_SERIALIZER_TRAILER_LENGTH ) )
+        {
+            result = STUN_RESULT_OUT_OF_MEMORY;
+        }
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        result = CheckAndUpdateAttributeFlag( pCtx,
+                                              STUN_ATTRIBUTE_TYPE_MESSAGE_INTEGRITY );
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        result = CheckAndUpdateAttributeFlag( pCtx,
+                                              STUN_ATTRIBUTE_TYPE_FINGERPRINT );
+    }
+
+    if( ( result == STUN_RESULT_OK ) &&
+        ( pCtx->pStart != NULL ) )
+    {
+        integrityIndex = pCtx->currentIndex;
+        pHashStream = pCtx->pHashStream;
+        pCtx->pHashStream = NULL;
+
+        if( ( pHashStream != NULL ) &&
+            ( pHashStream->hmacCtx.pIntegrityKey == pIntegrityKey ) &&
+            ( pHashStream->expectedMessageLength == ( integrityIndex + STUN_SERIALIZER_TRAILER_LENGTH ) ) )
+        {
+            /* The message before hashedIndex has already been hashed. */
+            pHmacCtx = &( pHashStream->hmacCtx );
+            crc32Fingerprint = pHashStream->crc32Fingerprint;
+            index = pHashStream->hashedIndex;
+        }
         else
         {
-            messageLength = pCtx->currentIndex - STUN_HEADER_LENGTH;
+            StartSignatureHash( pCtx,
+                                pHmacCtx,
+                                pIntegrityKey,
+                                integrityIndex + STUN_SERIALIZER_TRAILER_LENGTH,
+                                &( crc32Fingerprint ) );
         }
+
+        STUN_WRITE_UINT16( &( pCtx->pStart[ STUN_HEADER_MESSAGE_LENGTH_OFFSET ] ),
+                           ( uint16_t ) ( integrityIndex - STUN_HEADER_LENGTH + STUN_SERIALIZER_TRAILER_LENGTH ) );
+
+        for( ; index < integrityIndex; index += chunkLength )
+        {
+            chunkLength = integrityIndex - index;
+
+            if( chunkLength > STUN_SERIALIZER_HASH_CHUNK_LENGTH )
+            {
+                chunkLength = STUN_SERIALIZER_HASH_CHUNK_LENGTH;
+            }
+
+            ( void ) StunIntegrity_HmacUpdate( pHmacCtx,
+                                               &( pCtx->pStart[ index ] ),
+                                               chunkLength );
+            crc32Fingerprint = Stun_Crc32( crc32Fingerprint,
+                                           &( pCtx->pStart[ index ] ),
+                                           chunkLength );
+        }
+    }
+
+    if( ( result == STUN_RESULT_OK ) &&
+        ( pCtx->pStart != NULL ) )
+    {
+        STUN_WRITE_UINT16( &( pCtx->pStart[ integrityIndex ] ),
+                           STUN_ATTRIBUTE_TYPE_MESSAGE_INTEGRITY );
+        STUN_WRITE_UINT16( &( pCtx->pStart[ integrityIndex + STUN_ATTRIBUTE_HEADER_LENGTH_OFFSET ] ),
+                           STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH );
+
+        result = StunIntegrity_HmacFinal( pHmacCtx,
+                                          &( pCtx->pStart[ integrityIndex + STUN_ATTRIBUTE_HEADER_VALUE_OFFSET ] ) );
+    }
+
+    if( ( result == STUN_RESULT_OK ) &&
+        ( pCtx->pStart != NULL ) )
+    {
+        crc32Fingerprint = Stun_Crc32( crc32Fingerprint,
+                                       &( pCtx->pStart[ integrityIndex ] ),
+                                       STUN_ATTRIBUTE_TOTAL_LENGTH( STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH ) );
+
+        index = integrityIndex + STUN_ATTRIBUTE_TOTAL_LENGTH( STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH );
+
+        STUN_WRITE_UINT16( &( pCtx->pStart[ index ] ),
+                           STUN_ATTRIBUTE_TYPE_FINGERPRINT );
+        STUN_WRITE_UINT16( &( pCtx->pStart[ index + STUN_ATTRIBUTE_HEADER_LENGTH_OFFSET ] ),
+                           STUN_ATTRIBUTE_FINGERPRINT_VALUE_LENGTH );
+        STUN_WRITE_UINT32( &( pCtx->pStart[ index + STUN_ATTRIBUTE_HEADER_VALUE_OFFSET ] ),
+                           crc32Fingerprint ^ STUN_ATTRIBUTE_FINGERPRINT_XOR_VALUE );
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        pCtx->currentIndex += STUN_SERIALIZER_TRAILER_LENGTH;
+        *pStunMessageLength = pCtx->currentIndex;
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunSerializer_Checkpoint( const StunContext_t * pCtx,
+                                        StunSerializerCheckpoint_t * pCheckpoint )
+{
+    StunResult_t result = STUN_RESULT_OK;
+
+    if( ( pCtx == NULL ) ||
+        ( pCheckpoint == NULL ) ||
+        ( pCtx->currentIndex < STUN_HEADER_LENGTH ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        pCheckpoint->ctx = *pCtx;
+        pCheckpoint->ctx.pHashStream = NULL;
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunSerializer_Restore( StunContext_t * pCtx,
+                                     const StunSerializerCheckpoint_t * pCheckpoint )
+{
+    StunResult_t result = STUN_RESULT_OK;
+
+    /* The attributes up to the checkpoint must still be in the buffer. */
+    if( ( pCtx == NULL ) ||
+        ( pCheckpoint == NULL ) ||
+        ( pCtx->pStart != pCheckpoint->ctx.pStart ) ||
+        ( pCtx->currentIndex < pCheckpoint->ctx.currentIndex ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        *pCtx = pCheckpoint->ctx;
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunSerializer_Fork( const StunContext_t * pCtx,
+                                  StunContext_t * pForkCtx,
+                                  uint8_t * pBuffer,
+                                  size_t bufferLength )
+{
+    StunResult_t result = STUN_RESULT_OK;
+
+    if( ( pCtx == NULL ) ||
+        ( pCtx->pStart == NULL ) ||
+        ( pCtx->currentIndex < STUN_HEADER_LENGTH ) ||
+        ( pForkCtx == NULL ) ||
+        ( pBuffer == NULL ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( ( result == STUN_RESULT_OK ) &&
+        ( bufferLength < pCtx->currentIndex ) )
+    {
+        result = STUN_RESULT_OUT_OF_MEMORY;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        ( void ) memcpy( ( void * ) pBuffer,
+                         ( const void * ) pCtx->pStart,
+                         pCtx->currentIndex );
+
+        *pForkCtx = *pCtx;
+        pForkCtx->pStart = pBuffer;
+        pForkCtx->totalLength = bufferLength;
+        pForkCtx->pHashStream = NULL;
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunSerializer_SetTransactionId( StunContext_t * pCtx,
+                                              const uint8_t * pTransactionId )
+{
+    StunResult_t result = STUN_RESULT_OK;
+
+    if( ( pCtx == NULL ) ||
+        ( pTransactionId == NULL ) ||
+        ( pCtx->currentIndex < STUN_HEADER_LENGTH ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
     }
 
     if( result == STUN_RESULT_OK )
     {
         if( pCtx->pStart != NULL )
         {
-            STUN_WRITE_UINT16( &( pCtx->pStart[ STUN_HEADER_MESSAGE_LENGTH_OFFSET ] ),
-                               ( uint16_t ) messageLength );
+            ( void ) memcpy( ( void * ) &( pCtx->pStart[ STUN_HEADER_TRANSACTION_ID_OFFSET ] ),
+                             ( const void * ) pTransactionId,
+                             STUN_HEADER_TRANSACTION_ID_LENGTH );
         }
 
-        *pStunMessageLength = pCtx->currentIndex;
+        /* The stream has hashed the header with the previous ID. */
+        pCtx->pHashStream = NULL;
     }
 
     return result;
@@ -975,3 +1721,77 @@ StunResult_t StunSerializer_Finalize( StunContext_t * pCtx,
 
 /*-----------------------------------------------------------*/
 
+StunResult_t StunSerializer_WriteTrailer( uint8_t * pMessage,
+                                          size_t attributesLength,
+                                          const StunIntegrityKey_t * pIntegrityKey,
+                                          uint8_t addFingerprint,
+                                          size_t * pStunMessageLength )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    size_t messageLength = attributesLength;
+    uint32_t crc32Fingerprint;
+
+    if( ( pMessage == NULL ) ||
+        ( pStunMessageLength == NULL ) ||
+        ( attributesLength < STUN_HEADER_LENGTH ) ||
+        ( attributesLength > ( STUN_HEADER_LENGTH + STUN_MAX_MESSAGE_LENGTH - STUN_SERIALIZER_TRAILER_LENGTH ) ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    /* The HMAC covers the header with the length up to the end of
+     * MESSAGE-INTEGRITY. */
+    if( ( result == STUN_RESULT_OK ) &&
+        ( pIntegrityKey != NULL ) )
+    {
+        messageLength += STUN_ATTRIBUTE_TOTAL_LENGTH( STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH );
+
+        Stun_WriteUint16( &( pMessage[ STUN_HEADER_MESSAGE_LENGTH_OFFSET ] ),
+                          ( uint16_t ) ( messageLength - STUN_HEADER_LENGTH ) );
+        Stun_WriteUint16( &( pMessage[ attributesLength ] ),
+                          STUN_ATTRIBUTE_TYPE_MESSAGE_INTEGRITY );
+        Stun_WriteUint16( &( pMessage[ attributesLength + STUN_ATTRIBUTE_HEADER_LENGTH_OFFSET ] ),
+                          STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH );
+
+        result = StunIntegrity_ComputeHmac( pIntegrityKey,
+                                            pMessage,
+                                            attributesLength,
+                                            &( pMessage[ attributesLength + STUN_ATTRIBUTE_HEADER_VALUE_OFFSET ] ) );
+    }
+
+    /* FINGERPRINT is the last attribute, so the CRC covers the header with the
+     * final length. */
+    if( result == STUN_RESULT_OK )
+    {
+        if( addFingerprint != 0U )
+        {
+            Stun_WriteUint16( &( pMessage[ STUN_HEADER_MESSAGE_LENGTH_OFFSET ] ),
+                              ( uint16_t ) ( messageLength - STUN_HEADER_LENGTH +
+                                             STUN_ATTRIBUTE_TOTAL_LENGTH( STUN_ATTRIBUTE_FINGERPRINT_VALUE_LENGTH ) ) );
+
+            crc32Fingerprint = Stun_Crc32( 0,
+                                           pMessage,
+                                           messageLength ) ^ STUN_ATTRIBUTE_FINGERPRINT_XOR_VALUE;
+
+            Stun_WriteUint16( &( pMessage[ messageLength ] ),
+                              STUN_ATTRIBUTE_TYPE_FINGERPRINT );
+            Stun_WriteUint16( &( pMessage[ messageLength + STUN_ATTRIBUTE_HEADER_LENGTH_OFFSET ] ),
+                              STUN_ATTRIBUTE_FINGERPRINT_VALUE_LENGTH );
+            Stun_WriteUint32( &( pMessage[ messageLength + STUN_ATTRIBUTE_HEADER_VALUE_OFFSET ] ),
+                              crc32Fingerprint );
+
+            messageLength += STUN_ATTRIBUTE_TOTAL_LENGTH( STUN_ATTRIBUTE_FINGERPRINT_VALUE_LENGTH );
+        }
+        else
+        {
+            Stun_WriteUint16( &( pMessage[ STUN_HEADER_MESSAGE_LENGTH_OFFSET ] ),
+                              ( uint16_t ) ( messageLength - STUN_HEADER_LENGTH ) );
+        }
+
+        *pStunMessageLength = messageLength;
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
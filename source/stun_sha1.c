@@ -0,0 +1,540 @@
+/* Standard includes. */
+#include <string.h>
+
+/* API includes. */
+#include "stun_sha1.h"
+
+#if !defined( STUN_DISABLE_SIMD )
+    #if defined( __x86_64__ ) && ( defined( __GNUC__ ) || defined( __clang__ ) )
+        #include <immintrin.h>
+        #define STUN_SHA1_USE_SHA_NI
+    #elif defined( __aarch64__ ) && ( defined( __GNUC__ ) || defined( __clang__ ) )
+        #include <arm_neon.h>
+        #define STUN_SHA1_USE_ARMV8
+        #if !defined( __ARM_FEATURE_SHA2 ) && !defined( __ARM_FEATURE_CRYPTO ) && defined( __linux__ )
+            #include <sys/auxv.h>
+            #if !defined( HWCAP_SHA1 )
+                #define HWCAP_SHA1    ( 1 << 5 )
+            #endif
+        #endif
+    #endif
+#endif /* if !defined( STUN_DISABLE_SIMD ) */
+
+#define STUN_SHA1_ROTL( value, bits )    ( ( ( value ) << ( bits ) ) | ( ( value ) >> ( 32 - ( bits ) ) ) )
+
+/* Offset of the 64-bit message length in bits in the last block. */
+#define STUN_SHA1_LENGTH_OFFSET    ( STUN_SHA1_BLOCK_LENGTH - 8 )
+
+/*-----------------------------------------------------------*/
+
+void Stun_Sha1CompressPortable( uint32_t * pState,
+                                const uint8_t * pBlocks,
+                                size_t blockCount )
+{
+    const uint8_t * pCurrent = pBlocks;
+    uint32_t w[ 16 ];
+    uint32_t a, b, c, d, e, f, k, temp;
+    size_t block, i;
+
+    for( block = 0; block < blockCount; block++ )
+    {
+        for( i = 0; i < 16; i++ )
+        {
+            w[ i ] = ( ( uint32_t ) pCurrent[ 4 * i ] << 24 ) |
+                     ( ( uint32_t ) pCurrent[ ( 4 * i ) + 1 ] << 16 ) |
+                     ( ( uint32_t ) pCurrent[ ( 4 * i ) + 2 ] << 8 ) |
+                     ( uint32_t ) pCurrent[ ( 4 * i ) + 3 ];
+        }
+
+        a = pState[ 0 ];
+        b = pState[ 1 ];
+        c = pState[ 2 ];
+        d = pState[ 3 ];
+        e = pState[ 4 ];
+
+        for( i = 0; i < 80; i++ )
+        {
+            if( i >= 16 )
+            {
+                /* Message schedule kept in a 16 word circular buffer. */
+                temp = w[ ( i + 13 ) & 15 ] ^ w[ ( i + 8 ) & 15 ] ^ w[ ( i + 2 ) & 15 ] ^ w[ i & 15 ];
+                w[ i & 15 ] = STUN_SHA1_ROTL( temp, 1 );
+            }
+
+            if( i < 20 )
+            {
+                f = ( b & c ) | ( ( ~b ) & d );
+                k = 0x5A827999;
+            }
+            else if( i < 40 )
+            {
+                f = b ^ c ^ d;
+                k = 0x6ED9EBA1;
+            }
+            else if( i < 60 )
+            {
+                f = ( b & c ) | ( b & d ) | ( c & d );
+                k = 0x8F1BBCDC;
+            }
+            else
+            {
+                f = b ^ c ^ d;
+                k = 0xCA62C1D6;
+            }
+
+            temp = STUN_SHA1_ROTL( a, 5 ) + f + e + k + w[ i & 15 ];
+            e = d;
+            d = c;
+            c = STUN_SHA1_ROTL( b, 30 );
+            b = a;
+            a = temp;
+        }
+
+        pState[ 0 ] += a;
+        pState[ 1 ] += b;
+        pState[ 2 ] += c;
+        pState[ 3 ] += d;
+        pState[ 4 ] += e;
+
+        pCurrent += STUN_SHA1_BLOCK_LENGTH;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+#if defined( STUN_SHA1_USE_SHA_NI )
+
+/* LCOV_EXCL_START */
+/* Uses the SHA extensions (SHA-NI). Each _mm_sha1rnds4_epu32 performs 4
+ * rounds, and the message schedule is computed 4 words at a time with
+ * _mm_sha1msg1_epu32 and _mm_sha1msg2_epu32. */
+__attribute__( ( target( "sha,ssse3,sse4.1" ) ) )
+static void Sha1CompressShaNi( uint32_t * pState,
+                               const uint8_t * pBlocks,
+                               size_t blockCount )
+{
+    const uint8_t * pCurrent = pBlocks;
+    const __m128i byteSwapMask = _mm_set_epi64x( 0x0001020304050607LL, 0x08090A0B0C0D0E0FLL );
+    __m128i abcd, abcdSaved, e0, e0Saved, e1;
+    __m128i msg[ 4 ];
+    size_t block;
+
+    abcd = _mm_shuffle_epi32( _mm_loadu_si128( ( const __m128i * ) pState ), 0x1B );
+    e0 = _mm_set_epi32( ( int ) pState[ 4 ], 0, 0, 0 );
+
+    for( block = 0; block < blockCount; block++ )
+    {
+        abcdSaved = abcd;
+        e0Saved = e0;
+
+        /* Rounds 0-3. */
+        msg[ 0 ] = _mm_shuffle_epi8( _mm_loadu_si128( ( const __m128i * ) &( pCurrent[ 0 ] ) ), byteSwapMask );
+        e0 = _mm_add_epi32( e0, msg[ 0 ] );
+        e1 = abcd;
+        abcd = _mm_sha1rnds4_epu32( abcd, e0, 0 );
+
+        /* Rounds 4-7. */
+        msg[ 1 ] = _mm_shuffle_epi8( _mm_loadu_si128( ( const __m128i * ) &( pCurrent[ 16 ] ) ), byteSwapMask );
+        e1 = _mm_sha1nexte_epu32( e1, msg[ 1 ] );
+        e0 = abcd;
+        abcd = _mm_sha1rnds4_epu32( abcd, e1, 0 );
+        msg[ 0 ] = _mm_sha1msg1_epu32( msg[ 0 ], msg[ 1 ] );
+
+        /* Rounds 8-11. */
+        msg[ 2 ] = _mm_shuffle_epi8( _mm_loadu_si128( ( const __m128i * ) &( pCurrent[ 32 ] ) ), byteSwapMask );
+        e0 = _mm_sha1nexte_epu32( e0, msg[ 2 ] );
+        e1 = abcd;
+        abcd = _mm_sha1rnds4_epu32( abcd, e0, 0 );
+        msg[ 1 ] = _mm_sha1msg1_epu32( msg[ 1 ], msg[ 2 ] );
+        msg[ 0 ] = _mm_xor_si128( msg[ 0 ], msg[ 2 ] );
+
+        /* Rounds 12-15. */
+        msg[ 3 ] = _mm_shuffle_epi8( _mm_loadu_si128( ( const __m128i * ) &( pCurrent[ 48 ] ) ), byteSwapMask );
+        e1 = _mm_sha1nexte_epu32( e1, msg[ 3 ] );
+        e0 = abcd;
+        msg[ 0 ] = _mm_sha1msg2_epu32( msg[ 0 ], msg[ 3 ] );
+        abcd = _mm_sha1rnds4_epu32( abcd, e1, 0 );
+        msg[ 2 ] = _mm_sha1msg1_epu32( msg[ 2 ], msg[ 3 ] );
+        msg[ 1 ] = _mm_xor_si128( msg[ 1 ], msg[ 3 ] );
+
+        /* Rounds 16-19. */
+        e0 = _mm_sha1nexte_epu32( e0, msg[ 0 ] );
+        e1 = abcd;
+        msg[ 1 ] = _mm_sha1msg2_epu32( msg[ 1 ], msg[ 0 ] );
+        abcd = _mm_sha1rnds4_epu32( abcd, e0, 0 );
+        msg[ 3 ] = _mm_sha1msg1_epu32( msg[ 3 ], msg[ 0 ] );
+        msg[ 2 ] = _mm_xor_si128( msg[ 2 ], msg[ 0 ] );
+
+        /* Rounds 20-23. */
+        e1 = _mm_sha1nexte_epu32( e1, msg[ 1 ] );
+        e0 = abcd;
+        msg[ 2 ] = _mm_sha1msg2_epu32( msg[ 2 ], msg[ 1 ] );
+        abcd = _mm_sha1rnds4_epu32( abcd, e1, 1 );
+        msg[ 0 ] = _mm_sha1msg1_epu32( msg[ 0 ], msg[ 1 ] );
+        msg[ 3 ] = _mm_xor_si128( msg[ 3 ], msg[ 1 ] );
+
+        /* Rounds 24-27. */
+        e0 = _mm_sha1nexte_epu32( e0, msg[ 2 ] );
+        e1 = abcd;
+        msg[ 3 ] = _mm_sha1msg2_epu32( msg[ 3 ], msg[ 2 ] );
+        abcd = _mm_sha1rnds4_epu32( abcd, e0, 1 );
+        msg[ 1 ] = _mm_sha1msg1_epu32( msg[ 1 ], msg[ 2 ] );
+        msg[ 0 ] = _mm_xor_si128( msg[ 0 ], msg[ 2 ] );
+
+        /* Rounds 28-31. */
+        e1 = _mm_sha1nexte_epu32( e1, msg[ 3 ] );
+        e0 = abcd;
+        msg[ 0 ] = _mm_sha1msg2_epu32( msg[ 0 ], msg[ 3 ] );
+        abcd = _mm_sha1rnds4_epu32( abcd, e1, 1 );
+        msg[ 2 ] = _mm_sha1msg1_epu32( msg[ 2 ], msg[ 3 ] );
+        msg[ 1 ] = _mm_xor_si128( msg[ 1 ], msg[ 3 ] );
+
+        /* Rounds 32-35. */
+        e0 = _mm_sha1nexte_epu32( e0, msg[ 0 ] );
+        e1 = abcd;
+        msg[ 1 ] = _mm_sha1msg2_epu32( msg[ 1 ], msg[ 0 ] );
+        abcd = _mm_sha1rnds4_epu32( abcd, e0, 1 );
+        msg[ 3 ] = _mm_sha1msg1_epu32( msg[ 3 ], msg[ 0 ] );
+        msg[ 2 ] = _mm_xor_si128( msg[ 2 ], msg[ 0 ] );
+
+        /* Rounds 36-39. */
+        e1 = _mm_sha1nexte_epu32( e1, msg[ 1 ] );
+        e0 = abcd;
+        msg[ 2 ] = _mm_sha1msg2_epu32( msg[ 2 ], msg[ 1 ] );
+        abcd = _mm_sha1rnds4_epu32( abcd, e1, 1 );
+        msg[ 0 ] = _mm_sha1msg1_epu32( msg[ 0 ], msg[ 1 ] );
+        msg[ 3 ] = _mm_xor_si128( msg[ 3 ], msg[ 1 ] );
+
+        /* Rounds 40-43. */
+        e0 = _mm_sha1nexte_epu32( e0, msg[ 2 ] );
+        e1 = abcd;
+        msg[ 3 ] = _mm_sha1msg2_epu32( msg[ 3 ], msg[ 2 ] );
+        abcd = _mm_sha1rnds4_epu32( abcd, e0, 2 );
+        msg[ 1 ] = _mm_sha1msg1_epu32( msg[ 1 ], msg[ 2 ] );
+        msg[ 0 ] = _mm_xor_si128( msg[ 0 ], msg[ 2 ] );
+
+        /* Rounds 44-47. */
+        e1 = _mm_sha1nexte_epu32( e1, msg[ 3 ] );
+        e0 = abcd;
+        msg[ 0 ] = _mm_sha1msg2_epu32( msg[ 0 ], msg[ 3 ] );
+        abcd = _mm_sha1rnds4_epu32( abcd, e1, 2 );
+        msg[ 2 ] = _mm_sha1msg1_epu32( msg[ 2 ], msg[ 3 ] );
+        msg[ 1 ] = _mm_xor_si128( msg[ 1 ], msg[ 3 ] );
+
+        /* Rounds 48-51. */
+        e0 = _mm_sha1nexte_epu32( e0, msg[ 0 ] );
+        e1 = abcd;
+        msg[ 1 ] = _mm_sha1msg2_epu32( msg[ 1 ], msg[ 0 ] );
+        abcd = _mm_sha1rnds4_epu32( abcd, e0, 2 );
+        msg[ 3 ] = _mm_sha1msg1_epu32( msg[ 3 ], msg[ 0 ] );
+        msg[ 2 ] = _mm_xor_si128( msg[ 2 ], msg[ 0 ] );
+
+        /* Rounds 52-55. */
+        e1 = _mm_sha1nexte_epu32( e1, msg[ 1 ] );
+        e0 = abcd;
+        msg[ 2 ] = _mm_sha1msg2_epu32( msg[ 2 ], msg[ 1 ] );
+        abcd = _mm_sha1rnds4_epu32( abcd, e1, 2 );
+        msg[ 0 ] = _mm_sha1msg1_epu32( msg[ 0 ], msg[ 1 ] );
+        msg[ 3 ] = _mm_xor_si128( msg[ 3 ], msg[ 1 ] );
+
+        /* Rounds 56-59. */
+        e0 = _mm_sha1nexte_epu32( e0, msg[ 2 ] );
+        e1 = abcd;
+        msg[ 3 ] = _mm_sha1msg2_epu32( msg[ 3 ], msg[ 2 ] );
+        abcd = _mm_sha1rnds4_epu32( abcd, e0, 2 );
+        msg[ 1 ] = _mm_sha1msg1_epu32( msg[ 1 ], msg[ 2 ] );
+        msg[ 0 ] = _mm_xor_si128( msg[ 0 ], msg[ 2 ] );
+
+        /* Rounds 60-63. */
+        e1 = _mm_sha1nexte_epu32( e1, msg[ 3 ] );
+        e0 = abcd;
+        msg[ 0 ] = _mm_sha1msg2_epu32( msg[ 0 ], msg[ 3 ] );
+        abcd = _mm_sha1rnds4_epu32( abcd, e1, 3 );
+        msg[ 2 ] = _mm_sha1msg1_epu32( msg[ 2 ], msg[ 3 ] );
+        msg[ 1 ] = _mm_xor_si128( msg[ 1 ], msg[ 3 ] );
+
+        /* Rounds 64-67. */
+        e0 = _mm_sha1nexte_epu32( e0, msg[ 0 ] );
+        e1 = abcd;
+        msg[ 1 ] = _mm_sha1msg2_epu32( msg[ 1 ], msg[ 0 ] );
+        abcd = _mm_sha1rnds4_epu32( abcd, e0, 3 );
+        msg[ 3 ] = _mm_sha1msg1_epu32( msg[ 3 ], msg[ 0 ] );
+        msg[ 2 ] = _mm_xor_si128( msg[ 2 ], msg[ 0 ] );
+
+        /* Rounds 68-71. */
+        e1 = _mm_sha1nexte_epu32( e1, msg[ 1 ] );
+        e0 = abcd;
+        msg[ 2 ] = _mm_sha1msg2_epu32( msg[ 2 ], msg[ 1 ] );
+        abcd = _mm_sha1rnds4_epu32( abcd, e1, 3 );
+        msg[ 3 ] = _mm_xor_si128( msg[ 3 ], msg[ 1 ] );
+
+        /* Rounds 72-75. */
+        e0 = _mm_sha1nexte_epu32( e0, msg[ 2 ] );
+        e1 = abcd;
+        msg[ 3 ] = _mm_sha1msg2_epu32( msg[ 3 ], msg[ 2 ] );
+        abcd = _mm_sha1rnds4_epu32( abcd, e0, 3 );
+
+        /* Rounds 76-79. */
+        e1 = _mm_sha1nexte_epu32( e1, msg[ 3 ] );
+        e0 = abcd;
+        abcd = _mm_sha1rnds4_epu32( abcd, e1, 3 );
+
+        abcd = _mm_add_epi32( abcd, abcdSaved );
+        e0 = _mm_sha1nexte_epu32( e0, e0Saved );
+
+        pCurrent += STUN_SHA1_BLOCK_LENGTH;
+    }
+
+    _mm_storeu_si128( ( __m128i * ) pState, _mm_shuffle_epi32( abcd, 0x1B ) );
+    pState[ 4 ] = ( uint32_t ) _mm_extract_epi32( e0, 3 );
+}
+
+/* LCOV_EXCL_STOP */
+
+#endif /* if defined( STUN_SHA1_USE_SHA_NI ) */
+
+/*-----------------------------------------------------------*/
+
+#if defined( STUN_SHA1_USE_ARMV8 )
+
+/* LCOV_EXCL_START */
+/* Uses the ARMv8 cryptography extensions. Each vsha1*q_u32 performs 4 rounds,
+ * and the message schedule is computed 4 words at a time with vsha1su0q_u32
+ * and vsha1su1q_u32. */
+#if defined( __clang__ )
+    __attribute__( ( target( "sha2" ) ) )
+#else
+    __attribute__( ( target( "+crypto" ) ) )
+#endif
+static void Sha1CompressArmv8( uint32_t * pState,
+                               const uint8_t * pBlocks,
+                               size_t blockCount )
+{
+    static const uint32_t roundConstants[ 4 ] = { 0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xCA62C1D6 };
+    const uint8_t * pCurrent = pBlocks;
+    uint32x4_t abcd, abcdSaved, wk;
+    uint32x4_t msg[ 4 ];
+    uint32_t e, eNext, eSaved;
+    size_t block, group;
+
+    abcd = vld1q_u32( pState );
+    e = pState[ 4 ];
+
+    for( block = 0; block < blockCount; block++ )
+    {
+        abcdSaved = abcd;
+        eSaved = e;
+
+        for( group = 0; group < 4; group++ )
+        {
+            msg[ group ] = vreinterpretq_u32_u8( vrev32q_u8( vld1q_u8( &( pCurrent[ 16 * group ] ) ) ) );
+        }
+
+        /* 20 groups of 4 rounds. msg[ group % 4 ] holds the message words of
+         * the group, and is replaced with the words of group + 4 after use. */
+        for( group = 0; group < 20; group++ )
+        {
+            if( group >= 4 )
+            {
+                msg[ group % 4 ] = vsha1su1q_u32( vsha1su0q_u32( msg[ group % 4 ],
+                                                                 msg[ ( group + 1 ) % 4 ],
+                                                                 msg[ ( group + 2 ) % 4 ] ),
+                                                  msg[ ( group + 3 ) % 4 ] );
+            }
+
+            wk = vaddq_u32( msg[ group % 4 ], vdupq_n_u32( roundConstants[ group / 5 ] ) );
+            eNext = vsha1h_u32( vgetq_lane_u32( abcd, 0 ) );
+
+            if( group < 5 )
+            {
+                abcd = vsha1cq_u32( abcd, e, wk );
+            }
+            else if( ( group < 10 ) || ( group >= 15 ) )
+            {
+                abcd = vsha1pq_u32( abcd, e, wk );
+            }
+            else
+            {
+                abcd = vsha1mq_u32( abcd, e, wk );
+            }
+
+            e = eNext;
+        }
+
+        abcd = vaddq_u32( abcd, abcdSaved );
+        e += eSaved;
+
+        pCurrent += STUN_SHA1_BLOCK_LENGTH;
+    }
+
+    vst1q_u32( pState, abcd );
+    pState[ 4 ] = e;
+}
+
+/* LCOV_EXCL_STOP */
+
+#endif /* if defined( STUN_SHA1_USE_ARMV8 ) */
+
+/*-----------------------------------------------------------*/
+
+StunSha1CompressFunction_t Stun_Sha1GetCompressFunction( void )
+{
+    StunSha1CompressFunction_t compressFn = Stun_Sha1CompressPortable;
+
+    /* The kernel depends on the CPU, so the selection is excluded from the
+     * coverage. The unit tests run the test vectors through both the
+     * portable kernel and the selected one. */
+    /* LCOV_EXCL_START */
+    #if defined( STUN_SHA1_USE_SHA_NI )
+        if( ( __builtin_cpu_supports( "sha" ) ) &&
+            ( __builtin_cpu_supports( "sse4.1" ) ) )
+        {
+            compressFn = Sha1CompressShaNi;
+        }
+    #elif defined( STUN_SHA1_USE_ARMV8 )
+        #if defined( __ARM_FEATURE_SHA2 ) || defined( __ARM_FEATURE_CRYPTO )
+            compressFn = Sha1CompressArmv8;
+        #elif defined( __linux__ )
+            if( ( getauxval( AT_HWCAP ) & HWCAP_SHA1 ) != 0 )
+            {
+                compressFn = Sha1CompressArmv8;
+            }
+        #endif
+    #endif /* if defined( STUN_SHA1_USE_SHA_NI ) */
+    /* LCOV_EXCL_STOP */
+
+    return compressFn;
+}
+
+/*-----------------------------------------------------------*/
+
+void Stun_Sha1Init( StunSha1Context_t * pCtx )
+{
+    static const uint32_t initialState[ STUN_SHA1_STATE_WORDS ] =
+    {
+        0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0
+    };
+
+    Stun_Sha1InitFromState( pCtx,
+                            &( initialState[ 0 ] ),
+                            0,
+                            Stun_Sha1GetCompressFunction() );
+}
+
+/*-----------------------------------------------------------*/
+
+void Stun_Sha1InitFromState( StunSha1Context_t * pCtx,
+                             const uint32_t * pState,
+                             uint64_t processedLength,
+                             StunSha1CompressFunction_t compressFn )
+{
+    memcpy( ( void * ) &( pCtx->state[ 0 ] ),
+            ( const void * ) pState,
+            sizeof( pCtx->state ) );
+
+    pCtx->totalLength = processedLength;
+    pCtx->blockLength = 0;
+    pCtx->compressFn = compressFn;
+}
+
+/*-----------------------------------------------------------*/
+
+void Stun_Sha1Update( StunSha1Context_t * pCtx,
+                      const uint8_t * pData,
+                      size_t dataLength )
+{
+    const uint8_t * pCurrent = pData;
+    size_t remainingLength = dataLength;
+    size_t copyLength, blockCount;
+
+    pCtx->totalLength += dataLength;
+
+    /* Complete the partial block first. */
+    if( ( pCtx->blockLength > 0 ) && ( remainingLength > 0 ) )
+    {
+        copyLength = STUN_SHA1_BLOCK_LENGTH - pCtx->blockLength;
+
+        if( copyLength > remainingLength )
+        {
+            copyLength = remainingLength;
+        }
+
+        memcpy( ( void * ) &( pCtx->block[ pCtx->blockLength ] ),
+                ( const void * ) pCurrent,
+                copyLength );
+
+        pCtx->blockLength += copyLength;
+        pCurrent += copyLength;
+        remainingLength -= copyLength;
+
+        if( pCtx->blockLength == STUN_SHA1_BLOCK_LENGTH )
+        {
+            pCtx->compressFn( &( pCtx->state[ 0 ] ), &( pCtx->block[ 0 ] ), 1 );
+            pCtx->blockLength = 0;
+        }
+    }
+
+    /* Whole blocks straight from the input. */
+    blockCount = remainingLength / STUN_SHA1_BLOCK_LENGTH;
+
+    if( blockCount > 0 )
+    {
+        pCtx->compressFn( &( pCtx->state[ 0 ] ), pCurrent, blockCount );
+
+        pCurrent += blockCount * STUN_SHA1_BLOCK_LENGTH;
+        remainingLength -= blockCount * STUN_SHA1_BLOCK_LENGTH;
+    }
+
+    if( remainingLength > 0 )
+    {
+        memcpy( ( void * ) &( pCtx->block[ 0 ] ),
+                ( const void * ) pCurrent,
+                remainingLength );
+
+        pCtx->blockLength = remainingLength;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+void Stun_Sha1Final( StunSha1Context_t * pCtx,
+                     uint8_t * pDigest )
+{
+    uint64_t totalBits = pCtx->totalLength * 8U;
+    size_t i;
+
+    pCtx->block[ pCtx->blockLength ] = 0x80;
+    pCtx->blockLength++;
+
+    /* The length does not fit in this block - pad it and use another one. */
+    if( pCtx->blockLength > STUN_SHA1_LENGTH_OFFSET )
+    {
+        memset( ( void * ) &( pCtx->block[ pCtx->blockLength ] ),
+                0,
+                STUN_SHA1_BLOCK_LENGTH - pCtx->blockLength );
+
+        pCtx->compressFn( &( pCtx->state[ 0 ] ), &( pCtx->block[ 0 ] ), 1 );
+        pCtx->blockLength = 0;
+    }
+
+    memset( ( void * ) &( pCtx->block[ pCtx->blockLength ] ),
+            0,
+            STUN_SHA1_LENGTH_OFFSET - pCtx->blockLength );
+
+    for( i = 0; i < 8; i++ )
+    {
+        pCtx->block[ STUN_SHA1_LENGTH_OFFSET + i ] = ( uint8_t ) ( totalBits >> ( 56 - ( 8 * i ) ) );
+    }
+
+    pCtx->compressFn( &( pCtx->state[ 0 ] ), &( pCtx->block[ 0 ] ), 1 );
+
+    for( i = 0; i < STUN_SHA1_STATE_WORDS; i++ )
+    {
+        pDigest[ 4 * i ] = ( uint8_t ) ( pCtx->state[ i ] >> 24 );
+        pDigest[ ( 4 * i ) + 1 ] = ( uint8_t ) ( pCtx->state[ i ] >> 16 );
+        pDigest[ ( 4 * i ) + 2 ] = ( uint8_t ) ( pCtx->state[ i ] >> 8 );
+        pDigest[ ( 4 * i ) + 3 ] = ( uint8_t ) pCtx->state[ i ];
+    }
+}
+
+/*-----------------------------------------------------------*/
@@ -0,0 +1,315 @@
+/* Standard includes. */
+#include <string.h>
+
+/* API includes. */
+#include "stun_stream_parser.h"
+#include "stun_channel_data.h"
+
+/* RFC 4571 length prefix. */
+#define STUN_RFC4571_HEADER_LENGTH          2
+
+/*-----------------------------------------------------------*/
+
+/* Static Functions. */
+static void CompactBuffer( StunStreamParser_t * pParser );
+
+static StunResult_t GetStunFramedLength( const uint8_t * pData,
+                                         size_t dataLength,
+                                         StunStreamFrame_t * pFrame,
+                                         size_t * pTotalLength );
+
+static StunResult_t GetRfc4571FramedLength( const uint8_t * pData,
+                                            size_t dataLength,
+                                            StunStreamFrame_t * pFrame,
+                                            size_t * pTotalLength );
+
+/*-----------------------------------------------------------*/
+
+/* Moves the data of the incomplete frame to the start of the buffer. It is
+ * usually a few bytes, as the complete frames have been returned already. */
+static void CompactBuffer( StunStreamParser_t * pParser )
+{
+    size_t pendingLength = pParser->writeIndex - pParser->readIndex;
+
+    if( ( pParser->readIndex > 0 ) && ( pendingLength > 0 ) )
+    {
+        ( void ) memmove( &( pParser->pBuffer[ 0 ] ),
+                          &( pParser->pBuffer[ pParser->readIndex ] ),
+                          pendingLength );
+    }
+
+    pParser->readIndex = 0;
+    pParser->writeIndex = pendingLength;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Gets the length of a STUN or ChannelData message at the start of pData.
+ * pTotalLength is set to 0 if more data is needed to know the length. */
+static StunResult_t GetStunFramedLength( const uint8_t * pData,
+                                         size_t dataLength,
+                                         StunStreamFrame_t * pFrame,
+                                         size_t * pTotalLength )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    uint16_t length;
+    uint32_t magicCookie;
+
+    *pTotalLength = 0;
+
+    if( dataLength >= STUN_CHANNEL_DATA_HEADER_LENGTH )
+    {
+        length = Stun_ReadUint16( &( pData[ STUN_HEADER_MESSAGE_LENGTH_OFFSET ] ) );
+
+        if( pData[ 0 ] <= STUN_CLASSIFIER_STUN_FIRST_BYTE_MAX )
+        {
+            pFrame->packetType = STUN_PACKET_TYPE_STUN;
+            pFrame->frameLength = STUN_HEADER_LENGTH + ( size_t ) length;
+            *pTotalLength = pFrame->frameLength;
+
+            if( ( length & 0x03 ) != 0 )
+            {
+                result = STUN_RESULT_INVALID_MESSAGE_LENGTH;
+            }
+        }
+        else if( ( pData[ 0 ] >= STUN_CLASSIFIER_CHANNEL_DATA_FIRST_BYTE_MIN ) &&
+                 ( pData[ 0 ] <= STUN_CLASSIFIER_CHANNEL_DATA_FIRST_BYTE_MAX ) )
+        {
+            /* ChannelData is padded to a multiple of 4 bytes over TCP, and
+             * the padding is not included in the length. */
+            pFrame->packetType = STUN_PACKET_TYPE_CHANNEL_DATA;
+            pFrame->frameLength = STUN_CHANNEL_DATA_HEADER_LENGTH + ( size_t ) length;
+            *pTotalLength = ( pFrame->frameLength + 3U ) & ~( ( size_t ) 3U );
+        }
+        else
+        {
+            result = STUN_RESULT_INVALID_FRAME;
+        }
+    }
+
+    /* The magic cookie tells whether the stream is still in sync. */
+    if( ( result == STUN_RESULT_OK ) &&
+        ( pFrame->packetType == STUN_PACKET_TYPE_STUN ) &&
+        ( dataLength >= ( STUN_HEADER_MAGIC_COOKIE_OFFSET + sizeof( uint32_t ) ) ) )
+    {
+        magicCookie = Stun_ReadUint32( &( pData[ STUN_HEADER_MAGIC_COOKIE_OFFSET ] ) );
+
+        if( magicCookie != STUN_HEADER_MAGIC_COOKIE )
+        {
+            result = STUN_RESULT_MAGIC_COOKIE_MISMATCH;
+        }
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Gets the length of the RFC 4571 frame at the start of pData. pTotalLength is
+ * set to 0 if more data is needed to know the length. */
+static StunResult_t GetRfc4571FramedLength( const uint8_t * pData,
+                                            size_t dataLength,
+                                            StunStreamFrame_t * pFrame,
+                                            size_t * pTotalLength )
+{
+    *pTotalLength = 0;
+
+    if( dataLength >= STUN_RFC4571_HEADER_LENGTH )
+    {
+        pFrame->frameLength = Stun_ReadUint16( &( pData[ 0 ] ) );
+        *pTotalLength = STUN_RFC4571_HEADER_LENGTH + pFrame->frameLength;
+    }
+
+    return STUN_RESULT_OK;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunStreamParser_Init( StunStreamParser_t * pParser,
+                                    uint8_t * pBuffer,
+                                    size_t bufferLength,
+                                    StunStreamFraming_t framing )
+{
+    StunResult_t result = STUN_RESULT_OK;
+
+    if( ( pParser == NULL ) ||
+        ( pBuffer == NULL ) ||
+        ( bufferLength < STUN_HEADER_LENGTH ) ||
+        ( ( framing != STUN_STREAM_FRAMING_STUN ) &&
+          ( framing != STUN_STREAM_FRAMING_RFC4571 ) ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        pParser->pBuffer = pBuffer;
+        pParser->bufferLength = bufferLength;
+        pParser->readIndex = 0;
+        pParser->writeIndex = 0;
+        pParser->framing = framing;
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunStreamParser_GetWriteBuffer( StunStreamParser_t * pParser,
+                                              uint8_t ** ppWriteBuffer,
+                                              size_t * pWriteBufferLength )
+{
+    StunResult_t result = STUN_RESULT_OK;
+
+    if( ( pParser == NULL ) ||
+        ( ppWriteBuffer == NULL ) ||
+        ( pWriteBufferLength == NULL ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        CompactBuffer( pParser );
+
+        if( pParser->writeIndex == pParser->bufferLength )
+        {
+            result = STUN_RESULT_OUT_OF_MEMORY;
+        }
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        *ppWriteBuffer = &( pParser->pBuffer[ pParser->writeIndex ] );
+        *pWriteBufferLength = pParser->bufferLength - pParser->writeIndex;
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunStreamParser_CommitWrite( StunStreamParser_t * pParser,
+                                           size_t length )
+{
+    StunResult_t result = STUN_RESULT_OK;
+
+    if( ( pParser == NULL ) ||
+        ( length > ( pParser->bufferLength - pParser->writeIndex ) ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        pParser->writeIndex += length;
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunStreamParser_Feed( StunStreamParser_t * pParser,
+                                    const uint8_t * pData,
+                                    size_t dataLength,
+                                    size_t * pConsumedLength )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    uint8_t * pWriteBuffer = NULL;
+    size_t writeBufferLength = 0;
+
+    if( ( pParser == NULL ) ||
+        ( pData == NULL ) ||
+        ( pConsumedLength == NULL ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        result = StunStreamParser_GetWriteBuffer( pParser,
+                                                  &( pWriteBuffer ),
+                                                  &( writeBufferLength ) );
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        if( writeBufferLength > dataLength )
+        {
+            writeBufferLength = dataLength;
+        }
+
+        ( void ) memcpy( pWriteBuffer, pData, writeBufferLength );
+        pParser->writeIndex += writeBufferLength;
+        *pConsumedLength = writeBufferLength;
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunStreamParser_GetNextFrame( StunStreamParser_t * pParser,
+                                            StunStreamFrame_t * pFrame )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    const uint8_t * pData;
+    size_t dataLength = 0, totalLength = 0;
+
+    if( ( pParser == NULL ) ||
+        ( pFrame == NULL ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        pData = &( pParser->pBuffer[ pParser->readIndex ] );
+        dataLength = pParser->writeIndex - pParser->readIndex;
+
+        if( pParser->framing == STUN_STREAM_FRAMING_STUN )
+        {
+            result = GetStunFramedLength( pData, dataLength, pFrame, &( totalLength ) );
+        }
+        else
+        {
+            result = GetRfc4571FramedLength( pData, dataLength, pFrame, &( totalLength ) );
+        }
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        if( totalLength > pParser->bufferLength )
+        {
+            result = STUN_RESULT_OUT_OF_MEMORY;
+        }
+        else if( ( totalLength == 0 ) || ( totalLength > dataLength ) )
+        {
+            result = STUN_RESULT_NEED_MORE_DATA;
+        }
+        else
+        {
+            /* Complete frame. */
+        }
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        if( pParser->framing == STUN_STREAM_FRAMING_STUN )
+        {
+            pFrame->pFrame = &( pParser->pBuffer[ pParser->readIndex ] );
+        }
+        else
+        {
+            pFrame->pFrame = &( pParser->pBuffer[ pParser->readIndex + STUN_RFC4571_HEADER_LENGTH ] );
+            pFrame->packetType = StunClassifier_ClassifyPacket( pFrame->pFrame, pFrame->frameLength );
+        }
+
+        pParser->readIndex += totalLength;
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
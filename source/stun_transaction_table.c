@@ -0,0 +1,645 @@
+/* Standard includes. */
+#include <string.h>
+
+/* API includes. */
+#include "stun_transaction_table.h"
+
+/*
+ * Every slot has a tag byte:
+ * - STUN_TRANSACTION_TAG_EMPTY - Free.
+ * - STUN_TRANSACTION_TAG_BUSY - Being written or removed.
+ * - STUN_TRANSACTION_TAG_FULL_FLAG | 7 bits of the hash - In use.
+ *
+ * A thread takes a free slot by changing its tag to busy with a compare and
+ * swap, writes the transaction ID and user data, and then publishes the slot
+ * by storing the full tag. Removing takes the slot back to busy with a
+ * compare and swap, which lets only one of the removers have the user data,
+ * and then frees it.
+ *
+ * Every group counts the transactions that were inserted past it, i.e. in a
+ * later group of their probe sequence, and a probe ends at the first group
+ * whose count is 0. The remove that takes a transaction out decrements the
+ * counts it was added to, so removed slots are free again right away instead
+ * of being left as tombstones that a probe has to go past. With steady
+ * inserts and removes, tombstones would end up in every group and a lookup of
+ * a missing transaction would probe the whole table.
+ *
+ * A reader can find a slot with a matching tag that is removed and reused
+ * while it reads the transaction ID. The sequence number of the slot is odd
+ * while it is written, and the reader retries when the sequence number is odd
+ * or changes during the read (a seqlock).
+ *
+ * The tags of a group are compared with SSE2 on x86 and NEON on AArch64.
+ * Define STUN_DISABLE_SIMD to always use the portable implementation.
+ */
+#if !defined( STUN_DISABLE_SIMD )
+    #if defined( __SSE2__ ) || defined( _M_X64 )
+        #include <emmintrin.h>
+        #define STUN_TRANSACTION_TABLE_USE_SSE2
+    #elif ( defined( __ARM_NEON ) || defined( __ARM_NEON__ ) ) && defined( __aarch64__ )
+        #include <arm_neon.h>
+        #define STUN_TRANSACTION_TABLE_USE_NEON
+    #endif
+#endif /* if !defined( STUN_DISABLE_SIMD ) */
+
+/*
+ * Without the GCC/Clang atomic builtins, the table can only be used from one
+ * thread at a time.
+ */
+#if defined( __GNUC__ ) || defined( __clang__ )
+    #define STUN_LOAD_ACQUIRE( pVar )               __atomic_load_n( pVar, __ATOMIC_ACQUIRE )
+    #define STUN_LOAD_RELAXED( pVar )               __atomic_load_n( pVar, __ATOMIC_RELAXED )
+    #define STUN_STORE_RELEASE( pVar, val )         __atomic_store_n( pVar, val, __ATOMIC_RELEASE )
+    #define STUN_STORE_RELAXED( pVar, val )         __atomic_store_n( pVar, val, __ATOMIC_RELAXED )
+    #define STUN_CAS( pVar, pExpected, desired )    __atomic_compare_exchange_n( pVar, pExpected, desired, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED )
+    #define STUN_ADD_RELAXED( pVar, val )           ( void ) __atomic_add_fetch( pVar, val, __ATOMIC_RELAXED )
+    #define STUN_SUB_RELAXED( pVar, val )           ( void ) __atomic_sub_fetch( pVar, val, __ATOMIC_RELAXED )
+    #define STUN_FENCE_ACQUIRE()                    __atomic_thread_fence( __ATOMIC_ACQUIRE )
+    #define STUN_FENCE_RELEASE()                    __atomic_thread_fence( __ATOMIC_RELEASE )
+#else
+    #define STUN_LOAD_ACQUIRE( pVar )               ( *( pVar ) )
+    #define STUN_LOAD_RELAXED( pVar )               ( *( pVar ) )
+    #define STUN_STORE_RELEASE( pVar, val )         ( *( pVar ) = ( val ) )
+    #define STUN_STORE_RELAXED( pVar, val )         ( *( pVar ) = ( val ) )
+    #define STUN_CAS( pVar, pExpected, desired )    CompareAndSwap( pVar, pExpected, desired )
+    #define STUN_ADD_RELAXED( pVar, val )           ( *( pVar ) += ( val ) )
+    #define STUN_SUB_RELAXED( pVar, val )           ( *( pVar ) -= ( val ) )
+    #define STUN_FENCE_ACQUIRE()
+    #define STUN_FENCE_RELEASE()
+#endif /* if defined( __GNUC__ ) || defined( __clang__ ) */
+
+/*
+ * The unit tests define STUN_TRANSACTION_TABLE_TEST_HOOK to change a slot at
+ * the points where another thread could.
+ */
+#if defined( STUN_TRANSACTION_TABLE_TEST_HOOK )
+    void StunTransactionTable_TestHook( void );
+    #define STUN_TRANSACTION_TABLE_HOOK()    StunTransactionTable_TestHook()
+#else
+    #define STUN_TRANSACTION_TABLE_HOOK()
+#endif
+
+#define STUN_TRANSACTION_TAG_EMPTY          0x00
+#define STUN_TRANSACTION_TAG_BUSY           0x02
+#define STUN_TRANSACTION_TAG_FULL_FLAG      0x80
+
+#define STUN_TRANSACTION_ID_WORDS           ( STUN_HEADER_TRANSACTION_ID_LENGTH / sizeof( uint32_t ) )
+
+/*-----------------------------------------------------------*/
+
+/* Static Functions. */
+#if !defined( __GNUC__ ) && !defined( __clang__ )
+    static int CompareAndSwap( uint8_t * pTag,
+                               uint8_t * pExpected,
+                               uint8_t desired );
+#endif
+
+static uint64_t HashTransactionId( const uint32_t * pWords,
+                                   uint64_t seed );
+
+static uint32_t MatchGroup( const uint8_t * pGroupTags,
+                            uint8_t tag );
+
+static uint32_t CountTrailingZeros( uint32_t mask );
+
+static int ReadSlot( StunTransactionSlot_t * pSlot,
+                     const uint32_t * pWords,
+                     uint32_t * pSequence,
+                     void ** ppUserData );
+
+static void GetProbeStart( const StunTransactionTable_t * pTable,
+                           const uint32_t * pWords,
+                           uint8_t * pTag,
+                           size_t * pGroup );
+
+static void ReleaseGroups( const StunTransactionTable_t * pTable,
+                           size_t group,
+                           size_t groupCount );
+
+static StunResult_t FindSlot( const StunTransactionTable_t * pTable,
+                              const uint8_t * pTransactionId,
+                              uint8_t takeSlot,
+                              void ** ppUserData );
+
+static int TakeFreeSlot( const StunTransactionTable_t * pTable,
+                         size_t group,
+                         uint8_t tag,
+                         const uint32_t * pWords,
+                         void * pUserData );
+
+/*-----------------------------------------------------------*/
+
+#if !defined( __GNUC__ ) && !defined( __clang__ )
+    static int CompareAndSwap( uint8_t * pTag,
+                               uint8_t * pExpected,
+                               uint8_t desired )
+    {
+        int swapped = 0;
+
+        if( *pTag == *pExpected )
+        {
+            *pTag = desired;
+            swapped = 1;
+        }
+        else
+        {
+            *pExpected = *pTag;
+        }
+
+        return swapped;
+    }
+#endif /* if !defined( __GNUC__ ) && !defined( __clang__ ) */
+
+/*-----------------------------------------------------------*/
+
+static uint64_t HashTransactionId( const uint32_t * pWords,
+                                   uint64_t seed )
+{
+    uint64_t hash;
+
+    hash = seed ^ ( ( ( uint64_t ) pWords[ 0 ] << 32 ) | pWords[ 1 ] );
+    hash *= 0x9E3779B97F4A7C15ULL;
+    hash ^= ( hash >> 32 ) ^ pWords[ 2 ];
+    hash *= 0xC2B2AE3D27D4EB4FULL;
+    hash ^= hash >> 29;
+
+    return hash;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Returns a mask with bit i set if tag i of the group is equal to tag. The
+ * tags are read without synchronization, a match is confirmed by ReadSlot or
+ * the compare and swap on the tag. */
+static uint32_t MatchGroup( const uint8_t * pGroupTags,
+                            uint8_t tag )
+{
+    uint32_t mask = 0;
+
+    #if defined( STUN_TRANSACTION_TABLE_USE_SSE2 )
+        __m128i tags;
+
+        tags = _mm_loadu_si128( ( const __m128i * ) pGroupTags );
+        mask = ( uint32_t ) _mm_movemask_epi8( _mm_cmpeq_epi8( tags, _mm_set1_epi8( ( char ) tag ) ) );
+    #elif defined( STUN_TRANSACTION_TABLE_USE_NEON )
+        static const uint8_t bitWeights[ 16 ] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+        uint8x16_t bits;
+
+        bits = vandq_u8( vceqq_u8( vld1q_u8( pGroupTags ), vdupq_n_u8( tag ) ), vld1q_u8( bitWeights ) );
+        mask = ( uint32_t ) vaddv_u8( vget_low_u8( bits ) ) | ( ( uint32_t ) vaddv_u8( vget_high_u8( bits ) ) << 8 );
+    #else
+        size_t i;
+
+        for( i = 0; i < STUN_TRANSACTION_TABLE_GROUP_LENGTH; i++ )
+        {
+            if( STUN_LOAD_RELAXED( &( pGroupTags[ i ] ) ) == tag )
+            {
+                mask |= ( uint32_t ) 1 << i;
+            }
+        }
+    #endif /* if defined( STUN_TRANSACTION_TABLE_USE_SSE2 ) */
+
+    return mask;
+}
+
+/*-----------------------------------------------------------*/
+
+static uint32_t CountTrailingZeros( uint32_t mask )
+{
+    uint32_t count = 0;
+
+    #if defined( __GNUC__ ) || defined( __clang__ )
+        count = ( uint32_t ) __builtin_ctz( mask );
+    #else
+        while( ( mask & 1U ) == 0U )
+        {
+            mask >>= 1;
+            count++;
+        }
+    #endif
+
+    return count;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Returns 1 if the slot holds the transaction ID. pSequence is set to the
+ * sequence number the read was validated with. */
+static int ReadSlot( StunTransactionSlot_t * pSlot,
+                     const uint32_t * pWords,
+                     uint32_t * pSequence,
+                     void ** ppUserData )
+{
+    int isMatch = 0, isStable = 0;
+    uint32_t sequence, words[ STUN_TRANSACTION_ID_WORDS ];
+    void * pUserData;
+
+    while( isStable == 0 )
+    {
+        sequence = STUN_LOAD_ACQUIRE( &( pSlot->sequence ) );
+
+        words[ 0 ] = STUN_LOAD_RELAXED( &( pSlot->transactionIdWords[ 0 ] ) );
+        words[ 1 ] = STUN_LOAD_RELAXED( &( pSlot->transactionIdWords[ 1 ] ) );
+        words[ 2 ] = STUN_LOAD_RELAXED( &( pSlot->transactionIdWords[ 2 ] ) );
+        pUserData = STUN_LOAD_RELAXED( &( pSlot->pUserData ) );
+
+        STUN_TRANSACTION_TABLE_HOOK();
+        STUN_FENCE_ACQUIRE();
+
+        if( ( ( sequence & 1U ) == 0U ) &&
+            ( STUN_LOAD_RELAXED( &( pSlot->sequence ) ) == sequence ) )
+        {
+            isStable = 1;
+        }
+    }
+
+    if( ( words[ 0 ] == pWords[ 0 ] ) &&
+        ( words[ 1 ] == pWords[ 1 ] ) &&
+        ( words[ 2 ] == pWords[ 2 ] ) )
+    {
+        isMatch = 1;
+        *pSequence = sequence;
+        *ppUserData = pUserData;
+    }
+
+    return isMatch;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Returns the tag of the transaction ID and the first group of its probe
+ * sequence. */
+static void GetProbeStart( const StunTransactionTable_t * pTable,
+                           const uint32_t * pWords,
+                           uint8_t * pTag,
+                           size_t * pGroup )
+{
+    uint64_t hash;
+    size_t groupMask;
+
+    hash = HashTransactionId( pWords, pTable->seed );
+    groupMask = ( pTable->capacity / STUN_TRANSACTION_TABLE_GROUP_LENGTH ) - 1;
+
+    *pTag = ( uint8_t ) ( STUN_TRANSACTION_TAG_FULL_FLAG | ( hash & 0x7F ) );
+    *pGroup = ( size_t ) ( hash >> 7 ) & groupMask;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Decrements the overflow counts of the first groupCount groups of the probe
+ * sequence starting at group. */
+static void ReleaseGroups( const StunTransactionTable_t * pTable,
+                           size_t group,
+                           size_t groupCount )
+{
+    size_t groupMask, probe;
+
+    groupMask = ( pTable->capacity / STUN_TRANSACTION_TABLE_GROUP_LENGTH ) - 1;
+
+    for( probe = 0; probe < groupCount; probe++ )
+    {
+        STUN_SUB_RELAXED( &( pTable->pOverflowCounts[ group ] ), 1U );
+        group = ( group + probe + 1 ) & groupMask;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* Probes the groups for the transaction ID. If takeSlot is set, the matching
+ * slot is removed. A slot that is removed, or removed and reused, while it is
+ * read is skipped, so a transaction ID that another thread removes and
+ * inserts again during the probe can be reported as not found. It is not
+ * probed again, as the transaction was not in the table for a moment. */
+static StunResult_t FindSlot( const StunTransactionTable_t * pTable,
+                              const uint8_t * pTransactionId,
+                              uint8_t takeSlot,
+                              void ** ppUserData )
+{
+    StunResult_t result = STUN_RESULT_TRANSACTION_NOT_FOUND;
+    uint32_t words[ STUN_TRANSACTION_ID_WORDS ], matches, sequence;
+    size_t groupMask, firstGroup, group, probe, slotIndex;
+    uint8_t tag, expectedTag;
+    void * pUserData = NULL;
+    int done = 0, isMatch;
+
+    ( void ) memcpy( &( words[ 0 ] ), pTransactionId, STUN_HEADER_TRANSACTION_ID_LENGTH );
+
+    GetProbeStart( pTable, &( words[ 0 ] ), &( tag ), &( firstGroup ) );
+    groupMask = ( pTable->capacity / STUN_TRANSACTION_TABLE_GROUP_LENGTH ) - 1;
+    group = firstGroup;
+
+    /* Triangular probing visits every group once when the number of groups is
+     * a power of 2. */
+    for( probe = 0; ( probe <= groupMask ) && ( done == 0 ); probe++ )
+    {
+        const uint8_t * pGroupTags = &( pTable->pTags[ group * STUN_TRANSACTION_TABLE_GROUP_LENGTH ] );
+
+        matches = MatchGroup( pGroupTags, tag );
+
+        while( ( matches != 0U ) && ( done == 0 ) )
+        {
+            slotIndex = ( group * STUN_TRANSACTION_TABLE_GROUP_LENGTH ) + CountTrailingZeros( matches );
+            matches &= matches - 1U;
+
+            isMatch = ReadSlot( &( pTable->pSlots[ slotIndex ] ), &( words[ 0 ] ), &( sequence ), &( pUserData ) );
+
+            STUN_TRANSACTION_TABLE_HOOK();
+
+            if( isMatch == 0 )
+            {
+                /* Tag collision. */
+            }
+            else if( takeSlot == 0U )
+            {
+                /* Check that the slot was not removed, or removed and
+                 * reused, during the read. */
+                if( ( STUN_LOAD_ACQUIRE( &( pTable->pTags[ slotIndex ] ) ) == tag ) &&
+                    ( STUN_LOAD_RELAXED( &( pTable->pSlots[ slotIndex ].sequence ) ) == sequence ) )
+                {
+                    result = STUN_RESULT_OK;
+                    done = 1;
+                }
+            }
+            else
+            {
+                expectedTag = tag;
+
+                if( STUN_CAS( &( pTable->pTags[ slotIndex ] ), &( expectedTag ), STUN_TRANSACTION_TAG_BUSY ) != 0 )
+                {
+                    /* The slot can be reused between ReadSlot and the compare
+                     * and swap, in which case the sequence number changed. */
+                    if( STUN_LOAD_RELAXED( &( pTable->pSlots[ slotIndex ].sequence ) ) == sequence )
+                    {
+                        STUN_STORE_RELEASE( &( pTable->pTags[ slotIndex ] ), STUN_TRANSACTION_TAG_EMPTY );
+                        ReleaseGroups( pTable, firstGroup, probe );
+                        result = STUN_RESULT_OK;
+                        done = 1;
+                    }
+                    else
+                    {
+                        STUN_STORE_RELEASE( &( pTable->pTags[ slotIndex ] ), tag );
+                    }
+                }
+            }
+        }
+
+        if( ( done == 0 ) && ( STUN_LOAD_RELAXED( &( pTable->pOverflowCounts[ group ] ) ) == 0U ) )
+        {
+            /* No transaction in the table went past this group. */
+            done = 1;
+        }
+
+        group = ( group + probe + 1 ) & groupMask;
+    }
+
+    if( ( result == STUN_RESULT_OK ) && ( ppUserData != NULL ) )
+    {
+        *ppUserData = pUserData;
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Returns 1 if the transaction was written to a free slot of the group. */
+static int TakeFreeSlot( const StunTransactionTable_t * pTable,
+                         size_t group,
+                         uint8_t tag,
+                         const uint32_t * pWords,
+                         void * pUserData )
+{
+    int taken = 0;
+    uint32_t freeSlots, sequence;
+    size_t slotIndex;
+    uint8_t expectedTag;
+    StunTransactionSlot_t * pSlot;
+
+    freeSlots = MatchGroup( &( pTable->pTags[ group * STUN_TRANSACTION_TABLE_GROUP_LENGTH ] ), STUN_TRANSACTION_TAG_EMPTY );
+
+    while( ( freeSlots != 0U ) && ( taken == 0 ) )
+    {
+        slotIndex = ( group * STUN_TRANSACTION_TABLE_GROUP_LENGTH ) + CountTrailingZeros( freeSlots );
+        freeSlots &= freeSlots - 1U;
+
+        STUN_TRANSACTION_TABLE_HOOK();
+        expectedTag = STUN_LOAD_RELAXED( &( pTable->pTags[ slotIndex ] ) );
+
+        if( expectedTag == STUN_TRANSACTION_TAG_EMPTY )
+        {
+            STUN_TRANSACTION_TABLE_HOOK();
+
+            if( STUN_CAS( &( pTable->pTags[ slotIndex ] ), &( expectedTag ), STUN_TRANSACTION_TAG_BUSY ) != 0 )
+            {
+                pSlot = &( pTable->pSlots[ slotIndex ] );
+                sequence = STUN_LOAD_RELAXED( &( pSlot->sequence ) );
+
+                STUN_STORE_RELAXED( &( pSlot->sequence ), sequence + 1U );
+                STUN_FENCE_RELEASE();
+
+                STUN_STORE_RELAXED( &( pSlot->transactionIdWords[ 0 ] ), pWords[ 0 ] );
+                STUN_STORE_RELAXED( &( pSlot->transactionIdWords[ 1 ] ), pWords[ 1 ] );
+                STUN_STORE_RELAXED( &( pSlot->transactionIdWords[ 2 ] ), pWords[ 2 ] );
+                STUN_STORE_RELAXED( &( pSlot->pUserData ), pUserData );
+
+                STUN_STORE_RELEASE( &( pSlot->sequence ), sequence + 2U );
+                STUN_STORE_RELEASE( &( pTable->pTags[ slotIndex ] ), tag );
+
+                taken = 1;
+            }
+        }
+    }
+
+    return taken;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunTransactionTable_Init( StunTransactionTable_t * pTable,
+                                        uint8_t * pTags,
+                                        StunTransactionSlot_t * pSlots,
+                                        uint32_t * pOverflowCounts,
+                                        size_t capacity,
+                                        uint64_t seed )
+{
+    StunResult_t result = STUN_RESULT_OK;
+
+    if( ( pTable == NULL ) ||
+        ( pTags == NULL ) ||
+        ( pSlots == NULL ) ||
+        ( pOverflowCounts == NULL ) ||
+        ( capacity < STUN_TRANSACTION_TABLE_GROUP_LENGTH ) ||
+        ( ( capacity & ( capacity - 1 ) ) != 0 ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        ( void ) memset( pTags, STUN_TRANSACTION_TAG_EMPTY, capacity );
+        ( void ) memset( pSlots, 0, capacity * sizeof( StunTransactionSlot_t ) );
+        ( void ) memset( pOverflowCounts, 0, ( capacity / STUN_TRANSACTION_TABLE_GROUP_LENGTH ) * sizeof( uint32_t ) );
+
+        pTable->pTags = pTags;
+        pTable->pSlots = pSlots;
+        pTable->pOverflowCounts = pOverflowCounts;
+        pTable->capacity = capacity;
+        pTable->seed = seed;
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunTransactionTable_Insert( StunTransactionTable_t * pTable,
+                                          const uint8_t * pTransactionId,
+                                          void * pUserData )
+{
+    StunResult_t result = STUN_RESULT_OUT_OF_MEMORY;
+    uint32_t words[ STUN_TRANSACTION_ID_WORDS ];
+    size_t groupMask, firstGroup, group, probe;
+    uint8_t tag;
+
+    if( ( pTable == NULL ) ||
+        ( pTransactionId == NULL ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+    else
+    {
+        ( void ) memcpy( &( words[ 0 ] ), pTransactionId, STUN_HEADER_TRANSACTION_ID_LENGTH );
+
+        GetProbeStart( pTable, &( words[ 0 ] ), &( tag ), &( firstGroup ) );
+        groupMask = ( pTable->capacity / STUN_TRANSACTION_TABLE_GROUP_LENGTH ) - 1;
+        group = firstGroup;
+
+        for( probe = 0; ( probe <= groupMask ) && ( result != STUN_RESULT_OK ); probe++ )
+        {
+            if( TakeFreeSlot( pTable, group, tag, &( words[ 0 ] ), pUserData ) != 0 )
+            {
+                result = STUN_RESULT_OK;
+            }
+            else
+            {
+                /* The slot taken later is published with a release store, so
+                 * a lookup that can find the transaction sees the count. */
+                STUN_ADD_RELAXED( &( pTable->pOverflowCounts[ group ] ), 1U );
+            }
+
+            group = ( group + probe + 1 ) & groupMask;
+        }
+
+        if( result != STUN_RESULT_OK )
+        {
+            ReleaseGroups( pTable, firstGroup, groupMask + 1U );
+        }
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunTransactionTable_Lookup( const StunTransactionTable_t * pTable,
+                                          const uint8_t * pTransactionId,
+                                          void ** ppUserData )
+{
+    StunResult_t result = STUN_RESULT_OK;
+
+    if( ( pTable == NULL ) ||
+        ( pTransactionId == NULL ) ||
+        ( ppUserData == NULL ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        result = FindSlot( pTable, pTransactionId, 0U, ppUserData );
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunTransactionTable_Remove( StunTransactionTable_t * pTable,
+                                          const uint8_t * pTransactionId,
+                                          void ** ppUserData )
+{
+    StunResult_t result = STUN_RESULT_OK;
+
+    if( ( pTable == NULL ) ||
+        ( pTransactionId == NULL ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        result = FindSlot( pTable, pTransactionId, 1U, ppUserData );
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunTransactionTable_MatchResponse( StunTransactionTable_t * pTable,
+                                                 const StunHeader_t * pStunHeader,
+                                                 void ** ppUserData )
+{
+    StunResult_t result = STUN_RESULT_OK;
+
+    if( ( pTable == NULL ) ||
+        ( pStunHeader == NULL ) ||
+        ( pStunHeader->pTransactionId == NULL ) )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    if( result == STUN_RESULT_OK )
+    {
+        result = StunTransactionTable_Remove( pTable, pStunHeader->pTransactionId, ppUserData );
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+StunResult_t StunTransactionTable_Rebuild( StunTransactionTable_t * pTable )
+{
+    StunResult_t result = STUN_RESULT_OK;
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ], tag;
+    size_t slotIndex, firstGroup;
+    void * pUserData;
+
+    if( pTable == NULL )
+    {
+        result = STUN_RESULT_BAD_PARAM;
+    }
+
+    for( slotIndex = 0; ( result == STUN_RESULT_OK ) && ( slotIndex < pTable->capacity ); slotIndex++ )
+    {
+        if( ( pTable->pTags[ slotIndex ] & STUN_TRANSACTION_TAG_FULL_FLAG ) != 0U )
+        {
+            GetProbeStart( pTable, &( pTable->pSlots[ slotIndex ].transactionIdWords[ 0 ] ), &( tag ), &( firstGroup ) );
+
+            /* A transaction past its first group is inserted again, which
+             * moves it to the first free slot of its probe sequence. */
+            if( firstGroup != ( slotIndex / STUN_TRANSACTION_TABLE_GROUP_LENGTH ) )
+            {
+                ( void ) memcpy( &( transactionId[ 0 ] ), &( pTable->pSlots[ slotIndex ].transactionIdWords[ 0 ] ), STUN_HEADER_TRANSACTION_ID_LENGTH );
+
+                ( void ) FindSlot( pTable, &( transactionId[ 0 ] ), 1U, &( pUserData ) );
+                result = StunTransactionTable_Insert( pTable, &( transactionId[ 0 ] ), pUserData );
+            }
+        }
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
@@ -6,7 +6,18 @@
 set( STUN_SOURCES
      "${CMAKE_CURRENT_LIST_DIR}/source/stun_deserializer.c"
      "${CMAKE_CURRENT_LIST_DIR}/source/stun_serializer.c"
-     "${CMAKE_CURRENT_LIST_DIR}/source/stun_endianness.c" )
+     "${CMAKE_CURRENT_LIST_DIR}/source/stun_endianness.c"
+     "${CMAKE_CURRENT_LIST_DIR}/source/stun_classifier.c"
+     "${CMAKE_CURRENT_LIST_DIR}/source/stun_crc32.c"
+     "${CMAKE_CURRENT_LIST_DIR}/source/stun_sha1.c"
+     "${CMAKE_CURRENT_LIST_DIR}/source/stun_integrity.c"
+     "${CMAKE_CURRENT_LIST_DIR}/source/stun_md5.c"
+     "${CMAKE_CURRENT_LIST_DIR}/source/stun_credential_cache.c"
+     "${CMAKE_CURRENT_LIST_DIR}/source/stun_transaction_table.c"
+     "${CMAKE_CURRENT_LIST_DIR}/source/stun_stream_parser.c"
+     "${CMAKE_CURRENT_LIST_DIR}/source/stun_channel_data.c"
+     "${CMAKE_CURRENT_LIST_DIR}/source/stun_message_template.c"
+     "${CMAKE_CURRENT_LIST_DIR}/source/stun_response_batch.c" )
 
 # STUN library Public Include directories.
 set( STUN_INCLUDE_PUBLIC_DIRS
@@ -17,4 +28,15 @@ set( STUN_INCLUDE_PUBLIC_FILES
      "source/include/stun_data_types.h"
      "source/include/stun_endianness.h"
      "source/include/stun_deserializer.h"
-     "source/include/stun_serializer.h" )
+     "source/include/stun_serializer.h"
+     "source/include/stun_classifier.h"
+     "source/include/stun_crc32.h"
+     "source/include/stun_sha1.h"
+     "source/include/stun_integrity.h"
+     "source/include/stun_md5.h"
+     "source/include/stun_credential_cache.h"
+     "source/include/stun_transaction_table.h"
+     "source/include/stun_stream_parser.h"
+     "source/include/stun_channel_data.h"
+     "source/include/stun_message_template.h"
+     "source/include/stun_response_batch.h" )
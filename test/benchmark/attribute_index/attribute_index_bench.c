@@ -0,0 +1,122 @@
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* API includes. */
+#include "stun_serializer.h"
+#include "stun_deserializer.h"
+
+/* Benchmark includes. */
+#include "bench_utils.h"
+
+#define BENCH_ITERATIONS    5000000ULL
+
+/*
+ * Attribute lookups done by an ICE responder for every connectivity check:
+ * repeated StunDeserializer_FindAttribute calls against a single
+ * StunDeserializer_BuildIndex pass followed by constant time lookups.
+ */
+
+static const StunAttributeType_t lookups[] =
+{
+    STUN_ATTRIBUTE_TYPE_USERNAME,
+    STUN_ATTRIBUTE_TYPE_PRIORITY,
+    STUN_ATTRIBUTE_TYPE_ICE_CONTROLLING,
+    STUN_ATTRIBUTE_TYPE_USE_CANDIDATE,
+    STUN_ATTRIBUTE_TYPE_MESSAGE_INTEGRITY,
+    STUN_ATTRIBUTE_TYPE_FINGERPRINT,
+};
+
+#define NUM_LOOKUPS    ( sizeof( lookups ) / sizeof( lookups[ 0 ] ) )
+
+/*-----------------------------------------------------------*/
+
+static size_t BuildBindingRequest( uint8_t * pBuffer,
+                                   size_t bufferLength )
+{
+    StunContext_t ctx;
+    StunHeader_t header;
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] = { 0 };
+    uint8_t integrity[ STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH ] = { 0 };
+    const uint8_t username[] = "9e6f2bd4:a8c1f3e2";
+    size_t messageLength = 0;
+
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    ( void ) StunSerializer_Init( &( ctx ), pBuffer, bufferLength, &( header ) );
+    ( void ) StunSerializer_AddAttributeUsername( &( ctx ), &( username[ 0 ] ), ( uint16_t ) ( sizeof( username ) - 1 ) );
+    ( void ) StunSerializer_AddAttributePriority( &( ctx ), 0x6E7F1EFF );
+    ( void ) StunSerializer_AddAttributeIceControlling( &( ctx ), 0x932FF9B151263B36ULL );
+    ( void ) StunSerializer_AddAttributeUseCandidate( &( ctx ) );
+    ( void ) StunSerializer_AddAttributeIntegrity( &( ctx ), &( integrity[ 0 ] ), sizeof( integrity ) );
+    ( void ) StunSerializer_AddAttributeFingerprint( &( ctx ), 0x12345678 );
+    ( void ) StunSerializer_Finalize( &( ctx ), &( messageLength ) );
+
+    return messageLength;
+}
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    uint8_t request[ 256 ];
+    size_t requestLength, i;
+    StunContext_t ctx;
+    StunHeader_t header;
+    StunAttribute_t attribute;
+    StunAttributeIndex_t index;
+    uint64_t iteration, start, linearSum = 0, indexedSum = 0;
+
+    requestLength = BuildBindingRequest( &( request[ 0 ] ), sizeof( request ) );
+
+    start = Bench_NowNs();
+
+    for( iteration = 0; iteration < BENCH_ITERATIONS; iteration++ )
+    {
+        ( void ) StunDeserializer_Init( &( ctx ), &( request[ 0 ] ), requestLength, &( header ) );
+
+        for( i = 0; i < NUM_LOOKUPS; i++ )
+        {
+            if( StunDeserializer_FindAttribute( &( ctx ), lookups[ i ], &( attribute ) ) == STUN_RESULT_OK )
+            {
+                linearSum += attribute.attributeValueLength;
+            }
+        }
+
+        BENCH_CLOBBER();
+    }
+
+    Bench_Report( "6 x StunDeserializer_FindAttribute", Bench_NowNs() - start, BENCH_ITERATIONS );
+
+    start = Bench_NowNs();
+
+    for( iteration = 0; iteration < BENCH_ITERATIONS; iteration++ )
+    {
+        ( void ) StunDeserializer_Init( &( ctx ), &( request[ 0 ] ), requestLength, &( header ) );
+        ( void ) StunDeserializer_BuildIndex( &( ctx ), &( index ) );
+
+        for( i = 0; i < NUM_LOOKUPS; i++ )
+        {
+            if( StunDeserializer_FindAttributeInIndex( &( ctx ), &( index ), lookups[ i ], &( attribute ) ) == STUN_RESULT_OK )
+            {
+                indexedSum += attribute.attributeValueLength;
+            }
+        }
+
+        BENCH_CLOBBER();
+    }
+
+    Bench_Report( "BuildIndex + 6 x FindAttributeInIndex", Bench_NowNs() - start, BENCH_ITERATIONS );
+
+    if( linearSum != indexedSum )
+    {
+        printf( "Lookup results differ!\n" );
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*-----------------------------------------------------------*/
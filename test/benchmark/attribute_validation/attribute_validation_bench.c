@@ -0,0 +1,185 @@
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* API includes. */
+#include "stun_serializer.h"
+#include "stun_deserializer.h"
+
+/* Benchmark includes. */
+#include "bench_utils.h"
+
+#define BENCH_MESSAGE_COUNT        256
+#define BENCH_MESSAGE_STRIDE       512
+#define BENCH_ITERATIONS           20000ULL
+
+/*
+ * Attribute walk over a shuffled mix of the messages seen by an ICE agent with
+ * a TURN client: connectivity checks and their responses, TURN allocations,
+ * error responses and send indications. Every attribute goes through the
+ * length validation in StunDeserializer_GetNextAttribute. Branch misses are
+ * reported when the hardware counters are available.
+ */
+
+static const uint8_t username[] = "9e6f2bd4:a8c1f3e2";
+static const uint8_t realm[] = "example.org";
+static const uint8_t nonce[] = "f//499k954d6OL34oL9FSTvy64sA";
+static const uint8_t integrity[ STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH ] = { 0 };
+static const uint8_t payload[ 160 ] = { 0 };
+
+/*-----------------------------------------------------------*/
+
+static size_t BuildMessage( uint8_t * pBuffer,
+                            size_t bufferLength,
+                            uint32_t kind )
+{
+    StunContext_t ctx;
+    StunHeader_t header;
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ];
+    StunAttributeAddress_t ipv4Address = { STUN_ADDRESS_IPv4, 54321, { 192, 0, 2, 1 } };
+    StunAttributeAddress_t ipv6Address = { STUN_ADDRESS_IPv6, 54321, { 0x20, 0x01, 0x0D, 0xB8 } };
+    size_t messageLength = 0;
+
+    memset( &( transactionId[ 0 ] ), ( int ) kind, sizeof( transactionId ) );
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    switch( kind )
+    {
+        case 0:
+            header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+            ( void ) StunSerializer_Init( &( ctx ), pBuffer, bufferLength, &( header ) );
+            ( void ) StunSerializer_AddAttributeUsername( &( ctx ), &( username[ 0 ] ), ( uint16_t ) ( sizeof( username ) - 1 ) );
+            ( void ) StunSerializer_AddAttributePriority( &( ctx ), 0x6E7F1EFF );
+            ( void ) StunSerializer_AddAttributeIceControlling( &( ctx ), 0x932FF9B151263B36ULL );
+            ( void ) StunSerializer_AddAttributeUseCandidate( &( ctx ) );
+            break;
+
+        case 1:
+            header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+            ( void ) StunSerializer_Init( &( ctx ), pBuffer, bufferLength, &( header ) );
+            ( void ) StunSerializer_AddAttributeUsername( &( ctx ), &( username[ 0 ] ), ( uint16_t ) ( sizeof( username ) - 1 ) );
+            ( void ) StunSerializer_AddAttributePriority( &( ctx ), 0x6E7F1EFF );
+            ( void ) StunSerializer_AddAttributeIceControlled( &( ctx ), 0x932FF9B151263B36ULL );
+            break;
+
+        case 2:
+            header.messageType = STUN_MESSAGE_TYPE_BINDING_SUCCESS_RESPONSE;
+            ( void ) StunSerializer_Init( &( ctx ), pBuffer, bufferLength, &( header ) );
+            ( void ) StunSerializer_AddAttributeXorMappedAddress( &( ctx ), &( ipv4Address ) );
+            break;
+
+        case 3:
+            header.messageType = STUN_MESSAGE_TYPE_BINDING_SUCCESS_RESPONSE;
+            ( void ) StunSerializer_Init( &( ctx ), pBuffer, bufferLength, &( header ) );
+            ( void ) StunSerializer_AddAttributeXorMappedAddress( &( ctx ), &( ipv6Address ) );
+            break;
+
+        case 4:
+            header.messageType = STUN_MESSAGE_TYPE_ALLOCATE_REQUEST;
+            ( void ) StunSerializer_Init( &( ctx ), pBuffer, bufferLength, &( header ) );
+            ( void ) StunSerializer_AddAttributeRequestedTransport( &( ctx ), STUN_ATTRIBUTE_REQUESTED_TRANSPORT_UDP );
+            ( void ) StunSerializer_AddAttributeLifetime( &( ctx ), 600 );
+            ( void ) StunSerializer_AddAttributeUsername( &( ctx ), &( username[ 0 ] ), ( uint16_t ) ( sizeof( username ) - 1 ) );
+            ( void ) StunSerializer_AddAttributeRealm( &( ctx ), &( realm[ 0 ] ), ( uint16_t ) ( sizeof( realm ) - 1 ) );
+            ( void ) StunSerializer_AddAttributeNonce( &( ctx ), &( nonce[ 0 ] ), ( uint16_t ) ( sizeof( nonce ) - 1 ) );
+            break;
+
+        case 5:
+            header.messageType = STUN_MESSAGE_TYPE_ALLOCATE_ERROR_RESPONSE;
+            ( void ) StunSerializer_Init( &( ctx ), pBuffer, bufferLength, &( header ) );
+            ( void ) StunSerializer_AddAttributeErrorCode( &( ctx ), 401, ( const uint8_t * ) "Unauthorized", 12 );
+            ( void ) StunSerializer_AddAttributeRealm( &( ctx ), &( realm[ 0 ] ), ( uint16_t ) ( sizeof( realm ) - 1 ) );
+            ( void ) StunSerializer_AddAttributeNonce( &( ctx ), &( nonce[ 0 ] ), ( uint16_t ) ( sizeof( nonce ) - 1 ) );
+            break;
+
+        default:
+            header.messageType = STUN_MESSAGE_TYPE_SEND_INDICATION;
+            ( void ) StunSerializer_Init( &( ctx ), pBuffer, bufferLength, &( header ) );
+            ( void ) StunSerializer_AddAttributeXorPeerAddress( &( ctx ), &( ipv4Address ) );
+            ( void ) StunSerializer_AddAttributeDontFragment( &( ctx ) );
+            ( void ) StunSerializer_AddAttributeData( &( ctx ), &( payload[ 0 ] ), sizeof( payload ) );
+            break;
+    }
+
+    if( kind != 6 )
+    {
+        ( void ) StunSerializer_AddAttributeIntegrity( &( ctx ), &( integrity[ 0 ] ), sizeof( integrity ) );
+        ( void ) StunSerializer_AddAttributeFingerprint( &( ctx ), 0x12345678 );
+    }
+
+    ( void ) StunSerializer_Finalize( &( ctx ), &( messageLength ) );
+
+    return messageLength;
+}
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    static uint8_t messages[ BENCH_MESSAGE_COUNT ][ BENCH_MESSAGE_STRIDE ];
+    size_t messageLengths[ BENCH_MESSAGE_COUNT ];
+    StunContext_t ctx;
+    StunHeader_t header;
+    StunAttribute_t attribute;
+    StunResult_t result;
+    uint32_t random = 0x2545F491;
+    size_t i, attributeCount = 0;
+    uint64_t iteration, start, elapsed, branchMisses;
+    int counterFd;
+
+    /* Shuffle the kinds so that the order of the attribute types can not be
+     * learned by the branch predictor. */
+    for( i = 0; i < BENCH_MESSAGE_COUNT; i++ )
+    {
+        random = ( random * 1103515245U ) + 12345U;
+        messageLengths[ i ] = BuildMessage( &( messages[ i ][ 0 ] ), BENCH_MESSAGE_STRIDE, ( random >> 16 ) % 7U );
+    }
+
+    counterFd = Bench_BranchMissCounterOpen();
+    branchMisses = Bench_CounterRead( counterFd );
+    start = Bench_NowNs();
+
+    for( iteration = 0; iteration < BENCH_ITERATIONS; iteration++ )
+    {
+        for( i = 0; i < BENCH_MESSAGE_COUNT; i++ )
+        {
+            result = StunDeserializer_Init( &( ctx ), &( messages[ i ][ 0 ] ), messageLengths[ i ], &( header ) );
+
+            while( result == STUN_RESULT_OK )
+            {
+                result = StunDeserializer_GetNextAttribute( &( ctx ), &( attribute ) );
+                attributeCount += ( result == STUN_RESULT_OK ) ? 1U : 0U;
+            }
+
+            if( result != STUN_RESULT_NO_MORE_ATTRIBUTE_FOUND )
+            {
+                printf( "Unexpected result %d for message %zu\n", ( int ) result, i );
+                return EXIT_FAILURE;
+            }
+        }
+
+        BENCH_CLOBBER();
+    }
+
+    elapsed = Bench_NowNs() - start;
+    branchMisses = Bench_CounterRead( counterFd ) - branchMisses;
+
+    Bench_Report( "attribute walk (per attribute)", elapsed, attributeCount );
+
+    if( counterFd >= 0 )
+    {
+        printf( "%-48s %10.3f misses/attribute\n",
+                "branch misses",
+                ( double ) branchMisses / ( double ) attributeCount );
+        ( void ) close( counterFd );
+    }
+    else
+    {
+        printf( "%-48s %10s\n", "branch misses", "n/a" );
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*-----------------------------------------------------------*/
@@ -0,0 +1,126 @@
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* API includes. */
+#include "stun_serializer.h"
+#include "stun_deserializer.h"
+
+/* Benchmark includes. */
+#include "bench_utils.h"
+
+#define BENCH_BATCH_SIZE           64
+#define BENCH_DATAGRAM_STRIDE      2048
+#define BENCH_ITERATIONS           200000ULL
+
+/*
+ * Header validation of a recvmmsg sized batch of binding requests: one
+ * StunDeserializer_Init per datagram against one StunDeserializer_InitBatch
+ * call.
+ */
+
+/*-----------------------------------------------------------*/
+
+static size_t BuildBindingRequest( uint8_t * pBuffer,
+                                   size_t bufferLength,
+                                   uint8_t seed )
+{
+    StunContext_t ctx;
+    StunHeader_t header;
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ];
+    const uint8_t username[] = "9e6f2bd4:a8c1f3e2";
+    size_t messageLength = 0;
+
+    memset( &( transactionId[ 0 ] ), seed, sizeof( transactionId ) );
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    ( void ) StunSerializer_Init( &( ctx ), pBuffer, bufferLength, &( header ) );
+    ( void ) StunSerializer_AddAttributeUsername( &( ctx ), &( username[ 0 ] ), ( uint16_t ) ( sizeof( username ) - 1 ) );
+    ( void ) StunSerializer_AddAttributePriority( &( ctx ), 0x6E7F1EFF );
+    ( void ) StunSerializer_Finalize( &( ctx ), &( messageLength ) );
+
+    return messageLength;
+}
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    static uint8_t datagrams[ BENCH_BATCH_SIZE ][ BENCH_DATAGRAM_STRIDE ];
+    StunMessageBuffer_t messages[ BENCH_BATCH_SIZE ];
+    StunResult_t results[ BENCH_BATCH_SIZE ];
+    StunMessageType_t messageTypes[ BENCH_BATCH_SIZE ];
+    uint8_t * transactionIds[ BENCH_BATCH_SIZE ];
+    uint8_t * attributes[ BENCH_BATCH_SIZE ];
+    uint16_t attributesLengths[ BENCH_BATCH_SIZE ];
+    StunMessageBatch_t batch;
+    StunContext_t ctx;
+    StunHeader_t headers[ BENCH_BATCH_SIZE ];
+    size_t i, validCount, singleValid = 0, batchValid = 0;
+    uint64_t iteration, start;
+
+    for( i = 0; i < BENCH_BATCH_SIZE; i++ )
+    {
+        messages[ i ].pStunMessage = &( datagrams[ i ][ 0 ] );
+        messages[ i ].stunMessageLength = BuildBindingRequest( &( datagrams[ i ][ 0 ] ), BENCH_DATAGRAM_STRIDE, ( uint8_t ) i );
+    }
+
+    /* Every 8th datagram is not a valid STUN message. */
+    for( i = 0; i < BENCH_BATCH_SIZE; i += 8 )
+    {
+        datagrams[ i ][ STUN_HEADER_MAGIC_COOKIE_OFFSET ] = 0;
+    }
+
+    batch.pResults = &( results[ 0 ] );
+    batch.pMessageTypes = &( messageTypes[ 0 ] );
+    batch.ppTransactionIds = &( transactionIds[ 0 ] );
+    batch.ppAttributes = &( attributes[ 0 ] );
+    batch.pAttributesLengths = &( attributesLengths[ 0 ] );
+
+    start = Bench_NowNs();
+
+    for( iteration = 0; iteration < BENCH_ITERATIONS; iteration++ )
+    {
+        for( i = 0; i < BENCH_BATCH_SIZE; i++ )
+        {
+            if( StunDeserializer_Init( &( ctx ),
+                                       messages[ i ].pStunMessage,
+                                       messages[ i ].stunMessageLength,
+                                       &( headers[ i ] ) ) == STUN_RESULT_OK )
+            {
+                singleValid++;
+            }
+        }
+
+        BENCH_CLOBBER();
+    }
+
+    Bench_Report( "64 x StunDeserializer_Init (per datagram)",
+                  Bench_NowNs() - start,
+                  BENCH_ITERATIONS * BENCH_BATCH_SIZE );
+
+    start = Bench_NowNs();
+
+    for( iteration = 0; iteration < BENCH_ITERATIONS; iteration++ )
+    {
+        ( void ) StunDeserializer_InitBatch( &( messages[ 0 ] ), BENCH_BATCH_SIZE, &( batch ), &( validCount ) );
+        batchValid += validCount;
+        BENCH_CLOBBER();
+    }
+
+    Bench_Report( "StunDeserializer_InitBatch (per datagram)",
+                  Bench_NowNs() - start,
+                  BENCH_ITERATIONS * BENCH_BATCH_SIZE );
+
+    if( singleValid != batchValid )
+    {
+        printf( "Validation results differ!\n" );
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*-----------------------------------------------------------*/
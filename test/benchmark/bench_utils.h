@@ -0,0 +1,76 @@
+#ifndef BENCH_UTILS_H
+#define BENCH_UTILS_H
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+/* Prevent the compiler from optimizing away the benchmarked work. */
+#define BENCH_CLOBBER()    __asm__ volatile ( "" ::: "memory" )
+
+/*-----------------------------------------------------------*/
+
+static inline uint64_t Bench_NowNs( void )
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &( ts ) );
+
+    return ( ( uint64_t ) ts.tv_sec * 1000000000ULL ) + ( uint64_t ) ts.tv_nsec;
+}
+
+/*-----------------------------------------------------------*/
+
+static inline void Bench_Report( const char * pName,
+                                 uint64_t elapsedNs,
+                                 uint64_t iterations )
+{
+    double nsPerOp = ( double ) elapsedNs / ( double ) iterations;
+
+    printf( "%-48s %10.2f ns/op %12.0f ops/s\n",
+            pName,
+            nsPerOp,
+            1e9 / nsPerOp );
+}
+
+/*-----------------------------------------------------------*/
+
+/* Open a counter of the branch misses of the calling thread. Returns -1 if
+ * hardware counters are not available, e.g. in most virtual machines. */
+static inline int Bench_BranchMissCounterOpen( void )
+{
+    struct perf_event_attr attr;
+
+    memset( &( attr ), 0, sizeof( attr ) );
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof( attr );
+    attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    return ( int ) syscall( SYS_perf_event_open, &( attr ), 0, -1, -1, 0 );
+}
+
+/*-----------------------------------------------------------*/
+
+static inline uint64_t Bench_CounterRead( int counterFd )
+{
+    uint64_t count = 0;
+
+    if( ( counterFd < 0 ) ||
+        ( read( counterFd, &( count ), sizeof( count ) ) != ( ssize_t ) sizeof( count ) ) )
+    {
+        count = 0;
+    }
+
+    return count;
+}
+
+/*-----------------------------------------------------------*/
+
+#endif /* BENCH_UTILS_H */
@@ -0,0 +1,139 @@
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* API includes. */
+#include "stun_serializer.h"
+#include "stun_deserializer.h"
+
+/* Benchmark includes. */
+#include "bench_utils.h"
+
+#define BENCH_ITERATIONS    5000000ULL
+
+/*
+ * Binding-response path of an ICE agent: parse an incoming connectivity check
+ * and build the success response with XOR-MAPPED-ADDRESS, MESSAGE-INTEGRITY and
+ * FINGERPRINT. The HMAC and CRC values are constants so that only the codec is
+ * measured.
+ */
+
+static uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] =
+{
+    0xB7, 0xE7, 0xA7, 0x01, 0xBC, 0x34, 0xD6, 0x86, 0xFA, 0x87, 0xDF, 0xAE
+};
+
+static const uint8_t username[] = "9e6f2bd4:a8c1f3e2";
+static const uint8_t integrity[ STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH ] = { 0 };
+
+/*-----------------------------------------------------------*/
+
+static size_t BuildBindingRequest( uint8_t * pBuffer,
+                                   size_t bufferLength )
+{
+    StunContext_t ctx;
+    StunHeader_t header;
+    size_t messageLength = 0;
+
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    ( void ) StunSerializer_Init( &( ctx ), pBuffer, bufferLength, &( header ) );
+    ( void ) StunSerializer_AddAttributeUsername( &( ctx ), &( username[ 0 ] ), ( uint16_t ) ( sizeof( username ) - 1 ) );
+    ( void ) StunSerializer_AddAttributePriority( &( ctx ), 0x6E7F1EFF );
+    ( void ) StunSerializer_AddAttributeIceControlling( &( ctx ), 0x932FF9B151263B36ULL );
+    ( void ) StunSerializer_AddAttributeUseCandidate( &( ctx ) );
+    ( void ) StunSerializer_AddAttributeIntegrity( &( ctx ), &( integrity[ 0 ] ), sizeof( integrity ) );
+    ( void ) StunSerializer_AddAttributeFingerprint( &( ctx ), 0x12345678 );
+    ( void ) StunSerializer_Finalize( &( ctx ), &( messageLength ) );
+
+    return messageLength;
+}
+
+/*-----------------------------------------------------------*/
+
+static size_t HandleBindingRequest( uint8_t * pRequest,
+                                    size_t requestLength,
+                                    uint8_t * pResponse,
+                                    size_t responseLength )
+{
+    StunContext_t ctx;
+    StunHeader_t header;
+    StunAttribute_t attribute;
+    StunAttributeAddress_t mappedAddress = { STUN_ADDRESS_IPv4, 54321, { 192, 0, 2, 1 } };
+    StunResult_t result;
+    uint32_t priority = 0;
+    uint64_t tieBreaker = 0;
+    uint8_t * pHmacInput;
+    uint16_t hmacInputLength;
+    size_t messageLength = 0;
+
+    result = StunDeserializer_Init( &( ctx ), pRequest, requestLength, &( header ) );
+
+    while( result == STUN_RESULT_OK )
+    {
+        result = StunDeserializer_GetNextAttribute( &( ctx ), &( attribute ) );
+
+        if( result == STUN_RESULT_OK )
+        {
+            if( attribute.attributeType == STUN_ATTRIBUTE_TYPE_PRIORITY )
+            {
+                ( void ) StunDeserializer_ParseAttributePriority( &( ctx ), &( attribute ), &( priority ) );
+            }
+            else if( attribute.attributeType == STUN_ATTRIBUTE_TYPE_ICE_CONTROLLING )
+            {
+                ( void ) StunDeserializer_ParseAttributeIceControlling( &( ctx ), &( attribute ), &( tieBreaker ) );
+            }
+        }
+    }
+
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_SUCCESS_RESPONSE;
+    ( void ) StunSerializer_Init( &( ctx ), pResponse, responseLength, &( header ) );
+    ( void ) StunSerializer_AddAttributeXorMappedAddress( &( ctx ), &( mappedAddress ) );
+    ( void ) StunSerializer_GetIntegrityBuffer( &( ctx ), &( pHmacInput ), &( hmacInputLength ) );
+    ( void ) StunSerializer_AddAttributeIntegrity( &( ctx ), &( integrity[ 0 ] ), sizeof( integrity ) );
+    ( void ) StunSerializer_GetFingerprintBuffer( &( ctx ), &( pHmacInput ), &( hmacInputLength ) );
+    ( void ) StunSerializer_AddAttributeFingerprint( &( ctx ), ( uint32_t ) ( priority ^ tieBreaker ) );
+    ( void ) StunSerializer_Finalize( &( ctx ), &( messageLength ) );
+
+    return messageLength;
+}
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    uint8_t request[ 256 ];
+    uint8_t response[ 256 ];
+    size_t requestLength, responseLength = 0;
+    uint64_t i, start, elapsed;
+
+    requestLength = BuildBindingRequest( &( request[ 0 ] ), sizeof( request ) );
+
+    start = Bench_NowNs();
+
+    for( i = 0; i < BENCH_ITERATIONS; i++ )
+    {
+        responseLength += HandleBindingRequest( &( request[ 0 ] ), requestLength, &( response[ 0 ] ), sizeof( response ) );
+        BENCH_CLOBBER();
+    }
+
+    elapsed = Bench_NowNs() - start;
+
+    if( responseLength != ( BENCH_ITERATIONS * 64U ) )
+    {
+        printf( "Unexpected response length: %zu\n", responseLength );
+        return EXIT_FAILURE;
+    }
+
+    #if defined( STUN_BENCH_INLINE )
+        Bench_Report( "binding request -> response (inline)", elapsed, BENCH_ITERATIONS );
+    #else
+        Bench_Report( "binding request -> response (table)", elapsed, BENCH_ITERATIONS );
+    #endif
+
+    return EXIT_SUCCESS;
+}
+
+/*-----------------------------------------------------------*/
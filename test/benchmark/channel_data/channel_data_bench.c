@@ -0,0 +1,180 @@
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* API includes. */
+#include "stun_channel_data.h"
+
+/* Benchmark includes. */
+#include "bench_utils.h"
+
+#define BENCH_ITERATIONS        200000ULL
+
+/* Packets per recvmmsg/sendmmsg call. */
+#define BENCH_BATCH_LENGTH      32
+
+/* Video RTP packet relayed through TURN. */
+#define BENCH_PAYLOAD_LENGTH    1200
+
+#define BENCH_PACKET_LENGTH     ( STUN_CHANNEL_DATA_HEADER_LENGTH + BENCH_PAYLOAD_LENGTH + 4 )
+
+/*
+ * TURN relay traffic. The reference builds every ChannelData message by
+ * copying the application data after a header in a separate send buffer, and
+ * copies the application data out of every received message. The ChannelData
+ * API writes the header in the headroom before the application data and
+ * parses the received messages in place.
+ */
+
+static uint8_t packets[ BENCH_BATCH_LENGTH ][ BENCH_PACKET_LENGTH ];
+static uint8_t copies[ BENCH_BATCH_LENGTH ][ BENCH_PACKET_LENGTH ];
+
+/*-----------------------------------------------------------*/
+
+static size_t EncodeWithCopy( uint16_t channelNumber,
+                              const uint8_t * pData,
+                              uint16_t dataLength,
+                              uint8_t * pSendBuffer )
+{
+    pSendBuffer[ 0 ] = ( uint8_t ) ( channelNumber >> 8 );
+    pSendBuffer[ 1 ] = ( uint8_t ) channelNumber;
+    pSendBuffer[ 2 ] = ( uint8_t ) ( dataLength >> 8 );
+    pSendBuffer[ 3 ] = ( uint8_t ) dataLength;
+    memcpy( &( pSendBuffer[ STUN_CHANNEL_DATA_HEADER_LENGTH ] ), pData, dataLength );
+
+    return STUN_CHANNEL_DATA_HEADER_LENGTH + ( size_t ) dataLength;
+}
+
+/*-----------------------------------------------------------*/
+
+static size_t DecodeWithCopy( const uint8_t * pPacket,
+                              size_t packetLength,
+                              uint8_t * pData )
+{
+    size_t dataLength = ( ( size_t ) pPacket[ 2 ] << 8 ) | pPacket[ 3 ];
+
+    if( ( packetLength < STUN_CHANNEL_DATA_HEADER_LENGTH ) ||
+        ( dataLength > ( packetLength - STUN_CHANNEL_DATA_HEADER_LENGTH ) ) )
+    {
+        dataLength = 0;
+    }
+    else
+    {
+        memcpy( pData, &( pPacket[ STUN_CHANNEL_DATA_HEADER_LENGTH ] ), dataLength );
+    }
+
+    return dataLength;
+}
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    StunChannelData_t channelData[ BENCH_BATCH_LENGTH ], decoded[ BENCH_BATCH_LENGTH ];
+    StunMessageBuffer_t encoded[ BENCH_BATCH_LENGTH ];
+    StunResult_t results[ BENCH_BATCH_LENGTH ];
+    size_t i, length = 0, validCount = 0;
+    uint64_t iteration, start;
+
+    for( i = 0; i < BENCH_BATCH_LENGTH; i++ )
+    {
+        memset( &( packets[ i ][ STUN_CHANNEL_DATA_HEADER_LENGTH ] ), ( int ) i, BENCH_PAYLOAD_LENGTH );
+        channelData[ i ].channelNumber = ( uint16_t ) ( STUN_CHANNEL_NUMBER_MIN + i );
+        channelData[ i ].pData = &( packets[ i ][ STUN_CHANNEL_DATA_HEADER_LENGTH ] );
+        channelData[ i ].dataLength = BENCH_PAYLOAD_LENGTH;
+    }
+
+    /* Send side. */
+    start = Bench_NowNs();
+
+    for( iteration = 0; iteration < BENCH_ITERATIONS; iteration++ )
+    {
+        for( i = 0; i < BENCH_BATCH_LENGTH; i++ )
+        {
+            length += EncodeWithCopy( channelData[ i ].channelNumber,
+                                      channelData[ i ].pData,
+                                      channelData[ i ].dataLength,
+                                      &( copies[ i ][ 0 ] ) );
+        }
+
+        BENCH_CLOBBER();
+    }
+
+    Bench_Report( "ChannelData encode, copy into send buffer", Bench_NowNs() - start, BENCH_ITERATIONS * BENCH_BATCH_LENGTH );
+
+    start = Bench_NowNs();
+
+    for( iteration = 0; iteration < BENCH_ITERATIONS; iteration++ )
+    {
+        for( i = 0; i < BENCH_BATCH_LENGTH; i++ )
+        {
+            ( void ) StunChannelData_Encode( &( channelData[ i ] ), 0, &( encoded[ i ] ) );
+        }
+
+        BENCH_CLOBBER();
+    }
+
+    Bench_Report( "ChannelData encode, in place", Bench_NowNs() - start, BENCH_ITERATIONS * BENCH_BATCH_LENGTH );
+
+    start = Bench_NowNs();
+
+    for( iteration = 0; iteration < BENCH_ITERATIONS; iteration++ )
+    {
+        ( void ) StunChannelData_EncodeBatch( &( channelData[ 0 ] ), BENCH_BATCH_LENGTH, 0, &( encoded[ 0 ] ) );
+        BENCH_CLOBBER();
+    }
+
+    Bench_Report( "ChannelData encode, in place batch", Bench_NowNs() - start, BENCH_ITERATIONS * BENCH_BATCH_LENGTH );
+
+    /* Receive side. */
+    start = Bench_NowNs();
+
+    for( iteration = 0; iteration < BENCH_ITERATIONS; iteration++ )
+    {
+        for( i = 0; i < BENCH_BATCH_LENGTH; i++ )
+        {
+            length += DecodeWithCopy( encoded[ i ].pStunMessage, encoded[ i ].stunMessageLength, &( copies[ i ][ 0 ] ) );
+        }
+
+        BENCH_CLOBBER();
+    }
+
+    Bench_Report( "ChannelData decode, copy out", Bench_NowNs() - start, BENCH_ITERATIONS * BENCH_BATCH_LENGTH );
+
+    start = Bench_NowNs();
+
+    for( iteration = 0; iteration < BENCH_ITERATIONS; iteration++ )
+    {
+        for( i = 0; i < BENCH_BATCH_LENGTH; i++ )
+        {
+            ( void ) StunChannelData_Decode( encoded[ i ].pStunMessage, encoded[ i ].stunMessageLength, &( decoded[ i ] ) );
+        }
+
+        BENCH_CLOBBER();
+    }
+
+    Bench_Report( "ChannelData decode, in place", Bench_NowNs() - start, BENCH_ITERATIONS * BENCH_BATCH_LENGTH );
+
+    start = Bench_NowNs();
+
+    for( iteration = 0; iteration < BENCH_ITERATIONS; iteration++ )
+    {
+        ( void ) StunChannelData_DecodeBatch( &( encoded[ 0 ] ), BENCH_BATCH_LENGTH, &( decoded[ 0 ] ), &( results[ 0 ] ), &( validCount ) );
+        BENCH_CLOBBER();
+    }
+
+    Bench_Report( "ChannelData decode, in place batch", Bench_NowNs() - start, BENCH_ITERATIONS * BENCH_BATCH_LENGTH );
+
+    if( ( length == 0 ) ||
+        ( validCount != BENCH_BATCH_LENGTH ) ||
+        ( decoded[ 5 ].pData != channelData[ 5 ].pData ) )
+    {
+        printf( "ChannelData mismatch!\n" );
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*-----------------------------------------------------------*/
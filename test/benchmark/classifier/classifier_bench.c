@@ -0,0 +1,182 @@
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* API includes. */
+#include "stun_serializer.h"
+#include "stun_deserializer.h"
+#include "stun_classifier.h"
+
+/* Benchmark includes. */
+#include "bench_utils.h"
+
+#define BENCH_BATCH_SIZE           64
+#define BENCH_DATAGRAM_STRIDE      1500
+#define BENCH_ITERATIONS           200000ULL
+
+/*
+ * Demultiplexing of a recvmmsg sized batch of mixed traffic received on one
+ * port: mostly SRTP, with some DTLS, TURN ChannelData and STUN. Calling
+ * StunDeserializer_Init on every datagram to find the STUN messages is
+ * compared against the scalar and batch classifiers.
+ */
+
+/*-----------------------------------------------------------*/
+
+static size_t BuildBindingRequest( uint8_t * pBuffer,
+                                   size_t bufferLength,
+                                   uint8_t seed )
+{
+    StunContext_t ctx;
+    StunHeader_t header;
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ];
+    const uint8_t username[] = "9e6f2bd4:a8c1f3e2";
+    size_t messageLength = 0;
+
+    memset( &( transactionId[ 0 ] ), seed, sizeof( transactionId ) );
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    ( void ) StunSerializer_Init( &( ctx ), pBuffer, bufferLength, &( header ) );
+    ( void ) StunSerializer_AddAttributeUsername( &( ctx ), &( username[ 0 ] ), ( uint16_t ) ( sizeof( username ) - 1 ) );
+    ( void ) StunSerializer_AddAttributePriority( &( ctx ), 0x6E7F1EFF );
+    ( void ) StunSerializer_Finalize( &( ctx ), &( messageLength ) );
+
+    return messageLength;
+}
+
+/*-----------------------------------------------------------*/
+
+static size_t BuildDatagram( uint8_t * pBuffer,
+                             size_t bufferLength,
+                             size_t index )
+{
+    size_t length;
+
+    /* Fill with bytes that look random to the classifier. */
+    for( length = 0; length < bufferLength; length++ )
+    {
+        pBuffer[ length ] = ( uint8_t ) ( ( length * 131U ) + ( index * 7U ) );
+    }
+
+    switch( index % 16 )
+    {
+        case 0:
+        case 9:
+            length = BuildBindingRequest( pBuffer, bufferLength, ( uint8_t ) index );
+            break;
+
+        case 4:
+            /* DTLS 1.2 application data record. */
+            pBuffer[ 0 ] = 0x17;
+            length = 200;
+            break;
+
+        case 12:
+            /* TURN ChannelData. */
+            pBuffer[ 0 ] = 0x40;
+            pBuffer[ 1 ] = 0x01;
+            length = 164;
+            break;
+
+        default:
+            /* SRTP with payload type 111. */
+            pBuffer[ 0 ] = 0x80;
+            pBuffer[ 1 ] = 0x6F;
+            length = 1200;
+            break;
+    }
+
+    return length;
+}
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    static uint8_t datagrams[ BENCH_BATCH_SIZE ][ BENCH_DATAGRAM_STRIDE ];
+    StunMessageBuffer_t packets[ BENCH_BATCH_SIZE ];
+    uint8_t packetTypes[ BENCH_BATCH_SIZE ];
+    StunContext_t ctx;
+    StunHeader_t header;
+    size_t i, initCount = 0, scalarCount = 0, batchCount = 0;
+    uint64_t iteration, start;
+
+    for( i = 0; i < BENCH_BATCH_SIZE; i++ )
+    {
+        packets[ i ].pStunMessage = &( datagrams[ i ][ 0 ] );
+        packets[ i ].stunMessageLength = BuildDatagram( &( datagrams[ i ][ 0 ] ), BENCH_DATAGRAM_STRIDE, i );
+    }
+
+    start = Bench_NowNs();
+
+    for( iteration = 0; iteration < BENCH_ITERATIONS; iteration++ )
+    {
+        for( i = 0; i < BENCH_BATCH_SIZE; i++ )
+        {
+            if( StunDeserializer_Init( &( ctx ),
+                                       packets[ i ].pStunMessage,
+                                       packets[ i ].stunMessageLength,
+                                       &( header ) ) == STUN_RESULT_OK )
+            {
+                initCount++;
+            }
+        }
+
+        BENCH_CLOBBER();
+    }
+
+    Bench_Report( "StunDeserializer_Init (per datagram)",
+                  Bench_NowNs() - start,
+                  BENCH_ITERATIONS * BENCH_BATCH_SIZE );
+
+    start = Bench_NowNs();
+
+    for( iteration = 0; iteration < BENCH_ITERATIONS; iteration++ )
+    {
+        for( i = 0; i < BENCH_BATCH_SIZE; i++ )
+        {
+            if( StunClassifier_ClassifyPacket( packets[ i ].pStunMessage,
+                                               packets[ i ].stunMessageLength ) == STUN_PACKET_TYPE_STUN )
+            {
+                scalarCount++;
+            }
+        }
+
+        BENCH_CLOBBER();
+    }
+
+    Bench_Report( "StunClassifier_ClassifyPacket (per datagram)",
+                  Bench_NowNs() - start,
+                  BENCH_ITERATIONS * BENCH_BATCH_SIZE );
+
+    start = Bench_NowNs();
+
+    for( iteration = 0; iteration < BENCH_ITERATIONS; iteration++ )
+    {
+        ( void ) StunClassifier_ClassifyBatch( &( packets[ 0 ] ), BENCH_BATCH_SIZE, &( packetTypes[ 0 ] ) );
+
+        for( i = 0; i < BENCH_BATCH_SIZE; i++ )
+        {
+            batchCount += ( packetTypes[ i ] == STUN_PACKET_TYPE_STUN ) ? 1U : 0U;
+        }
+
+        BENCH_CLOBBER();
+    }
+
+    Bench_Report( "StunClassifier_ClassifyBatch (per datagram)",
+                  Bench_NowNs() - start,
+                  BENCH_ITERATIONS * BENCH_BATCH_SIZE );
+
+    if( ( initCount != scalarCount ) ||
+        ( initCount != batchCount ) )
+    {
+        printf( "Classification results differ!\n" );
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*-----------------------------------------------------------*/
@@ -0,0 +1,116 @@
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* API includes. */
+#include "stun_crc32.h"
+
+/* Benchmark includes. */
+#include "bench_utils.h"
+
+#define BENCH_BYTES_PER_LENGTH     200000000ULL
+
+/*
+ * CRC-32 over the sizes of the buffers covered by FINGERPRINT: a binding
+ * request, the RFC 5769 sample request, a TURN send indication and a full MTU.
+ * A bytewise table implementation, which is what most callers used before
+ * Stun_Crc32, is the reference.
+ */
+
+static uint32_t bytewiseTable[ 256 ];
+
+/*-----------------------------------------------------------*/
+
+static void BytewiseInit( void )
+{
+    uint32_t i, j, crc;
+
+    for( i = 0; i < 256; i++ )
+    {
+        crc = i;
+
+        for( j = 0; j < 8; j++ )
+        {
+            crc = ( crc >> 1 ) ^ ( ( crc & 1U ) != 0 ? 0xEDB88320U : 0U );
+        }
+
+        bytewiseTable[ i ] = crc;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+static uint32_t BytewiseCrc32( const uint8_t * pBuffer,
+                               size_t bufferLength )
+{
+    uint32_t crc = 0xFFFFFFFFU;
+    size_t i;
+
+    for( i = 0; i < bufferLength; i++ )
+    {
+        crc = bytewiseTable[ ( crc ^ pBuffer[ i ] ) & 0xFF ] ^ ( crc >> 8 );
+    }
+
+    return ~crc;
+}
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    static uint8_t buffer[ 1500 ];
+    const size_t lengths[] = { 80, 100, 548, 1280 };
+    char name[ 64 ];
+    size_t i, lengthIndex;
+    uint64_t iteration, iterations, start;
+    uint32_t bytewiseCrc = 0, crc = 0;
+
+    BytewiseInit();
+
+    for( i = 0; i < sizeof( buffer ); i++ )
+    {
+        buffer[ i ] = ( uint8_t ) ( ( i * 131U ) + 17U );
+    }
+
+    for( lengthIndex = 0; lengthIndex < sizeof( lengths ) / sizeof( lengths[ 0 ] ); lengthIndex++ )
+    {
+        iterations = BENCH_BYTES_PER_LENGTH / lengths[ lengthIndex ];
+
+        start = Bench_NowNs();
+
+        for( iteration = 0; iteration < iterations; iteration++ )
+        {
+            bytewiseCrc ^= BytewiseCrc32( &( buffer[ 0 ] ), lengths[ lengthIndex ] );
+            BENCH_CLOBBER();
+        }
+
+        snprintf( name, sizeof( name ), "bytewise, %zu bytes", lengths[ lengthIndex ] );
+        Bench_Report( name, Bench_NowNs() - start, iterations );
+
+        start = Bench_NowNs();
+
+        for( iteration = 0; iteration < iterations; iteration++ )
+        {
+            crc ^= Stun_Crc32( 0, &( buffer[ 0 ] ), lengths[ lengthIndex ] );
+            BENCH_CLOBBER();
+        }
+
+        #if defined( STUN_BENCH_PORTABLE )
+            snprintf( name, sizeof( name ), "Stun_Crc32 (portable), %zu bytes", lengths[ lengthIndex ] );
+        #else
+            snprintf( name, sizeof( name ), "Stun_Crc32, %zu bytes", lengths[ lengthIndex ] );
+        #endif
+        Bench_Report( name, Bench_NowNs() - start, iterations );
+
+        if( bytewiseCrc != crc )
+        {
+            printf( "CRC mismatch!\n" );
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*-----------------------------------------------------------*/
@@ -0,0 +1,178 @@
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* API includes. */
+#include "stun_serializer.h"
+#include "stun_credential_cache.h"
+
+/* Benchmark includes. */
+#include "bench_utils.h"
+
+#define BENCH_ITERATIONS     2000000ULL
+
+/* Number of TURN servers (i.e. credentials) the client talks to. */
+#define BENCH_CREDENTIAL_COUNT      4
+
+/*
+ * TURN Refresh and CreatePermission requests with long-term credentials, as
+ * built by a TURN client. The reference derives MD5( username:realm:password )
+ * and the HMAC state for every request. The cached variant looks the key up in
+ * a StunCredentialCache_t instead.
+ */
+
+static const uint8_t username[] = "1700000000:kvs-webrtc-client";
+static const uint8_t realm[ BENCH_CREDENTIAL_COUNT ][ 48 ] =
+{
+    "turn-0.kinesisvideo.amazonaws.com",
+    "turn-1.kinesisvideo.amazonaws.com",
+    "turn-2.kinesisvideo.amazonaws.com",
+    "turn-3.kinesisvideo.amazonaws.com"
+};
+static const uint8_t password[] = "dGhpcyBpcyBhIHR1cm4gcGFzc3dvcmQ";
+static const uint8_t nonce[] = "f//499k954d6OL34oL9FSTvy64sA";
+
+/*-----------------------------------------------------------*/
+
+static size_t BuildRequest( uint8_t * pBuffer,
+                            size_t bufferLength,
+                            StunMessageType_t messageType,
+                            const uint8_t * pRealm,
+                            const StunIntegrityKey_t * pIntegrityKey )
+{
+    StunContext_t ctx;
+    StunHeader_t header = { 0 };
+    StunAttributeAddress_t peerAddress = { 0 };
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] =
+    {
+        0x78, 0xAD, 0x34, 0x33, 0xC6, 0xAD, 0x72, 0xC0, 0x29, 0xDA, 0x41, 0x2E
+    };
+    size_t stunMessageLength = 0;
+
+    header.messageType = messageType;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    ( void ) StunSerializer_Init( &( ctx ), pBuffer, bufferLength, &( header ) );
+
+    if( messageType == STUN_MESSAGE_TYPE_REFRESH_REQUEST )
+    {
+        ( void ) StunSerializer_AddAttributeLifetime( &( ctx ), 600 );
+    }
+    else
+    {
+        peerAddress.family = STUN_ADDRESS_IPv4;
+        peerAddress.port = 50000;
+        memcpy( &( peerAddress.address[ 0 ] ), "\xC0\xA8\x01\x02", 4 );
+        ( void ) StunSerializer_AddAttributeXorPeerAddress( &( ctx ), &( peerAddress ) );
+    }
+
+    ( void ) StunSerializer_AddAttributeUsername( &( ctx ), &( username[ 0 ] ), sizeof( username ) - 1 );
+    ( void ) StunSerializer_AddAttributeRealm( &( ctx ), pRealm, ( uint16_t ) strlen( ( const char * ) pRealm ) );
+    ( void ) StunSerializer_AddAttributeNonce( &( ctx ), &( nonce[ 0 ] ), sizeof( nonce ) - 1 );
+    ( void ) StunSerializer_AddComputedIntegrity( &( ctx ), pIntegrityKey );
+    ( void ) StunSerializer_Finalize( &( ctx ), &( stunMessageLength ) );
+
+    return stunMessageLength;
+}
+
+/*-----------------------------------------------------------*/
+
+static size_t BuildRequestWithoutCache( uint8_t * pBuffer,
+                                        size_t bufferLength,
+                                        StunMessageType_t messageType,
+                                        const uint8_t * pRealm )
+{
+    StunIntegrityKey_t integrityKey;
+    uint8_t longTermKey[ STUN_INTEGRITY_LONG_TERM_KEY_LENGTH ];
+
+    ( void ) StunIntegrity_DeriveLongTermKey( &( username[ 0 ] ), sizeof( username ) - 1,
+                                              pRealm, strlen( ( const char * ) pRealm ),
+                                              &( password[ 0 ] ), sizeof( password ) - 1,
+                                              &( longTermKey[ 0 ] ) );
+    ( void ) StunIntegrity_InitKey( &( integrityKey ), &( longTermKey[ 0 ] ), sizeof( longTermKey ), NULL );
+
+    return BuildRequest( pBuffer, bufferLength, messageType, pRealm, &( integrityKey ) );
+}
+
+/*-----------------------------------------------------------*/
+
+static size_t BuildRequestWithCache( StunCredentialCache_t * pCache,
+                                     uint8_t * pBuffer,
+                                     size_t bufferLength,
+                                     StunMessageType_t messageType,
+                                     const uint8_t * pRealm )
+{
+    const StunIntegrityKey_t * pIntegrityKey = NULL;
+    size_t stunMessageLength = 0;
+
+    if( StunCredentialCache_GetKey( pCache,
+                                    &( username[ 0 ] ), sizeof( username ) - 1,
+                                    pRealm, ( uint16_t ) strlen( ( const char * ) pRealm ),
+                                    &( password[ 0 ] ), sizeof( password ) - 1,
+                                    &( pIntegrityKey ) ) == STUN_RESULT_OK )
+    {
+        stunMessageLength = BuildRequest( pBuffer, bufferLength, messageType, pRealm, pIntegrityKey );
+    }
+
+    return stunMessageLength;
+}
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    static uint8_t buffer[ 256 ];
+    static uint8_t cachedBuffer[ 256 ];
+    static StunCredentialCacheEntry_t cacheEntries[ 16 ];
+    StunCredentialCache_t cache;
+    const StunMessageType_t messageTypes[] = { STUN_MESSAGE_TYPE_REFRESH_REQUEST, STUN_MESSAGE_TYPE_CREATE_PERMISSION_REQUEST };
+    const char * pNames[] = { "Refresh", "CreatePermission" };
+    char name[ 64 ];
+    size_t typeIndex, length = 0, cachedLength = 0;
+    uint64_t iteration, start;
+
+    ( void ) StunCredentialCache_Init( &( cache ), &( cacheEntries[ 0 ] ), sizeof( cacheEntries ) / sizeof( cacheEntries[ 0 ] ) );
+
+    for( typeIndex = 0; typeIndex < sizeof( messageTypes ) / sizeof( messageTypes[ 0 ] ); typeIndex++ )
+    {
+        start = Bench_NowNs();
+
+        for( iteration = 0; iteration < BENCH_ITERATIONS; iteration++ )
+        {
+            length = BuildRequestWithoutCache( &( buffer[ 0 ] ), sizeof( buffer ),
+                                               messageTypes[ typeIndex ],
+                                               &( realm[ iteration % BENCH_CREDENTIAL_COUNT ][ 0 ] ) );
+            BENCH_CLOBBER();
+        }
+
+        snprintf( name, sizeof( name ), "%s, key derived per request", pNames[ typeIndex ] );
+        Bench_Report( name, Bench_NowNs() - start, BENCH_ITERATIONS );
+
+        start = Bench_NowNs();
+
+        for( iteration = 0; iteration < BENCH_ITERATIONS; iteration++ )
+        {
+            cachedLength = BuildRequestWithCache( &( cache ), &( cachedBuffer[ 0 ] ), sizeof( cachedBuffer ),
+                                                  messageTypes[ typeIndex ],
+                                                  &( realm[ iteration % BENCH_CREDENTIAL_COUNT ][ 0 ] ) );
+            BENCH_CLOBBER();
+        }
+
+        snprintf( name, sizeof( name ), "%s, credential cache", pNames[ typeIndex ] );
+        Bench_Report( name, Bench_NowNs() - start, BENCH_ITERATIONS );
+
+        /* The last iteration of both loops used the same realm. */
+        if( ( length == 0 ) ||
+            ( length != cachedLength ) ||
+            ( memcmp( &( buffer[ 0 ] ), &( cachedBuffer[ 0 ] ), length ) != 0 ) )
+        {
+            printf( "Request mismatch!\n" );
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*-----------------------------------------------------------*/
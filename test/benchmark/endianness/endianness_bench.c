@@ -0,0 +1,168 @@
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* API includes. */
+#include "stun_endianness.h"
+
+/* Benchmark includes. */
+#include "bench_utils.h"
+
+#define BENCH_BUFFER_LENGTH    4096
+#define BENCH_ROUNDS           200000ULL
+
+/*
+ * Compares the memcpy/builtin based read/write kernels in stun_endianness.c
+ * against the pointer cast kernels they replaced. The legacy kernels are kept
+ * here only as a reference and this file is built with -fno-strict-aliasing.
+ * Values are accessed at 4-byte aligned offsets, as attribute values are, so
+ * the 64-bit accesses are mostly not 8-byte aligned.
+ */
+
+#define LEGACY_SWAP_BYTES_16( value )    \
+    ( ( ( ( value ) >> 8 ) & 0xFF ) |    \
+      ( ( ( value ) & 0xFF ) << 8 ) )
+
+#define LEGACY_SWAP_BYTES_32( value )    \
+    ( ( ( ( value ) >> 24 ) & 0xFF ) |   \
+      ( ( ( value ) >> 8 ) & 0xFF00 ) |  \
+      ( ( ( value ) & 0xFF00 ) << 8 ) |  \
+      ( ( ( value ) & 0xFF ) << 24 ) )
+
+#define LEGACY_SWAP_BYTES_64( value )                     \
+    ( ( ( ( uint64_t ) ( value ) >> 56 ) & 0xFF ) |       \
+      ( ( ( uint64_t ) ( value ) >> 40 ) & 0xFF00 ) |     \
+      ( ( ( uint64_t ) ( value ) >> 24 ) & 0xFF0000 ) |   \
+      ( ( ( uint64_t ) ( value ) >> 8 ) & 0xFF000000 ) |  \
+      ( ( ( uint64_t ) ( value ) & 0xFF000000 ) << 8 ) |  \
+      ( ( ( uint64_t ) ( value ) & 0xFF0000 ) << 24 ) |   \
+      ( ( ( uint64_t ) ( value ) & 0xFF00 ) << 40 ) |     \
+      ( ( ( uint64_t ) ( value ) & 0xFF ) << 56 ) )
+
+static void LegacyWriteUint16( uint8_t * pDst,
+                               uint16_t val )
+{
+    *( ( uint16_t * ) ( pDst ) ) = LEGACY_SWAP_BYTES_16( val );
+}
+
+static void LegacyWriteUint32( uint8_t * pDst,
+                               uint32_t val )
+{
+    *( ( uint32_t * ) ( pDst ) ) = LEGACY_SWAP_BYTES_32( val );
+}
+
+static void LegacyWriteUint64( uint8_t * pDst,
+                               uint64_t val )
+{
+    *( ( uint64_t * ) ( pDst ) ) = LEGACY_SWAP_BYTES_64( val );
+}
+
+static uint16_t LegacyReadUint16( const uint8_t * pSrc )
+{
+    return LEGACY_SWAP_BYTES_16( *( ( uint16_t * ) ( pSrc ) ) );
+}
+
+static uint32_t LegacyReadUint32( const uint8_t * pSrc )
+{
+    return LEGACY_SWAP_BYTES_32( *( ( uint32_t * ) ( pSrc ) ) );
+}
+
+static uint64_t LegacyReadUint64( const uint8_t * pSrc )
+{
+    return LEGACY_SWAP_BYTES_64( *( ( uint64_t * ) ( pSrc ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+static uint64_t RunTable( const StunReadWriteFunctions_t * pFunctions,
+                          uint8_t * pBuffer )
+{
+    uint64_t round, sum = 0;
+    size_t offset;
+
+    for( round = 0; round < BENCH_ROUNDS; round++ )
+    {
+        for( offset = 0; offset + 12 <= BENCH_BUFFER_LENGTH; offset += 12 )
+        {
+            pFunctions->writeUint16Fn( &( pBuffer[ offset ] ), ( uint16_t ) offset );
+            pFunctions->writeUint64Fn( &( pBuffer[ offset + 4 ] ), round + offset );
+            sum += pFunctions->readUint16Fn( &( pBuffer[ offset ] ) );
+            sum += pFunctions->readUint32Fn( &( pBuffer[ offset + 4 ] ) );
+            sum += pFunctions->readUint64Fn( &( pBuffer[ offset + 4 ] ) );
+            pFunctions->writeUint32Fn( &( pBuffer[ offset + 8 ] ), ( uint32_t ) sum );
+        }
+
+        BENCH_CLOBBER();
+    }
+
+    return sum;
+}
+
+/*-----------------------------------------------------------*/
+
+static uint64_t RunInline( uint8_t * pBuffer )
+{
+    uint64_t round, sum = 0;
+    size_t offset;
+
+    for( round = 0; round < BENCH_ROUNDS; round++ )
+    {
+        for( offset = 0; offset + 12 <= BENCH_BUFFER_LENGTH; offset += 12 )
+        {
+            Stun_WriteUint16( &( pBuffer[ offset ] ), ( uint16_t ) offset );
+            Stun_WriteUint64( &( pBuffer[ offset + 4 ] ), round + offset );
+            sum += Stun_ReadUint16( &( pBuffer[ offset ] ) );
+            sum += Stun_ReadUint32( &( pBuffer[ offset + 4 ] ) );
+            sum += Stun_ReadUint64( &( pBuffer[ offset + 4 ] ) );
+            Stun_WriteUint32( &( pBuffer[ offset + 8 ] ), ( uint32_t ) sum );
+        }
+
+        BENCH_CLOBBER();
+    }
+
+    return sum;
+}
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    static uint8_t buffer[ BENCH_BUFFER_LENGTH ];
+    StunReadWriteFunctions_t legacy =
+    {
+        LegacyWriteUint16, LegacyWriteUint32, LegacyWriteUint64,
+        LegacyReadUint16,  LegacyReadUint32,  LegacyReadUint64
+    };
+    StunReadWriteFunctions_t current;
+    /* Keep the compiler from resolving the table at compile time, as it
+     * cannot in the library either. */
+    StunReadWriteFunctions_t * volatile pLegacy = &( legacy );
+    StunReadWriteFunctions_t * volatile pCurrent = &( current );
+    uint64_t start, legacySum, currentSum, inlineSum;
+    uint64_t operations = BENCH_ROUNDS * ( BENCH_BUFFER_LENGTH / 12 ) * 6U;
+
+    Stun_InitReadWriteFunctions( &( current ) );
+
+    start = Bench_NowNs();
+    legacySum = RunTable( pLegacy, &( buffer[ 0 ] ) );
+    Bench_Report( "pointer cast kernels (table)", Bench_NowNs() - start, operations );
+
+    start = Bench_NowNs();
+    currentSum = RunTable( pCurrent, &( buffer[ 0 ] ) );
+    Bench_Report( "memcpy/builtin kernels (table)", Bench_NowNs() - start, operations );
+
+    start = Bench_NowNs();
+    inlineSum = RunInline( &( buffer[ 0 ] ) );
+    Bench_Report( "memcpy/builtin kernels (inline)", Bench_NowNs() - start, operations );
+
+    if( ( legacySum != currentSum ) || ( currentSum != inlineSum ) )
+    {
+        printf( "Kernel results differ!\n" );
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*-----------------------------------------------------------*/
@@ -0,0 +1,168 @@
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* API includes. */
+#include "stun_serializer.h"
+#include "stun_deserializer.h"
+#include "stun_integrity.h"
+
+/* Benchmark includes. */
+#include "bench_utils.h"
+
+#define BENCH_ITERATIONS     2000000ULL
+
+/*
+ * MESSAGE-INTEGRITY over the sizes of a connectivity check and a TURN send
+ * indication. Deriving the HMAC ipad/opad state from the ICE password for every
+ * message, which is what callers did before StunIntegrityKey_t, is the
+ * reference. The last two cases sign and verify a complete binding request
+ * through the serializer and deserializer contexts.
+ */
+
+static const uint8_t password[] = "VOkJxbRl1RmTxUk/WvJxBt";
+
+/*-----------------------------------------------------------*/
+
+static size_t BuildBindingRequest( uint8_t * pBuffer,
+                                   size_t bufferLength,
+                                   const StunIntegrityKey_t * pIntegrityKey )
+{
+    StunContext_t ctx;
+    StunHeader_t header = { 0 };
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] =
+    {
+        0xB7, 0xE7, 0xA7, 0x01, 0xBC, 0x34, 0xD6, 0x86, 0xFA, 0x87, 0xDF, 0xAE
+    };
+    const uint8_t username[] = "evtj:h6vY";
+    size_t stunMessageLength = 0;
+
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    ( void ) StunSerializer_Init( &( ctx ), pBuffer, bufferLength, &( header ) );
+    ( void ) StunSerializer_AddAttributeUsername( &( ctx ), username, sizeof( username ) - 1 );
+    ( void ) StunSerializer_AddAttributePriority( &( ctx ), 0x6E0001FF );
+    ( void ) StunSerializer_AddAttributeIceControlled( &( ctx ), 0x932FF9B151263B36ULL );
+    ( void ) StunSerializer_AddComputedIntegrity( &( ctx ), pIntegrityKey );
+    ( void ) StunSerializer_AddComputedFingerprint( &( ctx ) );
+    ( void ) StunSerializer_Finalize( &( ctx ), &( stunMessageLength ) );
+
+    return stunMessageLength;
+}
+
+/*-----------------------------------------------------------*/
+
+static StunResult_t VerifyBindingRequest( uint8_t * pBuffer,
+                                          size_t bufferLength,
+                                          const StunIntegrityKey_t * pIntegrityKey )
+{
+    StunContext_t ctx;
+    StunHeader_t header;
+    StunAttribute_t attribute;
+    StunResult_t result;
+
+    result = StunDeserializer_Init( &( ctx ), pBuffer, bufferLength, &( header ) );
+
+    while( result == STUN_RESULT_OK )
+    {
+        result = StunDeserializer_GetNextAttribute( &( ctx ), &( attribute ) );
+
+        if( ( result == STUN_RESULT_OK ) &&
+            ( attribute.attributeType == STUN_ATTRIBUTE_TYPE_MESSAGE_INTEGRITY ) )
+        {
+            result = StunDeserializer_VerifyIntegrity( &( ctx ), &( attribute ), pIntegrityKey );
+            break;
+        }
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    static uint8_t buffer[ 1500 ];
+    static uint8_t message[ 256 ];
+    const size_t lengths[] = { 76, 524 };
+    char name[ 64 ];
+    size_t i, lengthIndex, messageLength;
+    uint64_t iteration, start;
+    uint8_t hmac[ STUN_SHA1_DIGEST_LENGTH ];
+    uint8_t precomputedHmac[ STUN_SHA1_DIGEST_LENGTH ];
+    StunIntegrityKey_t integrityKey, perMessageKey;
+
+    for( i = 0; i < sizeof( buffer ); i++ )
+    {
+        buffer[ i ] = ( uint8_t ) ( ( i * 131U ) + 17U );
+    }
+
+    ( void ) StunIntegrity_InitKey( &( integrityKey ), &( password[ 0 ] ), sizeof( password ) - 1, NULL );
+
+    for( lengthIndex = 0; lengthIndex < sizeof( lengths ) / sizeof( lengths[ 0 ] ); lengthIndex++ )
+    {
+        start = Bench_NowNs();
+
+        for( iteration = 0; iteration < BENCH_ITERATIONS; iteration++ )
+        {
+            ( void ) StunIntegrity_InitKey( &( perMessageKey ), &( password[ 0 ] ), sizeof( password ) - 1, NULL );
+            ( void ) StunIntegrity_ComputeHmac( &( perMessageKey ), &( buffer[ 0 ] ), lengths[ lengthIndex ], &( hmac[ 0 ] ) );
+            BENCH_CLOBBER();
+        }
+
+        snprintf( name, sizeof( name ), "HMAC with per-message key, %zu bytes", lengths[ lengthIndex ] );
+        Bench_Report( name, Bench_NowNs() - start, BENCH_ITERATIONS );
+
+        start = Bench_NowNs();
+
+        for( iteration = 0; iteration < BENCH_ITERATIONS; iteration++ )
+        {
+            ( void ) StunIntegrity_ComputeHmac( &( integrityKey ), &( buffer[ 0 ] ), lengths[ lengthIndex ], &( precomputedHmac[ 0 ] ) );
+            BENCH_CLOBBER();
+        }
+
+        snprintf( name, sizeof( name ), "HMAC with precomputed key, %zu bytes", lengths[ lengthIndex ] );
+        Bench_Report( name, Bench_NowNs() - start, BENCH_ITERATIONS );
+
+        if( memcmp( &( hmac[ 0 ] ), &( precomputedHmac[ 0 ] ), sizeof( hmac ) ) != 0 )
+        {
+            printf( "HMAC mismatch!\n" );
+            return EXIT_FAILURE;
+        }
+    }
+
+    start = Bench_NowNs();
+
+    for( iteration = 0; iteration < BENCH_ITERATIONS; iteration++ )
+    {
+        messageLength = BuildBindingRequest( &( message[ 0 ] ), sizeof( message ), &( integrityKey ) );
+        BENCH_CLOBBER();
+    }
+
+    Bench_Report( "Sign binding request", Bench_NowNs() - start, BENCH_ITERATIONS );
+
+    start = Bench_NowNs();
+
+    for( iteration = 0; iteration < BENCH_ITERATIONS; iteration++ )
+    {
+        if( VerifyBindingRequest( &( message[ 0 ] ), messageLength, &( integrityKey ) ) != STUN_RESULT_OK )
+        {
+            printf( "Verification failed!\n" );
+            return EXIT_FAILURE;
+        }
+
+        BENCH_CLOBBER();
+    }
+
+    #if defined( STUN_BENCH_PORTABLE )
+        Bench_Report( "Verify binding request (portable)", Bench_NowNs() - start, BENCH_ITERATIONS );
+    #else
+        Bench_Report( "Verify binding request", Bench_NowNs() - start, BENCH_ITERATIONS );
+    #endif
+
+    return EXIT_SUCCESS;
+}
+
+/*-----------------------------------------------------------*/
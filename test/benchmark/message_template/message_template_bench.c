@@ -0,0 +1,162 @@
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* API includes. */
+#include "stun_serializer.h"
+#include "stun_message_template.h"
+
+/* Benchmark includes. */
+#include "bench_utils.h"
+
+#define BENCH_ITERATIONS    1000000ULL
+
+/*
+ * ICE connectivity checks of about 100 bytes with USERNAME, ICE-CONTROLLING,
+ * PRIORITY, USE-CANDIDATE on every other check, MESSAGE-INTEGRITY and
+ * FINGERPRINT. The reference serializes every check, the checkpoint restores
+ * a message with USERNAME and ICE-CONTROLLING and adds the rest, and the
+ * template copies a serialized check and patches the transaction ID and
+ * PRIORITY. All use a precomputed integrity key, so the difference is the
+ * serializer work.
+ */
+
+static const uint8_t username[] = "4Af6T8dE0b1AcwKd:9zS0Bdmq";
+static const uint8_t password[] = "VOkJxbRl1RmTxUk/WvJxBt";
+
+/*-----------------------------------------------------------*/
+
+static size_t SerializeCheck( const uint8_t * pTransactionId,
+                              uint32_t priority,
+                              uint8_t useCandidate,
+                              const StunIntegrityKey_t * pIntegrityKey,
+                              uint8_t * pBuffer,
+                              size_t bufferLength )
+{
+    StunContext_t ctx;
+    StunHeader_t header;
+    size_t messageLength = 0;
+
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    header.pTransactionId = ( uint8_t * ) pTransactionId;
+
+    ( void ) StunSerializer_Init( &( ctx ), pBuffer, bufferLength, &( header ) );
+    ( void ) StunSerializer_AddAttributeUsername( &( ctx ), &( username[ 0 ] ), sizeof( username ) - 1 );
+    ( void ) StunSerializer_AddAttributeIceControlling( &( ctx ), 0x932FF9B151263B36ULL );
+
+    if( useCandidate != 0U )
+    {
+        ( void ) StunSerializer_AddAttributeUseCandidate( &( ctx ) );
+    }
+
+    ( void ) StunSerializer_AddAttributePriority( &( ctx ), priority );
+    ( void ) StunSerializer_AddComputedIntegrity( &( ctx ), pIntegrityKey );
+    ( void ) StunSerializer_AddComputedFingerprint( &( ctx ) );
+    ( void ) StunSerializer_Finalize( &( ctx ), &( messageLength ) );
+
+    return messageLength;
+}
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] = { 0 };
+    uint8_t templateMessage[ 128 ], serialized[ 128 ], restored[ 128 ], stamped[ 128 ];
+    StunIntegrityKey_t integrityKey;
+    StunMessageTemplate_t messageTemplate;
+    StunMessageTemplateFields_t fields;
+    StunContext_t ctx;
+    StunHeader_t header;
+    StunSerializerCheckpoint_t checkpoint;
+    size_t templateLength, serializedLength = 0, restoredLength = 0, stampedLength = 0, length = 0;
+    uint64_t iteration, start;
+
+    ( void ) StunIntegrity_InitKey( &( integrityKey ), &( password[ 0 ] ), sizeof( password ) - 1, NULL );
+
+    templateLength = SerializeCheck( &( transactionId[ 0 ] ), 0, 1, &( integrityKey ),
+                                     &( templateMessage[ 0 ] ), sizeof( templateMessage ) );
+
+    if( StunMessageTemplate_Init( &( messageTemplate ), &( templateMessage[ 0 ] ), templateLength ) != STUN_RESULT_OK )
+    {
+        printf( "Template init failed!\n" );
+        return EXIT_FAILURE;
+    }
+
+    start = Bench_NowNs();
+
+    for( iteration = 0; iteration < BENCH_ITERATIONS; iteration++ )
+    {
+        memcpy( &( transactionId[ 0 ] ), &( iteration ), sizeof( iteration ) );
+        serializedLength = SerializeCheck( &( transactionId[ 0 ] ), ( uint32_t ) iteration, ( uint8_t ) ( iteration & 1U ),
+                                           &( integrityKey ), &( serialized[ 0 ] ), sizeof( serialized ) );
+        length += serializedLength;
+        BENCH_CLOBBER();
+    }
+
+    Bench_Report( "Connectivity check, serializer", Bench_NowNs() - start, BENCH_ITERATIONS );
+
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    ( void ) StunSerializer_Init( &( ctx ), &( restored[ 0 ] ), sizeof( restored ), &( header ) );
+    ( void ) StunSerializer_AddAttributeUsername( &( ctx ), &( username[ 0 ] ), sizeof( username ) - 1 );
+    ( void ) StunSerializer_AddAttributeIceControlling( &( ctx ), 0x932FF9B151263B36ULL );
+    ( void ) StunSerializer_Checkpoint( &( ctx ), &( checkpoint ) );
+
+    start = Bench_NowNs();
+
+    for( iteration = 0; iteration < BENCH_ITERATIONS; iteration++ )
+    {
+        memcpy( &( transactionId[ 0 ] ), &( iteration ), sizeof( iteration ) );
+        ( void ) StunSerializer_Restore( &( ctx ), &( checkpoint ) );
+        ( void ) StunSerializer_SetTransactionId( &( ctx ), &( transactionId[ 0 ] ) );
+
+        if( ( iteration & 1U ) != 0U )
+        {
+            ( void ) StunSerializer_AddAttributeUseCandidate( &( ctx ) );
+        }
+
+        ( void ) StunSerializer_AddAttributePriority( &( ctx ), ( uint32_t ) iteration );
+        ( void ) StunSerializer_AddComputedIntegrity( &( ctx ), &( integrityKey ) );
+        ( void ) StunSerializer_AddComputedFingerprint( &( ctx ) );
+        ( void ) StunSerializer_Finalize( &( ctx ), &( restoredLength ) );
+        length += restoredLength;
+        BENCH_CLOBBER();
+    }
+
+    Bench_Report( "Connectivity check, checkpoint", Bench_NowNs() - start, BENCH_ITERATIONS );
+
+    fields.pTransactionId = &( transactionId[ 0 ] );
+
+    start = Bench_NowNs();
+
+    for( iteration = 0; iteration < BENCH_ITERATIONS; iteration++ )
+    {
+        memcpy( &( transactionId[ 0 ] ), &( iteration ), sizeof( iteration ) );
+        fields.priority = ( uint32_t ) iteration;
+        fields.useCandidate = ( uint8_t ) ( iteration & 1U );
+        ( void ) StunMessageTemplate_Stamp( &( messageTemplate ), &( fields ), &( integrityKey ),
+                                            &( stamped[ 0 ] ), sizeof( stamped ), &( stampedLength ) );
+        length += stampedLength;
+        BENCH_CLOBBER();
+    }
+
+    Bench_Report( "Connectivity check, template", Bench_NowNs() - start, BENCH_ITERATIONS );
+
+    /* The last checks of the loops have the same fields. */
+    if( ( length == 0 ) ||
+        ( serializedLength != restoredLength ) ||
+        ( serializedLength != stampedLength ) ||
+        ( memcmp( &( serialized[ 0 ] ), &( restored[ 0 ] ), restoredLength ) != 0 ) ||
+        ( memcmp( &( serialized[ 0 ] ), &( stamped[ 0 ] ), stampedLength ) != 0 ) )
+    {
+        printf( "Message template mismatch!\n" );
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*-----------------------------------------------------------*/
@@ -0,0 +1,154 @@
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* API includes. */
+#include "stun_serializer.h"
+#include "stun_deserializer.h"
+
+/* Benchmark includes. */
+#include "bench_utils.h"
+
+#define BENCH_ITERATIONS    5000000ULL
+
+/*
+ * Decoding of an ICE connectivity check by a responder: a
+ * StunDeserializer_GetNextAttribute loop with a StunDeserializer_ParseAttribute*
+ * call per attribute against a single StunDeserializer_DecodeMessageView pass.
+ */
+
+typedef struct DecodedRequest
+{
+    uint8_t * pUsername;
+    uint16_t usernameLength;
+    uint32_t priority;
+    uint64_t tieBreaker;
+    uint8_t useCandidate;
+    uint16_t integrityOffset;
+} DecodedRequest_t;
+
+/*-----------------------------------------------------------*/
+
+static size_t BuildBindingRequest( uint8_t * pBuffer,
+                                   size_t bufferLength )
+{
+    StunContext_t ctx;
+    StunHeader_t header;
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] = { 0 };
+    uint8_t integrity[ STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH ] = { 0 };
+    const uint8_t username[] = "9e6f2bd4:a8c1f3e2";
+    size_t messageLength = 0;
+
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    ( void ) StunSerializer_Init( &( ctx ), pBuffer, bufferLength, &( header ) );
+    ( void ) StunSerializer_AddAttributeUsername( &( ctx ), &( username[ 0 ] ), ( uint16_t ) ( sizeof( username ) - 1 ) );
+    ( void ) StunSerializer_AddAttributePriority( &( ctx ), 0x6E7F1EFF );
+    ( void ) StunSerializer_AddAttributeIceControlling( &( ctx ), 0x932FF9B151263B36ULL );
+    ( void ) StunSerializer_AddAttributeUseCandidate( &( ctx ) );
+    ( void ) StunSerializer_AddAttributeIntegrity( &( ctx ), &( integrity[ 0 ] ), sizeof( integrity ) );
+    ( void ) StunSerializer_AddAttributeFingerprint( &( ctx ), 0x12345678 );
+    ( void ) StunSerializer_Finalize( &( ctx ), &( messageLength ) );
+
+    return messageLength;
+}
+
+/*-----------------------------------------------------------*/
+
+static void DecodeWithAttributeLoop( StunContext_t * pCtx,
+                                     DecodedRequest_t * pDecoded )
+{
+    StunAttribute_t attribute;
+    size_t attributeOffset = pCtx->currentIndex;
+
+    while( StunDeserializer_GetNextAttribute( pCtx, &( attribute ) ) == STUN_RESULT_OK )
+    {
+        switch( attribute.attributeType )
+        {
+            case STUN_ATTRIBUTE_TYPE_USERNAME:
+                pDecoded->pUsername = attribute.pAttributeValue;
+                pDecoded->usernameLength = attribute.attributeValueLength;
+                break;
+
+            case STUN_ATTRIBUTE_TYPE_PRIORITY:
+                ( void ) StunDeserializer_ParseAttributePriority( pCtx, &( attribute ), &( pDecoded->priority ) );
+                break;
+
+            case STUN_ATTRIBUTE_TYPE_ICE_CONTROLLING:
+                ( void ) StunDeserializer_ParseAttributeIceControlling( pCtx, &( attribute ), &( pDecoded->tieBreaker ) );
+                break;
+
+            case STUN_ATTRIBUTE_TYPE_ICE_CONTROLLED:
+                ( void ) StunDeserializer_ParseAttributeIceControlled( pCtx, &( attribute ), &( pDecoded->tieBreaker ) );
+                break;
+
+            case STUN_ATTRIBUTE_TYPE_USE_CANDIDATE:
+                pDecoded->useCandidate = 1;
+                break;
+
+            case STUN_ATTRIBUTE_TYPE_MESSAGE_INTEGRITY:
+                pDecoded->integrityOffset = ( uint16_t ) attributeOffset;
+                break;
+
+            default:
+                break;
+        }
+
+        attributeOffset = pCtx->currentIndex;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    uint8_t request[ 256 ];
+    size_t requestLength;
+    StunContext_t ctx;
+    StunHeader_t header;
+    StunMessageView_t view;
+    DecodedRequest_t decoded = { 0 };
+    uint64_t iteration, start, loopSum = 0, viewSum = 0;
+
+    requestLength = BuildBindingRequest( &( request[ 0 ] ), sizeof( request ) );
+
+    start = Bench_NowNs();
+
+    for( iteration = 0; iteration < BENCH_ITERATIONS; iteration++ )
+    {
+        ( void ) StunDeserializer_Init( &( ctx ), &( request[ 0 ] ), requestLength, &( header ) );
+        DecodeWithAttributeLoop( &( ctx ), &( decoded ) );
+        loopSum += decoded.priority + decoded.usernameLength + decoded.useCandidate + decoded.integrityOffset;
+        BENCH_CLOBBER();
+    }
+
+    Bench_Report( "GetNextAttribute + ParseAttribute*", Bench_NowNs() - start, BENCH_ITERATIONS );
+
+    start = Bench_NowNs();
+
+    for( iteration = 0; iteration < BENCH_ITERATIONS; iteration++ )
+    {
+        ( void ) StunDeserializer_Init( &( ctx ), &( request[ 0 ] ), requestLength, &( header ) );
+        ( void ) StunDeserializer_DecodeMessageView( &( ctx ), &( view ) );
+        viewSum += view.priority + view.username.valueLength +
+                   StunDeserializer_IsAttributeInView( &( view ), STUN_ATTRIBUTE_TYPE_USE_CANDIDATE ) +
+                   view.integrityOffset;
+        BENCH_CLOBBER();
+    }
+
+    Bench_Report( "DecodeMessageView", Bench_NowNs() - start, BENCH_ITERATIONS );
+
+    if( ( loopSum != viewSum ) ||
+        ( decoded.tieBreaker != view.iceTieBreaker ) ||
+        ( decoded.pUsername != view.username.pValue ) )
+    {
+        printf( "Decoded requests differ!\n" );
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*-----------------------------------------------------------*/
@@ -0,0 +1,164 @@
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* API includes. */
+#include "stun_serializer.h"
+#include "stun_response_batch.h"
+
+/* Benchmark includes. */
+#include "bench_utils.h"
+
+#define BENCH_BATCHES       50000ULL
+#define BENCH_BATCH_SIZE    64U
+
+/* Room for a batch of the longest responses, IPv6 with MESSAGE-INTEGRITY. */
+#define BENCH_ARENA_LENGTH  ( BENCH_BATCH_SIZE * STUN_SERIALIZER_ICE_CHECK_RESPONSE_LENGTH( STUN_ATTRIBUTE_ADDRESS_IPV6_VALUE_LENGTH ) )
+
+/*
+ * STUN server answering batches of 64 Binding Requests, as received with
+ * recvmmsg, with the success responses written back-to-back into one arena.
+ * The reference runs StunSerializer_Init, AddAttributeXorMappedAddress,
+ * AddComputedIntegrity, AddComputedFingerprint and Finalize per response. The
+ * batch builder writes the responses in one loop. Reported per packet.
+ */
+
+static const uint8_t password[] = "VOkJxbRl1RmTxUk/WvJxBt";
+
+/*-----------------------------------------------------------*/
+
+static size_t SerializeBatch( const StunResponseBatchEntry_t * pEntries,
+                              uint8_t * pArena,
+                              size_t * pResponseLengths )
+{
+    StunContext_t ctx;
+    StunHeader_t header;
+    size_t i, offset = 0;
+
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_SUCCESS_RESPONSE;
+
+    for( i = 0; i < BENCH_BATCH_SIZE; i++ )
+    {
+        header.pTransactionId = ( uint8_t * ) pEntries[ i ].pTransactionId;
+
+        ( void ) StunSerializer_Init( &( ctx ), &( pArena[ offset ] ), BENCH_ARENA_LENGTH - offset, &( header ) );
+        ( void ) StunSerializer_AddAttributeXorMappedAddress( &( ctx ), pEntries[ i ].pSourceAddress );
+
+        if( pEntries[ i ].pIntegrityKey != NULL )
+        {
+            ( void ) StunSerializer_AddComputedIntegrity( &( ctx ), pEntries[ i ].pIntegrityKey );
+        }
+
+        ( void ) StunSerializer_AddComputedFingerprint( &( ctx ) );
+        ( void ) StunSerializer_Finalize( &( ctx ), &( pResponseLengths[ i ] ) );
+        offset += pResponseLengths[ i ];
+    }
+
+    return offset;
+}
+
+/*-----------------------------------------------------------*/
+
+static int RunCase( const char * pName,
+                    StunResponseBatchEntry_t * pEntries,
+                    uint8_t * pTransactionIds )
+{
+    static uint8_t serialized[ BENCH_ARENA_LENGTH ], batched[ BENCH_ARENA_LENGTH ];
+    size_t serializedLengths[ BENCH_BATCH_SIZE ], batchedLengths[ BENCH_BATCH_SIZE ];
+    size_t serializedLength = 0, responseCount = 0, i;
+    uint64_t batch, start;
+    char label[ 64 ];
+
+    start = Bench_NowNs();
+
+    for( batch = 0; batch < BENCH_BATCHES; batch++ )
+    {
+        memcpy( &( pTransactionIds[ 0 ] ), &( batch ), sizeof( batch ) );
+        serializedLength = SerializeBatch( pEntries, &( serialized[ 0 ] ), &( serializedLengths[ 0 ] ) );
+        BENCH_CLOBBER();
+    }
+
+    snprintf( label, sizeof( label ), "%s, serializer", pName );
+    Bench_Report( label, Bench_NowNs() - start, BENCH_BATCHES * BENCH_BATCH_SIZE );
+
+    start = Bench_NowNs();
+
+    for( batch = 0; batch < BENCH_BATCHES; batch++ )
+    {
+        memcpy( &( pTransactionIds[ 0 ] ), &( batch ), sizeof( batch ) );
+        ( void ) StunResponseBatch_SerializeBindingSuccess( pEntries, BENCH_BATCH_SIZE,
+                                                            &( batched[ 0 ] ), sizeof( batched ),
+                                                            &( batchedLengths[ 0 ] ), &( responseCount ) );
+        BENCH_CLOBBER();
+    }
+
+    snprintf( label, sizeof( label ), "%s, batch", pName );
+    Bench_Report( label, Bench_NowNs() - start, BENCH_BATCHES * BENCH_BATCH_SIZE );
+
+    /* The last batches of both loops have the same transaction IDs. */
+    for( i = 0; i < BENCH_BATCH_SIZE; i++ )
+    {
+        if( serializedLengths[ i ] != batchedLengths[ i ] )
+        {
+            responseCount = 0;
+        }
+    }
+
+    if( ( responseCount != BENCH_BATCH_SIZE ) ||
+        ( memcmp( &( serialized[ 0 ] ), &( batched[ 0 ] ), serializedLength ) != 0 ) )
+    {
+        printf( "Response batch mismatch!\n" );
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    static uint8_t transactionIds[ BENCH_BATCH_SIZE ][ STUN_HEADER_TRANSACTION_ID_LENGTH ];
+    static StunAttributeAddress_t addresses[ BENCH_BATCH_SIZE ];
+    StunResponseBatchEntry_t entries[ BENCH_BATCH_SIZE ];
+    StunIntegrityKey_t integrityKey;
+    int status = EXIT_SUCCESS;
+    size_t i;
+
+    ( void ) StunIntegrity_InitKey( &( integrityKey ), &( password[ 0 ] ), sizeof( password ) - 1, NULL );
+
+    for( i = 0; i < BENCH_BATCH_SIZE; i++ )
+    {
+        memset( &( transactionIds[ i ][ 0 ] ), ( int ) i, STUN_HEADER_TRANSACTION_ID_LENGTH );
+        addresses[ i ].family = STUN_ADDRESS_IPv4;
+        addresses[ i ].port = ( uint16_t ) ( 40000U + i );
+        addresses[ i ].address[ 0 ] = 198;
+        addresses[ i ].address[ 1 ] = 51;
+        addresses[ i ].address[ 2 ] = 100;
+        addresses[ i ].address[ 3 ] = ( uint8_t ) i;
+
+        entries[ i ].pTransactionId = &( transactionIds[ i ][ 0 ] );
+        entries[ i ].pSourceAddress = &( addresses[ i ] );
+        entries[ i ].pIntegrityKey = NULL;
+    }
+
+    if( RunCase( "Binding success, no credential", &( entries[ 0 ] ), &( transactionIds[ 0 ][ 0 ] ) ) != EXIT_SUCCESS )
+    {
+        status = EXIT_FAILURE;
+    }
+
+    for( i = 0; i < BENCH_BATCH_SIZE; i++ )
+    {
+        entries[ i ].pIntegrityKey = &( integrityKey );
+    }
+
+    if( RunCase( "Binding success, short-term credential", &( entries[ 0 ] ), &( transactionIds[ 0 ][ 0 ] ) ) != EXIT_SUCCESS )
+    {
+        status = EXIT_FAILURE;
+    }
+
+    return status;
+}
+
+/*-----------------------------------------------------------*/
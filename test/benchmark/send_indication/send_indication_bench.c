@@ -0,0 +1,144 @@
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* API includes. */
+#include "stun_serializer.h"
+#include "stun_deserializer.h"
+
+/* Benchmark includes. */
+#include "bench_utils.h"
+
+#define BENCH_ITERATIONS        200000ULL
+
+#define BENCH_MAX_PAYLOAD_LENGTH    8192
+
+/* XOR-PEER-ADDRESS (IPv4) and the DATA attribute header. */
+#define BENCH_ATTRIBUTES_LENGTH     ( 12 + STUN_ATTRIBUTE_HEADER_LENGTH )
+
+/*
+ * TURN Send and Data indications with media payloads: 1200 and 1400 bytes
+ * (video RTP packets) and 8K (jumbo frames, or TCP to the TURN server). Each
+ * size is encoded with the DATA value copied into the send buffer and with the
+ * DATA value referenced, and decoded in place.
+ */
+
+static uint8_t payload[ BENCH_MAX_PAYLOAD_LENGTH ];
+static uint8_t message[ STUN_HEADER_LENGTH + BENCH_ATTRIBUTES_LENGTH + BENCH_MAX_PAYLOAD_LENGTH ];
+
+/*-----------------------------------------------------------*/
+
+static void InitSendIndication( StunContext_t * pCtx,
+                                uint8_t * pBuffer,
+                                size_t bufferLength,
+                                const uint8_t * pTransactionId,
+                                const StunAttributeAddress_t * pPeerAddress )
+{
+    StunHeader_t header;
+
+    header.messageType = STUN_MESSAGE_TYPE_SEND_INDICATION;
+    header.pTransactionId = ( uint8_t * ) pTransactionId;
+
+    ( void ) StunSerializer_Init( pCtx, pBuffer, bufferLength, &( header ) );
+    ( void ) StunSerializer_AddAttributeXorPeerAddress( pCtx, pPeerAddress );
+}
+
+/*-----------------------------------------------------------*/
+
+static int RunPayloadLength( uint16_t payloadLength )
+{
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] = { 0 };
+    StunAttributeAddress_t peerAddress = { 0 };
+    StunContext_t ctx;
+    StunHeader_t header;
+    StunAttribute_t attribute;
+    StunIoVec_t ioVecs[ STUN_SERIALIZER_IOVEC_MAX_COUNT ];
+    size_t messageLength = 0, ioVecCount = 0, length = 0;
+    uint64_t iteration, start;
+    char name[ 64 ];
+
+    peerAddress.family = STUN_ADDRESS_IPv4;
+    peerAddress.port = 50000;
+    peerAddress.address[ 0 ] = 192;
+    peerAddress.address[ 1 ] = 168;
+    peerAddress.address[ 3 ] = 10;
+
+    start = Bench_NowNs();
+
+    for( iteration = 0; iteration < BENCH_ITERATIONS; iteration++ )
+    {
+        InitSendIndication( &( ctx ), &( message[ 0 ] ), sizeof( message ), &( transactionId[ 0 ] ), &( peerAddress ) );
+        ( void ) StunSerializer_AddAttributeData( &( ctx ), &( payload[ 0 ] ), payloadLength );
+        ( void ) StunSerializer_Finalize( &( ctx ), &( messageLength ) );
+        length += messageLength;
+        BENCH_CLOBBER();
+    }
+
+    snprintf( name, sizeof( name ), "Send indication %u B, encode copy", payloadLength );
+    Bench_Report( name, Bench_NowNs() - start, BENCH_ITERATIONS );
+
+    start = Bench_NowNs();
+
+    for( iteration = 0; iteration < BENCH_ITERATIONS; iteration++ )
+    {
+        InitSendIndication( &( ctx ), &( message[ 0 ] ), sizeof( message ), &( transactionId[ 0 ] ), &( peerAddress ) );
+        ( void ) StunSerializer_AddAttributeDataReference( &( ctx ), &( payload[ 0 ] ), payloadLength );
+        ( void ) StunSerializer_FinalizeIoVec( &( ctx ), &( ioVecs[ 0 ] ), STUN_SERIALIZER_IOVEC_MAX_COUNT, &( ioVecCount ) );
+        length += ioVecs[ 0 ].length + ioVecs[ 1 ].length;
+        BENCH_CLOBBER();
+    }
+
+    snprintf( name, sizeof( name ), "Send indication %u B, encode reference", payloadLength );
+    Bench_Report( name, Bench_NowNs() - start, BENCH_ITERATIONS );
+
+    /* Decode the copied message, as received. */
+    InitSendIndication( &( ctx ), &( message[ 0 ] ), sizeof( message ), &( transactionId[ 0 ] ), &( peerAddress ) );
+    ( void ) StunSerializer_AddAttributeData( &( ctx ), &( payload[ 0 ] ), payloadLength );
+    ( void ) StunSerializer_Finalize( &( ctx ), &( messageLength ) );
+
+    attribute.attributeValueLength = 0;
+    start = Bench_NowNs();
+
+    for( iteration = 0; iteration < BENCH_ITERATIONS; iteration++ )
+    {
+        ( void ) StunDeserializer_Init( &( ctx ), &( message[ 0 ] ), messageLength, &( header ) );
+
+        while( StunDeserializer_GetNextAttribute( &( ctx ), &( attribute ) ) == STUN_RESULT_OK )
+        {
+            length += attribute.attributeValueLength;
+        }
+
+        BENCH_CLOBBER();
+    }
+
+    snprintf( name, sizeof( name ), "Send indication %u B, decode", payloadLength );
+    Bench_Report( name, Bench_NowNs() - start, BENCH_ITERATIONS );
+
+    return ( ( length != 0 ) &&
+             ( ioVecCount == 2 ) &&
+             ( messageLength == STUN_HEADER_LENGTH + BENCH_ATTRIBUTES_LENGTH + ( size_t ) payloadLength ) ) ? 0 : -1;
+}
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    int ret = 0;
+
+    memset( &( payload[ 0 ] ), 0x5A, sizeof( payload ) );
+
+    ret |= RunPayloadLength( 1200 );
+    ret |= RunPayloadLength( 1400 );
+    ret |= RunPayloadLength( BENCH_MAX_PAYLOAD_LENGTH );
+
+    if( ret != 0 )
+    {
+        printf( "Send indication mismatch!\n" );
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*-----------------------------------------------------------*/
@@ -0,0 +1,199 @@
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* API includes. */
+#include "stun_serializer.h"
+#include "stun_crc32.h"
+
+/* Benchmark includes. */
+#include "bench_utils.h"
+
+#define BENCH_ITERATIONS    500000ULL
+
+#define BENCH_MAX_DATA_LENGTH       60000
+#define BENCH_BUFFER_LENGTH         ( BENCH_MAX_DATA_LENGTH + 256 )
+
+/*
+ * Finishing a message with MESSAGE-INTEGRITY and FINGERPRINT. The reference is
+ * the seven call sequence: get the integrity buffer, compute the HMAC, add
+ * MESSAGE-INTEGRITY, get the fingerprint buffer, compute the CRC, add
+ * FINGERPRINT and finalize. The fused finalize does the same in one call and
+ * one pass over the message, and with a hash stream it only hashes the last
+ * block at finalize. All use a precomputed integrity key. Measured for an ICE
+ * connectivity check and for messages with 1200, 8K and 60K DATA.
+ */
+
+static const uint8_t username[] = "4Af6T8dE0b1AcwKd:9zS0Bdmq";
+static const uint8_t password[] = "VOkJxbRl1RmTxUk/WvJxBt";
+static uint8_t data[ BENCH_MAX_DATA_LENGTH ];
+static uint8_t expected[ BENCH_BUFFER_LENGTH ];
+static uint8_t message[ BENCH_BUFFER_LENGTH ];
+
+/*-----------------------------------------------------------*/
+
+static void AddAttributes( StunContext_t * pCtx,
+                           uint16_t dataLength )
+{
+    ( void ) StunSerializer_AddAttributeUsername( pCtx, &( username[ 0 ] ), sizeof( username ) - 1 );
+    ( void ) StunSerializer_AddAttributePriority( pCtx, 0x6E0001FF );
+    ( void ) StunSerializer_AddAttributeIceControlling( pCtx, 0x932FF9B151263B36ULL );
+
+    if( dataLength > 0 )
+    {
+        ( void ) StunSerializer_AddAttributeData( pCtx, &( data[ 0 ] ), dataLength );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+static void InitMessage( StunContext_t * pCtx,
+                         uint8_t * pBuffer,
+                         size_t bufferLength )
+{
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] = { 0 };
+    StunHeader_t header;
+
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    ( void ) StunSerializer_Init( pCtx, pBuffer, bufferLength, &( header ) );
+}
+
+/*-----------------------------------------------------------*/
+
+static void SerializeAttributes( StunContext_t * pCtx,
+                                 uint8_t * pBuffer,
+                                 size_t bufferLength,
+                                 uint16_t dataLength )
+{
+    InitMessage( pCtx, pBuffer, bufferLength );
+    AddAttributes( pCtx, dataLength );
+}
+
+/*-----------------------------------------------------------*/
+
+static void SerializeAttributesStreamed( StunContext_t * pCtx,
+                                         StunSerializerHashStream_t * pHashStream,
+                                         const StunIntegrityKey_t * pIntegrityKey,
+                                         size_t expectedLength,
+                                         uint16_t dataLength )
+{
+    InitMessage( pCtx, &( message[ 0 ] ), sizeof( message ) );
+    ( void ) StunSerializer_EnableHashStream( pCtx, pHashStream, pIntegrityKey, expectedLength );
+    AddAttributes( pCtx, dataLength );
+}
+
+/*-----------------------------------------------------------*/
+
+static size_t FinalizeInSevenCalls( StunContext_t * pCtx,
+                                    const StunIntegrityKey_t * pIntegrityKey )
+{
+    uint8_t hmac[ STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH ];
+    uint8_t * pMessage = NULL;
+    uint16_t messageLength = 0;
+    size_t finalLength = 0;
+
+    ( void ) StunSerializer_GetIntegrityBuffer( pCtx, &( pMessage ), &( messageLength ) );
+    ( void ) StunIntegrity_ComputeHmac( pIntegrityKey, pMessage, messageLength, &( hmac[ 0 ] ) );
+    ( void ) StunSerializer_AddAttributeIntegrity( pCtx, &( hmac[ 0 ] ), sizeof( hmac ) );
+    ( void ) StunSerializer_GetFingerprintBuffer( pCtx, &( pMessage ), &( messageLength ) );
+    ( void ) StunSerializer_AddAttributeFingerprint( pCtx, Stun_Crc32( 0, pMessage, messageLength ) );
+    ( void ) StunSerializer_Finalize( pCtx, &( finalLength ) );
+
+    return finalLength;
+}
+
+/*-----------------------------------------------------------*/
+
+static int RunDataLength( uint16_t dataLength )
+{
+    StunIntegrityKey_t integrityKey;
+    StunSerializerHashStream_t hashStream;
+    StunContext_t ctx;
+    size_t expectedLength = 0, messageLength = 0, length = 0, mismatch = 0;
+    uint64_t iteration, start, iterations = BENCH_ITERATIONS;
+    char name[ 64 ];
+
+    if( dataLength > 8192 )
+    {
+        iterations /= 20;
+    }
+
+    ( void ) StunIntegrity_InitKey( &( integrityKey ), &( password[ 0 ] ), sizeof( password ) - 1, NULL );
+
+    start = Bench_NowNs();
+
+    for( iteration = 0; iteration < iterations; iteration++ )
+    {
+        SerializeAttributes( &( ctx ), &( expected[ 0 ] ), sizeof( expected ), dataLength );
+        expectedLength = FinalizeInSevenCalls( &( ctx ), &( integrityKey ) );
+        length += expectedLength;
+        BENCH_CLOBBER();
+    }
+
+    snprintf( name, sizeof( name ), "%u B message, seven calls", ( unsigned ) expectedLength );
+    Bench_Report( name, Bench_NowNs() - start, iterations );
+
+    start = Bench_NowNs();
+
+    for( iteration = 0; iteration < iterations; iteration++ )
+    {
+        SerializeAttributes( &( ctx ), &( message[ 0 ] ), sizeof( message ), dataLength );
+        ( void ) StunSerializer_FinalizeWithIntegrityAndFingerprint( &( ctx ), &( integrityKey ), &( messageLength ) );
+        length += messageLength;
+        BENCH_CLOBBER();
+    }
+
+    snprintf( name, sizeof( name ), "%u B message, fused finalize", ( unsigned ) messageLength );
+    Bench_Report( name, Bench_NowNs() - start, iterations );
+
+    mismatch |= ( expectedLength != messageLength ) ||
+                ( memcmp( &( expected[ 0 ] ), &( message[ 0 ] ), messageLength ) != 0 );
+    memset( &( message[ 0 ] ), 0, messageLength );
+
+    /* The expected length of every message is known, as with the size
+     * calculated once for messages of the same shape. */
+    start = Bench_NowNs();
+
+    for( iteration = 0; iteration < iterations; iteration++ )
+    {
+        SerializeAttributesStreamed( &( ctx ), &( hashStream ), &( integrityKey ), expectedLength, dataLength );
+        ( void ) StunSerializer_FinalizeWithIntegrityAndFingerprint( &( ctx ), &( integrityKey ), &( messageLength ) );
+        length += messageLength;
+        BENCH_CLOBBER();
+    }
+
+    snprintf( name, sizeof( name ), "%u B message, hash stream", ( unsigned ) messageLength );
+    Bench_Report( name, Bench_NowNs() - start, iterations );
+
+    mismatch |= ( expectedLength != messageLength ) ||
+                ( memcmp( &( expected[ 0 ] ), &( message[ 0 ] ), messageLength ) != 0 );
+
+    return ( ( length != 0 ) && ( mismatch == 0 ) ) ? 0 : -1;
+}
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    int ret = 0;
+
+    memset( &( data[ 0 ] ), 0x5A, sizeof( data ) );
+
+    ret |= RunDataLength( 0 );
+    ret |= RunDataLength( 1200 );
+    ret |= RunDataLength( 8192 );
+    ret |= RunDataLength( BENCH_MAX_DATA_LENGTH );
+
+    if( ret != 0 )
+    {
+        printf( "Signed message mismatch!\n" );
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*-----------------------------------------------------------*/
@@ -0,0 +1,203 @@
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* API includes. */
+#include "stun_serializer.h"
+#include "stun_deserializer.h"
+#include "stun_stream_parser.h"
+
+/* Benchmark includes. */
+#include "bench_utils.h"
+
+#define BENCH_PASSES                200
+
+/* Frames in the stream: one Binding request for every 4 ChannelData. */
+#define BENCH_FRAME_COUNT           2000
+
+#define BENCH_CHANNEL_DATA_LENGTH   162
+
+/* TCP segment size. */
+#define BENCH_CHUNK_LENGTH          1448
+
+#define BENCH_BUFFER_LENGTH         4096
+
+/*
+ * TURN over TCP: a stream of Binding requests (ICE consent freshness) and
+ * ChannelData carrying audio, received in TCP segments that split the frames
+ * at arbitrary places. The reference appends every segment to a reassembly
+ * buffer, copies every complete frame out before parsing it and shifts the
+ * rest of the buffer down. The stream parser receives into its own buffer and
+ * returns the frames in place.
+ */
+
+static uint8_t stream[ BENCH_FRAME_COUNT * ( BENCH_CHANNEL_DATA_LENGTH + 8 ) ];
+
+/*-----------------------------------------------------------*/
+
+static size_t BuildStream( void )
+{
+    StunContext_t ctx;
+    StunHeader_t header = { 0 };
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] = { 0 };
+    size_t streamLength = 0, messageLength, i;
+
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    for( i = 0; i < BENCH_FRAME_COUNT; i++ )
+    {
+        if( ( i % 5 ) == 0 )
+        {
+            transactionId[ 0 ] = ( uint8_t ) i;
+            ( void ) StunSerializer_Init( &( ctx ), &( stream[ streamLength ] ), sizeof( stream ) - streamLength, &( header ) );
+            ( void ) StunSerializer_AddAttributePriority( &( ctx ), 0x6E0001FF );
+            ( void ) StunSerializer_AddAttributeUsername( &( ctx ), ( const uint8_t * ) "evtj:h6vY", 9 );
+            ( void ) StunSerializer_Finalize( &( ctx ), &( messageLength ) );
+            streamLength += messageLength;
+        }
+        else
+        {
+            stream[ streamLength ] = 0x40;
+            stream[ streamLength + 1 ] = 0x01;
+            stream[ streamLength + 2 ] = 0x00;
+            stream[ streamLength + 3 ] = BENCH_CHANNEL_DATA_LENGTH;
+            memset( &( stream[ streamLength + 4 ] ), ( int ) i, BENCH_CHANNEL_DATA_LENGTH );
+            streamLength += ( 4 + BENCH_CHANNEL_DATA_LENGTH + 3 ) & ~3U;
+        }
+    }
+
+    return streamLength;
+}
+
+/*-----------------------------------------------------------*/
+
+static size_t ParseWithReassembly( size_t streamLength )
+{
+    static uint8_t reassemblyBuffer[ BENCH_BUFFER_LENGTH ];
+    static uint8_t messageBuffer[ BENCH_BUFFER_LENGTH ];
+    StunContext_t ctx;
+    StunHeader_t header;
+    size_t offset, chunkLength, pendingLength = 0, frameLength, totalLength, frameCount = 0;
+
+    for( offset = 0; offset < streamLength; offset += chunkLength )
+    {
+        chunkLength = ( ( streamLength - offset ) < BENCH_CHUNK_LENGTH ) ? ( streamLength - offset ) : BENCH_CHUNK_LENGTH;
+        memcpy( &( reassemblyBuffer[ pendingLength ] ), &( stream[ offset ] ), chunkLength );
+        pendingLength += chunkLength;
+
+        while( pendingLength >= 4 )
+        {
+            frameLength = ( ( size_t ) reassemblyBuffer[ 2 ] << 8 ) | reassemblyBuffer[ 3 ];
+
+            if( reassemblyBuffer[ 0 ] < 0x40 )
+            {
+                frameLength += STUN_HEADER_LENGTH;
+                totalLength = frameLength;
+            }
+            else
+            {
+                frameLength += 4;
+                totalLength = ( frameLength + 3 ) & ~( ( size_t ) 3 );
+            }
+
+            if( totalLength > pendingLength )
+            {
+                break;
+            }
+
+            memcpy( &( messageBuffer[ 0 ] ), &( reassemblyBuffer[ 0 ] ), frameLength );
+
+            if( messageBuffer[ 0 ] < 0x40 )
+            {
+                ( void ) StunDeserializer_Init( &( ctx ), &( messageBuffer[ 0 ] ), frameLength, &( header ) );
+            }
+
+            BENCH_CLOBBER();
+            frameCount++;
+
+            memmove( &( reassemblyBuffer[ 0 ] ), &( reassemblyBuffer[ totalLength ] ), pendingLength - totalLength );
+            pendingLength -= totalLength;
+        }
+    }
+
+    return frameCount;
+}
+
+/*-----------------------------------------------------------*/
+
+static size_t ParseWithStreamParser( size_t streamLength )
+{
+    static uint8_t parserBuffer[ BENCH_BUFFER_LENGTH ];
+    StunStreamParser_t parser;
+    StunStreamFrame_t frame;
+    StunContext_t ctx;
+    StunHeader_t header;
+    uint8_t * pWriteBuffer;
+    size_t offset, chunkLength, writeBufferLength, frameCount = 0;
+
+    ( void ) StunStreamParser_Init( &( parser ), &( parserBuffer[ 0 ] ), sizeof( parserBuffer ), STUN_STREAM_FRAMING_STUN );
+
+    for( offset = 0; offset < streamLength; offset += chunkLength )
+    {
+        chunkLength = ( ( streamLength - offset ) < BENCH_CHUNK_LENGTH ) ? ( streamLength - offset ) : BENCH_CHUNK_LENGTH;
+
+        /* Stands for recv() into the parser buffer. */
+        ( void ) StunStreamParser_GetWriteBuffer( &( parser ), &( pWriteBuffer ), &( writeBufferLength ) );
+        memcpy( pWriteBuffer, &( stream[ offset ] ), chunkLength );
+        ( void ) StunStreamParser_CommitWrite( &( parser ), chunkLength );
+
+        while( StunStreamParser_GetNextFrame( &( parser ), &( frame ) ) == STUN_RESULT_OK )
+        {
+            if( frame.packetType == STUN_PACKET_TYPE_STUN )
+            {
+                ( void ) StunDeserializer_Init( &( ctx ), frame.pFrame, frame.frameLength, &( header ) );
+            }
+
+            BENCH_CLOBBER();
+            frameCount++;
+        }
+    }
+
+    return frameCount;
+}
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    size_t streamLength, frameCount = 0, parserFrameCount = 0;
+    uint64_t pass, start;
+
+    streamLength = BuildStream();
+
+    start = Bench_NowNs();
+
+    for( pass = 0; pass < BENCH_PASSES; pass++ )
+    {
+        frameCount = ParseWithReassembly( streamLength );
+    }
+
+    Bench_Report( "TCP frames, reassembly buffer + copy", Bench_NowNs() - start, BENCH_PASSES * BENCH_FRAME_COUNT );
+
+    start = Bench_NowNs();
+
+    for( pass = 0; pass < BENCH_PASSES; pass++ )
+    {
+        parserFrameCount = ParseWithStreamParser( streamLength );
+    }
+
+    Bench_Report( "TCP frames, stream parser in place", Bench_NowNs() - start, BENCH_PASSES * BENCH_FRAME_COUNT );
+
+    if( ( frameCount != BENCH_FRAME_COUNT ) ||
+        ( parserFrameCount != BENCH_FRAME_COUNT ) )
+    {
+        printf( "Frame count mismatch!\n" );
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*-----------------------------------------------------------*/
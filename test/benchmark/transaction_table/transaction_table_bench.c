@@ -0,0 +1,223 @@
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+/* API includes. */
+#include "stun_transaction_table.h"
+
+/* Benchmark includes. */
+#include "bench_utils.h"
+
+#define BENCH_LOOKUPS_PER_READER    2000000ULL
+
+#define BENCH_TABLE_CAPACITY        1024
+
+/* Number of outstanding requests, i.e. half of the table. */
+#define BENCH_OUTSTANDING           512
+
+#define BENCH_MAX_READERS           4
+
+/*
+ * Response matching on a server with many outstanding requests (ICE
+ * connectivity checks, TURN refreshes). A writer thread keeps sending
+ * requests: it inserts a new transaction and removes the oldest one. The
+ * reader threads match responses to the outstanding transactions. The
+ * lock-free table is compared with the same table behind a mutex.
+ */
+
+typedef struct BenchShared
+{
+    StunTransactionTable_t table;
+    pthread_mutex_t mutex;
+    int useMutex;
+    uint32_t newestTransaction;
+    int stop;
+} BenchShared_t;
+
+typedef struct BenchReader
+{
+    BenchShared_t * pShared;
+    uint64_t elapsedNs;
+    uint64_t found;
+} BenchReader_t;
+
+static uint8_t tags[ BENCH_TABLE_CAPACITY ];
+static StunTransactionSlot_t slots[ BENCH_TABLE_CAPACITY ];
+static uint32_t overflowCounts[ BENCH_TABLE_CAPACITY / STUN_TRANSACTION_TABLE_GROUP_LENGTH ];
+
+/*-----------------------------------------------------------*/
+
+static void FillTransactionId( uint8_t * pTransactionId,
+                               uint32_t sequence )
+{
+    uint32_t random = sequence * 0x9E3779B9U;
+
+    memcpy( &( pTransactionId[ 0 ] ), &( sequence ), sizeof( sequence ) );
+    memcpy( &( pTransactionId[ 4 ] ), &( random ), sizeof( random ) );
+    memcpy( &( pTransactionId[ 8 ] ), "kvs!", 4 );
+}
+
+/*-----------------------------------------------------------*/
+
+static void * ReaderThread( void * pArg )
+{
+    BenchReader_t * pReader = ( BenchReader_t * ) pArg;
+    BenchShared_t * pShared = pReader->pShared;
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ];
+    uint32_t random = ( uint32_t ) ( uintptr_t ) pArg;
+    uint64_t i, start;
+    void * pUserData;
+    StunResult_t result;
+
+    start = Bench_NowNs();
+
+    for( i = 0; i < BENCH_LOOKUPS_PER_READER; i++ )
+    {
+        random = ( random * 1103515245U ) + 12345U;
+        FillTransactionId( &( transactionId[ 0 ] ),
+                           __atomic_load_n( &( pShared->newestTransaction ), __ATOMIC_ACQUIRE ) - ( ( random >> 8 ) % ( BENCH_OUTSTANDING / 2 ) ) );
+
+        if( pShared->useMutex != 0 )
+        {
+            pthread_mutex_lock( &( pShared->mutex ) );
+            result = StunTransactionTable_Lookup( &( pShared->table ), &( transactionId[ 0 ] ), &( pUserData ) );
+            pthread_mutex_unlock( &( pShared->mutex ) );
+        }
+        else
+        {
+            result = StunTransactionTable_Lookup( &( pShared->table ), &( transactionId[ 0 ] ), &( pUserData ) );
+        }
+
+        pReader->found += ( result == STUN_RESULT_OK ) ? 1U : 0U;
+    }
+
+    pReader->elapsedNs = Bench_NowNs() - start;
+
+    return NULL;
+}
+
+/*-----------------------------------------------------------*/
+
+static void * WriterThread( void * pArg )
+{
+    BenchShared_t * pShared = ( BenchShared_t * ) pArg;
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ];
+    uint32_t sequence = pShared->newestTransaction;
+
+    while( __atomic_load_n( &( pShared->stop ), __ATOMIC_RELAXED ) == 0 )
+    {
+        sequence++;
+
+        if( pShared->useMutex != 0 )
+        {
+            pthread_mutex_lock( &( pShared->mutex ) );
+        }
+
+        FillTransactionId( &( transactionId[ 0 ] ), sequence );
+        ( void ) StunTransactionTable_Insert( &( pShared->table ), &( transactionId[ 0 ] ), ( void * ) ( uintptr_t ) sequence );
+        FillTransactionId( &( transactionId[ 0 ] ), sequence - BENCH_OUTSTANDING );
+        ( void ) StunTransactionTable_Remove( &( pShared->table ), &( transactionId[ 0 ] ), NULL );
+
+        if( pShared->useMutex != 0 )
+        {
+            pthread_mutex_unlock( &( pShared->mutex ) );
+        }
+
+        __atomic_store_n( &( pShared->newestTransaction ), sequence, __ATOMIC_RELEASE );
+    }
+
+    return NULL;
+}
+
+/*-----------------------------------------------------------*/
+
+static void RunBench( int useMutex,
+                      int readerCount,
+                      int withWriter )
+{
+    static BenchShared_t shared;
+    BenchReader_t readers[ BENCH_MAX_READERS ];
+    pthread_t readerThreads[ BENCH_MAX_READERS ], writerThread;
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ];
+    uint64_t elapsedNs = 0, found = 0;
+    uint32_t sequence;
+    char name[ 64 ];
+    int i;
+
+    ( void ) StunTransactionTable_Init( &( shared.table ), &( tags[ 0 ] ), &( slots[ 0 ] ), &( overflowCounts[ 0 ] ), BENCH_TABLE_CAPACITY, 0x5DEECE66DULL );
+    pthread_mutex_init( &( shared.mutex ), NULL );
+    shared.useMutex = useMutex;
+    shared.stop = 0;
+
+    for( sequence = 1; sequence <= BENCH_OUTSTANDING; sequence++ )
+    {
+        FillTransactionId( &( transactionId[ 0 ] ), sequence );
+        ( void ) StunTransactionTable_Insert( &( shared.table ), &( transactionId[ 0 ] ), ( void * ) ( uintptr_t ) sequence );
+    }
+
+    shared.newestTransaction = BENCH_OUTSTANDING;
+
+    if( withWriter != 0 )
+    {
+        pthread_create( &( writerThread ), NULL, WriterThread, &( shared ) );
+    }
+
+    for( i = 0; i < readerCount; i++ )
+    {
+        readers[ i ].pShared = &( shared );
+        readers[ i ].elapsedNs = 0;
+        readers[ i ].found = 0;
+        pthread_create( &( readerThreads[ i ] ), NULL, ReaderThread, &( readers[ i ] ) );
+    }
+
+    for( i = 0; i < readerCount; i++ )
+    {
+        pthread_join( readerThreads[ i ], NULL );
+        elapsedNs += readers[ i ].elapsedNs;
+        found += readers[ i ].found;
+    }
+
+    if( withWriter != 0 )
+    {
+        __atomic_store_n( &( shared.stop ), 1, __ATOMIC_RELAXED );
+        pthread_join( writerThread, NULL );
+    }
+
+    pthread_mutex_destroy( &( shared.mutex ) );
+
+    /* Average latency of a lookup as seen by a reader. */
+    snprintf( name,
+              sizeof( name ),
+              "Lookup %s, %d reader(s)%s",
+              ( useMutex != 0 ) ? "mutex" : "lock-free",
+              readerCount,
+              ( withWriter != 0 ) ? " + writer" : "" );
+    Bench_Report( name, elapsedNs, BENCH_LOOKUPS_PER_READER * ( uint64_t ) readerCount );
+
+    if( found == 0 )
+    {
+        printf( "No transaction found!\n" );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    int readerCount;
+
+    RunBench( 0, 1, 0 );
+    RunBench( 1, 1, 0 );
+
+    for( readerCount = 1; readerCount <= BENCH_MAX_READERS; readerCount *= 2 )
+    {
+        RunBench( 0, readerCount, 1 );
+        RunBench( 1, readerCount, 1 );
+    }
+
+    return 0;
+}
+
+/*-----------------------------------------------------------*/
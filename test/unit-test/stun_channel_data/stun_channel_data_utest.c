@@ -0,0 +1,489 @@
+/* Unity includes. */
+#include "unity.h"
+#include "catch_assert.h"
+
+/* Standard includes. */
+#include <string.h>
+#include <stdint.h>
+
+/* API includes. */
+#include "stun_channel_data.h"
+
+/* ===========================  EXTERN VARIABLES  =========================== */
+
+static const uint8_t applicationData[] = { 0x80, 0x60, 0x12, 0x34, 0xAA };
+
+/* ============================  Helper Functions ============================ */
+
+static void InitChannelData( uint8_t * pBuffer,
+                             StunChannelData_t * pChannelData,
+                             uint16_t channelNumber,
+                             uint16_t dataLength )
+{
+    memcpy( &( pBuffer[ STUN_CHANNEL_DATA_HEADER_LENGTH ] ), &( applicationData[ 0 ] ), sizeof( applicationData ) );
+
+    pChannelData->channelNumber = channelNumber;
+    pChannelData->pData = &( pBuffer[ STUN_CHANNEL_DATA_HEADER_LENGTH ] );
+    pChannelData->dataLength = dataLength;
+}
+
+/*-----------------------------------------------------------*/
+
+static void InitBatch( uint8_t buffers[ 3 ][ 16 ],
+                       StunChannelData_t * pChannelData )
+{
+    size_t i;
+
+    for( i = 0; i < 3; i++ )
+    {
+        memset( &( buffers[ i ][ 0 ] ), 0xFF, 16 );
+        InitChannelData( &( buffers[ i ][ 0 ] ),
+                         &( pChannelData[ i ] ),
+                         ( uint16_t ) ( 0x4000 + i ),
+                         ( uint16_t ) ( sizeof( applicationData ) - i ) );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+void setUp( void )
+{
+}
+
+void tearDown( void )
+{
+}
+
+/* ==============================  Test Cases ============================== */
+
+/**
+ * @brief Validate that the header is written in the headroom and that the
+ * application data is not moved or padded for UDP.
+ */
+void test_StunChannelData_Encode_NoPadding( void )
+{
+    uint8_t buffer[ 16 ];
+    const uint8_t expected[] =
+    {
+        0x40, 0x01, 0x00, 0x05,
+        0x80, 0x60, 0x12, 0x34, 0xAA
+    };
+    StunChannelData_t channelData;
+    StunMessageBuffer_t encoded;
+
+    memset( &( buffer[ 0 ] ), 0xFF, sizeof( buffer ) );
+    InitChannelData( &( buffer[ 0 ] ), &( channelData ), 0x4001, sizeof( applicationData ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunChannelData_Encode( &( channelData ), 0, &( encoded ) ) );
+    TEST_ASSERT_EQUAL_PTR( &( buffer[ 0 ] ), encoded.pStunMessage );
+    TEST_ASSERT_EQUAL( sizeof( expected ), encoded.stunMessageLength );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expected[ 0 ] ), &( buffer[ 0 ] ), sizeof( expected ) );
+    TEST_ASSERT_EQUAL( 0xFF, buffer[ sizeof( expected ) ] );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that the application data is padded to a multiple of 4 for
+ * TCP.
+ */
+void test_StunChannelData_Encode_Padding( void )
+{
+    uint8_t buffer[ 16 ];
+    const uint8_t expected[] =
+    {
+        0x40, 0x01, 0x00, 0x05,
+        0x80, 0x60, 0x12, 0x34, 0xAA,
+        0x00, 0x00, 0x00
+    };
+    StunChannelData_t channelData;
+    StunMessageBuffer_t encoded;
+
+    memset( &( buffer[ 0 ] ), 0xFF, sizeof( buffer ) );
+    InitChannelData( &( buffer[ 0 ] ), &( channelData ), 0x4001, sizeof( applicationData ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunChannelData_Encode( &( channelData ), 1, &( encoded ) ) );
+    TEST_ASSERT_EQUAL_PTR( &( buffer[ 0 ] ), encoded.pStunMessage );
+    TEST_ASSERT_EQUAL( sizeof( expected ), encoded.stunMessageLength );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expected[ 0 ] ), &( buffer[ 0 ] ), sizeof( expected ) );
+    TEST_ASSERT_EQUAL( 0xFF, buffer[ sizeof( expected ) ] );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate the padding for every data length modulo 4.
+ */
+void test_StunChannelData_Encode_PaddingEveryLength( void )
+{
+    uint8_t buffer[ 16 ];
+    const size_t expectedLengths[ 8 ] = { 4, 8, 8, 8, 8, 12, 12, 12 };
+    StunChannelData_t channelData;
+    StunMessageBuffer_t encoded;
+    uint16_t dataLength;
+
+    for( dataLength = 0; dataLength < 8; dataLength++ )
+    {
+        memset( &( buffer[ 0 ] ), 0xFF, sizeof( buffer ) );
+        channelData.channelNumber = 0x4FFF;
+        channelData.pData = &( buffer[ STUN_CHANNEL_DATA_HEADER_LENGTH ] );
+        channelData.dataLength = dataLength;
+
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunChannelData_Encode( &( channelData ), 1, &( encoded ) ) );
+        TEST_ASSERT_EQUAL( expectedLengths[ dataLength ], encoded.stunMessageLength );
+        /* The data is untouched and only the padding is zeroed. */
+        TEST_ASSERT_EACH_EQUAL_UINT8( 0xFF,
+                                      &( buffer[ STUN_CHANNEL_DATA_HEADER_LENGTH ] ),
+                                      dataLength );
+        TEST_ASSERT_EACH_EQUAL_UINT8( 0,
+                                      &( buffer[ STUN_CHANNEL_DATA_HEADER_LENGTH + dataLength ] ),
+                                      encoded.stunMessageLength - STUN_CHANNEL_DATA_HEADER_LENGTH - dataLength );
+        TEST_ASSERT_EQUAL( 0xFF, buffer[ encoded.stunMessageLength ] );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that a received ChannelData message is parsed in place and
+ * that the padding is ignored.
+ */
+void test_StunChannelData_Decode_Padded( void )
+{
+    uint8_t packet[] =
+    {
+        0x4F, 0xFF, 0x00, 0x05,
+        0x80, 0x60, 0x12, 0x34, 0xAA,
+        0x00, 0x00, 0x00
+    };
+    StunChannelData_t channelData;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunChannelData_Decode( &( packet[ 0 ] ), sizeof( packet ), &( channelData ) ) );
+    TEST_ASSERT_EQUAL( 0x4FFF, channelData.channelNumber );
+    TEST_ASSERT_EQUAL_PTR( &( packet[ 4 ] ), channelData.pData );
+    TEST_ASSERT_EQUAL( sizeof( applicationData ), channelData.dataLength );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate a received ChannelData message without padding.
+ */
+void test_StunChannelData_Decode_NotPadded( void )
+{
+    uint8_t packet[] =
+    {
+        0x40, 0x00, 0x00, 0x05,
+        0x80, 0x60, 0x12, 0x34, 0xAA
+    };
+    StunChannelData_t channelData;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunChannelData_Decode( &( packet[ 0 ] ), sizeof( packet ), &( channelData ) ) );
+    TEST_ASSERT_EQUAL( 0x4000, channelData.channelNumber );
+    TEST_ASSERT_EQUAL_PTR( &( packet[ 4 ] ), channelData.pData );
+    TEST_ASSERT_EQUAL( sizeof( applicationData ), channelData.dataLength );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that truncated application data is rejected.
+ */
+void test_StunChannelData_Decode_TruncatedData( void )
+{
+    uint8_t packet[] =
+    {
+        0x40, 0x00, 0x00, 0x05,
+        0x80, 0x60, 0x12, 0x34
+    };
+    StunChannelData_t channelData;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_MESSAGE_LENGTH,
+                       StunChannelData_Decode( &( packet[ 0 ] ), sizeof( packet ), &( channelData ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that a truncated header is rejected.
+ */
+void test_StunChannelData_Decode_TruncatedHeader( void )
+{
+    uint8_t packet[] = { 0x40, 0x00, 0x00 };
+    StunChannelData_t channelData;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_MESSAGE_LENGTH,
+                       StunChannelData_Decode( &( packet[ 0 ] ), sizeof( packet ), &( channelData ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that a channel number above the RFC 8656 range is rejected.
+ */
+void test_StunChannelData_Decode_ChannelNumberAboveRange( void )
+{
+    uint8_t packet[] = { 0x50, 0x00, 0x00, 0x00 };
+    StunChannelData_t channelData;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_FRAME,
+                       StunChannelData_Decode( &( packet[ 0 ] ), sizeof( packet ), &( channelData ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that a channel number below the RFC 8656 range is rejected.
+ */
+void test_StunChannelData_Decode_ChannelNumberBelowRange( void )
+{
+    uint8_t packet[] = { 0x3F, 0xFF, 0x00, 0x00 };
+    StunChannelData_t channelData;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_FRAME,
+                       StunChannelData_Decode( &( packet[ 0 ] ), sizeof( packet ), &( channelData ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that a batch is encoded in place for sendmmsg.
+ */
+void test_StunChannelData_EncodeBatch_Pass( void )
+{
+    uint8_t buffers[ 3 ][ 16 ];
+    StunChannelData_t channelData[ 3 ];
+    StunMessageBuffer_t encoded[ 3 ];
+    const size_t expectedLengths[ 3 ] = { 12, 8, 8 };
+    size_t i;
+
+    InitBatch( buffers, &( channelData[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunChannelData_EncodeBatch( &( channelData[ 0 ] ), 3, 1, &( encoded[ 0 ] ) ) );
+
+    for( i = 0; i < 3; i++ )
+    {
+        TEST_ASSERT_EQUAL_PTR( &( buffers[ i ][ 0 ] ), encoded[ i ].pStunMessage );
+        TEST_ASSERT_EQUAL( expectedLengths[ i ], encoded[ i ].stunMessageLength );
+        TEST_ASSERT_EQUAL( 0x40, buffers[ i ][ 0 ] );
+        TEST_ASSERT_EQUAL( i, buffers[ i ][ 1 ] );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that the invalid messages of a batch received with recvmmsg
+ * are reported without failing the batch.
+ */
+void test_StunChannelData_DecodeBatch_InvalidMessage( void )
+{
+    uint8_t buffers[ 3 ][ 16 ];
+    StunChannelData_t channelData[ 3 ], decoded[ 3 ];
+    StunMessageBuffer_t encoded[ 3 ];
+    StunResult_t results[ 3 ];
+    size_t validCount = 0;
+
+    InitBatch( buffers, &( channelData[ 0 ] ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunChannelData_EncodeBatch( &( channelData[ 0 ] ), 3, 1, &( encoded[ 0 ] ) ) );
+
+    /* Longer than the received message. */
+    buffers[ 1 ][ 3 ] = 0x20;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunChannelData_DecodeBatch( &( encoded[ 0 ] ), 3, &( decoded[ 0 ] ), &( results[ 0 ] ), &( validCount ) ) );
+    TEST_ASSERT_EQUAL( 2, validCount );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK, results[ 0 ] );
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_MESSAGE_LENGTH, results[ 1 ] );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK, results[ 2 ] );
+    TEST_ASSERT_EQUAL( 0x4002, decoded[ 2 ].channelNumber );
+    TEST_ASSERT_EQUAL_PTR( channelData[ 2 ].pData, decoded[ 2 ].pData );
+    TEST_ASSERT_EQUAL( sizeof( applicationData ) - 2, decoded[ 2 ].dataLength );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that nothing is written if a channel number of the batch is
+ * above the range.
+ */
+void test_StunChannelData_EncodeBatch_ChannelNumberAboveRange( void )
+{
+    uint8_t buffers[ 3 ][ 16 ];
+    StunChannelData_t channelData[ 3 ];
+    StunMessageBuffer_t encoded[ 3 ];
+
+    InitBatch( buffers, &( channelData[ 0 ] ) );
+    channelData[ 2 ].channelNumber = 0x5000;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunChannelData_EncodeBatch( &( channelData[ 0 ] ), 3, 0, &( encoded[ 0 ] ) ) );
+    TEST_ASSERT_EQUAL( 0xFF, buffers[ 0 ][ 0 ] );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that nothing is written if a channel number of the batch is
+ * below the range.
+ */
+void test_StunChannelData_EncodeBatch_ChannelNumberBelowRange( void )
+{
+    uint8_t buffers[ 3 ][ 16 ];
+    StunChannelData_t channelData[ 3 ];
+    StunMessageBuffer_t encoded[ 3 ];
+
+    InitBatch( buffers, &( channelData[ 0 ] ) );
+    channelData[ 1 ].channelNumber = 0x3FFF;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunChannelData_EncodeBatch( &( channelData[ 0 ] ), 3, 0, &( encoded[ 0 ] ) ) );
+    TEST_ASSERT_EQUAL( 0xFF, buffers[ 0 ][ 0 ] );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that nothing is written if the data of a message in the
+ * batch is NULL.
+ */
+void test_StunChannelData_EncodeBatch_NullData( void )
+{
+    uint8_t buffers[ 3 ][ 16 ];
+    StunChannelData_t channelData[ 3 ];
+    StunMessageBuffer_t encoded[ 3 ];
+
+    InitBatch( buffers, &( channelData[ 0 ] ) );
+    channelData[ 2 ].pData = NULL;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunChannelData_EncodeBatch( &( channelData[ 0 ] ), 3, 0, &( encoded[ 0 ] ) ) );
+    TEST_ASSERT_EQUAL( 0xFF, buffers[ 0 ][ 0 ] );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that an empty batch is encoded without any buffers.
+ */
+void test_StunChannelData_EncodeBatch_Empty( void )
+{
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunChannelData_EncodeBatch( NULL, 0, 0, NULL ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that an empty batch is decoded without any buffers.
+ */
+void test_StunChannelData_DecodeBatch_Empty( void )
+{
+    size_t validCount = 1;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunChannelData_DecodeBatch( NULL, 0, NULL, NULL, &( validCount ) ) );
+    TEST_ASSERT_EQUAL( 0, validCount );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunChannelData_Encode with bad parameters.
+ */
+void test_StunChannelData_Encode_BadParams( void )
+{
+    uint8_t buffer[ 16 ] = { 0 };
+    StunChannelData_t channelData;
+    StunMessageBuffer_t encoded;
+
+    InitChannelData( &( buffer[ 0 ] ), &( channelData ), 0x4000, 0 );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunChannelData_Encode( NULL, 0, &( encoded ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunChannelData_Encode( &( channelData ), 0, NULL ) );
+
+    channelData.channelNumber = 0x3FFF;
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunChannelData_Encode( &( channelData ), 0, &( encoded ) ) );
+
+    channelData.channelNumber = 0x5000;
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunChannelData_Encode( &( channelData ), 0, &( encoded ) ) );
+
+    channelData.channelNumber = 0x4000;
+    channelData.pData = NULL;
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunChannelData_Encode( &( channelData ), 0, &( encoded ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunChannelData_Decode with bad parameters.
+ */
+void test_StunChannelData_Decode_BadParams( void )
+{
+    uint8_t buffer[ 16 ] = { 0 };
+    StunChannelData_t channelData;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunChannelData_Decode( NULL, sizeof( buffer ), &( channelData ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunChannelData_Decode( &( buffer[ 0 ] ), sizeof( buffer ), NULL ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunChannelData_EncodeBatch with bad parameters.
+ */
+void test_StunChannelData_EncodeBatch_BadParams( void )
+{
+    uint8_t buffer[ 16 ] = { 0 };
+    StunChannelData_t channelData;
+    StunMessageBuffer_t encoded;
+
+    InitChannelData( &( buffer[ 0 ] ), &( channelData ), 0x4000, 0 );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunChannelData_EncodeBatch( NULL, 1, 0, &( encoded ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunChannelData_EncodeBatch( &( channelData ), 1, 0, NULL ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunChannelData_DecodeBatch with bad parameters.
+ */
+void test_StunChannelData_DecodeBatch_BadParams( void )
+{
+    uint8_t buffer[ 16 ] = { 0 };
+    StunChannelData_t channelData;
+    StunMessageBuffer_t encoded;
+    StunResult_t results[ 1 ];
+    size_t validCount;
+
+    encoded.pStunMessage = &( buffer[ 0 ] );
+    encoded.stunMessageLength = sizeof( buffer );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunChannelData_DecodeBatch( NULL, 1, &( channelData ), &( results[ 0 ] ), &( validCount ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunChannelData_DecodeBatch( &( encoded ), 1, NULL, &( results[ 0 ] ), &( validCount ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunChannelData_DecodeBatch( &( encoded ), 1, &( channelData ), NULL, &( validCount ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunChannelData_DecodeBatch( &( encoded ), 1, &( channelData ), &( results[ 0 ] ), NULL ) );
+}
+
+/*-----------------------------------------------------------*/
@@ -0,0 +1,491 @@
+/* Unity includes. */
+#include "unity.h"
+#include "catch_assert.h"
+
+/* Standard includes. */
+#include <string.h>
+#include <stdint.h>
+
+/* API includes. */
+#include "stun_classifier.h"
+#include "stun_data_types.h"
+
+/* ===========================  EXTERN VARIABLES  =========================== */
+
+static uint8_t stunMessage[] =
+{
+    /* Message Type = STUN Binding Request, Message Length = 0x08 (excluding 20 bytes header). */
+    0x00, 0x01, 0x00, 0x08,
+    /* Magic cookie. */
+    0x21, 0x12, 0xA4, 0x42,
+    /* Transaction ID. */
+    0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+    /* Attribute type = PRIORITY (0x0024), Length = 4 bytes. */
+    0x00, 0x24, 0x00, 0x04,
+    /* Attribute Value = 0x7E7F00FF. */
+    0x7E, 0x7F, 0x00, 0xFF
+};
+
+static uint8_t dtlsRecord[] =
+{
+    /* Content Type = Handshake, Version = DTLS 1.2. */
+    0x16, 0xFE, 0xFD,
+    /* Epoch, Sequence Number. */
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    /* Length. */
+    0x00, 0x0C,
+    /* Handshake header. */
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+static uint8_t rtpPacket[] =
+{
+    /* Version = 2, Payload Type = 111, Sequence Number. */
+    0x80, 0x6F, 0x12, 0x34,
+    /* Timestamp. */
+    0x00, 0x00, 0x10, 0x00,
+    /* SSRC. */
+    0xDE, 0xAD, 0xBE, 0xEF,
+    /* Payload. */
+    0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08
+};
+
+static uint8_t channelData[] =
+{
+    /* Channel Number = 0x4001, Length = 4. */
+    0x40, 0x01, 0x00, 0x04,
+    /* Application data. */
+    0x01, 0x02, 0x03, 0x04
+};
+
+static uint8_t zrtpPacket[] =
+{
+    /* ZRTP header with the first byte set to 0x10. */
+    0x10, 0x00, 0x00, 0x01,
+    /* ZRTP magic cookie. */
+    0x5A, 0x52, 0x54, 0x50
+};
+
+/* Classifies stunMessage with its first byte replaced by firstByte. */
+static StunPacketType_t ClassifyWithFirstByte( uint8_t firstByte )
+{
+    uint8_t packet[ sizeof( stunMessage ) ];
+
+    memcpy( &( packet[ 0 ] ), &( stunMessage[ 0 ] ), sizeof( stunMessage ) );
+    packet[ 0 ] = firstByte;
+
+    return StunClassifier_ClassifyPacket( &( packet[ 0 ] ), sizeof( packet ) );
+}
+
+void setUp( void )
+{
+}
+
+void tearDown( void )
+{
+}
+
+/* ==============================  Test Cases ============================== */
+
+/**
+ * @brief Validate StunClassifier_ClassifyPacket with a STUN message.
+ */
+void test_StunClassifier_ClassifyPacket_Stun( void )
+{
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_STUN,
+                       StunClassifier_ClassifyPacket( &( stunMessage[ 0 ] ), sizeof( stunMessage ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunClassifier_ClassifyPacket with a DTLS record.
+ */
+void test_StunClassifier_ClassifyPacket_Dtls( void )
+{
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_DTLS,
+                       StunClassifier_ClassifyPacket( &( dtlsRecord[ 0 ] ), sizeof( dtlsRecord ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunClassifier_ClassifyPacket with an RTP packet.
+ */
+void test_StunClassifier_ClassifyPacket_Rtp( void )
+{
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_RTP,
+                       StunClassifier_ClassifyPacket( &( rtpPacket[ 0 ] ), sizeof( rtpPacket ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunClassifier_ClassifyPacket with a ChannelData message.
+ */
+void test_StunClassifier_ClassifyPacket_ChannelData( void )
+{
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_CHANNEL_DATA,
+                       StunClassifier_ClassifyPacket( &( channelData[ 0 ] ), sizeof( channelData ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunClassifier_ClassifyPacket with a ZRTP packet.
+ */
+void test_StunClassifier_ClassifyPacket_Zrtp( void )
+{
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_ZRTP,
+                       StunClassifier_ClassifyPacket( &( zrtpPacket[ 0 ] ), sizeof( zrtpPacket ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunClassifier_ClassifyPacket at the bounds of the STUN
+ * range.
+ */
+void test_StunClassifier_ClassifyPacket_StunRangeBounds( void )
+{
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_STUN,
+                       ClassifyWithFirstByte( STUN_CLASSIFIER_STUN_FIRST_BYTE_MIN ) );
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_STUN,
+                       ClassifyWithFirstByte( STUN_CLASSIFIER_STUN_FIRST_BYTE_MAX ) );
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_UNKNOWN,
+                       ClassifyWithFirstByte( STUN_CLASSIFIER_STUN_FIRST_BYTE_MAX + 1 ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunClassifier_ClassifyPacket at the bounds of the ZRTP
+ * range.
+ */
+void test_StunClassifier_ClassifyPacket_ZrtpRangeBounds( void )
+{
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_UNKNOWN,
+                       ClassifyWithFirstByte( STUN_CLASSIFIER_ZRTP_FIRST_BYTE_MIN - 1 ) );
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_ZRTP,
+                       ClassifyWithFirstByte( STUN_CLASSIFIER_ZRTP_FIRST_BYTE_MIN ) );
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_ZRTP,
+                       ClassifyWithFirstByte( STUN_CLASSIFIER_ZRTP_FIRST_BYTE_MAX ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunClassifier_ClassifyPacket at the bounds of the DTLS
+ * range.
+ */
+void test_StunClassifier_ClassifyPacket_DtlsRangeBounds( void )
+{
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_DTLS,
+                       ClassifyWithFirstByte( STUN_CLASSIFIER_DTLS_FIRST_BYTE_MIN ) );
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_DTLS,
+                       ClassifyWithFirstByte( STUN_CLASSIFIER_DTLS_FIRST_BYTE_MAX ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunClassifier_ClassifyPacket at the bounds of the
+ * ChannelData range.
+ */
+void test_StunClassifier_ClassifyPacket_ChannelDataRangeBounds( void )
+{
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_CHANNEL_DATA,
+                       ClassifyWithFirstByte( STUN_CLASSIFIER_CHANNEL_DATA_FIRST_BYTE_MIN ) );
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_CHANNEL_DATA,
+                       ClassifyWithFirstByte( STUN_CLASSIFIER_CHANNEL_DATA_FIRST_BYTE_MAX ) );
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_UNKNOWN,
+                       ClassifyWithFirstByte( STUN_CLASSIFIER_CHANNEL_DATA_FIRST_BYTE_MAX + 1 ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunClassifier_ClassifyPacket at the bounds of the RTP
+ * range.
+ */
+void test_StunClassifier_ClassifyPacket_RtpRangeBounds( void )
+{
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_UNKNOWN,
+                       ClassifyWithFirstByte( STUN_CLASSIFIER_RTP_FIRST_BYTE_MIN - 1 ) );
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_RTP,
+                       ClassifyWithFirstByte( STUN_CLASSIFIER_RTP_FIRST_BYTE_MIN ) );
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_RTP,
+                       ClassifyWithFirstByte( STUN_CLASSIFIER_RTP_FIRST_BYTE_MAX ) );
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_UNKNOWN,
+                       ClassifyWithFirstByte( STUN_CLASSIFIER_RTP_FIRST_BYTE_MAX + 1 ) );
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_UNKNOWN,
+                       ClassifyWithFirstByte( 0xFF ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunClassifier_ClassifyPacket with a packet in the STUN
+ * range that is shorter than the STUN header.
+ */
+void test_StunClassifier_ClassifyPacket_ShortStunHeader( void )
+{
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_UNKNOWN,
+                       StunClassifier_ClassifyPacket( &( stunMessage[ 0 ] ), STUN_HEADER_LENGTH - 1 ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunClassifier_ClassifyPacket with a packet in the STUN
+ * range with a wrong magic cookie.
+ */
+void test_StunClassifier_ClassifyPacket_MagicCookieMismatch( void )
+{
+    uint8_t packet[ sizeof( stunMessage ) ];
+
+    memcpy( &( packet[ 0 ] ), &( stunMessage[ 0 ] ), sizeof( stunMessage ) );
+    packet[ STUN_HEADER_MAGIC_COOKIE_OFFSET ] = 0x12;
+
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_UNKNOWN,
+                       StunClassifier_ClassifyPacket( &( packet[ 0 ] ), sizeof( packet ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunClassifier_ClassifyPacket with a packet in the STUN
+ * range with a message length that is not a multiple of 4.
+ */
+void test_StunClassifier_ClassifyPacket_UnalignedMessageLength( void )
+{
+    uint8_t packet[ sizeof( stunMessage ) ];
+
+    memcpy( &( packet[ 0 ] ), &( stunMessage[ 0 ] ), sizeof( stunMessage ) );
+    packet[ STUN_HEADER_MESSAGE_LENGTH_OFFSET + 1 ] = 0x06;
+
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_UNKNOWN,
+                       StunClassifier_ClassifyPacket( &( packet[ 0 ] ), sizeof( packet ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunClassifier_ClassifyPacket with a NULL packet.
+ */
+void test_StunClassifier_ClassifyPacket_NullPacket( void )
+{
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_UNKNOWN,
+                       StunClassifier_ClassifyPacket( NULL, sizeof( stunMessage ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunClassifier_ClassifyPacket with an empty packet.
+ */
+void test_StunClassifier_ClassifyPacket_ZeroLength( void )
+{
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_UNKNOWN,
+                       StunClassifier_ClassifyPacket( &( stunMessage[ 0 ] ), 0 ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunClassifier_ClassifyBatch agrees with
+ * StunClassifier_ClassifyPacket for every possible first byte, on a batch
+ * spanning multiple blocks.
+ */
+void test_StunClassifier_ClassifyBatch_EveryFirstByte( void )
+{
+    StunResult_t result;
+    uint8_t packets[ 256 ][ sizeof( stunMessage ) ];
+    StunMessageBuffer_t packetBuffers[ 256 ];
+    uint8_t packetTypes[ 256 ];
+    size_t i;
+
+    for( i = 0; i < 256; i++ )
+    {
+        memcpy( &( packets[ i ][ 0 ] ), &( stunMessage[ 0 ] ), sizeof( stunMessage ) );
+        packets[ i ][ 0 ] = ( uint8_t ) i;
+        packetBuffers[ i ].pStunMessage = &( packets[ i ][ 0 ] );
+        packetBuffers[ i ].stunMessageLength = sizeof( stunMessage );
+    }
+
+    result = StunClassifier_ClassifyBatch( &( packetBuffers[ 0 ] ),
+                                           256,
+                                           &( packetTypes[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    for( i = 0; i < 256; i++ )
+    {
+        TEST_ASSERT_EQUAL( ClassifyWithFirstByte( ( uint8_t ) i ),
+                           packetTypes[ i ] );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunClassifier_ClassifyBatch with packets in the STUN range
+ * that do not have a valid STUN header.
+ */
+void test_StunClassifier_ClassifyBatch_InvalidStunHeader( void )
+{
+    StunResult_t result;
+    uint8_t packets[ 4 ][ sizeof( stunMessage ) ];
+    StunMessageBuffer_t packetBuffers[ 4 ];
+    uint8_t packetTypes[ 4 ];
+    size_t i;
+
+    for( i = 0; i < 4; i++ )
+    {
+        memcpy( &( packets[ i ][ 0 ] ), &( stunMessage[ 0 ] ), sizeof( stunMessage ) );
+        packetBuffers[ i ].pStunMessage = &( packets[ i ][ 0 ] );
+        packetBuffers[ i ].stunMessageLength = sizeof( stunMessage );
+    }
+
+    packets[ 1 ][ STUN_HEADER_MAGIC_COOKIE_OFFSET + 3 ] = 0x43;
+    packets[ 2 ][ STUN_HEADER_MESSAGE_LENGTH_OFFSET + 1 ] = 0x09;
+    packetBuffers[ 3 ].stunMessageLength = STUN_HEADER_LENGTH - 1;
+
+    result = StunClassifier_ClassifyBatch( &( packetBuffers[ 0 ] ),
+                                           4,
+                                           &( packetTypes[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_STUN,
+                       packetTypes[ 0 ] );
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_UNKNOWN,
+                       packetTypes[ 1 ] );
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_UNKNOWN,
+                       packetTypes[ 2 ] );
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_UNKNOWN,
+                       packetTypes[ 3 ] );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunClassifier_ClassifyBatch with short, empty and NULL
+ * packets.
+ */
+void test_StunClassifier_ClassifyBatch_ShortAndEmptyPackets( void )
+{
+    StunResult_t result;
+    StunMessageBuffer_t packetBuffers[ 3 ];
+    uint8_t packetTypes[ 3 ];
+
+    packetBuffers[ 0 ].pStunMessage = &( rtpPacket[ 0 ] );
+    packetBuffers[ 0 ].stunMessageLength = 1;
+    packetBuffers[ 1 ].pStunMessage = &( rtpPacket[ 0 ] );
+    packetBuffers[ 1 ].stunMessageLength = 0;
+    packetBuffers[ 2 ].pStunMessage = NULL;
+    packetBuffers[ 2 ].stunMessageLength = sizeof( rtpPacket );
+
+    result = StunClassifier_ClassifyBatch( &( packetBuffers[ 0 ] ),
+                                           3,
+                                           &( packetTypes[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_RTP,
+                       packetTypes[ 0 ] );
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_UNKNOWN,
+                       packetTypes[ 1 ] );
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_UNKNOWN,
+                       packetTypes[ 2 ] );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunClassifier_ClassifyBatch only writes the types of the
+ * packets in the batch when the last block is partial.
+ */
+void test_StunClassifier_ClassifyBatch_PartialBlock( void )
+{
+    StunResult_t result;
+    StunMessageBuffer_t packetBuffers[ 2 ];
+    uint8_t packetTypes[ 4 ];
+
+    packetBuffers[ 0 ].pStunMessage = &( stunMessage[ 0 ] );
+    packetBuffers[ 0 ].stunMessageLength = sizeof( stunMessage );
+    packetBuffers[ 1 ].pStunMessage = &( channelData[ 0 ] );
+    packetBuffers[ 1 ].stunMessageLength = sizeof( channelData );
+
+    memset( &( packetTypes[ 0 ] ), 0xA5, sizeof( packetTypes ) );
+
+    result = StunClassifier_ClassifyBatch( &( packetBuffers[ 0 ] ),
+                                           2,
+                                           &( packetTypes[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_STUN,
+                       packetTypes[ 0 ] );
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_CHANNEL_DATA,
+                       packetTypes[ 1 ] );
+    TEST_ASSERT_EACH_EQUAL_UINT8( 0xA5,
+                                  &( packetTypes[ 2 ] ),
+                                  2 );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunClassifier_ClassifyBatch with NULL packets.
+ */
+void test_StunClassifier_ClassifyBatch_NullPackets( void )
+{
+    StunResult_t result;
+    uint8_t packetType = 0;
+
+    result = StunClassifier_ClassifyBatch( NULL,
+                                           1,
+                                           &( packetType ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunClassifier_ClassifyBatch with NULL packet types.
+ */
+void test_StunClassifier_ClassifyBatch_NullPacketTypes( void )
+{
+    StunResult_t result;
+    StunMessageBuffer_t packet = { 0 };
+
+    result = StunClassifier_ClassifyBatch( &( packet ),
+                                           1,
+                                           NULL );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunClassifier_ClassifyBatch with an empty batch.
+ */
+void test_StunClassifier_ClassifyBatch_EmptyBatch( void )
+{
+    StunResult_t result;
+
+    result = StunClassifier_ClassifyBatch( NULL,
+                                           0,
+                                           NULL );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
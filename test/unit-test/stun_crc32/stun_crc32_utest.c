@@ -0,0 +1,236 @@
+/* Unity includes. */
+#include "unity.h"
+#include "catch_assert.h"
+
+/* Standard includes. */
+#include <string.h>
+#include <stdint.h>
+
+/* API includes. */
+#include "stun_crc32.h"
+
+/* ===========================  EXTERN VARIABLES  =========================== */
+
+/* Sample request from RFC 5769 section 2.1, without the FINGERPRINT attribute.
+ * The message length in the header includes the FINGERPRINT attribute. */
+static const uint8_t sampleRequest[] =
+{
+    /* Message Type = STUN Binding Request, Message Length = 0x58. */
+    0x00, 0x01, 0x00, 0x58,
+    /* Magic cookie. */
+    0x21, 0x12, 0xA4, 0x42,
+    /* Transaction ID. */
+    0xB7, 0xE7, 0xA7, 0x01, 0xBC, 0x34, 0xD6, 0x86, 0xFA, 0x87, 0xDF, 0xAE,
+    /* Attribute Type = SOFTWARE, Attribute Length = 16, Value = "STUN test client". */
+    0x80, 0x22, 0x00, 0x10,
+    0x53, 0x54, 0x55, 0x4E, 0x20, 0x74, 0x65, 0x73,
+    0x74, 0x20, 0x63, 0x6C, 0x69, 0x65, 0x6E, 0x74,
+    /* Attribute Type = PRIORITY, Attribute Length = 4. */
+    0x00, 0x24, 0x00, 0x04,
+    0x6E, 0x00, 0x01, 0xFF,
+    /* Attribute Type = ICE-CONTROLLED, Attribute Length = 8. */
+    0x80, 0x29, 0x00, 0x08,
+    0x93, 0x2F, 0xF9, 0xB1, 0x51, 0x26, 0x3B, 0x36,
+    /* Attribute Type = USERNAME, Attribute Length = 9, Value = "evtj:h6vY" and padding. */
+    0x00, 0x06, 0x00, 0x09,
+    0x65, 0x76, 0x74, 0x6A, 0x3A, 0x68, 0x36, 0x76,
+    0x59, 0x20, 0x20, 0x20,
+    /* Attribute Type = MESSAGE-INTEGRITY, Attribute Length = 20. */
+    0x00, 0x08, 0x00, 0x14,
+    0x9A, 0xEA, 0xA7, 0x0C, 0xBF, 0xD8, 0xCB, 0x56, 0x78, 0x1E,
+    0xF2, 0xB5, 0xB2, 0xD3, 0xF2, 0x49, 0xC1, 0xB5, 0x71, 0xA2
+};
+
+/* ============================  Helper Functions ============================ */
+
+/* Reference CRC-32 computed one bit at a time. */
+static uint32_t Crc32Bitwise( uint32_t crc,
+                              const uint8_t * pBuffer,
+                              size_t bufferLength )
+{
+    uint32_t state = ~crc;
+    size_t i, bit;
+
+    for( i = 0; i < bufferLength; i++ )
+    {
+        state ^= pBuffer[ i ];
+
+        for( bit = 0; bit < 8; bit++ )
+        {
+            state = ( state >> 1 ) ^ ( ( state & 1U ) != 0U ? 0xEDB88320U : 0U );
+        }
+    }
+
+    return ~state;
+}
+
+/*-----------------------------------------------------------*/
+
+static void CheckLengthsAndOffsets( size_t minLength,
+                                    size_t maxLength,
+                                    size_t minOffset,
+                                    size_t maxOffset )
+{
+    /* 8 byte aligned, so that offset 0 is aligned. */
+    uint64_t storage[ 32 ];
+    uint8_t * pBuffer = ( uint8_t * ) &( storage[ 0 ] );
+    size_t i, length, offset;
+
+    for( i = 0; i < sizeof( storage ); i++ )
+    {
+        pBuffer[ i ] = ( uint8_t ) ( ( i * 31U ) + 7U );
+    }
+
+    for( offset = minOffset; offset <= maxOffset; offset++ )
+    {
+        for( length = minLength; length <= maxLength; length++ )
+        {
+            TEST_ASSERT_EQUAL_HEX32( Crc32Bitwise( 0x12345678, &( pBuffer[ offset ] ), length ),
+                                     Stun_Crc32( 0x12345678, &( pBuffer[ offset ] ), length ) );
+        }
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+void setUp( void )
+{
+}
+
+void tearDown( void )
+{
+}
+
+/* ==============================  Test Cases ============================== */
+
+/**
+ * @brief Validate Stun_Crc32 against the standard check value.
+ */
+void test_Stun_Crc32_CheckValue( void )
+{
+    const uint8_t checkInput[] = "123456789";
+
+    TEST_ASSERT_EQUAL_HEX32( 0xCBF43926,
+                             Stun_Crc32( 0, &( checkInput[ 0 ] ), sizeof( checkInput ) - 1 ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate Stun_Crc32 against the FINGERPRINT of the RFC 5769 sample
+ * request.
+ */
+void test_Stun_Crc32_Rfc5769SampleRequest( void )
+{
+    TEST_ASSERT_EQUAL_HEX32( 0xE57A3BCF ^ 0x5354554E,
+                             Stun_Crc32( 0, &( sampleRequest[ 0 ] ), sizeof( sampleRequest ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that Stun_Crc32 gives the same result when a buffer is split
+ * at any point, so that the accelerated and bytewise paths agree for every
+ * length and alignment.
+ */
+void test_Stun_Crc32_Chaining( void )
+{
+    uint8_t buffer[ 300 ];
+    uint32_t expectedCrc, crc;
+    size_t i, split;
+
+    for( i = 0; i < sizeof( buffer ); i++ )
+    {
+        buffer[ i ] = ( uint8_t ) ( ( i * 31U ) + 7U );
+    }
+
+    /* Bytewise reference. */
+    expectedCrc = 0;
+
+    for( i = 0; i < sizeof( buffer ); i++ )
+    {
+        expectedCrc = Stun_Crc32( expectedCrc, &( buffer[ i ] ), 1 );
+    }
+
+    for( split = 0; split <= sizeof( buffer ); split++ )
+    {
+        crc = Stun_Crc32( 0, &( buffer[ 0 ] ), split );
+        crc = Stun_Crc32( crc, &( buffer[ split ] ), sizeof( buffer ) - split );
+
+        TEST_ASSERT_EQUAL_HEX32( expectedCrc,
+                                 crc );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate Stun_Crc32 with a zero length buffer.
+ */
+void test_Stun_Crc32_ZeroLength( void )
+{
+    const uint8_t checkInput[] = "123456789";
+
+    TEST_ASSERT_EQUAL_HEX32( 0,
+                             Stun_Crc32( 0, &( checkInput[ 0 ] ), 0 ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that Stun_Crc32 returns the previous CRC for a zero length
+ * buffer.
+ */
+void test_Stun_Crc32_ZeroLengthKeepsCrc( void )
+{
+    const uint8_t checkInput[] = "123456789";
+
+    TEST_ASSERT_EQUAL_HEX32( 0xCBF43926,
+                             Stun_Crc32( 0xCBF43926, &( checkInput[ 0 ] ), 0 ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that Stun_Crc32 returns the previous CRC for a NULL buffer.
+ */
+void test_Stun_Crc32_NullBuffer( void )
+{
+    TEST_ASSERT_EQUAL_HEX32( 0xCBF43926,
+                             Stun_Crc32( 0xCBF43926, NULL, 10 ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate Stun_Crc32 with buffers of 0 to 16 bytes that do not start
+ * on an 8 byte boundary.
+ */
+void test_Stun_Crc32_UnalignedBuffers( void )
+{
+    CheckLengthsAndOffsets( 0, 16, 1, 7 );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate Stun_Crc32 with 8 byte words followed by a tail of 0 to 7
+ * bytes.
+ */
+void test_Stun_Crc32_ShortTail( void )
+{
+    CheckLengthsAndOffsets( 8, 31, 0, 0 );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate Stun_Crc32 with buffers long enough for the accelerated
+ * kernels, at every offset and with every tail length.
+ */
+void test_Stun_Crc32_LongBuffers( void )
+{
+    CheckLengthsAndOffsets( 60, 160, 0, 7 );
+}
+
+/*-----------------------------------------------------------*/
@@ -0,0 +1,911 @@
+/* Unity includes. */
+#include "unity.h"
+#include "catch_assert.h"
+
+/* Standard includes. */
+#include <string.h>
+#include <stdint.h>
+
+/* API includes. */
+#include "stun_credential_cache.h"
+
+/* ===========================  EXTERN VARIABLES  =========================== */
+
+#define CACHE_ENTRY_COUNT   8
+
+static StunCredentialCacheEntry_t cacheEntries[ CACHE_ENTRY_COUNT ];
+static StunCredentialCache_t cache;
+
+/* Username = U+30DE U+30C8 U+30EA U+30C3 U+30AF U+30B9 in UTF-8. */
+static const uint8_t username[] =
+{
+    0xE3, 0x83, 0x9E, 0xE3, 0x83, 0x88, 0xE3, 0x83, 0xAA,
+    0xE3, 0x83, 0x83, 0xE3, 0x82, 0xAF, 0xE3, 0x82, 0xB9
+};
+static const uint8_t realm[] = "example.org";
+static const uint8_t password[] = "TheMatrIX";
+
+/* Sample request with long-term authentication from RFC 5769 section 2.4, up
+ * to the MESSAGE-INTEGRITY attribute. */
+static const uint8_t sampleRequest[] =
+{
+    /* Message Type = STUN Binding Request, Message Length = 0x60. */
+    0x00, 0x01, 0x00, 0x60,
+    /* Magic cookie. */
+    0x21, 0x12, 0xA4, 0x42,
+    /* Transaction ID. */
+    0x78, 0xAD, 0x34, 0x33, 0xC6, 0xAD, 0x72, 0xC0, 0x29, 0xDA, 0x41, 0x2E,
+    /* Attribute Type = USERNAME, Attribute Length = 18. */
+    0x00, 0x06, 0x00, 0x12,
+    0xE3, 0x83, 0x9E, 0xE3, 0x83, 0x88, 0xE3, 0x83, 0xAA,
+    0xE3, 0x83, 0x83, 0xE3, 0x82, 0xAF, 0xE3, 0x82, 0xB9, 0x00, 0x00,
+    /* Attribute Type = NONCE, Attribute Length = 28, Value = "f//499k954d6OL34oL9FSTvy64sA". */
+    0x00, 0x15, 0x00, 0x1C,
+    0x66, 0x2F, 0x2F, 0x34, 0x39, 0x39, 0x6B, 0x39, 0x35, 0x34, 0x64, 0x36, 0x4F, 0x4C,
+    0x33, 0x34, 0x6F, 0x4C, 0x39, 0x46, 0x53, 0x54, 0x76, 0x79, 0x36, 0x34, 0x73, 0x41,
+    /* Attribute Type = REALM, Attribute Length = 11, Value = "example.org" and padding. */
+    0x00, 0x14, 0x00, 0x0B,
+    0x65, 0x78, 0x61, 0x6D, 0x70, 0x6C, 0x65, 0x2E, 0x6F, 0x72, 0x67, 0x00
+};
+
+/* MESSAGE-INTEGRITY value of the sample request. */
+static const uint8_t sampleRequestIntegrity[] =
+{
+    0xF6, 0x70, 0x24, 0x65, 0x6D, 0xD6, 0x4A, 0x3E, 0x02, 0xB8,
+    0xE0, 0x71, 0x2E, 0x85, 0xC9, 0xA2, 0x8C, 0xA8, 0x96, 0x66
+};
+
+/* Checks that pIntegrityKey is the key derived from the credentials. */
+static void CheckKey( const uint8_t * pUser,
+                      uint16_t userLength,
+                      const uint8_t * pRealmValue,
+                      uint16_t realmLength,
+                      const StunIntegrityKey_t * pIntegrityKey )
+{
+    StunIntegrityKey_t expectedKey;
+    uint8_t longTermKey[ STUN_INTEGRITY_LONG_TERM_KEY_LENGTH ];
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunIntegrity_DeriveLongTermKey( pUser,
+                                                        userLength,
+                                                        pRealmValue,
+                                                        realmLength,
+                                                        &( password[ 0 ] ),
+                                                        sizeof( password ) - 1,
+                                                        &( longTermKey[ 0 ] ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunIntegrity_InitKey( &( expectedKey ),
+                                              &( longTermKey[ 0 ] ),
+                                              sizeof( longTermKey ),
+                                              NULL ) );
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedKey ),
+                                   pIntegrityKey,
+                                   sizeof( expectedKey ) );
+}
+
+/* Gets the key of the credentials with the test password and checks it. */
+static const StunIntegrityKey_t * GetAndCheckKey( const uint8_t * pUser,
+                                                  uint16_t userLength,
+                                                  const uint8_t * pRealmValue,
+                                                  uint16_t realmLength )
+{
+    const StunIntegrityKey_t * pIntegrityKey = NULL;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunCredentialCache_GetKey( &( cache ),
+                                                   pUser,
+                                                   userLength,
+                                                   pRealmValue,
+                                                   realmLength,
+                                                   &( password[ 0 ] ),
+                                                   sizeof( password ) - 1,
+                                                   &( pIntegrityKey ) ) );
+
+    CheckKey( pUser, userLength, pRealmValue, realmLength, pIntegrityKey );
+
+    return pIntegrityKey;
+}
+
+/* Caches two credentials with the same hash and checks that each one keeps
+ * its own entry. */
+static void CheckHashCollision( const char * pFirstUser,
+                                const char * pFirstRealm,
+                                const char * pSecondUser,
+                                const char * pSecondRealm )
+{
+    const StunIntegrityKey_t * pFirstKey, * pSecondKey;
+
+    pFirstKey = GetAndCheckKey( ( const uint8_t * ) pFirstUser,
+                                ( uint16_t ) strlen( pFirstUser ),
+                                ( const uint8_t * ) pFirstRealm,
+                                ( uint16_t ) strlen( pFirstRealm ) );
+    pSecondKey = GetAndCheckKey( ( const uint8_t * ) pSecondUser,
+                                 ( uint16_t ) strlen( pSecondUser ),
+                                 ( const uint8_t * ) pSecondRealm,
+                                 ( uint16_t ) strlen( pSecondRealm ) );
+
+    TEST_ASSERT_TRUE( pFirstKey != pSecondKey );
+
+    /* Both are hits now. */
+    TEST_ASSERT_EQUAL_PTR( pFirstKey,
+                           GetAndCheckKey( ( const uint8_t * ) pFirstUser,
+                                           ( uint16_t ) strlen( pFirstUser ),
+                                           ( const uint8_t * ) pFirstRealm,
+                                           ( uint16_t ) strlen( pFirstRealm ) ) );
+    TEST_ASSERT_EQUAL_PTR( pSecondKey,
+                           GetAndCheckKey( ( const uint8_t * ) pSecondUser,
+                                           ( uint16_t ) strlen( pSecondUser ),
+                                           ( const uint8_t * ) pSecondRealm,
+                                           ( uint16_t ) strlen( pSecondRealm ) ) );
+}
+
+/* Returns the number of entries in use with the credentials. */
+static size_t CountEntries( const uint8_t * pUser,
+                            uint16_t userLength )
+{
+    size_t i, count = 0;
+
+    for( i = 0; i < cache.entryCount; i++ )
+    {
+        if( ( cacheEntries[ i ].inUse != 0 ) &&
+            ( cacheEntries[ i ].usernameLength == userLength ) &&
+            ( memcmp( &( cacheEntries[ i ].username[ 0 ] ), pUser, userLength ) == 0 ) )
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+void setUp( void )
+{
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunCredentialCache_Init( &( cache ),
+                                                 &( cacheEntries[ 0 ] ),
+                                                 CACHE_ENTRY_COUNT ) );
+}
+
+void tearDown( void )
+{
+}
+
+/* ==============================  Test Cases ============================== */
+
+/**
+ * @brief Validate the key returned by StunCredentialCache_GetKey against the
+ * RFC 5769 sample request with long-term authentication.
+ */
+void test_StunCredentialCache_GetKey_Rfc5769( void )
+{
+    StunResult_t result;
+    const StunIntegrityKey_t * pIntegrityKey = NULL;
+    uint8_t hmac[ STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH ];
+
+    result = StunCredentialCache_GetKey( &( cache ),
+                                         &( username[ 0 ] ),
+                                         sizeof( username ),
+                                         &( realm[ 0 ] ),
+                                         sizeof( realm ) - 1,
+                                         &( password[ 0 ] ),
+                                         sizeof( password ) - 1,
+                                         &( pIntegrityKey ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_NOT_NULL( pIntegrityKey );
+
+    result = StunIntegrity_ComputeHmac( pIntegrityKey,
+                                        &( sampleRequest[ 0 ] ),
+                                        sizeof( sampleRequest ),
+                                        &( hmac[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( sampleRequestIntegrity[ 0 ] ),
+                                   &( hmac[ 0 ] ),
+                                   STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that the key is only derived on the first lookup of a
+ * (username, realm) pair.
+ */
+void test_StunCredentialCache_GetKey_Hit( void )
+{
+    StunResult_t result;
+    const StunIntegrityKey_t * pFirstKey = NULL, * pSecondKey = NULL;
+    uint8_t hmac[ STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH ];
+    const uint8_t otherPassword[] = "TheMatrIY";
+
+    result = StunCredentialCache_GetKey( &( cache ),
+                                         &( username[ 0 ] ),
+                                         sizeof( username ),
+                                         &( realm[ 0 ] ),
+                                         sizeof( realm ) - 1,
+                                         &( password[ 0 ] ),
+                                         sizeof( password ) - 1,
+                                         &( pFirstKey ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    /* The password is not used on a hit. */
+    result = StunCredentialCache_GetKey( &( cache ),
+                                         &( username[ 0 ] ),
+                                         sizeof( username ),
+                                         &( realm[ 0 ] ),
+                                         sizeof( realm ) - 1,
+                                         &( otherPassword[ 0 ] ),
+                                         sizeof( otherPassword ) - 1,
+                                         &( pSecondKey ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL_PTR( pFirstKey,
+                           pSecondKey );
+
+    result = StunIntegrity_ComputeHmac( pSecondKey,
+                                        &( sampleRequest[ 0 ] ),
+                                        sizeof( sampleRequest ),
+                                        &( hmac[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( sampleRequestIntegrity[ 0 ] ),
+                                   &( hmac[ 0 ] ),
+                                   STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that the key is derived again with the new password after
+ * StunCredentialCache_Remove.
+ */
+void test_StunCredentialCache_Remove_Pass( void )
+{
+    StunResult_t result;
+    const StunIntegrityKey_t * pIntegrityKey = NULL;
+    uint8_t hmac[ STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH ];
+    const uint8_t otherPassword[] = "TheMatrIY";
+
+    ( void ) GetAndCheckKey( &( username[ 0 ] ),
+                             sizeof( username ),
+                             &( realm[ 0 ] ),
+                             sizeof( realm ) - 1 );
+
+    result = StunCredentialCache_Remove( &( cache ),
+                                         &( username[ 0 ] ),
+                                         sizeof( username ),
+                                         &( realm[ 0 ] ),
+                                         sizeof( realm ) - 1 );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( 0,
+                       CountEntries( &( username[ 0 ] ), sizeof( username ) ) );
+
+    result = StunCredentialCache_GetKey( &( cache ),
+                                         &( username[ 0 ] ),
+                                         sizeof( username ),
+                                         &( realm[ 0 ] ),
+                                         sizeof( realm ) - 1,
+                                         &( otherPassword[ 0 ] ),
+                                         sizeof( otherPassword ) - 1,
+                                         &( pIntegrityKey ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunIntegrity_ComputeHmac( pIntegrityKey,
+                                        &( sampleRequest[ 0 ] ),
+                                        sizeof( sampleRequest ),
+                                        &( hmac[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_TRUE( memcmp( &( sampleRequestIntegrity[ 0 ] ),
+                              &( hmac[ 0 ] ),
+                              STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH ) != 0 );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunCredentialCache_Remove with credentials that are not in
+ * the cache.
+ */
+void test_StunCredentialCache_Remove_NotFound( void )
+{
+    StunResult_t result;
+    const uint8_t otherUser[] = "other";
+
+    ( void ) GetAndCheckKey( &( username[ 0 ] ),
+                             sizeof( username ),
+                             &( realm[ 0 ] ),
+                             sizeof( realm ) - 1 );
+
+    result = StunCredentialCache_Remove( &( cache ),
+                                         &( otherUser[ 0 ] ),
+                                         sizeof( otherUser ) - 1,
+                                         &( realm[ 0 ] ),
+                                         sizeof( realm ) - 1 );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( 1,
+                       CountEntries( &( username[ 0 ] ), sizeof( username ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that every lookup returns the key of its own credentials
+ * when there are more credentials than entries.
+ */
+void test_StunCredentialCache_GetKey_Eviction( void )
+{
+    uint8_t user[ 8 ];
+    size_t round, i;
+
+    for( round = 0; round < 2; round++ )
+    {
+        for( i = 0; i < ( 3 * CACHE_ENTRY_COUNT ); i++ )
+        {
+            memcpy( &( user[ 0 ] ), "user", 4 );
+            user[ 4 ] = ( uint8_t ) ( 'A' + i );
+
+            ( void ) GetAndCheckKey( &( user[ 0 ] ),
+                                     5,
+                                     &( realm[ 0 ] ),
+                                     sizeof( realm ) - 1 );
+        }
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that one of the credentials in the probe window is evicted
+ * when all the entries of the window are in use.
+ */
+void test_StunCredentialCache_GetKey_FullProbeWindow( void )
+{
+    uint8_t user[ 8 ];
+    size_t i, remainingCount = 0;
+
+    /* With as many entries as the probe length, every probe window covers the
+     * whole cache. */
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunCredentialCache_Init( &( cache ),
+                                                 &( cacheEntries[ 0 ] ),
+                                                 STUN_CREDENTIAL_CACHE_PROBE_LENGTH ) );
+
+    memcpy( &( user[ 0 ] ), "user", 4 );
+
+    for( i = 0; i <= STUN_CREDENTIAL_CACHE_PROBE_LENGTH; i++ )
+    {
+        user[ 4 ] = ( uint8_t ) ( 'A' + i );
+
+        ( void ) GetAndCheckKey( &( user[ 0 ] ),
+                                 5,
+                                 &( realm[ 0 ] ),
+                                 sizeof( realm ) - 1 );
+    }
+
+    /* The last credentials are cached, and exactly one of the others was
+     * evicted. */
+    TEST_ASSERT_EQUAL( 1,
+                       CountEntries( &( user[ 0 ] ), 5 ) );
+
+    for( i = 0; i < STUN_CREDENTIAL_CACHE_PROBE_LENGTH; i++ )
+    {
+        user[ 4 ] = ( uint8_t ) ( 'A' + i );
+        remainingCount += CountEntries( &( user[ 0 ] ), 5 );
+    }
+
+    TEST_ASSERT_EQUAL( STUN_CREDENTIAL_CACHE_PROBE_LENGTH - 1,
+                       remainingCount );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate a cache with fewer entries than the probe length.
+ */
+void test_StunCredentialCache_GetKey_FewerEntriesThanProbeLength( void )
+{
+    uint8_t user[ 8 ];
+    size_t round, i;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunCredentialCache_Init( &( cache ),
+                                                 &( cacheEntries[ 0 ] ),
+                                                 2 ) );
+
+    memcpy( &( user[ 0 ] ), "user", 4 );
+
+    for( round = 0; round < 2; round++ )
+    {
+        for( i = 0; i < 3; i++ )
+        {
+            user[ 4 ] = ( uint8_t ) ( 'A' + i );
+
+            ( void ) GetAndCheckKey( &( user[ 0 ] ),
+                                     5,
+                                     &( realm[ 0 ] ),
+                                     sizeof( realm ) - 1 );
+        }
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunCredentialCache_GetKey with an empty username.
+ */
+void test_StunCredentialCache_GetKey_EmptyUsername( void )
+{
+    const StunIntegrityKey_t * pIntegrityKey;
+
+    pIntegrityKey = GetAndCheckKey( &( username[ 0 ] ),
+                                    0,
+                                    &( realm[ 0 ] ),
+                                    sizeof( realm ) - 1 );
+
+    TEST_ASSERT_EQUAL_PTR( pIntegrityKey,
+                           GetAndCheckKey( &( username[ 0 ] ),
+                                           0,
+                                           &( realm[ 0 ] ),
+                                           sizeof( realm ) - 1 ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunCredentialCache_GetKey with an empty realm.
+ */
+void test_StunCredentialCache_GetKey_EmptyRealm( void )
+{
+    const StunIntegrityKey_t * pIntegrityKey;
+
+    pIntegrityKey = GetAndCheckKey( &( username[ 0 ] ),
+                                    sizeof( username ),
+                                    &( realm[ 0 ] ),
+                                    0 );
+
+    TEST_ASSERT_EQUAL_PTR( pIntegrityKey,
+                           GetAndCheckKey( &( username[ 0 ] ),
+                                           sizeof( username ),
+                                           &( realm[ 0 ] ),
+                                           0 ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that the username and the realm are not interchangeable
+ * when one of them is empty.
+ */
+void test_StunCredentialCache_GetKey_EmptyUsernameAndEmptyRealm( void )
+{
+    const uint8_t value[] = "user";
+
+    CheckHashCollision( "", "user", "user", "" );
+    TEST_ASSERT_EQUAL( 2,
+                       CountEntries( &( value[ 0 ] ), 0 ) +
+                       CountEntries( &( value[ 0 ] ), sizeof( value ) - 1 ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate two credentials with the same hash and usernames of the
+ * same length.
+ */
+void test_StunCredentialCache_GetKey_HashCollisionUsername( void )
+{
+    /* FNV-1a of both "q4usx9ez:example.org" and "a554mfcj:example.org" is
+     * 0x06B682D4. */
+    CheckHashCollision( "q4usx9ez", "example.org", "a554mfcj", "example.org" );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate two credentials with the same hash and realms of the same
+ * length.
+ */
+void test_StunCredentialCache_GetKey_HashCollisionRealm( void )
+{
+    /* FNV-1a of both "user:bucpo8a5" and "user:8k3pa6p6" is 0x85404E53. */
+    CheckHashCollision( "user", "bucpo8a5", "user", "8k3pa6p6" );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate two credentials with the same hash and usernames of
+ * different lengths.
+ */
+void test_StunCredentialCache_GetKey_HashCollisionUsernameLength( void )
+{
+    /* FNV-1a of both "elrwsz4:example.org" and "y0h1kakow:example.org" is
+     * 0x5A2F6C1E. */
+    CheckHashCollision( "elrwsz4", "example.org", "y0h1kakow", "example.org" );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate two credentials with the same hash and realms of different
+ * lengths.
+ */
+void test_StunCredentialCache_GetKey_HashCollisionRealmLength( void )
+{
+    /* FNV-1a of both "ippzj9us:gw2hwc" and "dxrc54pz:yvjpo8tn6b" is
+     * 0xA014B65D. */
+    CheckHashCollision( "ippzj9us", "gw2hwc", "dxrc54pz", "yvjpo8tn6b" );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunCredentialCache_GetKey with a username that is too long
+ * to be cached.
+ */
+void test_StunCredentialCache_GetKey_UsernameTooLong( void )
+{
+    StunResult_t result;
+    const StunIntegrityKey_t * pIntegrityKey = NULL;
+    uint8_t longValue[ STUN_CREDENTIAL_CACHE_MAX_USERNAME_LENGTH + 1 ] = { 0 };
+
+    result = StunCredentialCache_GetKey( &( cache ),
+                                         &( longValue[ 0 ] ),
+                                         sizeof( longValue ),
+                                         &( realm[ 0 ] ),
+                                         sizeof( realm ) - 1,
+                                         &( password[ 0 ] ),
+                                         sizeof( password ) - 1,
+                                         &( pIntegrityKey ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OUT_OF_MEMORY,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunCredentialCache_GetKey with a realm that is too long to
+ * be cached.
+ */
+void test_StunCredentialCache_GetKey_RealmTooLong( void )
+{
+    StunResult_t result;
+    const StunIntegrityKey_t * pIntegrityKey = NULL;
+    uint8_t longValue[ STUN_CREDENTIAL_CACHE_MAX_REALM_LENGTH + 1 ] = { 0 };
+
+    result = StunCredentialCache_GetKey( &( cache ),
+                                         &( username[ 0 ] ),
+                                         sizeof( username ),
+                                         &( longValue[ 0 ] ),
+                                         sizeof( longValue ),
+                                         &( password[ 0 ] ),
+                                         sizeof( password ) - 1,
+                                         &( pIntegrityKey ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OUT_OF_MEMORY,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunCredentialCache_GetKey with an empty password.
+ */
+void test_StunCredentialCache_GetKey_EmptyPassword( void )
+{
+    StunResult_t result;
+    const StunIntegrityKey_t * pIntegrityKey = NULL;
+    StunIntegrityKey_t expectedKey;
+    uint8_t longTermKey[ STUN_INTEGRITY_LONG_TERM_KEY_LENGTH ];
+
+    result = StunCredentialCache_GetKey( &( cache ),
+                                         &( username[ 0 ] ),
+                                         sizeof( username ),
+                                         &( realm[ 0 ] ),
+                                         sizeof( realm ) - 1,
+                                         NULL,
+                                         0,
+                                         &( pIntegrityKey ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    ( void ) StunIntegrity_DeriveLongTermKey( &( username[ 0 ] ),
+                                              sizeof( username ),
+                                              &( realm[ 0 ] ),
+                                              sizeof( realm ) - 1,
+                                              NULL,
+                                              0,
+                                              &( longTermKey[ 0 ] ) );
+    ( void ) StunIntegrity_InitKey( &( expectedKey ),
+                                    &( longTermKey[ 0 ] ),
+                                    sizeof( longTermKey ),
+                                    NULL );
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedKey ),
+                                   pIntegrityKey,
+                                   sizeof( expectedKey ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunCredentialCache_Init with a NULL cache.
+ */
+void test_StunCredentialCache_Init_NullCache( void )
+{
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunCredentialCache_Init( NULL,
+                                                 &( cacheEntries[ 0 ] ),
+                                                 CACHE_ENTRY_COUNT ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunCredentialCache_Init with NULL entries.
+ */
+void test_StunCredentialCache_Init_NullEntries( void )
+{
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunCredentialCache_Init( &( cache ),
+                                                 NULL,
+                                                 CACHE_ENTRY_COUNT ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunCredentialCache_Init with no entries.
+ */
+void test_StunCredentialCache_Init_ZeroEntries( void )
+{
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunCredentialCache_Init( &( cache ),
+                                                 &( cacheEntries[ 0 ] ),
+                                                 0 ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunCredentialCache_GetKey with a NULL cache.
+ */
+void test_StunCredentialCache_GetKey_NullCache( void )
+{
+    const StunIntegrityKey_t * pIntegrityKey = NULL;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunCredentialCache_GetKey( NULL,
+                                                   &( username[ 0 ] ),
+                                                   sizeof( username ),
+                                                   &( realm[ 0 ] ),
+                                                   sizeof( realm ) - 1,
+                                                   &( password[ 0 ] ),
+                                                   sizeof( password ) - 1,
+                                                   &( pIntegrityKey ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunCredentialCache_GetKey with a cache that is not
+ * initialized.
+ */
+void test_StunCredentialCache_GetKey_UninitializedCache( void )
+{
+    StunCredentialCache_t uninitializedCache = { 0 };
+    const StunIntegrityKey_t * pIntegrityKey = NULL;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunCredentialCache_GetKey( &( uninitializedCache ),
+                                                   &( username[ 0 ] ),
+                                                   sizeof( username ),
+                                                   &( realm[ 0 ] ),
+                                                   sizeof( realm ) - 1,
+                                                   &( password[ 0 ] ),
+                                                   sizeof( password ) - 1,
+                                                   &( pIntegrityKey ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunCredentialCache_GetKey with a cache without entries.
+ */
+void test_StunCredentialCache_GetKey_ZeroEntries( void )
+{
+    StunCredentialCache_t emptyCache = { 0 };
+    const StunIntegrityKey_t * pIntegrityKey = NULL;
+
+    emptyCache.pEntries = &( cacheEntries[ 0 ] );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunCredentialCache_GetKey( &( emptyCache ),
+                                                   &( username[ 0 ] ),
+                                                   sizeof( username ),
+                                                   &( realm[ 0 ] ),
+                                                   sizeof( realm ) - 1,
+                                                   &( password[ 0 ] ),
+                                                   sizeof( password ) - 1,
+                                                   &( pIntegrityKey ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunCredentialCache_GetKey with a NULL username.
+ */
+void test_StunCredentialCache_GetKey_NullUsername( void )
+{
+    const StunIntegrityKey_t * pIntegrityKey = NULL;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunCredentialCache_GetKey( &( cache ),
+                                                   NULL,
+                                                   sizeof( username ),
+                                                   &( realm[ 0 ] ),
+                                                   sizeof( realm ) - 1,
+                                                   &( password[ 0 ] ),
+                                                   sizeof( password ) - 1,
+                                                   &( pIntegrityKey ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunCredentialCache_GetKey with a NULL realm.
+ */
+void test_StunCredentialCache_GetKey_NullRealm( void )
+{
+    const StunIntegrityKey_t * pIntegrityKey = NULL;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunCredentialCache_GetKey( &( cache ),
+                                                   &( username[ 0 ] ),
+                                                   sizeof( username ),
+                                                   NULL,
+                                                   sizeof( realm ) - 1,
+                                                   &( password[ 0 ] ),
+                                                   sizeof( password ) - 1,
+                                                   &( pIntegrityKey ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunCredentialCache_GetKey with a NULL password of non-zero
+ * length.
+ */
+void test_StunCredentialCache_GetKey_NullPassword( void )
+{
+    const StunIntegrityKey_t * pIntegrityKey = NULL;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunCredentialCache_GetKey( &( cache ),
+                                                   &( username[ 0 ] ),
+                                                   sizeof( username ),
+                                                   &( realm[ 0 ] ),
+                                                   sizeof( realm ) - 1,
+                                                   NULL,
+                                                   sizeof( password ) - 1,
+                                                   &( pIntegrityKey ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunCredentialCache_GetKey with a NULL output key.
+ */
+void test_StunCredentialCache_GetKey_NullIntegrityKey( void )
+{
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunCredentialCache_GetKey( &( cache ),
+                                                   &( username[ 0 ] ),
+                                                   sizeof( username ),
+                                                   &( realm[ 0 ] ),
+                                                   sizeof( realm ) - 1,
+                                                   &( password[ 0 ] ),
+                                                   sizeof( password ) - 1,
+                                                   NULL ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunCredentialCache_Remove with a NULL cache.
+ */
+void test_StunCredentialCache_Remove_NullCache( void )
+{
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunCredentialCache_Remove( NULL,
+                                                   &( username[ 0 ] ),
+                                                   sizeof( username ),
+                                                   &( realm[ 0 ] ),
+                                                   sizeof( realm ) - 1 ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunCredentialCache_Remove with a cache that is not
+ * initialized.
+ */
+void test_StunCredentialCache_Remove_UninitializedCache( void )
+{
+    StunCredentialCache_t uninitializedCache = { 0 };
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunCredentialCache_Remove( &( uninitializedCache ),
+                                                   &( username[ 0 ] ),
+                                                   sizeof( username ),
+                                                   &( realm[ 0 ] ),
+                                                   sizeof( realm ) - 1 ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunCredentialCache_Remove with a cache without entries.
+ */
+void test_StunCredentialCache_Remove_ZeroEntries( void )
+{
+    StunCredentialCache_t emptyCache = { 0 };
+
+    emptyCache.pEntries = &( cacheEntries[ 0 ] );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunCredentialCache_Remove( &( emptyCache ),
+                                                   &( username[ 0 ] ),
+                                                   sizeof( username ),
+                                                   &( realm[ 0 ] ),
+                                                   sizeof( realm ) - 1 ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunCredentialCache_Remove with a NULL username.
+ */
+void test_StunCredentialCache_Remove_NullUsername( void )
+{
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunCredentialCache_Remove( &( cache ),
+                                                   NULL,
+                                                   sizeof( username ),
+                                                   &( realm[ 0 ] ),
+                                                   sizeof( realm ) - 1 ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunCredentialCache_Remove with a NULL realm.
+ */
+void test_StunCredentialCache_Remove_NullRealm( void )
+{
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunCredentialCache_Remove( &( cache ),
+                                                   &( username[ 0 ] ),
+                                                   sizeof( username ),
+                                                   NULL,
+                                                   sizeof( realm ) - 1 ) );
+}
+
+/*-----------------------------------------------------------*/
@@ -8,6 +8,7 @@
 
 /* API includes. */
 #include "stun_deserializer.h"
+#include "stun_crc32.h"
 #include "stun_endianness.h"
 #include "stun_data_types.h"
 
@@ -21,6 +22,128 @@ void tearDown( void )
 {
 }
 
+/* Largest message accepted by StunDeserializer_Init. */
+static uint8_t largeMessage[ STUN_HEADER_LENGTH + STUN_MAX_MESSAGE_LENGTH ];
+
+static const uint8_t largeMessagePassword[] = "VOkJxbRl1RmTxUk/WvJxBt";
+
+/* ============================  Helper Functions ============================ */
+
+/* Writes a Binding Request with a DATA attribute of dataLength bytes followed
+ * by a valid MESSAGE-INTEGRITY or FINGERPRINT attribute to largeMessage, and
+ * returns the length of the message. */
+static size_t BuildLargeMessage( size_t dataLength,
+                                 StunAttributeType_t trailerType )
+{
+    StunIntegrityKey_t integrityKey;
+    size_t trailerOffset = STUN_HEADER_LENGTH + STUN_ATTRIBUTE_HEADER_LENGTH + dataLength;
+    size_t trailerLength, messageLength;
+    uint32_t crc32Fingerprint;
+
+    trailerLength = ( trailerType == STUN_ATTRIBUTE_TYPE_FINGERPRINT ) ? STUN_ATTRIBUTE_FINGERPRINT_VALUE_LENGTH :
+                                                                         STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH;
+    messageLength = trailerOffset + STUN_ATTRIBUTE_HEADER_LENGTH + trailerLength;
+
+    memset( &( largeMessage[ 0 ] ), 0x5A, messageLength );
+
+    /* Binding Request with the transaction ID of the RFC 5769 samples. */
+    largeMessage[ 0 ] = 0x00;
+    largeMessage[ 1 ] = 0x01;
+    largeMessage[ 2 ] = ( uint8_t ) ( ( messageLength - STUN_HEADER_LENGTH ) >> 8 );
+    largeMessage[ 3 ] = ( uint8_t ) ( messageLength - STUN_HEADER_LENGTH );
+    largeMessage[ 4 ] = 0x21;
+    largeMessage[ 5 ] = 0x12;
+    largeMessage[ 6 ] = 0xA4;
+    largeMessage[ 7 ] = 0x42;
+
+    largeMessage[ 20 ] = 0x00;
+    largeMessage[ 21 ] = ( uint8_t ) STUN_ATTRIBUTE_TYPE_DATA;
+    largeMessage[ 22 ] = ( uint8_t ) ( dataLength >> 8 );
+    largeMessage[ 23 ] = ( uint8_t ) dataLength;
+
+    largeMessage[ trailerOffset ] = ( uint8_t ) ( trailerType >> 8 );
+    largeMessage[ trailerOffset + 1 ] = ( uint8_t ) trailerType;
+    largeMessage[ trailerOffset + 2 ] = 0x00;
+    largeMessage[ trailerOffset + 3 ] = ( uint8_t ) trailerLength;
+
+    /* The trailer is the last attribute, so the length in the header is the
+     * one covered by the hash. */
+    if( trailerType == STUN_ATTRIBUTE_TYPE_FINGERPRINT )
+    {
+        crc32Fingerprint = Stun_Crc32( 0,
+                                       &( largeMessage[ 0 ] ),
+                                       trailerOffset ) ^ STUN_ATTRIBUTE_FINGERPRINT_XOR_VALUE;
+        largeMessage[ trailerOffset + 4 ] = ( uint8_t ) ( crc32Fingerprint >> 24 );
+        largeMessage[ trailerOffset + 5 ] = ( uint8_t ) ( crc32Fingerprint >> 16 );
+        largeMessage[ trailerOffset + 6 ] = ( uint8_t ) ( crc32Fingerprint >> 8 );
+        largeMessage[ trailerOffset + 7 ] = ( uint8_t ) crc32Fingerprint;
+    }
+    else
+    {
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunIntegrity_InitKey( &( integrityKey ),
+                                                  &( largeMessagePassword[ 0 ] ),
+                                                  sizeof( largeMessagePassword ) - 1,
+                                                  NULL ) );
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunIntegrity_ComputeHmac( &( integrityKey ),
+                                                      &( largeMessage[ 0 ] ),
+                                                      trailerOffset,
+                                                      &( largeMessage[ trailerOffset + 4 ] ) ) );
+    }
+
+    return messageLength;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Checks that the FINGERPRINT of a message built by BuildLargeMessage is
+ * verified over the whole message. */
+static void CheckLargeMessageFingerprint( size_t dataLength )
+{
+    StunContext_t ctx = { 0 };
+    StunHeader_t header = { 0 };
+    StunAttribute_t attribute = { 0 };
+    StunHashRange_t range = { 0 };
+    size_t messageLength;
+
+    messageLength = BuildLargeMessage( dataLength,
+                                       STUN_ATTRIBUTE_TYPE_FINGERPRINT );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunDeserializer_Init( &( ctx ),
+                                              &( largeMessage[ 0 ] ),
+                                              messageLength,
+                                              &( header ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunDeserializer_GetNextAttribute( &( ctx ),
+                                                          &( attribute ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunDeserializer_GetNextAttribute( &( ctx ),
+                                                          &( attribute ) ) );
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_FINGERPRINT,
+                       attribute.attributeType );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunDeserializer_GetFingerprintRange( &( ctx ),
+                                                             &( range ) ) );
+    TEST_ASSERT_EQUAL( STUN_HEADER_LENGTH + STUN_ATTRIBUTE_HEADER_LENGTH + dataLength,
+                       range.stunMessageLength );
+    TEST_ASSERT_EQUAL( messageLength - STUN_HEADER_LENGTH,
+                       range.patchedMessageLength );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunDeserializer_VerifyFingerprint( &( ctx ),
+                                                           &( attribute ) ) );
+
+    /* Corrupt the last byte of the DATA value. */
+    largeMessage[ range.stunMessageLength - 1 ] ^= 0x01;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_FINGERPRINT_MISMATCH,
+                       StunDeserializer_VerifyFingerprint( &( ctx ),
+                                                           &( attribute ) ) );
+}
+
 /* ==============================  Test Cases ============================== */
 
 /**
@@ -1149,32 +1272,45 @@ void test_StunDeserializer_GetFingerprintBuffer_NullParams( void )
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetIntegrityBuffer in the happy path.
+ * @brief Validate StunDeserializer_VerifyFingerprint with the sample request
+ * from RFC 5769 and with a corrupted copy of it.
  */
-void test_StunDeserializer_GetIntegrityBuffer_HappyPath( void )
+void test_StunDeserializer_VerifyFingerprint_Rfc5769SampleRequest( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
     StunHeader_t header = { 0 };
     StunAttribute_t attribute = { 0 };
-    uint8_t * pHmacCalculationData;
-    uint16_t hmacCalculationDataLength;
+    size_t i;
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 0x18 (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x18,
+        /* Message Type = STUN Binding Request, Message Length = 0x58 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x58,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
-        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute type = MESSAGE-INTEGRITY (0x0008), Length = 20 bytes. */
+        0xB7, 0xE7, 0xA7, 0x01, 0xBC, 0x34, 0xD6, 0x86, 0xFA, 0x87, 0xDF, 0xAE,
+        /* Attribute Type = SOFTWARE (0x8022), Attribute Length = 16, Value = "STUN test client". */
+        0x80, 0x22, 0x00, 0x10,
+        0x53, 0x54, 0x55, 0x4E, 0x20, 0x74, 0x65, 0x73,
+        0x74, 0x20, 0x63, 0x6C, 0x69, 0x65, 0x6E, 0x74,
+        /* Attribute Type = PRIORITY (0x0024), Attribute Length = 4. */
+        0x00, 0x24, 0x00, 0x04,
+        0x6E, 0x00, 0x01, 0xFF,
+        /* Attribute Type = ICE-CONTROLLED (0x8029), Attribute Length = 8. */
+        0x80, 0x29, 0x00, 0x08,
+        0x93, 0x2F, 0xF9, 0xB1, 0x51, 0x26, 0x3B, 0x36,
+        /* Attribute Type = USERNAME (0x0006), Attribute Length = 9, Value = "evtj:h6vY" and padding. */
+        0x00, 0x06, 0x00, 0x09,
+        0x65, 0x76, 0x74, 0x6A, 0x3A, 0x68, 0x36, 0x76,
+        0x59, 0x20, 0x20, 0x20,
+        /* Attribute Type = MESSAGE-INTEGRITY (0x0008), Attribute Length = 20. */
         0x00, 0x08, 0x00, 0x14,
-        /* Attribute Value = 20 bytes SHA-1 HMAC value. */
-        0x72, 0x64, 0x6D, 0x2F,
-        0x55, 0x77, 0xF4, 0x23,
-        0x73, 0x72, 0x75, 0x6C,
-        0x76, 0x61, 0x74, 0x62,
-        0xAB, 0xCD, 0xDE, 0xEF,
+        0x9A, 0xEA, 0xA7, 0x0C, 0xBF, 0xD8, 0xCB, 0x56, 0x78, 0x1E,
+        0xF2, 0xB5, 0xB2, 0xD3, 0xF2, 0x49, 0xC1, 0xB5, 0x71, 0xA2,
+        /* Attribute Type = FINGERPRINT (0x8028), Attribute Length = 4. */
+        0x80, 0x28, 0x00, 0x04,
+        0xE5, 0x7A, 0x3B, 0xCF,
     };
     size_t serializedMessageLength = sizeof( serializedMessage );
 
@@ -1186,58 +1322,67 @@ void test_StunDeserializer_GetIntegrityBuffer_HappyPath( void )
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
 
-    result = StunDeserializer_GetNextAttribute( &( ctx ),
-                                                &( attribute ) );
+    for( i = 0; i < 6; i++ )
+    {
+        result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                    &( attribute ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
-                       result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_MESSAGE_INTEGRITY,
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           result );
+    }
+
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_FINGERPRINT,
                        attribute.attributeType );
 
-    result = StunDeserializer_GetIntegrityBuffer( &( ctx ),
-                                                  &( pHmacCalculationData ),
-                                                  &( hmacCalculationDataLength ) );
+    result = StunDeserializer_VerifyFingerprint( &( ctx ),
+                                                 &( attribute ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
-    TEST_ASSERT_EQUAL( 20, /* Stun message excluding integrity attribute. */
-                       hmacCalculationDataLength );
-    TEST_ASSERT_EQUAL_PTR( &( serializedMessage[ 0 ] ),
-                           pHmacCalculationData );
-    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( serializedMessage[ 0 ] ),
-                                   pHmacCalculationData,
-                                   hmacCalculationDataLength );
+
+    /* Corrupt the PRIORITY value. */
+    serializedMessage[ 44 ] ^= 0x01;
+
+    result = StunDeserializer_VerifyFingerprint( &( ctx ),
+                                                 &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_FINGERPRINT_MISMATCH,
+                       result );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetIntegrityBuffer in case of null parameters.
+ * @brief Validate StunDeserializer_VerifyFingerprint incase of bad parameters.
  */
-void test_StunDeserializer_GetIntegrityBuffer_NullParams( void )
+void test_StunDeserializer_VerifyFingerprint_BadParams( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
-    uint8_t * pHmacCalculationData;
-    uint16_t hmacCalculationDataLength;
+    StunAttribute_t attribute = { 0 };
+    uint8_t attributeValue[ 4 ] = { 0 };
 
-    result = StunDeserializer_GetIntegrityBuffer( NULL,
-                                                  &( pHmacCalculationData ),
-                                                  &( hmacCalculationDataLength ) );
+    attribute.attributeType = STUN_ATTRIBUTE_TYPE_FINGERPRINT;
+    attribute.attributeValueLength = sizeof( attributeValue );
+    attribute.pAttributeValue = &( attributeValue[ 0 ] );
+
+    result = StunDeserializer_VerifyFingerprint( NULL,
+                                                 &( attribute ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
                        result );
 
-    result = StunDeserializer_GetIntegrityBuffer( &( ctx ),
-                                                  NULL,
-                                                  &( hmacCalculationDataLength ) );
+    result = StunDeserializer_VerifyFingerprint( &( ctx ),
+                                                 NULL );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
                        result );
 
-    result = StunDeserializer_GetIntegrityBuffer( &( ctx ),
-                                                  &( pHmacCalculationData ),
-                                                  NULL );
+    /* Not a FINGERPRINT attribute. */
+    attribute.attributeType = STUN_ATTRIBUTE_TYPE_PRIORITY;
+
+    result = StunDeserializer_VerifyFingerprint( &( ctx ),
+                                                 &( attribute ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
                        result );
@@ -1246,266 +1391,387 @@ void test_StunDeserializer_GetIntegrityBuffer_NullParams( void )
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_UpdateAttributeNonce in the happy path.
+ * @brief Validate StunDeserializer_VerifyIntegrity with the sample request
+ * from RFC 5769, with a wrong password and with a corrupted copy of it.
  */
-void test_StunDeserializer_UpdateAttributeNonce_HappyPath( void )
+void test_StunDeserializer_VerifyIntegrity_Rfc5769SampleRequest( void )
 {
+    StunContext_t ctx = { 0 };
     StunResult_t result;
-    StunAttribute_t attribute;
-    uint8_t attributeValue[] =
-    {
-        /* Attribute Value = 0x123456789ABCDEF0. */
-        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0,
-    };
-    uint8_t updatedNonce[] =
+    StunHeader_t header = { 0 };
+    StunAttribute_t attribute = { 0 };
+    StunIntegrityKey_t integrityKey, wrongIntegrityKey;
+    size_t i;
+    const uint8_t password[] = "VOkJxbRl1RmTxUk/WvJxBt";
+    const uint8_t wrongPassword[] = "VOkJxbRl1RmTxUk/WvJxBT";
+    uint8_t serializedMessage[] =
     {
-        0xAB, 0xBC, 0xCD, 0xDE, 0xEF, 0x1A, 0x2A, 0x3A
+        /* Message Type = STUN Binding Request, Message Length = 0x58 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x58,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0xB7, 0xE7, 0xA7, 0x01, 0xBC, 0x34, 0xD6, 0x86, 0xFA, 0x87, 0xDF, 0xAE,
+        /* Attribute Type = SOFTWARE (0x8022), Attribute Length = 16, Value = "STUN test client". */
+        0x80, 0x22, 0x00, 0x10,
+        0x53, 0x54, 0x55, 0x4E, 0x20, 0x74, 0x65, 0x73,
+        0x74, 0x20, 0x63, 0x6C, 0x69, 0x65, 0x6E, 0x74,
+        /* Attribute Type = PRIORITY (0x0024), Attribute Length = 4. */
+        0x00, 0x24, 0x00, 0x04,
+        0x6E, 0x00, 0x01, 0xFF,
+        /* Attribute Type = ICE-CONTROLLED (0x8029), Attribute Length = 8. */
+        0x80, 0x29, 0x00, 0x08,
+        0x93, 0x2F, 0xF9, 0xB1, 0x51, 0x26, 0x3B, 0x36,
+        /* Attribute Type = USERNAME (0x0006), Attribute Length = 9, Value = "evtj:h6vY" and padding. */
+        0x00, 0x06, 0x00, 0x09,
+        0x65, 0x76, 0x74, 0x6A, 0x3A, 0x68, 0x36, 0x76,
+        0x59, 0x20, 0x20, 0x20,
+        /* Attribute Type = MESSAGE-INTEGRITY (0x0008), Attribute Length = 20. */
+        0x00, 0x08, 0x00, 0x14,
+        0x9A, 0xEA, 0xA7, 0x0C, 0xBF, 0xD8, 0xCB, 0x56, 0x78, 0x1E,
+        0xF2, 0xB5, 0xB2, 0xD3, 0xF2, 0x49, 0xC1, 0xB5, 0x71, 0xA2,
+        /* Attribute Type = FINGERPRINT (0x8028), Attribute Length = 4. */
+        0x80, 0x28, 0x00, 0x04,
+        0xE5, 0x7A, 0x3B, 0xCF,
     };
-    uint16_t updatedNonceLength = sizeof( updatedNonce );
+    size_t serializedMessageLength = sizeof( serializedMessage );
 
-    attribute.attributeType = STUN_ATTRIBUTE_TYPE_NONCE;
-    attribute.pAttributeValue = &( attributeValue[ 0 ] );
-    attribute.attributeValueLength = sizeof( attributeValue );
+    result = StunIntegrity_InitKey( &( integrityKey ),
+                                    &( password[ 0 ] ),
+                                    sizeof( password ) - 1,
+                                    NULL );
 
-    result = StunDeserializer_UpdateAttributeNonce( &( updatedNonce[ 0 ] ),
-                                                    updatedNonceLength,
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunIntegrity_InitKey( &( wrongIntegrityKey ),
+                                    &( wrongPassword[ 0 ] ),
+                                    sizeof( wrongPassword ) - 1,
+                                    NULL );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunDeserializer_Init( &( ctx ),
+                                    &( serializedMessage[ 0 ] ),
+                                    serializedMessageLength,
+                                    &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    for( i = 0; i < 5; i++ )
+    {
+        result = StunDeserializer_GetNextAttribute( &( ctx ),
                                                     &( attribute ) );
 
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           result );
+    }
+
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_MESSAGE_INTEGRITY,
+                       attribute.attributeType );
+
+    result = StunDeserializer_VerifyIntegrity( &( ctx ),
+                                               &( attribute ),
+                                               &( integrityKey ) );
+
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
-    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( updatedNonce[ 0 ] ),
-                                   attribute.pAttributeValue,
-                                   updatedNonceLength );
+
+    result = StunDeserializer_VerifyIntegrity( &( ctx ),
+                                               &( attribute ),
+                                               &( wrongIntegrityKey ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_INTEGRITY_MISMATCH,
+                       result );
+
+    /* Corrupt the PRIORITY value. */
+    serializedMessage[ 44 ] ^= 0x01;
+
+    result = StunDeserializer_VerifyIntegrity( &( ctx ),
+                                               &( attribute ),
+                                               &( integrityKey ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_INTEGRITY_MISMATCH,
+                       result );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_UpdateAttributeNonce in case of bad parameters.
+ * @brief Validate StunDeserializer_VerifyIntegrity incase of bad parameters.
  */
-void test_StunDeserializer_UpdateAttributeNonce_BadParams( void )
+void test_StunDeserializer_VerifyIntegrity_BadParams( void )
 {
+    StunContext_t ctx = { 0 };
     StunResult_t result;
     StunAttribute_t attribute = { 0 };
-    uint8_t updatedNonce[] =
-    {
-        0xAB, 0xBC, 0xCD, 0xDE, 0xEF, 0x1A, 0x2A, 0x3A
-    };
-    uint16_t updatedNonceLength = sizeof( updatedNonce );
+    StunIntegrityKey_t integrityKey = { 0 };
+    uint8_t attributeValue[ STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH ] = { 0 };
 
-    result = StunDeserializer_UpdateAttributeNonce( NULL,
-                                                    updatedNonceLength,
-                                                    &( attribute ) );
+    attribute.attributeType = STUN_ATTRIBUTE_TYPE_MESSAGE_INTEGRITY;
+    attribute.attributeValueLength = sizeof( attributeValue );
+    attribute.pAttributeValue = &( attributeValue[ 0 ] );
+
+    result = StunDeserializer_VerifyIntegrity( NULL,
+                                               &( attribute ),
+                                               &( integrityKey ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
                        result );
 
-    result = StunDeserializer_UpdateAttributeNonce( &( updatedNonce[ 0 ] ),
-                                                    updatedNonceLength,
-                                                    NULL );
+    result = StunDeserializer_VerifyIntegrity( &( ctx ),
+                                               NULL,
+                                               &( integrityKey ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
                        result );
-}
 
-/*-----------------------------------------------------------*/
+    result = StunDeserializer_VerifyIntegrity( &( ctx ),
+                                               &( attribute ),
+                                               NULL );
 
-/**
- * @brief Validate StunDeserializer_UpdateAttributeNonce in case of wrong attribute type.
- */
-void test_StunDeserializer_UpdateAttributeNonce_WrongAttributeType( void )
-{
-    StunResult_t result;
-    StunAttribute_t attribute = { 0 };
-    uint8_t attributeValue[] =
-    {
-        /* Attribute Value = 0x123456789ABCDEF0. */
-        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0,
-    };
-    uint8_t updatedNonce[] =
-    {
-        0xAB, 0xBC, 0xCD, 0xDE, 0xEF, 0x1A, 0x2A, 0x3A
-    };
-    uint16_t updatedNonceLength = sizeof( updatedNonce );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
 
-    attribute.attributeType = STUN_ATTRIBUTE_TYPE_FINGERPRINT; /* Not nonce. */
-    attribute.pAttributeValue = &( attributeValue[ 0 ] );
-    attribute.attributeValueLength = sizeof( attributeValue );
+    /* Not a MESSAGE-INTEGRITY attribute. */
+    attribute.attributeType = STUN_ATTRIBUTE_TYPE_PRIORITY;
 
-    result = StunDeserializer_UpdateAttributeNonce( &( updatedNonce[ 0 ] ),
-                                                    updatedNonceLength,
-                                                    &( attribute ) );
+    result = StunDeserializer_VerifyIntegrity( &( ctx ),
+                                               &( attribute ),
+                                               &( integrityKey ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+
+    /* No value. */
+    attribute.attributeType = STUN_ATTRIBUTE_TYPE_MESSAGE_INTEGRITY;
+    attribute.pAttributeValue = NULL;
+
+    result = StunDeserializer_VerifyIntegrity( &( ctx ),
+                                               &( attribute ),
+                                               &( integrityKey ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
                        result );
+
+    /* Truncated HMAC. */
+    attribute.pAttributeValue = &( attributeValue[ 0 ] );
+    attribute.attributeValueLength = STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH - 4;
+
+    result = StunDeserializer_VerifyIntegrity( &( ctx ),
+                                               &( attribute ),
+                                               &( integrityKey ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE_LENGTH,
+                       result );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_UpdateAttributeNonce in case of invalid nonce length.
+ * @brief Validate StunDeserializer_VerifyFingerprint with the FINGERPRINT
+ * attribute just before and at 64 KiB into the message.
  */
-void test_StunDeserializer_UpdateAttributeNonce_InvalidNonceLength( void )
+void test_StunDeserializer_VerifyFingerprint_AttributeAt64KiB( void )
 {
-    StunResult_t result;
-    StunAttribute_t attribute = { 0 };
-    uint8_t attributeValue[] =
-    {
-        /* Attribute Value = 0x123456789ABCDEF0. */
-        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0,
-    };
-    /* Updated nonce is not of the same length as the original one. */
-    uint8_t updatedNonce[] =
-    {
-        0xAB, 0xBC, 0xCD, 0xDE,
-    };
-    uint16_t updatedNonceLength = sizeof( updatedNonce );
-
-    attribute.attributeType = STUN_ATTRIBUTE_TYPE_NONCE;
-    attribute.pAttributeValue = &( attributeValue[ 0 ] );
-    attribute.attributeValueLength = sizeof( attributeValue );
-
-    result = StunDeserializer_UpdateAttributeNonce( &( updatedNonce[ 0 ] ),
-                                                    updatedNonceLength,
-                                                    &( attribute ) );
+    /* FINGERPRINT at offset 65532. */
+    CheckLargeMessageFingerprint( 65508 );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
-                       result );
+    /* FINGERPRINT at offset 65536. */
+    CheckLargeMessageFingerprint( 65512 );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_ParseAttributeAddress incase of happy path.
+ * @brief Validate StunDeserializer_VerifyIntegrity with the MESSAGE-INTEGRITY
+ * attribute at the largest offset a message can have it at.
  */
-void test_StunDeserializer_ParseAttributeAddress_HappyPath( void )
+void test_StunDeserializer_VerifyIntegrity_LargestMessage( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
     StunHeader_t header = { 0 };
     StunAttribute_t attribute = { 0 };
-    StunAttributeAddress_t parsedAddress = { 0 };
-    uint8_t expectedAddress[] = { 0x7F, 0x00, 0x00, 0x01, };
-    uint8_t serializedMessage[] =
-    {
-        /* Message Type = STUN Binding Request, Message Length = 0x0C (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x0C,
-        /* Magic cookie. */
-        0x21, 0x12, 0xA4, 0x42,
-        /* Transaction ID. */
-        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute type = MAPPED-ADDRESS (0x0001), Attribute Length = 8. */
-        0x00, 0x01, 0x00, 0x08,
-        /* Address family = IPv4, Port = 0x1234, IP Address = 0x7F000001 (127.0.0.1). */
-        0x00, 0x01, 0x12, 0x34, 0x7F, 0x00, 0x00, 0x01,
-    };
-    size_t serializedMessageLength = sizeof( serializedMessage );
+    StunIntegrityKey_t integrityKey;
+    size_t messageLength, i;
 
-    result = StunDeserializer_Init( &( ctx ),
-                                    &( serializedMessage[ 0 ] ),
-                                    serializedMessageLength,
-                                    &( header ) );
+    /* MESSAGE-INTEGRITY at offset 65528, the message is 65552 bytes. */
+    messageLength = BuildLargeMessage( 65504,
+                                       STUN_ATTRIBUTE_TYPE_MESSAGE_INTEGRITY );
+
+    result = StunIntegrity_InitKey( &( integrityKey ),
+                                    &( largeMessagePassword[ 0 ] ),
+                                    sizeof( largeMessagePassword ) - 1,
+                                    NULL );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
 
-    result = StunDeserializer_GetNextAttribute( &( ctx ),
-                                                &( attribute ) );
+    result = StunDeserializer_Init( &( ctx ),
+                                    &( largeMessage[ 0 ] ),
+                                    messageLength,
+                                    &( header ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_MAPPED_ADDRESS,
+
+    /* Read the DATA attribute and the one after it. */
+    for( i = 0; i < 2; i++ )
+    {
+        result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                    &( attribute ) );
+
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           result );
+    }
+
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_MESSAGE_INTEGRITY,
                        attribute.attributeType );
 
-    result = StunDeserializer_ParseAttributeAddress( &( ctx ),
-                                                     &( attribute ),
-                                                     &( parsedAddress ) );
+    result = StunDeserializer_VerifyIntegrity( &( ctx ),
+                                               &( attribute ),
+                                               &( integrityKey ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ADDRESS_IPv4,
-                       parsedAddress.family );
-    TEST_ASSERT_EQUAL( 0x1234,
-                       parsedAddress.port );
-    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedAddress[ 0 ] ),
-                                   &( parsedAddress.address[ 0 ] ),
-                                   4 );
+
+    /* Corrupt the last byte of the DATA value. */
+    largeMessage[ 65527 ] ^= 0x01;
+
+    result = StunDeserializer_VerifyIntegrity( &( ctx ),
+                                               &( attribute ),
+                                               &( integrityKey ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_INTEGRITY_MISMATCH,
+                       result );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_ParseAttributeAddress in case of null parameters.
+ * @brief Validate that StunDeserializer_GetIntegrityBuffer and
+ * StunDeserializer_GetFingerprintBuffer reject an attribute past 64 KiB, as
+ * the covered length does not fit in their 16-bit output.
  */
-void test_StunDeserializer_ParseAttributeAddress_NullParams( void )
+void test_StunDeserializer_GetHashBuffers_AttributePast64KiB( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
+    StunHeader_t header = { 0 };
     StunAttribute_t attribute = { 0 };
-    StunAttributeAddress_t parsedAddress = { 0 };
-    uint8_t attributeValue[] =
-    {
-        0x00, 0x01, 0x12, 0x34, 0x7F, 0x00, 0x00, 0x01,
-    };
+    uint8_t * pStunMessage = NULL;
+    uint16_t stunMessageLength = 0;
+    size_t messageLength, i;
 
-    result = StunDeserializer_ParseAttributeAddress( &( ctx ),
-                                                     NULL,
-                                                     &( parsedAddress ) );
+    /* FINGERPRINT at offset 65536. */
+    messageLength = BuildLargeMessage( 65512,
+                                       STUN_ATTRIBUTE_TYPE_FINGERPRINT );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+    result = StunDeserializer_Init( &( ctx ),
+                                    &( largeMessage[ 0 ] ),
+                                    messageLength,
+                                    &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
 
-    attribute.attributeType = STUN_ATTRIBUTE_TYPE_MAPPED_ADDRESS;
-    attribute.pAttributeValue = NULL;
-    attribute.attributeValueLength = sizeof( attributeValue );
+    /* Read the DATA attribute and the one after it. */
+    for( i = 0; i < 2; i++ )
+    {
+        result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                    &( attribute ) );
 
-    result = StunDeserializer_ParseAttributeAddress( &( ctx ),
-                                                     &( attribute ),
-                                                     &( parsedAddress ) );
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           result );
+    }
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_FINGERPRINT,
+                       attribute.attributeType );
+
+    result = StunDeserializer_GetFingerprintBuffer( &( ctx ),
+                                                    &( pStunMessage ),
+                                                    &( stunMessageLength ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_MESSAGE_LENGTH,
                        result );
+    TEST_ASSERT_NULL( pStunMessage );
 
-    attribute.pAttributeValue = &( attributeValue[ 0 ] );
-    attribute.attributeValueLength = sizeof( attributeValue );
+    /* A MESSAGE-INTEGRITY attribute cannot start past 64 KiB in a message
+     * accepted by StunDeserializer_Init, so the context is set by hand. */
+    ctx.currentIndex = 65536 + STUN_ATTRIBUTE_HEADER_LENGTH + STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH;
 
-    result = StunDeserializer_ParseAttributeAddress( &( ctx ),
-                                                     &( attribute ),
-                                                     NULL );
+    result = StunDeserializer_GetIntegrityBuffer( &( ctx ),
+                                                  &( pStunMessage ),
+                                                  &( stunMessageLength ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_MESSAGE_LENGTH,
                        result );
+    TEST_ASSERT_NULL( pStunMessage );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_ParseAttributeAddress (XOR Mapped Type) incase of happy path.
+ * @brief Validate StunDeserializer_GetIntegrityRange and
+ * StunDeserializer_GetFingerprintRange, and that verifying the RFC 5769
+ * sample request does not modify it.
  */
-void test_StunDeserializer_ParseAttributeAddress_XorMapped_HappyPath( void )
+void test_StunDeserializer_GetHashRanges_Rfc5769SampleRequest( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
     StunHeader_t header = { 0 };
     StunAttribute_t attribute = { 0 };
-    StunAttributeAddress_t parsedAddress = { 0 };
-    uint8_t expectedAddress[] = { 0x7F, 0x00, 0x00, 0x01 };
+    StunHashRange_t range = { 0 };
+    StunIntegrityKey_t integrityKey;
+    size_t i;
+    const uint8_t password[] = "VOkJxbRl1RmTxUk/WvJxBt";
+    uint8_t originalMessage[ 108 ];
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 0x0C (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x0C,
+        /* Message Type = STUN Binding Request, Message Length = 0x58 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x58,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
-        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute type = XOR-MAPPED-ADDRESS (0x0020), Attribute Length = 8. */
-        0x00, 0x20, 0x00, 0x08,
-        /* Address family = IPv4, Port = 0x3326 (0x1234 XOR'd with 2 msb of cookie),
-         * IP Address = 0x5E12A443 (127.0.0.1 XOR'd with cookie). */
-        0x00, 0x01, 0x33, 0x26, 0x5E, 0x12, 0xA4, 0x43,
+        0xB7, 0xE7, 0xA7, 0x01, 0xBC, 0x34, 0xD6, 0x86, 0xFA, 0x87, 0xDF, 0xAE,
+        /* Attribute Type = SOFTWARE (0x8022), Attribute Length = 16, Value = "STUN test client". */
+        0x80, 0x22, 0x00, 0x10,
+        0x53, 0x54, 0x55, 0x4E, 0x20, 0x74, 0x65, 0x73,
+        0x74, 0x20, 0x63, 0x6C, 0x69, 0x65, 0x6E, 0x74,
+        /* Attribute Type = PRIORITY (0x0024), Attribute Length = 4. */
+        0x00, 0x24, 0x00, 0x04,
+        0x6E, 0x00, 0x01, 0xFF,
+        /* Attribute Type = ICE-CONTROLLED (0x8029), Attribute Length = 8. */
+        0x80, 0x29, 0x00, 0x08,
+        0x93, 0x2F, 0xF9, 0xB1, 0x51, 0x26, 0x3B, 0x36,
+        /* Attribute Type = USERNAME (0x0006), Attribute Length = 9, Value = "evtj:h6vY" and padding. */
+        0x00, 0x06, 0x00, 0x09,
+        0x65, 0x76, 0x74, 0x6A, 0x3A, 0x68, 0x36, 0x76,
+        0x59, 0x20, 0x20, 0x20,
+        /* Attribute Type = MESSAGE-INTEGRITY (0x0008), Attribute Length = 20. */
+        0x00, 0x08, 0x00, 0x14,
+        0x9A, 0xEA, 0xA7, 0x0C, 0xBF, 0xD8, 0xCB, 0x56, 0x78, 0x1E,
+        0xF2, 0xB5, 0xB2, 0xD3, 0xF2, 0x49, 0xC1, 0xB5, 0x71, 0xA2,
+        /* Attribute Type = FINGERPRINT (0x8028), Attribute Length = 4. */
+        0x80, 0x28, 0x00, 0x04,
+        0xE5, 0x7A, 0x3B, 0xCF,
     };
     size_t serializedMessageLength = sizeof( serializedMessage );
 
+    memcpy( &( originalMessage[ 0 ] ), &( serializedMessage[ 0 ] ), sizeof( originalMessage ) );
+
+    result = StunIntegrity_InitKey( &( integrityKey ),
+                                    &( password[ 0 ] ),
+                                    sizeof( password ) - 1,
+                                    NULL );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
     result = StunDeserializer_Init( &( ctx ),
                                     &( serializedMessage[ 0 ] ),
                                     serializedMessageLength,
@@ -1514,115 +1780,134 @@ void test_StunDeserializer_ParseAttributeAddress_XorMapped_HappyPath( void )
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
 
+    /* No attribute has been read yet. */
+    result = StunDeserializer_GetIntegrityRange( &( ctx ),
+                                                 &( range ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_MESSAGE_LENGTH,
+                       result );
+
+    for( i = 0; i < 5; i++ )
+    {
+        result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                    &( attribute ) );
+
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           result );
+    }
+
+    result = StunDeserializer_GetIntegrityRange( &( ctx ),
+                                                 &( range ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL_PTR( &( serializedMessage[ 0 ] ),
+                           range.pStunMessage );
+    TEST_ASSERT_EQUAL( 76,
+                       range.stunMessageLength );
+    TEST_ASSERT_EQUAL( 0x50,
+                       range.patchedMessageLength );
+
+    result = StunDeserializer_VerifyIntegrity( &( ctx ),
+                                               &( attribute ),
+                                               &( integrityKey ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
     result = StunDeserializer_GetNextAttribute( &( ctx ),
                                                 &( attribute ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_XOR_MAPPED_ADDRESS,
-                       attribute.attributeType );
 
-    result = StunDeserializer_ParseAttributeAddress( &( ctx ),
-                                                     &( attribute ),
-                                                     &( parsedAddress ) );
+    result = StunDeserializer_GetFingerprintRange( &( ctx ),
+                                                   &( range ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ADDRESS_IPv4,
-                       parsedAddress.family );
-    TEST_ASSERT_EQUAL( 0x1234,
-                       parsedAddress.port );
-    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedAddress[ 0 ] ),
-                                   &( parsedAddress.address[ 0 ] ),
-                                   4 );
+    TEST_ASSERT_EQUAL( 100,
+                       range.stunMessageLength );
+    TEST_ASSERT_EQUAL( 0x58,
+                       range.patchedMessageLength );
+
+    result = StunDeserializer_VerifyFingerprint( &( ctx ),
+                                                 &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( originalMessage[ 0 ] ),
+                                   &( serializedMessage[ 0 ] ),
+                                   sizeof( originalMessage ) );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_ParseAttributeAddress (XOR Relayed Type) incase of happy path.
+ * @brief Validate StunDeserializer_GetIntegrityRange and
+ * StunDeserializer_GetFingerprintRange incase of bad parameters.
  */
-void test_StunDeserializer_ParseAttributeAddress_XorRelayed_HappyPath( void )
+void test_StunDeserializer_GetHashRanges_BadParams( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
-    StunHeader_t header = { 0 };
-    StunAttribute_t attribute = { 0 };
-    StunAttributeAddress_t parsedAddress = { 0 };
-    uint8_t expectedAddress[] = { 0x7F, 0x00, 0x00, 0x01 };
-    uint8_t serializedMessage[] =
-    {
-        /* Message Type = STUN Binding Request, Message Length = 0x0C (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x0C,
-        /* Magic cookie. */
-        0x21, 0x12, 0xA4, 0x42,
-        /* Transaction ID. */
-        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute type = XOR-RELAYED-ADDRESS (0x0016), Attribute Length = 8. */
-        0x00, 0x16, 0x00, 0x08,
-        /* Address family = IPv4, Port = 0x3326 (0x1234 XOR'd with 2 msb of cookie),
-         * IP Address = 0x5E12A443 (127.0.0.1 XOR'd with cookie). */
-        0x00, 0x01, 0x33, 0x26, 0x5E, 0x12, 0xA4, 0x43,
-    };
-    size_t serializedMessageLength = sizeof( serializedMessage );
+    StunHashRange_t range;
 
-    result = StunDeserializer_Init( &( ctx ),
-                                    &( serializedMessage[ 0 ] ),
-                                    serializedMessageLength,
-                                    &( header ) );
+    result = StunDeserializer_GetIntegrityRange( NULL,
+                                                 &( range ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
                        result );
 
-    result = StunDeserializer_GetNextAttribute( &( ctx ),
-                                                &( attribute ) );
+    result = StunDeserializer_GetIntegrityRange( &( ctx ),
+                                                 NULL );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_XOR_RELAYED_ADDRESS,
-                       attribute.attributeType );
 
-    result = StunDeserializer_ParseAttributeAddress( &( ctx ),
-                                                     &( attribute ),
-                                                     &( parsedAddress ) );
+    result = StunDeserializer_GetFingerprintRange( NULL,
+                                                   &( range ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+
+    result = StunDeserializer_GetFingerprintRange( &( ctx ),
+                                                   NULL );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ADDRESS_IPv4,
-                       parsedAddress.family );
-    TEST_ASSERT_EQUAL( 0x1234,
-                       parsedAddress.port );
-    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedAddress[ 0 ] ),
-                                   &( parsedAddress.address[ 0 ] ),
-                                   4 );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_ParseAttributeAddress (XOR Peer Type) incase of happy path.
+ * @brief Validate StunDeserializer_GetIntegrityBuffer in the happy path.
  */
-void test_StunDeserializer_ParseAttributeAddress_XorPeer_HappyPath( void )
+void test_StunDeserializer_GetIntegrityBuffer_HappyPath( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
     StunHeader_t header = { 0 };
     StunAttribute_t attribute = { 0 };
-    StunAttributeAddress_t parsedAddress = { 0 };
-    uint8_t expectedAddress[] = { 0x7F, 0x00, 0x00, 0x01 };
+    uint8_t * pHmacCalculationData;
+    uint16_t hmacCalculationDataLength;
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 0x0C (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x0C,
+        /* Message Type = STUN Binding Request, Message Length = 0x18 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x18,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute type = XOR-PEER-ADDRESS (0x0012), Attribute Length = 8. */
-        0x00, 0x12, 0x00, 0x08,
-        /* Address family = IPv4, Port = 0x3326 (0x1234 XOR'd with 2 msb of cookie),
-         * IP Address = 0x5E12A443 (127.0.0.1 XOR'd with cookie). */
-        0x00, 0x01, 0x33, 0x26, 0x5E, 0x12, 0xA4, 0x43,
+        /* Attribute type = MESSAGE-INTEGRITY (0x0008), Length = 20 bytes. */
+        0x00, 0x08, 0x00, 0x14,
+        /* Attribute Value = 20 bytes SHA-1 HMAC value. */
+        0x72, 0x64, 0x6D, 0x2F,
+        0x55, 0x77, 0xF4, 0x23,
+        0x73, 0x72, 0x75, 0x6C,
+        0x76, 0x61, 0x74, 0x62,
+        0xAB, 0xCD, 0xDE, 0xEF,
     };
     size_t serializedMessageLength = sizeof( serializedMessage );
 
@@ -1639,61 +1924,1354 @@ void test_StunDeserializer_ParseAttributeAddress_XorPeer_HappyPath( void )
 
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_XOR_PEER_ADDRESS,
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_MESSAGE_INTEGRITY,
                        attribute.attributeType );
 
-    result = StunDeserializer_ParseAttributeAddress( &( ctx ),
-                                                     &( attribute ),
-                                                     &( parsedAddress ) );
+    result = StunDeserializer_GetIntegrityBuffer( &( ctx ),
+                                                  &( pHmacCalculationData ),
+                                                  &( hmacCalculationDataLength ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ADDRESS_IPv4,
-                       parsedAddress.family );
-    TEST_ASSERT_EQUAL( 0x1234,
-                       parsedAddress.port );
-    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedAddress[ 0 ] ),
-                                   &( parsedAddress.address[ 0 ] ),
-                                   4 );
+    TEST_ASSERT_EQUAL( 20, /* Stun message excluding integrity attribute. */
+                       hmacCalculationDataLength );
+    TEST_ASSERT_EQUAL_PTR( &( serializedMessage[ 0 ] ),
+                           pHmacCalculationData );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( serializedMessage[ 0 ] ),
+                                   pHmacCalculationData,
+                                   hmacCalculationDataLength );
 }
 
 /*-----------------------------------------------------------*/
 
-/* @brief Validate StunDeserializer_ParseAttributeAddress (IPv6 Type) incase of happy path.
+/**
+ * @brief Validate StunDeserializer_GetIntegrityBuffer in case of null parameters.
  */
-void test_StunDeserializer_ParseAttributeAddress_IPv6_HappyPath( void )
+void test_StunDeserializer_GetIntegrityBuffer_NullParams( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
-    StunHeader_t header = { 0 };
-    StunAttribute_t attribute = { 0 };
-    StunAttributeAddress_t parsedAddress = { 0 };
-    uint8_t expectedAddress[] =
-    {
-        0x01, 0x13, 0xA9, 0xFA,
+    uint8_t * pHmacCalculationData;
+    uint16_t hmacCalculationDataLength;
+
+    result = StunDeserializer_GetIntegrityBuffer( NULL,
+                                                  &( pHmacCalculationData ),
+                                                  &( hmacCalculationDataLength ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+
+    result = StunDeserializer_GetIntegrityBuffer( &( ctx ),
+                                                  NULL,
+                                                  &( hmacCalculationDataLength ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+
+    result = StunDeserializer_GetIntegrityBuffer( &( ctx ),
+                                                  &( pHmacCalculationData ),
+                                                  NULL );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunDeserializer_UpdateAttributeNonce in the happy path.
+ */
+void test_StunDeserializer_UpdateAttributeNonce_HappyPath( void )
+{
+    StunResult_t result;
+    StunAttribute_t attribute;
+    uint8_t attributeValue[] =
+    {
+        /* Attribute Value = 0x123456789ABCDEF0. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0,
+    };
+    uint8_t updatedNonce[] =
+    {
+        0xAB, 0xBC, 0xCD, 0xDE, 0xEF, 0x1A, 0x2A, 0x3A
+    };
+    uint16_t updatedNonceLength = sizeof( updatedNonce );
+
+    attribute.attributeType = STUN_ATTRIBUTE_TYPE_NONCE;
+    attribute.pAttributeValue = &( attributeValue[ 0 ] );
+    attribute.attributeValueLength = sizeof( attributeValue );
+
+    result = StunDeserializer_UpdateAttributeNonce( &( updatedNonce[ 0 ] ),
+                                                    updatedNonceLength,
+                                                    &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( updatedNonce[ 0 ] ),
+                                   attribute.pAttributeValue,
+                                   updatedNonceLength );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunDeserializer_UpdateAttributeNonce in case of bad parameters.
+ */
+void test_StunDeserializer_UpdateAttributeNonce_BadParams( void )
+{
+    StunResult_t result;
+    StunAttribute_t attribute = { 0 };
+    uint8_t updatedNonce[] =
+    {
+        0xAB, 0xBC, 0xCD, 0xDE, 0xEF, 0x1A, 0x2A, 0x3A
+    };
+    uint16_t updatedNonceLength = sizeof( updatedNonce );
+
+    result = StunDeserializer_UpdateAttributeNonce( NULL,
+                                                    updatedNonceLength,
+                                                    &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+
+    result = StunDeserializer_UpdateAttributeNonce( &( updatedNonce[ 0 ] ),
+                                                    updatedNonceLength,
+                                                    NULL );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunDeserializer_UpdateAttributeNonce in case of wrong attribute type.
+ */
+void test_StunDeserializer_UpdateAttributeNonce_WrongAttributeType( void )
+{
+    StunResult_t result;
+    StunAttribute_t attribute = { 0 };
+    uint8_t attributeValue[] =
+    {
+        /* Attribute Value = 0x123456789ABCDEF0. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0,
+    };
+    uint8_t updatedNonce[] =
+    {
+        0xAB, 0xBC, 0xCD, 0xDE, 0xEF, 0x1A, 0x2A, 0x3A
+    };
+    uint16_t updatedNonceLength = sizeof( updatedNonce );
+
+    attribute.attributeType = STUN_ATTRIBUTE_TYPE_FINGERPRINT; /* Not nonce. */
+    attribute.pAttributeValue = &( attributeValue[ 0 ] );
+    attribute.attributeValueLength = sizeof( attributeValue );
+
+    result = StunDeserializer_UpdateAttributeNonce( &( updatedNonce[ 0 ] ),
+                                                    updatedNonceLength,
+                                                    &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunDeserializer_UpdateAttributeNonce in case of invalid nonce length.
+ */
+void test_StunDeserializer_UpdateAttributeNonce_InvalidNonceLength( void )
+{
+    StunResult_t result;
+    StunAttribute_t attribute = { 0 };
+    uint8_t attributeValue[] =
+    {
+        /* Attribute Value = 0x123456789ABCDEF0. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0,
+    };
+    /* Updated nonce is not of the same length as the original one. */
+    uint8_t updatedNonce[] =
+    {
+        0xAB, 0xBC, 0xCD, 0xDE,
+    };
+    uint16_t updatedNonceLength = sizeof( updatedNonce );
+
+    attribute.attributeType = STUN_ATTRIBUTE_TYPE_NONCE;
+    attribute.pAttributeValue = &( attributeValue[ 0 ] );
+    attribute.attributeValueLength = sizeof( attributeValue );
+
+    result = StunDeserializer_UpdateAttributeNonce( &( updatedNonce[ 0 ] ),
+                                                    updatedNonceLength,
+                                                    &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunDeserializer_ParseAttributeAddress incase of happy path.
+ */
+void test_StunDeserializer_ParseAttributeAddress_HappyPath( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    StunAttribute_t attribute = { 0 };
+    StunAttributeAddress_t parsedAddress = { 0 };
+    uint8_t expectedAddress[] = { 0x7F, 0x00, 0x00, 0x01, };
+    uint8_t serializedMessage[] =
+    {
+        /* Message Type = STUN Binding Request, Message Length = 0x0C (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x0C,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+        /* Attribute type = MAPPED-ADDRESS (0x0001), Attribute Length = 8. */
+        0x00, 0x01, 0x00, 0x08,
+        /* Address family = IPv4, Port = 0x1234, IP Address = 0x7F000001 (127.0.0.1). */
+        0x00, 0x01, 0x12, 0x34, 0x7F, 0x00, 0x00, 0x01,
+    };
+    size_t serializedMessageLength = sizeof( serializedMessage );
+
+    result = StunDeserializer_Init( &( ctx ),
+                                    &( serializedMessage[ 0 ] ),
+                                    serializedMessageLength,
+                                    &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_MAPPED_ADDRESS,
+                       attribute.attributeType );
+
+    result = StunDeserializer_ParseAttributeAddress( &( ctx ),
+                                                     &( attribute ),
+                                                     &( parsedAddress ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ADDRESS_IPv4,
+                       parsedAddress.family );
+    TEST_ASSERT_EQUAL( 0x1234,
+                       parsedAddress.port );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedAddress[ 0 ] ),
+                                   &( parsedAddress.address[ 0 ] ),
+                                   4 );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunDeserializer_ParseAttributeAddress in case of null parameters.
+ */
+void test_StunDeserializer_ParseAttributeAddress_NullParams( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunAttribute_t attribute = { 0 };
+    StunAttributeAddress_t parsedAddress = { 0 };
+    uint8_t attributeValue[] =
+    {
+        0x00, 0x01, 0x12, 0x34, 0x7F, 0x00, 0x00, 0x01,
+    };
+
+    result = StunDeserializer_ParseAttributeAddress( &( ctx ),
+                                                     NULL,
+                                                     &( parsedAddress ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+
+    attribute.attributeType = STUN_ATTRIBUTE_TYPE_MAPPED_ADDRESS;
+    attribute.pAttributeValue = NULL;
+    attribute.attributeValueLength = sizeof( attributeValue );
+
+    result = StunDeserializer_ParseAttributeAddress( &( ctx ),
+                                                     &( attribute ),
+                                                     &( parsedAddress ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+
+    attribute.pAttributeValue = &( attributeValue[ 0 ] );
+    attribute.attributeValueLength = sizeof( attributeValue );
+
+    result = StunDeserializer_ParseAttributeAddress( &( ctx ),
+                                                     &( attribute ),
+                                                     NULL );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunDeserializer_ParseAttributeAddress (XOR Mapped Type) incase of happy path.
+ */
+void test_StunDeserializer_ParseAttributeAddress_XorMapped_HappyPath( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    StunAttribute_t attribute = { 0 };
+    StunAttributeAddress_t parsedAddress = { 0 };
+    uint8_t expectedAddress[] = { 0x7F, 0x00, 0x00, 0x01 };
+    uint8_t serializedMessage[] =
+    {
+        /* Message Type = STUN Binding Request, Message Length = 0x0C (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x0C,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+        /* Attribute type = XOR-MAPPED-ADDRESS (0x0020), Attribute Length = 8. */
+        0x00, 0x20, 0x00, 0x08,
+        /* Address family = IPv4, Port = 0x3326 (0x1234 XOR'd with 2 msb of cookie),
+         * IP Address = 0x5E12A443 (127.0.0.1 XOR'd with cookie). */
+        0x00, 0x01, 0x33, 0x26, 0x5E, 0x12, 0xA4, 0x43,
+    };
+    size_t serializedMessageLength = sizeof( serializedMessage );
+
+    result = StunDeserializer_Init( &( ctx ),
+                                    &( serializedMessage[ 0 ] ),
+                                    serializedMessageLength,
+                                    &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_XOR_MAPPED_ADDRESS,
+                       attribute.attributeType );
+
+    result = StunDeserializer_ParseAttributeAddress( &( ctx ),
+                                                     &( attribute ),
+                                                     &( parsedAddress ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ADDRESS_IPv4,
+                       parsedAddress.family );
+    TEST_ASSERT_EQUAL( 0x1234,
+                       parsedAddress.port );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedAddress[ 0 ] ),
+                                   &( parsedAddress.address[ 0 ] ),
+                                   4 );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunDeserializer_ParseAttributeAddress (XOR Relayed Type) incase of happy path.
+ */
+void test_StunDeserializer_ParseAttributeAddress_XorRelayed_HappyPath( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    StunAttribute_t attribute = { 0 };
+    StunAttributeAddress_t parsedAddress = { 0 };
+    uint8_t expectedAddress[] = { 0x7F, 0x00, 0x00, 0x01 };
+    uint8_t serializedMessage[] =
+    {
+        /* Message Type = STUN Binding Request, Message Length = 0x0C (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x0C,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+        /* Attribute type = XOR-RELAYED-ADDRESS (0x0016), Attribute Length = 8. */
+        0x00, 0x16, 0x00, 0x08,
+        /* Address family = IPv4, Port = 0x3326 (0x1234 XOR'd with 2 msb of cookie),
+         * IP Address = 0x5E12A443 (127.0.0.1 XOR'd with cookie). */
+        0x00, 0x01, 0x33, 0x26, 0x5E, 0x12, 0xA4, 0x43,
+    };
+    size_t serializedMessageLength = sizeof( serializedMessage );
+
+    result = StunDeserializer_Init( &( ctx ),
+                                    &( serializedMessage[ 0 ] ),
+                                    serializedMessageLength,
+                                    &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_XOR_RELAYED_ADDRESS,
+                       attribute.attributeType );
+
+    result = StunDeserializer_ParseAttributeAddress( &( ctx ),
+                                                     &( attribute ),
+                                                     &( parsedAddress ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ADDRESS_IPv4,
+                       parsedAddress.family );
+    TEST_ASSERT_EQUAL( 0x1234,
+                       parsedAddress.port );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedAddress[ 0 ] ),
+                                   &( parsedAddress.address[ 0 ] ),
+                                   4 );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunDeserializer_ParseAttributeAddress (XOR Peer Type) incase of happy path.
+ */
+void test_StunDeserializer_ParseAttributeAddress_XorPeer_HappyPath( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    StunAttribute_t attribute = { 0 };
+    StunAttributeAddress_t parsedAddress = { 0 };
+    uint8_t expectedAddress[] = { 0x7F, 0x00, 0x00, 0x01 };
+    uint8_t serializedMessage[] =
+    {
+        /* Message Type = STUN Binding Request, Message Length = 0x0C (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x0C,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+        /* Attribute type = XOR-PEER-ADDRESS (0x0012), Attribute Length = 8. */
+        0x00, 0x12, 0x00, 0x08,
+        /* Address family = IPv4, Port = 0x3326 (0x1234 XOR'd with 2 msb of cookie),
+         * IP Address = 0x5E12A443 (127.0.0.1 XOR'd with cookie). */
+        0x00, 0x01, 0x33, 0x26, 0x5E, 0x12, 0xA4, 0x43,
+    };
+    size_t serializedMessageLength = sizeof( serializedMessage );
+
+    result = StunDeserializer_Init( &( ctx ),
+                                    &( serializedMessage[ 0 ] ),
+                                    serializedMessageLength,
+                                    &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_XOR_PEER_ADDRESS,
+                       attribute.attributeType );
+
+    result = StunDeserializer_ParseAttributeAddress( &( ctx ),
+                                                     &( attribute ),
+                                                     &( parsedAddress ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ADDRESS_IPv4,
+                       parsedAddress.family );
+    TEST_ASSERT_EQUAL( 0x1234,
+                       parsedAddress.port );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedAddress[ 0 ] ),
+                                   &( parsedAddress.address[ 0 ] ),
+                                   4 );
+}
+
+/*-----------------------------------------------------------*/
+
+/* @brief Validate StunDeserializer_ParseAttributeAddress (IPv6 Type) incase of happy path.
+ */
+void test_StunDeserializer_ParseAttributeAddress_IPv6_HappyPath( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    StunAttribute_t attribute = { 0 };
+    StunAttributeAddress_t parsedAddress = { 0 };
+    uint8_t expectedAddress[] =
+    {
+        0x01, 0x13, 0xA9, 0xFA,
+        0x97, 0x97, 0x56, 0x78,
+        0x9A, 0xBC, 0x54, 0xDE,
+        0xA8, 0xBD, 0x9C, 0x91,
+    };
+    uint8_t serializedMessage[] =
+    {
+        /* Message Type = STUN Binding Request, Message Length = 0x18 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x18,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+        /* Attribute type = MAPPED-ADDRESS (0x0001), Attribute Length = 20. */
+        0x00, 0x01, 0x00, 0x14,
+        /* Address family = IPv6, Port = 0x1234,
+         * IP Address = 0113:A9FA:9797:5678:9ABC:54DE:A8BD:9C91. */
+        0x00, 0x02, 0x12, 0x34,
+        0x01, 0x13, 0xA9, 0xFA,
+        0x97, 0x97, 0x56, 0x78,
+        0x9A, 0xBC, 0x54, 0xDE,
+        0xA8, 0xBD, 0x9C, 0x91,
+    };
+    size_t serializedMessageLength = sizeof( serializedMessage );
+
+    result = StunDeserializer_Init( &( ctx ),
+                                    &( serializedMessage[ 0 ] ),
+                                    serializedMessageLength,
+                                    &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_MAPPED_ADDRESS,
+                       attribute.attributeType );
+
+    result = StunDeserializer_ParseAttributeAddress( &( ctx ),
+                                                     &( attribute ),
+                                                     &( parsedAddress ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ADDRESS_IPv6,
+                       parsedAddress.family );
+    TEST_ASSERT_EQUAL( 0x1234,
+                       parsedAddress.port );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedAddress[ 0 ] ),
+                                   &( parsedAddress.address[ 0 ] ),
+                                   16 );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunDeserializer_ParseAttributeAddress (XOR IPv6 Type) incase of happy path.
+ */
+void test_StunDeserializer_ParseAttributeAddressXorIPv6_HappyPath( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    StunAttribute_t attribute = { 0 };
+    StunAttributeAddress_t parsedAddress = { 0 };
+    uint8_t expectedAddress[] =
+    {
+        0x01, 0x13, 0xA9, 0xFA,
+        0x97, 0x97, 0x56, 0x78,
+        0x9A, 0xBC, 0x54, 0xDE,
+        0xA8, 0xBD, 0x9C, 0x91,
+    };
+    uint8_t serializedMessage[] =
+    {
+        /* Message Type = STUN Binding Request, Message Length = 0x18 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x18,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+        /* Attribute type = XOR-MAPPED-ADDRESS (0x0020), Attribute Length = 20. */
+        0x00, 0x20, 0x00, 0x14,
+        /* Address family = IPv6, Port = 0x3326 (0x1234 XOR'd with 2 msb of cookie),
+         * IP Address = 2001:0DB8:85A3:0000:0000:8A2E:0370:7334 (0113:A9FA:9797:5678:9ABC:54DE:A8BD:9C91
+         * XOR'd with cookie and transaction ID). */
+        0x00, 0x02, 0x33, 0x26,
+        0x20, 0x01, 0x0D, 0xB8,
+        0x85, 0xA3, 0x00, 0x00,
+        0x00, 0x00, 0x8A, 0x2E,
+        0x03, 0x70, 0x73, 0x34,
+    };
+    size_t serializedMessageLength = sizeof( serializedMessage );
+
+    result = StunDeserializer_Init( &( ctx ),
+                                    &( serializedMessage[ 0 ] ),
+                                    serializedMessageLength,
+                                    &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_XOR_MAPPED_ADDRESS,
+                       attribute.attributeType );
+
+    result = StunDeserializer_ParseAttributeAddress( &( ctx ),
+                                                     &( attribute ),
+                                                     &( parsedAddress ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ADDRESS_IPv6,
+                       parsedAddress.family );
+    TEST_ASSERT_EQUAL( 0x1234,
+                       parsedAddress.port );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedAddress[ 0 ] ),
+                                   &( parsedAddress.address[ 0 ] ),
+                                   16 );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunDeserializer_FindAttribute in case of different attribute types.
+ *
+ * It includes the following scenarios:
+ *
+ * 1. Trying to find the STUN_ATTRIBUTE_TYPE_ICE_CONTROLLED attribute, which is not
+ *    present in the STUN message, and expecting the function to return
+ *    STUN_RESULT_NO_ATTRIBUTE_FOUND.
+ * 2. Finding the STUN_ATTRIBUTE_TYPE_PRIORITY attribute, which is present in the
+ *    STUN message, and verifying that the function returns STUN_RESULT_OK.
+ */
+void test_StunDeserializer_FindAttribute( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    StunAttribute_t attribute = { 0 };
+    uint8_t serializedMessage[] =
+    {
+        /* Message Type = STUN Binding Request, Message Length = 0x08 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x08,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+        /* Attribute Type = PRIORITY (0x0024), Attribute Length = 4. */
+        0x00, 0x24, 0x00, 0x04,
+        /* Attribute Value = 0x6E000100 (Priority = 2023406816). */
+        0x6E, 0x00, 0x01, 0x00,
+    };
+    size_t serializedMessageLength = sizeof( serializedMessage );
+    uint8_t expectedAttributeValue[] =
+    {
+        /* Priority attribute value = 0x6E000100. */
+        0x6E, 0x00, 0x01, 0x00,
+    };
+    size_t expectedAttributeValueLength = sizeof( expectedAttributeValue );
+
+    result = StunDeserializer_Init( &( ctx ),
+                                    &( serializedMessage[ 0 ] ),
+                                    serializedMessageLength,
+                                    &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunDeserializer_FindAttribute( &( ctx ),
+                                             STUN_ATTRIBUTE_TYPE_ICE_CONTROLLED,
+                                             &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_NO_ATTRIBUTE_FOUND,
+                       result );
+
+    result = StunDeserializer_FindAttribute( &( ctx ),
+                                             STUN_ATTRIBUTE_TYPE_PRIORITY,
+                                             &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_PRIORITY,
+                       attribute.attributeType );
+    TEST_ASSERT_EQUAL( expectedAttributeValueLength,
+                       attribute.attributeValueLength );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedAttributeValue[ 0 ] ),
+                                   attribute.pAttributeValue,
+                                   expectedAttributeValueLength );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunDeserializer_FindAttribute in case of null attribute.
+ */
+void test_StunDeserializer_FindAttribute_NullAttribute( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    uint8_t serializedMessage[] =
+    {
+        /* Message Type = STUN Binding Request, Message Length = 0x08 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x08,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+        /* Attribute Type = PRIORITY (0x0024), Attribute Length = 4. */
+        0x00, 0x24, 0x00, 0x04,
+        /* Attribute Value = 0x6E000100 (Priority = 2023406816). */
+        0x6E, 0x00, 0x01, 0x00,
+    };
+    size_t serializedMessageLength = sizeof( serializedMessage );
+
+    result = StunDeserializer_Init( &( ctx ),
+                                    &( serializedMessage[ 0 ] ),
+                                    serializedMessageLength,
+                                    &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunDeserializer_FindAttribute( &( ctx ),
+                                             STUN_ATTRIBUTE_TYPE_ICE_CONTROLLED,
+                                             NULL );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunDeserializer_FindAttribute in case of null context.
+ */
+void test_StunDeserializer_FindAttribute_NullContext( void )
+{
+    StunResult_t result;
+    StunAttribute_t attribute = { 0 };
+
+    result = StunDeserializer_FindAttribute( NULL,
+                                             STUN_ATTRIBUTE_TYPE_ICE_CONTROLLED,
+                                             &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunDeserializer_FindAttribute in case of null StunContext_t.pStart.
+ */
+void test_StunDeserializer_FindAttribute_NullContextStart( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunAttribute_t attribute = { 0 };
+
+    ctx.pStart = NULL;
+
+    result = StunDeserializer_FindAttribute( &( ctx ),
+                                             STUN_ATTRIBUTE_TYPE_ICE_CONTROLLED,
+                                             &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunDeserializer_GetNextAttribute incase of invalid attribute order.
+ */
+void test_StunDeserializer_GetNextAttribute_InvalidAttributeOrder( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    StunAttribute_t attribute = { 0 };
+    uint8_t serializedMessage[] =
+    {
+        /* Message Type = STUN Binding Request, Message Length = 0x20 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x20,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+        /* Attribute type = FINGERPRINT (0x8028), Attribute Length = 4. */
+        0x80, 0x28, 0x00, 0x04,
+        /* Attribute Value = 0x078E383F (Obtained from XOR of 0x54DA6D71 and STUN_ATTRIBUTE_FINGERPRINT_XOR_VALUE). */
+        0x07, 0x8E, 0x38, 0x3F,
+        /* Attribute type = MESSAGE-INTEGRITY (0x0008), Length = 20 bytes. */
+        0x00, 0x08, 0x00, 0x14,
+        /* Attribute Value = 20 bytes SHA-1 HMAC value. */
+        0x72, 0x64, 0x6D, 0x2F,
+        0x55, 0x77, 0xF4, 0x23,
+        0x73, 0x72, 0x75, 0x6C,
+        0x76, 0x61, 0x74, 0x62,
+        0xAB, 0xCD, 0xDE, 0xEF,
+    };
+    size_t serializedMessageLength = sizeof( serializedMessage );
+
+    result = StunDeserializer_Init( &( ctx ),
+                                    &( serializedMessage[ 0 ] ),
+                                    serializedMessageLength,
+                                    &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    /* First attribute is FINGERPRINT. */
+    result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_FINGERPRINT,
+                       attribute.attributeType );
+
+    /* Next attribute is the Message-Integrity attribute. However, this is an
+     * invalid order, as Message-Integrity must come before Fingerprint. */
+    result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE_ORDER,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunDeserializer_GetNextAttribute incase of invalid attribute order.
+ */
+void test_StunDeserializer_GetNextAttribute_InvalidAttributeOrder_2( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    StunAttribute_t attribute = { 0 };
+    uint8_t serializedMessage[] =
+    {
+        /* Message Type = STUN Binding Request, Message Length = 0x20 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x20,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+        /* Attribute type = MESSAGE-INTEGRITY (0x0008), Length = 20 bytes. */
+        0x00, 0x08, 0x00, 0x14,
+        /* Attribute Value = 20 bytes SHA-1 HMAC value. */
+        0x72, 0x64, 0x6D, 0x2F,
+        0x55, 0x77, 0xF4, 0x23,
+        0x73, 0x72, 0x75, 0x6C,
+        0x76, 0x61, 0x74, 0x62,
+        0xAB, 0xCD, 0xDE, 0xEF,
+        /* Attribute Type = PRIORITY (0x0024), Attribute Length = 4. */
+        0x00, 0x24, 0x00, 0x04,
+        /* Attribute Value = 0x6E000100 (Priority = 2023406816). */
+        0x6E, 0x00, 0x01, 0x00,
+    };
+    size_t serializedMessageLength = sizeof( serializedMessage );
+
+    result = StunDeserializer_Init( &( ctx ),
+                                    &( serializedMessage[ 0 ] ),
+                                    serializedMessageLength,
+                                    &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    /* First attribute is Message-Integrity. */
+    result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_MESSAGE_INTEGRITY,
+                       attribute.attributeType );
+
+    /* Next attribute is the Priority. However, this is an invalid order, as
+     * Priority must come before Message-Integrity. Only Fingerprint attribute
+     * can come after the Message-Integrity attribute. */
+    result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE_ORDER,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunDeserializer_GetNextAttribute incase of valid attribute order.
+ */
+void test_StunDeserializer_GetNextAttribute_ValidAttributeOrder( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    StunAttribute_t attribute = { 0 };
+    uint32_t crc32Fingerprint;
+    uint8_t serializedMessage[] =
+    {
+        /* Message Type = STUN Binding Request, Message Length = 0x20 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x20,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+        /* Attribute type = MESSAGE-INTEGRITY (0x0008), Length = 20 bytes. */
+        0x00, 0x08, 0x00, 0x14,
+        /* Attribute Value = 20 bytes SHA-1 HMAC value. */
+        0x72, 0x64, 0x6D, 0x2F,
+        0x55, 0x77, 0xF4, 0x23,
+        0x73, 0x72, 0x75, 0x6C,
+        0x76, 0x61, 0x74, 0x62,
+        0xAB, 0xCD, 0xDE, 0xEF,
+        /* Attribute type = FINGERPRINT (0x8028), Attribute Length = 4. */
+        0x80, 0x28, 0x00, 0x04,
+        /* Attribute Value = 0x078E383F (Obtained from XOR of 0x54DA6D71 and STUN_ATTRIBUTE_FINGERPRINT_XOR_VALUE). */
+        0x07, 0x8E, 0x38, 0x3F,
+    };
+    size_t serializedMessageLength = sizeof( serializedMessage );
+
+    result = StunDeserializer_Init( &( ctx ),
+                                    &( serializedMessage[ 0 ] ),
+                                    serializedMessageLength,
+                                    &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    /* First attribute is Message-Integrity. */
+    result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_MESSAGE_INTEGRITY,
+                       attribute.attributeType );
+
+    /* Next attribute is Fingerprint. */
+    result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_FINGERPRINT,
+                       attribute.attributeType );
+
+    result = StunDeserializer_ParseAttributeFingerprint( &( ctx ),
+                                                         &( attribute ),
+                                                         &( crc32Fingerprint ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( 0x54DA6D71,
+                       crc32Fingerprint );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunDeserializer_GetNextAttribute in case of zero attributeValueLength.
+ */
+void test_StunDeserializer_GetNextAttribute_ZeroAttributeValueLength( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    StunAttribute_t attribute = { 0 };
+    uint8_t serializedMessage[] =
+    {
+        /* Message Type = STUN Binding Request, Message Length = 0x04 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x04,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+        /* Attribute Type = USE-CANDIDATE (0x0025), Length = 0. */
+        0x00, 0x25, 0x00, 0x00,
+    };
+    size_t serializedMessageLength = sizeof( serializedMessage );
+
+    result = StunDeserializer_Init( &( ctx ),
+                                    &( serializedMessage[ 0 ] ),
+                                    serializedMessageLength,
+                                    &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_USE_CANDIDATE,
+                       attribute.attributeType );
+    TEST_ASSERT_EQUAL( 0,
+                       attribute.attributeValueLength );
+    TEST_ASSERT_EQUAL( NULL,
+                       attribute.pAttributeValue );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunDeserializer_GetNextAttribute in case of out of memory.
+ */
+void test_StunDeserializer_GetNextAttribute_OutOfMemory( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    StunAttribute_t attribute = { 0 };
+    uint8_t serializedMessage[] =
+    {
+        /* Message Type = STUN Binding Request, Message Length = 0x04 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x04,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+        /* Attribute Type = PRIORITY (0x0024), Attribute Length = 4. */
+        0x00, 0x24, 0x00, 0x04,
+        /* Missing priority value. */
+    };
+    size_t serializedMessageLength = sizeof( serializedMessage );
+
+    result = StunDeserializer_Init( &( ctx ),
+                                    &( serializedMessage[ 0 ] ),
+                                    serializedMessageLength,
+                                    &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OUT_OF_MEMORY,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunDeserializer_GetNextAttribute incase of malformed message-integrity attribute.
+ */
+void test_StunDeserializer_GetNextAttribute_MalformedMessageIntegrity( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    StunAttribute_t attribute = { 0 };
+    uint8_t serializedMessage[] =
+    {
+        /* Message Type = STUN Binding Request, Message Length = 0x24 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x24,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+        /* Attribute type = MESSAGE-INTEGRITY (0x0008), Length = 24 bytes (set invalid intentionally). */
+        0x00, 0x08, 0x00, 0x18,
+        /* Attribute Value = 24 bytes SHA-1 HMAC value (set invalid intentionally). */
+        0x72, 0x64, 0x6D, 0x2F,
+        0x55, 0x77, 0xF4, 0x23,
+        0x73, 0x72, 0x75, 0x6C,
+        0x76, 0x61, 0x74, 0x62,
+        0xAB, 0xCD, 0xDE, 0xEF,
+        0x80, 0x28, 0x00, 0x04,
+        /* Attribute type = FINGERPRINT (0x8028), Attribute Length = 4. */
+        0x80, 0x28, 0x00, 0x04,
+        /* Attribute Value = 0x078E383F (Obtained from XOR of 0x54DA6D71 and STUN_ATTRIBUTE_FINGERPRINT_XOR_VALUE). */
+        0x07, 0x8E, 0x38, 0x3F,
+    };
+    size_t serializedMessageLength = sizeof( serializedMessage );
+
+    result = StunDeserializer_Init( &( ctx ),
+                                    &( serializedMessage[ 0 ] ),
+                                    serializedMessageLength,
+                                    &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_MESSAGE_INTEGRITY,
+                       attribute.attributeType );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunDeserializer_GetNextAttribute incase of malformed fingerprint attribute.
+ */
+void test_StunDeserializer_GetNextAttribute_MalformedFingerprint( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    StunAttribute_t attribute = { 0 };
+    uint8_t serializedMessage[] =
+    {
+        /* Message Type = STUN Binding Request, Message Length = 0x0C (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x0C,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+        /* Attribute type = FINGERPRINT (0x8028), Attribute Length = 8 (set invalid intentionally). */
+        0x80, 0x28, 0x00, 0x08,
+        /* Attribute Value = 0x078E383F078E383F. */
+        0x07, 0x8E, 0x38, 0x3F,
+        0x07, 0x8E, 0x38, 0x3F,
+    };
+    size_t serializedMessageLength = sizeof( serializedMessage );
+
+    result = StunDeserializer_Init( &( ctx ),
+                                    &( serializedMessage[ 0 ] ),
+                                    serializedMessageLength,
+                                    &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_FINGERPRINT,
+                       attribute.attributeType );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunDeserializer_GetNextAttribute incase of malformed mapped address attribute.
+ */
+void test_StunDeserializer_GetNextAttribute_MalformedIPv4MappedAddress( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    StunAttribute_t attribute = { 0 };
+    uint8_t serializedMessage[] =
+    {
+        /* Message Type = STUN Binding Request, Message Length = 0x14 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x14,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+        /* Attribute type = MAPPED-ADDRESS (0x0001), Attribute Length = 16 (set invalid intentionally). */
+        0x00, 0x01, 0x00, 0x10,
+        /* Address family = IPv4, Port = 0x1234, IP Address = 0x7F000001 (127.0.0.1)
+         * and additional 8 invalid bytes. */
+        0x00, 0x01, 0x12, 0x34, 0x7F, 0x00, 0x00, 0x01,
+        0x80, 0x28, 0x00, 0x04, 0x07, 0x8E, 0x38, 0x3F,
+    };
+    size_t serializedMessageLength = sizeof( serializedMessage );
+
+    result = StunDeserializer_Init( &( ctx ),
+                                    &( serializedMessage[ 0 ] ),
+                                    serializedMessageLength,
+                                    &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_MAPPED_ADDRESS,
+                       attribute.attributeType );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunDeserializer_GetNextAttribute incase of malformed mapped address attribute.
+ */
+void test_StunDeserializer_GetNextAttribute_MalformedIPv6MappedAddress( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    StunAttribute_t attribute = { 0 };
+    uint8_t serializedMessage[] =
+    {
+        /* Message Type = STUN Binding Request, Message Length = 0x1C (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x1C,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+        /* Attribute type = MAPPED-ADDRESS (0x0001), Attribute Length = 24 (set invalid intentionally). */
+        0x00, 0x01, 0x00, 0x18,
+        /* Address family = IPv6, Port = 0x1234,
+         * IP Address = 0113:A9FA:9797:5678:9ABC:54DE:A8BD:9C91 and 4 invalid bytes. */
+        0x00, 0x02, 0x12, 0x34,
+        0x01, 0x13, 0xA9, 0xFA,
         0x97, 0x97, 0x56, 0x78,
         0x9A, 0xBC, 0x54, 0xDE,
         0xA8, 0xBD, 0x9C, 0x91,
+        0x80, 0x28, 0x00, 0x04,
+    };
+    size_t serializedMessageLength = sizeof( serializedMessage );
+
+    result = StunDeserializer_Init( &( ctx ),
+                                    &( serializedMessage[ 0 ] ),
+                                    serializedMessageLength,
+                                    &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_MAPPED_ADDRESS,
+                       attribute.attributeType );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunDeserializer_GetNextAttribute incase of malformed XOR mapped address attribute.
+ */
+void test_StunDeserializer_GetNextAttribute_MalformedIPv6XorMappedAddress( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    StunAttribute_t attribute = { 0 };
+    uint8_t serializedMessage[] =
+    {
+        /* Message Type = STUN Binding Request, Message Length = 0x1C (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x1C,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+        /* Attribute type = XOR-MAPPED-ADDRESS (0x0020), Attribute Length = 24 (set invalid intentionally). */
+        0x00, 0x20, 0x00, 0x18,
+        /* Address family = IPv6, Port = 0x3326 (0x1234 XOR'd with 2 msb of cookie),
+         * IP Address = 2001:0DB8:85A3:0000:0000:8A2E:0370:7334 (0113:A9FA:9797:5678:9ABC:54DE:A8BD:9C91
+         * XOR'd with cookie and transaction ID) and 4 invalid bytes. */
+        0x00, 0x02, 0x33, 0x26,
+        0x20, 0x01, 0x0D, 0xB8,
+        0x85, 0xA3, 0x00, 0x00,
+        0x00, 0x00, 0x8A, 0x2E,
+        0x03, 0x70, 0x73, 0x34,
+        0x03, 0x70, 0x73, 0x34,
+    };
+    size_t serializedMessageLength = sizeof( serializedMessage );
+
+    result = StunDeserializer_Init( &( ctx ),
+                                    &( serializedMessage[ 0 ] ),
+                                    serializedMessageLength,
+                                    &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_XOR_MAPPED_ADDRESS,
+                       attribute.attributeType );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunDeserializer_GetNextAttribute incase of malformed XOR relayed address attribute.
+ */
+void test_StunDeserializer_GetNextAttribute_MalformedXorRelayedAddress( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    StunAttribute_t attribute = { 0 };
+    uint8_t serializedMessage[] =
+    {
+        /* Message Type = STUN Binding Request, Message Length = 0x10 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x10,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+        /* Attribute type = XOR-RELAYED-ADDRESS (0x0016), Attribute Length = 12 (set invalid intentionally). */
+        0x00, 0x16, 0x00, 0x0C,
+        /* Address family = IPv4, Port = 0x3326 (0x1234 XOR'd with 2 msb of cookie),
+         * IP Address = 0x5E12A443 (127.0.0.1 XOR'd with cookie) and 4 invalid bytes. */
+        0x00, 0x01, 0x33, 0x26,
+        0x5E, 0x12, 0xA4, 0x43,
+        0x00, 0x16, 0x00, 0x0C,
     };
+    size_t serializedMessageLength = sizeof( serializedMessage );
+
+    result = StunDeserializer_Init( &( ctx ),
+                                    &( serializedMessage[ 0 ] ),
+                                    serializedMessageLength,
+                                    &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_XOR_RELAYED_ADDRESS,
+                       attribute.attributeType );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunDeserializer_GetNextAttribute incase of malformed realm attribute.
+ */
+void test_StunDeserializer_GetNextAttribute_MalformedRealm( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    StunAttribute_t attribute = { 0 };
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 0x18 (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x18,
+        /* Message Type = STUN Binding Request, Message Length = 1028 (excluding 20 bytes header). */
+        0x00, 0x01, 0x04, 0x04,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute type = MAPPED-ADDRESS (0x0001), Attribute Length = 20. */
-        0x00, 0x01, 0x00, 0x14,
-        /* Address family = IPv6, Port = 0x1234,
-         * IP Address = 0113:A9FA:9797:5678:9ABC:54DE:A8BD:9C91. */
-        0x00, 0x02, 0x12, 0x34,
-        0x01, 0x13, 0xA9, 0xFA,
-        0x97, 0x97, 0x56, 0x78,
-        0x9A, 0xBC, 0x54, 0xDE,
-        0xA8, 0xBD, 0x9C, 0x91,
+        /* Attribute Type = REALM (0x0014), Attribute Length = 1024 (set invalid intentionally). */
+        0x00, 0x14, 0x04, 0x00,
+        /* Attribute Value = "Realm Example". */
+        0x52, 0x65, 0x61, 0x6C,
+        0x6D, 0x20, 0x45, 0x78,
+        0x61, 0x6D, 0x70, 0x6C,
+        0x65, 0x00, 0x00, 0x00,
+        0x65, 0x00, 0x00, 0x00,
     };
-    size_t serializedMessageLength = sizeof( serializedMessage );
+    size_t serializedMessageLength = 0x418; /* 1028 + 20 (header) = 1048 (0x418). */
 
     result = StunDeserializer_Init( &( ctx ),
                                     &( serializedMessage[ 0 ] ),
@@ -1706,63 +3284,126 @@ void test_StunDeserializer_ParseAttributeAddress_IPv6_HappyPath( void )
     result = StunDeserializer_GetNextAttribute( &( ctx ),
                                                 &( attribute ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_MAPPED_ADDRESS,
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_REALM,
                        attribute.attributeType );
+}
 
-    result = StunDeserializer_ParseAttributeAddress( &( ctx ),
-                                                     &( attribute ),
-                                                     &( parsedAddress ) );
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunDeserializer_GetNextAttribute incase of malformed nonce attribute.
+ */
+void test_StunDeserializer_GetNextAttribute_MalformedNonce( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    StunAttribute_t attribute = { 0 };
+    uint8_t serializedMessage[] =
+    {
+        /* Message Type = STUN Binding Request, Message Length = 1028 (excluding 20 bytes header). */
+        0x00, 0x01, 0x04, 0x04,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+        /* Attribute Type = NONCE (0x0015), Attribute Length = 1024 (set invalid intentionally). */
+        0x00, 0x15, 0x04, 0x00,
+        /* Attribute Value = "Nonce Example". */
+        0x4E, 0x6F, 0x6E, 0x63,
+        0x65, 0x20, 0x45, 0x78,
+        0x61, 0x6D, 0x70, 0x6C,
+        0x65, 0x00, 0x00, 0x00,
+    };
+    size_t serializedMessageLength = 0x418; /* 1028 + 20 (header) = 1048 (0x418). */
+
+    result = StunDeserializer_Init( &( ctx ),
+                                    &( serializedMessage[ 0 ] ),
+                                    serializedMessageLength,
+                                    &( header ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ADDRESS_IPv6,
-                       parsedAddress.family );
-    TEST_ASSERT_EQUAL( 0x1234,
-                       parsedAddress.port );
-    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedAddress[ 0 ] ),
-                                   &( parsedAddress.address[ 0 ] ),
-                                   16 );
+
+    result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_NONCE,
+                       attribute.attributeType );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_ParseAttributeAddress (XOR IPv6 Type) incase of happy path.
+ * @brief Validate StunDeserializer_GetNextAttribute incase of maximum length of nonce attribute.
  */
-void test_StunDeserializer_ParseAttributeAddressXorIPv6_HappyPath( void )
+void test_StunDeserializer_GetNextAttribute_MaxLengthNonce( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
     StunHeader_t header = { 0 };
     StunAttribute_t attribute = { 0 };
-    StunAttributeAddress_t parsedAddress = { 0 };
-    uint8_t expectedAddress[] =
+    uint8_t serializedMessage[] =
     {
-        0x01, 0x13, 0xA9, 0xFA,
-        0x97, 0x97, 0x56, 0x78,
-        0x9A, 0xBC, 0x54, 0xDE,
-        0xA8, 0xBD, 0x9C, 0x91,
+        /* Message Type = STUN Binding Request, Message Length = 516 (excluding 20 bytes header). */
+        0x00, 0x01, 0x02, 0x04,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+        /* Attribute Type = NONCE (0x0015), Attribute Length = 512 (set invalid intentionally). */
+        0x00, 0x15, 0x02, 0x00,
+        /* Attribute Value = "Nonce Example". */
+        0x4E, 0x6F, 0x6E, 0x63,
+        0x65, 0x20, 0x45, 0x78,
+        0x61, 0x6D, 0x70, 0x6C,
+        0x65, 0x00, 0x00, 0x00,
     };
-    uint8_t serializedMessage[] =
+    size_t serializedMessageLength = 0x218; /* 516 + 20 (header) = 536 (0x218). */
+
+    result = StunDeserializer_Init( &( ctx ),
+                                    &( serializedMessage[ 0 ] ),
+                                    serializedMessageLength,
+                                    &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_NONCE,
+                       attribute.attributeType );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunDeserializer_GetNextAttribute with a DATA attribute
+ * larger than the maximum length of general attributes.
+ */
+void test_StunDeserializer_GetNextAttribute_LargeData( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    StunAttribute_t attribute = { 0 };
+    uint8_t serializedMessage[ STUN_HEADER_LENGTH + STUN_ATTRIBUTE_HEADER_LENGTH + 1200 ] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 0x18 (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x18,
+        /* Message Type = Data Indication, Message Length = 1204 (excluding 20 bytes header). */
+        0x00, 0x17, 0x04, 0xB4,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute type = XOR-MAPPED-ADDRESS (0x0020), Attribute Length = 20. */
-        0x00, 0x20, 0x00, 0x14,
-        /* Address family = IPv6, Port = 0x3326 (0x1234 XOR'd with 2 msb of cookie),
-         * IP Address = 2001:0DB8:85A3:0000:0000:8A2E:0370:7334 (0113:A9FA:9797:5678:9ABC:54DE:A8BD:9C91
-         * XOR'd with cookie and transaction ID). */
-        0x00, 0x02, 0x33, 0x26,
-        0x20, 0x01, 0x0D, 0xB8,
-        0x85, 0xA3, 0x00, 0x00,
-        0x00, 0x00, 0x8A, 0x2E,
-        0x03, 0x70, 0x73, 0x34,
+        /* Attribute Type = DATA (0x0013), Attribute Length = 1200. */
+        0x00, 0x13, 0x04, 0xB0,
     };
     size_t serializedMessageLength = sizeof( serializedMessage );
 
@@ -1779,38 +3420,34 @@ void test_StunDeserializer_ParseAttributeAddressXorIPv6_HappyPath( void )
 
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_XOR_MAPPED_ADDRESS,
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_DATA,
                        attribute.attributeType );
+    TEST_ASSERT_EQUAL( 1200,
+                       attribute.attributeValueLength );
+    TEST_ASSERT_EQUAL_PTR( &( serializedMessage[ STUN_HEADER_LENGTH + STUN_ATTRIBUTE_HEADER_LENGTH ] ),
+                           attribute.pAttributeValue );
 
-    result = StunDeserializer_ParseAttributeAddress( &( ctx ),
-                                                     &( attribute ),
-                                                     &( parsedAddress ) );
+    /* The limit of general attributes still applies to the others. */
+    serializedMessage[ STUN_HEADER_LENGTH + 1 ] = ( uint8_t ) STUN_ATTRIBUTE_TYPE_NONCE;
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+    ( void ) StunDeserializer_Init( &( ctx ),
+                                    &( serializedMessage[ 0 ] ),
+                                    serializedMessageLength,
+                                    &( header ) );
+
+    result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ADDRESS_IPv6,
-                       parsedAddress.family );
-    TEST_ASSERT_EQUAL( 0x1234,
-                       parsedAddress.port );
-    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedAddress[ 0 ] ),
-                                   &( parsedAddress.address[ 0 ] ),
-                                   16 );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_FindAttribute in case of different attribute types.
- *
- * It includes the following scenarios:
- *
- * 1. Trying to find the STUN_ATTRIBUTE_TYPE_ICE_CONTROLLED attribute, which is not
- *    present in the STUN message, and expecting the function to return
- *    STUN_RESULT_NO_ATTRIBUTE_FOUND.
- * 2. Finding the STUN_ATTRIBUTE_TYPE_PRIORITY attribute, which is present in the
- *    STUN message, and verifying that the function returns STUN_RESULT_OK.
+ * @brief Validate StunDeserializer_GetNextAttribute incase of malformed priority attribute.
  */
-void test_StunDeserializer_FindAttribute( void )
+void test_StunDeserializer_GetNextAttribute_MalformedPriority( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
@@ -1818,24 +3455,64 @@ void test_StunDeserializer_FindAttribute( void )
     StunAttribute_t attribute = { 0 };
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 0x08 (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x08,
+        /* Message Type = STUN Binding Request, Message Length = 12 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x0C,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute Type = PRIORITY (0x0024), Attribute Length = 4. */
-        0x00, 0x24, 0x00, 0x04,
-        /* Attribute Value = 0x6E000100 (Priority = 2023406816). */
-        0x6E, 0x00, 0x01, 0x00,
+        /* Attribute Type = Priority (0x0024), Attribute Length = 8 (set invalid intentionally). */
+        0x00, 0x24, 0x00, 0x08,
+        /* Priority Value. */
+        0x6E, 0x7F, 0x1A, 0x2B,
+        0x6E, 0x7F, 0x1A, 0x2B,
     };
     size_t serializedMessageLength = sizeof( serializedMessage );
-    uint8_t expectedAttributeValue[] =
+
+    result = StunDeserializer_Init( &( ctx ),
+                                    &( serializedMessage[ 0 ] ),
+                                    serializedMessageLength,
+                                    &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_PRIORITY,
+                       attribute.attributeType );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunDeserializer_GetNextAttribute incase of malformed error attribute.
+ */
+void test_StunDeserializer_GetNextAttribute_MalformedError( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    StunAttribute_t attribute = { 0 };
+    uint8_t serializedMessage[] =
     {
-        /* Priority attribute value = 0x6E000100. */
-        0x6E, 0x00, 0x01, 0x00,
+        /* Message Type = STUN Binding Request, Message Length = 1028 (excluding 20 bytes header). */
+        0x00, 0x01, 0x04, 0x04,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+        /* Attribute Type = Error Code (0x0009), Attribute Length = 1024 (set invalid intentionally). */
+        0x00, 0x09, 0x04, 0x00,
+        /* Reserved = 0x0000, Error Class = 6, Error Number = 0 (Error Code = 600). */
+        0x00, 0x00, 0x06, 0x00,
+        /* Error Phrase. */
+        0x45, 0x72, 0x72, 0x6F, 0x72, 0x20, 0x50, 0x68, 0x72, 0x61, 0x73, 0x65
     };
-    size_t expectedAttributeValueLength = sizeof( expectedAttributeValue );
+    size_t serializedMessageLength = 0x418; /* 1028 + 20 (header) = 1048 (0x418). */
 
     result = StunDeserializer_Init( &( ctx ),
                                     &( serializedMessage[ 0 ] ),
@@ -1845,50 +3522,38 @@ void test_StunDeserializer_FindAttribute( void )
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
 
-    result = StunDeserializer_FindAttribute( &( ctx ),
-                                             STUN_ATTRIBUTE_TYPE_ICE_CONTROLLED,
-                                             &( attribute ) );
-
-    TEST_ASSERT_EQUAL( STUN_RESULT_NO_ATTRIBUTE_FOUND,
-                       result );
-
-    result = StunDeserializer_FindAttribute( &( ctx ),
-                                             STUN_ATTRIBUTE_TYPE_PRIORITY,
-                                             &( attribute ) );
+    result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                &( attribute ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_PRIORITY,
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_ERROR_CODE,
                        attribute.attributeType );
-    TEST_ASSERT_EQUAL( expectedAttributeValueLength,
-                       attribute.attributeValueLength );
-    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedAttributeValue[ 0 ] ),
-                                   attribute.pAttributeValue,
-                                   expectedAttributeValueLength );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_FindAttribute in case of null attribute.
+ * @brief Validate StunDeserializer_GetNextAttribute incase of malformed error attribute.
  */
-void test_StunDeserializer_FindAttribute_NullAttribute( void )
+void test_StunDeserializer_GetNextAttribute_MalformedError_2( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
     StunHeader_t header = { 0 };
+    StunAttribute_t attribute = { 0 };
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 0x08 (excluding 20 bytes header). */
+        /* Message Type = STUN Binding Request, Message Length = 8 (excluding 20 bytes header). */
         0x00, 0x01, 0x00, 0x08,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute Type = PRIORITY (0x0024), Attribute Length = 4. */
-        0x00, 0x24, 0x00, 0x04,
-        /* Attribute Value = 0x6E000100 (Priority = 2023406816). */
-        0x6E, 0x00, 0x01, 0x00,
+        /* Attribute Type = Error Code (0x0009), Attribute Length = 2 (set invalid intentionally). */
+        0x00, 0x09, 0x00, 0x02,
+        /* Reserved = 0x0000, Error Class and Error Number are not set. */
+        0x00, 0x00, 0x00, 0x00,
     };
     size_t serializedMessageLength = sizeof( serializedMessage );
 
@@ -1900,59 +3565,63 @@ void test_StunDeserializer_FindAttribute_NullAttribute( void )
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
 
-    result = StunDeserializer_FindAttribute( &( ctx ),
-                                             STUN_ATTRIBUTE_TYPE_ICE_CONTROLLED,
-                                             NULL );
+    result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                &( attribute ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
                        result );
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_ERROR_CODE,
+                       attribute.attributeType );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_FindAttribute in case of null context.
+ * @brief Validate StunDeserializer_GetNextAttribute incase of malformed dont fragment attribute.
  */
-void test_StunDeserializer_FindAttribute_NullContext( void )
+void test_StunDeserializer_GetNextAttribute_MalformedDontFragment( void )
 {
+    StunContext_t ctx = { 0 };
     StunResult_t result;
+    StunHeader_t header = { 0 };
     StunAttribute_t attribute = { 0 };
+    uint8_t serializedMessage[] =
+    {
+        /* Message Type = STUN Binding Request, Message Length = 8 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x08,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+        /* Attribute Type = Dont fragment (0x001A), Attribute Length = 4 (set invalid intentionally). */
+        0x00, 0x1A, 0x00, 0x04,
+        0x00, 0x1A, 0x00, 0x04,
+    };
+    size_t serializedMessageLength = sizeof( serializedMessage );
 
-    result = StunDeserializer_FindAttribute( NULL,
-                                             STUN_ATTRIBUTE_TYPE_ICE_CONTROLLED,
-                                             &( attribute ) );
+    result = StunDeserializer_Init( &( ctx ),
+                                    &( serializedMessage[ 0 ] ),
+                                    serializedMessageLength,
+                                    &( header ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
-}
-
-/*-----------------------------------------------------------*/
-
-/**
- * @brief Validate StunDeserializer_FindAttribute in case of null StunContext_t.pStart.
- */
-void test_StunDeserializer_FindAttribute_NullContextStart( void )
-{
-    StunContext_t ctx = { 0 };
-    StunResult_t result;
-    StunAttribute_t attribute = { 0 };
 
-    ctx.pStart = NULL;
-
-    result = StunDeserializer_FindAttribute( &( ctx ),
-                                             STUN_ATTRIBUTE_TYPE_ICE_CONTROLLED,
-                                             &( attribute ) );
+    result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                &( attribute ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
                        result );
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_DONT_FRAGMENT,
+                       attribute.attributeType );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetNextAttribute incase of invalid attribute order.
+ * @brief Validate StunDeserializer_GetNextAttribute incase of malformed ice-controlled attribute.
  */
-void test_StunDeserializer_GetNextAttribute_InvalidAttributeOrder( void )
+void test_StunDeserializer_GetNextAttribute_MalformedIceControlled( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
@@ -1960,24 +3629,18 @@ void test_StunDeserializer_GetNextAttribute_InvalidAttributeOrder( void )
     StunAttribute_t attribute = { 0 };
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 0x20 (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x20,
+        /* Message Type = STUN Binding Request, Message Length = 16 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x10,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute type = FINGERPRINT (0x8028), Attribute Length = 4. */
-        0x80, 0x28, 0x00, 0x04,
-        /* Attribute Value = 0x078E383F (Obtained from XOR of 0x54DA6D71 and STUN_ATTRIBUTE_FINGERPRINT_XOR_VALUE). */
-        0x07, 0x8E, 0x38, 0x3F,
-        /* Attribute type = MESSAGE-INTEGRITY (0x0008), Length = 20 bytes. */
-        0x00, 0x08, 0x00, 0x14,
-        /* Attribute Value = 20 bytes SHA-1 HMAC value. */
-        0x72, 0x64, 0x6D, 0x2F,
-        0x55, 0x77, 0xF4, 0x23,
-        0x73, 0x72, 0x75, 0x6C,
-        0x76, 0x61, 0x74, 0x62,
-        0xAB, 0xCD, 0xDE, 0xEF,
+        /* Attribute type = ICE-CONTROLLED (0x8029), Attribute Length = 12 (set invalid intentionally). */
+        0x80, 0x29, 0x00, 0x0C,
+        /* Attribute Value= 0x0123456789ABCDEF (tie breaker value) and 4 invalid bytes. */
+        0x12, 0x34, 0x56, 0x78,
+        0x90, 0xAB, 0xCD, 0xEF,
+        0x12, 0x34, 0x56, 0x78,
     };
     size_t serializedMessageLength = sizeof( serializedMessage );
 
@@ -1989,30 +3652,21 @@ void test_StunDeserializer_GetNextAttribute_InvalidAttributeOrder( void )
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
 
-    /* First attribute is FINGERPRINT. */
     result = StunDeserializer_GetNextAttribute( &( ctx ),
                                                 &( attribute ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_FINGERPRINT,
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_ICE_CONTROLLED,
                        attribute.attributeType );
-
-    /* Next attribute is the Message-Integrity attribute. However, this is an
-     * invalid order, as Message-Integrity must come before Fingerprint. */
-    result = StunDeserializer_GetNextAttribute( &( ctx ),
-                                                &( attribute ) );
-
-    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE_ORDER,
-                       result );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetNextAttribute incase of invalid attribute order.
+ * @brief Validate StunDeserializer_GetNextAttribute incase of malformed ice-controlling attribute.
  */
-void test_StunDeserializer_GetNextAttribute_InvalidAttributeOrder_2( void )
+void test_StunDeserializer_GetNextAttribute_MalformedIceControlling( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
@@ -2020,24 +3674,18 @@ void test_StunDeserializer_GetNextAttribute_InvalidAttributeOrder_2( void )
     StunAttribute_t attribute = { 0 };
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 0x20 (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x20,
+        /* Message Type = STUN Binding Request, Message Length = 16 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x10,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute type = MESSAGE-INTEGRITY (0x0008), Length = 20 bytes. */
-        0x00, 0x08, 0x00, 0x14,
-        /* Attribute Value = 20 bytes SHA-1 HMAC value. */
-        0x72, 0x64, 0x6D, 0x2F,
-        0x55, 0x77, 0xF4, 0x23,
-        0x73, 0x72, 0x75, 0x6C,
-        0x76, 0x61, 0x74, 0x62,
-        0xAB, 0xCD, 0xDE, 0xEF,
-        /* Attribute Type = PRIORITY (0x0024), Attribute Length = 4. */
-        0x00, 0x24, 0x00, 0x04,
-        /* Attribute Value = 0x6E000100 (Priority = 2023406816). */
-        0x6E, 0x00, 0x01, 0x00,
+        /* Attribute Type = ICE-CONTROLLING (0x802A), Attribute Length = 12 (set invalid intentionally). */
+        0x80, 0x2A, 0x00, 0x0C,
+        /* Attribute Value = 0x0123456789ABCDEF (tie breaker value) and 4 invalid bytes. */
+        0x01, 0x23, 0x45, 0x67,
+        0x89, 0xAB, 0xCD, 0xEF,
+        0x89, 0xAB, 0xCD, 0xEF,
     };
     size_t serializedMessageLength = sizeof( serializedMessage );
 
@@ -2049,57 +3697,37 @@ void test_StunDeserializer_GetNextAttribute_InvalidAttributeOrder_2( void )
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
 
-    /* First attribute is Message-Integrity. */
     result = StunDeserializer_GetNextAttribute( &( ctx ),
                                                 &( attribute ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_MESSAGE_INTEGRITY,
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_ICE_CONTROLLING,
                        attribute.attributeType );
-
-    /* Next attribute is the Priority. However, this is an invalid order, as
-     * Priority must come before Message-Integrity. Only Fingerprint attribute
-     * can come after the Message-Integrity attribute. */
-    result = StunDeserializer_GetNextAttribute( &( ctx ),
-                                                &( attribute ) );
-
-    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE_ORDER,
-                       result );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetNextAttribute incase of valid attribute order.
+ * @brief Validate StunDeserializer_GetNextAttribute incase of malformed use-candidate attribute.
  */
-void test_StunDeserializer_GetNextAttribute_ValidAttributeOrder( void )
+void test_StunDeserializer_GetNextAttribute_MalformedUseCandidate( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
     StunHeader_t header = { 0 };
     StunAttribute_t attribute = { 0 };
-    uint32_t crc32Fingerprint;
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 0x20 (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x20,
+        /* Message Type = STUN Binding Request, Message Length = 8 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x08,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute type = MESSAGE-INTEGRITY (0x0008), Length = 20 bytes. */
-        0x00, 0x08, 0x00, 0x14,
-        /* Attribute Value = 20 bytes SHA-1 HMAC value. */
-        0x72, 0x64, 0x6D, 0x2F,
-        0x55, 0x77, 0xF4, 0x23,
-        0x73, 0x72, 0x75, 0x6C,
-        0x76, 0x61, 0x74, 0x62,
-        0xAB, 0xCD, 0xDE, 0xEF,
-        /* Attribute type = FINGERPRINT (0x8028), Attribute Length = 4. */
-        0x80, 0x28, 0x00, 0x04,
-        /* Attribute Value = 0x078E383F (Obtained from XOR of 0x54DA6D71 and STUN_ATTRIBUTE_FINGERPRINT_XOR_VALUE). */
-        0x07, 0x8E, 0x38, 0x3F,
+        /* Attribute Type = USE-CANDIDATE (0x0025), Length = 4 (set invalid intentionally). */
+        0x00, 0x25, 0x00, 0x04,
+        0x00, 0x25, 0x00, 0x04,
     };
     size_t serializedMessageLength = sizeof( serializedMessage );
 
@@ -2111,40 +3739,21 @@ void test_StunDeserializer_GetNextAttribute_ValidAttributeOrder( void )
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
 
-    /* First attribute is Message-Integrity. */
-    result = StunDeserializer_GetNextAttribute( &( ctx ),
-                                                &( attribute ) );
-
-    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
-                       result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_MESSAGE_INTEGRITY,
-                       attribute.attributeType );
-
-    /* Next attribute is Fingerprint. */
     result = StunDeserializer_GetNextAttribute( &( ctx ),
                                                 &( attribute ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_FINGERPRINT,
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_USE_CANDIDATE,
                        attribute.attributeType );
-
-    result = StunDeserializer_ParseAttributeFingerprint( &( ctx ),
-                                                         &( attribute ),
-                                                         &( crc32Fingerprint ) );
-
-    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
-                       result );
-    TEST_ASSERT_EQUAL( 0x54DA6D71,
-                       crc32Fingerprint );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetNextAttribute in case of zero attributeValueLength.
+ * @brief Validate StunDeserializer_GetNextAttribute incase of malformed lifetime attribute.
  */
-void test_StunDeserializer_GetNextAttribute_ZeroAttributeValueLength( void )
+void test_StunDeserializer_GetNextAttribute_MalformedLifetime( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
@@ -2152,14 +3761,17 @@ void test_StunDeserializer_GetNextAttribute_ZeroAttributeValueLength( void )
     StunAttribute_t attribute = { 0 };
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 0x04 (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x04,
+        /* Message Type = STUN Binding Request, Message Length = 12 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x0C,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute Type = USE-CANDIDATE (0x0025), Length = 0. */
-        0x00, 0x25, 0x00, 0x00,
+        /* Attribute Type = Lifetime (0x000D), Attribute Length = 8 (set invalid intentionally). */
+        0x00, 0x0D, 0x00, 0x08,
+        /* Attribute Value = 0x0000EA60 (60000 seconds in hex) and 4 invalid bytes. */
+        0x00, 0x00, 0xEA, 0x60,
+        0x6E, 0x7F, 0x1A, 0x2B,
     };
     size_t serializedMessageLength = sizeof( serializedMessage );
 
@@ -2174,22 +3786,18 @@ void test_StunDeserializer_GetNextAttribute_ZeroAttributeValueLength( void )
     result = StunDeserializer_GetNextAttribute( &( ctx ),
                                                 &( attribute ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_USE_CANDIDATE,
-                       attribute.attributeType );
-    TEST_ASSERT_EQUAL( 0,
-                       attribute.attributeValueLength );
-    TEST_ASSERT_EQUAL( NULL,
-                       attribute.pAttributeValue );
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_LIFETIME,
+                       attribute.attributeType );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetNextAttribute in case of out of memory.
+ * @brief Validate StunDeserializer_GetNextAttribute incase of malformed channel number attribute.
  */
-void test_StunDeserializer_GetNextAttribute_OutOfMemory( void )
+void test_StunDeserializer_GetNextAttribute_MalformedChannelNumber( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
@@ -2197,15 +3805,17 @@ void test_StunDeserializer_GetNextAttribute_OutOfMemory( void )
     StunAttribute_t attribute = { 0 };
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 0x04 (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x04,
+        /* Message Type = STUN Binding Request, Message Length = 12 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x0C,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute Type = PRIORITY (0x0024), Attribute Length = 4. */
-        0x00, 0x24, 0x00, 0x04,
-        /* Missing priority value. */
+        /* Attribute Type = Channel Number (0x000C), Attribute Length = 8 (set invalid intentionally). */
+        0x00, 0x0C, 0x00, 0x08,
+        /* Channel Number = 0x1234, Reserved = 0x0000 and, 4 invalid bytes. */
+        0x12, 0x34, 0x00, 0x00,
+        0x6E, 0x7F, 0x1A, 0x2B,
     };
     size_t serializedMessageLength = sizeof( serializedMessage );
 
@@ -2220,16 +3830,18 @@ void test_StunDeserializer_GetNextAttribute_OutOfMemory( void )
     result = StunDeserializer_GetNextAttribute( &( ctx ),
                                                 &( attribute ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_OUT_OF_MEMORY,
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
                        result );
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_CHANNEL_NUMBER,
+                       attribute.attributeType );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetNextAttribute incase of malformed message-integrity attribute.
+ * @brief Validate StunDeserializer_GetNextAttribute incase of malformed change request attribute.
  */
-void test_StunDeserializer_GetNextAttribute_MalformedMessageIntegrity( void )
+void test_StunDeserializer_GetNextAttribute_MalformedChangeRequest( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
@@ -2237,25 +3849,17 @@ void test_StunDeserializer_GetNextAttribute_MalformedMessageIntegrity( void )
     StunAttribute_t attribute = { 0 };
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 0x24 (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x24,
+        /* Message Type = STUN Binding Request, Message Length = 12 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x0C,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute type = MESSAGE-INTEGRITY (0x0008), Length = 24 bytes (set invalid intentionally). */
-        0x00, 0x08, 0x00, 0x18,
-        /* Attribute Value = 24 bytes SHA-1 HMAC value (set invalid intentionally). */
-        0x72, 0x64, 0x6D, 0x2F,
-        0x55, 0x77, 0xF4, 0x23,
-        0x73, 0x72, 0x75, 0x6C,
-        0x76, 0x61, 0x74, 0x62,
-        0xAB, 0xCD, 0xDE, 0xEF,
-        0x80, 0x28, 0x00, 0x04,
-        /* Attribute type = FINGERPRINT (0x8028), Attribute Length = 4. */
-        0x80, 0x28, 0x00, 0x04,
-        /* Attribute Value = 0x078E383F (Obtained from XOR of 0x54DA6D71 and STUN_ATTRIBUTE_FINGERPRINT_XOR_VALUE). */
-        0x07, 0x8E, 0x38, 0x3F,
+        /* Attribute Type = CHANGE-REQUEST (0x0003), Attribute Length = 8 (set invalid intentionally). */
+        0x00, 0x03, 0x00, 0x08,
+        /* Attribute Value = 0x00000004 (Change IP flag) and, 4 invalid bytes. */
+        0x00, 0x00, 0x00, 0x04,
+        0x6E, 0x7F, 0x1A, 0x2B,
     };
     size_t serializedMessageLength = sizeof( serializedMessage );
 
@@ -2272,21 +3876,23 @@ void test_StunDeserializer_GetNextAttribute_MalformedMessageIntegrity( void )
 
     TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_MESSAGE_INTEGRITY,
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_CHANGE_REQUEST,
                        attribute.attributeType );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetNextAttribute incase of malformed fingerprint attribute.
+ * @brief Validate StunDeserializer_ParseAttributeAddress (RESPONSE_ADDRESS Type) in happy path.
  */
-void test_StunDeserializer_GetNextAttribute_MalformedFingerprint( void )
+void test_StunDeserializer_ParseAttributeAddress_ResponseAddress_HappyPath( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
     StunHeader_t header = { 0 };
     StunAttribute_t attribute = { 0 };
+    StunAttributeAddress_t parsedAddress = { 0 };
+    uint8_t expectedAddress[] = { 0x7F, 0x00, 0x00, 0x01 };
     uint8_t serializedMessage[] =
     {
         /* Message Type = STUN Binding Request, Message Length = 0x0C (excluding 20 bytes header). */
@@ -2295,11 +3901,10 @@ void test_StunDeserializer_GetNextAttribute_MalformedFingerprint( void )
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute type = FINGERPRINT (0x8028), Attribute Length = 8 (set invalid intentionally). */
-        0x80, 0x28, 0x00, 0x08,
-        /* Attribute Value = 0x078E383F078E383F. */
-        0x07, 0x8E, 0x38, 0x3F,
-        0x07, 0x8E, 0x38, 0x3F,
+        /* Attribute type = RESPONSE-ADDRESS (0x0002), Attribute Length = 8. */
+        0x00, 0x02, 0x00, 0x08,
+        /* Address family = IPv4, Port = 0x1234, IP Address = 0x7F000001 (127.0.0.1). */
+        0x00, 0x01, 0x12, 0x34, 0x7F, 0x00, 0x00, 0x01,
     };
     size_t serializedMessageLength = sizeof( serializedMessage );
 
@@ -2314,37 +3919,51 @@ void test_StunDeserializer_GetNextAttribute_MalformedFingerprint( void )
     result = StunDeserializer_GetNextAttribute( &( ctx ),
                                                 &( attribute ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_FINGERPRINT,
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_RESPONSE_ADDRESS,
                        attribute.attributeType );
+
+    result = StunDeserializer_ParseAttributeAddress( &( ctx ),
+                                                     &( attribute ),
+                                                     &( parsedAddress ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ADDRESS_IPv4,
+                       parsedAddress.family );
+    TEST_ASSERT_EQUAL( 0x1234,
+                       parsedAddress.port );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedAddress[ 0 ] ),
+                                   &( parsedAddress.address[ 0 ] ),
+                                   4 );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetNextAttribute incase of malformed mapped address attribute.
+ * @brief Validate StunDeserializer_ParseAttributeAddress (SOURCE_ADDRESS Type) in happy path.
  */
-void test_StunDeserializer_GetNextAttribute_MalformedIPv4MappedAddress( void )
+void test_StunDeserializer_ParseAttributeAddress_SourceAddress_HappyPath( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
     StunHeader_t header = { 0 };
     StunAttribute_t attribute = { 0 };
+    StunAttributeAddress_t parsedAddress = { 0 };
+    uint8_t expectedAddress[] = { 0xC0, 0xA8, 0x01, 0x01 };
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 0x14 (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x14,
+        /* Message Type = STUN Binding Request, Message Length = 0x0C (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x0C,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute type = MAPPED-ADDRESS (0x0001), Attribute Length = 16 (set invalid intentionally). */
-        0x00, 0x01, 0x00, 0x10,
-        /* Address family = IPv4, Port = 0x1234, IP Address = 0x7F000001 (127.0.0.1)
-         * and additional 8 invalid bytes. */
-        0x00, 0x01, 0x12, 0x34, 0x7F, 0x00, 0x00, 0x01,
-        0x80, 0x28, 0x00, 0x04, 0x07, 0x8E, 0x38, 0x3F,
+        /* Attribute type = SOURCE-ADDRESS (0x0004), Attribute Length = 8. */
+        0x00, 0x04, 0x00, 0x08,
+        /* Address family = IPv4, Port = 0x5678, IP Address = 0xC0A80101 (192.168.1.1). */
+        0x00, 0x01, 0x56, 0x78, 0xC0, 0xA8, 0x01, 0x01,
     };
     size_t serializedMessageLength = sizeof( serializedMessage );
 
@@ -2359,41 +3978,51 @@ void test_StunDeserializer_GetNextAttribute_MalformedIPv4MappedAddress( void )
     result = StunDeserializer_GetNextAttribute( &( ctx ),
                                                 &( attribute ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_MAPPED_ADDRESS,
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_SOURCE_ADDRESS,
                        attribute.attributeType );
+
+    result = StunDeserializer_ParseAttributeAddress( &( ctx ),
+                                                     &( attribute ),
+                                                     &( parsedAddress ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ADDRESS_IPv4,
+                       parsedAddress.family );
+    TEST_ASSERT_EQUAL( 0x5678,
+                       parsedAddress.port );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedAddress[ 0 ] ),
+                                   &( parsedAddress.address[ 0 ] ),
+                                   4 );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetNextAttribute incase of malformed mapped address attribute.
+ * @brief Validate StunDeserializer_ParseAttributeAddress (CHANGED_ADDRESS Type) in happy path.
  */
-void test_StunDeserializer_GetNextAttribute_MalformedIPv6MappedAddress( void )
+void test_StunDeserializer_ParseAttributeAddress_ChangedAddress_HappyPath( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
     StunHeader_t header = { 0 };
     StunAttribute_t attribute = { 0 };
+    StunAttributeAddress_t parsedAddress = { 0 };
+    uint8_t expectedAddress[] = { 0x08, 0x08, 0x08, 0x08 };
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 0x1C (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x1C,
+        /* Message Type = STUN Binding Request, Message Length = 0x0C (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x0C,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute type = MAPPED-ADDRESS (0x0001), Attribute Length = 24 (set invalid intentionally). */
-        0x00, 0x01, 0x00, 0x18,
-        /* Address family = IPv6, Port = 0x1234,
-         * IP Address = 0113:A9FA:9797:5678:9ABC:54DE:A8BD:9C91 and 4 invalid bytes. */
-        0x00, 0x02, 0x12, 0x34,
-        0x01, 0x13, 0xA9, 0xFA,
-        0x97, 0x97, 0x56, 0x78,
-        0x9A, 0xBC, 0x54, 0xDE,
-        0xA8, 0xBD, 0x9C, 0x91,
-        0x80, 0x28, 0x00, 0x04,
+        /* Attribute type = CHANGED-ADDRESS (0x0005), Attribute Length = 8. */
+        0x00, 0x05, 0x00, 0x08,
+        /* Address family = IPv4, Port = 0x0050, IP Address = 0x08080808 (8.8.8.8). */
+        0x00, 0x01, 0x00, 0x50, 0x08, 0x08, 0x08, 0x08,
     };
     size_t serializedMessageLength = sizeof( serializedMessage );
 
@@ -2408,42 +4037,51 @@ void test_StunDeserializer_GetNextAttribute_MalformedIPv6MappedAddress( void )
     result = StunDeserializer_GetNextAttribute( &( ctx ),
                                                 &( attribute ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_MAPPED_ADDRESS,
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_CHANGED_ADDRESS,
                        attribute.attributeType );
+
+    result = StunDeserializer_ParseAttributeAddress( &( ctx ),
+                                                     &( attribute ),
+                                                     &( parsedAddress ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ADDRESS_IPv4,
+                       parsedAddress.family );
+    TEST_ASSERT_EQUAL( 0x0050,
+                       parsedAddress.port );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedAddress[ 0 ] ),
+                                   &( parsedAddress.address[ 0 ] ),
+                                   4 );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetNextAttribute incase of malformed XOR mapped address attribute.
+ * @brief Validate StunDeserializer_ParseAttributeAddress (REFLECTED_FROM Type) in happy path.
  */
-void test_StunDeserializer_GetNextAttribute_MalformedIPv6XorMappedAddress( void )
+void test_StunDeserializer_ParseAttributeAddress_ReflectedFrom_HappyPath( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
     StunHeader_t header = { 0 };
     StunAttribute_t attribute = { 0 };
+    StunAttributeAddress_t parsedAddress = { 0 };
+    uint8_t expectedAddress[] = { 0xAC, 0x10, 0x0A, 0x01 };
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 0x1C (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x1C,
+        /* Message Type = STUN Binding Request, Message Length = 0x0C (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x0C,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute type = XOR-MAPPED-ADDRESS (0x0020), Attribute Length = 24 (set invalid intentionally). */
-        0x00, 0x20, 0x00, 0x18,
-        /* Address family = IPv6, Port = 0x3326 (0x1234 XOR'd with 2 msb of cookie),
-         * IP Address = 2001:0DB8:85A3:0000:0000:8A2E:0370:7334 (0113:A9FA:9797:5678:9ABC:54DE:A8BD:9C91
-         * XOR'd with cookie and transaction ID) and 4 invalid bytes. */
-        0x00, 0x02, 0x33, 0x26,
-        0x20, 0x01, 0x0D, 0xB8,
-        0x85, 0xA3, 0x00, 0x00,
-        0x00, 0x00, 0x8A, 0x2E,
-        0x03, 0x70, 0x73, 0x34,
-        0x03, 0x70, 0x73, 0x34,
+        /* Attribute type = REFLECTED-FROM (0x000B), Attribute Length = 8. */
+        0x00, 0x0B, 0x00, 0x08,
+        /* Address family = IPv4, Port = 0x1A0A, IP Address = 0xAC100A01 (172.16.10.1). */
+        0x00, 0x01, 0x1A, 0x0A, 0xAC, 0x10, 0x0A, 0x01,
     };
     size_t serializedMessageLength = sizeof( serializedMessage );
 
@@ -2458,18 +4096,32 @@ void test_StunDeserializer_GetNextAttribute_MalformedIPv6XorMappedAddress( void
     result = StunDeserializer_GetNextAttribute( &( ctx ),
                                                 &( attribute ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_XOR_MAPPED_ADDRESS,
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_REFLECTED_FROM,
                        attribute.attributeType );
+
+    result = StunDeserializer_ParseAttributeAddress( &( ctx ),
+                                                     &( attribute ),
+                                                     &( parsedAddress ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ADDRESS_IPv4,
+                       parsedAddress.family );
+    TEST_ASSERT_EQUAL( 0x1A0A,
+                       parsedAddress.port );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedAddress[ 0 ] ),
+                                   &( parsedAddress.address[ 0 ] ),
+                                   4 );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetNextAttribute incase of malformed XOR relayed address attribute.
+ * @brief Validate StunDeserializer_GetNextAttribute with malformed RESPONSE_ADDRESS attribute.
  */
-void test_StunDeserializer_GetNextAttribute_MalformedXorRelayedAddress( void )
+void test_StunDeserializer_GetNextAttribute_MalformedResponseAddress( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
@@ -2477,19 +4129,18 @@ void test_StunDeserializer_GetNextAttribute_MalformedXorRelayedAddress( void )
     StunAttribute_t attribute = { 0 };
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 0x10 (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x10,
+        /* Message Type = STUN Binding Request, Message Length = 0x14 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x14,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute type = XOR-RELAYED-ADDRESS (0x0016), Attribute Length = 12 (set invalid intentionally). */
-        0x00, 0x16, 0x00, 0x0C,
-        /* Address family = IPv4, Port = 0x3326 (0x1234 XOR'd with 2 msb of cookie),
-         * IP Address = 0x5E12A443 (127.0.0.1 XOR'd with cookie) and 4 invalid bytes. */
-        0x00, 0x01, 0x33, 0x26,
-        0x5E, 0x12, 0xA4, 0x43,
-        0x00, 0x16, 0x00, 0x0C,
+        /* Attribute type = RESPONSE-ADDRESS (0x0002), Attribute Length = 16 (set invalid intentionally). */
+        0x00, 0x02, 0x00, 0x10,
+        /* Address family = IPv4, Port = 0x1234, IP Address = 0x7F000001 (127.0.0.1)
+         * and additional 8 invalid bytes. */
+        0x00, 0x01, 0x12, 0x34, 0x7F, 0x00, 0x00, 0x01,
+        0x80, 0x28, 0x00, 0x04, 0x07, 0x8E, 0x38, 0x3F,
     };
     size_t serializedMessageLength = sizeof( serializedMessage );
 
@@ -2506,16 +4157,16 @@ void test_StunDeserializer_GetNextAttribute_MalformedXorRelayedAddress( void )
 
     TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_XOR_RELAYED_ADDRESS,
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_RESPONSE_ADDRESS,
                        attribute.attributeType );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetNextAttribute incase of malformed realm attribute.
+ * @brief Validate StunDeserializer_GetNextAttribute with malformed SOURCE_ADDRESS attribute.
  */
-void test_StunDeserializer_GetNextAttribute_MalformedRealm( void )
+void test_StunDeserializer_GetNextAttribute_MalformedSourceAddress( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
@@ -2523,22 +4174,20 @@ void test_StunDeserializer_GetNextAttribute_MalformedRealm( void )
     StunAttribute_t attribute = { 0 };
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 1028 (excluding 20 bytes header). */
-        0x00, 0x01, 0x04, 0x04,
+        /* Message Type = STUN Binding Request, Message Length = 0x14 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x14,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute Type = REALM (0x0014), Attribute Length = 1024 (set invalid intentionally). */
-        0x00, 0x14, 0x04, 0x00,
-        /* Attribute Value = "Realm Example". */
-        0x52, 0x65, 0x61, 0x6C,
-        0x6D, 0x20, 0x45, 0x78,
-        0x61, 0x6D, 0x70, 0x6C,
-        0x65, 0x00, 0x00, 0x00,
-        0x65, 0x00, 0x00, 0x00,
+        /* Attribute type = SOURCE-ADDRESS (0x0004), Attribute Length = 16 (set invalid intentionally). */
+        0x00, 0x04, 0x00, 0x10,
+        /* Address family = IPv4, Port = 0x5678, IP Address = 0xC0A80101 (192.168.1.1)
+         * and additional 8 invalid bytes. */
+        0x00, 0x01, 0x56, 0x78, 0xC0, 0xA8, 0x01, 0x01,
+        0x00, 0x04, 0x00, 0x10, 0xC0, 0xA8, 0x01, 0x01,
     };
-    size_t serializedMessageLength = 0x418; /* 1028 + 20 (header) = 1048 (0x418). */
+    size_t serializedMessageLength = sizeof( serializedMessage );
 
     result = StunDeserializer_Init( &( ctx ),
                                     &( serializedMessage[ 0 ] ),
@@ -2553,16 +4202,16 @@ void test_StunDeserializer_GetNextAttribute_MalformedRealm( void )
 
     TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_REALM,
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_SOURCE_ADDRESS,
                        attribute.attributeType );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetNextAttribute incase of malformed nonce attribute.
+ * @brief Validate StunDeserializer_GetNextAttribute with malformed CHANGED_ADDRESS attribute.
  */
-void test_StunDeserializer_GetNextAttribute_MalformedNonce( void )
+void test_StunDeserializer_GetNextAttribute_MalformedChangedAddress( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
@@ -2570,21 +4219,20 @@ void test_StunDeserializer_GetNextAttribute_MalformedNonce( void )
     StunAttribute_t attribute = { 0 };
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 1028 (excluding 20 bytes header). */
-        0x00, 0x01, 0x04, 0x04,
+        /* Message Type = STUN Binding Request, Message Length = 0x14 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x14,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute Type = NONCE (0x0015), Attribute Length = 1024 (set invalid intentionally). */
-        0x00, 0x15, 0x04, 0x00,
-        /* Attribute Value = "Nonce Example". */
-        0x4E, 0x6F, 0x6E, 0x63,
-        0x65, 0x20, 0x45, 0x78,
-        0x61, 0x6D, 0x70, 0x6C,
-        0x65, 0x00, 0x00, 0x00,
+        /* Attribute type = CHANGED-ADDRESS (0x0005), Attribute Length = 16 (set invalid intentionally). */
+        0x00, 0x05, 0x00, 0x10,
+        /* Address family = IPv4, Port = 0x0050, IP Address = 0x08080808 (8.8.8.8)
+         * and additional 8 invalid bytes. */
+        0x00, 0x01, 0x00, 0x50, 0x08, 0x08, 0x08, 0x08,
+        0x00, 0x05, 0x00, 0x10, 0x08, 0x08, 0x08, 0x08,
     };
-    size_t serializedMessageLength = 0x418; /* 1028 + 20 (header) = 1048 (0x418). */
+    size_t serializedMessageLength = sizeof( serializedMessage );
 
     result = StunDeserializer_Init( &( ctx ),
                                     &( serializedMessage[ 0 ] ),
@@ -2599,16 +4247,16 @@ void test_StunDeserializer_GetNextAttribute_MalformedNonce( void )
 
     TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_NONCE,
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_CHANGED_ADDRESS,
                        attribute.attributeType );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetNextAttribute incase of maximum length of nonce attribute.
+ * @brief Validate StunDeserializer_GetNextAttribute with malformed REFLECTED_FROM attribute.
  */
-void test_StunDeserializer_GetNextAttribute_MaxLengthNonce( void )
+void test_StunDeserializer_GetNextAttribute_MalformedReflectedFrom( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
@@ -2616,21 +4264,20 @@ void test_StunDeserializer_GetNextAttribute_MaxLengthNonce( void )
     StunAttribute_t attribute = { 0 };
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 516 (excluding 20 bytes header). */
-        0x00, 0x01, 0x02, 0x04,
+        /* Message Type = STUN Binding Request, Message Length = 0x14 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x14,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute Type = NONCE (0x0015), Attribute Length = 512 (set invalid intentionally). */
-        0x00, 0x15, 0x02, 0x00,
-        /* Attribute Value = "Nonce Example". */
-        0x4E, 0x6F, 0x6E, 0x63,
-        0x65, 0x20, 0x45, 0x78,
-        0x61, 0x6D, 0x70, 0x6C,
-        0x65, 0x00, 0x00, 0x00,
+        /* Attribute type = REFLECTED-FROM (0x000B), Attribute Length = 16 (set invalid intentionally). */
+        0x00, 0x0B, 0x00, 0x10,
+        /* Address family = IPv4, Port = 0x1A0A, IP Address = 0xAC100A01 (172.16.10.1)
+         * and additional 8 invalid bytes. */
+        0x00, 0x01, 0x1A, 0x0A, 0xAC, 0x10, 0x0A, 0x01,
+        0x00, 0x0B, 0x00, 0x10, 0xAC, 0x10, 0x0A, 0x01,
     };
-    size_t serializedMessageLength = 0x218; /* 516 + 20 (header) = 536 (0x218). */
+    size_t serializedMessageLength = sizeof( serializedMessage );
 
     result = StunDeserializer_Init( &( ctx ),
                                     &( serializedMessage[ 0 ] ),
@@ -2643,18 +4290,20 @@ void test_StunDeserializer_GetNextAttribute_MaxLengthNonce( void )
     result = StunDeserializer_GetNextAttribute( &( ctx ),
                                                 &( attribute ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_NONCE,
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_REFLECTED_FROM,
                        attribute.attributeType );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetNextAttribute incase of malformed priority attribute.
+ * @brief Validate StunDeserializer_GetNextAttribute with attribute types that
+ * the library does not know, both inside and outside of the attribute index
+ * slots.
  */
-void test_StunDeserializer_GetNextAttribute_MalformedPriority( void )
+void test_StunDeserializer_GetNextAttribute_UnknownAttributes( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
@@ -2662,17 +4311,20 @@ void test_StunDeserializer_GetNextAttribute_MalformedPriority( void )
     StunAttribute_t attribute = { 0 };
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 12 (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x0C,
+        /* Message Type = STUN Binding Request, Message Length = 0x14 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x14,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute Type = Priority (0x0024), Attribute Length = 8 (set invalid intentionally). */
-        0x00, 0x24, 0x00, 0x08,
-        /* Priority Value. */
-        0x6E, 0x7F, 0x1A, 0x2B,
-        0x6E, 0x7F, 0x1A, 0x2B,
+        /* Attribute type = SOFTWARE (0x8022), Attribute Length = 6. */
+        0x80, 0x22, 0x00, 0x06,
+        /* Attribute Value = "libkvs" and 2 padding bytes. */
+        0x6C, 0x69, 0x62, 0x6B, 0x76, 0x73, 0x00, 0x00,
+        /* Attribute type = NETWORK-COST (0xC057), Attribute Length = 4. */
+        0xC0, 0x57, 0x00, 0x04,
+        /* Network ID = 0x0001, Cost = 0x000A. */
+        0x00, 0x01, 0x00, 0x0A,
     };
     size_t serializedMessageLength = sizeof( serializedMessage );
 
@@ -2687,39 +4339,53 @@ void test_StunDeserializer_GetNextAttribute_MalformedPriority( void )
     result = StunDeserializer_GetNextAttribute( &( ctx ),
                                                 &( attribute ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_PRIORITY,
+    TEST_ASSERT_EQUAL( 0x8022,
+                       attribute.attributeType );
+    TEST_ASSERT_EQUAL( 6,
+                       attribute.attributeValueLength );
+
+    result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( 0xC057,
                        attribute.attributeType );
+    TEST_ASSERT_EQUAL( 4,
+                       attribute.attributeValueLength );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetNextAttribute incase of malformed error attribute.
+ * @brief Validate StunDeserializer_GetNextAttribute rejects an unknown attribute
+ * longer than STUN_ATTRIBUTE_VALUE_MAX_LENGTH.
  */
-void test_StunDeserializer_GetNextAttribute_MalformedError( void )
+void test_StunDeserializer_GetNextAttribute_MalformedUnknownAttribute( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
     StunHeader_t header = { 0 };
     StunAttribute_t attribute = { 0 };
-    uint8_t serializedMessage[] =
+    uint8_t serializedMessage[ STUN_HEADER_LENGTH + 4 + 516 ] = { 0 };
+    uint8_t serializedHeader[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 1028 (excluding 20 bytes header). */
-        0x00, 0x01, 0x04, 0x04,
+        /* Message Type = STUN Binding Request, Message Length = 520 (excluding 20 bytes header). */
+        0x00, 0x01, 0x02, 0x08,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute Type = Error Code (0x0009), Attribute Length = 1024 (set invalid intentionally). */
-        0x00, 0x09, 0x04, 0x00,
-        /* Reserved = 0x0000, Error Class = 6, Error Number = 0 (Error Code = 600). */
-        0x00, 0x00, 0x06, 0x00,
-        /* Error Phrase. */
-        0x45, 0x72, 0x72, 0x6F, 0x72, 0x20, 0x50, 0x68, 0x72, 0x61, 0x73, 0x65
+        /* Attribute type = 0x0030 (unknown), Attribute Length = 516 (set invalid intentionally). */
+        0x00, 0x30, 0x02, 0x04,
     };
-    size_t serializedMessageLength = 0x418; /* 1028 + 20 (header) = 1048 (0x418). */
+    size_t serializedMessageLength = sizeof( serializedMessage );
+
+    memcpy( &( serializedMessage[ 0 ] ),
+            &( serializedHeader[ 0 ] ),
+            sizeof( serializedHeader ) );
 
     result = StunDeserializer_Init( &( ctx ),
                                     &( serializedMessage[ 0 ] ),
@@ -2734,16 +4400,16 @@ void test_StunDeserializer_GetNextAttribute_MalformedError( void )
 
     TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_ERROR_CODE,
+    TEST_ASSERT_EQUAL( 0x0030,
                        attribute.attributeType );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetNextAttribute incase of malformed error attribute.
+ * @brief Validate StunDeserializer_GetNextAttribute with USERNAME attribute.
  */
-void test_StunDeserializer_GetNextAttribute_MalformedError_2( void )
+void test_StunDeserializer_GetNextAttribute_Username_HappyPath( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
@@ -2751,16 +4417,17 @@ void test_StunDeserializer_GetNextAttribute_MalformedError_2( void )
     StunAttribute_t attribute = { 0 };
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 8 (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x08,
+        /* Message Type = STUN Binding Request, Message Length = 0x0C (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x0C,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute Type = Error Code (0x0009), Attribute Length = 2 (set invalid intentionally). */
-        0x00, 0x09, 0x00, 0x02,
-        /* Reserved = 0x0000, Error Class and Error Number are not set. */
-        0x00, 0x00, 0x00, 0x00,
+        /* Attribute type = USERNAME (0x0006), Attribute Length = 8. */
+        0x00, 0x06, 0x00, 0x08,
+        /* Username = "testuser". */
+        0x74, 0x65, 0x73, 0x74,
+        0x75, 0x73, 0x65, 0x72,
     };
     size_t serializedMessageLength = sizeof( serializedMessage );
 
@@ -2775,79 +4442,138 @@ void test_StunDeserializer_GetNextAttribute_MalformedError_2( void )
     result = StunDeserializer_GetNextAttribute( &( ctx ),
                                                 &( attribute ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_ERROR_CODE,
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_USERNAME,
                        attribute.attributeType );
+    TEST_ASSERT_EQUAL( 8,
+                       attribute.attributeValueLength );
+    TEST_ASSERT_NOT_NULL( attribute.pAttributeValue );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetNextAttribute incase of malformed dont fragment attribute.
+ * @brief Validate deserializing a message from a buffer which is not aligned
+ * to the size of the attribute values.
  */
-void test_StunDeserializer_GetNextAttribute_MalformedDontFragment( void )
+void test_StunDeserializer_UnalignedBuffer_Pass( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
     StunHeader_t header = { 0 };
     StunAttribute_t attribute = { 0 };
+    uint32_t priority;
+    uint64_t tieBreaker;
+    uint8_t buffer[ 64 ];
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 8 (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x08,
+        /* Message Type = STUN Binding Request, Message Length = 20 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x14,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute Type = Dont fragment (0x001A), Attribute Length = 4 (set invalid intentionally). */
-        0x00, 0x1A, 0x00, 0x04,
-        0x00, 0x1A, 0x00, 0x04,
+        /* Attribute type = PRIORITY (0x0024), Attribute Length = 4. */
+        0x00, 0x24, 0x00, 0x04,
+        /* Attribute Value = 0x7E7F00FF. */
+        0x7E, 0x7F, 0x00, 0xFF,
+        /* Attribute type = ICE-CONTROLLING (0x802A), Attribute Length = 8. */
+        0x80, 0x2A, 0x00, 0x08,
+        /* Attribute Value = 0x1234567890ABCDEF. */
+        0x12, 0x34, 0x56, 0x78, 0x90, 0xAB, 0xCD, 0xEF
     };
     size_t serializedMessageLength = sizeof( serializedMessage );
 
+    /* Place the message at an odd address. */
+    memcpy( &( buffer[ 1 ] ),
+            &( serializedMessage[ 0 ] ),
+            serializedMessageLength );
+
     result = StunDeserializer_Init( &( ctx ),
-                                    &( serializedMessage[ 0 ] ),
+                                    &( buffer[ 1 ] ),
                                     serializedMessageLength,
                                     &( header ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
+    TEST_ASSERT_EQUAL( STUN_MESSAGE_TYPE_BINDING_REQUEST,
+                       header.messageType );
+
+    result = StunDeserializer_GetNextAttribute( &( ctx ),
+                                                &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunDeserializer_ParseAttributePriority( &( ctx ),
+                                                      &( attribute ),
+                                                      &( priority ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( 0x7E7F00FF,
+                       priority );
 
     result = StunDeserializer_GetNextAttribute( &( ctx ),
                                                 &( attribute ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_DONT_FRAGMENT,
-                       attribute.attributeType );
+
+    result = StunDeserializer_ParseAttributeIceControlling( &( ctx ),
+                                                            &( attribute ),
+                                                            &( tieBreaker ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( 0x1234567890ABCDEF,
+                       tieBreaker );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetNextAttribute incase of malformed ice-controlled attribute.
+ * @brief Validate StunDeserializer_BuildIndex and
+ * StunDeserializer_FindAttributeInIndex in the happy path.
  */
-void test_StunDeserializer_GetNextAttribute_MalformedIceControlled( void )
+void test_StunDeserializer_BuildIndex_Pass( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
     StunHeader_t header = { 0 };
     StunAttribute_t attribute = { 0 };
+    StunAttributeIndex_t index;
+    uint32_t priority;
+    uint64_t tieBreaker;
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 16 (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x10,
+        /* Message Type = STUN Binding Request, Message Length = 48 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x30,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute type = ICE-CONTROLLED (0x8029), Attribute Length = 12 (set invalid intentionally). */
-        0x80, 0x29, 0x00, 0x0C,
-        /* Attribute Value= 0x0123456789ABCDEF (tie breaker value) and 4 invalid bytes. */
-        0x12, 0x34, 0x56, 0x78,
-        0x90, 0xAB, 0xCD, 0xEF,
-        0x12, 0x34, 0x56, 0x78,
+        /* Attribute type = USERNAME (0x0006), Attribute Length = 5. */
+        0x00, 0x06, 0x00, 0x05,
+        /* Username = "alice" + padding. */
+        0x61, 0x6C, 0x69, 0x63, 0x65, 0x00, 0x00, 0x00,
+        /* Attribute type = PRIORITY (0x0024), Attribute Length = 4. */
+        0x00, 0x24, 0x00, 0x04,
+        /* Attribute Value = 0x7E7F00FF. */
+        0x7E, 0x7F, 0x00, 0xFF,
+        /* Attribute type = USERNAME (0x0006), Attribute Length = 3. */
+        0x00, 0x06, 0x00, 0x03,
+        /* Username = "bob" + padding. */
+        0x62, 0x6F, 0x62, 0x00,
+        /* Attribute type = ICE-CONTROLLING (0x802A), Attribute Length = 8. */
+        0x80, 0x2A, 0x00, 0x08,
+        /* Attribute Value = 0x1234567890ABCDEF. */
+        0x12, 0x34, 0x56, 0x78, 0x90, 0xAB, 0xCD, 0xEF,
+        /* Attribute type = USE-CANDIDATE (0x0025), Attribute Length = 0. */
+        0x00, 0x25, 0x00, 0x00,
+        /* Attribute type = Unknown comprehension-optional (0xC001), Attribute Length = 0. */
+        0xC0, 0x01, 0x00, 0x00,
     };
     size_t serializedMessageLength = sizeof( serializedMessage );
 
@@ -2859,71 +4585,184 @@ void test_StunDeserializer_GetNextAttribute_MalformedIceControlled( void )
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
 
-    result = StunDeserializer_GetNextAttribute( &( ctx ),
-                                                &( attribute ) );
+    result = StunDeserializer_BuildIndex( &( ctx ),
+                                          &( index ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_ICE_CONTROLLED,
+
+    /* Only the first occurrence of an attribute is indexed. */
+    result = StunDeserializer_FindAttributeInIndex( &( ctx ),
+                                                    &( index ),
+                                                    STUN_ATTRIBUTE_TYPE_USERNAME,
+                                                    &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_USERNAME,
+                       attribute.attributeType );
+    TEST_ASSERT_EQUAL( 5,
+                       attribute.attributeValueLength );
+    TEST_ASSERT_EQUAL_PTR( &( serializedMessage[ 24 ] ),
+                           attribute.pAttributeValue );
+
+    result = StunDeserializer_FindAttributeInIndex( &( ctx ),
+                                                    &( index ),
+                                                    STUN_ATTRIBUTE_TYPE_PRIORITY,
+                                                    &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunDeserializer_ParseAttributePriority( &( ctx ),
+                                                      &( attribute ),
+                                                      &( priority ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( 0x7E7F00FF,
+                       priority );
+
+    result = StunDeserializer_FindAttributeInIndex( &( ctx ),
+                                                    &( index ),
+                                                    STUN_ATTRIBUTE_TYPE_ICE_CONTROLLING,
+                                                    &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunDeserializer_ParseAttributeIceControlling( &( ctx ),
+                                                            &( attribute ),
+                                                            &( tieBreaker ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( 0x1234567890ABCDEF,
+                       tieBreaker );
+
+    result = StunDeserializer_FindAttributeInIndex( &( ctx ),
+                                                    &( index ),
+                                                    STUN_ATTRIBUTE_TYPE_USE_CANDIDATE,
+                                                    &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( 0,
+                       attribute.attributeValueLength );
+    TEST_ASSERT_NULL( attribute.pAttributeValue );
+
+    /* Attribute type outside the indexed ranges. */
+    result = StunDeserializer_FindAttributeInIndex( &( ctx ),
+                                                    &( index ),
+                                                    ( StunAttributeType_t ) 0xC001,
+                                                    &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( 0xC001,
                        attribute.attributeType );
+
+    /* Attributes not present in the message. */
+    result = StunDeserializer_FindAttributeInIndex( &( ctx ),
+                                                    &( index ),
+                                                    STUN_ATTRIBUTE_TYPE_FINGERPRINT,
+                                                    &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_NO_ATTRIBUTE_FOUND,
+                       result );
+
+    result = StunDeserializer_FindAttributeInIndex( &( ctx ),
+                                                    &( index ),
+                                                    ( StunAttributeType_t ) 0xC002,
+                                                    &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_NO_ATTRIBUTE_FOUND,
+                       result );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetNextAttribute incase of malformed ice-controlling attribute.
+ * @brief Validate StunDeserializer_BuildIndex and
+ * StunDeserializer_FindAttributeInIndex incase of bad parameters.
  */
-void test_StunDeserializer_GetNextAttribute_MalformedIceControlling( void )
+void test_StunDeserializer_BuildIndex_BadParams( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
-    StunHeader_t header = { 0 };
     StunAttribute_t attribute = { 0 };
-    uint8_t serializedMessage[] =
-    {
-        /* Message Type = STUN Binding Request, Message Length = 16 (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x10,
-        /* Magic cookie. */
-        0x21, 0x12, 0xA4, 0x42,
-        /* Transaction ID. */
-        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute Type = ICE-CONTROLLING (0x802A), Attribute Length = 12 (set invalid intentionally). */
-        0x80, 0x2A, 0x00, 0x0C,
-        /* Attribute Value = 0x0123456789ABCDEF (tie breaker value) and 4 invalid bytes. */
-        0x01, 0x23, 0x45, 0x67,
-        0x89, 0xAB, 0xCD, 0xEF,
-        0x89, 0xAB, 0xCD, 0xEF,
-    };
-    size_t serializedMessageLength = sizeof( serializedMessage );
+    StunAttributeIndex_t index;
+    uint8_t stunMessage[ STUN_HEADER_LENGTH ] = { 0 };
+
+    result = StunDeserializer_BuildIndex( NULL,
+                                          &( index ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+
+    /* Context not initialized. */
+    result = StunDeserializer_BuildIndex( &( ctx ),
+                                          &( index ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+
+    ctx.pStart = &( stunMessage[ 0 ] );
+    ctx.totalLength = sizeof( stunMessage );
+
+    result = StunDeserializer_BuildIndex( &( ctx ),
+                                          NULL );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+
+    result = StunDeserializer_FindAttributeInIndex( NULL,
+                                                    &( index ),
+                                                    STUN_ATTRIBUTE_TYPE_PRIORITY,
+                                                    &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
 
-    result = StunDeserializer_Init( &( ctx ),
-                                    &( serializedMessage[ 0 ] ),
-                                    serializedMessageLength,
-                                    &( header ) );
+    result = StunDeserializer_FindAttributeInIndex( &( ctx ),
+                                                    NULL,
+                                                    STUN_ATTRIBUTE_TYPE_PRIORITY,
+                                                    &( attribute ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
                        result );
 
-    result = StunDeserializer_GetNextAttribute( &( ctx ),
-                                                &( attribute ) );
+    result = StunDeserializer_FindAttributeInIndex( &( ctx ),
+                                                    &( index ),
+                                                    STUN_ATTRIBUTE_TYPE_PRIORITY,
+                                                    NULL );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+
+    ctx.pStart = NULL;
+
+    result = StunDeserializer_FindAttributeInIndex( &( ctx ),
+                                                    &( index ),
+                                                    STUN_ATTRIBUTE_TYPE_PRIORITY,
+                                                    &( attribute ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_ICE_CONTROLLING,
-                       attribute.attributeType );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetNextAttribute incase of malformed use-candidate attribute.
+ * @brief Validate that StunDeserializer_BuildIndex fails for a malformed
+ * message.
  */
-void test_StunDeserializer_GetNextAttribute_MalformedUseCandidate( void )
+void test_StunDeserializer_BuildIndex_MalformedMessage( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
     StunHeader_t header = { 0 };
-    StunAttribute_t attribute = { 0 };
+    StunAttributeIndex_t index;
     uint8_t serializedMessage[] =
     {
         /* Message Type = STUN Binding Request, Message Length = 8 (excluding 20 bytes header). */
@@ -2932,622 +4771,996 @@ void test_StunDeserializer_GetNextAttribute_MalformedUseCandidate( void )
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute Type = USE-CANDIDATE (0x0025), Length = 4 (set invalid intentionally). */
-        0x00, 0x25, 0x00, 0x04,
-        0x00, 0x25, 0x00, 0x04,
+        /* Attribute type = PRIORITY (0x0024), Attribute Length = 4. */
+        0x00, 0x24, 0x00, 0x04,
+        /* Attribute Value. */
+        0x7E, 0x7F, 0x00, 0xFF,
     };
-    size_t serializedMessageLength = sizeof( serializedMessage );
 
     result = StunDeserializer_Init( &( ctx ),
                                     &( serializedMessage[ 0 ] ),
-                                    serializedMessageLength,
+                                    sizeof( serializedMessage ),
                                     &( header ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
 
-    result = StunDeserializer_GetNextAttribute( &( ctx ),
-                                                &( attribute ) );
+    /* Corrupt the priority length so that the attribute overflows the
+     * message. */
+    serializedMessage[ 23 ] = 0x08;
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
+    result = StunDeserializer_BuildIndex( &( ctx ),
+                                          &( index ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OUT_OF_MEMORY,
+                       result );
+
+    /* Corrupt the magic cookie. */
+    serializedMessage[ 4 ] = 0x00;
+
+    result = StunDeserializer_BuildIndex( &( ctx ),
+                                          &( index ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_MAGIC_COOKIE_MISMATCH,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_USE_CANDIDATE,
-                       attribute.attributeType );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetNextAttribute incase of malformed lifetime attribute.
+ * @brief Validate StunDeserializer_DecodeMessageView with the RFC 5769 sample
+ * request.
  */
-void test_StunDeserializer_GetNextAttribute_MalformedLifetime( void )
+void test_StunDeserializer_DecodeMessageView_Rfc5769SampleRequest( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
     StunHeader_t header = { 0 };
     StunAttribute_t attribute = { 0 };
+    StunMessageView_t view;
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 12 (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x0C,
+        /* Message Type = STUN Binding Request, Message Length = 0x58 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x58,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
-        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute Type = Lifetime (0x000D), Attribute Length = 8 (set invalid intentionally). */
-        0x00, 0x0D, 0x00, 0x08,
-        /* Attribute Value = 0x0000EA60 (60000 seconds in hex) and 4 invalid bytes. */
-        0x00, 0x00, 0xEA, 0x60,
-        0x6E, 0x7F, 0x1A, 0x2B,
+        0xB7, 0xE7, 0xA7, 0x01, 0xBC, 0x34, 0xD6, 0x86, 0xFA, 0x87, 0xDF, 0xAE,
+        /* Attribute Type = SOFTWARE (0x8022), Attribute Length = 16, Value = "STUN test client". */
+        0x80, 0x22, 0x00, 0x10,
+        0x53, 0x54, 0x55, 0x4E, 0x20, 0x74, 0x65, 0x73,
+        0x74, 0x20, 0x63, 0x6C, 0x69, 0x65, 0x6E, 0x74,
+        /* Attribute Type = PRIORITY (0x0024), Attribute Length = 4. */
+        0x00, 0x24, 0x00, 0x04,
+        0x6E, 0x00, 0x01, 0xFF,
+        /* Attribute Type = ICE-CONTROLLED (0x8029), Attribute Length = 8. */
+        0x80, 0x29, 0x00, 0x08,
+        0x93, 0x2F, 0xF9, 0xB1, 0x51, 0x26, 0x3B, 0x36,
+        /* Attribute Type = USERNAME (0x0006), Attribute Length = 9, Value = "evtj:h6vY" and padding. */
+        0x00, 0x06, 0x00, 0x09,
+        0x65, 0x76, 0x74, 0x6A, 0x3A, 0x68, 0x36, 0x76,
+        0x59, 0x20, 0x20, 0x20,
+        /* Attribute Type = MESSAGE-INTEGRITY (0x0008), Attribute Length = 20. */
+        0x00, 0x08, 0x00, 0x14,
+        0x9A, 0xEA, 0xA7, 0x0C, 0xBF, 0xD8, 0xCB, 0x56, 0x78, 0x1E,
+        0xF2, 0xB5, 0xB2, 0xD3, 0xF2, 0x49, 0xC1, 0xB5, 0x71, 0xA2,
+        /* Attribute Type = FINGERPRINT (0x8028), Attribute Length = 4. */
+        0x80, 0x28, 0x00, 0x04,
+        0xE5, 0x7A, 0x3B, 0xCF,
     };
-    size_t serializedMessageLength = sizeof( serializedMessage );
 
     result = StunDeserializer_Init( &( ctx ),
                                     &( serializedMessage[ 0 ] ),
-                                    serializedMessageLength,
+                                    sizeof( serializedMessage ),
                                     &( header ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
 
+    /* Read one attribute to check that the context is not used for the walk. */
     result = StunDeserializer_GetNextAttribute( &( ctx ),
                                                 &( attribute ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_LIFETIME,
-                       attribute.attributeType );
+
+    result = StunDeserializer_DecodeMessageView( &( ctx ),
+                                                 &( view ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( 40,
+                       ctx.currentIndex );
+    TEST_ASSERT_EQUAL( 2 * STUN_CACHE_LINE_SIZE,
+                       sizeof( StunMessageView_t ) );
+    TEST_ASSERT_EQUAL( 0,
+                       ( uintptr_t ) &( view ) % STUN_CACHE_LINE_SIZE );
+
+    TEST_ASSERT_EQUAL( 0x6E0001FF,
+                       view.priority );
+    TEST_ASSERT_EQUAL( 0x932FF9B151263B36,
+                       view.iceTieBreaker );
+    TEST_ASSERT_EQUAL_PTR( &( serializedMessage[ 64 ] ),
+                           view.username.pValue );
+    TEST_ASSERT_EQUAL( 9,
+                       view.username.valueLength );
+    TEST_ASSERT_EQUAL( 76,
+                       view.integrityOffset );
+    TEST_ASSERT_EQUAL( 100,
+                       view.fingerprintOffset );
+
+    TEST_ASSERT_EQUAL( 1,
+                       StunDeserializer_IsAttributeInView( &( view ),
+                                                           ( StunAttributeType_t ) 0x8022 ) ); /* SOFTWARE */
+    TEST_ASSERT_EQUAL( 1,
+                       StunDeserializer_IsAttributeInView( &( view ),
+                                                           STUN_ATTRIBUTE_TYPE_ICE_CONTROLLED ) );
+    TEST_ASSERT_EQUAL( 0,
+                       StunDeserializer_IsAttributeInView( &( view ),
+                                                           STUN_ATTRIBUTE_TYPE_ICE_CONTROLLING ) );
+    TEST_ASSERT_EQUAL( 0,
+                       StunDeserializer_IsAttributeInView( &( view ),
+                                                           STUN_ATTRIBUTE_TYPE_USE_CANDIDATE ) );
+    TEST_ASSERT_EQUAL( 0,
+                       StunDeserializer_IsAttributeInView( &( view ),
+                                                           ( StunAttributeType_t ) 0xC001 ) );
+    TEST_ASSERT_EQUAL( 0,
+                       StunDeserializer_IsAttributeInView( NULL,
+                                                           STUN_ATTRIBUTE_TYPE_PRIORITY ) );
+
+    /* Attributes not present in the message are 0. */
+    TEST_ASSERT_EQUAL( 0,
+                       view.lifetime );
+    TEST_ASSERT_NULL( view.realm.pValue );
+    TEST_ASSERT_EQUAL( 0,
+                       view.realm.valueLength );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetNextAttribute incase of malformed channel number attribute.
+ * @brief Validate StunDeserializer_DecodeMessageView with the TURN attributes.
  */
-void test_StunDeserializer_GetNextAttribute_MalformedChannelNumber( void )
+void test_StunDeserializer_DecodeMessageView_TurnAttributes( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
     StunHeader_t header = { 0 };
-    StunAttribute_t attribute = { 0 };
+    StunMessageView_t view;
+    uint8_t expectedAddress[] = { 0xC0, 0x00, 0x02, 0x01 };
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 12 (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x0C,
+        /* Message Type = STUN Binding Error Response, Message Length = 76 (excluding 20 bytes header). */
+        0x01, 0x11, 0x00, 0x4C,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
-        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute Type = Channel Number (0x000C), Attribute Length = 8 (set invalid intentionally). */
-        0x00, 0x0C, 0x00, 0x08,
-        /* Channel Number = 0x1234, Reserved = 0x0000 and, 4 invalid bytes. */
-        0x12, 0x34, 0x00, 0x00,
-        0x6E, 0x7F, 0x1A, 0x2B,
+        0xB7, 0xE7, 0xA7, 0x01, 0xBC, 0x34, 0xD6, 0x86, 0xFA, 0x87, 0xDF, 0xAE,
+        /* Attribute Type = XOR-MAPPED-ADDRESS (0x0020), Attribute Length = 8, 192.0.2.1:32853. */
+        0x00, 0x20, 0x00, 0x08,
+        0x00, 0x01, 0xA1, 0x47, 0xE1, 0x12, 0xA6, 0x43,
+        /* Attribute Type = ERROR-CODE (0x0009), Attribute Length = 4, 438 without reason phrase. */
+        0x00, 0x09, 0x00, 0x04,
+        0x00, 0x00, 0x04, 0x26,
+        /* Attribute Type = LIFETIME (0x000D), Attribute Length = 4, 600 seconds. */
+        0x00, 0x0D, 0x00, 0x04,
+        0x00, 0x00, 0x02, 0x58,
+        /* Attribute Type = CHANNEL-NUMBER (0x000C), Attribute Length = 4. */
+        0x00, 0x0C, 0x00, 0x04,
+        0x40, 0x01, 0x00, 0x00,
+        /* Attribute Type = REALM (0x0014), Attribute Length = 7, Value = "example" and padding. */
+        0x00, 0x14, 0x00, 0x07,
+        0x65, 0x78, 0x61, 0x6D, 0x70, 0x6C, 0x65, 0x00,
+        /* Attribute Type = NONCE (0x0015), Attribute Length = 4. */
+        0x00, 0x15, 0x00, 0x04,
+        0x6E, 0x6F, 0x6E, 0x63,
+        /* Attribute Type = LIFETIME (0x000D), Attribute Length = 4, only the first one is decoded. */
+        0x00, 0x0D, 0x00, 0x04,
+        0x00, 0x00, 0x00, 0x00,
+        /* Attribute Type = DATA (0x0013), Attribute Length = 2. */
+        0x00, 0x13, 0x00, 0x02,
+        0xAB, 0xCD, 0x00, 0x00,
+        /* Attribute Type = USE-CANDIDATE (0x0025), Attribute Length = 0. */
+        0x00, 0x25, 0x00, 0x00,
     };
-    size_t serializedMessageLength = sizeof( serializedMessage );
 
     result = StunDeserializer_Init( &( ctx ),
                                     &( serializedMessage[ 0 ] ),
-                                    serializedMessageLength,
+                                    sizeof( serializedMessage ),
                                     &( header ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
 
-    result = StunDeserializer_GetNextAttribute( &( ctx ),
-                                                &( attribute ) );
+    result = StunDeserializer_DecodeMessageView( &( ctx ),
+                                                 &( view ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_CHANNEL_NUMBER,
-                       attribute.attributeType );
+    TEST_ASSERT_EQUAL( STUN_ADDRESS_IPv4,
+                       view.xorMappedAddress.family );
+    TEST_ASSERT_EQUAL( 32853,
+                       view.xorMappedAddress.port );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedAddress[ 0 ] ),
+                                   &( view.xorMappedAddress.address[ 0 ] ),
+                                   sizeof( expectedAddress ) );
+    TEST_ASSERT_EQUAL( 438,
+                       view.errorCode );
+    TEST_ASSERT_EQUAL( 600,
+                       view.lifetime );
+    TEST_ASSERT_EQUAL( 0x4001,
+                       view.channelNumber );
+    TEST_ASSERT_EQUAL_PTR( &( serializedMessage[ 60 ] ),
+                           view.realm.pValue );
+    TEST_ASSERT_EQUAL( 7,
+                       view.realm.valueLength );
+    TEST_ASSERT_EQUAL_PTR( &( serializedMessage[ 72 ] ),
+                           view.nonce.pValue );
+    TEST_ASSERT_EQUAL( 4,
+                       view.nonce.valueLength );
+    TEST_ASSERT_EQUAL_PTR( &( serializedMessage[ 88 ] ),
+                           view.data.pValue );
+    TEST_ASSERT_EQUAL( 2,
+                       view.data.valueLength );
+    TEST_ASSERT_EQUAL( 1,
+                       StunDeserializer_IsAttributeInView( &( view ),
+                                                           STUN_ATTRIBUTE_TYPE_USE_CANDIDATE ) );
+    TEST_ASSERT_EQUAL( 0,
+                       StunDeserializer_IsAttributeInView( &( view ),
+                                                           STUN_ATTRIBUTE_TYPE_MESSAGE_INTEGRITY ) );
+    TEST_ASSERT_EQUAL( 0,
+                       view.integrityOffset );
+    TEST_ASSERT_EQUAL( 0,
+                       view.fingerprintOffset );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetNextAttribute incase of malformed change request attribute.
+ * @brief Validate that StunDeserializer_DecodeMessageView takes the tie-breaker
+ * from ICE-CONTROLLING when both roles are present.
  */
-void test_StunDeserializer_GetNextAttribute_MalformedChangeRequest( void )
+void test_StunDeserializer_DecodeMessageView_BothIceRoles( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
     StunHeader_t header = { 0 };
-    StunAttribute_t attribute = { 0 };
+    StunMessageView_t view;
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 12 (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x0C,
+        /* Message Type = STUN Binding Request, Message Length = 24 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x18,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute Type = CHANGE-REQUEST (0x0003), Attribute Length = 8 (set invalid intentionally). */
-        0x00, 0x03, 0x00, 0x08,
-        /* Attribute Value = 0x00000004 (Change IP flag) and, 4 invalid bytes. */
-        0x00, 0x00, 0x00, 0x04,
-        0x6E, 0x7F, 0x1A, 0x2B,
+        /* Attribute Type = ICE-CONTROLLED (0x8029), Attribute Length = 8. */
+        0x80, 0x29, 0x00, 0x08,
+        0x93, 0x2F, 0xF9, 0xB1, 0x51, 0x26, 0x3B, 0x36,
+        /* Attribute Type = ICE-CONTROLLING (0x802A), Attribute Length = 8. */
+        0x80, 0x2A, 0x00, 0x08,
+        0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
     };
-    size_t serializedMessageLength = sizeof( serializedMessage );
 
     result = StunDeserializer_Init( &( ctx ),
                                     &( serializedMessage[ 0 ] ),
-                                    serializedMessageLength,
+                                    sizeof( serializedMessage ),
                                     &( header ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
 
-    result = StunDeserializer_GetNextAttribute( &( ctx ),
-                                                &( attribute ) );
+    result = StunDeserializer_DecodeMessageView( &( ctx ),
+                                                 &( view ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_CHANGE_REQUEST,
-                       attribute.attributeType );
+    TEST_ASSERT_EQUAL( 1,
+                       StunDeserializer_IsAttributeInView( &( view ),
+                                                           STUN_ATTRIBUTE_TYPE_ICE_CONTROLLED ) );
+    TEST_ASSERT_EQUAL( 1,
+                       StunDeserializer_IsAttributeInView( &( view ),
+                                                           STUN_ATTRIBUTE_TYPE_ICE_CONTROLLING ) );
+    TEST_ASSERT_EQUAL_UINT64( 0x0102030405060708ULL,
+                              view.iceTieBreaker );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_ParseAttributeAddress (RESPONSE_ADDRESS Type) in happy path.
+ * @brief Validate StunDeserializer_DecodeMessageView with an attribute without
+ * a value.
  */
-void test_StunDeserializer_ParseAttributeAddress_ResponseAddress_HappyPath( void )
+void test_StunDeserializer_DecodeMessageView_EmptyValue( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
     StunHeader_t header = { 0 };
-    StunAttribute_t attribute = { 0 };
-    StunAttributeAddress_t parsedAddress = { 0 };
-    uint8_t expectedAddress[] = { 0x7F, 0x00, 0x00, 0x01 };
+    StunMessageView_t view;
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 0x0C (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x0C,
+        /* Message Type = STUN Binding Request, Message Length = 4 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x04,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute type = RESPONSE-ADDRESS (0x0002), Attribute Length = 8. */
-        0x00, 0x02, 0x00, 0x08,
-        /* Address family = IPv4, Port = 0x1234, IP Address = 0x7F000001 (127.0.0.1). */
-        0x00, 0x01, 0x12, 0x34, 0x7F, 0x00, 0x00, 0x01,
+        /* Attribute Type = USERNAME (0x0006), Attribute Length = 0. */
+        0x00, 0x06, 0x00, 0x00,
     };
-    size_t serializedMessageLength = sizeof( serializedMessage );
 
     result = StunDeserializer_Init( &( ctx ),
                                     &( serializedMessage[ 0 ] ),
-                                    serializedMessageLength,
+                                    sizeof( serializedMessage ),
                                     &( header ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
 
-    result = StunDeserializer_GetNextAttribute( &( ctx ),
-                                                &( attribute ) );
-
-    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
-                       result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_RESPONSE_ADDRESS,
-                       attribute.attributeType );
-
-    result = StunDeserializer_ParseAttributeAddress( &( ctx ),
-                                                     &( attribute ),
-                                                     &( parsedAddress ) );
+    result = StunDeserializer_DecodeMessageView( &( ctx ),
+                                                 &( view ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ADDRESS_IPv4,
-                       parsedAddress.family );
-    TEST_ASSERT_EQUAL( 0x1234,
-                       parsedAddress.port );
-    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedAddress[ 0 ] ),
-                                   &( parsedAddress.address[ 0 ] ),
-                                   4 );
+    TEST_ASSERT_EQUAL( 1,
+                       StunDeserializer_IsAttributeInView( &( view ),
+                                                           STUN_ATTRIBUTE_TYPE_USERNAME ) );
+    TEST_ASSERT_NULL( view.username.pValue );
+    TEST_ASSERT_EQUAL( 0,
+                       view.username.valueLength );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_ParseAttributeAddress (SOURCE_ADDRESS Type) in happy path.
+ * @brief Validate that StunDeserializer_DecodeMessageView decodes the first of
+ * two attributes of the same type.
  */
-void test_StunDeserializer_ParseAttributeAddress_SourceAddress_HappyPath( void )
+void test_StunDeserializer_DecodeMessageView_DuplicateAttribute( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
     StunHeader_t header = { 0 };
-    StunAttribute_t attribute = { 0 };
-    StunAttributeAddress_t parsedAddress = { 0 };
-    uint8_t expectedAddress[] = { 0xC0, 0xA8, 0x01, 0x01 };
+    StunMessageView_t view;
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 0x0C (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x0C,
+        /* Message Type = STUN Binding Request, Message Length = 16 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x10,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute type = SOURCE-ADDRESS (0x0004), Attribute Length = 8. */
-        0x00, 0x04, 0x00, 0x08,
-        /* Address family = IPv4, Port = 0x5678, IP Address = 0xC0A80101 (192.168.1.1). */
-        0x00, 0x01, 0x56, 0x78, 0xC0, 0xA8, 0x01, 0x01,
+        /* Attribute Type = PRIORITY (0x0024), Attribute Length = 4. */
+        0x00, 0x24, 0x00, 0x04,
+        0x6E, 0x00, 0x01, 0xFF,
+        /* Attribute Type = PRIORITY (0x0024), Attribute Length = 4. */
+        0x00, 0x24, 0x00, 0x04,
+        0x7E, 0x7F, 0x00, 0xFF,
     };
-    size_t serializedMessageLength = sizeof( serializedMessage );
 
     result = StunDeserializer_Init( &( ctx ),
                                     &( serializedMessage[ 0 ] ),
-                                    serializedMessageLength,
+                                    sizeof( serializedMessage ),
                                     &( header ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
 
-    result = StunDeserializer_GetNextAttribute( &( ctx ),
-                                                &( attribute ) );
-
-    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
-                       result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_SOURCE_ADDRESS,
-                       attribute.attributeType );
-
-    result = StunDeserializer_ParseAttributeAddress( &( ctx ),
-                                                     &( attribute ),
-                                                     &( parsedAddress ) );
+    result = StunDeserializer_DecodeMessageView( &( ctx ),
+                                                 &( view ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ADDRESS_IPv4,
-                       parsedAddress.family );
-    TEST_ASSERT_EQUAL( 0x5678,
-                       parsedAddress.port );
-    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedAddress[ 0 ] ),
-                                   &( parsedAddress.address[ 0 ] ),
-                                   4 );
+    TEST_ASSERT_EQUAL( 0x6E0001FF,
+                       view.priority );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_ParseAttributeAddress (CHANGED_ADDRESS Type) in happy path.
+ * @brief Validate that StunDeserializer_DecodeMessageView skips attributes
+ * outside the indexed type ranges.
  */
-void test_StunDeserializer_ParseAttributeAddress_ChangedAddress_HappyPath( void )
+void test_StunDeserializer_DecodeMessageView_UnindexedAttribute( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
     StunHeader_t header = { 0 };
-    StunAttribute_t attribute = { 0 };
-    StunAttributeAddress_t parsedAddress = { 0 };
-    uint8_t expectedAddress[] = { 0x08, 0x08, 0x08, 0x08 };
+    StunMessageView_t view;
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 0x0C (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x0C,
+        /* Message Type = STUN Binding Request, Message Length = 16 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x10,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute type = CHANGED-ADDRESS (0x0005), Attribute Length = 8. */
-        0x00, 0x05, 0x00, 0x08,
-        /* Address family = IPv4, Port = 0x0050, IP Address = 0x08080808 (8.8.8.8). */
-        0x00, 0x01, 0x00, 0x50, 0x08, 0x08, 0x08, 0x08,
+        /* Attribute Type = NETWORK-COST (0xC057), Attribute Length = 4. */
+        0xC0, 0x57, 0x00, 0x04,
+        0x00, 0x01, 0x00, 0x0A,
+        /* Attribute Type = PRIORITY (0x0024), Attribute Length = 4. */
+        0x00, 0x24, 0x00, 0x04,
+        0x6E, 0x00, 0x01, 0xFF,
     };
-    size_t serializedMessageLength = sizeof( serializedMessage );
 
     result = StunDeserializer_Init( &( ctx ),
                                     &( serializedMessage[ 0 ] ),
-                                    serializedMessageLength,
+                                    sizeof( serializedMessage ),
                                     &( header ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
 
-    result = StunDeserializer_GetNextAttribute( &( ctx ),
-                                                &( attribute ) );
-
-    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
-                       result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_CHANGED_ADDRESS,
-                       attribute.attributeType );
-
-    result = StunDeserializer_ParseAttributeAddress( &( ctx ),
-                                                     &( attribute ),
-                                                     &( parsedAddress ) );
+    result = StunDeserializer_DecodeMessageView( &( ctx ),
+                                                 &( view ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ADDRESS_IPv4,
-                       parsedAddress.family );
-    TEST_ASSERT_EQUAL( 0x0050,
-                       parsedAddress.port );
-    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedAddress[ 0 ] ),
-                                   &( parsedAddress.address[ 0 ] ),
-                                   4 );
+    TEST_ASSERT_EQUAL( 0,
+                       StunDeserializer_IsAttributeInView( &( view ),
+                                                           ( StunAttributeType_t ) 0xC057 ) );
+    TEST_ASSERT_EQUAL( 0x6E0001FF,
+                       view.priority );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_ParseAttributeAddress (REFLECTED_FROM Type) in happy path.
+ * @brief Validate StunDeserializer_DecodeMessageView incase of bad parameters
+ * and malformed messages.
  */
-void test_StunDeserializer_ParseAttributeAddress_ReflectedFrom_HappyPath( void )
+void test_StunDeserializer_DecodeMessageView_BadParams( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
     StunHeader_t header = { 0 };
-    StunAttribute_t attribute = { 0 };
-    StunAttributeAddress_t parsedAddress = { 0 };
-    uint8_t expectedAddress[] = { 0xAC, 0x10, 0x0A, 0x01 };
+    StunMessageView_t view;
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 0x0C (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x0C,
+        /* Message Type = STUN Binding Request, Message Length = 8 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x08,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute type = REFLECTED-FROM (0x000B), Attribute Length = 8. */
-        0x00, 0x0B, 0x00, 0x08,
-        /* Address family = IPv4, Port = 0x1A0A, IP Address = 0xAC100A01 (172.16.10.1). */
-        0x00, 0x01, 0x1A, 0x0A, 0xAC, 0x10, 0x0A, 0x01,
+        /* Attribute type = PRIORITY (0x0024), Attribute Length = 4. */
+        0x00, 0x24, 0x00, 0x04,
+        /* Attribute Value. */
+        0x7E, 0x7F, 0x00, 0xFF,
     };
-    size_t serializedMessageLength = sizeof( serializedMessage );
+
+    result = StunDeserializer_DecodeMessageView( NULL,
+                                                 &( view ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+
+    /* Context not initialized. */
+    result = StunDeserializer_DecodeMessageView( &( ctx ),
+                                                 &( view ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+
+    /* Message shorter than a header. */
+    ctx.pStart = &( serializedMessage[ 0 ] );
+    ctx.totalLength = STUN_HEADER_LENGTH - 1;
+
+    result = StunDeserializer_DecodeMessageView( &( ctx ),
+                                                 &( view ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
 
     result = StunDeserializer_Init( &( ctx ),
                                     &( serializedMessage[ 0 ] ),
-                                    serializedMessageLength,
+                                    sizeof( serializedMessage ),
                                     &( header ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
 
-    result = StunDeserializer_GetNextAttribute( &( ctx ),
-                                                &( attribute ) );
+    result = StunDeserializer_DecodeMessageView( &( ctx ),
+                                                 NULL );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_REFLECTED_FROM,
-                       attribute.attributeType );
 
-    result = StunDeserializer_ParseAttributeAddress( &( ctx ),
-                                                     &( attribute ),
-                                                     &( parsedAddress ) );
+    /* Corrupt the priority length so that the attribute overflows the
+     * message. */
+    serializedMessage[ 23 ] = 0x08;
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+    result = StunDeserializer_DecodeMessageView( &( ctx ),
+                                                 &( view ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OUT_OF_MEMORY,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ADDRESS_IPv4,
-                       parsedAddress.family );
-    TEST_ASSERT_EQUAL( 0x1A0A,
-                       parsedAddress.port );
-    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedAddress[ 0 ] ),
-                                   &( parsedAddress.address[ 0 ] ),
-                                   4 );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetNextAttribute with malformed RESPONSE_ADDRESS attribute.
+ * @brief Validate StunDeserializer_DecodeMessageView with an attribute that
+ * starts past 64 KiB.
  */
-void test_StunDeserializer_GetNextAttribute_MalformedResponseAddress( void )
+void test_StunDeserializer_DecodeMessageView_AttributePast64KiB( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
     StunHeader_t header = { 0 };
-    StunAttribute_t attribute = { 0 };
-    uint8_t serializedMessage[] =
+    StunMessageView_t view;
+    static uint8_t serializedMessage[ 65544 ];
+    uint8_t messageHeader[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 0x14 (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x14,
+        /* Message Type = STUN Binding Indication, Message Length = 65524 (excluding 20 bytes header). */
+        0x00, 0x11, 0xFF, 0xF4,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
-        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute type = RESPONSE-ADDRESS (0x0002), Attribute Length = 16 (set invalid intentionally). */
-        0x00, 0x02, 0x00, 0x10,
-        /* Address family = IPv4, Port = 0x1234, IP Address = 0x7F000001 (127.0.0.1)
-         * and additional 8 invalid bytes. */
-        0x00, 0x01, 0x12, 0x34, 0x7F, 0x00, 0x00, 0x01,
-        0x80, 0x28, 0x00, 0x04, 0x07, 0x8E, 0x38, 0x3F,
+        0xB7, 0xE7, 0xA7, 0x01, 0xBC, 0x34, 0xD6, 0x86, 0xFA, 0x87, 0xDF, 0xAE,
+        /* Attribute Type = DATA (0x0013), Attribute Length = 65512. */
+        0x00, 0x13, 0xFF, 0xE8,
+    };
+    uint8_t fingerprint[] =
+    {
+        /* Attribute Type = FINGERPRINT (0x8028), Attribute Length = 4. */
+        0x80, 0x28, 0x00, 0x04,
+        0x12, 0x34, 0x56, 0x78,
     };
-    size_t serializedMessageLength = sizeof( serializedMessage );
+
+    memset( &( serializedMessage[ 0 ] ),
+            0xAB,
+            sizeof( serializedMessage ) );
+    memcpy( &( serializedMessage[ 0 ] ),
+            &( messageHeader[ 0 ] ),
+            sizeof( messageHeader ) );
+    memcpy( &( serializedMessage[ 65536 ] ),
+            &( fingerprint[ 0 ] ),
+            sizeof( fingerprint ) );
 
     result = StunDeserializer_Init( &( ctx ),
                                     &( serializedMessage[ 0 ] ),
-                                    serializedMessageLength,
+                                    sizeof( serializedMessage ),
                                     &( header ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
 
-    result = StunDeserializer_GetNextAttribute( &( ctx ),
-                                                &( attribute ) );
+    result = StunDeserializer_DecodeMessageView( &( ctx ),
+                                                 &( view ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_RESPONSE_ADDRESS,
-                       attribute.attributeType );
+    TEST_ASSERT_EQUAL_PTR( &( serializedMessage[ 24 ] ),
+                           view.data.pValue );
+    TEST_ASSERT_EQUAL( 65512,
+                       view.data.valueLength );
+    TEST_ASSERT_EQUAL( 1,
+                       StunDeserializer_IsAttributeInView( &( view ),
+                                                           STUN_ATTRIBUTE_TYPE_FINGERPRINT ) );
+    TEST_ASSERT_EQUAL( 65536,
+                       view.fingerprintOffset );
+    TEST_ASSERT_EQUAL( 0,
+                       view.integrityOffset );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetNextAttribute with malformed SOURCE_ADDRESS attribute.
+ * @brief Validate StunDeserializer_InitBatch and StunDeserializer_InitFromBatch
+ * with a mix of valid and invalid messages.
  */
-void test_StunDeserializer_GetNextAttribute_MalformedSourceAddress( void )
+void test_StunDeserializer_InitBatch_Pass( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
     StunHeader_t header = { 0 };
     StunAttribute_t attribute = { 0 };
-    uint8_t serializedMessage[] =
+    StunMessageBuffer_t messages[ 4 ];
+    StunResult_t results[ 4 ];
+    StunMessageType_t messageTypes[ 4 ];
+    uint8_t * transactionIds[ 4 ];
+    uint8_t * attributes[ 4 ];
+    uint16_t attributesLengths[ 4 ];
+    StunMessageBatch_t batch = { 0 };
+    size_t validMessageCount = 0;
+    uint8_t validMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 0x14 (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x14,
+        /* Message Type = STUN Binding Success Response, Message Length = 8 (excluding 20 bytes header). */
+        0x01, 0x01, 0x00, 0x08,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+        /* Attribute type = PRIORITY (0x0024), Attribute Length = 4. */
+        0x00, 0x24, 0x00, 0x04,
+        /* Attribute Value = 0x7E7F00FF. */
+        0x7E, 0x7F, 0x00, 0xFF,
+    };
+    uint8_t wrongCookieMessage[] =
+    {
+        /* Message Type = STUN Binding Request, Message Length = 0. */
+        0x00, 0x01, 0x00, 0x00,
+        /* Intentionally wrong Magic cookie. */
+        0x21, 0x13, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+    };
+    uint8_t wrongLengthMessage[] =
+    {
+        /* Message Type = STUN Binding Request, Intentionally wrong Message Length = 4. */
+        0x00, 0x01, 0x00, 0x04,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute type = SOURCE-ADDRESS (0x0004), Attribute Length = 16 (set invalid intentionally). */
-        0x00, 0x04, 0x00, 0x10,
-        /* Address family = IPv4, Port = 0x5678, IP Address = 0xC0A80101 (192.168.1.1)
-         * and additional 8 invalid bytes. */
-        0x00, 0x01, 0x56, 0x78, 0xC0, 0xA8, 0x01, 0x01,
-        0x00, 0x04, 0x00, 0x10, 0xC0, 0xA8, 0x01, 0x01,
     };
-    size_t serializedMessageLength = sizeof( serializedMessage );
 
-    result = StunDeserializer_Init( &( ctx ),
-                                    &( serializedMessage[ 0 ] ),
-                                    serializedMessageLength,
-                                    &( header ) );
+    messages[ 0 ].pStunMessage = &( validMessage[ 0 ] );
+    messages[ 0 ].stunMessageLength = sizeof( validMessage );
+    messages[ 1 ].pStunMessage = &( wrongCookieMessage[ 0 ] );
+    messages[ 1 ].stunMessageLength = sizeof( wrongCookieMessage );
+    messages[ 2 ].pStunMessage = &( wrongLengthMessage[ 0 ] );
+    messages[ 2 ].stunMessageLength = sizeof( wrongLengthMessage );
+    /* Shorter than the STUN header. */
+    messages[ 3 ].pStunMessage = &( validMessage[ 0 ] );
+    messages[ 3 ].stunMessageLength = 10;
+
+    batch.pResults = &( results[ 0 ] );
+    batch.pMessageTypes = &( messageTypes[ 0 ] );
+    batch.ppTransactionIds = &( transactionIds[ 0 ] );
+    batch.ppAttributes = &( attributes[ 0 ] );
+    batch.pAttributesLengths = &( attributesLengths[ 0 ] );
+
+    result = StunDeserializer_InitBatch( &( messages[ 0 ] ),
+                                         4,
+                                         &( batch ),
+                                         &( validMessageCount ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( 1,
+                       validMessageCount );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       results[ 0 ] );
+    TEST_ASSERT_EQUAL( STUN_RESULT_MAGIC_COOKIE_MISMATCH,
+                       results[ 1 ] );
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_MESSAGE_LENGTH,
+                       results[ 2 ] );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       results[ 3 ] );
+    TEST_ASSERT_EQUAL( STUN_MESSAGE_TYPE_BINDING_SUCCESS_RESPONSE,
+                       messageTypes[ 0 ] );
+    TEST_ASSERT_EQUAL_PTR( &( validMessage[ 8 ] ),
+                           transactionIds[ 0 ] );
+    TEST_ASSERT_EQUAL_PTR( &( validMessage[ 20 ] ),
+                           attributes[ 0 ] );
+    TEST_ASSERT_EQUAL( 8,
+                       attributesLengths[ 0 ] );
+
+    result = StunDeserializer_InitFromBatch( &( ctx ),
+                                             &( batch ),
+                                             0,
+                                             &( header ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
+    TEST_ASSERT_EQUAL( STUN_MESSAGE_TYPE_BINDING_SUCCESS_RESPONSE,
+                       header.messageType );
+    TEST_ASSERT_EQUAL_PTR( &( validMessage[ 8 ] ),
+                           header.pTransactionId );
+    TEST_ASSERT_EQUAL_PTR( &( validMessage[ 0 ] ),
+                           ctx.pStart );
+    TEST_ASSERT_EQUAL( sizeof( validMessage ),
+                       ctx.totalLength );
 
     result = StunDeserializer_GetNextAttribute( &( ctx ),
                                                 &( attribute ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_SOURCE_ADDRESS,
+    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_PRIORITY,
                        attribute.attributeType );
+
+    result = StunDeserializer_InitFromBatch( &( ctx ),
+                                             &( batch ),
+                                             1,
+                                             &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_MAGIC_COOKIE_MISMATCH,
+                       result );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetNextAttribute with malformed CHANGED_ADDRESS attribute.
+ * @brief Validate StunDeserializer_InitBatch with a batch larger than the
+ * internal block size.
  */
-void test_StunDeserializer_GetNextAttribute_MalformedChangedAddress( void )
+void test_StunDeserializer_InitBatch_MultipleBlocks( void )
 {
-    StunContext_t ctx = { 0 };
     StunResult_t result;
-    StunHeader_t header = { 0 };
-    StunAttribute_t attribute = { 0 };
+    StunMessageBuffer_t messages[ 70 ];
+    StunResult_t results[ 70 ];
+    StunMessageType_t messageTypes[ 70 ];
+    uint8_t * transactionIds[ 70 ];
+    uint8_t * attributes[ 70 ];
+    uint16_t attributesLengths[ 70 ];
+    StunMessageBatch_t batch = { 0 };
+    size_t validMessageCount = 0, i;
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 0x14 (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x14,
+        /* Message Type = STUN Binding Request, Message Length = 0. */
+        0x00, 0x01, 0x00, 0x00,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute type = CHANGED-ADDRESS (0x0005), Attribute Length = 16 (set invalid intentionally). */
-        0x00, 0x05, 0x00, 0x10,
-        /* Address family = IPv4, Port = 0x0050, IP Address = 0x08080808 (8.8.8.8)
-         * and additional 8 invalid bytes. */
-        0x00, 0x01, 0x00, 0x50, 0x08, 0x08, 0x08, 0x08,
-        0x00, 0x05, 0x00, 0x10, 0x08, 0x08, 0x08, 0x08,
     };
-    size_t serializedMessageLength = sizeof( serializedMessage );
 
-    result = StunDeserializer_Init( &( ctx ),
-                                    &( serializedMessage[ 0 ] ),
-                                    serializedMessageLength,
-                                    &( header ) );
+    for( i = 0; i < 70; i++ )
+    {
+        messages[ i ].pStunMessage = &( serializedMessage[ 0 ] );
+        messages[ i ].stunMessageLength = sizeof( serializedMessage );
+    }
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
-                       result );
+    /* NULL message in the second block. */
+    messages[ 65 ].pStunMessage = NULL;
 
-    result = StunDeserializer_GetNextAttribute( &( ctx ),
-                                                &( attribute ) );
+    batch.pResults = &( results[ 0 ] );
+    batch.pMessageTypes = &( messageTypes[ 0 ] );
+    batch.ppTransactionIds = &( transactionIds[ 0 ] );
+    batch.ppAttributes = &( attributes[ 0 ] );
+    batch.pAttributesLengths = &( attributesLengths[ 0 ] );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
+    result = StunDeserializer_InitBatch( &( messages[ 0 ] ),
+                                         70,
+                                         &( batch ),
+                                         &( validMessageCount ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_CHANGED_ADDRESS,
-                       attribute.attributeType );
+    TEST_ASSERT_EQUAL( 69,
+                       validMessageCount );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       results[ 69 ] );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       results[ 65 ] );
+    TEST_ASSERT_NULL( transactionIds[ 65 ] );
+    TEST_ASSERT_NULL( attributes[ 65 ] );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetNextAttribute with malformed REFLECTED_FROM attribute.
+ * @brief Validate StunDeserializer_InitFromBatch with a message index past the
+ * end of the batch.
  */
-void test_StunDeserializer_GetNextAttribute_MalformedReflectedFrom( void )
+void test_StunDeserializer_InitFromBatch_IndexOutOfRange( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
     StunHeader_t header = { 0 };
-    StunAttribute_t attribute = { 0 };
+    StunMessageBuffer_t messages[ 2 ];
+    StunResult_t results[ 2 ];
+    StunMessageType_t messageTypes[ 2 ];
+    uint8_t * transactionIds[ 2 ];
+    uint8_t * attributes[ 2 ];
+    uint16_t attributesLengths[ 2 ];
+    StunMessageBatch_t batch = { 0 };
+    size_t validMessageCount = 0;
     uint8_t serializedMessage[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 0x14 (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x14,
+        /* Message Type = STUN Binding Request, Message Length = 0. */
+        0x00, 0x01, 0x00, 0x00,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
         0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute type = REFLECTED-FROM (0x000B), Attribute Length = 16 (set invalid intentionally). */
-        0x00, 0x0B, 0x00, 0x10,
-        /* Address family = IPv4, Port = 0x1A0A, IP Address = 0xAC100A01 (172.16.10.1)
-         * and additional 8 invalid bytes. */
-        0x00, 0x01, 0x1A, 0x0A, 0xAC, 0x10, 0x0A, 0x01,
-        0x00, 0x0B, 0x00, 0x10, 0xAC, 0x10, 0x0A, 0x01,
     };
-    size_t serializedMessageLength = sizeof( serializedMessage );
 
-    result = StunDeserializer_Init( &( ctx ),
-                                    &( serializedMessage[ 0 ] ),
-                                    serializedMessageLength,
-                                    &( header ) );
+    messages[ 0 ].pStunMessage = &( serializedMessage[ 0 ] );
+    messages[ 0 ].stunMessageLength = sizeof( serializedMessage );
+    messages[ 1 ] = messages[ 0 ];
+
+    batch.pResults = &( results[ 0 ] );
+    batch.pMessageTypes = &( messageTypes[ 0 ] );
+    batch.ppTransactionIds = &( transactionIds[ 0 ] );
+    batch.ppAttributes = &( attributes[ 0 ] );
+    batch.pAttributesLengths = &( attributesLengths[ 0 ] );
+
+    result = StunDeserializer_InitBatch( &( messages[ 0 ] ),
+                                         2,
+                                         &( batch ),
+                                         &( validMessageCount ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
+    TEST_ASSERT_EQUAL( 2,
+                       batch.messageCount );
 
-    result = StunDeserializer_GetNextAttribute( &( ctx ),
-                                                &( attribute ) );
+    result = StunDeserializer_InitFromBatch( &( ctx ),
+                                             &( batch ),
+                                             1,
+                                             &( header ) );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE,
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunDeserializer_InitFromBatch( &( ctx ),
+                                             &( batch ),
+                                             2,
+                                             &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+
+    /* A smaller batch reuses the arrays. */
+    result = StunDeserializer_InitBatch( &( messages[ 0 ] ),
+                                         1,
+                                         &( batch ),
+                                         &( validMessageCount ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunDeserializer_InitFromBatch( &( ctx ),
+                                             &( batch ),
+                                             1,
+                                             &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_REFLECTED_FROM,
-                       attribute.attributeType );
 }
 
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunDeserializer_GetNextAttribute with USERNAME attribute.
+ * @brief Validate StunDeserializer_InitBatch and StunDeserializer_InitFromBatch
+ * incase of bad parameters.
  */
-void test_StunDeserializer_GetNextAttribute_Username_HappyPath( void )
+void test_StunDeserializer_InitBatch_BadParams( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
     StunHeader_t header = { 0 };
-    StunAttribute_t attribute = { 0 };
-    uint8_t serializedMessage[] =
-    {
-        /* Message Type = STUN Binding Request, Message Length = 0x0C (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x0C,
-        /* Magic cookie. */
-        0x21, 0x12, 0xA4, 0x42,
-        /* Transaction ID. */
-        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute type = USERNAME (0x0006), Attribute Length = 8. */
-        0x00, 0x06, 0x00, 0x08,
-        /* Username = "testuser". */
-        0x74, 0x65, 0x73, 0x74,
-        0x75, 0x73, 0x65, 0x72,
-    };
-    size_t serializedMessageLength = sizeof( serializedMessage );
+    StunMessageBuffer_t message = { 0 };
+    StunResult_t results[ 1 ];
+    StunMessageType_t messageTypes[ 1 ];
+    uint8_t * transactionIds[ 1 ];
+    uint8_t * attributes[ 1 ];
+    uint16_t attributesLengths[ 1 ];
+    StunMessageBatch_t batch = { 0 };
+    size_t validMessageCount = 0;
+
+    batch.pResults = &( results[ 0 ] );
+    batch.pMessageTypes = &( messageTypes[ 0 ] );
+    batch.ppTransactionIds = &( transactionIds[ 0 ] );
+    batch.ppAttributes = &( attributes[ 0 ] );
+    batch.pAttributesLengths = &( attributesLengths[ 0 ] );
+
+    result = StunDeserializer_InitBatch( NULL,
+                                         1,
+                                         &( batch ),
+                                         &( validMessageCount ) );
 
-    result = StunDeserializer_Init( &( ctx ),
-                                    &( serializedMessage[ 0 ] ),
-                                    serializedMessageLength,
-                                    &( header ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+
+    result = StunDeserializer_InitBatch( &( message ),
+                                         1,
+                                         NULL,
+                                         &( validMessageCount ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+
+    result = StunDeserializer_InitBatch( &( message ),
+                                         1,
+                                         &( batch ),
+                                         NULL );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+
+    batch.pAttributesLengths = NULL;
+
+    result = StunDeserializer_InitBatch( &( message ),
+                                         1,
+                                         &( batch ),
+                                         &( validMessageCount ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+
+    batch.pAttributesLengths = &( attributesLengths[ 0 ] );
+    batch.ppAttributes = NULL;
+
+    result = StunDeserializer_InitBatch( &( message ),
+                                         1,
+                                         &( batch ),
+                                         &( validMessageCount ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+
+    batch.ppAttributes = &( attributes[ 0 ] );
+    batch.ppTransactionIds = NULL;
+
+    result = StunDeserializer_InitBatch( &( message ),
+                                         1,
+                                         &( batch ),
+                                         &( validMessageCount ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+
+    batch.ppTransactionIds = &( transactionIds[ 0 ] );
+    batch.pMessageTypes = NULL;
+
+    result = StunDeserializer_InitBatch( &( message ),
+                                         1,
+                                         &( batch ),
+                                         &( validMessageCount ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+
+    batch.pMessageTypes = &( messageTypes[ 0 ] );
+    batch.pResults = NULL;
+
+    result = StunDeserializer_InitBatch( &( message ),
+                                         1,
+                                         &( batch ),
+                                         &( validMessageCount ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+
+    /* An empty batch is valid. */
+    batch.pResults = &( results[ 0 ] );
+
+    result = StunDeserializer_InitBatch( NULL,
+                                         0,
+                                         &( batch ),
+                                         &( validMessageCount ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
+    TEST_ASSERT_EQUAL( 0,
+                       validMessageCount );
 
-    result = StunDeserializer_GetNextAttribute( &( ctx ),
-                                                &( attribute ) );
+    result = StunDeserializer_InitBatch( &( message ),
+                                         1,
+                                         &( batch ),
+                                         &( validMessageCount ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
-    TEST_ASSERT_EQUAL( STUN_ATTRIBUTE_TYPE_USERNAME,
-                       attribute.attributeType );
-    TEST_ASSERT_EQUAL( 8,
-                       attribute.attributeValueLength );
-    TEST_ASSERT_NOT_NULL( attribute.pAttributeValue );
+
+    result = StunDeserializer_InitFromBatch( NULL,
+                                             &( batch ),
+                                             0,
+                                             &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+
+    result = StunDeserializer_InitFromBatch( &( ctx ),
+                                             NULL,
+                                             0,
+                                             &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+
+    result = StunDeserializer_InitFromBatch( &( ctx ),
+                                             &( batch ),
+                                             0,
+                                             NULL );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
 }
 
 /*-----------------------------------------------------------*/
@@ -32,6 +32,10 @@ list(APPEND mock_define_list
 list(APPEND real_source_files
             ${MODULE_ROOT_DIR}/source/stun_deserializer.c
             ${MODULE_ROOT_DIR}/source/stun_endianness.c
+            ${MODULE_ROOT_DIR}/source/stun_crc32.c
+            ${MODULE_ROOT_DIR}/source/stun_sha1.c
+            ${MODULE_ROOT_DIR}/source/stun_integrity.c
+            ${MODULE_ROOT_DIR}/source/stun_md5.c
         )
 # List the directories the module under test includes.
 list(APPEND real_include_directories
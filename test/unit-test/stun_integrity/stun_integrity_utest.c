@@ -0,0 +1,1045 @@
+/* Unity includes. */
+#include "unity.h"
+#include "catch_assert.h"
+
+/* Standard includes. */
+#include <string.h>
+#include <stdint.h>
+
+/* API includes. */
+#include "stun_integrity.h"
+#include "stun_sha1.h"
+#include "stun_md5.h"
+
+/* ===========================  EXTERN VARIABLES  =========================== */
+
+/* Number of blocks processed by CountingCompress. */
+static size_t compressedBlockCount = 0;
+
+static void CountingCompress( uint32_t * pState,
+                              const uint8_t * pBlocks,
+                              size_t blockCount )
+{
+    compressedBlockCount += blockCount;
+    Stun_Sha1GetCompressFunction()( pState, pBlocks, blockCount );
+}
+
+/* RFC 2202 test case 2. */
+static const uint8_t rfc2202Key[] = "Jefe";
+static const uint8_t rfc2202Data[] = "what do ya want for nothing?";
+static const uint8_t rfc2202Hmac[] =
+{
+    0xEF, 0xFC, 0xDF, 0x6A, 0xE5, 0xEB, 0x2F, 0xA2, 0xD2, 0x74,
+    0x16, 0xD5, 0xF1, 0x84, 0xDF, 0x9C, 0x25, 0x9A, 0x7C, 0x79
+};
+
+/* RFC 2202 test case 6, used with a key of 80 bytes of 0xAA. */
+static const uint8_t rfc2202LongKeyData[] = "Test Using Larger Than Block-Size Key - Hash Key First";
+static const uint8_t rfc2202LongKeyHmac[] =
+{
+    0xAA, 0x4A, 0xE5, 0xE1, 0x52, 0x72, 0xD0, 0x0E, 0x95, 0x70,
+    0x56, 0x37, 0xCE, 0x8A, 0x3B, 0x55, 0xED, 0x40, 0x21, 0x12
+};
+
+/* Checks the digest of the message with the portable compression function
+ * and with the one selected for the CPU. */
+static void CheckSha1Digest( const uint8_t * pMessage,
+                             size_t messageLength,
+                             const uint8_t * pExpectedDigest )
+{
+    StunSha1Context_t sha1Ctx;
+    uint8_t digest[ STUN_SHA1_DIGEST_LENGTH ];
+
+    Stun_Sha1Init( &( sha1Ctx ) );
+    sha1Ctx.compressFn = Stun_Sha1CompressPortable;
+    Stun_Sha1Update( &( sha1Ctx ), pMessage, messageLength );
+    Stun_Sha1Final( &( sha1Ctx ), &( digest[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( pExpectedDigest,
+                                   &( digest[ 0 ] ),
+                                   STUN_SHA1_DIGEST_LENGTH );
+
+    Stun_Sha1Init( &( sha1Ctx ) );
+    TEST_ASSERT_EQUAL_PTR( Stun_Sha1GetCompressFunction(),
+                           sha1Ctx.compressFn );
+    Stun_Sha1Update( &( sha1Ctx ), pMessage, messageLength );
+    Stun_Sha1Final( &( sha1Ctx ), &( digest[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( pExpectedDigest,
+                                   &( digest[ 0 ] ),
+                                   STUN_SHA1_DIGEST_LENGTH );
+}
+
+/* Checks the MD5 digest of the message given in two updates, the first one of
+ * firstLength bytes. */
+static void CheckMd5Digest( const uint8_t * pMessage,
+                            size_t messageLength,
+                            size_t firstLength,
+                            const uint8_t * pExpectedDigest )
+{
+    StunMd5Context_t md5Ctx;
+    uint8_t digest[ STUN_MD5_DIGEST_LENGTH ];
+
+    Stun_Md5Init( &( md5Ctx ) );
+    Stun_Md5Update( &( md5Ctx ), pMessage, firstLength );
+    Stun_Md5Update( &( md5Ctx ), &( pMessage[ firstLength ] ), messageLength - firstLength );
+    Stun_Md5Final( &( md5Ctx ), &( digest[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( pExpectedDigest,
+                                   &( digest[ 0 ] ),
+                                   STUN_MD5_DIGEST_LENGTH );
+}
+
+void setUp( void )
+{
+    compressedBlockCount = 0;
+}
+
+void tearDown( void )
+{
+}
+
+/* ==============================  Test Cases ============================== */
+
+/**
+ * @brief Validate the SHA-1 test vectors with the portable compression
+ * function and with the one selected for the CPU.
+ */
+void test_Stun_Sha1_Abc( void )
+{
+    const uint8_t message[] = "abc";
+    const uint8_t expectedDigest[] =
+    {
+        0xA9, 0x99, 0x3E, 0x36, 0x47, 0x06, 0x81, 0x6A, 0xBA, 0x3E,
+        0x25, 0x71, 0x78, 0x50, 0xC2, 0x6C, 0x9C, 0xD0, 0xD8, 0x9D
+    };
+
+    CheckSha1Digest( &( message[ 0 ] ),
+                     sizeof( message ) - 1,
+                     &( expectedDigest[ 0 ] ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate the SHA-1 digest of an empty message.
+ */
+void test_Stun_Sha1_Empty( void )
+{
+    const uint8_t expectedDigest[] =
+    {
+        0xDA, 0x39, 0xA3, 0xEE, 0x5E, 0x6B, 0x4B, 0x0D, 0x32, 0x55,
+        0xBF, 0xEF, 0x95, 0x60, 0x18, 0x90, 0xAF, 0xD8, 0x07, 0x09
+    };
+
+    CheckSha1Digest( NULL,
+                     0,
+                     &( expectedDigest[ 0 ] ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate the SHA-1 digest of a 55 byte message, the longest one
+ * whose padding fits in one block.
+ */
+void test_Stun_Sha1_55Bytes( void )
+{
+    uint8_t message[ 55 ];
+    const uint8_t expectedDigest[] =
+    {
+        0xC1, 0xC8, 0xBB, 0xDC, 0x22, 0x79, 0x6E, 0x28, 0xC0, 0xE1,
+        0x51, 0x63, 0xD2, 0x08, 0x99, 0xB6, 0x56, 0x21, 0xD6, 0x5A
+    };
+
+    memset( &( message[ 0 ] ), 'a', sizeof( message ) );
+
+    CheckSha1Digest( &( message[ 0 ] ),
+                     sizeof( message ),
+                     &( expectedDigest[ 0 ] ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate the SHA-1 digest of the 56 byte FIPS 180 test vector, the
+ * shortest message whose padding needs a second block.
+ */
+void test_Stun_Sha1_56Bytes( void )
+{
+    const uint8_t message[] = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    const uint8_t expectedDigest[] =
+    {
+        0x84, 0x98, 0x3E, 0x44, 0x1C, 0x3B, 0xD2, 0x6E, 0xBA, 0xAE,
+        0x4A, 0xA1, 0xF9, 0x51, 0x29, 0xE5, 0xE5, 0x46, 0x70, 0xF1
+    };
+
+    CheckSha1Digest( &( message[ 0 ] ),
+                     sizeof( message ) - 1,
+                     &( expectedDigest[ 0 ] ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate the SHA-1 digest of a 63 byte message.
+ */
+void test_Stun_Sha1_63Bytes( void )
+{
+    uint8_t message[ 63 ];
+    const uint8_t expectedDigest[] =
+    {
+        0x03, 0xF0, 0x9F, 0x5B, 0x15, 0x8A, 0x7A, 0x8C, 0xDA, 0xD9,
+        0x20, 0xBD, 0xDC, 0x29, 0xB8, 0x1C, 0x18, 0xA5, 0x51, 0xF5
+    };
+
+    memset( &( message[ 0 ] ), 'a', sizeof( message ) );
+
+    CheckSha1Digest( &( message[ 0 ] ),
+                     sizeof( message ),
+                     &( expectedDigest[ 0 ] ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate the SHA-1 digest of a message of exactly one block.
+ */
+void test_Stun_Sha1_64Bytes( void )
+{
+    uint8_t message[ 64 ];
+    const uint8_t expectedDigest[] =
+    {
+        0x00, 0x98, 0xBA, 0x82, 0x4B, 0x5C, 0x16, 0x42, 0x7B, 0xD7,
+        0xA1, 0x12, 0x2A, 0x5A, 0x44, 0x2A, 0x25, 0xEC, 0x64, 0x4D
+    };
+
+    memset( &( message[ 0 ] ), 'a', sizeof( message ) );
+
+    CheckSha1Digest( &( message[ 0 ] ),
+                     sizeof( message ),
+                     &( expectedDigest[ 0 ] ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate the SHA-1 digest of a message one byte longer than a
+ * block.
+ */
+void test_Stun_Sha1_65Bytes( void )
+{
+    uint8_t message[ 65 ];
+    const uint8_t expectedDigest[] =
+    {
+        0x11, 0x65, 0x53, 0x26, 0xC7, 0x08, 0xD7, 0x03, 0x19, 0xBE,
+        0x26, 0x10, 0xE8, 0xA5, 0x7D, 0x9A, 0x5B, 0x95, 0x9D, 0x3B
+    };
+
+    memset( &( message[ 0 ] ), 'a', sizeof( message ) );
+
+    CheckSha1Digest( &( message[ 0 ] ),
+                     sizeof( message ),
+                     &( expectedDigest[ 0 ] ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate the SHA-1 digest of the 112 byte FIPS 180 test vector,
+ * which is compressed as several blocks in one call.
+ */
+void test_Stun_Sha1_MultiBlock( void )
+{
+    const uint8_t message[] = "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu";
+    const uint8_t expectedDigest[] =
+    {
+        0xA4, 0x9B, 0x24, 0x46, 0xA0, 0x2C, 0x64, 0x5B, 0xF4, 0x19,
+        0xF9, 0x95, 0xB6, 0x70, 0x91, 0x25, 0x3A, 0x04, 0xA2, 0x59
+    };
+
+    CheckSha1Digest( &( message[ 0 ] ),
+                     sizeof( message ) - 1,
+                     &( expectedDigest[ 0 ] ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate Stun_Sha1Update with input split into chunks that do not
+ * line up with the block boundaries, using the one million 'a' test vector.
+ */
+void test_Stun_Sha1_ChunkedUpdate( void )
+{
+    StunSha1Context_t sha1Ctx;
+    uint8_t digest[ STUN_SHA1_DIGEST_LENGTH ];
+    uint8_t chunk[ 1000 ];
+    size_t i;
+    const uint8_t expectedDigest[] =
+    {
+        0x34, 0xAA, 0x97, 0x3C, 0xD4, 0xC4, 0xDA, 0xA4, 0xF6, 0x1E,
+        0xEB, 0x2B, 0xDB, 0xAD, 0x27, 0x31, 0x65, 0x34, 0x01, 0x6F
+    };
+
+    memset( &( chunk[ 0 ] ), 'a', sizeof( chunk ) );
+
+    Stun_Sha1Init( &( sha1Ctx ) );
+
+    /* 1000 updates of 1 + 999 bytes. */
+    for( i = 0; i < 1000; i++ )
+    {
+        Stun_Sha1Update( &( sha1Ctx ), &( chunk[ 0 ] ), 1 );
+        Stun_Sha1Update( &( sha1Ctx ), &( chunk[ 0 ] ), sizeof( chunk ) - 1 );
+    }
+
+    Stun_Sha1Final( &( sha1Ctx ), &( digest[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedDigest[ 0 ] ),
+                                   &( digest[ 0 ] ),
+                                   STUN_SHA1_DIGEST_LENGTH );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that an empty Stun_Sha1Update keeps a partial block.
+ */
+void test_Stun_Sha1_EmptyUpdateAfterPartialBlock( void )
+{
+    StunSha1Context_t sha1Ctx;
+    uint8_t digest[ STUN_SHA1_DIGEST_LENGTH ];
+    const uint8_t message[] = "abc";
+    const uint8_t expectedDigest[] =
+    {
+        0xA9, 0x99, 0x3E, 0x36, 0x47, 0x06, 0x81, 0x6A, 0xBA, 0x3E,
+        0x25, 0x71, 0x78, 0x50, 0xC2, 0x6C, 0x9C, 0xD0, 0xD8, 0x9D
+    };
+
+    Stun_Sha1Init( &( sha1Ctx ) );
+    Stun_Sha1Update( &( sha1Ctx ), &( message[ 0 ] ), 1 );
+    Stun_Sha1Update( &( sha1Ctx ), &( message[ 1 ] ), 0 );
+    Stun_Sha1Update( &( sha1Ctx ), &( message[ 1 ] ), sizeof( message ) - 2 );
+    Stun_Sha1Final( &( sha1Ctx ), &( digest[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedDigest[ 0 ] ),
+                                   &( digest[ 0 ] ),
+                                   STUN_SHA1_DIGEST_LENGTH );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunIntegrity_ComputeHmac against RFC 2202 test case 2.
+ */
+void test_StunIntegrity_ComputeHmac_Rfc2202( void )
+{
+    StunResult_t result;
+    StunIntegrityKey_t integrityKey;
+    uint8_t hmac[ STUN_SHA1_DIGEST_LENGTH ];
+
+    result = StunIntegrity_InitKey( &( integrityKey ),
+                                    &( rfc2202Key[ 0 ] ),
+                                    sizeof( rfc2202Key ) - 1,
+                                    NULL );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunIntegrity_ComputeHmac( &( integrityKey ),
+                                        &( rfc2202Data[ 0 ] ),
+                                        sizeof( rfc2202Data ) - 1,
+                                        &( hmac[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( rfc2202Hmac[ 0 ] ),
+                                   &( hmac[ 0 ] ),
+                                   STUN_SHA1_DIGEST_LENGTH );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunIntegrity_ComputeHmac against RFC 2202 test case 6,
+ * with a key longer than the block length.
+ */
+void test_StunIntegrity_ComputeHmac_Rfc2202LongKey( void )
+{
+    StunResult_t result;
+    StunIntegrityKey_t integrityKey;
+    uint8_t hmac[ STUN_SHA1_DIGEST_LENGTH ];
+    uint8_t longKey[ 80 ];
+
+    memset( &( longKey[ 0 ] ), 0xAA, sizeof( longKey ) );
+
+    result = StunIntegrity_InitKey( &( integrityKey ),
+                                    &( longKey[ 0 ] ),
+                                    sizeof( longKey ),
+                                    NULL );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunIntegrity_ComputeHmac( &( integrityKey ),
+                                        &( rfc2202LongKeyData[ 0 ] ),
+                                        sizeof( rfc2202LongKeyData ) - 1,
+                                        &( hmac[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( rfc2202LongKeyHmac[ 0 ] ),
+                                   &( hmac[ 0 ] ),
+                                   STUN_SHA1_DIGEST_LENGTH );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that StunIntegrity_InitKey prepares the key with the
+ * application provided SHA-1 backend.
+ */
+void test_StunIntegrity_InitKey_CustomBackend( void )
+{
+    StunResult_t result;
+    StunIntegrityKey_t integrityKey;
+
+    result = StunIntegrity_InitKey( &( integrityKey ),
+                                    &( rfc2202Key[ 0 ] ),
+                                    sizeof( rfc2202Key ) - 1,
+                                    CountingCompress );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    /* Inner and outer padded key blocks. */
+    TEST_ASSERT_EQUAL( 2,
+                       compressedBlockCount );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that StunIntegrity_InitKey also hashes a key longer than
+ * the block length with the application provided SHA-1 backend.
+ */
+void test_StunIntegrity_InitKey_CustomBackendLongKey( void )
+{
+    StunResult_t result;
+    StunIntegrityKey_t integrityKey;
+    uint8_t hmac[ STUN_SHA1_DIGEST_LENGTH ];
+    uint8_t longKey[ 80 ];
+
+    memset( &( longKey[ 0 ] ), 0xAA, sizeof( longKey ) );
+
+    result = StunIntegrity_InitKey( &( integrityKey ),
+                                    &( longKey[ 0 ] ),
+                                    sizeof( longKey ),
+                                    CountingCompress );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    /* Two blocks for the hash of the key, then the inner and outer padded key
+     * blocks. */
+    TEST_ASSERT_EQUAL( 4,
+                       compressedBlockCount );
+
+    result = StunIntegrity_ComputeHmac( &( integrityKey ),
+                                        &( rfc2202LongKeyData[ 0 ] ),
+                                        sizeof( rfc2202LongKeyData ) - 1,
+                                        &( hmac[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( rfc2202LongKeyHmac[ 0 ] ),
+                                   &( hmac[ 0 ] ),
+                                   STUN_SHA1_DIGEST_LENGTH );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that a short message only costs two compressions with the
+ * application provided SHA-1 backend once the key is prepared.
+ */
+void test_StunIntegrity_ComputeHmac_CustomBackend( void )
+{
+    StunResult_t result;
+    StunIntegrityKey_t integrityKey;
+    uint8_t hmac[ STUN_SHA1_DIGEST_LENGTH ];
+
+    result = StunIntegrity_InitKey( &( integrityKey ),
+                                    &( rfc2202Key[ 0 ] ),
+                                    sizeof( rfc2202Key ) - 1,
+                                    CountingCompress );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    compressedBlockCount = 0;
+
+    result = StunIntegrity_ComputeHmac( &( integrityKey ),
+                                        &( rfc2202Data[ 0 ] ),
+                                        sizeof( rfc2202Data ) - 1,
+                                        &( hmac[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( 2,
+                       compressedBlockCount );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( rfc2202Hmac[ 0 ] ),
+                                   &( hmac[ 0 ] ),
+                                   STUN_SHA1_DIGEST_LENGTH );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunIntegrity_ComputeHmac with an empty key and an empty
+ * message.
+ */
+void test_StunIntegrity_ComputeHmac_Empty( void )
+{
+    StunResult_t result;
+    StunIntegrityKey_t integrityKey;
+    uint8_t hmac[ STUN_SHA1_DIGEST_LENGTH ];
+    const uint8_t expectedHmac[] =
+    {
+        0xFB, 0xDB, 0x1D, 0x1B, 0x18, 0xAA, 0x6C, 0x08, 0x32, 0x4B,
+        0x7D, 0x64, 0xB7, 0x1F, 0xB7, 0x63, 0x70, 0x69, 0x0E, 0x1D
+    };
+
+    result = StunIntegrity_InitKey( &( integrityKey ),
+                                    NULL,
+                                    0,
+                                    NULL );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunIntegrity_ComputeHmac( &( integrityKey ),
+                                        NULL,
+                                        0,
+                                        &( hmac[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedHmac[ 0 ] ),
+                                   &( hmac[ 0 ] ),
+                                   STUN_SHA1_DIGEST_LENGTH );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunIntegrity_InitKey with a NULL integrity key.
+ */
+void test_StunIntegrity_InitKey_NullIntegrityKey( void )
+{
+    StunResult_t result;
+
+    result = StunIntegrity_InitKey( NULL,
+                                    &( rfc2202Key[ 0 ] ),
+                                    sizeof( rfc2202Key ) - 1,
+                                    NULL );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunIntegrity_InitKey with a NULL key of non-zero length.
+ */
+void test_StunIntegrity_InitKey_NullKey( void )
+{
+    StunResult_t result;
+    StunIntegrityKey_t integrityKey;
+
+    result = StunIntegrity_InitKey( &( integrityKey ),
+                                    NULL,
+                                    sizeof( rfc2202Key ) - 1,
+                                    NULL );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunIntegrity_ComputeHmac with a NULL integrity key.
+ */
+void test_StunIntegrity_ComputeHmac_NullIntegrityKey( void )
+{
+    StunResult_t result;
+    uint8_t hmac[ STUN_SHA1_DIGEST_LENGTH ];
+
+    result = StunIntegrity_ComputeHmac( NULL,
+                                        &( rfc2202Data[ 0 ] ),
+                                        sizeof( rfc2202Data ) - 1,
+                                        &( hmac[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunIntegrity_ComputeHmac with NULL data of non-zero
+ * length.
+ */
+void test_StunIntegrity_ComputeHmac_NullData( void )
+{
+    StunResult_t result;
+    StunIntegrityKey_t integrityKey;
+    uint8_t hmac[ STUN_SHA1_DIGEST_LENGTH ];
+
+    result = StunIntegrity_InitKey( &( integrityKey ),
+                                    &( rfc2202Key[ 0 ] ),
+                                    sizeof( rfc2202Key ) - 1,
+                                    NULL );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunIntegrity_ComputeHmac( &( integrityKey ),
+                                        NULL,
+                                        sizeof( rfc2202Data ) - 1,
+                                        &( hmac[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunIntegrity_ComputeHmac with a NULL output buffer.
+ */
+void test_StunIntegrity_ComputeHmac_NullHmac( void )
+{
+    StunResult_t result;
+    StunIntegrityKey_t integrityKey;
+
+    result = StunIntegrity_InitKey( &( integrityKey ),
+                                    &( rfc2202Key[ 0 ] ),
+                                    sizeof( rfc2202Key ) - 1,
+                                    NULL );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunIntegrity_ComputeHmac( &( integrityKey ),
+                                        &( rfc2202Data[ 0 ] ),
+                                        sizeof( rfc2202Data ) - 1,
+                                        NULL );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunIntegrity_HmacUpdate over several parts against RFC
+ * 2202 test case 2.
+ */
+void test_StunIntegrity_HmacUpdate_Rfc2202( void )
+{
+    StunResult_t result;
+    StunIntegrityKey_t integrityKey;
+    StunHmacContext_t hmacCtx;
+    uint8_t hmac[ STUN_SHA1_DIGEST_LENGTH ];
+
+    result = StunIntegrity_InitKey( &( integrityKey ),
+                                    &( rfc2202Key[ 0 ] ),
+                                    sizeof( rfc2202Key ) - 1,
+                                    NULL );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunIntegrity_HmacInit( &( hmacCtx ),
+                                     &( integrityKey ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunIntegrity_HmacUpdate( &( hmacCtx ),
+                                       &( rfc2202Data[ 0 ] ),
+                                       5 );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunIntegrity_HmacUpdate( &( hmacCtx ),
+                                       NULL,
+                                       0 );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunIntegrity_HmacUpdate( &( hmacCtx ),
+                                       &( rfc2202Data[ 5 ] ),
+                                       sizeof( rfc2202Data ) - 6 );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunIntegrity_HmacFinal( &( hmacCtx ),
+                                      &( hmac[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( rfc2202Hmac[ 0 ] ),
+                                   &( hmac[ 0 ] ),
+                                   STUN_SHA1_DIGEST_LENGTH );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunIntegrity_HmacInit with a NULL context.
+ */
+void test_StunIntegrity_HmacInit_NullContext( void )
+{
+    StunResult_t result;
+    StunIntegrityKey_t integrityKey = { 0 };
+
+    result = StunIntegrity_HmacInit( NULL,
+                                     &( integrityKey ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunIntegrity_HmacInit with a NULL key.
+ */
+void test_StunIntegrity_HmacInit_NullIntegrityKey( void )
+{
+    StunResult_t result;
+    StunHmacContext_t hmacCtx;
+
+    result = StunIntegrity_HmacInit( &( hmacCtx ),
+                                     NULL );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunIntegrity_HmacUpdate with a NULL context.
+ */
+void test_StunIntegrity_HmacUpdate_NullContext( void )
+{
+    StunResult_t result;
+
+    result = StunIntegrity_HmacUpdate( NULL,
+                                       &( rfc2202Data[ 0 ] ),
+                                       sizeof( rfc2202Data ) - 1 );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunIntegrity_HmacUpdate with NULL data of non-zero length.
+ */
+void test_StunIntegrity_HmacUpdate_NullData( void )
+{
+    StunResult_t result;
+    StunIntegrityKey_t integrityKey;
+    StunHmacContext_t hmacCtx;
+
+    ( void ) StunIntegrity_InitKey( &( integrityKey ),
+                                    &( rfc2202Key[ 0 ] ),
+                                    sizeof( rfc2202Key ) - 1,
+                                    NULL );
+    ( void ) StunIntegrity_HmacInit( &( hmacCtx ),
+                                     &( integrityKey ) );
+
+    result = StunIntegrity_HmacUpdate( &( hmacCtx ),
+                                       NULL,
+                                       sizeof( rfc2202Data ) - 1 );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunIntegrity_HmacFinal with a NULL context.
+ */
+void test_StunIntegrity_HmacFinal_NullContext( void )
+{
+    StunResult_t result;
+    uint8_t hmac[ STUN_SHA1_DIGEST_LENGTH ];
+
+    result = StunIntegrity_HmacFinal( NULL,
+                                      &( hmac[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunIntegrity_HmacFinal with a NULL output buffer.
+ */
+void test_StunIntegrity_HmacFinal_NullHmac( void )
+{
+    StunResult_t result;
+    StunIntegrityKey_t integrityKey;
+    StunHmacContext_t hmacCtx;
+
+    ( void ) StunIntegrity_InitKey( &( integrityKey ),
+                                    &( rfc2202Key[ 0 ] ),
+                                    sizeof( rfc2202Key ) - 1,
+                                    NULL );
+    ( void ) StunIntegrity_HmacInit( &( hmacCtx ),
+                                     &( integrityKey ) );
+
+    result = StunIntegrity_HmacFinal( &( hmacCtx ),
+                                      NULL );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate the MD5 digest of the empty message from RFC 1321.
+ */
+void test_Stun_Md5_Empty( void )
+{
+    const uint8_t expectedDigest[] =
+    {
+        0xD4, 0x1D, 0x8C, 0xD9, 0x8F, 0x00, 0xB2, 0x04, 0xE9, 0x80, 0x09, 0x98, 0xEC, 0xF8, 0x42, 0x7E
+    };
+
+    CheckMd5Digest( &( expectedDigest[ 0 ] ), 0, 0, &( expectedDigest[ 0 ] ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate the MD5 digest of "abc" from RFC 1321.
+ */
+void test_Stun_Md5_Abc( void )
+{
+    const uint8_t message[] = "abc";
+    const uint8_t expectedDigest[] =
+    {
+        0x90, 0x01, 0x50, 0x98, 0x3C, 0xD2, 0x4F, 0xB0, 0xD6, 0x96, 0x3F, 0x7D, 0x28, 0xE1, 0x7F, 0x72
+    };
+
+    CheckMd5Digest( &( message[ 0 ] ), sizeof( message ) - 1, 0, &( expectedDigest[ 0 ] ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate the MD5 digest of the 62 bytes message from RFC 1321, for
+ * which the length does not fit in the last block.
+ */
+void test_Stun_Md5_62Bytes( void )
+{
+    const uint8_t message[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+    const uint8_t expectedDigest[] =
+    {
+        0xD1, 0x74, 0xAB, 0x98, 0xD2, 0x77, 0xD9, 0xF5, 0xA5, 0x61, 0x1C, 0x2C, 0x9F, 0x41, 0x9D, 0x9F
+    };
+
+    CheckMd5Digest( &( message[ 0 ] ), sizeof( message ) - 1, 0, &( expectedDigest[ 0 ] ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate the MD5 digest of the 80 bytes message from RFC 1321 given
+ * in one update, so that the first block is compressed from the input.
+ */
+void test_Stun_Md5_80Bytes( void )
+{
+    const uint8_t message[] = "12345678901234567890123456789012345678901234567890123456789012345678901234567890";
+    const uint8_t expectedDigest[] =
+    {
+        0x57, 0xED, 0xF4, 0xA2, 0x2B, 0xE3, 0xC9, 0x55, 0xAC, 0x49, 0xDA, 0x2E, 0x21, 0x07, 0xB6, 0x7A
+    };
+
+    CheckMd5Digest( &( message[ 0 ] ), sizeof( message ) - 1, 0, &( expectedDigest[ 0 ] ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate the MD5 digest of the 80 bytes message from RFC 1321 given
+ * in two updates, so that a block is completed from the buffered bytes.
+ */
+void test_Stun_Md5_80BytesSplitUpdate( void )
+{
+    const uint8_t message[] = "12345678901234567890123456789012345678901234567890123456789012345678901234567890";
+    const uint8_t expectedDigest[] =
+    {
+        0x57, 0xED, 0xF4, 0xA2, 0x2B, 0xE3, 0xC9, 0x55, 0xAC, 0x49, 0xDA, 0x2E, 0x21, 0x07, 0xB6, 0x7A
+    };
+
+    CheckMd5Digest( &( message[ 0 ] ), sizeof( message ) - 1, 10, &( expectedDigest[ 0 ] ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunIntegrity_DeriveLongTermKey with the credentials of the
+ * RFC 5769 sample request with long-term authentication.
+ */
+void test_StunIntegrity_DeriveLongTermKey_Rfc5769( void )
+{
+    StunResult_t result;
+    uint8_t longTermKey[ STUN_INTEGRITY_LONG_TERM_KEY_LENGTH ];
+    /* Username = U+30DE U+30C8 U+30EA U+30C3 U+30AF U+30B9 in UTF-8. */
+    const uint8_t username[] =
+    {
+        0xE3, 0x83, 0x9E, 0xE3, 0x83, 0x88, 0xE3, 0x83, 0xAA,
+        0xE3, 0x83, 0x83, 0xE3, 0x82, 0xAF, 0xE3, 0x82, 0xB9
+    };
+    const uint8_t realm[] = "example.org";
+    const uint8_t password[] = "TheMatrIX";
+    const uint8_t expectedLongTermKey[] =
+    {
+        0xE8, 0xCA, 0x7A, 0xD5, 0x9D, 0x5E, 0xB0, 0x51, 0x8E, 0x31, 0x29, 0x11, 0xD2, 0xDA, 0xB2, 0xA9
+    };
+
+    result = StunIntegrity_DeriveLongTermKey( &( username[ 0 ] ),
+                                              sizeof( username ),
+                                              &( realm[ 0 ] ),
+                                              sizeof( realm ) - 1,
+                                              &( password[ 0 ] ),
+                                              sizeof( password ) - 1,
+                                              &( longTermKey[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedLongTermKey[ 0 ] ),
+                                   &( longTermKey[ 0 ] ),
+                                   STUN_INTEGRITY_LONG_TERM_KEY_LENGTH );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunIntegrity_DeriveLongTermKey with empty credentials given
+ * as NULL, which derives MD5( "::" ).
+ */
+void test_StunIntegrity_DeriveLongTermKey_EmptyCredentials( void )
+{
+    StunResult_t result;
+    uint8_t longTermKey[ STUN_INTEGRITY_LONG_TERM_KEY_LENGTH ];
+    const uint8_t expectedLongTermKey[] =
+    {
+        0x45, 0x01, 0xC0, 0x91, 0xB0, 0x36, 0x6D, 0x76, 0xEA, 0x32, 0x18, 0xB6, 0xCF, 0xDD, 0x80, 0x97
+    };
+
+    result = StunIntegrity_DeriveLongTermKey( NULL, 0,
+                                              NULL, 0,
+                                              NULL, 0,
+                                              &( longTermKey[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedLongTermKey[ 0 ] ),
+                                   &( longTermKey[ 0 ] ),
+                                   STUN_INTEGRITY_LONG_TERM_KEY_LENGTH );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunIntegrity_DeriveLongTermKey with a NULL username of non-zero length.
+ */
+void test_StunIntegrity_DeriveLongTermKey_NullUsername( void )
+{
+    StunResult_t result;
+    uint8_t longTermKey[ STUN_INTEGRITY_LONG_TERM_KEY_LENGTH ];
+    const uint8_t credential[] = "user";
+
+    result = StunIntegrity_DeriveLongTermKey( NULL, 4,
+                                              &( credential[ 0 ] ), 4,
+                                              &( credential[ 0 ] ), 4,
+                                              &( longTermKey[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunIntegrity_DeriveLongTermKey with a NULL realm of non-zero length.
+ */
+void test_StunIntegrity_DeriveLongTermKey_NullRealm( void )
+{
+    StunResult_t result;
+    uint8_t longTermKey[ STUN_INTEGRITY_LONG_TERM_KEY_LENGTH ];
+    const uint8_t credential[] = "user";
+
+    result = StunIntegrity_DeriveLongTermKey( &( credential[ 0 ] ), 4,
+                                              NULL, 4,
+                                              &( credential[ 0 ] ), 4,
+                                              &( longTermKey[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunIntegrity_DeriveLongTermKey with a NULL password of non-zero length.
+ */
+void test_StunIntegrity_DeriveLongTermKey_NullPassword( void )
+{
+    StunResult_t result;
+    uint8_t longTermKey[ STUN_INTEGRITY_LONG_TERM_KEY_LENGTH ];
+    const uint8_t credential[] = "user";
+
+    result = StunIntegrity_DeriveLongTermKey( &( credential[ 0 ] ), 4,
+                                              &( credential[ 0 ] ), 4,
+                                              NULL, 4,
+                                              &( longTermKey[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunIntegrity_DeriveLongTermKey with a NULL output key.
+ */
+void test_StunIntegrity_DeriveLongTermKey_NullLongTermKey( void )
+{
+    StunResult_t result;
+    const uint8_t credential[] = "user";
+
+    result = StunIntegrity_DeriveLongTermKey( &( credential[ 0 ] ), 4,
+                                              &( credential[ 0 ] ), 4,
+                                              &( credential[ 0 ] ), 4,
+                                              NULL );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
@@ -0,0 +1,504 @@
+/* Unity includes. */
+#include "unity.h"
+#include "catch_assert.h"
+
+/* Standard includes. */
+#include <string.h>
+#include <stdint.h>
+
+/* API includes. */
+#include "stun_message_template.h"
+#include "stun_serializer.h"
+
+/* ===========================  EXTERN VARIABLES  =========================== */
+
+static const uint8_t username[] = "evtj:h6vY";
+static const uint8_t password[] = "VOkJxbRl1RmTxUk/WvJxBt";
+static const uint8_t templateTransactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] = { 0 };
+static const uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] =
+{
+    0xB7, 0xE7, 0xA7, 0x01, 0xBC, 0x34, 0xD6, 0x86, 0xFA, 0x87, 0xDF, 0xAE
+};
+
+static StunIntegrityKey_t integrityKey;
+
+void setUp( void )
+{
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunIntegrity_InitKey( &( integrityKey ),
+                                              &( password[ 0 ] ),
+                                              sizeof( password ) - 1,
+                                              NULL ) );
+}
+
+void tearDown( void )
+{
+}
+
+/* ===========================  Helper Functions  =========================== */
+
+/* Attributes of the messages built by SerializeBindingRequest. */
+#define MESSAGE_PRIORITY                    ( 1U << 0 )
+#define MESSAGE_USE_CANDIDATE               ( 1U << 1 )
+#define MESSAGE_INTEGRITY                   ( 1U << 2 )
+#define MESSAGE_FINGERPRINT                 ( 1U << 3 )
+#define MESSAGE_PRIORITY_FIRST              ( 1U << 4 )
+#define MESSAGE_DUPLICATE                   ( 1U << 5 )
+
+#define MESSAGE_ICE_CHECK                   ( MESSAGE_PRIORITY | MESSAGE_INTEGRITY | MESSAGE_FINGERPRINT )
+
+/* Serializes a connectivity check with the serializer, as the reference for
+ * the stamped messages. MESSAGE_PRIORITY_FIRST adds PRIORITY before
+ * USE-CANDIDATE and MESSAGE_DUPLICATE adds PRIORITY and USE-CANDIDATE twice,
+ * the second time with priority 1. */
+static size_t SerializeBindingRequest( const uint8_t * pTransactionId,
+                                       uint32_t priority,
+                                       uint32_t attributes,
+                                       uint8_t * pBuffer,
+                                       size_t bufferLength )
+{
+    StunContext_t ctx;
+    StunHeader_t header;
+    size_t messageLength = 0, i;
+    size_t count = ( ( attributes & MESSAGE_DUPLICATE ) != 0U ) ? 2 : 1;
+
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    header.pTransactionId = ( uint8_t * ) pTransactionId;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_Init( &( ctx ), pBuffer, bufferLength, &( header ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_AddAttributeUsername( &( ctx ), &( username[ 0 ] ), sizeof( username ) - 1 ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_AddAttributeIceControlling( &( ctx ), 0x932FF9B151263B36ULL ) );
+
+    for( i = 0; i < count; i++ )
+    {
+        if( ( attributes & ( MESSAGE_PRIORITY | MESSAGE_PRIORITY_FIRST ) ) == ( MESSAGE_PRIORITY | MESSAGE_PRIORITY_FIRST ) )
+        {
+            TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                               StunSerializer_AddAttributePriority( &( ctx ), ( i == 0 ) ? priority : 1U ) );
+        }
+
+        if( ( attributes & MESSAGE_USE_CANDIDATE ) != 0U )
+        {
+            TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                               StunSerializer_AddAttributeUseCandidate( &( ctx ) ) );
+        }
+
+        if( ( attributes & ( MESSAGE_PRIORITY | MESSAGE_PRIORITY_FIRST ) ) == MESSAGE_PRIORITY )
+        {
+            TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                               StunSerializer_AddAttributePriority( &( ctx ), ( i == 0 ) ? priority : 1U ) );
+        }
+    }
+
+    if( ( attributes & MESSAGE_INTEGRITY ) != 0U )
+    {
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunSerializer_AddComputedIntegrity( &( ctx ), &( integrityKey ) ) );
+    }
+
+    if( ( attributes & MESSAGE_FINGERPRINT ) != 0U )
+    {
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunSerializer_AddComputedFingerprint( &( ctx ) ) );
+    }
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_Finalize( &( ctx ), &( messageLength ) ) );
+
+    return messageLength;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Initializes pTemplate from a message serialized with the template
+ * transaction ID and priority 0. */
+static void InitTemplate( StunMessageTemplate_t * pTemplate,
+                          uint32_t attributes,
+                          uint8_t * pBuffer,
+                          size_t bufferLength )
+{
+    size_t templateLength;
+
+    templateLength = SerializeBindingRequest( &( templateTransactionId[ 0 ] ), 0, attributes,
+                                              pBuffer, bufferLength );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunMessageTemplate_Init( pTemplate, pBuffer, templateLength ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/* Checks that stamping pTemplate gives the same message as the serializer. */
+static void CheckStamp( const StunMessageTemplate_t * pTemplate,
+                        uint32_t priority,
+                        uint32_t attributes,
+                        const StunIntegrityKey_t * pIntegrityKey )
+{
+    uint8_t expected[ 128 ], stamped[ 128 ];
+    size_t expectedLength, stampedLength = 0;
+    StunMessageTemplateFields_t fields;
+
+    fields.pTransactionId = &( transactionId[ 0 ] );
+    fields.priority = priority;
+    fields.useCandidate = ( ( attributes & MESSAGE_USE_CANDIDATE ) != 0U ) ? 1U : 0U;
+
+    expectedLength = SerializeBindingRequest( &( transactionId[ 0 ] ), priority, attributes,
+                                              &( expected[ 0 ] ), sizeof( expected ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunMessageTemplate_Stamp( pTemplate, &( fields ), pIntegrityKey,
+                                                  &( stamped[ 0 ] ), sizeof( stamped ), &( stampedLength ) ) );
+    TEST_ASSERT_EQUAL( expectedLength, stampedLength );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expected[ 0 ] ), &( stamped[ 0 ] ), expectedLength );
+}
+
+/* ==============================  Test Cases ============================== */
+
+/**
+ * @brief Validate that Init records the offsets of the variable fields.
+ */
+void test_StunMessageTemplate_Init_Offsets( void )
+{
+    uint8_t templateMessage[ 128 ];
+    StunMessageTemplate_t messageTemplate;
+
+    InitTemplate( &( messageTemplate ), MESSAGE_ICE_CHECK | MESSAGE_USE_CANDIDATE,
+                  &( templateMessage[ 0 ] ), sizeof( templateMessage ) );
+
+    TEST_ASSERT_EQUAL_PTR( &( templateMessage[ 0 ] ), messageTemplate.pMessage );
+    TEST_ASSERT_EQUAL( 48, messageTemplate.useCandidateOffset );
+    TEST_ASSERT_EQUAL( 52, messageTemplate.priorityOffset );
+    TEST_ASSERT_EQUAL( 60, messageTemplate.integrityOffset );
+    TEST_ASSERT_EQUAL( 84, messageTemplate.fingerprintOffset );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that Init takes the message length from the header.
+ */
+void test_StunMessageTemplate_Init_MessageLength( void )
+{
+    uint8_t templateMessage[ 128 ];
+    StunMessageTemplate_t messageTemplate;
+
+    InitTemplate( &( messageTemplate ), MESSAGE_ICE_CHECK | MESSAGE_USE_CANDIDATE,
+                  &( templateMessage[ 0 ] ), sizeof( templateMessage ) );
+
+    TEST_ASSERT_EQUAL( STUN_HEADER_LENGTH + ( ( ( size_t ) templateMessage[ 2 ] << 8 ) | templateMessage[ 3 ] ),
+                       messageTemplate.messageLength );
+    TEST_ASSERT_EQUAL( 92, messageTemplate.messageLength );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that Init records the first PRIORITY and USE-CANDIDATE when
+ * they are repeated.
+ */
+void test_StunMessageTemplate_Init_DuplicateAttributes( void )
+{
+    uint8_t templateMessage[ 128 ];
+    StunMessageTemplate_t messageTemplate;
+
+    InitTemplate( &( messageTemplate ), MESSAGE_ICE_CHECK | MESSAGE_USE_CANDIDATE | MESSAGE_DUPLICATE,
+                  &( templateMessage[ 0 ] ), sizeof( templateMessage ) );
+
+    TEST_ASSERT_EQUAL( 48, messageTemplate.useCandidateOffset );
+    TEST_ASSERT_EQUAL( 52, messageTemplate.priorityOffset );
+    TEST_ASSERT_EQUAL( 72, messageTemplate.integrityOffset );
+    TEST_ASSERT_EQUAL( 96, messageTemplate.fingerprintOffset );
+
+    CheckStamp( &( messageTemplate ), 0x6E0001FF, MESSAGE_ICE_CHECK | MESSAGE_USE_CANDIDATE | MESSAGE_DUPLICATE, &( integrityKey ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate a nominating check stamped from a template with
+ * USE-CANDIDATE.
+ */
+void test_StunMessageTemplate_Stamp_UseCandidate( void )
+{
+    uint8_t templateMessage[ 128 ];
+    StunMessageTemplate_t messageTemplate;
+
+    InitTemplate( &( messageTemplate ), MESSAGE_ICE_CHECK | MESSAGE_USE_CANDIDATE,
+                  &( templateMessage[ 0 ] ), sizeof( templateMessage ) );
+
+    CheckStamp( &( messageTemplate ), 0x6E0001FF, MESSAGE_ICE_CHECK | MESSAGE_USE_CANDIDATE, &( integrityKey ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that USE-CANDIDATE is dropped for a regular check and that
+ * the attributes after it move.
+ */
+void test_StunMessageTemplate_Stamp_DropUseCandidate( void )
+{
+    uint8_t templateMessage[ 128 ];
+    StunMessageTemplate_t messageTemplate;
+
+    InitTemplate( &( messageTemplate ), MESSAGE_ICE_CHECK | MESSAGE_USE_CANDIDATE,
+                  &( templateMessage[ 0 ] ), sizeof( templateMessage ) );
+
+    CheckStamp( &( messageTemplate ), 0x7E7F00FF, MESSAGE_ICE_CHECK, &( integrityKey ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that a PRIORITY before USE-CANDIDATE does not move when
+ * USE-CANDIDATE is dropped.
+ */
+void test_StunMessageTemplate_Stamp_DropUseCandidateAfterPriority( void )
+{
+    uint8_t templateMessage[ 128 ];
+    StunMessageTemplate_t messageTemplate;
+
+    InitTemplate( &( messageTemplate ), MESSAGE_ICE_CHECK | MESSAGE_USE_CANDIDATE | MESSAGE_PRIORITY_FIRST,
+                  &( templateMessage[ 0 ] ), sizeof( templateMessage ) );
+    TEST_ASSERT_EQUAL( 48, messageTemplate.priorityOffset );
+    TEST_ASSERT_EQUAL( 56, messageTemplate.useCandidateOffset );
+
+    CheckStamp( &( messageTemplate ), 0x7E7F00FF, MESSAGE_ICE_CHECK | MESSAGE_PRIORITY_FIRST, &( integrityKey ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that stamping does not modify the template.
+ */
+void test_StunMessageTemplate_Stamp_TemplateUnchanged( void )
+{
+    uint8_t templateMessage[ 128 ], original[ 128 ];
+    StunMessageTemplate_t messageTemplate;
+
+    InitTemplate( &( messageTemplate ), MESSAGE_ICE_CHECK | MESSAGE_USE_CANDIDATE,
+                  &( templateMessage[ 0 ] ), sizeof( templateMessage ) );
+    memcpy( &( original[ 0 ] ), &( templateMessage[ 0 ] ), messageTemplate.messageLength );
+
+    CheckStamp( &( messageTemplate ), 0x7E7F00FF, MESSAGE_ICE_CHECK, &( integrityKey ) );
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( original[ 0 ] ),
+                                   &( templateMessage[ 0 ] ),
+                                   messageTemplate.messageLength );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate a template without PRIORITY.
+ */
+void test_StunMessageTemplate_Stamp_NoPriority( void )
+{
+    uint8_t templateMessage[ 128 ];
+    StunMessageTemplate_t messageTemplate;
+
+    InitTemplate( &( messageTemplate ), MESSAGE_INTEGRITY | MESSAGE_FINGERPRINT,
+                  &( templateMessage[ 0 ] ), sizeof( templateMessage ) );
+    TEST_ASSERT_EQUAL( STUN_MESSAGE_TEMPLATE_NO_FIELD, messageTemplate.priorityOffset );
+
+    /* The priority is ignored. */
+    CheckStamp( &( messageTemplate ), 0x6E0001FF, MESSAGE_INTEGRITY | MESSAGE_FINGERPRINT, &( integrityKey ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that a template without MESSAGE-INTEGRITY is stamped
+ * without a key.
+ */
+void test_StunMessageTemplate_Stamp_NoIntegrity( void )
+{
+    uint8_t templateMessage[ 128 ];
+    StunMessageTemplate_t messageTemplate;
+
+    InitTemplate( &( messageTemplate ), MESSAGE_PRIORITY | MESSAGE_FINGERPRINT,
+                  &( templateMessage[ 0 ] ), sizeof( templateMessage ) );
+    TEST_ASSERT_EQUAL( STUN_MESSAGE_TEMPLATE_NO_FIELD, messageTemplate.integrityOffset );
+
+    CheckStamp( &( messageTemplate ), 0x6E0001FF, MESSAGE_PRIORITY | MESSAGE_FINGERPRINT, NULL );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate a template without FINGERPRINT.
+ */
+void test_StunMessageTemplate_Stamp_NoFingerprint( void )
+{
+    uint8_t templateMessage[ 128 ];
+    StunMessageTemplate_t messageTemplate;
+
+    InitTemplate( &( messageTemplate ), MESSAGE_PRIORITY | MESSAGE_INTEGRITY,
+                  &( templateMessage[ 0 ] ), sizeof( templateMessage ) );
+    TEST_ASSERT_EQUAL( STUN_MESSAGE_TEMPLATE_NO_FIELD, messageTemplate.fingerprintOffset );
+
+    CheckStamp( &( messageTemplate ), 0x6E0001FF, MESSAGE_PRIORITY | MESSAGE_INTEGRITY, &( integrityKey ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate a template without any of the variable attributes.
+ */
+void test_StunMessageTemplate_Stamp_NoVariableAttributes( void )
+{
+    uint8_t templateMessage[ 128 ];
+    StunMessageTemplate_t messageTemplate;
+
+    InitTemplate( &( messageTemplate ), 0,
+                  &( templateMessage[ 0 ] ), sizeof( templateMessage ) );
+
+    CheckStamp( &( messageTemplate ), 0, 0, NULL );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that USE-CANDIDATE cannot be requested from a template
+ * without it.
+ */
+void test_StunMessageTemplate_Stamp_UseCandidateNotInTemplate( void )
+{
+    uint8_t templateMessage[ 128 ], stamped[ 128 ];
+    size_t stampedLength;
+    StunMessageTemplate_t messageTemplate;
+    StunMessageTemplateFields_t fields;
+
+    InitTemplate( &( messageTemplate ), MESSAGE_ICE_CHECK,
+                  &( templateMessage[ 0 ] ), sizeof( templateMessage ) );
+
+    fields.pTransactionId = &( transactionId[ 0 ] );
+    fields.priority = 0x6E0001FF;
+    fields.useCandidate = 1;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunMessageTemplate_Stamp( &( messageTemplate ), &( fields ), &( integrityKey ),
+                                                  &( stamped[ 0 ] ), sizeof( stamped ), &( stampedLength ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that stamping fails if the send buffer is too small.
+ */
+void test_StunMessageTemplate_Stamp_OutOfMemory( void )
+{
+    uint8_t templateMessage[ 128 ], stamped[ 128 ];
+    size_t stampedLength;
+    StunMessageTemplate_t messageTemplate;
+    StunMessageTemplateFields_t fields;
+
+    InitTemplate( &( messageTemplate ), MESSAGE_ICE_CHECK | MESSAGE_USE_CANDIDATE,
+                  &( templateMessage[ 0 ] ), sizeof( templateMessage ) );
+
+    fields.pTransactionId = &( transactionId[ 0 ] );
+    fields.priority = 0x6E0001FF;
+    fields.useCandidate = 0;
+
+    /* Without USE-CANDIDATE. */
+    TEST_ASSERT_EQUAL( STUN_RESULT_OUT_OF_MEMORY,
+                       StunMessageTemplate_Stamp( &( messageTemplate ), &( fields ), &( integrityKey ),
+                                                  &( stamped[ 0 ] ), messageTemplate.messageLength - STUN_ATTRIBUTE_HEADER_LENGTH - 1,
+                                                  &( stampedLength ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunMessageTemplate_Init with bad parameters.
+ */
+void test_StunMessageTemplate_Init_BadParams( void )
+{
+    uint8_t templateMessage[ 128 ];
+    StunMessageTemplate_t messageTemplate;
+    size_t templateLength;
+
+    templateLength = SerializeBindingRequest( &( templateTransactionId[ 0 ] ), 0, MESSAGE_ICE_CHECK,
+                                              &( templateMessage[ 0 ] ), sizeof( templateMessage ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunMessageTemplate_Init( NULL, &( templateMessage[ 0 ] ), templateLength ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunMessageTemplate_Init( &( messageTemplate ), NULL, templateLength ) );
+    /* Longer than a STUN message can be. */
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunMessageTemplate_Init( &( messageTemplate ), &( templateMessage[ 0 ] ), ( size_t ) UINT16_MAX + 1U ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that a malformed message leaves a template that cannot be
+ * stamped.
+ */
+void test_StunMessageTemplate_Init_MalformedMessage( void )
+{
+    uint8_t templateMessage[ 128 ], stamped[ 128 ];
+    size_t templateLength, stampedLength;
+    StunMessageTemplate_t messageTemplate;
+    StunMessageTemplateFields_t fields;
+
+    templateLength = SerializeBindingRequest( &( templateTransactionId[ 0 ] ), 0, MESSAGE_ICE_CHECK,
+                                              &( templateMessage[ 0 ] ), sizeof( templateMessage ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_MESSAGE_LENGTH,
+                       StunMessageTemplate_Init( &( messageTemplate ), &( templateMessage[ 0 ] ), templateLength - 4 ) );
+
+    fields.pTransactionId = &( transactionId[ 0 ] );
+    fields.priority = 0;
+    fields.useCandidate = 0;
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunMessageTemplate_Stamp( &( messageTemplate ), &( fields ), &( integrityKey ),
+                                                  &( stamped[ 0 ] ), sizeof( stamped ), &( stampedLength ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunMessageTemplate_Stamp with bad parameters.
+ */
+void test_StunMessageTemplate_Stamp_BadParams( void )
+{
+    uint8_t templateMessage[ 128 ], stamped[ 128 ];
+    size_t stampedLength;
+    StunMessageTemplate_t messageTemplate;
+    StunMessageTemplateFields_t fields;
+
+    InitTemplate( &( messageTemplate ), MESSAGE_ICE_CHECK | MESSAGE_USE_CANDIDATE,
+                  &( templateMessage[ 0 ] ), sizeof( templateMessage ) );
+
+    fields.pTransactionId = &( transactionId[ 0 ] );
+    fields.priority = 0;
+    fields.useCandidate = 0;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunMessageTemplate_Stamp( NULL, &( fields ), &( integrityKey ),
+                                                  &( stamped[ 0 ] ), sizeof( stamped ), &( stampedLength ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunMessageTemplate_Stamp( &( messageTemplate ), NULL, &( integrityKey ),
+                                                  &( stamped[ 0 ] ), sizeof( stamped ), &( stampedLength ) ) );
+    /* The template has MESSAGE-INTEGRITY. */
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunMessageTemplate_Stamp( &( messageTemplate ), &( fields ), NULL,
+                                                  &( stamped[ 0 ] ), sizeof( stamped ), &( stampedLength ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunMessageTemplate_Stamp( &( messageTemplate ), &( fields ), &( integrityKey ),
+                                                  NULL, sizeof( stamped ), &( stampedLength ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunMessageTemplate_Stamp( &( messageTemplate ), &( fields ), &( integrityKey ),
+                                                  &( stamped[ 0 ] ), sizeof( stamped ), NULL ) );
+
+    fields.pTransactionId = NULL;
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunMessageTemplate_Stamp( &( messageTemplate ), &( fields ), &( integrityKey ),
+                                                  &( stamped[ 0 ] ), sizeof( stamped ), &( stampedLength ) ) );
+}
+
+/*-----------------------------------------------------------*/
@@ -0,0 +1,383 @@
+/* Unity includes. */
+#include "unity.h"
+#include "catch_assert.h"
+
+/* Standard includes. */
+#include <string.h>
+#include <stdint.h>
+
+/* API includes. */
+#include "stun_response_batch.h"
+#include "stun_serializer.h"
+
+/* ===========================  EXTERN VARIABLES  =========================== */
+
+static const uint8_t password[] = "VOkJxbRl1RmTxUk/WvJxBt";
+static const uint8_t transactionIds[ 3 ][ STUN_HEADER_TRANSACTION_ID_LENGTH ] =
+{
+    { 0xB7, 0xE7, 0xA7, 0x01, 0xBC, 0x34, 0xD6, 0x86, 0xFA, 0x87, 0xDF, 0xAE },
+    { 0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5 },
+    { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C }
+};
+
+static StunIntegrityKey_t integrityKey;
+static StunAttributeAddress_t ipv4Address;
+static StunAttributeAddress_t ipv6Address;
+
+void setUp( void )
+{
+    const uint8_t ipv6[ STUN_IPV6_ADDRESS_SIZE ] =
+    {
+        0x20, 0x01, 0x0D, 0xB8, 0x12, 0x34, 0x56, 0x78, 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77
+    };
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunIntegrity_InitKey( &( integrityKey ),
+                                              &( password[ 0 ] ),
+                                              sizeof( password ) - 1,
+                                              NULL ) );
+
+    memset( &( ipv4Address ), 0, sizeof( ipv4Address ) );
+    ipv4Address.family = STUN_ADDRESS_IPv4;
+    ipv4Address.port = 32853;
+    ipv4Address.address[ 0 ] = 192;
+    ipv4Address.address[ 1 ] = 0;
+    ipv4Address.address[ 2 ] = 2;
+    ipv4Address.address[ 3 ] = 1;
+
+    memset( &( ipv6Address ), 0, sizeof( ipv6Address ) );
+    ipv6Address.family = STUN_ADDRESS_IPv6;
+    ipv6Address.port = 3478;
+    memcpy( &( ipv6Address.address[ 0 ] ), &( ipv6[ 0 ] ), sizeof( ipv6 ) );
+}
+
+void tearDown( void )
+{
+}
+
+/* ===========================  Helper Functions  =========================== */
+
+/* Serializes a response with the serializer, as the reference for the batch. */
+static size_t SerializeBindingSuccess( const StunResponseBatchEntry_t * pEntry,
+                                       uint8_t * pBuffer,
+                                       size_t bufferLength )
+{
+    StunContext_t ctx;
+    StunHeader_t header;
+    size_t messageLength = 0;
+
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_SUCCESS_RESPONSE;
+    header.pTransactionId = ( uint8_t * ) pEntry->pTransactionId;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_Init( &( ctx ), pBuffer, bufferLength, &( header ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_AddAttributeXorMappedAddress( &( ctx ), pEntry->pSourceAddress ) );
+
+    if( pEntry->pIntegrityKey != NULL )
+    {
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunSerializer_AddComputedIntegrity( &( ctx ), pEntry->pIntegrityKey ) );
+    }
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_AddComputedFingerprint( &( ctx ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_Finalize( &( ctx ), &( messageLength ) ) );
+
+    return messageLength;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Checks that a batch whose second entry is invalid stops after the first
+ * response. */
+static void CheckInvalidSecondEntry( const StunResponseBatchEntry_t * pEntries )
+{
+    uint8_t arena[ 256 ];
+    size_t responseLengths[ 3 ], responseCount = 0;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunResponseBatch_SerializeBindingSuccess( pEntries,
+                                                                  3,
+                                                                  &( arena[ 0 ] ),
+                                                                  sizeof( arena ),
+                                                                  &( responseLengths[ 0 ] ),
+                                                                  &( responseCount ) ) );
+    TEST_ASSERT_EQUAL( 1,
+                       responseCount );
+    TEST_ASSERT_EQUAL( STUN_SERIALIZER_ICE_CHECK_RESPONSE_LENGTH( STUN_ATTRIBUTE_ADDRESS_IPV4_VALUE_LENGTH ) -
+                       STUN_ATTRIBUTE_TOTAL_LENGTH( STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH ),
+                       responseLengths[ 0 ] );
+}
+
+/* ==============================  Test Cases ============================== */
+
+/**
+ * @brief Validate that the responses of a batch are written back-to-back and
+ * are the same as the responses serialized one by one.
+ */
+void test_StunResponseBatch_SerializeBindingSuccess_Pass( void )
+{
+    StunResponseBatchEntry_t entries[ 3 ] =
+    {
+        { &( transactionIds[ 0 ][ 0 ] ), &( ipv4Address ), &( integrityKey ) },
+        { &( transactionIds[ 1 ][ 0 ] ), &( ipv6Address ), NULL },
+        { &( transactionIds[ 2 ][ 0 ] ), &( ipv6Address ), &( integrityKey ) }
+    };
+    uint8_t arena[ 256 ], expected[ 128 ];
+    size_t responseLengths[ 3 ], responseCount = 0, expectedLength, offset = 0, i;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunResponseBatch_SerializeBindingSuccess( &( entries[ 0 ] ),
+                                                                  3,
+                                                                  &( arena[ 0 ] ),
+                                                                  sizeof( arena ),
+                                                                  &( responseLengths[ 0 ] ),
+                                                                  &( responseCount ) ) );
+    TEST_ASSERT_EQUAL( 3,
+                       responseCount );
+
+    for( i = 0; i < 3; i++ )
+    {
+        expectedLength = SerializeBindingSuccess( &( entries[ i ] ),
+                                                  &( expected[ 0 ] ),
+                                                  sizeof( expected ) );
+
+        TEST_ASSERT_EQUAL( expectedLength,
+                           responseLengths[ i ] );
+        TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expected[ 0 ] ),
+                                       &( arena[ offset ] ),
+                                       expectedLength );
+
+        offset += responseLengths[ i ];
+    }
+
+    TEST_ASSERT_EQUAL( STUN_SERIALIZER_ICE_CHECK_RESPONSE_LENGTH( STUN_ATTRIBUTE_ADDRESS_IPV4_VALUE_LENGTH ),
+                       responseLengths[ 0 ] );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that an empty batch is accepted without entries.
+ */
+void test_StunResponseBatch_SerializeBindingSuccess_EmptyBatch( void )
+{
+    uint8_t arena[ 16 ];
+    size_t responseLengths[ 1 ], responseCount = 1;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunResponseBatch_SerializeBindingSuccess( NULL,
+                                                                  0,
+                                                                  &( arena[ 0 ] ),
+                                                                  sizeof( arena ),
+                                                                  &( responseLengths[ 0 ] ),
+                                                                  &( responseCount ) ) );
+    TEST_ASSERT_EQUAL( 0,
+                       responseCount );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that the responses that fit are written when the arena is
+ * too small for the batch.
+ */
+void test_StunResponseBatch_SerializeBindingSuccess_OutOfMemory( void )
+{
+    StunResponseBatchEntry_t entries[ 3 ] =
+    {
+        { &( transactionIds[ 0 ][ 0 ] ), &( ipv4Address ), &( integrityKey ) },
+        { &( transactionIds[ 1 ][ 0 ] ), &( ipv4Address ), &( integrityKey ) },
+        { &( transactionIds[ 2 ][ 0 ] ), &( ipv4Address ), &( integrityKey ) }
+    };
+    uint8_t arena[ 256 ];
+    size_t responseLengths[ 3 ], responseCount = 0;
+    size_t responseLength = STUN_SERIALIZER_ICE_CHECK_RESPONSE_LENGTH( STUN_ATTRIBUTE_ADDRESS_IPV4_VALUE_LENGTH );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OUT_OF_MEMORY,
+                       StunResponseBatch_SerializeBindingSuccess( &( entries[ 0 ] ),
+                                                                  3,
+                                                                  &( arena[ 0 ] ),
+                                                                  ( 3 * responseLength ) - 1,
+                                                                  &( responseLengths[ 0 ] ),
+                                                                  &( responseCount ) ) );
+    TEST_ASSERT_EQUAL( 2,
+                       responseCount );
+    TEST_ASSERT_EQUAL( responseLength,
+                       responseLengths[ 0 ] );
+    TEST_ASSERT_EQUAL( responseLength,
+                       responseLengths[ 1 ] );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that nothing is written when the first response does not
+ * fit in the arena.
+ */
+void test_StunResponseBatch_SerializeBindingSuccess_OutOfMemoryFirstResponse( void )
+{
+    StunResponseBatchEntry_t entries[ 1 ] =
+    {
+        { &( transactionIds[ 0 ][ 0 ] ), &( ipv4Address ), &( integrityKey ) }
+    };
+    uint8_t arena[ 256 ];
+    size_t responseLengths[ 1 ], responseCount = 1;
+    size_t responseLength = STUN_SERIALIZER_ICE_CHECK_RESPONSE_LENGTH( STUN_ATTRIBUTE_ADDRESS_IPV4_VALUE_LENGTH );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OUT_OF_MEMORY,
+                       StunResponseBatch_SerializeBindingSuccess( &( entries[ 0 ] ),
+                                                                  1,
+                                                                  &( arena[ 0 ] ),
+                                                                  responseLength - 1,
+                                                                  &( responseLengths[ 0 ] ),
+                                                                  &( responseCount ) ) );
+    TEST_ASSERT_EQUAL( 0,
+                       responseCount );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that the batch stops at an entry with an invalid address
+ * family.
+ */
+void test_StunResponseBatch_SerializeBindingSuccess_InvalidAddressFamily( void )
+{
+    StunAttributeAddress_t invalidAddress = { 0 };
+    StunResponseBatchEntry_t entries[ 3 ] =
+    {
+        { &( transactionIds[ 0 ][ 0 ] ), &( ipv4Address ), NULL },
+        { &( transactionIds[ 1 ][ 0 ] ), &( invalidAddress ), NULL },
+        { &( transactionIds[ 2 ][ 0 ] ), &( ipv4Address ), NULL }
+    };
+
+    CheckInvalidSecondEntry( &( entries[ 0 ] ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that the batch stops at an entry without an address.
+ */
+void test_StunResponseBatch_SerializeBindingSuccess_NullAddress( void )
+{
+    StunResponseBatchEntry_t entries[ 3 ] =
+    {
+        { &( transactionIds[ 0 ][ 0 ] ), &( ipv4Address ), NULL },
+        { &( transactionIds[ 1 ][ 0 ] ), NULL, NULL },
+        { &( transactionIds[ 2 ][ 0 ] ), &( ipv4Address ), NULL }
+    };
+
+    CheckInvalidSecondEntry( &( entries[ 0 ] ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that the batch stops at an entry without a transaction ID.
+ */
+void test_StunResponseBatch_SerializeBindingSuccess_NullTransactionId( void )
+{
+    StunResponseBatchEntry_t entries[ 3 ] =
+    {
+        { &( transactionIds[ 0 ][ 0 ] ), &( ipv4Address ), NULL },
+        { NULL, &( ipv4Address ), NULL },
+        { &( transactionIds[ 2 ][ 0 ] ), &( ipv4Address ), NULL }
+    };
+
+    CheckInvalidSecondEntry( &( entries[ 0 ] ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunResponseBatch_SerializeBindingSuccess with NULL entries.
+ */
+void test_StunResponseBatch_SerializeBindingSuccess_NullEntries( void )
+{
+    uint8_t arena[ 256 ];
+    size_t responseLengths[ 1 ], responseCount = 0;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunResponseBatch_SerializeBindingSuccess( NULL,
+                                                                  1,
+                                                                  &( arena[ 0 ] ),
+                                                                  sizeof( arena ),
+                                                                  &( responseLengths[ 0 ] ),
+                                                                  &( responseCount ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunResponseBatch_SerializeBindingSuccess with a NULL arena.
+ */
+void test_StunResponseBatch_SerializeBindingSuccess_NullArena( void )
+{
+    StunResponseBatchEntry_t entries[ 1 ] =
+    {
+        { &( transactionIds[ 0 ][ 0 ] ), &( ipv4Address ), NULL }
+    };
+    size_t responseLengths[ 1 ], responseCount = 0;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunResponseBatch_SerializeBindingSuccess( &( entries[ 0 ] ),
+                                                                  1,
+                                                                  NULL,
+                                                                  256,
+                                                                  &( responseLengths[ 0 ] ),
+                                                                  &( responseCount ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunResponseBatch_SerializeBindingSuccess with NULL response
+ * lengths.
+ */
+void test_StunResponseBatch_SerializeBindingSuccess_NullResponseLengths( void )
+{
+    StunResponseBatchEntry_t entries[ 1 ] =
+    {
+        { &( transactionIds[ 0 ][ 0 ] ), &( ipv4Address ), NULL }
+    };
+    uint8_t arena[ 256 ];
+    size_t responseCount = 0;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunResponseBatch_SerializeBindingSuccess( &( entries[ 0 ] ),
+                                                                  1,
+                                                                  &( arena[ 0 ] ),
+                                                                  sizeof( arena ),
+                                                                  NULL,
+                                                                  &( responseCount ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunResponseBatch_SerializeBindingSuccess with a NULL
+ * response count.
+ */
+void test_StunResponseBatch_SerializeBindingSuccess_NullResponseCount( void )
+{
+    StunResponseBatchEntry_t entries[ 1 ] =
+    {
+        { &( transactionIds[ 0 ][ 0 ] ), &( ipv4Address ), NULL }
+    };
+    uint8_t arena[ 256 ];
+    size_t responseLengths[ 1 ];
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunResponseBatch_SerializeBindingSuccess( &( entries[ 0 ] ),
+                                                                  1,
+                                                                  &( arena[ 0 ] ),
+                                                                  sizeof( arena ),
+                                                                  &( responseLengths[ 0 ] ),
+                                                                  NULL ) );
+}
+
+/*-----------------------------------------------------------*/
@@ -8,6 +8,7 @@
 
 /* API includes. */
 #include "stun_serializer.h"
+#include "stun_crc32.h"
 #include "stun_endianness.h"
 #include "stun_data_types.h"
 
@@ -1315,6 +1316,320 @@ void test_StunSerializer_AddAttributeFingerprint_NullContext( void )
 
 /*-----------------------------------------------------------*/
 
+/**
+ * @brief Validate StunSerializer_AddComputedFingerprint computes the CRC-32 of
+ * the message.
+ */
+void test_StunSerializer_AddComputedFingerprint_Pass( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    size_t stunMessageLength;
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] =
+    {
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5
+    };
+    uint8_t expectedStunMessage[] =
+    {
+        /* Message Type = STUN Binding Request, Message Length = 16 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x10,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+        /* Attribute type = PRIORITY (0x0024), Attribute Length = 4. */
+        0x00, 0x24, 0x00, 0x04,
+        /* Attribute Value = 0x7E7F00FF. */
+        0x7E, 0x7F, 0x00, 0xFF,
+        /* Attribute type = FINGERPRINT (0x8028), Attribute Length = 4. */
+        0x80, 0x28, 0x00, 0x04,
+        /* Attribute Value: 0xD371A52F (CRC-32 0x8025F061 XOR-ed with STUN_ATTRIBUTE_FINGERPRINT_XOR_VALUE). */
+        0xD3, 0x71, 0xA5, 0x2F,
+    };
+    size_t expectedStunMessageLength = sizeof( expectedStunMessage );
+
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    result = StunSerializer_Init( &( ctx ),
+                                  pStunMessageBuffer,
+                                  STUN_MESSAGE_BUFFER_LENGTH,
+                                  &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunSerializer_AddAttributePriority( &( ctx ),
+                                                  0x7E7F00FF );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunSerializer_AddComputedFingerprint( &( ctx ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunSerializer_Finalize( &( ctx ),
+                                      &( stunMessageLength ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( expectedStunMessageLength,
+                       stunMessageLength );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedStunMessage[ 0 ] ),
+                                   pStunMessageBuffer,
+                                   expectedStunMessageLength );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunSerializer_AddComputedFingerprint when only the length of
+ * the message is calculated.
+ */
+void test_StunSerializer_AddComputedFingerprint_NullBuffer( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    size_t stunMessageLength;
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] =
+    {
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5
+    };
+
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    result = StunSerializer_Init( &( ctx ),
+                                  NULL,
+                                  0,
+                                  &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunSerializer_AddComputedFingerprint( &( ctx ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunSerializer_Finalize( &( ctx ),
+                                      &( stunMessageLength ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_HEADER_LENGTH + 8,
+                       stunMessageLength );
+}
+
+/*-----------------------------------------------------------*/
+
+static uint8_t largeStunMessage[ STUN_HEADER_LENGTH + STUN_MAX_MESSAGE_LENGTH ];
+
+static const uint8_t largeData[ STUN_ATTRIBUTE_DATA_VALUE_MAX_LENGTH ] = { 0x5A };
+
+/* Serializes a Binding Request with a copied DATA value of dataLength bytes
+ * and a computed FINGERPRINT, and checks the FINGERPRINT against the CRC-32 of
+ * the whole message before it. */
+static void CheckLargeMessageFingerprint( uint16_t dataLength )
+{
+    StunContext_t ctx = { 0 };
+    StunHeader_t header = { 0 };
+    size_t stunMessageLength = 0, fingerprintOffset;
+    uint32_t crc32Fingerprint;
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] =
+    {
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5
+    };
+
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_Init( &( ctx ),
+                                            &( largeStunMessage[ 0 ] ),
+                                            sizeof( largeStunMessage ),
+                                            &( header ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_AddAttributeData( &( ctx ),
+                                                        &( largeData[ 0 ] ),
+                                                        dataLength ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_AddComputedFingerprint( &( ctx ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_Finalize( &( ctx ),
+                                                &( stunMessageLength ) ) );
+
+    fingerprintOffset = STUN_HEADER_LENGTH + STUN_ATTRIBUTE_HEADER_LENGTH + ( size_t ) dataLength;
+
+    TEST_ASSERT_EQUAL( fingerprintOffset + STUN_ATTRIBUTE_HEADER_LENGTH + STUN_ATTRIBUTE_FINGERPRINT_VALUE_LENGTH,
+                       stunMessageLength );
+    TEST_ASSERT_EQUAL( stunMessageLength - STUN_HEADER_LENGTH,
+                       ( ( size_t ) largeStunMessage[ 2 ] << 8 ) | largeStunMessage[ 3 ] );
+
+    crc32Fingerprint = Stun_Crc32( 0,
+                                   &( largeStunMessage[ 0 ] ),
+                                   fingerprintOffset ) ^ STUN_ATTRIBUTE_FINGERPRINT_XOR_VALUE;
+
+    TEST_ASSERT_EQUAL_HEX32( crc32Fingerprint,
+                             ( ( uint32_t ) largeStunMessage[ fingerprintOffset + 4 ] << 24 ) |
+                             ( ( uint32_t ) largeStunMessage[ fingerprintOffset + 5 ] << 16 ) |
+                             ( ( uint32_t ) largeStunMessage[ fingerprintOffset + 6 ] << 8 ) |
+                             ( uint32_t ) largeStunMessage[ fingerprintOffset + 7 ] );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunSerializer_AddComputedFingerprint with a copied DATA
+ * value that puts FINGERPRINT just before and at 64 KiB into the message.
+ */
+void test_StunSerializer_AddComputedFingerprint_AttributeAt64KiB( void )
+{
+    /* FINGERPRINT at offset 65532. */
+    CheckLargeMessageFingerprint( 65508 );
+
+    /* FINGERPRINT at offset 65536. */
+    CheckLargeMessageFingerprint( 65512 );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that StunSerializer_AddComputedFingerprint rejects a message
+ * that would be longer than STUN_MAX_MESSAGE_LENGTH with FINGERPRINT.
+ */
+void test_StunSerializer_AddComputedFingerprint_MessageTooLong( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] =
+    {
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5
+    };
+
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    result = StunSerializer_Init( &( ctx ),
+                                  &( largeStunMessage[ 0 ] ),
+                                  sizeof( largeStunMessage ),
+                                  &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    /* 65532 bytes after the header, 65540 with FINGERPRINT. */
+    result = StunSerializer_AddAttributeData( &( ctx ),
+                                              &( largeData[ 0 ] ),
+                                              STUN_ATTRIBUTE_DATA_VALUE_MAX_LENGTH );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunSerializer_AddComputedFingerprint( &( ctx ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_MESSAGE_LENGTH,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that StunSerializer_GetFingerprintBuffer rejects a
+ * FINGERPRINT attribute past 64 KiB, as the covered length does not fit in
+ * its 16-bit output.
+ */
+void test_StunSerializer_GetFingerprintBuffer_AttributePast64KiB( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    uint8_t * pStunMessage = NULL;
+    uint16_t stunMessageLength = 0;
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] =
+    {
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5
+    };
+
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    /* FINGERPRINT at offset 65532. */
+    result = StunSerializer_Init( &( ctx ),
+                                  &( largeStunMessage[ 0 ] ),
+                                  sizeof( largeStunMessage ),
+                                  &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunSerializer_AddAttributeData( &( ctx ),
+                                              &( largeData[ 0 ] ),
+                                              65508 );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunSerializer_GetFingerprintBuffer( &( ctx ),
+                                                  &( pStunMessage ),
+                                                  &( stunMessageLength ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( &( largeStunMessage[ 0 ] ),
+                       pStunMessage );
+    TEST_ASSERT_EQUAL( 65532,
+                       stunMessageLength );
+
+    /* FINGERPRINT at offset 65536. */
+    pStunMessage = NULL;
+
+    result = StunSerializer_Init( &( ctx ),
+                                  &( largeStunMessage[ 0 ] ),
+                                  sizeof( largeStunMessage ),
+                                  &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunSerializer_AddAttributeData( &( ctx ),
+                                              &( largeData[ 0 ] ),
+                                              65512 );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunSerializer_GetFingerprintBuffer( &( ctx ),
+                                                  &( pStunMessage ),
+                                                  &( stunMessageLength ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_MESSAGE_LENGTH,
+                       result );
+    TEST_ASSERT_NULL( pStunMessage );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunSerializer_AddComputedFingerprint with a NULL context.
+ */
+void test_StunSerializer_AddComputedFingerprint_NullContext( void )
+{
+    StunResult_t result;
+
+    result = StunSerializer_AddComputedFingerprint( NULL );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
 /**
  * @brief Validate StunSerializer_AddAttributeFingerprint in case of out of memory.
  */
@@ -2520,58 +2835,487 @@ void test_StunSerializer_AddAttributeData_Pass( void )
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunSerializer_AddAttributeRealm in the happy path.
+ * @brief Validate StunSerializer_AddAttributeData with a full-MTU payload,
+ * which is larger than the maximum length of general attributes.
  */
-void test_StunSerializer_AddAttributeRealm_Pass( void )
+void test_StunSerializer_AddAttributeData_LargePayload( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
     StunHeader_t header = { 0 };
-    const uint8_t * pRealm = ( const uint8_t * ) "Realm Example";
-    uint16_t realmLength = strlen( ( const char * ) pRealm );
+    uint8_t attributeData[ 1200 ];
+    uint8_t stunMessage[ STUN_HEADER_LENGTH + STUN_ATTRIBUTE_HEADER_LENGTH + sizeof( attributeData ) ];
     size_t stunMessageLength;
-    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] =
-    {
-        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5
-    };
-    uint8_t expectedStunMessage[] =
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] = { 0 };
+    uint8_t expectedHeader[] =
     {
-        /* Message Type = STUN Binding Request, Message Length = 20 (excluding 20 bytes header). */
-        0x00, 0x01, 0x00, 0x14,
+        /* Message Type = Send Indication, Message Length = 1204. */
+        0x00, 0x16, 0x04, 0xB4,
         /* Magic cookie. */
         0x21, 0x12, 0xA4, 0x42,
         /* Transaction ID. */
-        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
-        /* Attribute Type = REALM (0x0014), Attribute Length = 13. */
-        0x00, 0x14, 0x00, 0x0D,
-        /* Attribute Value = "Realm Example". */
-        0x52, 0x65, 0x61, 0x6C,
-        0x6D, 0x20, 0x45, 0x78,
-        0x61, 0x6D, 0x70, 0x6C,
-        0x65, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        /* Attribute Type = DATA (0x0013), Attribute Length = 1200. */
+        0x00, 0x13, 0x04, 0xB0,
     };
-    size_t expectedStunMessageLength = sizeof( expectedStunMessage );
 
-    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    memset( &( attributeData[ 0 ] ),
+            0x5A,
+            sizeof( attributeData ) );
+
+    header.messageType = STUN_MESSAGE_TYPE_SEND_INDICATION;
     header.pTransactionId = &( transactionId[ 0 ] );
 
     result = StunSerializer_Init( &( ctx ),
-                                  pStunMessageBuffer,
-                                  STUN_MESSAGE_BUFFER_LENGTH,
+                                  &( stunMessage[ 0 ] ),
+                                  sizeof( stunMessage ),
                                   &( header ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
 
-    result = StunSerializer_AddAttributeRealm( &( ctx ),
-                                               pRealm,
-                                               realmLength );
+    /* Over the 16-bit message length. */
+    result = StunSerializer_AddAttributeData( &( ctx ),
+                                              &( attributeData[ 0 ] ),
+                                              STUN_ATTRIBUTE_DATA_VALUE_MAX_LENGTH + 1 );
 
-    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
                        result );
 
-    result = StunSerializer_Finalize( &( ctx ),
-                                      &( stunMessageLength ) );
+    /* The limit of general attributes still applies to the others. */
+    result = StunSerializer_AddAttributeNonce( &( ctx ),
+                                               &( attributeData[ 0 ] ),
+                                               STUN_ATTRIBUTE_VALUE_MAX_LENGTH + 1 );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+
+    result = StunSerializer_AddAttributeData( &( ctx ),
+                                              &( attributeData[ 0 ] ),
+                                              sizeof( attributeData ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunSerializer_Finalize( &( ctx ),
+                                      &( stunMessageLength ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( sizeof( stunMessage ),
+                       stunMessageLength );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedHeader[ 0 ] ),
+                                   &( stunMessage[ 0 ] ),
+                                   sizeof( expectedHeader ) );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( attributeData[ 0 ] ),
+                                   &( stunMessage[ sizeof( expectedHeader ) ] ),
+                                   sizeof( attributeData ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that a message with a referenced DATA value, gathered from
+ * the parts returned by StunSerializer_FinalizeIoVec, is the same as the one
+ * serialized with StunSerializer_AddAttributeData.
+ */
+void test_StunSerializer_AddAttributeDataReference_Pass( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    const uint8_t * pAttributeData = ( const uint8_t * ) "Attribute Data";
+    uint16_t attributeDataLength = strlen( ( const char * ) pAttributeData );
+    StunIoVec_t ioVecs[ STUN_SERIALIZER_IOVEC_MAX_COUNT ];
+    size_t ioVecCount = 0, i, gatheredLength = 0, stunMessageLength, expectedStunMessageLength;
+    uint8_t gathered[ 64 ], expectedStunMessage[ 64 ];
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] =
+    {
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5
+    };
+
+    header.messageType = STUN_MESSAGE_TYPE_SEND_INDICATION;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    /* Expected message serialized with a copy of the DATA value. */
+    ( void ) StunSerializer_Init( &( ctx ),
+                                  &( expectedStunMessage[ 0 ] ),
+                                  sizeof( expectedStunMessage ),
+                                  &( header ) );
+    ( void ) StunSerializer_AddAttributeData( &( ctx ),
+                                              pAttributeData,
+                                              attributeDataLength );
+    ( void ) StunSerializer_AddAttributeDontFragment( &( ctx ) );
+    ( void ) StunSerializer_AddComputedFingerprint( &( ctx ) );
+    ( void ) StunSerializer_Finalize( &( ctx ),
+                                      &( expectedStunMessageLength ) );
+
+    result = StunSerializer_Init( &( ctx ),
+                                  pStunMessageBuffer,
+                                  STUN_MESSAGE_BUFFER_LENGTH,
+                                  &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunSerializer_AddAttributeDataReference( &( ctx ),
+                                                       pAttributeData,
+                                                       attributeDataLength );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunSerializer_AddAttributeDontFragment( &( ctx ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunSerializer_AddComputedFingerprint( &( ctx ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunSerializer_FinalizeIoVec( &( ctx ),
+                                           &( ioVecs[ 0 ] ),
+                                           STUN_SERIALIZER_IOVEC_MAX_COUNT,
+                                           &( ioVecCount ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( 3,
+                       ioVecCount );
+
+    /* The DATA value is not copied. */
+    TEST_ASSERT_EQUAL_PTR( pStunMessageBuffer,
+                           ioVecs[ 0 ].pBase );
+    TEST_ASSERT_EQUAL( STUN_HEADER_LENGTH + STUN_ATTRIBUTE_HEADER_LENGTH,
+                       ioVecs[ 0 ].length );
+    TEST_ASSERT_EQUAL_PTR( pAttributeData,
+                           ioVecs[ 1 ].pBase );
+    TEST_ASSERT_EQUAL( attributeDataLength,
+                       ioVecs[ 1 ].length );
+
+    for( i = 0; i < ioVecCount; i++ )
+    {
+        memcpy( &( gathered[ gatheredLength ] ),
+                ioVecs[ i ].pBase,
+                ioVecs[ i ].length );
+        gatheredLength += ioVecs[ i ].length;
+    }
+
+    TEST_ASSERT_EQUAL( expectedStunMessageLength,
+                       gatheredLength );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedStunMessage[ 0 ] ),
+                                   &( gathered[ 0 ] ),
+                                   expectedStunMessageLength );
+
+    /* Finalize returns the length of the whole message. */
+    result = StunSerializer_Finalize( &( ctx ),
+                                      &( stunMessageLength ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( expectedStunMessageLength,
+                       stunMessageLength );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunSerializer_FinalizeIoVec when nothing follows an
+ * unpadded referenced DATA value, and when only the message length is
+ * calculated.
+ */
+void test_StunSerializer_AddAttributeDataReference_NoPadding( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    const uint8_t * pAttributeData = ( const uint8_t * ) "16 bytes of data";
+    StunIoVec_t ioVecs[ STUN_SERIALIZER_IOVEC_MAX_COUNT ];
+    size_t ioVecCount = 0, stunMessageLength = 0;
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] = { 0 };
+    uint8_t expectedHeader[] =
+    {
+        /* Message Type = Send Indication, Message Length = 20. */
+        0x00, 0x16, 0x00, 0x14,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        /* Attribute Type = DATA (0x0013), Attribute Length = 16. */
+        0x00, 0x13, 0x00, 0x10,
+    };
+
+    header.messageType = STUN_MESSAGE_TYPE_SEND_INDICATION;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    /* Length only. */
+    ( void ) StunSerializer_Init( &( ctx ),
+                                  NULL,
+                                  0,
+                                  &( header ) );
+    result = StunSerializer_AddAttributeDataReference( &( ctx ),
+                                                       pAttributeData,
+                                                       16 );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunSerializer_Finalize( &( ctx ),
+                                      &( stunMessageLength ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( sizeof( expectedHeader ) + 16,
+                       stunMessageLength );
+
+    /* There is no buffer to return. */
+    result = StunSerializer_FinalizeIoVec( &( ctx ),
+                                           &( ioVecs[ 0 ] ),
+                                           STUN_SERIALIZER_IOVEC_MAX_COUNT,
+                                           &( ioVecCount ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+
+    ( void ) StunSerializer_Init( &( ctx ),
+                                  pStunMessageBuffer,
+                                  STUN_MESSAGE_BUFFER_LENGTH,
+                                  &( header ) );
+    ( void ) StunSerializer_AddAttributeDataReference( &( ctx ),
+                                                       pAttributeData,
+                                                       16 );
+
+    result = StunSerializer_FinalizeIoVec( &( ctx ),
+                                           &( ioVecs[ 0 ] ),
+                                           2,
+                                           &( ioVecCount ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( 2,
+                       ioVecCount );
+    TEST_ASSERT_EQUAL( sizeof( expectedHeader ),
+                       ioVecs[ 0 ].length );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedHeader[ 0 ] ),
+                                   ioVecs[ 0 ].pBase,
+                                   sizeof( expectedHeader ) );
+    TEST_ASSERT_EQUAL_PTR( pAttributeData,
+                           ioVecs[ 1 ].pBase );
+    TEST_ASSERT_EQUAL( 16,
+                       ioVecs[ 1 ].length );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunSerializer_AddAttributeDataReference and
+ * StunSerializer_FinalizeIoVec with bad parameters.
+ */
+void test_StunSerializer_AddAttributeDataReference_BadParams( void )
+{
+    StunContext_t ctx = { 0 };
+    StunHeader_t header = { 0 };
+    uint8_t attributeData[ 8 ] = { 0 };
+    uint8_t integrity[ STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH ] = { 0 };
+    StunIoVec_t ioVecs[ STUN_SERIALIZER_IOVEC_MAX_COUNT ];
+    size_t ioVecCount = 0;
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] = { 0 };
+
+    header.messageType = STUN_MESSAGE_TYPE_SEND_INDICATION;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    /* Not enough space for the attribute header. */
+    ( void ) StunSerializer_Init( &( ctx ),
+                                  pStunMessageBuffer,
+                                  STUN_HEADER_LENGTH + 2,
+                                  &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OUT_OF_MEMORY,
+                       StunSerializer_AddAttributeDataReference( &( ctx ),
+                                                                 &( attributeData[ 0 ] ),
+                                                                 4 ) );
+
+    ( void ) StunSerializer_Init( &( ctx ),
+                                  pStunMessageBuffer,
+                                  STUN_MESSAGE_BUFFER_LENGTH,
+                                  &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_AddAttributeDataReference( NULL,
+                                                                 &( attributeData[ 0 ] ),
+                                                                 4 ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_AddAttributeDataReference( &( ctx ),
+                                                                 NULL,
+                                                                 4 ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_AddAttributeDataReference( &( ctx ),
+                                                                 &( attributeData[ 0 ] ),
+                                                                 0 ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_AddAttributeDataReference( &( ctx ),
+                                                                 &( attributeData[ 0 ] ),
+                                                                 STUN_ATTRIBUTE_DATA_VALUE_MAX_LENGTH + 1 ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_AddAttributeDataReference( &( ctx ),
+                                                                 &( attributeData[ 0 ] ),
+                                                                 5 ) );
+
+    /* Only one DATA value can be referenced. */
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_AddAttributeDataReference( &( ctx ),
+                                                                 &( attributeData[ 0 ] ),
+                                                                 4 ) );
+
+    /* Integrity cannot be computed over the referenced DATA value. */
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE_ORDER,
+                       StunSerializer_AddAttributeIntegrity( &( ctx ),
+                                                             &( integrity[ 0 ] ),
+                                                             STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH ) );
+
+    /* The padding is after the DATA value, so there are 3 parts. */
+    TEST_ASSERT_EQUAL( STUN_RESULT_OUT_OF_MEMORY,
+                       StunSerializer_FinalizeIoVec( &( ctx ),
+                                                     &( ioVecs[ 0 ] ),
+                                                     2,
+                                                     &( ioVecCount ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_FinalizeIoVec( NULL,
+                                                     &( ioVecs[ 0 ] ),
+                                                     STUN_SERIALIZER_IOVEC_MAX_COUNT,
+                                                     &( ioVecCount ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_FinalizeIoVec( &( ctx ),
+                                                     NULL,
+                                                     STUN_SERIALIZER_IOVEC_MAX_COUNT,
+                                                     &( ioVecCount ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_FinalizeIoVec( &( ctx ),
+                                                     &( ioVecs[ 0 ] ),
+                                                     STUN_SERIALIZER_IOVEC_MAX_COUNT,
+                                                     NULL ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_FinalizeIoVec( &( ctx ),
+                                                     &( ioVecs[ 0 ] ),
+                                                     STUN_SERIALIZER_IOVEC_MAX_COUNT,
+                                                     &( ioVecCount ) ) );
+    TEST_ASSERT_EQUAL( 3,
+                       ioVecCount );
+    TEST_ASSERT_EQUAL( 3,
+                       ioVecs[ 2 ].length );
+    TEST_ASSERT_EACH_EQUAL_UINT8( 0,
+                                  ioVecs[ 2 ].pBase,
+                                  3 );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunSerializer_FinalizeIoVec with a message without a
+ * referenced DATA value, which is returned in one part.
+ */
+void test_StunSerializer_FinalizeIoVec_SingleIoVec( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    const uint8_t * pAttributeData = ( const uint8_t * ) "Attribute Data";
+    StunIoVec_t ioVecs[ 1 ];
+    size_t ioVecCount = 0, stunMessageLength = 0;
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] = { 0 };
+
+    header.messageType = STUN_MESSAGE_TYPE_SEND_INDICATION;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    ( void ) StunSerializer_Init( &( ctx ),
+                                  pStunMessageBuffer,
+                                  STUN_MESSAGE_BUFFER_LENGTH,
+                                  &( header ) );
+    ( void ) StunSerializer_AddAttributeData( &( ctx ),
+                                              pAttributeData,
+                                              strlen( ( const char * ) pAttributeData ) );
+
+    result = StunSerializer_FinalizeIoVec( &( ctx ),
+                                           &( ioVecs[ 0 ] ),
+                                           1,
+                                           &( ioVecCount ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( 1,
+                       ioVecCount );
+
+    result = StunSerializer_Finalize( &( ctx ),
+                                      &( stunMessageLength ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL_PTR( pStunMessageBuffer,
+                           ioVecs[ 0 ].pBase );
+    TEST_ASSERT_EQUAL( stunMessageLength,
+                       ioVecs[ 0 ].length );
+    TEST_ASSERT_EQUAL( STUN_HEADER_LENGTH + STUN_ATTRIBUTE_HEADER_LENGTH + 16,
+                       ioVecs[ 0 ].length );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunSerializer_AddAttributeRealm in the happy path.
+ */
+void test_StunSerializer_AddAttributeRealm_Pass( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    const uint8_t * pRealm = ( const uint8_t * ) "Realm Example";
+    uint16_t realmLength = strlen( ( const char * ) pRealm );
+    size_t stunMessageLength;
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] =
+    {
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5
+    };
+    uint8_t expectedStunMessage[] =
+    {
+        /* Message Type = STUN Binding Request, Message Length = 20 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x14,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+        /* Attribute Type = REALM (0x0014), Attribute Length = 13. */
+        0x00, 0x14, 0x00, 0x0D,
+        /* Attribute Value = "Realm Example". */
+        0x52, 0x65, 0x61, 0x6C,
+        0x6D, 0x20, 0x45, 0x78,
+        0x61, 0x6D, 0x70, 0x6C,
+        0x65, 0x00, 0x00, 0x00,
+    };
+    size_t expectedStunMessageLength = sizeof( expectedStunMessage );
+
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    result = StunSerializer_Init( &( ctx ),
+                                  pStunMessageBuffer,
+                                  STUN_MESSAGE_BUFFER_LENGTH,
+                                  &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunSerializer_AddAttributeRealm( &( ctx ),
+                                               pRealm,
+                                               realmLength );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunSerializer_Finalize( &( ctx ),
+                                      &( stunMessageLength ) );
 
     TEST_ASSERT_EQUAL( STUN_RESULT_OK,
                        result );
@@ -3955,31 +4699,73 @@ void test_StunSerializer_GetFingerprintBuffer_CurrentIndexUnderflow( void )
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Validate StunSerializer_AddAttributeFingerprint incase of invalid attribute order.
+ * @brief Validate that StunSerializer_GetFingerprintBuffer fails after a
+ * referenced DATA value, which is not in the buffer.
  */
-void test_StunSerializer_AddAttributeFingerprint_InvalidAttributeOrder( void )
+void test_StunSerializer_GetFingerprintBuffer_DataReference( void )
 {
     StunContext_t ctx = { 0 };
     StunResult_t result;
     StunHeader_t header = { 0 };
-    uint32_t crc32Fingerprint = 0x54DA6D71;
-    const uint8_t hmacValue[] =
-    {
-        0x72, 0x64, 0x6D, 0x2F,
-        0x55, 0x77, 0xF4, 0x23,
-        0x73, 0x72, 0x75, 0x6C,
-        0x76, 0x61, 0x74, 0x62,
-        0xAB, 0xBC, 0xCD, 0xDE,
-    };
-    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] =
-    {
-        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5
-    };
+    const uint8_t * pAttributeData = ( const uint8_t * ) "Attribute Data";
+    uint8_t * pFingerprintBuffer = NULL;
+    uint16_t fingerprintBufferLength = 0;
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] = { 0 };
 
-    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    header.messageType = STUN_MESSAGE_TYPE_SEND_INDICATION;
     header.pTransactionId = &( transactionId[ 0 ] );
 
-    result = StunSerializer_Init( &( ctx ),
+    ( void ) StunSerializer_Init( &( ctx ),
+                                  pStunMessageBuffer,
+                                  STUN_MESSAGE_BUFFER_LENGTH,
+                                  &( header ) );
+    ( void ) StunSerializer_AddAttributeDataReference( &( ctx ),
+                                                       pAttributeData,
+                                                       strlen( ( const char * ) pAttributeData ) );
+
+    result = StunSerializer_GetFingerprintBuffer( &( ctx ),
+                                                  &( pFingerprintBuffer ),
+                                                  &( fingerprintBufferLength ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE_ORDER,
+                       result );
+    TEST_ASSERT_NULL( pFingerprintBuffer );
+
+    /* StunSerializer_AddComputedFingerprint includes the referenced value. */
+    result = StunSerializer_AddComputedFingerprint( &( ctx ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunSerializer_AddAttributeFingerprint incase of invalid attribute order.
+ */
+void test_StunSerializer_AddAttributeFingerprint_InvalidAttributeOrder( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    uint32_t crc32Fingerprint = 0x54DA6D71;
+    const uint8_t hmacValue[] =
+    {
+        0x72, 0x64, 0x6D, 0x2F,
+        0x55, 0x77, 0xF4, 0x23,
+        0x73, 0x72, 0x75, 0x6C,
+        0x76, 0x61, 0x74, 0x62,
+        0xAB, 0xBC, 0xCD, 0xDE,
+    };
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] =
+    {
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5
+    };
+
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    result = StunSerializer_Init( &( ctx ),
                                   pStunMessageBuffer,
                                   STUN_MESSAGE_BUFFER_LENGTH,
                                   &( header ) );
@@ -4133,4 +4919,1259 @@ void test_StunSerializer_AddAttributeFingerprint_ValidAttributeOrder( void )
                                    expectedStunMessageLength );
 }
 
-/*-----------------------------------------------------------*/
\ No newline at end of file
+/*-----------------------------------------------------------*/
+/**
+ * @brief Validate serializing into a buffer which is not aligned to the size
+ * of the attribute values.
+ */
+void test_StunSerializer_UnalignedBuffer_Pass( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    size_t stunMessageLength;
+    uint8_t * pUnalignedBuffer = &( pStunMessageBuffer[ 1 ] );
+    uint32_t priority = 0x7E7F00FF;
+    uint64_t tieBreaker = 0x1234567890ABCDEF;
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] =
+    {
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5
+    };
+    uint8_t expectedStunMessage[] =
+    {
+        /* Message Type = STUN Binding Request, Message Length = 20 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x14,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+        /* Attribute type = PRIORITY (0x0024), Attribute Length = 4. */
+        0x00, 0x24, 0x00, 0x04,
+        /* Attribute Value = 0x7E7F00FF. */
+        0x7E, 0x7F, 0x00, 0xFF,
+        /* Attribute type = ICE-CONTROLLING (0x802A), Attribute Length = 8. */
+        0x80, 0x2A, 0x00, 0x08,
+        /* Attribute Value = 0x1234567890ABCDEF. */
+        0x12, 0x34, 0x56, 0x78, 0x90, 0xAB, 0xCD, 0xEF
+    };
+    size_t expectedStunMessageLength = sizeof( expectedStunMessage );
+
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    result = StunSerializer_Init( &( ctx ),
+                                  pUnalignedBuffer,
+                                  STUN_MESSAGE_BUFFER_LENGTH - 1,
+                                  &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunSerializer_AddAttributePriority( &( ctx ),
+                                                  priority );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunSerializer_AddAttributeIceControlling( &( ctx ),
+                                                        tieBreaker );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunSerializer_Finalize( &( ctx ),
+                                      &( stunMessageLength ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( expectedStunMessageLength,
+                       stunMessageLength );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedStunMessage[ 0 ] ),
+                                   pUnalignedBuffer,
+                                   expectedStunMessageLength );
+}
+
+/*-----------------------------------------------------------*/
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunSerializer_AddComputedIntegrity computes the HMAC-SHA1
+ * of the message.
+ */
+void test_StunSerializer_AddComputedIntegrity_Pass( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    StunIntegrityKey_t integrityKey;
+    size_t stunMessageLength;
+    const uint8_t password[] = "VOkJxbRl1RmTxUk/WvJxBt";
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] =
+    {
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5
+    };
+    uint8_t expectedStunMessage[] =
+    {
+        /* Message Type = STUN Binding Request, Message Length = 32 (excluding 20 bytes header). */
+        0x00, 0x01, 0x00, 0x20,
+        /* Magic cookie. */
+        0x21, 0x12, 0xA4, 0x42,
+        /* Transaction ID. */
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5,
+        /* Attribute type = PRIORITY (0x0024), Attribute Length = 4. */
+        0x00, 0x24, 0x00, 0x04,
+        /* Attribute Value = 0x7E7F00FF. */
+        0x7E, 0x7F, 0x00, 0xFF,
+        /* Attribute type = MESSAGE-INTEGRITY (0x0008), Attribute Length = 20. */
+        0x00, 0x08, 0x00, 0x14,
+        /* Attribute Value = HMAC-SHA1 of the bytes above with key "VOkJxbRl1RmTxUk/WvJxBt". */
+        0x29, 0x77, 0xE4, 0xE3, 0x3C, 0xF7, 0xE1, 0xC7, 0xC5, 0x1D,
+        0xCB, 0x88, 0xCC, 0x99, 0xC4, 0x64, 0x4C, 0xDB, 0xFB, 0x6A
+    };
+    size_t expectedStunMessageLength = sizeof( expectedStunMessage );
+
+    result = StunIntegrity_InitKey( &( integrityKey ),
+                                    &( password[ 0 ] ),
+                                    sizeof( password ) - 1,
+                                    NULL );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    result = StunSerializer_Init( &( ctx ),
+                                  pStunMessageBuffer,
+                                  STUN_MESSAGE_BUFFER_LENGTH,
+                                  &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunSerializer_AddAttributePriority( &( ctx ),
+                                                  0x7E7F00FF );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunSerializer_AddComputedIntegrity( &( ctx ),
+                                                  &( integrityKey ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunSerializer_Finalize( &( ctx ),
+                                      &( stunMessageLength ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( expectedStunMessageLength,
+                       stunMessageLength );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedStunMessage[ 0 ] ),
+                                   pStunMessageBuffer,
+                                   expectedStunMessageLength );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunSerializer_AddComputedIntegrity when only the length of
+ * the message is calculated.
+ */
+void test_StunSerializer_AddComputedIntegrity_NullBuffer( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunHeader_t header = { 0 };
+    StunIntegrityKey_t integrityKey = { 0 };
+    size_t stunMessageLength;
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] =
+    {
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5
+    };
+
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    result = StunSerializer_Init( &( ctx ),
+                                  NULL,
+                                  0,
+                                  &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    /* The key is not used as nothing is hashed. */
+    result = StunSerializer_AddComputedIntegrity( &( ctx ),
+                                                  &( integrityKey ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+
+    result = StunSerializer_Finalize( &( ctx ),
+                                      &( stunMessageLength ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       result );
+    TEST_ASSERT_EQUAL( STUN_HEADER_LENGTH + 24,
+                       stunMessageLength );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunSerializer_AddComputedIntegrity incase of bad
+ * parameters.
+ */
+void test_StunSerializer_AddComputedIntegrity_BadParams( void )
+{
+    StunContext_t ctx = { 0 };
+    StunResult_t result;
+    StunIntegrityKey_t integrityKey = { 0 };
+
+    result = StunSerializer_AddComputedIntegrity( NULL,
+                                                  &( integrityKey ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+
+    result = StunSerializer_AddComputedIntegrity( &( ctx ),
+                                                  NULL );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       result );
+}
+
+/*-----------------------------------------------------------*/
+
+static size_t SerializeSignedMessage( uint8_t * pBuffer,
+                                      size_t bufferLength,
+                                      const uint8_t * pData,
+                                      uint16_t dataLength,
+                                      uint8_t fused )
+{
+    StunContext_t ctx = { 0 };
+    StunHeader_t header = { 0 };
+    StunIntegrityKey_t integrityKey;
+    size_t stunMessageLength = 0;
+    const uint8_t password[] = "VOkJxbRl1RmTxUk/WvJxBt";
+    const uint8_t username[] = "evtj:h6vY";
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] =
+    {
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5
+    };
+
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunIntegrity_InitKey( &( integrityKey ),
+                                              &( password[ 0 ] ),
+                                              sizeof( password ) - 1,
+                                              NULL ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_Init( &( ctx ),
+                                            pBuffer,
+                                            bufferLength,
+                                            &( header ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_AddAttributeUsername( &( ctx ),
+                                                            &( username[ 0 ] ),
+                                                            sizeof( username ) - 1 ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_AddAttributePriority( &( ctx ),
+                                                            0x6E0001FF ) );
+
+    if( dataLength > 0 )
+    {
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunSerializer_AddAttributeData( &( ctx ),
+                                                            pData,
+                                                            dataLength ) );
+    }
+
+    if( fused != 0 )
+    {
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunSerializer_FinalizeWithIntegrityAndFingerprint( &( ctx ),
+                                                                               &( integrityKey ),
+                                                                               &( stunMessageLength ) ) );
+    }
+    else
+    {
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunSerializer_AddComputedIntegrity( &( ctx ),
+                                                                &( integrityKey ) ) );
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunSerializer_AddComputedFingerprint( &( ctx ) ) );
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunSerializer_Finalize( &( ctx ),
+                                                    &( stunMessageLength ) ) );
+    }
+
+    return stunMessageLength;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that StunSerializer_FinalizeWithIntegrityAndFingerprint
+ * produces the same message as adding the attributes one by one, including
+ * for a message hashed in several chunks.
+ */
+void test_StunSerializer_FinalizeWithIntegrityAndFingerprint_Pass( void )
+{
+    uint8_t data[ 2500 ];
+    uint8_t expectedStunMessage[ 2600 ], stunMessage[ 2600 ];
+    size_t expectedStunMessageLength, stunMessageLength, i;
+    uint16_t dataLengths[] = { 0, 1, 1023, 2500 };
+
+    for( i = 0; i < sizeof( data ); i++ )
+    {
+        data[ i ] = ( uint8_t ) i;
+    }
+
+    for( i = 0; i < sizeof( dataLengths ) / sizeof( dataLengths[ 0 ] ); i++ )
+    {
+        expectedStunMessageLength = SerializeSignedMessage( &( expectedStunMessage[ 0 ] ),
+                                                            sizeof( expectedStunMessage ),
+                                                            &( data[ 0 ] ),
+                                                            dataLengths[ i ],
+                                                            0 );
+        stunMessageLength = SerializeSignedMessage( &( stunMessage[ 0 ] ),
+                                                    sizeof( stunMessage ),
+                                                    &( data[ 0 ] ),
+                                                    dataLengths[ i ],
+                                                    1 );
+
+        TEST_ASSERT_EQUAL( expectedStunMessageLength,
+                           stunMessageLength );
+        TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedStunMessage[ 0 ] ),
+                                       &( stunMessage[ 0 ] ),
+                                       expectedStunMessageLength );
+    }
+
+    /* Only the length is calculated. */
+    stunMessageLength = SerializeSignedMessage( NULL,
+                                                0,
+                                                &( data[ 0 ] ),
+                                                100,
+                                                1 );
+
+    TEST_ASSERT_EQUAL( STUN_HEADER_LENGTH + 16 + 8 + 104 + 24 + 8,
+                       stunMessageLength );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunSerializer_FinalizeWithIntegrityAndFingerprint with
+ * more than STUN_SERIALIZER_HASH_CHUNK_LENGTH bytes before MESSAGE-INTEGRITY,
+ * which are hashed in several chunks, against
+ * StunSerializer_AddComputedIntegrity.
+ */
+void test_StunSerializer_FinalizeWithIntegrityAndFingerprint_LargeMessage( void )
+{
+    static uint8_t data[ 20000 ];
+    static uint8_t expectedStunMessage[ 20100 ], stunMessage[ 20100 ];
+    size_t expectedStunMessageLength, stunMessageLength, i;
+
+    for( i = 0; i < sizeof( data ); i++ )
+    {
+        data[ i ] = ( uint8_t ) ( i * 7U );
+    }
+
+    expectedStunMessageLength = SerializeSignedMessage( &( expectedStunMessage[ 0 ] ),
+                                                        sizeof( expectedStunMessage ),
+                                                        &( data[ 0 ] ),
+                                                        sizeof( data ),
+                                                        0 );
+    stunMessageLength = SerializeSignedMessage( &( stunMessage[ 0 ] ),
+                                                sizeof( stunMessage ),
+                                                &( data[ 0 ] ),
+                                                sizeof( data ),
+                                                1 );
+
+    TEST_ASSERT_EQUAL( STUN_HEADER_LENGTH + 16 + 8 + 20004 + 24 + 8,
+                       stunMessageLength );
+    TEST_ASSERT_EQUAL( expectedStunMessageLength,
+                       stunMessageLength );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedStunMessage[ 0 ] ),
+                                   &( stunMessage[ 0 ] ),
+                                   expectedStunMessageLength );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunSerializer_FinalizeWithIntegrityAndFingerprint with
+ * currentIndex less than STUN_HEADER_LENGTH.
+ */
+void test_StunSerializer_FinalizeWithIntegrityAndFingerprint_CurrentIndexUnderflow( void )
+{
+    StunContext_t ctx = { 0 };
+    StunIntegrityKey_t integrityKey;
+    size_t stunMessageLength;
+    const uint8_t key[] = "key";
+
+    ( void ) StunIntegrity_InitKey( &( integrityKey ),
+                                    &( key[ 0 ] ),
+                                    sizeof( key ) - 1,
+                                    NULL );
+
+    ctx.currentIndex = 10;
+    ctx.pStart = pStunMessageBuffer;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_MESSAGE_LENGTH,
+                       StunSerializer_FinalizeWithIntegrityAndFingerprint( &( ctx ),
+                                                                           &( integrityKey ),
+                                                                           &( stunMessageLength ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunSerializer_FinalizeWithIntegrityAndFingerprint with bad
+ * parameters and attribute order.
+ */
+void test_StunSerializer_FinalizeWithIntegrityAndFingerprint_BadParams( void )
+{
+    StunContext_t ctx = { 0 };
+    StunHeader_t header = { 0 };
+    StunIntegrityKey_t integrityKey;
+    size_t stunMessageLength;
+    const uint8_t key[] = "key";
+    uint8_t data[ 4 ] = { 0 };
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] = { 0 };
+
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    ( void ) StunIntegrity_InitKey( &( integrityKey ),
+                                    &( key[ 0 ] ),
+                                    sizeof( key ) - 1,
+                                    NULL );
+    ( void ) StunSerializer_Init( &( ctx ),
+                                  pStunMessageBuffer,
+                                  STUN_MESSAGE_BUFFER_LENGTH,
+                                  &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_FinalizeWithIntegrityAndFingerprint( NULL,
+                                                                           &( integrityKey ),
+                                                                           &( stunMessageLength ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_FinalizeWithIntegrityAndFingerprint( &( ctx ),
+                                                                           NULL,
+                                                                           &( stunMessageLength ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_FinalizeWithIntegrityAndFingerprint( &( ctx ),
+                                                                           &( integrityKey ),
+                                                                           NULL ) );
+
+    /* No space for the two attributes. */
+    ( void ) StunSerializer_Init( &( ctx ),
+                                  pStunMessageBuffer,
+                                  STUN_HEADER_LENGTH + 31,
+                                  &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OUT_OF_MEMORY,
+                       StunSerializer_FinalizeWithIntegrityAndFingerprint( &( ctx ),
+                                                                           &( integrityKey ),
+                                                                           &( stunMessageLength ) ) );
+
+    /* FINGERPRINT is already there. */
+    ( void ) StunSerializer_Init( &( ctx ),
+                                  pStunMessageBuffer,
+                                  STUN_MESSAGE_BUFFER_LENGTH,
+                                  &( header ) );
+    ( void ) StunSerializer_AddComputedFingerprint( &( ctx ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE_ORDER,
+                       StunSerializer_FinalizeWithIntegrityAndFingerprint( &( ctx ),
+                                                                           &( integrityKey ),
+                                                                           &( stunMessageLength ) ) );
+
+    /* The HMAC cannot cover a referenced DATA value. */
+    ( void ) StunSerializer_Init( &( ctx ),
+                                  pStunMessageBuffer,
+                                  STUN_MESSAGE_BUFFER_LENGTH,
+                                  &( header ) );
+    ( void ) StunSerializer_AddAttributeDataReference( &( ctx ),
+                                                       &( data[ 0 ] ),
+                                                       sizeof( data ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_ATTRIBUTE_ORDER,
+                       StunSerializer_FinalizeWithIntegrityAndFingerprint( &( ctx ),
+                                                                           &( integrityKey ),
+                                                                           &( stunMessageLength ) ) );
+
+    /* Message length over the maximum. */
+    ctx.attributeFlag = 0;
+    ctx.currentIndex = STUN_HEADER_LENGTH + STUN_MAX_MESSAGE_LENGTH - 28;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_MESSAGE_LENGTH,
+                       StunSerializer_FinalizeWithIntegrityAndFingerprint( &( ctx ),
+                                                                           &( integrityKey ),
+                                                                           &( stunMessageLength ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that the message finalized with a hash stream is the same as
+ * without, including when the message does not have the expected length or is
+ * finalized with another key.
+ */
+void test_StunSerializer_EnableHashStream_Pass( void )
+{
+    StunContext_t ctx = { 0 };
+    StunHeader_t header = { 0 };
+    StunIntegrityKey_t integrityKey, otherIntegrityKey;
+    StunSerializerHashStream_t hashStream;
+    uint8_t data[ 2500 ];
+    uint8_t expectedStunMessage[ 2600 ], stunMessage[ 2600 ];
+    size_t expectedStunMessageLength, stunMessageLength, i;
+    const uint8_t password[] = "VOkJxbRl1RmTxUk/WvJxBt";
+    const uint8_t username[] = "evtj:h6vY";
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] =
+    {
+        0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xAB, 0xCD, 0xEF, 0xA5
+    };
+    /* Expected length offsets: exact, wrong, exact with another key. */
+    int32_t lengthOffsets[] = { 0, 4, 0 };
+
+    for( i = 0; i < sizeof( data ); i++ )
+    {
+        data[ i ] = ( uint8_t ) i;
+    }
+
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    ( void ) StunIntegrity_InitKey( &( integrityKey ),
+                                    &( password[ 0 ] ),
+                                    sizeof( password ) - 1,
+                                    NULL );
+    ( void ) StunIntegrity_InitKey( &( otherIntegrityKey ),
+                                    &( password[ 0 ] ),
+                                    sizeof( password ) - 1,
+                                    NULL );
+
+    expectedStunMessageLength = SerializeSignedMessage( &( expectedStunMessage[ 0 ] ),
+                                                        sizeof( expectedStunMessage ),
+                                                        &( data[ 0 ] ),
+                                                        sizeof( data ),
+                                                        1 );
+
+    for( i = 0; i < sizeof( lengthOffsets ) / sizeof( lengthOffsets[ 0 ] ); i++ )
+    {
+        memset( &( stunMessage[ 0 ] ),
+                0,
+                sizeof( stunMessage ) );
+
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunSerializer_Init( &( ctx ),
+                                                &( stunMessage[ 0 ] ),
+                                                sizeof( stunMessage ),
+                                                &( header ) ) );
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunSerializer_EnableHashStream( &( ctx ),
+                                                            &( hashStream ),
+                                                            ( i == 2 ) ? &( otherIntegrityKey ) : &( integrityKey ),
+                                                            ( size_t ) ( ( int32_t ) expectedStunMessageLength + lengthOffsets[ i ] ) ) );
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunSerializer_AddAttributeUsername( &( ctx ),
+                                                                &( username[ 0 ] ),
+                                                                sizeof( username ) - 1 ) );
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunSerializer_AddAttributePriority( &( ctx ),
+                                                                0x6E0001FF ) );
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunSerializer_AddAttributeData( &( ctx ),
+                                                            &( data[ 0 ] ),
+                                                            sizeof( data ) ) );
+
+        /* Whole blocks have been hashed while the attributes were added. */
+        TEST_ASSERT_EQUAL( ( ctx.currentIndex / 64 ) * 64,
+                           hashStream.hashedIndex );
+
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunSerializer_FinalizeWithIntegrityAndFingerprint( &( ctx ),
+                                                                               &( integrityKey ),
+                                                                               &( stunMessageLength ) ) );
+        TEST_ASSERT_EQUAL( expectedStunMessageLength,
+                           stunMessageLength );
+        TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedStunMessage[ 0 ] ),
+                                       &( stunMessage[ 0 ] ),
+                                       expectedStunMessageLength );
+        TEST_ASSERT_NULL( ctx.pHashStream );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunSerializer_EnableHashStream with bad parameters.
+ */
+void test_StunSerializer_EnableHashStream_BadParams( void )
+{
+    StunContext_t ctx = { 0 };
+    StunHeader_t header = { 0 };
+    StunIntegrityKey_t integrityKey;
+    StunSerializerHashStream_t hashStream;
+    const uint8_t key[] = "key";
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] = { 0 };
+
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    ( void ) StunIntegrity_InitKey( &( integrityKey ),
+                                    &( key[ 0 ] ),
+                                    sizeof( key ) - 1,
+                                    NULL );
+    ( void ) StunSerializer_Init( &( ctx ),
+                                  pStunMessageBuffer,
+                                  STUN_MESSAGE_BUFFER_LENGTH,
+                                  &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_EnableHashStream( NULL,
+                                                        &( hashStream ),
+                                                        &( integrityKey ),
+                                                        100 ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_EnableHashStream( &( ctx ),
+                                                        NULL,
+                                                        &( integrityKey ),
+                                                        100 ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_EnableHashStream( &( ctx ),
+                                                        &( hashStream ),
+                                                        NULL,
+                                                        100 ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_EnableHashStream( &( ctx ),
+                                                        &( hashStream ),
+                                                        &( integrityKey ),
+                                                        STUN_HEADER_LENGTH + 31 ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_EnableHashStream( &( ctx ),
+                                                        &( hashStream ),
+                                                        &( integrityKey ),
+                                                        STUN_HEADER_LENGTH + STUN_MAX_MESSAGE_LENGTH + 1 ) );
+
+    /* Attributes have already been added. */
+    ( void ) StunSerializer_AddAttributePriority( &( ctx ),
+                                                  0 );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_EnableHashStream( &( ctx ),
+                                                        &( hashStream ),
+                                                        &( integrityKey ),
+                                                        100 ) );
+
+    /* Only the length is calculated. */
+    ( void ) StunSerializer_Init( &( ctx ),
+                                  NULL,
+                                  0,
+                                  &( header ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_EnableHashStream( &( ctx ),
+                                                        &( hashStream ),
+                                                        &( integrityKey ),
+                                                        100 ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that StunSerializer_CalculateMessageLength and the length
+ * macros match the length of the serialized messages.
+ */
+void test_StunSerializer_CalculateMessageLength_Pass( void )
+{
+    StunContext_t ctx = { 0 };
+    StunHeader_t header = { 0 };
+    StunIntegrityKey_t integrityKey;
+    uint8_t data[ 1201 ] = { 0 }, stunMessage[ 1300 ];
+    uint8_t iceCheck[ STUN_SERIALIZER_ICE_CHECK_LENGTH( 16, 1 ) ];
+    size_t stunMessageLength = 0, calculatedMessageLength = 0;
+    const uint8_t key[] = "key";
+    const uint8_t username[] = "0123456789abcdef";
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] = { 0 };
+    StunSerializerAttributeDescriptor_t signedMessage[] =
+    {
+        { STUN_ATTRIBUTE_TYPE_USERNAME, 9 },
+        { STUN_ATTRIBUTE_TYPE_PRIORITY, STUN_ATTRIBUTE_PRIORITY_VALUE_LENGTH },
+        { STUN_ATTRIBUTE_TYPE_DATA, 0 },
+        { STUN_ATTRIBUTE_TYPE_MESSAGE_INTEGRITY, STUN_ATTRIBUTE_INTEGRITY_VALUE_LENGTH },
+        { STUN_ATTRIBUTE_TYPE_FINGERPRINT, STUN_ATTRIBUTE_FINGERPRINT_VALUE_LENGTH }
+    };
+    StunSerializerAttributeDescriptor_t sendIndication[] =
+    {
+        { STUN_ATTRIBUTE_TYPE_XOR_PEER_ADDRESS, STUN_ATTRIBUTE_ADDRESS_IPV6_VALUE_LENGTH },
+        { STUN_ATTRIBUTE_TYPE_DATA, STUN_ATTRIBUTE_DATA_VALUE_MAX_LENGTH - STUN_SERIALIZER_ATTRIBUTE_LENGTH( STUN_ATTRIBUTE_ADDRESS_IPV6_VALUE_LENGTH ) }
+    };
+
+    /* DATA with and without padding. */
+    signedMessage[ 2 ].valueLength = 1200;
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_CalculateMessageLength( &( signedMessage[ 0 ] ),
+                                                              sizeof( signedMessage ) / sizeof( signedMessage[ 0 ] ),
+                                                              &( calculatedMessageLength ) ) );
+    TEST_ASSERT_EQUAL( SerializeSignedMessage( &( stunMessage[ 0 ] ),
+                                               sizeof( stunMessage ),
+                                               &( data[ 0 ] ),
+                                               1200,
+                                               1 ),
+                       calculatedMessageLength );
+
+    signedMessage[ 2 ].valueLength = 1201;
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_CalculateMessageLength( &( signedMessage[ 0 ] ),
+                                                              sizeof( signedMessage ) / sizeof( signedMessage[ 0 ] ),
+                                                              &( calculatedMessageLength ) ) );
+    TEST_ASSERT_EQUAL( SerializeSignedMessage( &( stunMessage[ 0 ] ),
+                                               sizeof( stunMessage ),
+                                               &( data[ 0 ] ),
+                                               1201,
+                                               1 ),
+                       calculatedMessageLength );
+
+    /* Header only. */
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_CalculateMessageLength( NULL,
+                                                              0,
+                                                              &( calculatedMessageLength ) ) );
+    TEST_ASSERT_EQUAL( STUN_HEADER_LENGTH,
+                       calculatedMessageLength );
+
+    /* Largest message. */
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_CalculateMessageLength( &( sendIndication[ 0 ] ),
+                                                              2,
+                                                              &( calculatedMessageLength ) ) );
+    TEST_ASSERT_EQUAL( STUN_SERIALIZER_SEND_INDICATION_LENGTH( STUN_ATTRIBUTE_ADDRESS_IPV6_VALUE_LENGTH,
+                                                               sendIndication[ 1 ].valueLength ),
+                       calculatedMessageLength );
+    TEST_ASSERT_EQUAL( STUN_HEADER_LENGTH + STUN_ATTRIBUTE_DATA_VALUE_MAX_LENGTH + STUN_ATTRIBUTE_HEADER_LENGTH,
+                       calculatedMessageLength );
+
+    TEST_ASSERT_EQUAL( 92,
+                       STUN_SERIALIZER_ICE_CHECK_LENGTH( 9, 1 ) );
+    TEST_ASSERT_EQUAL( 88,
+                       STUN_SERIALIZER_ICE_CHECK_LENGTH( 9, 0 ) );
+    TEST_ASSERT_EQUAL( STUN_HEADER_LENGTH + 12 + 32,
+                       STUN_SERIALIZER_ICE_CHECK_RESPONSE_LENGTH( STUN_ATTRIBUTE_ADDRESS_IPV4_VALUE_LENGTH ) );
+
+    /* An ICE check fills a buffer sized with the macro. */
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    ( void ) StunIntegrity_InitKey( &( integrityKey ),
+                                    &( key[ 0 ] ),
+                                    sizeof( key ) - 1,
+                                    NULL );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_Init( &( ctx ),
+                                            &( iceCheck[ 0 ] ),
+                                            sizeof( iceCheck ),
+                                            &( header ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_AddAttributeUsername( &( ctx ),
+                                                            &( username[ 0 ] ),
+                                                            sizeof( username ) - 1 ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_AddAttributeIceControlling( &( ctx ),
+                                                                  0x1122334455667788 ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_AddAttributeUseCandidate( &( ctx ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_AddAttributePriority( &( ctx ),
+                                                            0x6E0001FF ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_FinalizeWithIntegrityAndFingerprint( &( ctx ),
+                                                                           &( integrityKey ),
+                                                                           &( stunMessageLength ) ) );
+    TEST_ASSERT_EQUAL( sizeof( iceCheck ),
+                       stunMessageLength );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunSerializer_CalculateMessageLength with bad parameters
+ * and messages that are too long.
+ */
+void test_StunSerializer_CalculateMessageLength_BadParams( void )
+{
+    size_t calculatedMessageLength = 0;
+    StunSerializerAttributeDescriptor_t attributes[] =
+    {
+        { STUN_ATTRIBUTE_TYPE_DATA, STUN_ATTRIBUTE_DATA_VALUE_MAX_LENGTH },
+        { STUN_ATTRIBUTE_TYPE_USERNAME, STUN_ATTRIBUTE_VALUE_MAX_LENGTH }
+    };
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_CalculateMessageLength( NULL,
+                                                              1,
+                                                              &( calculatedMessageLength ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_CalculateMessageLength( &( attributes[ 0 ] ),
+                                                              1,
+                                                              NULL ) );
+
+    /* Only DATA can be longer than STUN_ATTRIBUTE_VALUE_MAX_LENGTH. */
+    attributes[ 1 ].valueLength = STUN_ATTRIBUTE_VALUE_MAX_LENGTH + 1;
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_CalculateMessageLength( &( attributes[ 1 ] ),
+                                                              1,
+                                                              &( calculatedMessageLength ) ) );
+    attributes[ 0 ].valueLength = STUN_ATTRIBUTE_DATA_VALUE_MAX_LENGTH + 1;
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_CalculateMessageLength( &( attributes[ 0 ] ),
+                                                              1,
+                                                              &( calculatedMessageLength ) ) );
+
+    /* Does not fit in the 16-bit message length. */
+    attributes[ 0 ].valueLength = STUN_ATTRIBUTE_DATA_VALUE_MAX_LENGTH;
+    attributes[ 1 ].valueLength = 1;
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_MESSAGE_LENGTH,
+                       StunSerializer_CalculateMessageLength( &( attributes[ 0 ] ),
+                                                              2,
+                                                              &( calculatedMessageLength ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+static void AddIceCheckTail( StunContext_t * pCtx,
+                             const StunIntegrityKey_t * pIntegrityKey,
+                             uint32_t priority,
+                             uint8_t useCandidate,
+                             size_t * pStunMessageLength )
+{
+    if( useCandidate != 0 )
+    {
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunSerializer_AddAttributeUseCandidate( pCtx ) );
+    }
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_AddAttributePriority( pCtx,
+                                                            priority ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_FinalizeWithIntegrityAndFingerprint( pCtx,
+                                                                           pIntegrityKey,
+                                                                           pStunMessageLength ) );
+}
+
+/*-----------------------------------------------------------*/
+
+static void SerializeIceCheckPrefix( StunContext_t * pCtx,
+                                     uint8_t * pBuffer,
+                                     size_t bufferLength,
+                                     uint8_t * pTransactionId )
+{
+    StunHeader_t header = { 0 };
+    const uint8_t username[] = "evtj:h6vY";
+
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+    header.pTransactionId = pTransactionId;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_Init( pCtx,
+                                            pBuffer,
+                                            bufferLength,
+                                            &( header ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_AddAttributeUsername( pCtx,
+                                                            &( username[ 0 ] ),
+                                                            sizeof( username ) - 1 ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_AddAttributeIceControlling( pCtx,
+                                                                  0x932FF9B151263B36 ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that messages built from a checkpoint or a fork are the
+ * same as messages serialized from the start.
+ */
+void test_StunSerializer_Checkpoint_Pass( void )
+{
+    StunContext_t ctx = { 0 }, forkCtx = { 0 }, expectedCtx = { 0 };
+    StunSerializerCheckpoint_t checkpoint;
+    StunIntegrityKey_t integrityKey;
+    uint8_t stunMessage[ 128 ], forkStunMessage[ 128 ], expectedStunMessage[ 128 ];
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] = { 0 };
+    size_t stunMessageLength, expectedStunMessageLength;
+    const uint8_t password[] = "VOkJxbRl1RmTxUk/WvJxBt";
+    uint8_t i;
+
+    ( void ) StunIntegrity_InitKey( &( integrityKey ),
+                                    &( password[ 0 ] ),
+                                    sizeof( password ) - 1,
+                                    NULL );
+
+    SerializeIceCheckPrefix( &( ctx ),
+                             &( stunMessage[ 0 ] ),
+                             sizeof( stunMessage ),
+                             &( transactionId[ 0 ] ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_Checkpoint( &( ctx ),
+                                                  &( checkpoint ) ) );
+
+    for( i = 0; i < 4; i++ )
+    {
+        transactionId[ 0 ] = i;
+        SerializeIceCheckPrefix( &( expectedCtx ),
+                                 &( expectedStunMessage[ 0 ] ),
+                                 sizeof( expectedStunMessage ),
+                                 &( transactionId[ 0 ] ) );
+        AddIceCheckTail( &( expectedCtx ),
+                         &( integrityKey ),
+                         0x6E0001FFU + i,
+                         i % 2,
+                         &( expectedStunMessageLength ) );
+
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunSerializer_Restore( &( ctx ),
+                                                   &( checkpoint ) ) );
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunSerializer_SetTransactionId( &( ctx ),
+                                                            &( transactionId[ 0 ] ) ) );
+        AddIceCheckTail( &( ctx ),
+                         &( integrityKey ),
+                         0x6E0001FFU + i,
+                         i % 2,
+                         &( stunMessageLength ) );
+
+        TEST_ASSERT_EQUAL( expectedStunMessageLength,
+                           stunMessageLength );
+        TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedStunMessage[ 0 ] ),
+                                       &( stunMessage[ 0 ] ),
+                                       expectedStunMessageLength );
+
+        /* The checkpoint can also be forked into another buffer. */
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunSerializer_Restore( &( ctx ),
+                                                   &( checkpoint ) ) );
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunSerializer_Fork( &( ctx ),
+                                                &( forkCtx ),
+                                                &( forkStunMessage[ 0 ] ),
+                                                sizeof( forkStunMessage ) ) );
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunSerializer_SetTransactionId( &( forkCtx ),
+                                                            &( transactionId[ 0 ] ) ) );
+        AddIceCheckTail( &( forkCtx ),
+                         &( integrityKey ),
+                         0x6E0001FFU + i,
+                         i % 2,
+                         &( stunMessageLength ) );
+
+        TEST_ASSERT_EQUAL( expectedStunMessageLength,
+                           stunMessageLength );
+        TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedStunMessage[ 0 ] ),
+                                       &( forkStunMessage[ 0 ] ),
+                                       expectedStunMessageLength );
+    }
+
+    /* Forking leaves the original context unchanged. */
+    TEST_ASSERT_EQUAL( checkpoint.ctx.currentIndex,
+                       ctx.currentIndex );
+    TEST_ASSERT_EQUAL_PTR( &( stunMessage[ 0 ] ),
+                           ctx.pStart );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunSerializer_SetTransactionId when only the message length
+ * is calculated.
+ */
+void test_StunSerializer_SetTransactionId_NullBuffer( void )
+{
+    StunContext_t ctx = { 0 };
+    StunSerializerHashStream_t hashStream;
+    StunHeader_t header = { 0 };
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] = { 0 };
+
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_REQUEST;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_Init( &( ctx ),
+                                            NULL,
+                                            0,
+                                            &( header ) ) );
+
+    ctx.pHashStream = &( hashStream );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_SetTransactionId( &( ctx ),
+                                                        &( transactionId[ 0 ] ) ) );
+    TEST_ASSERT_NULL( ctx.pHashStream );
+    TEST_ASSERT_EQUAL( STUN_HEADER_LENGTH,
+                       ctx.currentIndex );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate checkpoint, restore, fork and transaction ID functions with
+ * bad parameters.
+ */
+void test_StunSerializer_Checkpoint_BadParams( void )
+{
+    StunContext_t ctx = { 0 }, otherCtx = { 0 }, forkCtx = { 0 };
+    StunSerializerCheckpoint_t checkpoint;
+    uint8_t stunMessage[ 128 ], otherStunMessage[ 128 ], forkStunMessage[ 128 ];
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] = { 0 };
+
+    /* Not initialized. */
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_Checkpoint( &( ctx ),
+                                                  &( checkpoint ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_SetTransactionId( &( ctx ),
+                                                        &( transactionId[ 0 ] ) ) );
+    ctx.pStart = &( stunMessage[ 0 ] );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_Fork( &( ctx ),
+                                            &( forkCtx ),
+                                            &( forkStunMessage[ 0 ] ),
+                                            sizeof( forkStunMessage ) ) );
+
+    SerializeIceCheckPrefix( &( ctx ),
+                             &( stunMessage[ 0 ] ),
+                             sizeof( stunMessage ),
+                             &( transactionId[ 0 ] ) );
+    SerializeIceCheckPrefix( &( otherCtx ),
+                             &( otherStunMessage[ 0 ] ),
+                             sizeof( otherStunMessage ),
+                             &( transactionId[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_Checkpoint( NULL,
+                                                  &( checkpoint ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_Checkpoint( &( ctx ),
+                                                  NULL ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_Checkpoint( &( ctx ),
+                                                  &( checkpoint ) ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_Restore( NULL,
+                                               &( checkpoint ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_Restore( &( ctx ),
+                                               NULL ) );
+    /* Another buffer. */
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_Restore( &( otherCtx ),
+                                               &( checkpoint ) ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_Fork( NULL,
+                                            &( forkCtx ),
+                                            &( forkStunMessage[ 0 ] ),
+                                            sizeof( forkStunMessage ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_Fork( &( ctx ),
+                                            NULL,
+                                            &( forkStunMessage[ 0 ] ),
+                                            sizeof( forkStunMessage ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_Fork( &( ctx ),
+                                            &( forkCtx ),
+                                            NULL,
+                                            sizeof( forkStunMessage ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OUT_OF_MEMORY,
+                       StunSerializer_Fork( &( ctx ),
+                                            &( forkCtx ),
+                                            &( forkStunMessage[ 0 ] ),
+                                            ctx.currentIndex - 1 ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_SetTransactionId( NULL,
+                                                        &( transactionId[ 0 ] ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_SetTransactionId( &( ctx ),
+                                                        NULL ) );
+
+    /* Re-initialized since the checkpoint. */
+    SerializeIceCheckPrefix( &( ctx ),
+                             &( stunMessage[ 0 ] ),
+                             sizeof( stunMessage ),
+                             &( transactionId[ 0 ] ) );
+    ctx.currentIndex = STUN_HEADER_LENGTH;
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_Restore( &( ctx ),
+                                               &( checkpoint ) ) );
+
+    /* Only the length is calculated, so there is nothing to fork. */
+    ctx.pStart = NULL;
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_Fork( &( ctx ),
+                                            &( forkCtx ),
+                                            &( forkStunMessage[ 0 ] ),
+                                            sizeof( forkStunMessage ) ) );
+}
+
+/**
+ * @brief Validate that StunSerializer_WriteTrailer writes the same
+ * MESSAGE-INTEGRITY and FINGERPRINT as the serializer, and either of them
+ * alone.
+ */
+void test_StunSerializer_WriteTrailer_Pass( void )
+{
+    uint8_t data[ 100 ];
+    uint8_t expectedStunMessage[ 200 ], stunMessage[ 200 ];
+    StunIntegrityKey_t integrityKey;
+    size_t expectedStunMessageLength, attributesLength, stunMessageLength, i;
+    const uint8_t password[] = "VOkJxbRl1RmTxUk/WvJxBt";
+    uint32_t crc32Fingerprint;
+
+    for( i = 0; i < sizeof( data ); i++ )
+    {
+        data[ i ] = ( uint8_t ) i;
+    }
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunIntegrity_InitKey( &( integrityKey ),
+                                              &( password[ 0 ] ),
+                                              sizeof( password ) - 1,
+                                              NULL ) );
+
+    expectedStunMessageLength = SerializeSignedMessage( &( expectedStunMessage[ 0 ] ),
+                                                        sizeof( expectedStunMessage ),
+                                                        &( data[ 0 ] ),
+                                                        sizeof( data ),
+                                                        0 );
+    attributesLength = expectedStunMessageLength - 32;
+
+    /* MESSAGE-INTEGRITY and FINGERPRINT. */
+    memset( &( stunMessage[ 0 ] ), 0, sizeof( stunMessage ) );
+    memcpy( &( stunMessage[ 0 ] ), &( expectedStunMessage[ 0 ] ), attributesLength );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_WriteTrailer( &( stunMessage[ 0 ] ),
+                                                    attributesLength,
+                                                    &( integrityKey ),
+                                                    1,
+                                                    &( stunMessageLength ) ) );
+    TEST_ASSERT_EQUAL( expectedStunMessageLength,
+                       stunMessageLength );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedStunMessage[ 0 ] ),
+                                   &( stunMessage[ 0 ] ),
+                                   expectedStunMessageLength );
+
+    /* MESSAGE-INTEGRITY only, the HMAC covers the same header. */
+    memset( &( stunMessage[ 0 ] ), 0, sizeof( stunMessage ) );
+    memcpy( &( stunMessage[ 0 ] ), &( expectedStunMessage[ 0 ] ), attributesLength );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_WriteTrailer( &( stunMessage[ 0 ] ),
+                                                    attributesLength,
+                                                    &( integrityKey ),
+                                                    0,
+                                                    &( stunMessageLength ) ) );
+    TEST_ASSERT_EQUAL( expectedStunMessageLength - 8,
+                       stunMessageLength );
+    TEST_ASSERT_EQUAL( 0, stunMessage[ STUN_HEADER_MESSAGE_LENGTH_OFFSET ] );
+    TEST_ASSERT_EQUAL( stunMessageLength - STUN_HEADER_LENGTH,
+                       stunMessage[ STUN_HEADER_MESSAGE_LENGTH_OFFSET + 1 ] );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedStunMessage[ STUN_HEADER_MAGIC_COOKIE_OFFSET ] ),
+                                   &( stunMessage[ STUN_HEADER_MAGIC_COOKIE_OFFSET ] ),
+                                   stunMessageLength - STUN_HEADER_MAGIC_COOKIE_OFFSET );
+    TEST_ASSERT_EQUAL( 0, stunMessage[ stunMessageLength ] );
+
+    /* FINGERPRINT only. */
+    memset( &( stunMessage[ 0 ] ), 0, sizeof( stunMessage ) );
+    memcpy( &( stunMessage[ 0 ] ), &( expectedStunMessage[ 0 ] ), attributesLength );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_WriteTrailer( &( stunMessage[ 0 ] ),
+                                                    attributesLength,
+                                                    NULL,
+                                                    1,
+                                                    &( stunMessageLength ) ) );
+    TEST_ASSERT_EQUAL( attributesLength + 8,
+                       stunMessageLength );
+    TEST_ASSERT_EQUAL( stunMessageLength - STUN_HEADER_LENGTH,
+                       stunMessage[ STUN_HEADER_MESSAGE_LENGTH_OFFSET + 1 ] );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( expectedStunMessage[ expectedStunMessageLength - 8 ] ),
+                                   &( stunMessage[ attributesLength ] ),
+                                   4 );
+
+    crc32Fingerprint = Stun_Crc32( 0,
+                                   &( stunMessage[ 0 ] ),
+                                   attributesLength ) ^ STUN_ATTRIBUTE_FINGERPRINT_XOR_VALUE;
+    TEST_ASSERT_EQUAL( ( uint8_t ) ( crc32Fingerprint >> 24 ),
+                       stunMessage[ attributesLength + 4 ] );
+    TEST_ASSERT_EQUAL( ( uint8_t ) crc32Fingerprint,
+                       stunMessage[ attributesLength + 7 ] );
+
+    /* Neither, only the length in the header is written. */
+    memset( &( stunMessage[ 0 ] ), 0, sizeof( stunMessage ) );
+    memcpy( &( stunMessage[ 0 ] ), &( expectedStunMessage[ 0 ] ), attributesLength );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunSerializer_WriteTrailer( &( stunMessage[ 0 ] ),
+                                                    attributesLength,
+                                                    NULL,
+                                                    0,
+                                                    &( stunMessageLength ) ) );
+    TEST_ASSERT_EQUAL( attributesLength,
+                       stunMessageLength );
+    TEST_ASSERT_EQUAL( attributesLength - STUN_HEADER_LENGTH,
+                       stunMessage[ STUN_HEADER_MESSAGE_LENGTH_OFFSET + 1 ] );
+    TEST_ASSERT_EQUAL( 0, stunMessage[ attributesLength ] );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunSerializer_WriteTrailer with bad parameters.
+ */
+void test_StunSerializer_WriteTrailer_BadParams( void )
+{
+    size_t stunMessageLength;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_WriteTrailer( NULL,
+                                                    STUN_HEADER_LENGTH,
+                                                    NULL,
+                                                    1,
+                                                    &( stunMessageLength ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_WriteTrailer( pStunMessageBuffer,
+                                                    STUN_HEADER_LENGTH,
+                                                    NULL,
+                                                    1,
+                                                    NULL ) );
+
+    /* Shorter than the header. */
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_WriteTrailer( pStunMessageBuffer,
+                                                    STUN_HEADER_LENGTH - 1,
+                                                    NULL,
+                                                    1,
+                                                    &( stunMessageLength ) ) );
+
+    /* No room for the trailer in the 16-bit message length. */
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunSerializer_WriteTrailer( pStunMessageBuffer,
+                                                    STUN_HEADER_LENGTH + STUN_MAX_MESSAGE_LENGTH - 31,
+                                                    NULL,
+                                                    1,
+                                                    &( stunMessageLength ) ) );
+}
+
+/*-----------------------------------------------------------*/
@@ -0,0 +1,494 @@
+/* Unity includes. */
+#include "unity.h"
+#include "catch_assert.h"
+
+/* Standard includes. */
+#include <string.h>
+#include <stdint.h>
+
+/* API includes. */
+#include "stun_stream_parser.h"
+
+/* ===========================  EXTERN VARIABLES  =========================== */
+
+#define PARSER_BUFFER_LENGTH    128
+
+static uint8_t parserBuffer[ PARSER_BUFFER_LENGTH ];
+static StunStreamParser_t parser;
+
+/* Binding request with a PRIORITY attribute. */
+static const uint8_t bindingRequest[] =
+{
+    /* Message Type = STUN Binding Request, Message Length = 8. */
+    0x00, 0x01, 0x00, 0x08,
+    /* Magic cookie. */
+    0x21, 0x12, 0xA4, 0x42,
+    /* Transaction ID. */
+    0xB7, 0xE7, 0xA7, 0x01, 0xBC, 0x34, 0xD6, 0x86, 0xFA, 0x87, 0xDF, 0xAE,
+    /* Attribute Type = PRIORITY, Attribute Length = 4. */
+    0x00, 0x24, 0x00, 0x04,
+    0x6E, 0x00, 0x01, 0xFF
+};
+
+/* ChannelData message on channel 0x4001 with 5 bytes of data. */
+static const uint8_t channelData[] =
+{
+    0x40, 0x01, 0x00, 0x05,
+    0x01, 0x02, 0x03, 0x04, 0x05
+};
+
+void setUp( void )
+{
+    memset( &( parserBuffer[ 0 ] ), 0, sizeof( parserBuffer ) );
+}
+
+void tearDown( void )
+{
+}
+
+/* ==============================  Test Cases ============================== */
+
+/**
+ * @brief Validate that STUN and padded ChannelData messages are split out of a
+ * stream fed one byte at a time.
+ */
+void test_StunStreamParser_StunFraming_ByteByByte( void )
+{
+    uint8_t stream[ 96 ];
+    size_t streamLength = 0, i, consumedLength;
+    StunStreamFrame_t frame;
+    int frameCount = 0;
+
+    /* STUN message, ChannelData padded to 12 bytes, STUN message. */
+    memcpy( &( stream[ streamLength ] ), &( bindingRequest[ 0 ] ), sizeof( bindingRequest ) );
+    streamLength += sizeof( bindingRequest );
+    memcpy( &( stream[ streamLength ] ), &( channelData[ 0 ] ), sizeof( channelData ) );
+    streamLength += sizeof( channelData );
+    memset( &( stream[ streamLength ] ), 0, 3 );
+    streamLength += 3;
+    memcpy( &( stream[ streamLength ] ), &( bindingRequest[ 0 ] ), sizeof( bindingRequest ) );
+    streamLength += sizeof( bindingRequest );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_Init( &( parser ),
+                                              &( parserBuffer[ 0 ] ),
+                                              PARSER_BUFFER_LENGTH,
+                                              STUN_STREAM_FRAMING_STUN ) );
+
+    for( i = 0; i < streamLength; i++ )
+    {
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunStreamParser_Feed( &( parser ), &( stream[ i ] ), 1, &( consumedLength ) ) );
+        TEST_ASSERT_EQUAL( 1, consumedLength );
+
+        if( StunStreamParser_GetNextFrame( &( parser ), &( frame ) ) == STUN_RESULT_OK )
+        {
+            if( frameCount == 1 )
+            {
+                TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_CHANNEL_DATA, frame.packetType );
+                TEST_ASSERT_EQUAL( sizeof( channelData ), frame.frameLength );
+                TEST_ASSERT_EQUAL_UINT8_ARRAY( &( channelData[ 0 ] ), frame.pFrame, sizeof( channelData ) );
+                /* The padding is consumed with the frame. */
+                TEST_ASSERT_EQUAL( 28 + 12 - 1, i );
+            }
+            else
+            {
+                TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_STUN, frame.packetType );
+                TEST_ASSERT_EQUAL( sizeof( bindingRequest ), frame.frameLength );
+                TEST_ASSERT_EQUAL_UINT8_ARRAY( &( bindingRequest[ 0 ] ), frame.pFrame, sizeof( bindingRequest ) );
+            }
+
+            frameCount++;
+        }
+    }
+
+    TEST_ASSERT_EQUAL( 3, frameCount );
+    TEST_ASSERT_EQUAL( STUN_RESULT_NEED_MORE_DATA,
+                       StunStreamParser_GetNextFrame( &( parser ), &( frame ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that RFC 4571 frames received into the write buffer are
+ * returned in place and classified.
+ */
+void test_StunStreamParser_Rfc4571Framing_WriteBuffer( void )
+{
+    uint8_t stream[ 96 ];
+    size_t streamLength = 0, chunkLength, offset = 0;
+    uint8_t * pWriteBuffer = NULL;
+    size_t writeBufferLength = 0;
+    StunStreamFrame_t frame;
+    const uint8_t rtp[] = { 0x80, 0x60, 0x00, 0x01 };
+
+    /* STUN message, RTP packet and an empty frame. */
+    stream[ streamLength++ ] = 0x00;
+    stream[ streamLength++ ] = sizeof( bindingRequest );
+    memcpy( &( stream[ streamLength ] ), &( bindingRequest[ 0 ] ), sizeof( bindingRequest ) );
+    streamLength += sizeof( bindingRequest );
+    stream[ streamLength++ ] = 0x00;
+    stream[ streamLength++ ] = sizeof( rtp );
+    memcpy( &( stream[ streamLength ] ), &( rtp[ 0 ] ), sizeof( rtp ) );
+    streamLength += sizeof( rtp );
+    stream[ streamLength++ ] = 0x00;
+    stream[ streamLength++ ] = 0x00;
+
+    /* The buffer is only large enough for the STUN message and the start of
+     * the next frame, so the parser has to move the partial frame. */
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_Init( &( parser ),
+                                              &( parserBuffer[ 0 ] ),
+                                              sizeof( bindingRequest ) + 4,
+                                              STUN_STREAM_FRAMING_RFC4571 ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_GetWriteBuffer( &( parser ), &( pWriteBuffer ), &( writeBufferLength ) ) );
+    TEST_ASSERT_EQUAL_PTR( &( parserBuffer[ 0 ] ), pWriteBuffer );
+    TEST_ASSERT_EQUAL( sizeof( bindingRequest ) + 4, writeBufferLength );
+
+    /* Receive the STUN message and 2 bytes of the RTP frame. */
+    chunkLength = writeBufferLength;
+    memcpy( pWriteBuffer, &( stream[ offset ] ), chunkLength );
+    offset += chunkLength;
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_CommitWrite( &( parser ), chunkLength ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_GetNextFrame( &( parser ), &( frame ) ) );
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_STUN, frame.packetType );
+    TEST_ASSERT_EQUAL_PTR( &( parserBuffer[ 2 ] ), frame.pFrame );
+    TEST_ASSERT_EQUAL( sizeof( bindingRequest ), frame.frameLength );
+    TEST_ASSERT_EQUAL( STUN_RESULT_NEED_MORE_DATA,
+                       StunStreamParser_GetNextFrame( &( parser ), &( frame ) ) );
+
+    /* Receive the rest. */
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_GetWriteBuffer( &( parser ), &( pWriteBuffer ), &( writeBufferLength ) ) );
+    TEST_ASSERT_EQUAL_PTR( &( parserBuffer[ 2 ] ), pWriteBuffer );
+    chunkLength = streamLength - offset;
+    memcpy( pWriteBuffer, &( stream[ offset ] ), chunkLength );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_CommitWrite( &( parser ), chunkLength ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_GetNextFrame( &( parser ), &( frame ) ) );
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_RTP, frame.packetType );
+    TEST_ASSERT_EQUAL( sizeof( rtp ), frame.frameLength );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( &( rtp[ 0 ] ), frame.pFrame, sizeof( rtp ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_GetNextFrame( &( parser ), &( frame ) ) );
+    TEST_ASSERT_EQUAL( STUN_PACKET_TYPE_UNKNOWN, frame.packetType );
+    TEST_ASSERT_EQUAL( 0, frame.frameLength );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_NEED_MORE_DATA,
+                       StunStreamParser_GetNextFrame( &( parser ), &( frame ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that a first byte below the ChannelData range is rejected.
+ */
+void test_StunStreamParser_GetNextFrame_DtlsFirstByte( void )
+{
+    StunStreamFrame_t frame;
+    size_t consumedLength;
+    const uint8_t data[] = { 0x16, 0xFE, 0xFD, 0x00 };
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_Init( &( parser ), &( parserBuffer[ 0 ] ), 32, STUN_STREAM_FRAMING_STUN ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_Feed( &( parser ), &( data[ 0 ] ), sizeof( data ), &( consumedLength ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_FRAME,
+                       StunStreamParser_GetNextFrame( &( parser ), &( frame ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that a first byte above the ChannelData range is rejected.
+ */
+void test_StunStreamParser_GetNextFrame_RtpFirstByte( void )
+{
+    StunStreamFrame_t frame;
+    size_t consumedLength;
+    const uint8_t data[] = { 0x80, 0x60, 0x00, 0x01 };
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_Init( &( parser ), &( parserBuffer[ 0 ] ), 32, STUN_STREAM_FRAMING_STUN ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_Feed( &( parser ), &( data[ 0 ] ), sizeof( data ), &( consumedLength ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_FRAME,
+                       StunStreamParser_GetNextFrame( &( parser ), &( frame ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that a wrong magic cookie is rejected.
+ */
+void test_StunStreamParser_GetNextFrame_MagicCookieMismatch( void )
+{
+    StunStreamFrame_t frame;
+    size_t consumedLength;
+    uint8_t data[ 8 ];
+
+    memcpy( &( data[ 0 ] ), &( bindingRequest[ 0 ] ), sizeof( data ) );
+    data[ 7 ] = 0x43;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_Init( &( parser ), &( parserBuffer[ 0 ] ), 32, STUN_STREAM_FRAMING_STUN ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_Feed( &( parser ), &( data[ 0 ] ), sizeof( data ), &( consumedLength ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_MAGIC_COOKIE_MISMATCH,
+                       StunStreamParser_GetNextFrame( &( parser ), &( frame ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that a wrong magic cookie is rejected when it is received
+ * after the first 4 bytes of the header.
+ */
+void test_StunStreamParser_GetNextFrame_MagicCookieMismatchAfterLength( void )
+{
+    StunStreamFrame_t frame;
+    size_t consumedLength;
+    uint8_t data[ 8 ];
+
+    memcpy( &( data[ 0 ] ), &( bindingRequest[ 0 ] ), sizeof( data ) );
+    data[ 4 ] = 0x12;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_Init( &( parser ), &( parserBuffer[ 0 ] ), 32, STUN_STREAM_FRAMING_STUN ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_Feed( &( parser ), &( data[ 0 ] ), 4, &( consumedLength ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_NEED_MORE_DATA,
+                       StunStreamParser_GetNextFrame( &( parser ), &( frame ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_Feed( &( parser ), &( data[ 4 ] ), 4, &( consumedLength ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_MAGIC_COOKIE_MISMATCH,
+                       StunStreamParser_GetNextFrame( &( parser ), &( frame ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that a STUN message length that is not a multiple of 4 is
+ * rejected.
+ */
+void test_StunStreamParser_GetNextFrame_InvalidMessageLength( void )
+{
+    StunStreamFrame_t frame;
+    size_t consumedLength;
+    const uint8_t data[] = { 0x00, 0x01, 0x00, 0x06 };
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_Init( &( parser ), &( parserBuffer[ 0 ] ), 32, STUN_STREAM_FRAMING_STUN ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_Feed( &( parser ), &( data[ 0 ] ), sizeof( data ), &( consumedLength ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_INVALID_MESSAGE_LENGTH,
+                       StunStreamParser_GetNextFrame( &( parser ), &( frame ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that a STUN message larger than the buffer is rejected.
+ */
+void test_StunStreamParser_GetNextFrame_StunFrameTooLarge( void )
+{
+    StunStreamFrame_t frame;
+    size_t consumedLength;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_Init( &( parser ), &( parserBuffer[ 0 ] ), 32, STUN_STREAM_FRAMING_STUN ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_Feed( &( parser ), &( bindingRequest[ 0 ] ), 8, &( consumedLength ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_NEED_MORE_DATA,
+                       StunStreamParser_GetNextFrame( &( parser ), &( frame ) ) );
+
+    /* Message length 16, 36 bytes with the header. */
+    parserBuffer[ 3 ] = 0x10;
+    TEST_ASSERT_EQUAL( STUN_RESULT_OUT_OF_MEMORY,
+                       StunStreamParser_GetNextFrame( &( parser ), &( frame ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that a ChannelData message that only fits in the buffer
+ * without its padding is rejected.
+ */
+void test_StunStreamParser_GetNextFrame_ChannelDataPaddingTooLarge( void )
+{
+    StunStreamFrame_t frame;
+    size_t consumedLength;
+    /* 25 bytes of data, 29 bytes without and 32 bytes with the padding. */
+    const uint8_t data[] = { 0x40, 0x01, 0x00, 0x19 };
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_Init( &( parser ), &( parserBuffer[ 0 ] ), 30, STUN_STREAM_FRAMING_STUN ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_Feed( &( parser ), &( data[ 0 ] ), sizeof( data ), &( consumedLength ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OUT_OF_MEMORY,
+                       StunStreamParser_GetNextFrame( &( parser ), &( frame ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that Feed only consumes as much data as fits in the buffer.
+ */
+void test_StunStreamParser_Feed_PartialConsume( void )
+{
+    StunStreamFrame_t frame;
+    uint8_t data[ 40 ] = { 0 };
+    size_t consumedLength;
+
+    memcpy( &( data[ 0 ] ), &( bindingRequest[ 0 ] ), sizeof( bindingRequest ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_Init( &( parser ), &( parserBuffer[ 0 ] ), 32, STUN_STREAM_FRAMING_STUN ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_Feed( &( parser ), &( data[ 0 ] ), sizeof( data ), &( consumedLength ) ) );
+    TEST_ASSERT_EQUAL( 32, consumedLength );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_GetNextFrame( &( parser ), &( frame ) ) );
+    TEST_ASSERT_EQUAL( sizeof( bindingRequest ), frame.frameLength );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that GetWriteBuffer fails when the buffer is full.
+ */
+void test_StunStreamParser_GetWriteBuffer_BufferFull( void )
+{
+    uint8_t * pWriteBuffer = NULL;
+    size_t writeBufferLength;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_Init( &( parser ), &( parserBuffer[ 0 ] ), 32, STUN_STREAM_FRAMING_RFC4571 ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_CommitWrite( &( parser ), 32 ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OUT_OF_MEMORY,
+                       StunStreamParser_GetWriteBuffer( &( parser ), &( pWriteBuffer ), &( writeBufferLength ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that Feed fails when the buffer is full.
+ */
+void test_StunStreamParser_Feed_BufferFull( void )
+{
+    const uint8_t data[ 1 ] = { 0 };
+    size_t consumedLength;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_Init( &( parser ), &( parserBuffer[ 0 ] ), 32, STUN_STREAM_FRAMING_RFC4571 ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_CommitWrite( &( parser ), 32 ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OUT_OF_MEMORY,
+                       StunStreamParser_Feed( &( parser ), &( data[ 0 ] ), sizeof( data ), &( consumedLength ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunStreamParser_Init with bad parameters.
+ */
+void test_StunStreamParser_Init_BadParams( void )
+{
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunStreamParser_Init( NULL, &( parserBuffer[ 0 ] ), PARSER_BUFFER_LENGTH, STUN_STREAM_FRAMING_STUN ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunStreamParser_Init( &( parser ), NULL, PARSER_BUFFER_LENGTH, STUN_STREAM_FRAMING_STUN ) );
+    /* Smaller than a STUN header. */
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunStreamParser_Init( &( parser ), &( parserBuffer[ 0 ] ), STUN_HEADER_LENGTH - 1, STUN_STREAM_FRAMING_STUN ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunStreamParser_Init( &( parser ), &( parserBuffer[ 0 ] ), PARSER_BUFFER_LENGTH, ( StunStreamFraming_t ) 2 ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunStreamParser_GetWriteBuffer with bad parameters.
+ */
+void test_StunStreamParser_GetWriteBuffer_BadParams( void )
+{
+    uint8_t * pWriteBuffer = NULL;
+    size_t length;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_Init( &( parser ), &( parserBuffer[ 0 ] ), PARSER_BUFFER_LENGTH, STUN_STREAM_FRAMING_STUN ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunStreamParser_GetWriteBuffer( NULL, &( pWriteBuffer ), &( length ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunStreamParser_GetWriteBuffer( &( parser ), NULL, &( length ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunStreamParser_GetWriteBuffer( &( parser ), &( pWriteBuffer ), NULL ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunStreamParser_CommitWrite with bad parameters.
+ */
+void test_StunStreamParser_CommitWrite_BadParams( void )
+{
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_Init( &( parser ), &( parserBuffer[ 0 ] ), PARSER_BUFFER_LENGTH, STUN_STREAM_FRAMING_STUN ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunStreamParser_CommitWrite( NULL, 1 ) );
+    /* More than the free space. */
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunStreamParser_CommitWrite( &( parser ), PARSER_BUFFER_LENGTH + 1 ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunStreamParser_Feed with bad parameters.
+ */
+void test_StunStreamParser_Feed_BadParams( void )
+{
+    size_t length;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_Init( &( parser ), &( parserBuffer[ 0 ] ), PARSER_BUFFER_LENGTH, STUN_STREAM_FRAMING_STUN ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunStreamParser_Feed( NULL, &( bindingRequest[ 0 ] ), 1, &( length ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunStreamParser_Feed( &( parser ), NULL, 1, &( length ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunStreamParser_Feed( &( parser ), &( bindingRequest[ 0 ] ), 1, NULL ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunStreamParser_GetNextFrame with bad parameters.
+ */
+void test_StunStreamParser_GetNextFrame_BadParams( void )
+{
+    StunStreamFrame_t frame;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunStreamParser_Init( &( parser ), &( parserBuffer[ 0 ] ), PARSER_BUFFER_LENGTH, STUN_STREAM_FRAMING_STUN ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunStreamParser_GetNextFrame( NULL, &( frame ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunStreamParser_GetNextFrame( &( parser ), NULL ) );
+}
+
+/*-----------------------------------------------------------*/
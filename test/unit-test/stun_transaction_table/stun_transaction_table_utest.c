@@ -0,0 +1,1060 @@
+/* Unity includes. */
+#include "unity.h"
+#include "catch_assert.h"
+
+/* Standard includes. */
+#include <string.h>
+#include <stdint.h>
+
+/* API includes. */
+#include "stun_transaction_table.h"
+
+/* ===========================  EXTERN VARIABLES  =========================== */
+
+#define TABLE_CAPACITY  64
+#define TABLE_GROUPS    ( TABLE_CAPACITY / STUN_TRANSACTION_TABLE_GROUP_LENGTH )
+#define TABLE_SEED      0x0123456789ABCDEFULL
+
+/* Table kept half full while many more transactions than its capacity are
+ * inserted and removed. */
+#define CHURN_TABLE_CAPACITY    2048
+#define CHURN_TABLE_GROUPS      ( CHURN_TABLE_CAPACITY / STUN_TRANSACTION_TABLE_GROUP_LENGTH )
+#define CHURN_OUTSTANDING       1024U
+#define CHURN_TRANSACTIONS      100000U
+
+/* Number of candidates tried when looking for transaction IDs that hash
+ * alike. */
+#define MAX_CANDIDATES  100000U
+
+static uint8_t tags[ TABLE_CAPACITY ];
+static StunTransactionSlot_t slots[ TABLE_CAPACITY ];
+static uint32_t overflowCounts[ TABLE_GROUPS ];
+static StunTransactionTable_t table;
+
+/* Empty table used to find the group and tag of a transaction ID. */
+static uint8_t scratchTags[ TABLE_CAPACITY ];
+static StunTransactionSlot_t scratchSlots[ TABLE_CAPACITY ];
+static uint32_t scratchOverflowCounts[ TABLE_GROUPS ];
+
+static uint8_t churnTags[ CHURN_TABLE_CAPACITY ];
+static StunTransactionSlot_t churnSlots[ CHURN_TABLE_CAPACITY ];
+static uint32_t churnOverflowCounts[ CHURN_TABLE_GROUPS ];
+
+/* The hook runs hookAction on its hookCallNumber-th call, in place of another
+ * thread. */
+static size_t hookCallCount;
+static size_t hookCallNumber;
+static void ( * hookAction )( void );
+static size_t hookSlotIndex;
+static uint8_t hookTransactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ];
+
+static void FillTransactionId( uint8_t * pTransactionId,
+                               uint32_t value )
+{
+    size_t i;
+
+    for( i = 0; i < STUN_HEADER_TRANSACTION_ID_LENGTH; i++ )
+    {
+        pTransactionId[ i ] = ( uint8_t ) ( ( value >> ( 8 * ( i % 4 ) ) ) ^ ( i * 0x5B ) );
+    }
+}
+
+/* Returns the index of the first slot of the group the transaction ID hashes
+ * to, and its tag in pTag. */
+static size_t GetHomeSlot( const uint8_t * pTransactionId,
+                           uint8_t * pTag )
+{
+    StunTransactionTable_t scratchTable;
+    size_t i, slotIndex = TABLE_CAPACITY;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Init( &( scratchTable ),
+                                                  &( scratchTags[ 0 ] ),
+                                                  &( scratchSlots[ 0 ] ),
+                                                  &( scratchOverflowCounts[ 0 ] ),
+                                                  TABLE_CAPACITY,
+                                                  TABLE_SEED ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Insert( &( scratchTable ), pTransactionId, NULL ) );
+
+    /* The first slot of the group is taken in an empty table. */
+    for( i = 0; i < TABLE_CAPACITY; i++ )
+    {
+        if( scratchTags[ i ] != 0U )
+        {
+            slotIndex = i;
+            *pTag = scratchTags[ i ];
+        }
+    }
+
+    TEST_ASSERT_EQUAL( 0, slotIndex % STUN_TRANSACTION_TABLE_GROUP_LENGTH );
+
+    return slotIndex;
+}
+
+/* Finds a transaction ID with the same group and tag as pTransactionId that
+ * differs only in the given byte, which is changed in pOtherTransactionId. */
+static void FindTagCollision( const uint8_t * pTransactionId,
+                              size_t byteIndex,
+                              uint8_t * pOtherTransactionId )
+{
+    uint8_t tag, otherTag = 0;
+    size_t homeSlot, otherHomeSlot = TABLE_CAPACITY;
+    uint32_t i;
+
+    homeSlot = GetHomeSlot( pTransactionId, &( tag ) );
+    ( void ) memcpy( pOtherTransactionId, pTransactionId, STUN_HEADER_TRANSACTION_ID_LENGTH );
+
+    for( i = 1; ( i < 256U ) && ( ( otherHomeSlot != homeSlot ) || ( otherTag != tag ) ); i++ )
+    {
+        pOtherTransactionId[ byteIndex ] = ( uint8_t ) ( pTransactionId[ byteIndex ] ^ i );
+        otherHomeSlot = GetHomeSlot( pOtherTransactionId, &( otherTag ) );
+    }
+
+    TEST_ASSERT_EQUAL( homeSlot, otherHomeSlot );
+    TEST_ASSERT_EQUAL( tag, otherTag );
+}
+
+/* Finds the next transaction ID, from *pValue, whose first probed slot is
+ * homeSlot. */
+static void FindTransactionIdInGroup( size_t homeSlot,
+                                      uint32_t * pValue,
+                                      uint8_t * pTransactionId )
+{
+    uint8_t tag;
+    uint32_t last = *pValue + MAX_CANDIDATES;
+
+    do
+    {
+        FillTransactionId( pTransactionId, *pValue );
+        ( *pValue )++;
+    } while( ( GetHomeSlot( pTransactionId, &( tag ) ) != homeSlot ) && ( *pValue < last ) );
+
+    TEST_ASSERT_TRUE( *pValue < last );
+}
+
+/* Returns the largest number of groups probed by the lookup of a missing
+ * transaction ID, over all the groups it can start from. */
+static size_t GetLongestMissProbe( const uint32_t * pOverflowCounts,
+                                   size_t groupCount )
+{
+    size_t firstGroup, group, probe, longest = 0;
+
+    for( firstGroup = 0; firstGroup < groupCount; firstGroup++ )
+    {
+        group = firstGroup;
+
+        for( probe = 0; ( probe < groupCount ) && ( pOverflowCounts[ group ] != 0U ); probe++ )
+        {
+            group = ( group + probe + 1 ) & ( groupCount - 1 );
+        }
+
+        if( probe + 1 > longest )
+        {
+            longest = probe + 1;
+        }
+    }
+
+    return longest;
+}
+
+static void ArmHook( size_t callNumber,
+                     void ( * action )( void ) )
+{
+    hookCallCount = 0;
+    hookCallNumber = callNumber;
+    hookAction = action;
+}
+
+/* Defined for stun_transaction_table.c, which is built with
+ * STUN_TRANSACTION_TABLE_TEST_HOOK. */
+void StunTransactionTable_TestHook( void )
+{
+    void ( * action )( void ) = hookAction;
+
+    hookCallCount++;
+
+    if( ( action != NULL ) && ( hookCallCount == hookCallNumber ) )
+    {
+        /* The action can call the table, which calls the hook again. */
+        hookAction = NULL;
+        action();
+    }
+}
+
+/* Starts to write the slot, as an insert does, and finishes on the next
+ * call of the hook. */
+static void FinishWrite( void )
+{
+    slots[ hookSlotIndex ].sequence++;
+}
+
+static void StartWrite( void )
+{
+    slots[ hookSlotIndex ].sequence++;
+    hookCallNumber = hookCallCount + 1U;
+    hookAction = FinishWrite;
+}
+
+static void RemoveTransaction( void )
+{
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Remove( &( table ), &( hookTransactionId[ 0 ] ), NULL ) );
+}
+
+static void ReinsertTransaction( void )
+{
+    RemoveTransaction();
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Insert( &( table ), &( hookTransactionId[ 0 ] ), &( hookSlotIndex ) ) );
+}
+
+static void InsertTransaction( void )
+{
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Insert( &( table ), &( hookTransactionId[ 0 ] ), NULL ) );
+}
+
+void setUp( void )
+{
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Init( &( table ),
+                                                  &( tags[ 0 ] ),
+                                                  &( slots[ 0 ] ),
+                                                  &( overflowCounts[ 0 ] ),
+                                                  TABLE_CAPACITY,
+                                                  TABLE_SEED ) );
+    ArmHook( 0, NULL );
+}
+
+void tearDown( void )
+{
+}
+
+/* ==============================  Test Cases ============================== */
+
+/**
+ * @brief Validate that inserted transactions are found with their user data.
+ */
+void test_StunTransactionTable_Lookup_Pass( void )
+{
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ];
+    uint32_t userData[ 32 ];
+    void * pUserData = NULL;
+    uint32_t i;
+
+    for( i = 0; i < 32; i++ )
+    {
+        FillTransactionId( &( transactionId[ 0 ] ), i );
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunTransactionTable_Insert( &( table ), &( transactionId[ 0 ] ), &( userData[ i ] ) ) );
+    }
+
+    for( i = 0; i < 32; i++ )
+    {
+        FillTransactionId( &( transactionId[ 0 ] ), i );
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunTransactionTable_Lookup( &( table ), &( transactionId[ 0 ] ), &( pUserData ) ) );
+        TEST_ASSERT_EQUAL_PTR( &( userData[ i ] ), pUserData );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunTransactionTable_Lookup with a transaction that was
+ * never inserted.
+ */
+void test_StunTransactionTable_Lookup_NotFound( void )
+{
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ];
+    void * pUserData = NULL;
+    uint32_t i;
+
+    for( i = 0; i < 32; i++ )
+    {
+        FillTransactionId( &( transactionId[ 0 ] ), i );
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunTransactionTable_Insert( &( table ), &( transactionId[ 0 ] ), NULL ) );
+    }
+
+    FillTransactionId( &( transactionId[ 0 ] ), 32 );
+    TEST_ASSERT_EQUAL( STUN_RESULT_TRANSACTION_NOT_FOUND,
+                       StunTransactionTable_Lookup( &( table ), &( transactionId[ 0 ] ), &( pUserData ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that a transaction is removed once, with its user data.
+ */
+void test_StunTransactionTable_Remove_Pass( void )
+{
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ];
+    int request = 0;
+    void * pUserData = NULL;
+
+    FillTransactionId( &( transactionId[ 0 ] ), 7 );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Insert( &( table ), &( transactionId[ 0 ] ), &( request ) ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Remove( &( table ), &( transactionId[ 0 ] ), &( pUserData ) ) );
+    TEST_ASSERT_EQUAL_PTR( &( request ), pUserData );
+    TEST_ASSERT_EQUAL( STUN_RESULT_TRANSACTION_NOT_FOUND,
+                       StunTransactionTable_Remove( &( table ), &( transactionId[ 0 ] ), NULL ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_TRANSACTION_NOT_FOUND,
+                       StunTransactionTable_Lookup( &( table ), &( transactionId[ 0 ] ), &( pUserData ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunTransactionTable_Remove without user data output.
+ */
+void test_StunTransactionTable_Remove_NullUserData( void )
+{
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ];
+    void * pUserData = NULL;
+
+    FillTransactionId( &( transactionId[ 0 ] ), 7 );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Insert( &( table ), &( transactionId[ 0 ] ), &( pUserData ) ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Remove( &( table ), &( transactionId[ 0 ] ), NULL ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_TRANSACTION_NOT_FOUND,
+                       StunTransactionTable_Lookup( &( table ), &( transactionId[ 0 ] ), &( pUserData ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that every slot can be used and that insert fails when the
+ * table is full.
+ */
+void test_StunTransactionTable_Insert_OutOfMemory( void )
+{
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ];
+    void * pUserData = NULL;
+    uintptr_t i;
+
+    for( i = 0; i < TABLE_CAPACITY; i++ )
+    {
+        FillTransactionId( &( transactionId[ 0 ] ), ( uint32_t ) i );
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunTransactionTable_Insert( &( table ), &( transactionId[ 0 ] ), ( void * ) ( i + 1 ) ) );
+    }
+
+    FillTransactionId( &( transactionId[ 0 ] ), TABLE_CAPACITY );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OUT_OF_MEMORY,
+                       StunTransactionTable_Insert( &( table ), &( transactionId[ 0 ] ), NULL ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_TRANSACTION_NOT_FOUND,
+                       StunTransactionTable_Lookup( &( table ), &( transactionId[ 0 ] ), &( pUserData ) ) );
+
+    for( i = 0; i < TABLE_CAPACITY; i++ )
+    {
+        FillTransactionId( &( transactionId[ 0 ] ), ( uint32_t ) i );
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunTransactionTable_Lookup( &( table ), &( transactionId[ 0 ] ), &( pUserData ) ) );
+        TEST_ASSERT_EQUAL_PTR( ( void * ) ( i + 1 ), pUserData );
+    }
+
+    /* The failed insert is not counted. */
+    for( i = 0; i < TABLE_CAPACITY; i++ )
+    {
+        FillTransactionId( &( transactionId[ 0 ] ), ( uint32_t ) i );
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunTransactionTable_Remove( &( table ), &( transactionId[ 0 ] ), NULL ) );
+    }
+
+    TEST_ASSERT_EQUAL( 1, GetLongestMissProbe( &( overflowCounts[ 0 ] ), TABLE_GROUPS ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that removed slots are reused and do not hide the
+ * transactions inserted after them.
+ */
+void test_StunTransactionTable_Insert_Churn( void )
+{
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ];
+    void * pUserData = NULL;
+    uintptr_t i;
+
+    /* Keep 48 transactions in the table while inserting and removing many
+     * more than the capacity. */
+    for( i = 0; i < 4096; i++ )
+    {
+        FillTransactionId( &( transactionId[ 0 ] ), ( uint32_t ) i );
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunTransactionTable_Insert( &( table ), &( transactionId[ 0 ] ), ( void * ) ( i + 1 ) ) );
+
+        if( i >= 47 )
+        {
+            FillTransactionId( &( transactionId[ 0 ] ), ( uint32_t ) ( i - 47 ) );
+            TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                               StunTransactionTable_Remove( &( table ), &( transactionId[ 0 ] ), &( pUserData ) ) );
+            TEST_ASSERT_EQUAL_PTR( ( void * ) ( i - 46 ), pUserData );
+        }
+    }
+
+    for( i = 4096 - 47; i < 4096; i++ )
+    {
+        FillTransactionId( &( transactionId[ 0 ] ), ( uint32_t ) i );
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunTransactionTable_Lookup( &( table ), &( transactionId[ 0 ] ), &( pUserData ) ) );
+        TEST_ASSERT_EQUAL_PTR( ( void * ) ( i + 1 ), pUserData );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that removed slots are free again, so that the lookups of
+ * missing transaction IDs stay short in a table kept half full.
+ */
+void test_StunTransactionTable_Remove_ChurnKeepsProbesShort( void )
+{
+    StunTransactionTable_t churnTable;
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ];
+    void * pUserData = NULL;
+    size_t i, emptySlots = 0;
+    uint32_t value;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Init( &( churnTable ),
+                                                  &( churnTags[ 0 ] ),
+                                                  &( churnSlots[ 0 ] ),
+                                                  &( churnOverflowCounts[ 0 ] ),
+                                                  CHURN_TABLE_CAPACITY,
+                                                  TABLE_SEED ) );
+
+    /* Remove the oldest transaction for every new one. */
+    for( value = 0; value < CHURN_TRANSACTIONS; value++ )
+    {
+        FillTransactionId( &( transactionId[ 0 ] ), value );
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunTransactionTable_Insert( &( churnTable ), &( transactionId[ 0 ] ), NULL ) );
+
+        if( value >= CHURN_OUTSTANDING )
+        {
+            FillTransactionId( &( transactionId[ 0 ] ), value - CHURN_OUTSTANDING );
+            TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                               StunTransactionTable_Remove( &( churnTable ), &( transactionId[ 0 ] ), NULL ) );
+        }
+    }
+
+    for( i = 0; i < CHURN_TABLE_CAPACITY; i++ )
+    {
+        if( churnTags[ i ] == 0U )
+        {
+            emptySlots++;
+        }
+    }
+
+    TEST_ASSERT_EQUAL( CHURN_TABLE_CAPACITY - CHURN_OUTSTANDING, emptySlots );
+    TEST_ASSERT_TRUE( GetLongestMissProbe( &( churnOverflowCounts[ 0 ] ), CHURN_TABLE_GROUPS ) <= 4U );
+
+    FillTransactionId( &( transactionId[ 0 ] ), CHURN_TRANSACTIONS );
+    TEST_ASSERT_EQUAL( STUN_RESULT_TRANSACTION_NOT_FOUND,
+                       StunTransactionTable_Lookup( &( churnTable ), &( transactionId[ 0 ] ), &( pUserData ) ) );
+
+    for( value = CHURN_TRANSACTIONS - CHURN_OUTSTANDING; value < CHURN_TRANSACTIONS; value++ )
+    {
+        FillTransactionId( &( transactionId[ 0 ] ), value );
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunTransactionTable_Remove( &( churnTable ), &( transactionId[ 0 ] ), NULL ) );
+    }
+
+    /* The counts go back to 0 with the table empty. */
+    TEST_ASSERT_EQUAL( 1, GetLongestMissProbe( &( churnOverflowCounts[ 0 ] ), CHURN_TABLE_GROUPS ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that a transaction whose first group is full is inserted in
+ * the next probed group, and that a lookup stops at the first group no
+ * transaction went past.
+ */
+void test_StunTransactionTable_Lookup_FullFirstGroup( void )
+{
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ], tag;
+    void * pUserData = NULL;
+    size_t homeSlot, i;
+    uint32_t value = 0;
+
+    FillTransactionId( &( transactionId[ 0 ] ), value );
+    homeSlot = GetHomeSlot( &( transactionId[ 0 ] ), &( tag ) );
+
+    for( i = 0; i < STUN_TRANSACTION_TABLE_GROUP_LENGTH; i++ )
+    {
+        FindTransactionIdInGroup( homeSlot, &( value ), &( transactionId[ 0 ] ) );
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunTransactionTable_Insert( &( table ), &( transactionId[ 0 ] ), NULL ) );
+    }
+
+    /* The group is full, the next one has empty slots. */
+    FindTransactionIdInGroup( homeSlot, &( value ), &( transactionId[ 0 ] ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_TRANSACTION_NOT_FOUND,
+                       StunTransactionTable_Lookup( &( table ), &( transactionId[ 0 ] ), &( pUserData ) ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Insert( &( table ), &( transactionId[ 0 ] ), &( value ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Lookup( &( table ), &( transactionId[ 0 ] ), &( pUserData ) ) );
+    TEST_ASSERT_EQUAL_PTR( &( value ), pUserData );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Remove( &( table ), &( transactionId[ 0 ] ), NULL ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate two transactions with the same group and tag that differ
+ * in the second word of the transaction ID.
+ */
+void test_StunTransactionTable_Lookup_TagCollisionSecondWord( void )
+{
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ];
+    uint8_t otherTransactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ];
+    int request = 0, otherRequest = 0;
+    void * pUserData = NULL;
+
+    FillTransactionId( &( transactionId[ 0 ] ), 1 );
+    FindTagCollision( &( transactionId[ 0 ] ), 4, &( otherTransactionId[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Insert( &( table ), &( transactionId[ 0 ] ), &( request ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_TRANSACTION_NOT_FOUND,
+                       StunTransactionTable_Lookup( &( table ), &( otherTransactionId[ 0 ] ), &( pUserData ) ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Insert( &( table ), &( otherTransactionId[ 0 ] ), &( otherRequest ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Lookup( &( table ), &( otherTransactionId[ 0 ] ), &( pUserData ) ) );
+    TEST_ASSERT_EQUAL_PTR( &( otherRequest ), pUserData );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate two transactions with the same group and tag that differ
+ * in the third word of the transaction ID.
+ */
+void test_StunTransactionTable_Lookup_TagCollisionThirdWord( void )
+{
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ];
+    uint8_t otherTransactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ];
+    int request = 0, otherRequest = 0;
+    void * pUserData = NULL;
+
+    FillTransactionId( &( transactionId[ 0 ] ), 1 );
+    FindTagCollision( &( transactionId[ 0 ] ), 8, &( otherTransactionId[ 0 ] ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Insert( &( table ), &( transactionId[ 0 ] ), &( request ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_TRANSACTION_NOT_FOUND,
+                       StunTransactionTable_Remove( &( table ), &( otherTransactionId[ 0 ] ), &( pUserData ) ) );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Insert( &( table ), &( otherTransactionId[ 0 ] ), &( otherRequest ) ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Remove( &( table ), &( otherTransactionId[ 0 ] ), &( pUserData ) ) );
+    TEST_ASSERT_EQUAL_PTR( &( otherRequest ), pUserData );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Lookup( &( table ), &( transactionId[ 0 ] ), &( pUserData ) ) );
+    TEST_ASSERT_EQUAL_PTR( &( request ), pUserData );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that a lookup retries the read of a slot while another
+ * thread writes it.
+ */
+void test_StunTransactionTable_Lookup_SeqlockRetry( void )
+{
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ], tag;
+    int request = 0;
+    void * pUserData = NULL;
+
+    FillTransactionId( &( transactionId[ 0 ] ), 1 );
+    hookSlotIndex = GetHomeSlot( &( transactionId[ 0 ] ), &( tag ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Insert( &( table ), &( transactionId[ 0 ] ), &( request ) ) );
+
+    /* The first read sees the sequence number change to odd, the second one
+     * sees it odd and changed again, the third one is stable. */
+    ArmHook( 1, StartWrite );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Lookup( &( table ), &( transactionId[ 0 ] ), &( pUserData ) ) );
+    TEST_ASSERT_EQUAL_PTR( &( request ), pUserData );
+    TEST_ASSERT_EQUAL( 4, hookCallCount );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate a lookup of a transaction that another thread removes
+ * while it is read.
+ */
+void test_StunTransactionTable_Lookup_RemovedDuringRead( void )
+{
+    void * pUserData = NULL;
+
+    FillTransactionId( &( hookTransactionId[ 0 ] ), 1 );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Insert( &( table ), &( hookTransactionId[ 0 ] ), NULL ) );
+
+    /* After ReadSlot. */
+    ArmHook( 2, RemoveTransaction );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_TRANSACTION_NOT_FOUND,
+                       StunTransactionTable_Lookup( &( table ), &( hookTransactionId[ 0 ] ), &( pUserData ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate a lookup of a transaction that another thread removes and
+ * inserts again in the same slot while it is read, which is reported as not
+ * found.
+ */
+void test_StunTransactionTable_Lookup_ReinsertedDuringRead( void )
+{
+    uint8_t tag;
+    void * pUserData = NULL;
+
+    FillTransactionId( &( hookTransactionId[ 0 ] ), 1 );
+    hookSlotIndex = GetHomeSlot( &( hookTransactionId[ 0 ] ), &( tag ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Insert( &( table ), &( hookTransactionId[ 0 ] ), NULL ) );
+
+    ArmHook( 2, ReinsertTransaction );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_TRANSACTION_NOT_FOUND,
+                       StunTransactionTable_Lookup( &( table ), &( hookTransactionId[ 0 ] ), &( pUserData ) ) );
+    TEST_ASSERT_EQUAL( tag, tags[ hookSlotIndex ] );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Lookup( &( table ), &( hookTransactionId[ 0 ] ), &( pUserData ) ) );
+    TEST_ASSERT_EQUAL_PTR( &( hookSlotIndex ), pUserData );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that only one of two concurrent removes of a transaction
+ * succeeds.
+ */
+void test_StunTransactionTable_Remove_RemovedDuringRead( void )
+{
+    void * pUserData = NULL;
+
+    FillTransactionId( &( hookTransactionId[ 0 ] ), 1 );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Insert( &( table ), &( hookTransactionId[ 0 ] ), NULL ) );
+
+    ArmHook( 2, RemoveTransaction );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_TRANSACTION_NOT_FOUND,
+                       StunTransactionTable_Remove( &( table ), &( hookTransactionId[ 0 ] ), &( pUserData ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that a remove gives the slot back when it was reused
+ * between the read and the compare and swap of its tag.
+ */
+void test_StunTransactionTable_Remove_ReinsertedDuringRead( void )
+{
+    uint8_t tag;
+    void * pUserData = NULL;
+
+    FillTransactionId( &( hookTransactionId[ 0 ] ), 1 );
+    hookSlotIndex = GetHomeSlot( &( hookTransactionId[ 0 ] ), &( tag ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Insert( &( table ), &( hookTransactionId[ 0 ] ), NULL ) );
+
+    ArmHook( 2, ReinsertTransaction );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_TRANSACTION_NOT_FOUND,
+                       StunTransactionTable_Remove( &( table ), &( hookTransactionId[ 0 ] ), &( pUserData ) ) );
+    TEST_ASSERT_EQUAL( tag, tags[ hookSlotIndex ] );
+
+    /* The reinserted transaction is still there. */
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Remove( &( table ), &( hookTransactionId[ 0 ] ), &( pUserData ) ) );
+    TEST_ASSERT_EQUAL_PTR( &( hookSlotIndex ), pUserData );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate an insert when another thread takes the free slot before
+ * its tag is read.
+ */
+void test_StunTransactionTable_Insert_SlotTakenBeforeRead( void )
+{
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ], tag;
+    void * pUserData = NULL;
+    size_t homeSlot;
+    uint32_t value = 0;
+
+    FillTransactionId( &( transactionId[ 0 ] ), value );
+    homeSlot = GetHomeSlot( &( transactionId[ 0 ] ), &( tag ) );
+    value++;
+    FindTransactionIdInGroup( homeSlot, &( value ), &( hookTransactionId[ 0 ] ) );
+
+    ArmHook( 1, InsertTransaction );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Insert( &( table ), &( transactionId[ 0 ] ), &( value ) ) );
+    TEST_ASSERT_EQUAL( tag, tags[ homeSlot + 1 ] );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Lookup( &( table ), &( transactionId[ 0 ] ), &( pUserData ) ) );
+    TEST_ASSERT_EQUAL_PTR( &( value ), pUserData );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Lookup( &( table ), &( hookTransactionId[ 0 ] ), &( pUserData ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate an insert when another thread takes the free slot between
+ * the read of its tag and the compare and swap.
+ */
+void test_StunTransactionTable_Insert_SlotTakenBeforeSwap( void )
+{
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ], tag;
+    void * pUserData = NULL;
+    size_t homeSlot;
+    uint32_t value = 0;
+
+    FillTransactionId( &( transactionId[ 0 ] ), value );
+    homeSlot = GetHomeSlot( &( transactionId[ 0 ] ), &( tag ) );
+    value++;
+    FindTransactionIdInGroup( homeSlot, &( value ), &( hookTransactionId[ 0 ] ) );
+
+    ArmHook( 2, InsertTransaction );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Insert( &( table ), &( transactionId[ 0 ] ), &( value ) ) );
+    TEST_ASSERT_EQUAL( tag, tags[ homeSlot + 1 ] );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Lookup( &( table ), &( transactionId[ 0 ] ), &( pUserData ) ) );
+    TEST_ASSERT_EQUAL_PTR( &( value ), pUserData );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Lookup( &( table ), &( hookTransactionId[ 0 ] ), &( pUserData ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that a response header is matched to its request once.
+ */
+void test_StunTransactionTable_MatchResponse_Pass( void )
+{
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] =
+    {
+        0xB7, 0xE7, 0xA7, 0x01, 0xBC, 0x34, 0xD6, 0x86, 0xFA, 0x87, 0xDF, 0xAE
+    };
+    uint8_t responseTransactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ];
+    StunHeader_t header;
+    int request = 0;
+    void * pUserData = NULL;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Insert( &( table ), &( transactionId[ 0 ] ), &( request ) ) );
+
+    ( void ) memcpy( &( responseTransactionId[ 0 ] ), &( transactionId[ 0 ] ), STUN_HEADER_TRANSACTION_ID_LENGTH );
+    header.messageType = STUN_MESSAGE_TYPE_BINDING_SUCCESS_RESPONSE;
+    header.pTransactionId = &( responseTransactionId[ 0 ] );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_MatchResponse( &( table ), &( header ), &( pUserData ) ) );
+    TEST_ASSERT_EQUAL_PTR( &( request ), pUserData );
+
+    /* A retransmitted response does not match anymore. */
+    TEST_ASSERT_EQUAL( STUN_RESULT_TRANSACTION_NOT_FOUND,
+                       StunTransactionTable_MatchResponse( &( table ), &( header ), &( pUserData ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate that a rebuild moves a transaction back to its first group
+ * once a slot of it is free, and keeps the one that cannot move.
+ */
+void test_StunTransactionTable_Rebuild_Pass( void )
+{
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ], tag;
+    uint8_t firstTransactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ];
+    uint8_t otherTransactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ];
+    int request = 0, otherRequest = 0;
+    void * pUserData = NULL;
+    size_t homeSlot, i;
+    uint32_t value = 0;
+
+    FillTransactionId( &( transactionId[ 0 ] ), value );
+    homeSlot = GetHomeSlot( &( transactionId[ 0 ] ), &( tag ) );
+
+    for( i = 0; i < STUN_TRANSACTION_TABLE_GROUP_LENGTH; i++ )
+    {
+        FindTransactionIdInGroup( homeSlot, &( value ), &( transactionId[ 0 ] ) );
+        TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                           StunTransactionTable_Insert( &( table ), &( transactionId[ 0 ] ), NULL ) );
+
+        if( i == 0 )
+        {
+            ( void ) memcpy( &( firstTransactionId[ 0 ] ), &( transactionId[ 0 ] ), STUN_HEADER_TRANSACTION_ID_LENGTH );
+        }
+    }
+
+    /* Both go past the full group. */
+    FindTransactionIdInGroup( homeSlot, &( value ), &( transactionId[ 0 ] ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Insert( &( table ), &( transactionId[ 0 ] ), &( request ) ) );
+    FindTransactionIdInGroup( homeSlot, &( value ), &( otherTransactionId[ 0 ] ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Insert( &( table ), &( otherTransactionId[ 0 ] ), &( otherRequest ) ) );
+    TEST_ASSERT_EQUAL( 2, overflowCounts[ homeSlot / STUN_TRANSACTION_TABLE_GROUP_LENGTH ] );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Remove( &( table ), &( firstTransactionId[ 0 ] ), NULL ) );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Rebuild( &( table ) ) );
+
+    ( void ) GetHomeSlot( &( transactionId[ 0 ] ), &( tag ) );
+    TEST_ASSERT_EQUAL( tag, tags[ homeSlot ] );
+    TEST_ASSERT_EQUAL( 1, overflowCounts[ homeSlot / STUN_TRANSACTION_TABLE_GROUP_LENGTH ] );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Lookup( &( table ), &( transactionId[ 0 ] ), &( pUserData ) ) );
+    TEST_ASSERT_EQUAL_PTR( &( request ), pUserData );
+    TEST_ASSERT_EQUAL( STUN_RESULT_OK,
+                       StunTransactionTable_Lookup( &( table ), &( otherTransactionId[ 0 ] ), &( pUserData ) ) );
+    TEST_ASSERT_EQUAL_PTR( &( otherRequest ), pUserData );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunTransactionTable_Init with a NULL table.
+ */
+void test_StunTransactionTable_Init_NullTable( void )
+{
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunTransactionTable_Init( NULL, &( tags[ 0 ] ), &( slots[ 0 ] ), &( overflowCounts[ 0 ] ), TABLE_CAPACITY, 0 ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunTransactionTable_Init with NULL tags.
+ */
+void test_StunTransactionTable_Init_NullTags( void )
+{
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunTransactionTable_Init( &( table ), NULL, &( slots[ 0 ] ), &( overflowCounts[ 0 ] ), TABLE_CAPACITY, 0 ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunTransactionTable_Init with NULL slots.
+ */
+void test_StunTransactionTable_Init_NullSlots( void )
+{
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunTransactionTable_Init( &( table ), &( tags[ 0 ] ), NULL, &( overflowCounts[ 0 ] ), TABLE_CAPACITY, 0 ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunTransactionTable_Init with NULL overflow counts.
+ */
+void test_StunTransactionTable_Init_NullOverflowCounts( void )
+{
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunTransactionTable_Init( &( table ), &( tags[ 0 ] ), &( slots[ 0 ] ), NULL, TABLE_CAPACITY, 0 ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunTransactionTable_Init with a capacity smaller than a
+ * group.
+ */
+void test_StunTransactionTable_Init_CapacityTooSmall( void )
+{
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunTransactionTable_Init( &( table ), &( tags[ 0 ] ), &( slots[ 0 ] ), &( overflowCounts[ 0 ] ), 8, 0 ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunTransactionTable_Init with a capacity that is not a
+ * power of 2.
+ */
+void test_StunTransactionTable_Init_CapacityNotPowerOf2( void )
+{
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunTransactionTable_Init( &( table ), &( tags[ 0 ] ), &( slots[ 0 ] ), &( overflowCounts[ 0 ] ), 48, 0 ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunTransactionTable_Insert with a NULL table.
+ */
+void test_StunTransactionTable_Insert_NullTable( void )
+{
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] = { 0 };
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunTransactionTable_Insert( NULL, &( transactionId[ 0 ] ), NULL ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunTransactionTable_Insert with a NULL transaction ID.
+ */
+void test_StunTransactionTable_Insert_NullTransactionId( void )
+{
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunTransactionTable_Insert( &( table ), NULL, NULL ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunTransactionTable_Lookup with a NULL table.
+ */
+void test_StunTransactionTable_Lookup_NullTable( void )
+{
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] = { 0 };
+    void * pUserData = NULL;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunTransactionTable_Lookup( NULL, &( transactionId[ 0 ] ), &( pUserData ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunTransactionTable_Lookup with a NULL transaction ID.
+ */
+void test_StunTransactionTable_Lookup_NullTransactionId( void )
+{
+    void * pUserData = NULL;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunTransactionTable_Lookup( &( table ), NULL, &( pUserData ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunTransactionTable_Lookup with a NULL user data output.
+ */
+void test_StunTransactionTable_Lookup_NullUserData( void )
+{
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] = { 0 };
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunTransactionTable_Lookup( &( table ), &( transactionId[ 0 ] ), NULL ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunTransactionTable_Remove with a NULL table.
+ */
+void test_StunTransactionTable_Remove_NullTable( void )
+{
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] = { 0 };
+    void * pUserData = NULL;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunTransactionTable_Remove( NULL, &( transactionId[ 0 ] ), &( pUserData ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunTransactionTable_Remove with a NULL transaction ID.
+ */
+void test_StunTransactionTable_Remove_NullTransactionId( void )
+{
+    void * pUserData = NULL;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunTransactionTable_Remove( &( table ), NULL, &( pUserData ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunTransactionTable_MatchResponse with a NULL table.
+ */
+void test_StunTransactionTable_MatchResponse_NullTable( void )
+{
+    uint8_t transactionId[ STUN_HEADER_TRANSACTION_ID_LENGTH ] = { 0 };
+    StunHeader_t header = { 0 };
+    void * pUserData = NULL;
+
+    header.pTransactionId = &( transactionId[ 0 ] );
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunTransactionTable_MatchResponse( NULL, &( header ), &( pUserData ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunTransactionTable_MatchResponse with a NULL header.
+ */
+void test_StunTransactionTable_MatchResponse_NullHeader( void )
+{
+    void * pUserData = NULL;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunTransactionTable_MatchResponse( &( table ), NULL, &( pUserData ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunTransactionTable_MatchResponse with a header without a
+ * transaction ID.
+ */
+void test_StunTransactionTable_MatchResponse_NullTransactionId( void )
+{
+    StunHeader_t header = { 0 };
+    void * pUserData = NULL;
+
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunTransactionTable_MatchResponse( &( table ), &( header ), &( pUserData ) ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Validate StunTransactionTable_Rebuild with a NULL table.
+ */
+void test_StunTransactionTable_Rebuild_NullTable( void )
+{
+    TEST_ASSERT_EQUAL( STUN_RESULT_BAD_PARAM,
+                       StunTransactionTable_Rebuild( NULL ) );
+}
+
+/*-----------------------------------------------------------*/